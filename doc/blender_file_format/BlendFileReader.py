@@ -135,11 +135,12 @@ class BlendFile:
         self.Header = BlendFileHeader(handle)
         self.Blocks = []
         fileblock = BlendFileBlock(handle, self)
-        found_dna_block = False
-        while not found_dna_block:
+        # The DNA block is not necessarily the last one, read until "ENDB".
+        while fileblock.Header.Code != "ENDB":
             if fileblock.Header.Code in {"DNA1", "SDNA"}:
                 self.Catalog = DNACatalog(self.Header, handle)
-                found_dna_block = True
+                # Skip possible padding at the end of the DNA block.
+                handle.seek(fileblock.Header.FileOffset + fileblock.Header.Size, os.SEEK_SET)
             else:
                 fileblock.Header.skip(handle)
 
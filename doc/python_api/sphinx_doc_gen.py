@@ -236,6 +236,7 @@ else:
         "bpy.app",
         "bpy.app.handlers",
         "bpy.app.timers",
+        "bpy.app.trace",
         "bpy.app.translations",
         "bpy.context",
         "bpy.data",
@@ -2022,6 +2023,7 @@ def write_rst_importable_modules(basepath):
         "bpy.app.translations": "Application Translations",
         "bpy.app.icons": "Application Icons",
         "bpy.app.timers": "Application Timers",
+        "bpy.app.trace": "Application Tracing",
         "bpy.props": "Property Definitions",
         "idprop.types": "ID Property Access",
         "mathutils": "Math Types & Utilities",
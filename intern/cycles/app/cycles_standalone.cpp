@@ -20,6 +20,7 @@
 #include "render/buffers.h"
 #include "render/camera.h"
 #include "render/integrator.h"
+#include "render/merge.h"
 #include "render/scene.h"
 #include "render/session.h"
 
@@ -31,6 +32,7 @@
 #include "util/util_path.h"
 #include "util/util_progress.h"
 #include "util/util_string.h"
+#include "util/util_system.h"
 #include "util/util_time.h"
 #include "util/util_transform.h"
 #include "util/util_unique_ptr.h"
@@ -58,6 +60,11 @@ struct Options {
   bool show_help, interactive, pause;
   string output_filepath;
   string output_pass;
+  /* Input files, the scene file or the tile files to merge. */
+  vector<string> input_filepaths;
+  bool merge;
+  /* Full-frame tile files written by the session. */
+  vector<string> tile_filepaths;
 } options;
 
 static void session_print(const string &str)
@@ -135,6 +142,10 @@ static void session_init()
         options.output_filepath, options.output_pass, session_print));
   }
 
+  options.session->full_buffer_written_cb = [](string_view filename) {
+    options.tile_filepaths.push_back(string(filename));
+  };
+
   if (options.session_params.background && !options.quiet)
     options.session->progress.set_update_callback(function_bind(&session_print_status));
 #ifdef WITH_CYCLES_STANDALONE_GUI
@@ -154,6 +165,56 @@ static void session_init()
   options.session->start();
 }
 
+/* Handle full-frame tile files written when rendering with big tiles. */
+static void session_process_tile_files()
+{
+  if (options.session_params.use_full_buffer_file ||
+      options.session_params.distributed_num_instances > 1) {
+    /* Keep the raw render buffers of this instance, to be merged with the other instances. */
+    foreach (const string &filepath, options.tile_filepaths) {
+      vector<uint8_t> binary;
+      if (!path_read_binary(filepath, binary) ||
+          !path_write_binary(options.output_filepath, binary)) {
+        fprintf(stderr, "Failed to write render buffers to %s\n", options.output_filepath.c_str());
+      }
+    }
+  }
+  else {
+    foreach (const string &filepath, options.tile_filepaths) {
+      options.session->process_full_buffer_from_disk(filepath);
+    }
+  }
+
+  foreach (const string &filepath, options.tile_filepaths) {
+    path_remove(filepath);
+  }
+  options.tile_filepaths.clear();
+}
+
+/* Merge render buffers written by instances which rendered different tiles or sample ranges of
+ * the same frame, and denoise and write the merged result. */
+static void session_merge()
+{
+  ImageMerger merger;
+  merger.input = options.input_filepaths;
+  merger.output = path_temp_get("cycles-merged-buffers-" + to_string(system_self_process_id()) +
+                                ".exr");
+
+  if (!merger.run()) {
+    fprintf(stderr, "Failed to merge render buffers: %s\n", merger.error.c_str());
+    exit(EXIT_FAILURE);
+  }
+
+  options.output_pass = "combined";
+  options.session = new Session(options.session_params, options.scene_params);
+  options.session->set_output_driver(make_unique<OIIOOutputDriver>(
+      options.output_filepath, options.output_pass, session_print));
+
+  options.session->process_full_buffer_from_disk(merger.output);
+
+  path_remove(merger.output);
+}
+
 static void session_exit()
 {
   if (options.session) {
@@ -341,8 +402,11 @@ static void keyboard(unsigned char key)
 
 static int files_parse(int argc, const char *argv[])
 {
-  if (argc > 0)
-    options.filepath = argv[0];
+  for (int i = 0; i < argc; i++)
+    options.input_filepaths.push_back(argv[i]);
+
+  if (!options.input_filepaths.empty())
+    options.filepath = options.input_filepaths.front();
 
   return 0;
 }
@@ -354,6 +418,7 @@ static void options_parse(int argc, const char **argv)
   options.filepath = "";
   options.session = NULL;
   options.quiet = false;
+  options.merge = false;
   options.session_params.use_auto_tile = false;
   options.session_params.tile_size = 0;
 
@@ -374,12 +439,17 @@ static void options_parse(int argc, const char **argv)
   /* shading system */
   string ssname = "svm";
 
+  /* distributed rendering */
+  string distributed = "";
+  string sample_range = "";
+
   /* parse options */
   ArgParse ap;
   bool help = false, debug = false, version = false;
   int verbosity = 1;
 
-  ap.options("Usage: cycles [options] file.xml",
+  ap.options("Usage: cycles [options] file.xml\n"
+             "       cycles --merge [options] tiles.exr ...",
              "%*",
              files_parse,
              "",
@@ -415,6 +485,18 @@ static void options_parse(int argc, const char **argv)
              "--tile-size %d",
              &options.session_params.tile_size,
              "Tile size in pixels",
+             "--distributed %s",
+             &distributed,
+             "Render only the tiles of this instance, as INDEX:COUNT, and write them to the "
+             "output file to be combined with --merge",
+             "--sample-range %s",
+             &sample_range,
+             "Render only the samples in the range START:COUNT, and write the render buffers to "
+             "the output file to be combined with --merge",
+             "--merge",
+             &options.merge,
+             "Merge render buffers of all instances of a distributed render, and denoise and "
+             "write the result to the output image",
              "--list-devices",
              &list,
              "List information about all available devices",
@@ -480,6 +562,39 @@ static void options_parse(int argc, const char **argv)
     options.session_params.use_auto_tile = true;
   }
 
+  if (distributed != "") {
+    int instance_index, num_instances;
+    if (sscanf(distributed.c_str(), "%d:%d", &instance_index, &num_instances) != 2 ||
+        instance_index < 0 || instance_index >= num_instances) {
+      fprintf(stderr, "Invalid distributed instance: %s\n", distributed.c_str());
+      exit(EXIT_FAILURE);
+    }
+    if (!options.session_params.use_auto_tile) {
+      fprintf(stderr, "Distributed rendering requires a tile size\n");
+      exit(EXIT_FAILURE);
+    }
+    options.session_params.distributed_instance_index = instance_index;
+    options.session_params.distributed_num_instances = num_instances;
+  }
+
+  if (sample_range != "") {
+    int start_sample, num_samples;
+    if (sscanf(sample_range.c_str(), "%d:%d", &start_sample, &num_samples) != 2 ||
+        start_sample < 0 || num_samples < 1) {
+      fprintf(stderr, "Invalid sample range: %s\n", sample_range.c_str());
+      exit(EXIT_FAILURE);
+    }
+    options.session_params.sample_offset = start_sample;
+    options.session_params.samples = num_samples;
+    options.session_params.use_full_buffer_file = true;
+  }
+
+  if ((options.merge || distributed != "" || sample_range != "") &&
+      options.output_filepath == "") {
+    fprintf(stderr, "No output file path specified\n");
+    exit(EXIT_FAILURE);
+  }
+
   /* find matching device */
   DeviceType device_type = Device::type_from_string(devicename.c_str());
   vector<DeviceInfo> devices = Device::available_devices(DEVICE_MASK(device_type));
@@ -526,11 +641,18 @@ int main(int argc, const char **argv)
   path_init();
   options_parse(argc, argv);
 
+  if (options.merge) {
+    session_merge();
+    session_exit();
+    return 0;
+  }
+
 #ifdef WITH_CYCLES_STANDALONE_GUI
   if (options.session_params.background) {
 #endif
     session_init();
     options.session->wait();
+    session_process_tile_files();
     session_exit();
 #ifdef WITH_CYCLES_STANDALONE_GUI
   }
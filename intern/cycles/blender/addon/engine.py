@@ -31,6 +31,10 @@ def _configure_argument_parser():
                              "Valid options are 'CPU', 'CUDA', 'OPTIX', or 'HIP'"
                              "Additionally, you can append '+CPU' to any GPU type for hybrid rendering.",
                         default=None)
+    parser.add_argument("--cycles-sample-range",
+                        help="Render only the samples START:COUNT, for splitting a frame between render farm jobs. "
+                             "The results can be combined with the Cycles merge images operator",
+                        default=None)
     return parser
 
 
@@ -52,6 +56,11 @@ def _parse_command_line():
         import _cycles
         _cycles.set_device_override(args.cycles_device)
 
+    if args.cycles_sample_range:
+        import _cycles
+        start, count = args.cycles_sample_range.split(":")
+        _cycles.set_sample_range(int(start), int(count))
+
 
 def init():
     import bpy
@@ -212,6 +221,7 @@ def list_render_passes(scene, srl):
 
     # Debug passes.
     if crl.pass_debug_sample_count:            yield ("Debug Sample Count",            "X",   'VALUE')
+    if crl.pass_debug_adaptive_error:          yield ("Debug Adaptive Error",          "X",   'VALUE')
 
     # Cryptomatte passes.
     crypto_depth = (srl.pass_cryptomatte_depth + 1) // 2
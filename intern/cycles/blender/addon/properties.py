@@ -164,6 +164,7 @@ enum_view3d_shading_render_pass = (
     ('DENOISING_ALBEDO', "Denoising Albedo", "Albedo pass used by denoiser"),
     ('DENOISING_NORMAL', "Denoising Normal", "Normal pass used by denoiser"),
     ('SAMPLE_COUNT', "Sample Count", "Per-pixel number of samples"),
+    ('ADAPTIVE_ERROR', "Adaptive Error", "Per-pixel noise estimate of adaptive sampling"),
 )
 
 
@@ -351,6 +352,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=0.0, max=1.0,
         default=0.01,
     )
+    use_light_tree: BoolProperty(
+        name="Light Tree",
+        description="Pick lights for each shading point based on their estimated contribution, "
+        "reducing noise in scenes with many lights",
+        default=False,
+    )
 
     use_adaptive_sampling: BoolProperty(
         name="Use Adaptive Sampling",
@@ -620,6 +627,11 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="Use special type BVH optimized for hair (uses more ram but renders faster)",
         default=True,
     )
+    debug_use_quantized_bvh: BoolProperty(
+        name="Use Quantized BVH",
+        description="Store BVH node bounds with lower precision (uses less memory but renders slower)",
+        default=False,
+    )
     debug_bvh_time_steps: IntProperty(
         name="BVH Time Steps",
         description="Split BVH primitives by this number of time steps to speed up render time in cost of memory",
@@ -750,6 +762,20 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         min=8, max=16384,
     )
 
+    use_texture_cache: BoolProperty(
+        name="Texture Cache",
+        description="Load parts of image textures from disk as they are used while rendering, instead of loading full images before rendering. "
+        "Only supported on the CPU",
+        default=False,
+    )
+    texture_cache_size: IntProperty(
+        name="Cache Size",
+        description="Maximum memory used by the texture cache, in megabytes",
+        subtype='UNSIGNED',
+        default=4096,
+        min=64, max=1048576,
+    )
+
     # Various fine-tuning debug flags
 
     def _devices_update_callback(self, context):
@@ -767,6 +793,12 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         items=enum_bvh_layouts,
         default='EMBREE',
     )
+    debug_use_cpu_wavefront: BoolProperty(
+        name="Wavefront",
+        description="Render batches of paths per thread with paths sorted by shader, "
+        "instead of rendering paths one by one",
+        default=False,
+    )
 
     debug_use_cuda_adaptive_compile: BoolProperty(name="Adaptive Compile", default=False)
 
@@ -1203,6 +1235,13 @@ class CyclesRenderLayerSettings(bpy.types.PropertyGroup):
         default=False,
         update=update_render_passes,
     )
+    pass_debug_adaptive_error: BoolProperty(
+        name="Debug Adaptive Error",
+        description="Per-pixel noise estimate of adaptive sampling. Pixels with a value below the "
+        "noise threshold are considered converged",
+        default=False,
+        update=update_render_passes,
+    )
     use_pass_volume_direct: BoolProperty(
         name="Volume Direct",
         description="Deliver direct volumetric scattering pass",
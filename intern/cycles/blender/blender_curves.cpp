@@ -27,6 +27,7 @@
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_logging.h"
+#include "util/util_md5.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -911,4 +912,111 @@ void BlenderSync::sync_hair_motion(BL::Depsgraph b_depsgraph,
   hair->copy_center_to_motion_step(motion_step);
 }
 
+/* Hair instancing.
+ *
+ * Separate objects often have identical hair, for example copies of a character in a crowd which
+ * share the mesh and particle settings. Particle hair is owned by the object though, so every copy
+ * gets its own hair geometry. Detect hair geometry with identical curves and attributes, and make
+ * all objects use a single one of them, so the curves and their BVH are only stored once and are
+ * instanced with the object transforms. */
+
+static string hair_content_hash(Hair *hair)
+{
+  MD5Hash md5;
+  hair->hash(md5);
+
+  foreach (const Attribute &attr, hair->attributes.attributes) {
+    md5.append(attr.name.string());
+    md5.append((const uint8_t *)&attr.std, sizeof(attr.std));
+    md5.append(attr.type.c_str());
+    md5.append((const uint8_t *)&attr.element, sizeof(attr.element));
+    if (!attr.buffer.empty()) {
+      md5.append((const uint8_t *)attr.buffer.data(), attr.buffer.size());
+    }
+  }
+
+  return md5.get_hex();
+}
+
+static bool hair_content_equals(Hair *a, Hair *b)
+{
+  if (!a->equals(*b) || a->attributes.attributes.size() != b->attributes.attributes.size()) {
+    return false;
+  }
+
+  list<Attribute>::const_iterator it_a = a->attributes.attributes.begin();
+  list<Attribute>::const_iterator it_b = b->attributes.attributes.begin();
+  for (; it_a != a->attributes.attributes.end(); ++it_a, ++it_b) {
+    if (it_a->name != it_b->name || it_a->std != it_b->std || it_a->type != it_b->type ||
+        it_a->element != it_b->element || it_a->buffer != it_b->buffer) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void BlenderSync::sync_hair_instances()
+{
+  /* Objects are only redirected to the shared hair after all data has been synced, which is not
+   * compatible with incremental updates: those assume every object keeps using its own geometry.
+   * So only do it when the scene is synced once. */
+  if (preview || b_scene.render().use_persistent_data()) {
+    return;
+  }
+
+  map<string, vector<Hair *>> unique_hairs;
+  map<Geometry *, Geometry *> hair_instances;
+
+  for (const auto &it : geometry_map.key_to_scene_data()) {
+    Geometry *geom = it.second;
+    if (geom->geometry_type != Geometry::HAIR) {
+      continue;
+    }
+
+    Hair *hair = static_cast<Hair *>(geom);
+    if (hair->num_curves() == 0) {
+      continue;
+    }
+
+    vector<Hair *> &candidates = unique_hairs[hair_content_hash(hair)];
+    Hair *instanced_hair = NULL;
+    for (Hair *candidate : candidates) {
+      if (hair_content_equals(hair, candidate)) {
+        instanced_hair = candidate;
+        break;
+      }
+    }
+
+    if (instanced_hair) {
+      hair_instances[hair] = instanced_hair;
+    }
+    else {
+      candidates.push_back(hair);
+    }
+  }
+
+  if (hair_instances.empty()) {
+    return;
+  }
+
+  foreach (Object *object, scene->objects) {
+    map<Geometry *, Geometry *>::const_iterator it = hair_instances.find(object->get_geometry());
+    if (it != hair_instances.end()) {
+      object->set_geometry(it->second);
+    }
+  }
+
+  size_t num_instanced_keys = 0;
+  for (const auto &it : hair_instances) {
+    Hair *hair = static_cast<Hair *>(it.first);
+    num_instanced_keys += hair->num_keys();
+    hair->clear(true);
+    hair->tag_update(scene, true);
+  }
+
+  VLOG(1) << "Instanced " << hair_instances.size() << " hair geometries with identical curves ("
+          << num_instanced_keys << " curve keys).";
+}
+
 CCL_NAMESPACE_END
@@ -72,6 +72,15 @@ array<Node *> BlenderSync::find_used_shaders(BL::Object &b_ob)
   return used_shaders;
 }
 
+bool BlenderSync::geometry_is_modified(Geometry *geom)
+{
+  /* Geometry synced in this loop may still be in the task pool, so don't access its data. */
+  if (geometry_synced.find(geom) != geometry_synced.end()) {
+    return true;
+  }
+  return geom->is_modified();
+}
+
 Geometry *BlenderSync::sync_geometry(BL::Depsgraph &b_depsgraph,
                                      BObjectInfo &b_ob_info,
                                      bool object_updated,
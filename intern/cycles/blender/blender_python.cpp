@@ -81,6 +81,7 @@ static void debug_flags_sync_from_scene(BL::Scene b_scene)
   flags.cpu.sse3 = get_boolean(cscene, "debug_use_cpu_sse3");
   flags.cpu.sse2 = get_boolean(cscene, "debug_use_cpu_sse2");
   flags.cpu.bvh_layout = (BVHLayout)get_enum(cscene, "debug_bvh_layout");
+  flags.cpu.wavefront = get_boolean(cscene, "debug_use_cpu_wavefront");
   /* Synchronize CUDA flags. */
   flags.cuda.adaptive_compile = get_boolean(cscene, "debug_use_cuda_adaptive_compile");
   /* Synchronize OptiX flags. */
@@ -908,6 +909,21 @@ static PyObject *enable_print_stats_func(PyObject * /*self*/, PyObject * /*args*
   Py_RETURN_NONE;
 }
 
+static PyObject *set_sample_range_func(PyObject * /*self*/, PyObject *args)
+{
+  int start_sample, num_samples;
+  if (!PyArg_ParseTuple(args, "ii", &start_sample, &num_samples)) {
+    return NULL;
+  }
+
+  BlenderSession::sample_range_start = max(start_sample, 0);
+  BlenderSession::sample_range_num_samples = max(num_samples, 0);
+
+  VLOG(2) << "Rendering sample range " << start_sample << ":" << num_samples;
+
+  Py_RETURN_NONE;
+}
+
 static PyObject *get_device_types_func(PyObject * /*self*/, PyObject * /*args*/)
 {
   vector<DeviceType> device_types = Device::available_types();
@@ -996,6 +1012,9 @@ static PyMethodDef methods[] = {
     {"get_device_types", get_device_types_func, METH_VARARGS, ""},
     {"set_device_override", set_device_override_func, METH_O, ""},
 
+    /* Render farm distribution */
+    {"set_sample_range", set_sample_range_func, METH_VARARGS, ""},
+
     {NULL, NULL, 0, NULL},
 };
 
@@ -53,6 +53,8 @@ CCL_NAMESPACE_BEGIN
 DeviceTypeMask BlenderSession::device_override = DEVICE_MASK_ALL;
 bool BlenderSession::headless = false;
 bool BlenderSession::print_render_stats = false;
+int BlenderSession::sample_range_start = 0;
+int BlenderSession::sample_range_num_samples = -1;
 
 BlenderSession::BlenderSession(BL::RenderEngine &b_engine,
                                BL::Preferences &b_userpref,
@@ -300,15 +302,12 @@ void BlenderSession::stamp_view_layer_metadata(Scene *scene, const string &view_
                             to_string(session->params.samples).c_str());
 
   /* Store ranged samples information. */
-  /* TODO(sergey): Need to bring this information back. */
-#if 0
-  if (session->tile_manager.range_num_samples != -1) {
+  if (sample_range_num_samples != -1) {
     b_rr.stamp_data_add_field((prefix + "range_start_sample").c_str(),
-                              to_string(session->tile_manager.range_start_sample).c_str());
+                              to_string(session->params.sample_offset).c_str());
     b_rr.stamp_data_add_field((prefix + "range_num_samples").c_str(),
-                              to_string(session->tile_manager.range_num_samples).c_str());
+                              to_string(session->params.samples).c_str());
   }
-#endif
 
   /* Write cryptomatte metadata. */
   if (scene->film->get_cryptomatte_passes() & CRYPT_OBJECT) {
@@ -430,6 +429,13 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
       effective_session_params.samples = samples;
     }
 
+    /* Render only a range of the samples of the layer. */
+    if (sample_range_num_samples != -1) {
+      effective_session_params.sample_offset = sample_range_start;
+      effective_session_params.samples = clamp(
+          effective_session_params.samples - sample_range_start, 0, sample_range_num_samples);
+    }
+
     /* Update session itself. */
     session->reset(effective_session_params, buffer_params);
 
@@ -441,10 +447,15 @@ void BlenderSession::render(BL::Depsgraph &b_depsgraph_)
     session->start();
     session->wait();
 
-    if (!b_engine.is_preview() && background && print_render_stats) {
+    if (!b_engine.is_preview() && background && (print_render_stats || VLOG_IS_ON(1))) {
       RenderStats stats;
       session->collect_statistics(&stats);
-      printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      if (print_render_stats) {
+        printf("Render statistics:\n%s\n", stats.full_report().c_str());
+      }
+      else {
+        VLOG(1) << "Render statistics:\n" << stats.full_report();
+      }
     }
 
     if (session->progress.get_cancel())
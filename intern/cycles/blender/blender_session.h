@@ -130,6 +130,11 @@ class BlenderSession {
 
   static bool print_render_stats;
 
+  /* Range of samples to render, for splitting a frame between render farm jobs.
+   * The number of samples is -1 when the full frame is rendered. */
+  static int sample_range_start;
+  static int sample_range_num_samples;
+
  protected:
   void stamp_view_layer_metadata(Scene *scene, const string &view_layer_name);
 
@@ -166,12 +166,15 @@ class BlenderSync {
   void sync_particle_hair(
       Hair *hair, BL::Mesh &b_mesh, BObjectInfo &b_ob_info, bool motion, int motion_step = 0);
   bool object_has_particle_hair(BL::Object b_ob);
+  void sync_hair_instances();
 
   /* Camera */
   void sync_camera_motion(
       BL::RenderSettings &b_render, BL::Object &b_ob, int width, int height, float motion_time);
 
   /* Geometry */
+  bool geometry_is_modified(Geometry *geom);
+
   Geometry *sync_geometry(BL::Depsgraph &b_depsgrpah,
                           BObjectInfo &b_ob_info,
                           bool object_updated,
@@ -27,6 +27,7 @@
 
 #include "util/util_foreach.h"
 #include "util/util_progress.h"
+#include "util/util_tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -42,7 +43,7 @@ int BVHStackEntry::encodeIdx() const
 BVH2::BVH2(const BVHParams &params_,
            const vector<Geometry *> &geometry_,
            const vector<Object *> &objects_)
-    : BVH(params_, geometry_, objects_)
+    : BVH(params_, geometry_, objects_), build_sah_cost(0.0f), refit_sah_cost(0.0f)
 {
 }
 
@@ -94,6 +95,9 @@ void BVH2::build(Progress &progress, Stats *)
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root);
 
+  build_sah_cost = root->computeSubtreeSAHCost(params);
+  refit_sah_cost = build_sah_cost;
+
   /* free build nodes */
   root->deleteSubtree();
 }
@@ -110,6 +114,11 @@ void BVH2::refit(Progress &progress)
   refit_nodes();
 }
 
+bool BVH2::need_rebuild() const
+{
+  return refit_sah_cost > build_sah_cost * BVH_REFIT_MAX_SAH_COST_FACTOR;
+}
+
 BVHNode *BVH2::widen_children_nodes(const BVHNode *root)
 {
   return const_cast<BVHNode *>(root);
@@ -152,13 +161,24 @@ void BVH2::pack_aligned_inner(const BVHStackEntry &e,
                               const BVHStackEntry &e0,
                               const BVHStackEntry &e1)
 {
-  pack_aligned_node(e.idx,
-                    e0.node->bounds,
-                    e1.node->bounds,
-                    e0.encodeIdx(),
-                    e1.encodeIdx(),
-                    e0.node->visibility,
-                    e1.node->visibility);
+  if (params.use_quantized_nodes) {
+    pack_quantized_node(e.idx,
+                        e0.node->bounds,
+                        e1.node->bounds,
+                        e0.encodeIdx(),
+                        e1.encodeIdx(),
+                        e0.node->visibility,
+                        e1.node->visibility);
+  }
+  else {
+    pack_aligned_node(e.idx,
+                      e0.node->bounds,
+                      e1.node->bounds,
+                      e0.encodeIdx(),
+                      e1.encodeIdx(),
+                      e0.node->visibility,
+                      e1.node->visibility);
+  }
 }
 
 void BVH2::pack_aligned_node(int idx,
@@ -193,6 +213,116 @@ void BVH2::pack_aligned_node(int idx,
   memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_NODE_SIZE);
 }
 
+/* Quantized nodes store the bounds of both children in steps of a power of two per axis, starting
+ * from the lower corner of the node bounds. Decoding the bounds in the kernel is exact, so the
+ * rounding here can make sure the quantized bounds always contain the child bounds. */
+
+static uint quantize_exponent(const float origin, const float max)
+{
+  const float extent = max - origin;
+  int exponent = (extent > 0.0f) ? (int)ceilf(log2f(extent / 255.0f)) + 127 : 1;
+  exponent = clamp(exponent, 1, 254);
+  while (exponent < 254 && origin + 255.0f * __uint_as_float(exponent << 23) < max) {
+    exponent++;
+  }
+  return exponent;
+}
+
+static uint quantize_lower(const float value, const float origin, const float scale)
+{
+  int q = (int)clamp(floorf((value - origin) / scale), 0.0f, 255.0f);
+  while (q > 0 && origin + (float)q * scale > value) {
+    q--;
+  }
+  return q;
+}
+
+static uint quantize_upper(const float value, const float origin, const float scale)
+{
+  int q = (int)clamp(ceilf((value - origin) / scale), 0.0f, 255.0f);
+  while (q < 255 && origin + (float)q * scale < value) {
+    q++;
+  }
+  return q;
+}
+
+void BVH2::pack_quantized_node(int idx,
+                               const BoundBox &b0,
+                               const BoundBox &b1,
+                               int c0,
+                               int c1,
+                               uint visibility0,
+                               uint visibility1)
+{
+  assert(idx + BVH_QUANTIZED_NODE_SIZE <= pack.nodes.size());
+  assert(c0 < 0 || c0 < pack.nodes.size());
+  assert(c1 < 0 || c1 < pack.nodes.size());
+
+  /* Children without valid bounds are never traversed. */
+  if (!b0.valid()) {
+    visibility0 = 0;
+  }
+  if (!b1.valid()) {
+    visibility1 = 0;
+  }
+
+  BoundBox bounds = BoundBox::empty;
+  if (b0.valid()) {
+    bounds.grow(b0);
+  }
+  if (b1.valid()) {
+    bounds.grow(b1);
+  }
+  if (!bounds.valid()) {
+    bounds = BoundBox(zero_float3());
+  }
+
+  const float3 origin = bounds.min;
+  const uint exponent_x = quantize_exponent(origin.x, bounds.max.x);
+  const uint exponent_y = quantize_exponent(origin.y, bounds.max.y);
+  const uint exponent_z = quantize_exponent(origin.z, bounds.max.z);
+  const float3 scale = make_float3(__uint_as_float(exponent_x << 23),
+                                   __uint_as_float(exponent_y << 23),
+                                   __uint_as_float(exponent_z << 23));
+
+  uint quantized[4] = {0, 0, 0, 0};
+  const BoundBox *child_bounds[2] = {&b0, &b1};
+  for (int i = 0; i < 2; i++) {
+    const BoundBox &b = *child_bounds[i];
+    if (!b.valid()) {
+      continue;
+    }
+    quantized[i * 2 + 0] = quantize_lower(b.min.x, origin.x, scale.x) |
+                           (quantize_lower(b.min.y, origin.y, scale.y) << 8) |
+                           (quantize_lower(b.min.z, origin.z, scale.z) << 16);
+    quantized[i * 2 + 1] = quantize_upper(b.max.x, origin.x, scale.x) |
+                           (quantize_upper(b.max.y, origin.y, scale.y) << 8) |
+                           (quantize_upper(b.max.z, origin.z, scale.z) << 16);
+  }
+
+  int4 data[BVH_QUANTIZED_NODE_SIZE] = {
+      make_int4(visibility0 & ~PATH_RAY_NODE_UNALIGNED,
+                (visibility1 & ~PATH_RAY_NODE_UNALIGNED) | PATH_RAY_NODE_QUANTIZED,
+                c0,
+                c1),
+      make_int4(__float_as_int(origin.x),
+                __float_as_int(origin.y),
+                __float_as_int(origin.z),
+                exponent_x | (exponent_y << 8) | (exponent_z << 16)),
+      make_int4(quantized[0], quantized[1], quantized[2], quantized[3]),
+  };
+
+  memcpy(&pack.nodes[idx], data, sizeof(int4) * BVH_QUANTIZED_NODE_SIZE);
+}
+
+int BVH2::inner_node_size(const BVHNode *node) const
+{
+  if (node->has_unaligned()) {
+    return BVH_UNALIGNED_NODE_SIZE;
+  }
+  return (params.use_quantized_nodes) ? BVH_QUANTIZED_NODE_SIZE : BVH_NODE_SIZE;
+}
+
 void BVH2::pack_unaligned_inner(const BVHStackEntry &e,
                                 const BVHStackEntry &e0,
                                 const BVHStackEntry &e1)
@@ -246,14 +376,16 @@ void BVH2::pack_nodes(const BVHNode *root)
   const size_t num_leaf_nodes = root->getSubtreeSize(BVH_STAT_LEAF_COUNT);
   assert(num_leaf_nodes <= num_nodes);
   const size_t num_inner_nodes = num_nodes - num_leaf_nodes;
+  const size_t aligned_node_size = (params.use_quantized_nodes) ? BVH_QUANTIZED_NODE_SIZE :
+                                                                  BVH_NODE_SIZE;
   size_t node_size;
   if (params.use_unaligned_nodes) {
     const size_t num_unaligned_nodes = root->getSubtreeSize(BVH_STAT_UNALIGNED_INNER_COUNT);
     node_size = (num_unaligned_nodes * BVH_UNALIGNED_NODE_SIZE) +
-                (num_inner_nodes - num_unaligned_nodes) * BVH_NODE_SIZE;
+                (num_inner_nodes - num_unaligned_nodes) * aligned_node_size;
   }
   else {
-    node_size = num_inner_nodes * BVH_NODE_SIZE;
+    node_size = num_inner_nodes * aligned_node_size;
   }
   /* Resize arrays */
   pack.nodes.clear();
@@ -276,7 +408,7 @@ void BVH2::pack_nodes(const BVHNode *root)
   }
   else {
     stack.push_back(BVHStackEntry(root, nextNodeIdx));
-    nextNodeIdx += root->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE : BVH_NODE_SIZE;
+    nextNodeIdx += inner_node_size(root);
   }
 
   while (stack.size()) {
@@ -297,8 +429,7 @@ void BVH2::pack_nodes(const BVHNode *root)
         }
         else {
           idx[i] = nextNodeIdx;
-          nextNodeIdx += e.node->get_child(i)->has_unaligned() ? BVH_UNALIGNED_NODE_SIZE :
-                                                                 BVH_NODE_SIZE;
+          nextNodeIdx += inner_node_size(e.node->get_child(i));
         }
       }
 
@@ -319,10 +450,15 @@ void BVH2::refit_nodes()
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
-  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+  float sah = 0.0f;
+  refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility, sah, 0);
+
+  /* Same measure as BVHNode::computeSubtreeSAHCost(), so it can be compared to the cost of the
+   * tree when it was built. */
+  refit_sah_cost = (bbox.valid()) ? sah / bbox.safe_area() : build_sah_cost;
 }
 
-void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
+void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah, int depth)
 {
   if (leaf) {
     /* refit leaf node */
@@ -340,26 +476,45 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     leaf_data[0].z = __uint_as_float(visibility);
     leaf_data[0].w = __uint_as_float(data[0].w);
     memcpy(&pack.leaf_nodes[idx], leaf_data, sizeof(float4) * BVH_NODE_LEAF_SIZE);
+
+    sah = bbox.safe_area() * params.primitive_cost(c1 - c0);
   }
   else {
-    assert(idx + BVH_NODE_SIZE <= pack.nodes.size());
+    assert(idx + BVH_QUANTIZED_NODE_SIZE <= pack.nodes.size());
 
     const int4 *data = &pack.nodes[idx];
     const bool is_unaligned = (data[0].x & PATH_RAY_NODE_UNALIGNED) != 0;
+    const bool is_quantized = !is_unaligned && (data[0].y & PATH_RAY_NODE_QUANTIZED) != 0;
     const int c0 = data[0].z;
     const int c1 = data[0].w;
     /* refit inner node, set bbox from children */
     BoundBox bbox0 = BoundBox::empty, bbox1 = BoundBox::empty;
     uint visibility0 = 0, visibility1 = 0;
-
-    refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0);
-    refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1);
+    float sah0 = 0.0f, sah1 = 0.0f;
+
+    /* Children write to separate nodes, so the upper levels of the tree can be refit in
+     * parallel. */
+    if (depth < BVH_REFIT_PARALLEL_DEPTH) {
+      tbb::task_group tasks;
+      tasks.run([&] {
+        refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, sah0, depth + 1);
+      });
+      refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, sah1, depth + 1);
+      tasks.wait();
+    }
+    else {
+      refit_node((c0 < 0) ? -c0 - 1 : c0, (c0 < 0), bbox0, visibility0, sah0, depth + 1);
+      refit_node((c1 < 0) ? -c1 - 1 : c1, (c1 < 0), bbox1, visibility1, sah1, depth + 1);
+    }
 
     if (is_unaligned) {
       Transform aligned_space = transform_identity();
       pack_unaligned_node(
           idx, aligned_space, aligned_space, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
+    else if (is_quantized) {
+      pack_quantized_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
+    }
     else {
       pack_aligned_node(idx, bbox0, bbox1, c0, c1, visibility0, visibility1);
     }
@@ -367,6 +522,7 @@ void BVH2::refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility)
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    sah = bbox.safe_area() * params.node_cost(2) + sah0 + sah1;
   }
 }
 
@@ -607,6 +763,10 @@ void BVH2::pack_instances(size_t nodes_size, size_t leaf_nodes_size)
           nsize = BVH_UNALIGNED_NODE_SIZE;
           nsize_bbox = 0;
         }
+        else if (bvh_nodes[i].y & PATH_RAY_NODE_QUANTIZED) {
+          nsize = BVH_QUANTIZED_NODE_SIZE;
+          nsize_bbox = 0;
+        }
         else {
           nsize = BVH_NODE_SIZE;
           nsize_bbox = 0;
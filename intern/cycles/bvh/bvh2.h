@@ -29,6 +29,12 @@ CCL_NAMESPACE_BEGIN
 #define BVH_NODE_SIZE 4
 #define BVH_NODE_LEAF_SIZE 1
 #define BVH_UNALIGNED_NODE_SIZE 7
+#define BVH_QUANTIZED_NODE_SIZE 3
+
+/* Rebuild a refit BVH once its SAH cost grew by this factor since it was built. */
+#define BVH_REFIT_MAX_SAH_COST_FACTOR 1.5f
+/* Refit subtrees in parallel up to this depth of the tree. */
+#define BVH_REFIT_PARALLEL_DEPTH 6
 
 /* Pack Utility */
 struct BVHStackEntry {
@@ -48,6 +54,9 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Test if the quality of the tree got too bad after refitting, compared to when it was built. */
+  bool need_rebuild() const;
+
   PackedBVH pack;
 
  protected:
@@ -57,6 +66,11 @@ class BVH2 : public BVH {
        const vector<Geometry *> &geometry,
        const vector<Object *> &objects);
 
+  /* SAH cost of the tree when it was built and after the last refit, relative to the surface
+   * area of the root. */
+  float build_sah_cost;
+  float refit_sah_cost;
+
   /* Building process. */
   virtual BVHNode *widen_children_nodes(const BVHNode *root);
 
@@ -76,6 +90,16 @@ class BVH2 : public BVH {
                          int c1,
                          uint visibility0,
                          uint visibility1);
+  void pack_quantized_node(int idx,
+                           const BoundBox &b0,
+                           const BoundBox &b1,
+                           int c0,
+                           int c1,
+                           uint visibility0,
+                           uint visibility1);
+
+  /* Number of packed elements used by an inner node. */
+  int inner_node_size(const BVHNode *node) const;
 
   void pack_unaligned_inner(const BVHStackEntry &e,
                             const BVHStackEntry &e0,
@@ -92,7 +116,7 @@ class BVH2 : public BVH {
 
   /* refit */
   void refit_nodes();
-  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility);
+  void refit_node(int idx, bool leaf, BoundBox &bbox, uint &visibility, float &sah, int depth);
 
   /* Refit range of primitives. */
   void refit_primitives(int start, int end, BoundBox &bbox, uint &visibility);
@@ -50,6 +50,7 @@
 #  include "util/util_logging.h"
 #  include "util/util_progress.h"
 #  include "util/util_stats.h"
+#  include "util/util_tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
@@ -347,27 +348,34 @@ void BVHEmbree::build(Progress &progress, Stats *stats, RTCDevice rtc_device_)
                                                         RTC_BUILD_QUALITY_MEDIUM);
   rtcSetSceneBuildQuality(scene, build_quality);
 
-  int i = 0;
-  foreach (Object *ob, objects) {
-    if (params.top_level) {
-      if (!ob->is_traceable()) {
-        ++i;
-        continue;
-      }
-      if (!ob->get_geometry()->is_instanced()) {
-        add_object(ob, i);
-      }
-      else {
-        add_instance(ob, i);
-      }
-    }
-    else {
-      add_object(ob, i);
-    }
-    ++i;
-    if (progress.get_cancel())
-      return;
-  }
+  /* Fill in the Embree geometry of the objects in parallel, creating and attaching geometry to a
+   * scene is thread-safe in Embree. For scenes with many unique objects copying the vertex and
+   * index buffers takes a significant part of the build time. Geometry IDs are derived from the
+   * object index, so the resulting scene does not depend on the order the tasks run in. */
+  static const int OBJECTS_PER_TASK = 32;
+  parallel_for(blocked_range<size_t>(0, objects.size(), OBJECTS_PER_TASK),
+               [&](const blocked_range<size_t> &r) {
+                 if (progress.get_cancel()) {
+                   return;
+                 }
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   Object *ob = objects[i];
+                   if (params.top_level) {
+                     if (!ob->is_traceable()) {
+                       continue;
+                     }
+                     if (!ob->get_geometry()->is_instanced()) {
+                       add_object(ob, i);
+                     }
+                     else {
+                       add_instance(ob, i);
+                     }
+                   }
+                   else {
+                     add_object(ob, i);
+                   }
+                 }
+               });
 
   if (progress.get_cancel()) {
     return;
@@ -675,17 +683,23 @@ void BVHEmbree::refit(Progress &progress)
 {
   progress.set_substatus("Refitting BVH nodes");
 
-  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. */
+  /* Update all vertex buffers, then tell Embree to rebuild/-fit the BVHs. Geometry which only
+   * moved to a different offset in the packed arrays keeps its vertex buffers, only the primitive
+   * offset stored in the user data has to be updated for it. */
   unsigned geom_id = 0;
   foreach (Object *ob, objects) {
     if (!params.top_level || (ob->is_traceable() && !ob->get_geometry()->is_instanced())) {
       Geometry *geom = ob->get_geometry();
+      const Attribute *attr_mP = geom->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+      const bool update_verts = geom->is_modified() || (attr_mP && attr_mP->modified);
 
       if (geom->geometry_type == Geometry::MESH || geom->geometry_type == Geometry::VOLUME) {
         Mesh *mesh = static_cast<Mesh *>(geom);
         if (mesh->num_triangles() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id);
-          set_tri_vertex_buffer(geom, mesh, true);
+          if (update_verts) {
+            set_tri_vertex_buffer(geom, mesh, true);
+          }
           rtcSetGeometryUserData(geom, (void *)mesh->prim_offset);
           rtcCommitGeometry(geom);
         }
@@ -694,7 +708,9 @@ void BVHEmbree::refit(Progress &progress)
         Hair *hair = static_cast<Hair *>(geom);
         if (hair->num_curves() > 0) {
           RTCGeometry geom = rtcGetGeometry(scene, geom_id + 1);
-          set_curve_vertex_buffer(geom, hair, true);
+          if (update_verts) {
+            set_curve_vertex_buffer(geom, hair, true);
+          }
           rtcSetGeometryUserData(geom, (void *)hair->curve_segment_offset);
           rtcCommitGeometry(geom);
         }
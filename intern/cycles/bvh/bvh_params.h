@@ -95,6 +95,11 @@ class BVHParams {
    */
   bool use_unaligned_nodes;
 
+  /* Store the bounds of aligned nodes quantized to 8 bits relative to the node bounds.
+   * Uses less memory, at the cost of looser bounds.
+   */
+  bool use_quantized_nodes;
+
   /* Split time range to this number of steps and create leaf node for each
    * of this time steps.
    *
@@ -136,6 +141,7 @@ class BVHParams {
     top_level = false;
     bvh_layout = BVH_LAYOUT_BVH2;
     use_unaligned_nodes = false;
+    use_quantized_nodes = false;
 
     num_motion_curve_steps = 0;
     num_motion_triangle_steps = 0;
@@ -261,7 +261,9 @@ void CPUDevice::tex_alloc(device_texture &mem)
   }
 
   texture_info[slot] = mem.info;
-  texture_info[slot].data = (uint64_t)mem.host_pointer;
+  if (!mem.info.use_cache) {
+    texture_info[slot].data = (uint64_t)mem.host_pointer;
+  }
   need_texture_info = true;
 }
 
@@ -324,8 +326,14 @@ void *CPUDevice::get_cpu_osl_memory()
 #endif
 }
 
-bool CPUDevice::load_kernels(const uint /*kernel_features*/)
+bool CPUDevice::load_kernels(const uint kernel_features)
 {
+  /* Kernels loaded for denoising only don't tell which features the scene uses. */
+  if (kernel_features & KERNEL_FEATURE_PATH_TRACING) {
+    kernels.use_kernel_features(kernel_features);
+    VLOG(1) << "Will be using " << kernels.integrator_megakernel.get_uarch_name()
+            << " integrator kernels.";
+  }
   return true;
 }
 
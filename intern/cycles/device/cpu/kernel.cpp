@@ -26,21 +26,24 @@ CCL_NAMESPACE_BEGIN
       KERNEL_NAME_EVAL(cpu_avx, name), KERNEL_NAME_EVAL(cpu_avx2, name)
 
 #define REGISTER_KERNEL(name) name(KERNEL_FUNCTIONS(name))
+#define REGISTER_SPECIALIZED_KERNEL(name) \
+  name(KERNEL_FUNCTIONS(name), KERNEL_NAME_EVAL(cpu_avx2_basic, name))
 
 CPUKernels::CPUKernels()
     : /* Integrator. */
-      REGISTER_KERNEL(integrator_init_from_camera),
-      REGISTER_KERNEL(integrator_init_from_bake),
-      REGISTER_KERNEL(integrator_intersect_closest),
-      REGISTER_KERNEL(integrator_intersect_shadow),
-      REGISTER_KERNEL(integrator_intersect_subsurface),
-      REGISTER_KERNEL(integrator_intersect_volume_stack),
-      REGISTER_KERNEL(integrator_shade_background),
-      REGISTER_KERNEL(integrator_shade_light),
-      REGISTER_KERNEL(integrator_shade_shadow),
-      REGISTER_KERNEL(integrator_shade_surface),
-      REGISTER_KERNEL(integrator_shade_volume),
-      REGISTER_KERNEL(integrator_megakernel),
+      REGISTER_SPECIALIZED_KERNEL(integrator_init_from_camera),
+      REGISTER_SPECIALIZED_KERNEL(integrator_init_from_bake),
+      REGISTER_SPECIALIZED_KERNEL(integrator_intersect_closest),
+      REGISTER_SPECIALIZED_KERNEL(integrator_intersect_shadow),
+      REGISTER_SPECIALIZED_KERNEL(integrator_intersect_subsurface),
+      REGISTER_SPECIALIZED_KERNEL(integrator_intersect_volume_stack),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_background),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_light),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_shadow),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_surface),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_surface_raytrace),
+      REGISTER_SPECIALIZED_KERNEL(integrator_shade_volume),
+      REGISTER_SPECIALIZED_KERNEL(integrator_megakernel),
       /* Shader evaluation. */
       REGISTER_KERNEL(shader_eval_displace),
       REGISTER_KERNEL(shader_eval_background),
@@ -55,6 +58,26 @@ CPUKernels::CPUKernels()
 {
 }
 
+void CPUKernels::use_kernel_features(const uint kernel_features)
+{
+  const bool use_basic = (kernel_features & ~KERNEL_FEATURE_CPU_BASIC) == 0;
+
+  integrator_init_from_camera.use_basic_kernel(use_basic);
+  integrator_init_from_bake.use_basic_kernel(use_basic);
+  integrator_intersect_closest.use_basic_kernel(use_basic);
+  integrator_intersect_shadow.use_basic_kernel(use_basic);
+  integrator_intersect_subsurface.use_basic_kernel(use_basic);
+  integrator_intersect_volume_stack.use_basic_kernel(use_basic);
+  integrator_shade_background.use_basic_kernel(use_basic);
+  integrator_shade_light.use_basic_kernel(use_basic);
+  integrator_shade_shadow.use_basic_kernel(use_basic);
+  integrator_shade_surface.use_basic_kernel(use_basic);
+  integrator_shade_surface_raytrace.use_basic_kernel(use_basic);
+  integrator_shade_volume.use_basic_kernel(use_basic);
+  integrator_megakernel.use_basic_kernel(use_basic);
+}
+
+#undef REGISTER_SPECIALIZED_KERNEL
 #undef REGISTER_KERNEL
 #undef KERNEL_FUNCTIONS
 
@@ -48,6 +48,7 @@ class CPUKernels {
   IntegratorShadeFunction integrator_shade_light;
   IntegratorShadeFunction integrator_shade_shadow;
   IntegratorShadeFunction integrator_shade_surface;
+  IntegratorShadeFunction integrator_shade_surface_raytrace;
   IntegratorShadeFunction integrator_shade_volume;
   IntegratorShadeFunction integrator_megakernel;
 
@@ -106,6 +107,10 @@ class CPUKernels {
   CPUKernelFunction<void (*)(const KernelGlobals *, float *, int, int, int, int, int)> bake;
 
   CPUKernels();
+
+  /* Switch the integrator kernels to the variants specialized for scenes using only the
+   * KERNEL_FEATURE_CPU_BASIC features, when the requested kernel features allow it. */
+  void use_kernel_features(const uint kernel_features);
 };
 
 CCL_NAMESPACE_END
@@ -33,10 +33,26 @@ template<typename FunctionType> class CPUKernelFunction {
                     FunctionType kernel_sse3,
                     FunctionType kernel_sse41,
                     FunctionType kernel_avx,
-                    FunctionType kernel_avx2)
+                    FunctionType kernel_avx2,
+                    FunctionType kernel_avx2_basic = nullptr)
   {
     kernel_info_ = get_best_kernel_info(
         kernel_default, kernel_sse2, kernel_sse3, kernel_sse41, kernel_avx, kernel_avx2);
+    generic_kernel_info_ = kernel_info_;
+
+    /* The specialized kernel is only compiled with AVX2 optimizations, so only use it when the
+     * generic AVX2 kernel is used as well. */
+    if (kernel_avx2_basic != nullptr && kernel_info_.kernel == kernel_avx2) {
+      basic_kernel_info_ = KernelInfo("AVX2 basic", kernel_avx2_basic);
+    }
+  }
+
+  /* Use the kernel specialized for the KERNEL_FEATURE_CPU_BASIC features when available, or the
+   * generic kernel supporting all features otherwise. */
+  void use_basic_kernel(const bool use_basic)
+  {
+    kernel_info_ = (use_basic && basic_kernel_info_.kernel) ? basic_kernel_info_ :
+                                                               generic_kernel_info_;
   }
 
   template<typename... Args> inline auto operator()(Args... args) const
@@ -119,6 +135,8 @@ template<typename FunctionType> class CPUKernelFunction {
   }
 
   KernelInfo kernel_info_;
+  KernelInfo generic_kernel_info_;
+  KernelInfo basic_kernel_info_;
 };
 
 CCL_NAMESPACE_END
@@ -563,6 +563,7 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
     device_memory *max_mem = NULL;
     size_t max_size = 0;
     bool max_is_image = false;
+    MemoryResidency max_residency = MEM_RESIDENCY_HIGH;
 
     thread_scoped_lock lock(cuda_mem_map_mutex);
     foreach (CUDAMemMap::value_type &pair, cuda_mem_map) {
@@ -589,8 +590,13 @@ void CUDADevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
+      /* Try to move largest allocation, prefer moving memory which is less important to keep
+       * in device memory, and images. */
+      if (max_mem == NULL || mem.residency < max_residency ||
+          (mem.residency == max_residency &&
+           (is_image > max_is_image ||
+            (is_image == max_is_image && mem.device_size > max_size)))) {
+        max_residency = mem.residency;
         max_is_image = is_image;
         max_size = mem.device_size;
         max_mem = &mem;
@@ -694,6 +700,7 @@ CUDADevice::CUDAMem *CUDADevice::generic_alloc(device_memory &mem, size_t pitch_
     if (mem_alloc_result == CUDA_SUCCESS) {
       cuda_assert(cuMemHostGetDevicePointer_v2(&device_pointer, shared_pointer, 0));
       map_host_used += size;
+      stats.mem_host_mapped_alloc(size);
       status = " in host memory";
     }
   }
@@ -791,6 +798,7 @@ void CUDADevice::generic_free(device_memory &mem)
         }
       }
       map_host_used -= mem.device_size;
+      stats.mem_host_mapped_free(mem.device_size);
     }
     else {
       /* Free device memory. */
@@ -30,6 +30,7 @@ device_memory::device_memory(Device *device, const char *name, MemoryType type)
       data_height(0),
       data_depth(0),
       type(type),
+      residency(MEM_RESIDENCY_NORMAL),
       name(name),
       device(device),
       device_pointer(0),
@@ -53,6 +54,7 @@ device_memory::device_memory(device_memory &&other) noexcept
       data_height(other.data_height),
       data_depth(other.data_depth),
       type(other.type),
+      residency(other.residency),
       name(other.name),
       device(other.device),
       device_pointer(other.device_pointer),
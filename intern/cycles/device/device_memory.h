@@ -40,6 +40,15 @@ enum MemoryType {
   MEM_TEXTURE,
 };
 
+/* Importance of keeping memory in device memory when it does not fit all the data. Memory with a
+ * lower residency is moved to host memory first, where it is slower to access. */
+
+enum MemoryResidency {
+  MEM_RESIDENCY_LOW,
+  MEM_RESIDENCY_NORMAL,
+  MEM_RESIDENCY_HIGH,
+};
+
 /* Supported Data Types */
 
 enum DataType {
@@ -257,6 +266,7 @@ class device_memory {
   size_t data_height;
   size_t data_depth;
   MemoryType type;
+  MemoryResidency residency;
   const char *name;
 
   /* Pointers. */
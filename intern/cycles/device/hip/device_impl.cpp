@@ -536,6 +536,7 @@ void HIPDevice::move_textures_to_host(size_t size, bool for_texture)
     device_memory *max_mem = NULL;
     size_t max_size = 0;
     bool max_is_image = false;
+    MemoryResidency max_residency = MEM_RESIDENCY_HIGH;
 
     thread_scoped_lock lock(hip_mem_map_mutex);
     foreach (HIPMemMap::value_type &pair, hip_mem_map) {
@@ -562,8 +563,13 @@ void HIPDevice::move_textures_to_host(size_t size, bool for_texture)
         continue;
       }
 
-      /* Try to move largest allocation, prefer moving images. */
-      if (is_image > max_is_image || (is_image == max_is_image && mem.device_size > max_size)) {
+      /* Try to move largest allocation, prefer moving memory which is less important to keep
+       * in device memory, and images. */
+      if (max_mem == NULL || mem.residency < max_residency ||
+          (mem.residency == max_residency &&
+           (is_image > max_is_image ||
+            (is_image == max_is_image && mem.device_size > max_size)))) {
+        max_residency = mem.residency;
         max_is_image = is_image;
         max_size = mem.device_size;
         max_mem = &mem;
@@ -666,6 +672,7 @@ HIPDevice::HIPMem *HIPDevice::generic_alloc(device_memory &mem, size_t pitch_pad
     if (mem_alloc_result == hipSuccess) {
       hip_assert(hipHostGetDevicePointer(&device_pointer, shared_pointer, 0));
       map_host_used += size;
+      stats.mem_host_mapped_alloc(size);
       status = " in host memory";
     }
   }
@@ -763,6 +770,7 @@ void HIPDevice::generic_free(device_memory &mem)
         }
       }
       map_host_used -= mem.device_size;
+      stats.mem_host_mapped_free(mem.device_size);
     }
     else {
       /* Free device memory. */
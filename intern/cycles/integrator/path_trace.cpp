@@ -67,6 +67,8 @@ PathTrace::PathTrace(Device *device,
 
 PathTrace::~PathTrace()
 {
+  denoise_async_wait();
+
   /* Destroy any GPU resource which was used for graphics interop.
    * Need to have access to the PathTraceDisplay as it is the only source of drawing context which
    * is used for interop. */
@@ -79,6 +81,8 @@ PathTrace::~PathTrace()
 
 void PathTrace::load_kernels()
 {
+  denoise_async_wait();
+
   if (denoiser_) {
     denoiser_->load_kernels(progress_);
   }
@@ -134,11 +138,15 @@ void PathTrace::reset(const BufferParams &full_params, const BufferParams &big_t
   render_state_.has_denoised_result = false;
   render_state_.tile_written = false;
 
+  denoise_async_.is_outdated = true;
+
   did_draw_after_reset_ = false;
 }
 
 void PathTrace::device_free()
 {
+  denoise_async_wait();
+
   /* Free render buffers used by the path trace work to reduce memory peak. */
   BufferParams empty_params;
   empty_params.pass_stride = 0;
@@ -463,6 +471,8 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
 
 void PathTrace::set_denoiser_params(const DenoiseParams &params)
 {
+  denoise_async_wait();
+
   render_scheduler_.set_denoiser_params(params);
 
   if (!params.use) {
@@ -501,6 +511,8 @@ void PathTrace::cryptomatte_postprocess(const RenderWork &render_work)
 
 void PathTrace::denoise(const RenderWork &render_work)
 {
+  denoise_async_apply_result();
+
   if (!render_work.tile.denoise) {
     return;
   }
@@ -510,6 +522,16 @@ void PathTrace::denoise(const RenderWork &render_work)
     return;
   }
 
+  /* Intermediate results are denoised while path tracing continues. The final result is always
+   * denoised synchronously, so that it is complete when written. */
+  if (!render_work.tile.write && render_work.path_trace.num_samples > 0) {
+    if (denoise_async_start(render_work)) {
+      return;
+    }
+  }
+
+  denoise_async_wait();
+
   VLOG(3) << "Perform denoising work.";
 
   const double start_time = time_dt();
@@ -556,6 +578,93 @@ void PathTrace::denoise(const RenderWork &render_work)
   render_scheduler_.report_denoise_time(render_work, time_dt() - start_time);
 }
 
+bool PathTrace::denoise_async_start(const RenderWork &render_work)
+{
+  if (denoise_async_.denoise_thread) {
+    /* Previous denoising is still running, keep displaying its result rather than stalling the
+     * path tracing. */
+    VLOG(3) << "Skip denoising work, asynchronous denoising is in progress.";
+    return true;
+  }
+
+  Device *denoiser_device = denoiser_->get_denoiser_device();
+  if (!denoiser_device) {
+    return false;
+  }
+
+  VLOG(3) << "Perform asynchronous denoising work.";
+
+  if (!denoise_async_.buffers || denoise_async_.buffers->buffer.device != denoiser_device) {
+    denoise_async_.buffers = make_unique<RenderBuffers>(denoiser_device);
+  }
+  denoise_async_.buffers->reset(render_state_.effective_big_tile_params);
+  copy_to_render_buffers(denoise_async_.buffers.get());
+
+  denoise_async_.num_samples = get_num_samples_in_buffer();
+  denoise_async_.render_work = make_unique<RenderWork>(render_work);
+  denoise_async_.is_finished = false;
+  denoise_async_.is_denoised = false;
+  denoise_async_.is_outdated = false;
+
+  denoise_async_.denoise_thread = make_unique<thread>([this]() {
+    const double start_time = time_dt();
+
+    RenderBuffers *buffers = denoise_async_.buffers.get();
+    denoise_async_.is_denoised = denoiser_->denoise_buffer(
+        buffers->params, buffers, denoise_async_.num_samples, true);
+
+    denoise_async_.time = time_dt() - start_time;
+    denoise_async_.is_finished = true;
+  });
+
+  return true;
+}
+
+void PathTrace::denoise_async_apply_result()
+{
+  if (!denoise_async_.denoise_thread || !denoise_async_.is_finished) {
+    return;
+  }
+
+  denoise_async_wait();
+
+  render_scheduler_.report_denoise_time(*denoise_async_.render_work, denoise_async_.time);
+
+  if (!denoise_async_.is_denoised || denoise_async_.is_outdated ||
+      denoise_async_.buffers->params.modified(render_state_.effective_big_tile_params)) {
+    VLOG(3) << "Discard outdated asynchronous denoising result.";
+    return;
+  }
+
+  VLOG(3) << "Apply asynchronous denoising result.";
+
+  /* Only the denoised passes are copied, make sure the host side of the render buffers has the
+   * samples which were path traced while denoising.
+   *
+   * The result was denoised with fewer samples than the buffers have now, rescale it so it is
+   * displayed as bright as the noisy passes it's divided by the current sample count with. */
+  RenderBuffers *buffers = denoise_async_.buffers.get();
+  const int denoised_num_samples = denoise_async_.num_samples;
+  const int num_samples = get_num_samples_in_buffer();
+  buffers->copy_from_device();
+  tbb::parallel_for_each(path_trace_works_, [&](unique_ptr<PathTraceWork> &path_trace_work) {
+    path_trace_work->copy_render_buffers_from_device();
+    path_trace_work->copy_from_denoised_render_buffers(buffers, denoised_num_samples, num_samples);
+  });
+
+  render_state_.has_denoised_result = true;
+}
+
+void PathTrace::denoise_async_wait()
+{
+  if (!denoise_async_.denoise_thread) {
+    return;
+  }
+
+  denoise_async_.denoise_thread->join();
+  denoise_async_.denoise_thread.reset();
+}
+
 void PathTrace::set_output_driver(unique_ptr<OutputDriver> driver)
 {
   output_driver_ = move(driver);
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "integrator/denoiser.h"
 #include "integrator/pass_accessor.h"
 #include "integrator/path_trace_work.h"
@@ -213,6 +215,20 @@ class PathTrace {
   void write_tile_buffer(const RenderWork &render_work);
   void finalize_full_buffer_on_disk(const RenderWork &render_work);
 
+  /* Asynchronous denoising.
+   *
+   * Intermediate viewport results are denoised from a snapshot of the render buffers in a
+   * separate thread, while path tracing of the following samples continues. The denoised passes
+   * are copied back to the render buffers of the path trace works from the render thread, once
+   * the denoiser has finished.
+   *
+   * Start returns false if the denoiser can not run asynchronously. */
+  bool denoise_async_start(const RenderWork &render_work);
+  void denoise_async_apply_result();
+  /* Wait for the asynchronous denoising to finish, discarding its result. Is to be called before
+   * the denoiser is modified or used synchronously. */
+  void denoise_async_wait();
+
   /* Get number of samples in the current state of the render buffers. */
   int get_num_samples_in_buffer();
 
@@ -317,6 +333,26 @@ class PathTrace {
   struct {
     RenderBuffers *render_buffers = nullptr;
   } full_frame_state_;
+
+  /* State of the asynchronous denoising. */
+  struct {
+    unique_ptr<thread> denoise_thread;
+
+    /* Snapshot of the render buffers which is being denoised, allocated on the denoiser device. */
+    unique_ptr<RenderBuffers> buffers;
+    int num_samples = 0;
+
+    /* Render work which requested denoising, used to report the denoising time. */
+    unique_ptr<RenderWork> render_work;
+
+    /* Written by the denoising thread. */
+    std::atomic<bool> is_finished = false;
+    bool is_denoised = false;
+    double time = 0.0;
+
+    /* Render buffers were reset since the snapshot was taken, the result is outdated. */
+    bool is_outdated = false;
+  } denoise_async_;
 };
 
 CCL_NAMESPACE_END
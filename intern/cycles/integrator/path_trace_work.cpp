@@ -119,14 +119,21 @@ void PathTraceWork::copy_from_render_buffers(const RenderBuffers *render_buffers
   copy_render_buffers_to_device();
 }
 
-void PathTraceWork::copy_from_denoised_render_buffers(const RenderBuffers *render_buffers)
+void PathTraceWork::copy_from_denoised_render_buffers(const RenderBuffers *render_buffers,
+                                                      const int denoised_num_samples,
+                                                      const int num_samples)
 {
   const int64_t width = effective_buffer_params_.width;
   const int64_t offset_y = effective_buffer_params_.full_y - effective_big_tile_params_.full_y;
   const int64_t offset = offset_y * width;
 
-  render_buffers_host_copy_denoised(
-      buffers_.get(), effective_buffer_params_, render_buffers, effective_buffer_params_, offset);
+  render_buffers_host_copy_denoised(buffers_.get(),
+                                    effective_buffer_params_,
+                                    render_buffers,
+                                    effective_buffer_params_,
+                                    offset,
+                                    denoised_num_samples,
+                                    num_samples);
 
   copy_render_buffers_to_device();
 }
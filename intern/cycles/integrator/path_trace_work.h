@@ -105,8 +105,13 @@ class PathTraceWork {
   /* Special version of the `copy_from_render_buffers()` which only copies denoised passes from the
    * given render buffers, leaving rest of the passes.
    *
-   * Same notes about device copying applies to this call as well. */
-  void copy_from_denoised_render_buffers(const RenderBuffers *render_buffers);
+   * Same notes about device copying applies to this call as well.
+   *
+   * The sample counts are used to rescale the denoised passes to the samples which were rendered
+   * since the given buffers were denoised, see `render_buffers_host_copy_denoised()`. */
+  void copy_from_denoised_render_buffers(const RenderBuffers *render_buffers,
+                                         const int denoised_num_samples = 0,
+                                         const int num_samples = 0);
 
   /* Copy render buffers to/from device using an appropriate device queue when needed so that
    * things are executed in order with the `render_samples()`. */
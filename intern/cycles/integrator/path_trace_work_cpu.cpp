@@ -27,12 +27,18 @@
 #include "render/buffers.h"
 #include "render/scene.h"
 
+#include "util/util_algorithm.h"
 #include "util/util_atomic.h"
+#include "util/util_debug.h"
 #include "util/util_logging.h"
 #include "util/util_tbb.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* Number of paths rendered together by a thread in wavefront mode. Kept moderate because the CPU
+ * integrator state is big, mostly due to the intersections stored for transparent shadows. */
+static const int WAVEFRONT_NUM_PATHS = 256;
+
 /* Create TBB arena for execution of path tracing and rendering tasks. */
 static inline tbb::task_arena local_tbb_arena_create(const Device *device)
 {
@@ -82,30 +88,68 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
   }
 
   tbb::task_arena local_arena = local_tbb_arena_create(device_);
-  local_arena.execute([&]() {
-    tbb::parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
-      if (is_cancel_requested()) {
-        return;
-      }
 
-      const int y = work_index / image_width;
-      const int x = work_index - y * image_width;
+  if (DebugFlags().cpu.wavefront) {
+    /* Batches of consecutive pixels of a row. */
+    const int64_t row_batches_num = divide_up(image_width, WAVEFRONT_NUM_PATHS);
 
-      KernelWorkTile work_tile;
-      work_tile.x = effective_buffer_params_.full_x + x;
-      work_tile.y = effective_buffer_params_.full_y + y;
-      work_tile.w = 1;
-      work_tile.h = 1;
-      work_tile.start_sample = start_sample;
-      work_tile.num_samples = 1;
-      work_tile.offset = effective_buffer_params_.offset;
-      work_tile.stride = effective_buffer_params_.stride;
+    wavefront_integrator_states_.resize(kernel_thread_globals_.size());
 
-      CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+    local_arena.execute([&]() {
+      tbb::parallel_for(int64_t(0), image_height * row_batches_num, [&](int64_t work_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+        const int y = work_index / row_batches_num;
+        const int x = (work_index - y * row_batches_num) * WAVEFRONT_NUM_PATHS;
+
+        KernelWorkTile work_tile;
+        work_tile.x = effective_buffer_params_.full_x + x;
+        work_tile.y = effective_buffer_params_.full_y + y;
+        work_tile.w = min(int64_t(WAVEFRONT_NUM_PATHS), image_width - x);
+        work_tile.h = 1;
+        work_tile.start_sample = start_sample;
+        work_tile.num_samples = 1;
+        work_tile.offset = effective_buffer_params_.offset;
+        work_tile.stride = effective_buffer_params_.stride;
+
+        const int thread_index = tbb::this_task_arena::current_thread_index();
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+
+        render_samples_wavefront_pipeline(kernel_globals,
+                                          wavefront_integrator_states_[thread_index],
+                                          work_tile,
+                                          samples_num);
+      });
     });
-  });
+  }
+  else {
+    local_arena.execute([&]() {
+      tbb::parallel_for(int64_t(0), total_pixels_num, [&](int64_t work_index) {
+        if (is_cancel_requested()) {
+          return;
+        }
+
+        const int y = work_index / image_width;
+        const int x = work_index - y * image_width;
+
+        KernelWorkTile work_tile;
+        work_tile.x = effective_buffer_params_.full_x + x;
+        work_tile.y = effective_buffer_params_.full_y + y;
+        work_tile.w = 1;
+        work_tile.h = 1;
+        work_tile.start_sample = start_sample;
+        work_tile.num_samples = 1;
+        work_tile.offset = effective_buffer_params_.offset;
+        work_tile.stride = effective_buffer_params_.stride;
+
+        CPUKernelThreadGlobals *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
+
+        render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      });
+    });
+  }
 
   for (CPUKernelThreadGlobals &kernel_globals : kernel_thread_globals_) {
     kernel_globals.stop_profiling();
@@ -161,6 +205,173 @@ void PathTraceWorkCPU::render_samples_full_pipeline(KernelGlobals *kernel_global
   }
 }
 
+void PathTraceWorkCPU::render_samples_wavefront_pipeline(
+    KernelGlobals *kernel_globals,
+    vector<IntegratorStateCPU> &integrator_states,
+    const KernelWorkTile &work_tile,
+    const int samples_num)
+{
+  const bool has_bake = device_scene_->data.bake.use;
+
+  /* The shadow catcher splits a path into the state following it in memory. */
+  const int state_stride = device_scene_->data.integrator.has_shadow_catcher ? 2 : 1;
+  const int paths_num = work_tile.w;
+  const int states_num = paths_num * state_stride;
+
+  if (integrator_states.size() < states_num) {
+    integrator_states.resize(states_num);
+  }
+  IntegratorStateCPU *states = integrator_states.data();
+
+  for (int i = 0; i < states_num; i++) {
+    path_state_init_queues(kernel_globals, &states[i]);
+  }
+
+  /* Paths of pixels which have no more samples to render are inactive. */
+  vector<bool> path_active(paths_num, true);
+  vector<int> queued_states;
+  queued_states.reserve(states_num);
+
+  KernelWorkTile pixel_work_tile = work_tile;
+  pixel_work_tile.w = 1;
+  float *render_buffer = buffers_->buffer.data();
+
+  for (int sample = 0; sample < samples_num; ++sample) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    bool any_path_active = false;
+    for (int i = 0; i < paths_num; i++) {
+      if (!path_active[i]) {
+        continue;
+      }
+
+      IntegratorStateCPU *state = &states[i * state_stride];
+      pixel_work_tile.x = work_tile.x + i;
+
+      const bool is_active = has_bake ? kernels_.integrator_init_from_bake(
+                                            kernel_globals, state, &pixel_work_tile, render_buffer) :
+                                        kernels_.integrator_init_from_camera(
+                                            kernel_globals, state, &pixel_work_tile, render_buffer);
+      if (!is_active) {
+        path_state_init_queues(kernel_globals, state);
+        path_active[i] = false;
+        continue;
+      }
+      any_path_active = true;
+    }
+
+    if (!any_path_active) {
+      break;
+    }
+
+    while (true) {
+      int num_queued[DEVICE_KERNEL_INTEGRATOR_NUM] = {0};
+      bool any_shadow_queued = false;
+
+      for (int i = 0; i < states_num; i++) {
+        const IntegratorStateCPU &state = states[i];
+        if (state.shadow_path.queued_kernel) {
+          num_queued[state.shadow_path.queued_kernel]++;
+          any_shadow_queued = true;
+        }
+        else if (state.path.queued_kernel) {
+          num_queued[state.path.queued_kernel]++;
+        }
+      }
+
+      /* Handle shadow paths first, same as the megakernel, before more of them are created. Then
+       * pick the kernel which has most paths queued. */
+      DeviceKernel kernel = DEVICE_KERNEL_NUM;
+      int max_num_queued = 0;
+      for (int i = 0; i < DEVICE_KERNEL_INTEGRATOR_NUM; i++) {
+        const bool is_shadow_kernel = (i == DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW ||
+                                       i == DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW);
+        if (any_shadow_queued && !is_shadow_kernel) {
+          continue;
+        }
+        if (num_queued[i] > max_num_queued) {
+          kernel = (DeviceKernel)i;
+          max_num_queued = num_queued[i];
+        }
+      }
+
+      if (kernel == DEVICE_KERNEL_NUM) {
+        break;
+      }
+
+      queued_states.clear();
+      for (int i = 0; i < states_num; i++) {
+        const IntegratorStateCPU &state = states[i];
+        const int queued_kernel = (any_shadow_queued) ? state.shadow_path.queued_kernel :
+                                                        state.path.queued_kernel;
+        if (queued_kernel == kernel) {
+          queued_states.push_back(i);
+        }
+      }
+
+      /* Sort by shader, so that paths evaluating the same shader are executed one after the
+       * other for better instruction and data cache usage. */
+      if (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE ||
+          kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE) {
+        std::stable_sort(queued_states.begin(), queued_states.end(), [&](const int a, const int b) {
+          return states[a].path.shader_sort_key < states[b].path.shader_sort_key;
+        });
+      }
+
+      for (const int i : queued_states) {
+        integrator_kernel_execute(kernel_globals, &states[i], kernel, render_buffer);
+      }
+    }
+
+    pixel_work_tile.start_sample++;
+  }
+}
+
+void PathTraceWorkCPU::integrator_kernel_execute(KernelGlobals *kernel_globals,
+                                                 IntegratorStateCPU *state,
+                                                 const DeviceKernel kernel,
+                                                 float *render_buffer) const
+{
+  switch (kernel) {
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST:
+      kernels_.integrator_intersect_closest(kernel_globals, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SHADOW:
+      kernels_.integrator_intersect_shadow(kernel_globals, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_SUBSURFACE:
+      kernels_.integrator_intersect_subsurface(kernel_globals, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_INTERSECT_VOLUME_STACK:
+      kernels_.integrator_intersect_volume_stack(kernel_globals, state);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_BACKGROUND:
+      kernels_.integrator_shade_background(kernel_globals, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_LIGHT:
+      kernels_.integrator_shade_light(kernel_globals, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SHADOW:
+      kernels_.integrator_shade_shadow(kernel_globals, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE:
+      kernels_.integrator_shade_surface(kernel_globals, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE:
+      kernels_.integrator_shade_surface_raytrace(kernel_globals, state, render_buffer);
+      break;
+    case DEVICE_KERNEL_INTEGRATOR_SHADE_VOLUME:
+      kernels_.integrator_shade_volume(kernel_globals, state, render_buffer);
+      break;
+    default:
+      LOG(FATAL) << "Unhandled kernel " << device_kernel_as_string(kernel)
+                 << ", should never happen.";
+      break;
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        int num_samples)
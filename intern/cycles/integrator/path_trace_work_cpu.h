@@ -68,6 +68,19 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Wavefront path tracing routine. Renders all pixels of the given work tile together, executing
+   * one kernel at a time for all paths which have it queued. */
+  void render_samples_wavefront_pipeline(KernelGlobals *kernel_globals,
+                                         vector<IntegratorStateCPU> &integrator_states,
+                                         const KernelWorkTile &work_tile,
+                                         const int samples_num);
+
+  /* Execute the given integrator kernel on the given state. */
+  void integrator_kernel_execute(KernelGlobals *kernel_globals,
+                                 IntegratorStateCPU *state,
+                                 const DeviceKernel kernel,
+                                 float *render_buffer) const;
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -77,6 +90,9 @@ class PathTraceWorkCPU : public PathTraceWork {
    * accessing it, but some "localization" is required to decouple from kernel globals stored
    * on the device level. */
   vector<CPUKernelThreadGlobals> kernel_thread_globals_;
+
+  /* Integrator states of the wavefront path tracing, per thread. */
+  vector<vector<IntegratorStateCPU>> wavefront_integrator_states_;
 };
 
 CCL_NAMESPACE_END
@@ -157,6 +157,8 @@ void RenderScheduler::reset(const BufferParams &buffer_params, int num_samples)
 
   state_.occupancy_num_samples = 0;
   state_.occupancy = 1.0f;
+  state_.occupancy_sum = 0.0;
+  state_.occupancy_sum_num_samples = 0;
 
   first_render_time_.path_trace_per_sample = 0.0;
   first_render_time_.denoise_time = 0.0;
@@ -482,9 +484,19 @@ void RenderScheduler::report_path_trace_occupancy(const RenderWork &render_work,
 {
   state_.occupancy_num_samples = render_work.path_trace.num_samples;
   state_.occupancy = occupancy;
+  state_.occupancy_sum += double(occupancy) * render_work.path_trace.num_samples;
+  state_.occupancy_sum_num_samples += render_work.path_trace.num_samples;
   VLOG(4) << "Measured path tracing occupancy: " << occupancy;
 }
 
+float RenderScheduler::get_average_path_trace_occupancy() const
+{
+  if (state_.occupancy_sum_num_samples == 0) {
+    return 0.0f;
+  }
+  return state_.occupancy_sum / state_.occupancy_sum_num_samples;
+}
+
 void RenderScheduler::report_adaptive_filter_time(const RenderWork &render_work,
                                                   double time,
                                                   bool is_cancelled)
@@ -192,6 +192,10 @@ class RenderScheduler {
   void report_display_update_time(const RenderWork &render_work, double time);
   void report_rebalance_time(const RenderWork &render_work, double time, bool balance_changed);
 
+  /* Average of the reported path tracing occupancy since the last reset, weighted by the number
+   * of samples. Zero when no occupancy was reported. */
+  float get_average_path_trace_occupancy() const;
+
   /* Generate full multi-line report of the rendering process, including rendering parameters,
    * times, and so on. */
   string full_report() const;
@@ -388,6 +392,10 @@ class RenderScheduler {
      * previous work was rendered. */
     int occupancy_num_samples = 0;
     float occupancy = 1.0f;
+
+    /* Sum of the reported occupancy multiplied by the number of samples it was measured for. */
+    double occupancy_sum = 0.0;
+    int occupancy_sum_num_samples = 0;
   } state_;
 
   /* Timing of tasks which were performed at the very first render work at 100% of the
@@ -35,62 +35,94 @@ void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos)
   const double weight = 1.0 / num_infos;
   for (WorkBalanceInfo &balance_info : work_balance_infos) {
     balance_info.weight = weight;
+    balance_info.throughput = 0;
   }
 }
 
-static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_infos)
+/* The balance is based on the throughput of every device: amount of work it performed per second
+ * of time spent. Weights are assigned proportionally to the throughput, so that the time spent by
+ * all devices is expected to equalize.
+ *
+ * The throughput is smoothed over several rebalances, which avoids oscillation caused by noise in
+ * the time measurement, and the balance only changes when the expected gain is big enough. This
+ * is important for a mix of very different devices (such as CPU and GPU), where a direct
+ * correction based on the latest time measurement tends to overshoot. */
+
+/* Influence of the latest measurement on the smoothed throughput. */
+static const double kThroughputSmoothFactor = 0.5;
+
+/* Relative difference between the expected time of the slowest device and the average time at
+ * which weights are changed. */
+static const double kRebalanceThreshold = 0.03;
+
+/* Low occupancy means the device did not get enough work to be fully utilized, so its throughput
+ * at a bigger amount of work is expected to be higher than the measured one. Compensate for this,
+ * but limit the influence of the occupancy since it is only an approximation. */
+static double occupancy_throughput_scale(const float occupancy)
+{
+  return 1.0 / double(clamp(occupancy, 0.5f, 1.0f));
+}
+
+static double calculate_max_relative_time(const vector<WorkBalanceInfo> &work_balance_infos,
+                                          const vector<double> &weights)
 {
+  /* Expected time of every device when the weights are used, relative to the time of the even
+   * distribution of the work across all devices. */
+  double max_time = 0;
   double total_time = 0;
-  for (const WorkBalanceInfo &info : work_balance_infos) {
-    total_time += info.time_spent;
+  const int num_infos = work_balance_infos.size();
+  for (int i = 0; i < num_infos; ++i) {
+    const double time = weights[i] / work_balance_infos[i].throughput;
+    max_time = max(max_time, time);
+    total_time += time;
   }
-  return total_time;
+  return max_time * num_infos / total_time;
 }
 
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
-
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
   const int num_infos = work_balance_infos.size();
 
-  const double total_time = calculate_total_time(work_balance_infos);
-  const double time_average = total_time / num_infos;
-
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
+  double total_throughput = 0;
+  for (WorkBalanceInfo &info : work_balance_infos) {
+    if (info.time_spent <= 0) {
+      /* No statistics for this device, can not rebalance reliably. */
+      return false;
+    }
 
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
+    const double throughput = info.weight / info.time_spent *
+                              occupancy_throughput_scale(info.occupancy);
+    if (info.throughput == 0) {
+      info.throughput = throughput;
+    }
+    else {
+      info.throughput = lerp(info.throughput, throughput, kThroughputSmoothFactor);
+    }
+    info.time_spent = 0;
 
-  bool has_big_difference = false;
+    total_throughput += info.throughput;
+  }
 
+  vector<double> current_weights;
+  vector<double> new_weights;
+  current_weights.reserve(num_infos);
+  new_weights.reserve(num_infos);
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = lerp(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
-
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
-      has_big_difference = true;
-    }
+    current_weights.push_back(info.weight);
+    new_weights.push_back(info.throughput / total_throughput);
   }
 
-  if (!has_big_difference) {
+  /* Only change the balance when it is expected to noticeably reduce the time of the slowest
+   * device. */
+  const double current_max_time = calculate_max_relative_time(work_balance_infos,
+                                                              current_weights);
+  const double new_max_time = calculate_max_relative_time(work_balance_infos, new_weights);
+  if (current_max_time - new_max_time < kRebalanceThreshold) {
     return false;
   }
 
-  const double total_weight_inv = 1.0 / total_weight;
   for (int i = 0; i < num_infos; ++i) {
-    WorkBalanceInfo &info = work_balance_infos[i];
-    info.weight = new_weights[i] * total_weight_inv;
-    info.time_spent = 0;
+    work_balance_infos[i].weight = new_weights[i];
   }
 
   return true;
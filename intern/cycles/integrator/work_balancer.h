@@ -27,6 +27,10 @@ struct WorkBalanceInfo {
   /* Average occupancy of the device while performing the work. */
   float occupancy = 1.0f;
 
+  /* Smoothed estimate of the amount of work the device performs per second, measured in fractions
+   * of the big tile. Zero when no estimate is known yet. */
+  double throughput = 0;
+
   /* Normalized weight, which is ready to be used for work balancing (like calculating fraction of
    * the big tile which is to be rendered on the device). */
   double weight = 1.0;
@@ -28,6 +28,64 @@ ccl_device_forceinline Transform bvh_unaligned_node_fetch_space(ccl_global const
   return space;
 }
 
+/* Decode bounds of a quantized node, see BVH2::pack_quantized_node(). The multiplication is
+ * exact, so the result matches the bounds the node was packed with. */
+ccl_device_forceinline float3 bvh_quantized_node_bound(const uint quantized,
+                                                       const float3 origin,
+                                                       const float3 scale)
+{
+  return origin + make_float3((float)(quantized & 0xff),
+                              (float)((quantized >> 8) & 0xff),
+                              (float)((quantized >> 16) & 0xff)) *
+                      scale;
+}
+
+ccl_device_forceinline int bvh_quantized_node_intersect(ccl_global const KernelGlobals *kg,
+                                                        const float3 P,
+                                                        const float3 idir,
+                                                        const float t,
+                                                        const int node_addr,
+                                                        const uint visibility,
+                                                        float dist[2])
+{
+  /* fetch node data */
+  float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
+  float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
+  float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
+
+  const float3 origin = float4_to_float3(node0);
+  const uint exponents = __float_as_uint(node0.w);
+  const float3 scale = make_float3(__uint_as_float((exponents & 0xff) << 23),
+                                   __uint_as_float(((exponents >> 8) & 0xff) << 23),
+                                   __uint_as_float(((exponents >> 16) & 0xff) << 23));
+
+  /* intersect ray against child nodes */
+  const float3 c0lo = (bvh_quantized_node_bound(__float_as_uint(node1.x), origin, scale) - P) *
+                      idir;
+  const float3 c0hi = (bvh_quantized_node_bound(__float_as_uint(node1.y), origin, scale) - P) *
+                      idir;
+  float c0min = max4(0.0f, min(c0lo.x, c0hi.x), min(c0lo.y, c0hi.y), min(c0lo.z, c0hi.z));
+  float c0max = min4(t, max(c0lo.x, c0hi.x), max(c0lo.y, c0hi.y), max(c0lo.z, c0hi.z));
+
+  const float3 c1lo = (bvh_quantized_node_bound(__float_as_uint(node1.z), origin, scale) - P) *
+                      idir;
+  const float3 c1hi = (bvh_quantized_node_bound(__float_as_uint(node1.w), origin, scale) - P) *
+                      idir;
+  float c1min = max4(0.0f, min(c1lo.x, c1hi.x), min(c1lo.y, c1hi.y), min(c1lo.z, c1hi.z));
+  float c1max = min4(t, max(c1lo.x, c1hi.x), max(c1lo.y, c1hi.y), max(c1lo.z, c1hi.z));
+
+  dist[0] = c0min;
+  dist[1] = c1min;
+
+#ifdef __VISIBILITY_FLAG__
+  const uint visibility1 = __float_as_uint(cnodes.y) & ~PATH_RAY_NODE_QUANTIZED;
+  return (((c0max >= c0min) && (__float_as_uint(cnodes.x) & visibility)) ? 1 : 0) |
+         (((c1max >= c1min) && (visibility1 & visibility)) ? 2 : 0);
+#else
+  return ((c0max >= c0min) ? 1 : 0) | ((c1max >= c1min) ? 2 : 0);
+#endif
+}
+
 ccl_device_forceinline int bvh_aligned_node_intersect(ccl_global const KernelGlobals *kg,
                                                       const float3 P,
                                                       const float3 idir,
@@ -38,9 +96,11 @@ ccl_device_forceinline int bvh_aligned_node_intersect(ccl_global const KernelGlo
 {
 
   /* fetch node data */
-#ifdef __VISIBILITY_FLAG__
   float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
-#endif
+  if (__float_as_uint(cnodes.y) & PATH_RAY_NODE_QUANTIZED) {
+    return bvh_quantized_node_intersect(kg, P, idir, t, node_addr, visibility, dist);
+  }
+
   float4 node0 = kernel_tex_fetch(__bvh_nodes, node_addr + 1);
   float4 node1 = kernel_tex_fetch(__bvh_nodes, node_addr + 2);
   float4 node2 = kernel_tex_fetch(__bvh_nodes, node_addr + 3);
@@ -67,6 +67,8 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
   isect->prim = PRIM_NONE;
   isect->object = OBJECT_NONE;
 
+  PROFILING_BVH_INIT();
+
   /* traversal loop */
   do {
     do {
@@ -75,6 +77,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
         int node_addr_child1, traverse_mask;
         float dist[2];
         float4 cnodes = kernel_tex_fetch(__bvh_nodes, node_addr + 0);
+        PROFILING_BVH_NODE();
 
         {
           traverse_mask = NODE_INTERSECT(kg,
@@ -126,6 +129,7 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
         if (prim_addr >= 0) {
           const int prim_addr2 = __float_as_int(leaf.y);
           const uint type = __float_as_int(leaf.w);
+          PROFILING_BVH_PRIMITIVES(prim_addr2 - prim_addr);
 
           /* pop */
           node_addr = traversal_stack[stack_ptr];
@@ -139,8 +143,10 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
                 if (triangle_intersect(
                         kg, isect, P, dir, isect->t, visibility, object, prim_addr)) {
                   /* shadow ray early termination */
-                  if (visibility & PATH_RAY_SHADOW_OPAQUE)
+                  if (visibility & PATH_RAY_SHADOW_OPAQUE) {
+                    PROFILING_BVH_DONE(kg);
                     return true;
+                  }
                 }
               }
               break;
@@ -152,8 +158,10 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
                 if (motion_triangle_intersect(
                         kg, isect, P, dir, isect->t, ray->time, visibility, object, prim_addr)) {
                   /* shadow ray early termination */
-                  if (visibility & PATH_RAY_SHADOW_OPAQUE)
+                  if (visibility & PATH_RAY_SHADOW_OPAQUE) {
+                    PROFILING_BVH_DONE(kg);
                     return true;
+                  }
                 }
               }
               break;
@@ -179,8 +187,10 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
                     kg, isect, P, dir, isect->t, curve_object, curve_prim, ray->time, curve_type);
                 if (hit) {
                   /* shadow ray early termination */
-                  if (visibility & PATH_RAY_SHADOW_OPAQUE)
+                  if (visibility & PATH_RAY_SHADOW_OPAQUE) {
+                    PROFILING_BVH_DONE(kg);
                     return true;
+                  }
                 }
               }
               break;
@@ -223,6 +233,8 @@ ccl_device_noinline bool BVH_FUNCTION_FULL_NAME(BVH)(ccl_global const KernelGlob
     }
   } while (node_addr != ENTRYPOINT_SENTINEL);
 
+  PROFILING_BVH_DONE(kg);
+
   return (isect->prim != PRIM_NONE);
 }
 
@@ -22,6 +22,8 @@
 #  include <nanovdb/util/SampleFromVoxels.h>
 #endif
 
+#include "util/util_texture_cache.h"
+
 CCL_NAMESPACE_BEGIN
 
 /* Make template functions private so symbols don't conflict between kernels with different
@@ -44,6 +46,20 @@ ccl_device_inline float frac(float x, int *ix)
   return x - (float)i;
 }
 
+/* Pixel of a 2D image, either stored in memory or loaded on demand by the texture cache. */
+template<typename T> ccl_always_inline T texture_fetch(const T *data, int x, int y, int width)
+{
+  return data[y * width + x];
+}
+
+ccl_always_inline float4 texture_fetch(const TextureCacheImage *data,
+                                       int x,
+                                       int y,
+                                       int /*width*/)
+{
+  return data->fetch(x, y);
+}
+
 template<typename T> struct TextureInterpolator {
 
   static ccl_always_inline float4 read(float4 r)
@@ -98,7 +114,7 @@ template<typename T> struct TextureInterpolator {
     if (x < 0 || y < 0 || x >= width || y >= height) {
       return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
-    return read(data[y * width + x]);
+    return read(texture_fetch(data, x, y, width));
   }
 
   static ccl_always_inline int wrap_periodic(int x, int width)
@@ -142,7 +158,7 @@ template<typename T> struct TextureInterpolator {
         kernel_assert(0);
         return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
     }
-    return read(data[ix + iy * width]);
+    return read(texture_fetch(data, ix, iy, width));
   }
 
   static ccl_always_inline float4 interp_linear(const TextureInfo &info, float x, float y)
@@ -587,6 +603,10 @@ ccl_device float4 kernel_tex_image_interp(const KernelGlobals *kg, int id, float
 {
   const TextureInfo &info = kernel_tex_fetch(__texture_info, id);
 
+  if (info.use_cache) {
+    return TextureInterpolator<TextureCacheImage>::interp(info, x, y);
+  }
+
   switch (info.data_type) {
     case IMAGE_DATA_TYPE_HALF:
       return TextureInterpolator<half>::interp(info, x, y);
@@ -59,4 +59,7 @@ void kernel_global_memory_copy(KernelGlobals *kg, const char *name, void *mem, s
 #define KERNEL_ARCH cpu_avx2
 #include "kernel/device/cpu/kernel_arch.h"
 
+#define KERNEL_ARCH cpu_avx2_basic
+#include "kernel/device/cpu/kernel_arch.h"
+
 CCL_NAMESPACE_END
@@ -95,9 +95,9 @@ ccl_device_inline void triangle_vertices_and_normals(ccl_global const KernelGlob
   P[0] = float4_to_float3(kernel_tex_fetch(__tri_verts, tri_vindex.w + 0));
   P[1] = float4_to_float3(kernel_tex_fetch(__tri_verts, tri_vindex.w + 1));
   P[2] = float4_to_float3(kernel_tex_fetch(__tri_verts, tri_vindex.w + 2));
-  N[0] = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
-  N[1] = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
-  N[2] = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
+  N[0] = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
+  N[1] = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
+  N[2] = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
 }
 
 /* Interpolate smooth vertex normal from vertices */
@@ -107,9 +107,9 @@ triangle_smooth_normal(ccl_global const KernelGlobals *kg, float3 Ng, int prim,
 {
   /* load triangle vertices */
   const uint4 tri_vindex = kernel_tex_fetch(__tri_vindex, prim);
-  float3 n0 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
-  float3 n1 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
-  float3 n2 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
+  float3 n0 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
+  float3 n1 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
+  float3 n2 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
 
   float3 N = safe_normalize((1.0f - u - v) * n2 + u * n0 + v * n1);
 
@@ -125,9 +125,9 @@ ccl_device_inline float3 triangle_smooth_normal_unnormalized(ccl_global const Ke
 {
   /* load triangle vertices */
   const uint4 tri_vindex = kernel_tex_fetch(__tri_vindex, prim);
-  float3 n0 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
-  float3 n1 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
-  float3 n2 = float4_to_float3(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
+  float3 n0 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.x));
+  float3 n1 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.y));
+  float3 n2 = decode_normal_octahedral(kernel_tex_fetch(__tri_vnormal, tri_vindex.z));
 
   /* ensure that the normals are in object space */
   if (sd->object_flag & SD_OBJECT_TRANSFORM_APPLIED) {
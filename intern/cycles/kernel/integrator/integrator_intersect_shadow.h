@@ -104,6 +104,7 @@ ccl_device bool integrate_intersect_shadow_transparent(INTEGRATOR_STATE_ARGS,
 ccl_device void integrator_intersect_shadow(INTEGRATOR_STATE_ARGS)
 {
   PROFILING_INIT(kg, PROFILING_INTERSECT_SHADOW);
+  PROFILING_COUNT_SHADOW_RAY(kg);
 
   /* Read ray from integrator state into local memory. */
   Ray ray ccl_optional_struct_init;
@@ -84,6 +84,10 @@ ccl_device bool kernel_adaptive_sampling_convergence_check(ccl_global const Kern
   const uint aux_w_offset = kernel_data.film.pass_adaptive_aux_buffer + 3;
   buffer[aux_w_offset] = did_converge;
 
+  if (kernel_data.film.pass_adaptive_error != PASS_UNUSED) {
+    buffer[kernel_data.film.pass_adaptive_error] = error;
+  }
+
   return did_converge;
 }
 
@@ -19,6 +19,7 @@
 #include "geom/geom.h"
 
 #include "kernel_light_background.h"
+#include "kernel_light_tree.h"
 #include "kernel_montecarlo.h"
 #include "kernel_projection.h"
 #include "kernel_types.h"
@@ -204,7 +205,11 @@ ccl_device_inline bool light_sample(ccl_global const KernelGlobals *kg,
     }
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  /* With the light tree, the probability of picking the lamp depends on the shading point and
+   * is applied by the caller. */
+  if (!(kernel_data.integrator.use_light_tree && light_tree_contains_type(type))) {
+    ls->pdf *= kernel_data.integrator.pdf_lights;
+  }
 
   return (ls->pdf > 0.0f);
 }
@@ -455,7 +460,12 @@ ccl_device bool light_sample_from_intersection(ccl_global const KernelGlobals *c
     return false;
   }
 
-  ls->pdf *= kernel_data.integrator.pdf_lights;
+  if (kernel_data.integrator.use_light_tree) {
+    ls->pdf *= light_tree_pdf_lamp(kg, ray_P, lamp);
+  }
+  else {
+    ls->pdf *= kernel_data.integrator.pdf_lights;
+  }
 
   return true;
 }
@@ -506,9 +516,31 @@ ccl_device_inline float triangle_light_pdf_area(ccl_global const KernelGlobals *
   return t * t * pdf / cos_pi;
 }
 
-ccl_device_forceinline float triangle_light_pdf(ccl_global const KernelGlobals *kg,
-                                                ccl_private const ShaderData *sd,
-                                                float t)
+/* Area of the triangle that the light distribution was built from. */
+ccl_device_inline float triangle_light_area(ccl_global const KernelGlobals *kg,
+                                            const int object,
+                                            const int prim)
+{
+  float3 V[3];
+  triangle_world_space_vertices(kg, object, prim, -1.0f, V);
+  return triangle_area(V[0], V[1], V[2]);
+}
+
+/* Convert the PDF of a triangle computed with `pdf_triangles` set to one into the PDF of picking
+ * the triangle from the light tree. */
+ccl_device_inline float triangle_light_tree_pdf(ccl_global const KernelGlobals *kg,
+                                                const float pdf,
+                                                const float select_pdf,
+                                                const int object,
+                                                const int prim)
+{
+  const float area = triangle_light_area(kg, object, prim);
+  return (area > 0.0f) ? pdf * select_pdf / area : 0.0f;
+}
+
+ccl_device_forceinline float triangle_light_pdf_distribution(ccl_global const KernelGlobals *kg,
+                                                             ccl_private const ShaderData *sd,
+                                                             float t)
 {
   /* A naive heuristic to decide between costly solid angle sampling
    * and simple area sampling, comparing the distance to the triangle plane
@@ -577,6 +609,21 @@ ccl_device_forceinline float triangle_light_pdf(ccl_global const KernelGlobals *
   }
 }
 
+ccl_device_forceinline float triangle_light_pdf(ccl_global const KernelGlobals *kg,
+                                                ccl_private const ShaderData *sd,
+                                                float t)
+{
+  const float pdf = triangle_light_pdf_distribution(kg, sd, t);
+  if (!kernel_data.integrator.use_light_tree || pdf == 0.0f) {
+    return pdf;
+  }
+
+  /* sd contains the point on the light source, calculate the point that we're shading. */
+  const float3 Px = sd->P + sd->I * t;
+  const float select_pdf = light_tree_pdf_triangle(kg, Px, sd->object, sd->prim);
+  return triangle_light_tree_pdf(kg, pdf, select_pdf, sd->object, sd->prim);
+}
+
 template<bool in_volume_segment>
 ccl_device_forceinline void triangle_light_sample(ccl_global const KernelGlobals *kg,
                                                   int prim,
@@ -793,6 +840,32 @@ ccl_device_inline bool light_select_reached_max_bounces(ccl_global const KernelG
   return (bounce > kernel_tex_fetch(__lights, index).max_bounces);
 }
 
+/* Pick a light from the light tree, or one of the distant lights which are not part of the tree.
+ * The returned pick probability is one for distant lights, their probability is already included
+ * in `pdf_lights`. */
+ccl_device int light_tree_distribution_sample(ccl_global const KernelGlobals *kg,
+                                              ccl_private float *randu,
+                                              const float3 P,
+                                              ccl_private float *select_pdf)
+{
+  const float pdf_light_tree = kernel_data.integrator.pdf_light_tree;
+  float r = *randu;
+
+  if (r < pdf_light_tree) {
+    *randu = r / pdf_light_tree;
+    const int index = light_tree_sample(kg, randu, P, select_pdf);
+    *select_pdf *= pdf_light_tree;
+    return index;
+  }
+
+  const int num_distant = kernel_data.integrator.num_distant_lights;
+  r = (r - pdf_light_tree) / (1.0f - pdf_light_tree) * num_distant;
+  const int distant = clamp((int)r, 0, num_distant - 1);
+  *randu = min(r - distant, 1.0f - FLT_EPSILON);
+  *select_pdf = 1.0f;
+  return kernel_data.integrator.distant_lights_offset + distant;
+}
+
 template<bool in_volume_segment>
 ccl_device_noinline bool light_distribution_sample(ccl_global const KernelGlobals *kg,
                                                    float randu,
@@ -804,7 +877,13 @@ ccl_device_noinline bool light_distribution_sample(ccl_global const KernelGlobal
                                                    ccl_private LightSample *ls)
 {
   /* Sample light index from distribution. */
-  const int index = light_distribution_sample(kg, &randu);
+  float select_pdf = 1.0f;
+  const int index = (kernel_data.integrator.use_light_tree) ?
+                        light_tree_distribution_sample(kg, &randu, P, &select_pdf) :
+                        light_distribution_sample(kg, &randu);
+  if (index < 0) {
+    return false;
+  }
   ccl_global const KernelLightDistribution *kdistribution = &kernel_tex_fetch(__light_distribution,
                                                                               index);
   const int prim = kdistribution->prim;
@@ -822,6 +901,9 @@ ccl_device_noinline bool light_distribution_sample(ccl_global const KernelGlobal
     const int shader_flag = kdistribution->mesh_light.shader_flag;
     triangle_light_sample<in_volume_segment>(kg, prim, object, randu, randv, time, ls, P);
     ls->shader |= shader_flag;
+    if (kernel_data.integrator.use_light_tree && ls->pdf > 0.0f) {
+      ls->pdf = triangle_light_tree_pdf(kg, ls->pdf, select_pdf, object, prim);
+    }
     return (ls->pdf > 0.0f);
   }
 
@@ -831,7 +913,13 @@ ccl_device_noinline bool light_distribution_sample(ccl_global const KernelGlobal
     return false;
   }
 
-  return light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls);
+  if (!light_sample<in_volume_segment>(kg, lamp, randu, randv, P, path_flag, ls)) {
+    return false;
+  }
+  if (kernel_data.integrator.use_light_tree && light_tree_contains_type(ls->type)) {
+    ls->pdf *= select_pdf;
+  }
+  return (ls->pdf > 0.0f);
 }
 
 ccl_device_inline bool light_distribution_sample_from_volume_segment(
@@ -869,10 +957,20 @@ ccl_device_inline bool light_distribution_sample_new_position(ccl_global const K
   /* Sample a new position on the same light, for volume sampling. */
   if (ls->type == LIGHT_TRIANGLE) {
     triangle_light_sample<false>(kg, ls->prim, ls->object, randu, randv, time, ls, P);
+    if (kernel_data.integrator.use_light_tree && ls->pdf > 0.0f) {
+      const float select_pdf = light_tree_pdf_triangle(kg, P, ls->object, ls->prim);
+      ls->pdf = triangle_light_tree_pdf(kg, ls->pdf, select_pdf, ls->object, ls->prim);
+    }
     return (ls->pdf > 0.0f);
   }
   else {
-    return light_sample<false>(kg, ls->lamp, randu, randv, P, 0, ls);
+    if (!light_sample<false>(kg, ls->lamp, randu, randv, P, 0, ls)) {
+      return false;
+    }
+    if (kernel_data.integrator.use_light_tree && light_tree_contains_type(ls->type)) {
+      ls->pdf *= light_tree_pdf_lamp(kg, P, ls->lamp);
+    }
+    return (ls->pdf > 0.0f);
   }
 }
 
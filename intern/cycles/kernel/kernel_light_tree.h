@@ -0,0 +1,220 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "kernel_types.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Light Tree
+ *
+ * Lights and emissive triangles are stored in a binary tree built by the light manager. To pick
+ * a light, the tree is traversed from the root, choosing each child with a probability
+ * proportional to its importance for the shading point. The importance is estimated from the
+ * bounds, orientation and power of the emitters below the node, based on:
+ *
+ * Alejandro Conty Estevez and Christopher Kulla.
+ * Importance Sampling of Many Lights with Adaptive Tree Splitting.
+ *
+ * Distant and background lights are not part of the tree, they are picked uniformly with a
+ * fixed probability. */
+
+ccl_device float light_tree_node_importance(const float3 P,
+                                            ccl_global const KernelLightTreeNode *knode)
+{
+  if (knode->energy == 0.0f) {
+    return 0.0f;
+  }
+
+  const float3 bounds_min = make_float3(
+      knode->bounds_min[0], knode->bounds_min[1], knode->bounds_min[2]);
+  const float3 bounds_max = make_float3(
+      knode->bounds_max[0], knode->bounds_max[1], knode->bounds_max[2]);
+  const float3 centroid = 0.5f * (bounds_min + bounds_max);
+  const float radius_squared = 0.25f * len_squared(bounds_max - bounds_min);
+
+  const float3 centroid_to_P = P - centroid;
+  const float distance_squared = len_squared(centroid_to_P);
+
+  /* Clamp the distance to the size of the bounds, to not let the importance grow unbounded when
+   * the point is close to or inside the bounds. */
+  const float clamped_distance_squared = max(max(distance_squared, radius_squared), 1e-8f);
+
+  float cos_theta_prime = 1.0f;
+  if (knode->theta_o < M_PI_F && distance_squared > radius_squared) {
+    const float distance = sqrtf(distance_squared);
+    const float3 axis = make_float3(knode->axis[0], knode->axis[1], knode->axis[2]);
+
+    /* Angle between the axis and the direction to the point, reduced by the spread of the
+     * emitter normals and the angle the bounds take up as seen from the point. */
+    const float cos_theta = clamp(dot(axis, centroid_to_P) / distance, -1.0f, 1.0f);
+    const float theta = fast_acosf(cos_theta);
+    const float theta_u = fast_asinf(min(sqrtf(radius_squared) / distance, 1.0f));
+    const float theta_prime = max(theta - knode->theta_o - theta_u, 0.0f);
+
+    if (theta_prime >= knode->theta_e) {
+      /* No emitter below the node faces the point. */
+      return 0.0f;
+    }
+    /* Keep a small importance for grazing angles, the bound is only approximate. */
+    cos_theta_prime = max(fast_cosf(theta_prime), 1e-4f);
+  }
+
+  return knode->energy * cos_theta_prime / clamped_distance_squared;
+}
+
+/* Probability of choosing the first child of an inner node. Returns a negative value when no
+ * emitter below the node contributes to the point. */
+ccl_device float light_tree_first_child_probability(ccl_global const KernelGlobals *kg,
+                                                    const float3 P,
+                                                    const int node_index)
+{
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node_index);
+  const float importance_first = light_tree_node_importance(
+      P, &kernel_tex_fetch(__light_tree_nodes, node_index + 1));
+  const float importance_second = light_tree_node_importance(
+      P, &kernel_tex_fetch(__light_tree_nodes, knode->child_index));
+  const float importance = importance_first + importance_second;
+  if (importance == 0.0f) {
+    return -1.0f;
+  }
+  return importance_first / importance;
+}
+
+/* Probability of choosing an emitter in its leaf. */
+ccl_device float light_tree_emitter_probability(ccl_global const KernelLightTreeNode *knode,
+                                                ccl_global const KernelLightTreeEmitter *kemitter)
+{
+  if (knode->energy == 0.0f) {
+    return 1.0f / knode->num_emitters;
+  }
+  return kemitter->energy / knode->energy;
+}
+
+/* Pick an emitter for the shading point. Returns its index in the light distribution, or -1 when
+ * no emitter contributes. The random number is rescaled to be reused for sampling the emitter. */
+ccl_device int light_tree_sample(ccl_global const KernelGlobals *kg,
+                                 ccl_private float *randu,
+                                 const float3 P,
+                                 ccl_private float *pdf)
+{
+  float r = *randu;
+  float node_pdf = 1.0f;
+  int node_index = 0;
+
+  while (kernel_tex_fetch(__light_tree_nodes, node_index).child_index >= 0) {
+    const float probability = light_tree_first_child_probability(kg, P, node_index);
+    if (probability < 0.0f) {
+      return -1;
+    }
+
+    if (r < probability) {
+      r = r / probability;
+      node_pdf *= probability;
+      node_index = node_index + 1;
+    }
+    else {
+      r = (r - probability) / (1.0f - probability);
+      node_pdf *= 1.0f - probability;
+      node_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+    }
+    /* Guard against rounding errors, the number has to stay below one. */
+    r = min(r, 1.0f - FLT_EPSILON);
+  }
+
+  /* Pick an emitter of the leaf proportional to its power. */
+  ccl_global const KernelLightTreeNode *knode = &kernel_tex_fetch(__light_tree_nodes, node_index);
+  int emitter_index = knode->first_emitter;
+  const int last_emitter = knode->first_emitter + knode->num_emitters - 1;
+  float emitter_probability = 1.0f;
+
+  for (; emitter_index <= last_emitter; emitter_index++) {
+    emitter_probability = light_tree_emitter_probability(
+        knode, &kernel_tex_fetch(__light_tree_emitters, emitter_index));
+    if (r < emitter_probability || emitter_index == last_emitter) {
+      break;
+    }
+    r -= emitter_probability;
+  }
+
+  if (emitter_probability == 0.0f) {
+    return -1;
+  }
+
+  *randu = min(r / emitter_probability, 1.0f - FLT_EPSILON);
+  *pdf = node_pdf * emitter_probability;
+  return kernel_tex_fetch(__light_tree_emitters, emitter_index).distribution_index;
+}
+
+/* Probability of picking the emitter with #light_tree_sample. */
+ccl_device float light_tree_pdf(ccl_global const KernelGlobals *kg,
+                                const float3 P,
+                                const int emitter_index)
+{
+  if (emitter_index < 0) {
+    return 0.0f;
+  }
+  ccl_global const KernelLightTreeEmitter *kemitter = &kernel_tex_fetch(__light_tree_emitters,
+                                                                         emitter_index);
+  uint bit_trail = kemitter->bit_trail;
+  float pdf = 1.0f;
+  int node_index = 0;
+
+  while (kernel_tex_fetch(__light_tree_nodes, node_index).child_index >= 0) {
+    const float probability = light_tree_first_child_probability(kg, P, node_index);
+    if (probability < 0.0f) {
+      return 0.0f;
+    }
+
+    if (bit_trail & 1) {
+      pdf *= 1.0f - probability;
+      node_index = kernel_tex_fetch(__light_tree_nodes, node_index).child_index;
+    }
+    else {
+      pdf *= probability;
+      node_index = node_index + 1;
+    }
+    bit_trail >>= 1;
+  }
+
+  return pdf * light_tree_emitter_probability(&kernel_tex_fetch(__light_tree_nodes, node_index),
+                                              kemitter);
+}
+
+ccl_device_inline float light_tree_pdf_lamp(ccl_global const KernelGlobals *kg,
+                                            const float3 P,
+                                            const int lamp)
+{
+  return light_tree_pdf(kg, P, kernel_tex_fetch(__light_to_tree, lamp));
+}
+
+ccl_device_inline float light_tree_pdf_triangle(ccl_global const KernelGlobals *kg,
+                                                const float3 P,
+                                                const int object,
+                                                const int prim)
+{
+  const int offset = kernel_tex_fetch(__object_to_tree, object);
+  return light_tree_pdf(kg, P, kernel_tex_fetch(__triangle_to_tree, offset + prim));
+}
+
+/* Lamps of these types are part of the tree, the others are picked uniformly. */
+ccl_device_inline bool light_tree_contains_type(const LightType type)
+{
+  return type == LIGHT_POINT || type == LIGHT_SPOT || type == LIGHT_AREA;
+}
+
+CCL_NAMESPACE_END
@@ -30,11 +30,34 @@ CCL_NAMESPACE_BEGIN
     ProfilingWithShaderHelper profiling_helper((ProfilingState *)&kg->profiler, event)
 #  define PROFILING_SHADER(object, shader) \
     profiling_helper.set_shader(object, (shader)&SHADER_MASK);
+
+/* Counters of rendering work, only updated while profiling. */
+#  define PROFILING_COUNT_RAY(kg, bounce) ((ProfilingState *)&kg->profiler)->count_ray(bounce)
+#  define PROFILING_COUNT_SHADOW_RAY(kg) ((ProfilingState *)&kg->profiler)->count_shadow_ray()
+#  define PROFILING_COUNT_SVM_NODE(kg, type) \
+    ((ProfilingState *)&kg->profiler)->count_svm_node(type)
+
+/* BVH traversal counters are kept in local variables, and only added once per traversal. */
+#  define PROFILING_BVH_INIT() \
+    uint profiling_bvh_nodes = 0; \
+    uint profiling_bvh_primitives = 0;
+#  define PROFILING_BVH_NODE() profiling_bvh_nodes++
+#  define PROFILING_BVH_PRIMITIVES(num) profiling_bvh_primitives += (num)
+#  define PROFILING_BVH_DONE(kg) \
+    ((ProfilingState *)&kg->profiler) \
+        ->count_bvh_traversal(profiling_bvh_nodes, profiling_bvh_primitives)
 #else
 #  define PROFILING_INIT(kg, event)
 #  define PROFILING_EVENT(event)
 #  define PROFILING_INIT_FOR_SHADER(kg, event)
 #  define PROFILING_SHADER(object, shader)
+#  define PROFILING_COUNT_RAY(kg, bounce)
+#  define PROFILING_COUNT_SHADOW_RAY(kg)
+#  define PROFILING_COUNT_SVM_NODE(kg, type)
+#  define PROFILING_BVH_INIT()
+#  define PROFILING_BVH_NODE()
+#  define PROFILING_BVH_PRIMITIVES(num)
+#  define PROFILING_BVH_DONE(kg)
 #endif /* __KERNEL_CPU__ */
 
 CCL_NAMESPACE_END
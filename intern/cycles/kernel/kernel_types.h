@@ -106,39 +106,102 @@ CCL_NAMESPACE_BEGIN
 #  undef __BAKING__
 #endif /* __KERNEL_OPTIX__ */
 
+/* Kernel Features
+ *
+ * Defined as macros so that they can be used for selective features compilation. */
+
+/* Shader nodes. */
+#define KERNEL_FEATURE_NODE_BSDF (1U << 0U)
+#define KERNEL_FEATURE_NODE_EMISSION (1U << 1U)
+#define KERNEL_FEATURE_NODE_VOLUME (1U << 2U)
+#define KERNEL_FEATURE_NODE_HAIR (1U << 3U)
+#define KERNEL_FEATURE_NODE_BUMP (1U << 4U)
+#define KERNEL_FEATURE_NODE_BUMP_STATE (1U << 5U)
+#define KERNEL_FEATURE_NODE_VORONOI_EXTRA (1U << 6U)
+#define KERNEL_FEATURE_NODE_RAYTRACE (1U << 7U)
+
+/* Use denoising kernels and output denoising passes. */
+#define KERNEL_FEATURE_DENOISING (1U << 8U)
+
+/* Use path tracing kernels. */
+#define KERNEL_FEATURE_PATH_TRACING (1U << 9U)
+
+/* BVH/sampling kernel features. */
+#define KERNEL_FEATURE_HAIR (1U << 10U)
+#define KERNEL_FEATURE_HAIR_THICK (1U << 11U)
+#define KERNEL_FEATURE_OBJECT_MOTION (1U << 12U)
+#define KERNEL_FEATURE_CAMERA_MOTION (1U << 13U)
+
+/* Denotes whether baking functionality is needed. */
+#define KERNEL_FEATURE_BAKING (1U << 14U)
+
+/* Use subsurface scattering materials. */
+#define KERNEL_FEATURE_SUBSURFACE (1U << 15U)
+
+/* Use volume materials. */
+#define KERNEL_FEATURE_VOLUME (1U << 16U)
+
+/* Use OpenSubdiv patch evaluation */
+#define KERNEL_FEATURE_PATCH_EVALUATION (1U << 17U)
+
+/* Use Transparent shadows */
+#define KERNEL_FEATURE_TRANSPARENT (1U << 18U)
+
+/* Use shadow catcher. */
+#define KERNEL_FEATURE_SHADOW_CATCHER (1U << 19U)
+
+/* Per-uber shader usage flags. */
+#define KERNEL_FEATURE_PRINCIPLED (1U << 20U)
+
+/* Light render passes. */
+#define KERNEL_FEATURE_LIGHT_PASSES (1U << 21U)
+
+/* Shadow render pass. */
+#define KERNEL_FEATURE_SHADOW_PASS (1U << 22U)
+
+/* Use OSL shading. Only used on the host, to choose between CPU kernels. */
+#define KERNEL_FEATURE_OSL (1U << 23U)
+
+/* Features of the CPU kernels specialized for scenes without volumes, subsurface scattering, hair
+ * and motion blur. OSL shading is excluded as it shares data structures with the kernel that
+ * depend on these features. */
+#define KERNEL_FEATURE_CPU_BASIC \
+  (~(KERNEL_FEATURE_HAIR | KERNEL_FEATURE_OBJECT_MOTION | KERNEL_FEATURE_CAMERA_MOTION | \
+     KERNEL_FEATURE_SUBSURFACE | KERNEL_FEATURE_VOLUME | KERNEL_FEATURE_OSL))
+
 /* Scene-based selective features compilation. */
 #ifdef __KERNEL_FEATURES__
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_CAMERA_MOTION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_CAMERA_MOTION)
 #    undef __CAMERA_MOTION__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_OBJECT_MOTION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_OBJECT_MOTION)
 #    undef __OBJECT_MOTION__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_HAIR)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_HAIR)
 #    undef __HAIR__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_VOLUME)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_VOLUME)
 #    undef __VOLUME__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_SUBSURFACE)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_SUBSURFACE)
 #    undef __SUBSURFACE__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_BAKING)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_BAKING)
 #    undef __BAKING__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_PATCH_EVALUATION)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_PATCH_EVALUATION)
 #    undef __PATCH_EVAL__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_TRANSPARENT)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_TRANSPARENT)
 #    undef __TRANSPARENT_SHADOWS__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_SHADOW_CATCHER)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_SHADOW_CATCHER)
 #    undef __SHADOW_CATCHER__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_PRINCIPLED)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_PRINCIPLED)
 #    undef __PRINCIPLED__
 #  endif
-#  if !(__KERNEL_FEATURES & KERNEL_FEATURE_DENOISING)
+#  if !(__KERNEL_FEATURES__ & KERNEL_FEATURE_DENOISING)
 #    undef __DENOISING_FEATURES__
 #  endif
 #endif
@@ -216,6 +279,11 @@ enum PathRayFlag {
    * in the node (either it should be intersected as AABB or as OBB). */
   PATH_RAY_NODE_UNALIGNED = (1 << 10),
 
+  /* Special flag to tag quantized BVH nodes.
+   * Uses the same bit as unaligned nodes, but only set in the visibility of the second child of
+   * aligned nodes, whose child bounds are then stored with 8 bits per component. */
+  PATH_RAY_NODE_QUANTIZED = (1 << 10),
+
   /* Subset of flags used for ray visibility for intersection.
    *
    * NOTE: SHADOW_CATCHER macros below assume there are no more than
@@ -367,6 +435,9 @@ typedef enum PassType {
   PASS_AOV_VALUE,
   PASS_ADAPTIVE_AUX_BUFFER,
   PASS_SAMPLE_COUNT,
+  /* Per-pixel error estimate of the adaptive sampling convergence check, which is compared against
+   * the noise threshold. Holds the error at the time the pixel was last checked. */
+  PASS_ADAPTIVE_ERROR,
   PASS_DIFFUSE_COLOR,
   PASS_GLOSSY_COLOR,
   PASS_TRANSMISSION_COLOR,
@@ -862,12 +933,10 @@ typedef struct ShaderVolumePhases {
 
 /* Volume Stack */
 
-#ifdef __VOLUME__
 typedef struct VolumeStack {
   int object;
   int shader;
 } VolumeStack;
-#endif
 
 /* Struct to gather multiple nearby intersections. */
 typedef struct LocalIntersection {
@@ -1014,6 +1083,7 @@ typedef struct KernelFilm {
 
   int pass_adaptive_aux_buffer;
   int pass_sample_count;
+  int pass_adaptive_error;
 
   int pass_mist;
   float mist_start;
@@ -1038,7 +1108,7 @@ typedef struct KernelFilm {
 
   int use_approximate_shadow_catcher;
 
-  int pad1, pad2, pad3;
+  int pad1, pad2;
 } KernelFilm;
 static_assert_align(KernelFilm, 16);
 
@@ -1123,6 +1193,12 @@ typedef struct KernelIntegrator {
   float pdf_lights;
   float light_inv_rr_threshold;
 
+  /* light tree, see kernel_light_tree.h */
+  int use_light_tree;
+  float pdf_light_tree;
+  int num_distant_lights;
+  int distant_lights_offset;
+
   /* bounces */
   int min_bounce;
   int max_bounce;
@@ -1352,6 +1428,37 @@ typedef struct KernelLightDistribution {
 } KernelLightDistribution;
 static_assert_align(KernelLightDistribution, 16);
 
+typedef struct KernelLightTreeNode {
+  /* Bounding box of the emitters. */
+  float bounds_min[3];
+  /* Estimated power of the emitters. */
+  float energy;
+  float bounds_max[3];
+  /* Spread of the emitter normals around the axis. */
+  float theta_o;
+  float axis[3];
+  /* Spread of the emission around the emitter normals. */
+  float theta_e;
+
+  /* -1 for leaves. For inner nodes the index of the second child, the first child directly
+   * follows its parent. */
+  int child_index;
+  int first_emitter;
+  int num_emitters;
+  int pad;
+} KernelLightTreeNode;
+static_assert_align(KernelLightTreeNode, 16);
+
+typedef struct KernelLightTreeEmitter {
+  float energy;
+  /* Index in the light distribution. */
+  int distribution_index;
+  /* Path from the root to the leaf of the emitter, one bit per level, zero for the first child. */
+  uint bit_trail;
+  int pad;
+} KernelLightTreeEmitter;
+static_assert_align(KernelLightTreeEmitter, 16);
+
 typedef struct KernelParticle {
   int index;
   float age;
@@ -1493,58 +1600,6 @@ enum {
   DEVICE_KERNEL_INTEGRATOR_NUM = DEVICE_KERNEL_INTEGRATOR_MEGAKERNEL + 1,
 };
 
-/* Kernel Features */
-
-enum KernelFeatureFlag : unsigned int {
-  /* Shader nodes. */
-  KERNEL_FEATURE_NODE_BSDF = (1U << 0U),
-  KERNEL_FEATURE_NODE_EMISSION = (1U << 1U),
-  KERNEL_FEATURE_NODE_VOLUME = (1U << 2U),
-  KERNEL_FEATURE_NODE_HAIR = (1U << 3U),
-  KERNEL_FEATURE_NODE_BUMP = (1U << 4U),
-  KERNEL_FEATURE_NODE_BUMP_STATE = (1U << 5U),
-  KERNEL_FEATURE_NODE_VORONOI_EXTRA = (1U << 6U),
-  KERNEL_FEATURE_NODE_RAYTRACE = (1U << 7U),
-
-  /* Use denoising kernels and output denoising passes. */
-  KERNEL_FEATURE_DENOISING = (1U << 8U),
-
-  /* Use path tracing kernels. */
-  KERNEL_FEATURE_PATH_TRACING = (1U << 9U),
-
-  /* BVH/sampling kernel features. */
-  KERNEL_FEATURE_HAIR = (1U << 10U),
-  KERNEL_FEATURE_HAIR_THICK = (1U << 11U),
-  KERNEL_FEATURE_OBJECT_MOTION = (1U << 12U),
-  KERNEL_FEATURE_CAMERA_MOTION = (1U << 13U),
-
-  /* Denotes whether baking functionality is needed. */
-  KERNEL_FEATURE_BAKING = (1U << 14U),
-
-  /* Use subsurface scattering materials. */
-  KERNEL_FEATURE_SUBSURFACE = (1U << 15U),
-
-  /* Use volume materials. */
-  KERNEL_FEATURE_VOLUME = (1U << 16U),
-
-  /* Use OpenSubdiv patch evaluation */
-  KERNEL_FEATURE_PATCH_EVALUATION = (1U << 17U),
-
-  /* Use Transparent shadows */
-  KERNEL_FEATURE_TRANSPARENT = (1U << 18U),
-
-  /* Use shadow catcher. */
-  KERNEL_FEATURE_SHADOW_CATCHER = (1U << 19U),
-
-  /* Per-uber shader usage flags. */
-  KERNEL_FEATURE_PRINCIPLED = (1U << 20U),
-
-  /* Light render passes. */
-  KERNEL_FEATURE_LIGHT_PASSES = (1U << 21U),
-
-  /* Shadow render pass. */
-  KERNEL_FEATURE_SHADOW_PASS = (1U << 22U),
-};
 
 /* Shader node feature mask, to specialize shader evaluation for kernels. */
 
@@ -237,6 +237,7 @@ ccl_device void svm_eval_nodes(INTEGRATOR_STATE_CONST_ARGS,
 
   while (1) {
     uint4 node = read_node(kg, &offset);
+    PROFILING_COUNT_SVM_NODE(kg, node.x);
 
     switch (node.x) {
       case NODE_END:
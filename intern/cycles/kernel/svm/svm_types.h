@@ -125,6 +125,8 @@ typedef enum ShaderNodeType {
   NODE_FLOAT_CURVE,
   /* NOTE: for best OpenCL performance, item definition in the enum must
    * match the switch case order in svm.h. */
+
+  NODE_NUM,
 } ShaderNodeType;
 
 typedef enum NodeAttributeOutputType {
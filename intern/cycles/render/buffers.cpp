@@ -110,6 +110,7 @@ NODE_DEFINE(BufferParams)
   SOCKET_STRING(layer, "Layer", ustring());
   SOCKET_STRING(view, "View", ustring());
   SOCKET_INT(samples, "Samples", 0);
+  SOCKET_INT(sample_offset, "Sample Offset", 0);
   SOCKET_FLOAT(exposure, "Exposure", 1.0f);
   SOCKET_BOOLEAN(use_approximate_shadow_catcher, "Use Approximate Shadow Catcher", false);
   SOCKET_BOOLEAN(use_transparent_background, "Transparent Background", false);
@@ -318,7 +319,9 @@ void render_buffers_host_copy_denoised(RenderBuffers *dst,
                                        const BufferParams &dst_params,
                                        const RenderBuffers *src,
                                        const BufferParams &src_params,
-                                       const size_t src_offset)
+                                       const size_t src_offset,
+                                       const int src_num_samples,
+                                       const int dst_num_samples)
 {
   DCHECK_EQ(dst_params.width, src_params.width);
   /* TODO(sergey): More sanity checks to avoid buffer overrun. */
@@ -366,17 +369,35 @@ void render_buffers_host_copy_denoised(RenderBuffers *dst,
   const float *src_pixel = src->buffer.data() + src_offset_in_floats;
   float *dst_pixel = dst->buffer.data();
 
+  const bool use_rescale = (src_num_samples != 0 && dst_num_samples != 0);
+  const int src_pass_sample_count = src_params.get_pass_offset(PASS_SAMPLE_COUNT);
+  const int dst_pass_sample_count = dst_params.get_pass_offset(PASS_SAMPLE_COUNT);
+  const bool use_pixel_sample_count = (src_pass_sample_count != PASS_UNUSED &&
+                                       dst_pass_sample_count != PASS_UNUSED);
+
   for (int i = 0; i < dst_num_pixels;
        ++i, src_pixel += src_pass_stride, dst_pixel += dst_pass_stride) {
+    float scale = 1.0f;
+    if (use_rescale) {
+      if (use_pixel_sample_count) {
+        const uint src_pixel_samples = __float_as_uint(src_pixel[src_pass_sample_count]);
+        const uint dst_pixel_samples = __float_as_uint(dst_pixel[dst_pass_sample_count]);
+        scale = src_pixel_samples ? float(dst_pixel_samples) / src_pixel_samples : 1.0f;
+      }
+      else {
+        scale = float(dst_num_samples) / src_num_samples;
+      }
+    }
+
     for (int pass_offset_idx = 0; pass_offset_idx < num_passes; ++pass_offset_idx) {
       const int dst_pass_offset = pass_offsets[pass_offset_idx].dst_offset;
       const int src_pass_offset = pass_offsets[pass_offset_idx].src_offset;
 
       /* TODO(sergey): Support non-RGBA passes. */
-      dst_pixel[dst_pass_offset + 0] = src_pixel[src_pass_offset + 0];
-      dst_pixel[dst_pass_offset + 1] = src_pixel[src_pass_offset + 1];
-      dst_pixel[dst_pass_offset + 2] = src_pixel[src_pass_offset + 2];
-      dst_pixel[dst_pass_offset + 3] = src_pixel[src_pass_offset + 3];
+      dst_pixel[dst_pass_offset + 0] = src_pixel[src_pass_offset + 0] * scale;
+      dst_pixel[dst_pass_offset + 1] = src_pixel[src_pass_offset + 1] * scale;
+      dst_pixel[dst_pass_offset + 2] = src_pixel[src_pass_offset + 2] * scale;
+      dst_pixel[dst_pass_offset + 3] = src_pixel[src_pass_offset + 3] * scale;
     }
   }
 }
@@ -108,6 +108,7 @@ class BufferParams : public Node {
   ustring layer;
   ustring view;
   int samples = 0;
+  int sample_offset = 0;
   float exposure = 1.0f;
   bool use_approximate_shadow_catcher = false;
   bool use_transparent_background = false;
@@ -187,12 +188,20 @@ class RenderBuffers {
  * `src_offset` allows to offset source pixel index which is used when a fraction of the source
  * buffer is to be copied.
  *
- * Copy happens of the number of pixels in the destination. */
+ * Copy happens of the number of pixels in the destination.
+ *
+ * Denoised passes hold pixels scaled by the number of samples they were denoised with. When the
+ * destination kept rendering after the source was denoised, `src_num_samples` and
+ * `dst_num_samples` are used to rescale the copied pixels to the number of samples of the
+ * destination, so that they are displayed with the same brightness. With adaptive sampling the
+ * per-pixel sample counts of both buffers are used instead. Zero disables the rescaling. */
 void render_buffers_host_copy_denoised(RenderBuffers *dst,
                                        const BufferParams &dst_params,
                                        const RenderBuffers *src,
                                        const BufferParams &src_params,
-                                       const size_t src_offset = 0);
+                                       const size_t src_offset = 0,
+                                       const int src_num_samples = 0,
+                                       const int dst_num_samples = 0);
 
 CCL_NAMESPACE_END
 
@@ -62,6 +62,7 @@ Geometry::Geometry(const NodeType *node_type, const Type type)
 {
   need_update_rebuild = false;
   need_update_bvh_for_offset = false;
+  is_deforming = false;
 
   transform_applied = false;
   transform_negative_scaled = false;
@@ -221,15 +222,25 @@ void Geometry::compute_bvh(
     vector<Object *> objects;
     objects.push_back(&object);
 
-    if (bvh && !need_update_rebuild) {
+    bool rebuild = (bvh == NULL || need_update_rebuild);
+
+    if (!rebuild) {
       progress->set_status(msg, "Refitting BVH");
 
       bvh->geometry = geometry;
       bvh->objects = objects;
 
       device->build_bvh(bvh, *progress, true);
+
+      /* Refitting keeps the topology of the tree, which gets worse as the geometry deforms away
+       * from the shape it was built for. Rebuild once the tree got too expensive to traverse. */
+      if (bvh_layout == BVH_LAYOUT_BVH2 && static_cast<BVH2 *>(bvh)->need_rebuild()) {
+        VLOG(1) << "Rebuilding BVH of " << name << " with degraded quality after refit.";
+        rebuild = true;
+      }
     }
-    else {
+
+    if (rebuild) {
       progress->set_status(msg, "Building BVH");
 
       BVHParams bparams;
@@ -237,6 +248,7 @@ void Geometry::compute_bvh(
       bparams.bvh_layout = bvh_layout;
       bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                     params->use_bvh_unaligned_nodes;
+      bparams.use_quantized_nodes = params->use_bvh_quantized_nodes;
       bparams.num_motion_triangle_steps = params->num_bvh_time_steps;
       bparams.num_motion_curve_steps = params->num_bvh_time_steps;
       bparams.bvh_type = params->bvh_type;
@@ -247,6 +259,12 @@ void Geometry::compute_bvh(
       MEM_GUARDED_CALL(progress, device->build_bvh, bvh, *progress, false);
     }
   }
+  else if (bvh) {
+    /* The geometry is part of the scene BVH now, so its own BVH is outdated and must not be
+     * refit when it gets instanced again. */
+    delete bvh;
+    bvh = NULL;
+  }
 
   need_update_rebuild = false;
   need_update_bvh_for_offset = false;
@@ -270,6 +288,8 @@ bool Geometry::has_voxel_attributes() const
 
 void Geometry::tag_update(Scene *scene, bool rebuild)
 {
+  is_deforming = !rebuild;
+
   if (rebuild) {
     need_update_rebuild = true;
     scene->light_manager->tag_update(scene, LightManager::MESH_NEED_REBUILD);
@@ -1078,7 +1098,7 @@ void GeometryManager::device_update_mesh(Device *,
 
     float4 *tri_verts = dscene->tri_verts.alloc(tri_size * 3);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    float4 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     uint4 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
     uint *tri_patch = dscene->tri_patch.alloc(tri_size);
     float2 *tri_patch_uv = dscene->tri_patch_uv.alloc(vert_size);
@@ -1203,6 +1223,7 @@ void GeometryManager::device_update_bvh(Device *device,
   bparams.use_spatial_split = scene->params.use_bvh_spatial_split;
   bparams.use_unaligned_nodes = dscene->data.bvh.have_curves &&
                                 scene->params.use_bvh_unaligned_nodes;
+  bparams.use_quantized_nodes = scene->params.use_bvh_quantized_nodes;
   bparams.num_motion_triangle_steps = scene->params.num_bvh_time_steps;
   bparams.num_motion_curve_steps = scene->params.num_bvh_time_steps;
   bparams.bvh_type = scene->params.bvh_type;
@@ -91,6 +91,11 @@ class Geometry : public Node {
   bool need_update_rebuild;
   bool need_update_bvh_for_offset;
 
+  /* Set when the last update modified the geometry without changing its topology, as happens
+   * for deforming geometry in animations. Such geometry keeps its own BVH even with static BVHs,
+   * so that it can be refit on following updates instead of being rebuilt. */
+  bool is_deforming;
+
   /* Index into scene->geometry (only valid during update) */
   size_t index;
 
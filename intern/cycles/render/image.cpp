@@ -30,6 +30,7 @@
 #include "util/util_progress.h"
 #include "util/util_task.h"
 #include "util/util_texture.h"
+#include "util/util_texture_cache.h"
 #include "util/util_unique_ptr.h"
 
 #ifdef WITH_OSL
@@ -300,6 +301,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 {
   need_update_ = true;
   osl_texture_system = NULL;
+  texture_cache = NULL;
   animation_frame = 0;
 
   /* Set image limits */
@@ -311,6 +313,8 @@ ImageManager::~ImageManager()
 {
   for (size_t slot = 0; slot < images.size(); slot++)
     assert(!images[slot]);
+
+  delete texture_cache;
 }
 
 void ImageManager::set_osl_texture_system(void *texture_system)
@@ -444,6 +448,7 @@ int ImageManager::add_image_slot(ImageLoader *loader,
   img->builtin = builtin;
   img->users = 1;
   img->mem = NULL;
+  img->cache_image = NULL;
 
   images[slot] = img;
 
@@ -642,6 +647,66 @@ bool ImageManager::file_load_image(Image *img, int texture_limit)
   return true;
 }
 
+bool ImageManager::texture_cache_load_image(Device *device, Scene *scene, Image *img)
+{
+  /* The texture cache is only accessible from the CPU. */
+  if (!scene->params.use_texture_cache || device->info.type != DEVICE_CPU) {
+    return false;
+  }
+
+  const ustring filepath = img->loader->osl_filepath();
+  if (filepath.empty()) {
+    return false;
+  }
+
+  /* Only 2D images that need no processing of all pixels, conversion from sRGB is done by the
+   * kernel. */
+  const ImageMetaData &metadata = img->metadata;
+  if (metadata.depth > 1 || !(metadata.channels > 0) ||
+      !(metadata.colorspace == u_colorspace_raw || metadata.colorspace == u_colorspace_srgb)) {
+    return false;
+  }
+  if (metadata.colorspace_file_format == "jpeg" && metadata.channels == 4) {
+    /* CMYK. */
+    return false;
+  }
+
+  {
+    thread_scoped_lock device_lock(device_mutex);
+    if (texture_cache == NULL) {
+      texture_cache = new TextureCache(scene->params.texture_cache_size);
+    }
+    else {
+      texture_cache->set_max_memory(scene->params.texture_cache_size);
+    }
+  }
+
+  TextureCacheImage *cache_image = TextureCacheImage::create(
+      texture_cache,
+      filepath.string(),
+      scene->params.texture_limit,
+      image_associate_alpha(img),
+      img->params.alpha_type == IMAGE_ALPHA_IGNORE);
+  if (cache_image == NULL) {
+    return false;
+  }
+
+  thread_scoped_lock device_lock(device_mutex);
+
+  /* The kernel reads pixels from the cache, texture memory is only a placeholder. */
+  void *pixels = img->mem->alloc(1, 1);
+  memset(pixels, 0, img->mem->memory_size());
+  img->mem->info.width = cache_image->width;
+  img->mem->info.height = cache_image->height;
+  img->mem->info.data = (uint64_t)cache_image;
+  img->mem->info.use_cache = true;
+  img->cache_image = cache_image;
+
+  VLOG(1) << "Using texture cache for image " << img->loader->name() << ".";
+
+  return true;
+}
+
 void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Progress *progress)
 {
   if (progress->get_cancel()) {
@@ -666,6 +731,11 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
     delete img->mem;
     img->mem = NULL;
   }
+  if (img->cache_image) {
+    delete img->cache_image;
+    img->cache_image = NULL;
+    texture_cache->invalidate(img->loader->osl_filepath().string());
+  }
 
   img->mem = new device_texture(
       device, img->mem_name.c_str(), slot, type, img->params.interpolation, img->params.extension);
@@ -673,7 +743,10 @@ void ImageManager::device_load_image(Device *device, Scene *scene, int slot, Pro
   img->mem->info.transform_3d = img->metadata.transform_3d;
 
   /* Create new texture. */
-  if (type == IMAGE_DATA_TYPE_FLOAT4) {
+  if (texture_cache_load_image(device, scene, img)) {
+    /* Pixels are loaded on demand. */
+  }
+  else if (type == IMAGE_DATA_TYPE_FLOAT4) {
     if (!file_load_image<TypeDesc::FLOAT, float>(img, texture_limit)) {
       /* on failure to load, we set a 1x1 pixels pink image */
       thread_scoped_lock device_lock(device_mutex);
@@ -799,6 +872,11 @@ void ImageManager::device_free_image(Device *, int slot)
     delete img->mem;
   }
 
+  if (img->cache_image) {
+    delete img->cache_image;
+    texture_cache->invalidate(img->loader->osl_filepath().string());
+  }
+
   delete img->loader;
   delete img;
   images[slot] = NULL;
@@ -38,6 +38,8 @@ class ImageManager;
 class Progress;
 class RenderStats;
 class Scene;
+class TextureCache;
+class TextureCacheImage;
 class ColorSpaceProcessor;
 class VDBImageLoader;
 
@@ -212,6 +214,8 @@ class ImageManager {
 
     string mem_name;
     device_texture *mem;
+    /* Set when pixels are loaded on demand by the texture cache. */
+    TextureCacheImage *cache_image;
 
     int users;
     thread_mutex mutex;
@@ -228,6 +232,7 @@ class ImageManager {
 
   vector<Image *> images;
   void *osl_texture_system;
+  TextureCache *texture_cache;
 
   int add_image_slot(ImageLoader *loader, const ImageParams &params, const bool builtin);
   void add_image_user(int slot);
@@ -238,6 +243,8 @@ class ImageManager {
   template<TypeDesc::BASETYPE FileFormat, typename StorageType>
   bool file_load_image(Image *img, int texture_limit);
 
+  bool texture_cache_load_image(Device *device, Scene *scene, Image *img);
+
   void device_load_image(Device *device, Scene *scene, int slot, Progress *progress);
   void device_free_image(Device *device, int slot);
 
@@ -21,6 +21,7 @@
 #include "render/graph.h"
 #include "render/integrator.h"
 #include "render/light.h"
+#include "render/light_tree.h"
 #include "render/mesh.h"
 #include "render/nodes.h"
 #include "render/object.h"
@@ -30,6 +31,7 @@
 
 #include "integrator/shader_eval.h"
 
+#include "util/util_algorithm.h"
 #include "util/util_foreach.h"
 #include "util/util_hash.h"
 #include "util/util_logging.h"
@@ -269,6 +271,54 @@ bool LightManager::object_usable_as_light(Object *object)
   return false;
 }
 
+/* Lights of these types are part of the light tree, matches light_tree_contains_type(). */
+static bool light_in_tree(const Light *light)
+{
+  return ELEM(light->light_type, LIGHT_POINT, LIGHT_SPOT, LIGHT_AREA);
+}
+
+static LightTreeEmitter light_tree_emitter_from_light(const Light *light)
+{
+  LightTreeEmitter emitter;
+  const float3 strength = light->strength;
+  emitter.energy = fabsf(average(strength));
+
+  if (light->light_type == LIGHT_AREA) {
+    const float3 axisu = light->axisu * (light->sizeu * light->size);
+    const float3 axisv = light->axisv * (light->sizev * light->size);
+    const float3 corner = light->co - 0.5f * (axisu + axisv);
+    emitter.bounds.grow(corner);
+    emitter.bounds.grow(corner + axisu);
+    emitter.bounds.grow(corner + axisv);
+    emitter.bounds.grow(corner + axisu + axisv);
+
+    /* Area lights only emit from their front side. */
+    const float3 dir = safe_normalize(light->dir);
+    if (len_squared(dir) > 0.0f) {
+      emitter.cone.axis = dir;
+      emitter.cone.theta_o = 0.0f;
+      emitter.cone.theta_e = M_PI_2_F;
+    }
+    else {
+      emitter.cone = LightTreeCone::omnidirectional();
+    }
+    return emitter;
+  }
+
+  emitter.bounds.grow(light->co, light->size);
+  emitter.cone = LightTreeCone::omnidirectional();
+
+  if (light->light_type == LIGHT_SPOT) {
+    const float3 dir = safe_normalize(light->dir);
+    if (len_squared(dir) > 0.0f) {
+      emitter.cone.axis = dir;
+      emitter.cone.theta_o = 0.0f;
+      emitter.cone.theta_e = min(light->spot_angle * 0.5f, M_PI_F);
+    }
+  }
+  return emitter;
+}
+
 void LightManager::device_update_distribution(Device *,
                                               DeviceScene *dscene,
                                               Scene *scene,
@@ -282,7 +332,10 @@ void LightManager::device_update_distribution(Device *,
   size_t num_background_lights = 0;
   size_t num_triangles = 0;
 
+  size_t num_total_triangles = 0;
+
   bool background_mis = false;
+  const bool use_light_tree = scene->integrator->get_use_light_tree();
 
   foreach (Light *light, scene->lights) {
     if (light->is_enabled) {
@@ -304,6 +357,7 @@ void LightManager::device_update_distribution(Device *,
     /* Count triangles. */
     Mesh *mesh = static_cast<Mesh *>(object->get_geometry());
     size_t mesh_num_triangles = mesh->num_triangles();
+    num_total_triangles += mesh_num_triangles;
     for (size_t i = 0; i < mesh_num_triangles; i++) {
       int shader_index = mesh->get_shader()[i];
       Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
@@ -323,6 +377,20 @@ void LightManager::device_update_distribution(Device *,
   KernelLightDistribution *distribution = dscene->light_distribution.alloc(num_distribution + 1);
   float totarea = 0.0f;
 
+  /* Emitters to build the light tree from, and the tables to find the emitter of lights and
+   * triangles when computing the PDF of a light hit by a ray. */
+  vector<LightTreeEmitter> tree_emitters;
+  int *object_to_tree = nullptr;
+  int *triangle_to_tree = nullptr;
+  size_t triangle_to_tree_offset = 0;
+
+  if (use_light_tree) {
+    tree_emitters.reserve(num_distribution);
+    object_to_tree = dscene->object_to_tree.alloc(max(scene->objects.size(), (size_t)1));
+    triangle_to_tree = dscene->triangle_to_tree.alloc(max(num_total_triangles, (size_t)1));
+    memset(object_to_tree, 0, sizeof(int) * dscene->object_to_tree.size());
+  }
+
   /* triangles */
   size_t offset = 0;
   int j = 0;
@@ -362,37 +430,68 @@ void LightManager::device_update_distribution(Device *,
     }
 
     size_t mesh_num_triangles = mesh->num_triangles();
+    if (use_light_tree) {
+      object_to_tree[object_id] = (int)triangle_to_tree_offset - (int)mesh->prim_offset;
+    }
+
     for (size_t i = 0; i < mesh_num_triangles; i++) {
       int shader_index = mesh->get_shader()[i];
       Shader *shader = (shader_index < mesh->get_used_shaders().size()) ?
                            static_cast<Shader *>(mesh->get_used_shaders()[shader_index]) :
                            scene->default_surface;
 
-      if (shader->get_use_mis() && shader->has_surface_emission) {
-        distribution[offset].totarea = totarea;
-        distribution[offset].prim = i + mesh->prim_offset;
-        distribution[offset].mesh_light.shader_flag = shader_flag;
-        distribution[offset].mesh_light.object_id = object_id;
-        offset++;
-
-        Mesh::Triangle t = mesh->get_triangle(i);
-        if (!t.valid(&mesh->get_verts()[0])) {
-          continue;
-        }
-        float3 p1 = mesh->get_verts()[t.v[0]];
-        float3 p2 = mesh->get_verts()[t.v[1]];
-        float3 p3 = mesh->get_verts()[t.v[2]];
-
-        if (!transform_applied) {
-          p1 = transform_point(&tfm, p1);
-          p2 = transform_point(&tfm, p2);
-          p3 = transform_point(&tfm, p3);
+      if (!(shader->get_use_mis() && shader->has_surface_emission)) {
+        if (use_light_tree) {
+          triangle_to_tree[triangle_to_tree_offset + i] = -1;
         }
+        continue;
+      }
+
+      distribution[offset].totarea = totarea;
+      distribution[offset].prim = i + mesh->prim_offset;
+      distribution[offset].mesh_light.shader_flag = shader_flag;
+      distribution[offset].mesh_light.object_id = object_id;
+
+      LightTreeEmitter *emitter = nullptr;
+      if (use_light_tree) {
+        /* Store the distribution index for now, it's replaced by the emitter index once the tree
+         * is built. */
+        triangle_to_tree[triangle_to_tree_offset + i] = offset;
+        emitter = &tree_emitters.emplace_back();
+        emitter->distribution_index = offset;
+        /* The emission of the shader is not known here, so only the area is used as power and
+         * the triangle is assumed to emit in all directions. */
+        emitter->cone = LightTreeCone::omnidirectional();
+      }
+      offset++;
 
-        totarea += triangle_area(p1, p2, p3);
+      Mesh::Triangle t = mesh->get_triangle(i);
+      if (!t.valid(&mesh->get_verts()[0])) {
+        continue;
+      }
+      float3 p1 = mesh->get_verts()[t.v[0]];
+      float3 p2 = mesh->get_verts()[t.v[1]];
+      float3 p3 = mesh->get_verts()[t.v[2]];
+
+      if (!transform_applied) {
+        p1 = transform_point(&tfm, p1);
+        p2 = transform_point(&tfm, p2);
+        p3 = transform_point(&tfm, p3);
+      }
+
+      const float area = triangle_area(p1, p2, p3);
+      totarea += area;
+
+      if (emitter) {
+        emitter->energy = area;
+        emitter->bounds.grow(p1);
+        emitter->bounds.grow(p2);
+        emitter->bounds.grow(p3);
       }
     }
 
+    triangle_to_tree_offset += mesh_num_triangles;
+
     j++;
   }
 
@@ -400,19 +499,53 @@ void LightManager::device_update_distribution(Device *,
   /* point lights */
   bool use_lamp_mis = false;
   int light_index = 0;
+  size_t num_tree_lights = 0;
+  int *light_to_tree = nullptr;
 
   if (num_lights > 0) {
-    float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
+    /* Index of the lights in the kernel, following device_update_points(). With the light tree
+     * the lights in the tree come first in the distribution, so the distant lights picked
+     * uniformly are stored contiguously after them. */
+    vector<std::pair<Light *, int>> distribution_lights;
+    distribution_lights.reserve(num_lights);
     foreach (Light *light, scene->lights) {
-      if (!light->is_enabled)
-        continue;
+      if (light->is_enabled) {
+        distribution_lights.emplace_back(light, distribution_lights.size());
+      }
+    }
+    if (use_light_tree) {
+      std::stable_partition(distribution_lights.begin(),
+                            distribution_lights.end(),
+                            [](const std::pair<Light *, int> &item) {
+                              return light_in_tree(item.first);
+                            });
+      light_to_tree = dscene->light_to_tree.alloc(num_lights);
+    }
+
+    float lightarea = (totarea > 0.0f) ? totarea / num_lights : 1.0f;
+    for (const std::pair<Light *, int> &item : distribution_lights) {
+      Light *light = item.first;
+      const int kernel_light_index = item.second;
 
       distribution[offset].totarea = totarea;
-      distribution[offset].prim = ~light_index;
+      distribution[offset].prim = ~kernel_light_index;
       distribution[offset].lamp.pad = 1.0f;
       distribution[offset].lamp.size = light->size;
       totarea += lightarea;
 
+      if (use_light_tree) {
+        if (light_in_tree(light)) {
+          LightTreeEmitter &emitter = tree_emitters.emplace_back(
+              light_tree_emitter_from_light(light));
+          emitter.distribution_index = offset;
+          light_to_tree[kernel_light_index] = offset;
+          num_tree_lights++;
+        }
+        else {
+          light_to_tree[kernel_light_index] = -1;
+        }
+      }
+
       if (light->light_type == LIGHT_DISTANT) {
         use_lamp_mis |= (light->angle > 0.0f && light->use_mis);
       }
@@ -447,6 +580,42 @@ void LightManager::device_update_distribution(Device *,
   if (progress.get_cancel())
     return;
 
+  /* Build the light tree, and replace the distribution indices in the tables by the index of the
+   * emitters in the tree. */
+  const size_t num_tree_emitters = tree_emitters.size();
+  size_t num_tree_leaf_emitters = 0;
+  if (use_light_tree) {
+    LightTree light_tree(tree_emitters, num_distribution);
+
+    auto remap = [&](int *table, const size_t size) {
+      for (size_t i = 0; i < size; i++) {
+        if (table[i] >= 0) {
+          table[i] = light_tree.distribution_to_emitter[table[i]];
+        }
+      }
+    };
+    remap(triangle_to_tree, num_total_triangles);
+    remap(light_to_tree, (light_to_tree) ? num_lights : 0);
+
+    num_tree_leaf_emitters = light_tree.emitters.size();
+    VLOG(1) << "Light tree with " << light_tree.nodes.size() << " nodes for "
+            << num_tree_leaf_emitters << " emitters.";
+
+    KernelLightTreeNode *nodes = dscene->light_tree_nodes.alloc(
+        max(light_tree.nodes.size(), (size_t)1));
+    KernelLightTreeEmitter *emitters = dscene->light_tree_emitters.alloc(
+        max(light_tree.emitters.size(), (size_t)1));
+    if (!light_tree.nodes.empty()) {
+      memcpy(nodes, light_tree.nodes.data(), sizeof(KernelLightTreeNode) * light_tree.nodes.size());
+      memcpy(emitters,
+             light_tree.emitters.data(),
+             sizeof(KernelLightTreeEmitter) * light_tree.emitters.size());
+    }
+    if (light_to_tree == nullptr) {
+      dscene->light_to_tree.alloc(1)[0] = -1;
+    }
+  }
+
   /* update device */
   KernelIntegrator *kintegrator = &dscene->data.integrator;
   KernelBackground *kbackground = &dscene->data.background;
@@ -478,11 +647,43 @@ void LightManager::device_update_distribution(Device *,
 
     kintegrator->use_lamp_mis = use_lamp_mis;
 
+    /* With the light tree, lights and triangles in the tree are picked with a probability that
+     * depends on the shading point, the remaining distant and background lights uniformly. */
+    kintegrator->use_light_tree = use_light_tree && num_tree_leaf_emitters > 0;
+    if (kintegrator->use_light_tree) {
+      const size_t num_distant_lights = num_lights - num_tree_lights;
+      kintegrator->pdf_light_tree = (num_distant_lights > 0) ? 0.5f : 1.0f;
+      kintegrator->num_distant_lights = num_distant_lights;
+      kintegrator->distant_lights_offset = num_tree_emitters;
+      /* Triangle PDFs are computed on unit area, see triangle_light_tree_pdf(). */
+      kintegrator->pdf_triangles = 1.0f;
+      kintegrator->pdf_lights = (num_distant_lights > 0) ?
+                                    (1.0f - kintegrator->pdf_light_tree) / num_distant_lights :
+                                    0.0f;
+
+      dscene->light_tree_nodes.copy_to_device();
+      dscene->light_tree_emitters.copy_to_device();
+      dscene->light_to_tree.copy_to_device();
+      dscene->object_to_tree.copy_to_device();
+      dscene->triangle_to_tree.copy_to_device();
+    }
+    else {
+      dscene->light_tree_nodes.free();
+      dscene->light_tree_emitters.free();
+      dscene->light_to_tree.free();
+      dscene->object_to_tree.free();
+      dscene->triangle_to_tree.free();
+
+      kintegrator->pdf_light_tree = 0.0f;
+      kintegrator->num_distant_lights = 0;
+      kintegrator->distant_lights_offset = 0;
+    }
+
     /* bit of an ugly hack to compensate for emitting triangles influencing
      * amount of samples we get for this pass */
     kfilm->pass_shadow_scale = 1.0f;
 
-    if (kintegrator->pdf_triangles != 0.0f)
+    if (trianglearea > 0.0f)
       kfilm->pass_shadow_scale /= 0.5f;
 
     if (num_background_lights < num_lights)
@@ -508,12 +709,21 @@ void LightManager::device_update_distribution(Device *,
   }
   else {
     dscene->light_distribution.free();
+    dscene->light_tree_nodes.free();
+    dscene->light_tree_emitters.free();
+    dscene->light_to_tree.free();
+    dscene->object_to_tree.free();
+    dscene->triangle_to_tree.free();
 
     kintegrator->num_distribution = 0;
     kintegrator->num_all_lights = 0;
     kintegrator->pdf_triangles = 0.0f;
     kintegrator->pdf_lights = 0.0f;
     kintegrator->use_lamp_mis = false;
+    kintegrator->use_light_tree = false;
+    kintegrator->pdf_light_tree = 0.0f;
+    kintegrator->num_distant_lights = 0;
+    kintegrator->distant_lights_offset = 0;
 
     kbackground->num_portals = 0;
     kbackground->portal_offset = 0;
@@ -1008,6 +1218,11 @@ void LightManager::device_free(Device *, DeviceScene *dscene, const bool free_ba
 {
   dscene->light_distribution.free();
   dscene->lights.free();
+  dscene->light_tree_nodes.free();
+  dscene->light_tree_emitters.free();
+  dscene->light_to_tree.free();
+  dscene->object_to_tree.free();
+  dscene->triangle_to_tree.free();
   if (free_background) {
     dscene->light_background_marginal_cdf.free();
     dscene->light_background_conditional_cdf.free();
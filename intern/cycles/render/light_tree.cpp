@@ -0,0 +1,244 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "render/light_tree.h"
+
+#include "util/util_algorithm.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Number of buckets to evaluate splits with. */
+static const int light_tree_num_buckets = 12;
+
+void LightTreeCone::merge(const LightTreeCone &other)
+{
+  if (other.theta_o < 0.0f) {
+    return;
+  }
+  if (theta_o < 0.0f) {
+    *this = other;
+    return;
+  }
+
+  const float theta_e_merged = max(theta_e, other.theta_e);
+
+  /* Merge the smaller cone into the bigger one. */
+  const LightTreeCone &a = (theta_o >= other.theta_o) ? *this : other;
+  const LightTreeCone &b = (theta_o >= other.theta_o) ? other : *this;
+
+  const float theta_d = safe_acosf(dot(a.axis, b.axis));
+  if (min(theta_d + b.theta_o, M_PI_F) <= a.theta_o) {
+    /* The bigger cone contains the smaller one. */
+    const float3 merged_axis = a.axis;
+    const float merged_theta_o = a.theta_o;
+    axis = merged_axis;
+    theta_o = merged_theta_o;
+    theta_e = theta_e_merged;
+    return;
+  }
+
+  const float merged_theta_o = 0.5f * (a.theta_o + theta_d + b.theta_o);
+  const float3 ortho = b.axis - dot(a.axis, b.axis) * a.axis;
+  if (merged_theta_o >= M_PI_F || len_squared(ortho) < 1e-12f) {
+    axis = a.axis;
+    theta_o = M_PI_F;
+    theta_e = theta_e_merged;
+    return;
+  }
+
+  /* Rotate the axis of the bigger cone towards the smaller one. */
+  const float theta_r = merged_theta_o - a.theta_o;
+  const float3 merged_axis = normalize(cosf(theta_r) * a.axis + sinf(theta_r) * normalize(ortho));
+  axis = merged_axis;
+  theta_o = merged_theta_o;
+  theta_e = theta_e_merged;
+}
+
+LightTree::LightTree(vector<LightTreeEmitter> &input_emitters, const int num_distribution)
+{
+  distribution_to_emitter.resize(num_distribution, -1);
+
+  /* Emitters without power or bounds can't be picked, they keep -1 as emitter index. */
+  input_emitters.erase(std::remove_if(input_emitters.begin(),
+                                      input_emitters.end(),
+                                      [](const LightTreeEmitter &emitter) {
+                                        return !(emitter.energy > 0.0f) || !emitter.bounds.valid();
+                                      }),
+                       input_emitters.end());
+  if (input_emitters.empty()) {
+    return;
+  }
+  nodes.reserve(2 * input_emitters.size());
+  emitters.reserve(input_emitters.size());
+  build(input_emitters, 0, input_emitters.size(), 0, 0);
+}
+
+int LightTree::build(vector<LightTreeEmitter> &input_emitters,
+                     const int begin,
+                     const int end,
+                     const int depth,
+                     const uint bit_trail)
+{
+  BoundBox bounds = BoundBox::empty;
+  LightTreeCone cone;
+  float energy = 0.0f;
+  for (int i = begin; i < end; i++) {
+    bounds.grow(input_emitters[i].bounds);
+    cone.merge(input_emitters[i].cone);
+    energy += input_emitters[i].energy;
+  }
+  if (cone.theta_o < 0.0f) {
+    cone = LightTreeCone::omnidirectional();
+  }
+
+  const int node_index = nodes.size();
+  nodes.emplace_back();
+  {
+    KernelLightTreeNode &knode = nodes[node_index];
+    knode.bounds_min[0] = bounds.min.x;
+    knode.bounds_min[1] = bounds.min.y;
+    knode.bounds_min[2] = bounds.min.z;
+    knode.bounds_max[0] = bounds.max.x;
+    knode.bounds_max[1] = bounds.max.y;
+    knode.bounds_max[2] = bounds.max.z;
+    knode.energy = energy;
+    knode.axis[0] = cone.axis.x;
+    knode.axis[1] = cone.axis.y;
+    knode.axis[2] = cone.axis.z;
+    knode.theta_o = cone.theta_o;
+    knode.theta_e = cone.theta_e;
+    knode.child_index = -1;
+    knode.first_emitter = -1;
+    knode.num_emitters = 0;
+    knode.pad = 0;
+  }
+
+  const int mid = (end - begin > 1 && depth < max_depth) ? split(input_emitters, begin, end) : -1;
+
+  if (mid < 0) {
+    /* Leaf. */
+    nodes[node_index].first_emitter = emitters.size();
+    nodes[node_index].num_emitters = end - begin;
+    for (int i = begin; i < end; i++) {
+      KernelLightTreeEmitter kemitter;
+      kemitter.energy = input_emitters[i].energy;
+      kemitter.distribution_index = input_emitters[i].distribution_index;
+      kemitter.bit_trail = bit_trail;
+      kemitter.pad = 0;
+      distribution_to_emitter[kemitter.distribution_index] = emitters.size();
+      emitters.push_back(kemitter);
+    }
+    return node_index;
+  }
+
+  /* The first child directly follows the node. */
+  build(input_emitters, begin, mid, depth + 1, bit_trail);
+  const int second_child = build(input_emitters, mid, end, depth + 1, bit_trail | (1u << depth));
+  nodes[node_index].child_index = second_child;
+  return node_index;
+}
+
+/* Partition the emitters along the largest axis of their centroids, choosing the split with the
+ * lowest cost estimated from the power and surface area of both sides. Returns the index of the
+ * first emitter of the second child, or -1 to create a leaf. */
+int LightTree::split(vector<LightTreeEmitter> &input_emitters, const int begin, const int end)
+{
+  BoundBox centroid_bounds = BoundBox::empty;
+  float energy = 0.0f;
+  for (int i = begin; i < end; i++) {
+    centroid_bounds.grow(input_emitters[i].bounds.center());
+    energy += input_emitters[i].energy;
+  }
+
+  const float3 extent = centroid_bounds.size();
+  const int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 :
+                   (extent.y >= extent.z)                         ? 1 :
+                                                                    2;
+  const float axis_min = centroid_bounds.min[axis];
+  const float axis_extent = extent[axis];
+
+  if (!(axis_extent > 0.0f)) {
+    /* All emitters at the same position, split them in the middle. */
+    return (begin + end) / 2;
+  }
+
+  const bool use_energy = energy > 0.0f;
+  auto bucket_of = [&](const LightTreeEmitter &emitter) {
+    const float value = emitter.bounds.center()[axis];
+    const int bucket = (int)(light_tree_num_buckets * (value - axis_min) / axis_extent);
+    return clamp(bucket, 0, light_tree_num_buckets - 1);
+  };
+
+  BoundBox bucket_bounds[light_tree_num_buckets];
+  float bucket_energy[light_tree_num_buckets];
+  int bucket_count[light_tree_num_buckets];
+  for (int i = 0; i < light_tree_num_buckets; i++) {
+    bucket_bounds[i] = BoundBox::empty;
+    bucket_energy[i] = 0.0f;
+    bucket_count[i] = 0;
+  }
+  for (int i = begin; i < end; i++) {
+    const int bucket = bucket_of(input_emitters[i]);
+    bucket_bounds[bucket].grow(input_emitters[i].bounds);
+    bucket_energy[bucket] += input_emitters[i].energy;
+    bucket_count[bucket]++;
+  }
+
+  int best_split = -1;
+  float best_cost = FLT_MAX;
+  for (int split = 1; split < light_tree_num_buckets; split++) {
+    BoundBox bounds_first = BoundBox::empty, bounds_second = BoundBox::empty;
+    float weight_first = 0.0f, weight_second = 0.0f;
+    int count_first = 0, count_second = 0;
+    for (int i = 0; i < light_tree_num_buckets; i++) {
+      const float weight = use_energy ? bucket_energy[i] : (float)bucket_count[i];
+      if (i < split) {
+        bounds_first.grow(bucket_bounds[i]);
+        weight_first += weight;
+        count_first += bucket_count[i];
+      }
+      else {
+        bounds_second.grow(bucket_bounds[i]);
+        weight_second += weight;
+        count_second += bucket_count[i];
+      }
+    }
+    if (count_first == 0 || count_second == 0) {
+      continue;
+    }
+    const float cost = weight_first * bounds_first.safe_area() +
+                       weight_second * bounds_second.safe_area();
+    if (cost < best_cost) {
+      best_cost = cost;
+      best_split = split;
+    }
+  }
+
+  if (best_split == -1) {
+    return (begin + end) / 2;
+  }
+
+  auto first_it = input_emitters.begin() + begin;
+  auto mid_it = std::partition(first_it,
+                               input_emitters.begin() + end,
+                               [&](const LightTreeEmitter &emitter) {
+                                 return bucket_of(emitter) < best_split;
+                               });
+  return begin + (int)(mid_it - input_emitters.begin() - begin);
+}
+
+CCL_NAMESPACE_END
@@ -0,0 +1,83 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __LIGHT_TREE_H__
+#define __LIGHT_TREE_H__
+
+#include "kernel/kernel_types.h"
+
+#include "util/util_boundbox.h"
+#include "util/util_types.h"
+#include "util/util_vector.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Cone containing the normals of emitters, with the spread of their emission. */
+struct LightTreeCone {
+  float3 axis = make_float3(0.0f, 0.0f, 1.0f);
+  /* Negative for an empty cone. */
+  float theta_o = -1.0f;
+  float theta_e = 0.0f;
+
+  static LightTreeCone omnidirectional()
+  {
+    LightTreeCone cone;
+    cone.theta_o = M_PI_F;
+    cone.theta_e = M_PI_2_F;
+    return cone;
+  }
+
+  void merge(const LightTreeCone &other);
+};
+
+/* Light or emissive triangle to build the light tree from. */
+struct LightTreeEmitter {
+  BoundBox bounds = BoundBox::empty;
+  LightTreeCone cone;
+  /* Estimated power. */
+  float energy = 0.0f;
+  /* Index of the emitter in the light distribution. */
+  int distribution_index = 0;
+};
+
+/* Binary tree of emitters used to pick lights based on their importance for the shading
+ * point, see kernel_light_tree.h. */
+class LightTree {
+ public:
+  /* Leaves deeper than this have multiple emitters, so the path to every leaf fits the bit trail
+   * of the emitters. */
+  static const int max_depth = 32;
+
+  vector<KernelLightTreeNode> nodes;
+  /* Emitters in the order of the leaves. */
+  vector<KernelLightTreeEmitter> emitters;
+  /* Index in #emitters for every distribution index. */
+  vector<int> distribution_to_emitter;
+
+  LightTree(vector<LightTreeEmitter> &input_emitters, int num_distribution);
+
+ protected:
+  int build(vector<LightTreeEmitter> &input_emitters,
+            const int begin,
+            const int end,
+            const int depth,
+            const uint bit_trail);
+  int split(vector<LightTreeEmitter> &input_emitters, const int begin, const int end);
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __LIGHT_TREE_H__ */
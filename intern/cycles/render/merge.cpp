@@ -16,6 +16,7 @@
 
 #include "render/merge.h"
 
+#include "util/util_algorithm.h"
 #include "util/util_array.h"
 #include "util/util_map.h"
 #include "util/util_system.h"
@@ -471,6 +472,270 @@ static bool save_output(const string &filepath,
   return ok;
 }
 
+/* Merge Render Buffers
+ *
+ * Files written by the tile manager contain raw render buffers, where passes are accumulated over
+ * all samples instead of being averaged. Instances rendering different tiles or different ranges
+ * of samples of the same frame can therefore be merged exactly by adding their buffers, except
+ * for cryptomatte passes which store pairs of ID and weight. */
+
+/* Attributes as written by the tile manager. */
+static const char *ATTR_PASSES_COUNT = "cycles.passes.count";
+static const char *ATTR_BUFFER_SAMPLES = "cycles.buffer.samples";
+static const char *ATTR_BUFFER_SAMPLE_OFFSET = "cycles.buffer.sample_offset";
+
+/* Same as ID_NONE in the kernel, marks an unused cryptomatte slot. */
+static const float MERGE_ID_NONE = 0.0f;
+
+struct MergeRenderBuffers {
+  /* OIIO file handle. */
+  unique_ptr<ImageInput> in;
+  /* Image file path. */
+  string filepath;
+  /* Range of samples rendered into the buffers. */
+  int sample_offset;
+  int samples;
+};
+
+static bool is_render_buffers_image(const ImageSpec &spec)
+{
+  return spec.get_int_attribute(ATTR_PASSES_COUNT, 0) > 0;
+}
+
+/* Group the channels of cryptomatte passes by their type, in the order of their slots. Channel
+ * names are "<pass index><pass name>.<component>", for example "00000005CryptoObject00.R". */
+static vector<vector<int>> parse_id_slot_channels(const ImageSpec &spec)
+{
+  map<string, vector<int>> channels_by_type;
+
+  for (int i = 0; i < spec.nchannels; i++) {
+    static const int pass_index_length = 8;
+    if (spec.channelnames[i].size() <= pass_index_length) {
+      continue;
+    }
+
+    string pass_name = spec.channelnames[i].substr(pass_index_length), component;
+    if (!split_last_dot(pass_name, component) || !string_startswith(pass_name, "Crypto")) {
+      continue;
+    }
+
+    /* Strip the index of the cryptomatte layer. */
+    while (!pass_name.empty() && isdigit(pass_name.back())) {
+      pass_name.pop_back();
+    }
+
+    channels_by_type[pass_name].push_back(i);
+  }
+
+  vector<vector<int>> id_slot_channels;
+  for (auto &i : channels_by_type) {
+    id_slot_channels.push_back(i.second);
+  }
+
+  return id_slot_channels;
+}
+
+/* Add (ID, weight) pairs of other slots into the slots, in the same way as the kernel does when
+ * accumulating samples, and keep the slots sorted by weight. */
+static void merge_id_slots(float *slots, const float *other_slots, const int num_slots)
+{
+  for (int i = 0; i < num_slots; i++) {
+    const float id = other_slots[i * 2 + 0];
+    const float weight = other_slots[i * 2 + 1];
+    if (weight == 0.0f) {
+      continue;
+    }
+
+    for (int slot = 0; slot < num_slots; slot++) {
+      if (slots[slot * 2] == MERGE_ID_NONE) {
+        slots[slot * 2 + 0] = id;
+        slots[slot * 2 + 1] = weight;
+        break;
+      }
+      else if (slots[slot * 2] == id || slot == num_slots - 1) {
+        slots[slot * 2 + 1] += weight;
+        break;
+      }
+    }
+  }
+
+  for (int slot = 1; slot < num_slots; slot++) {
+    if (slots[slot * 2] == MERGE_ID_NONE) {
+      break;
+    }
+    for (int i = slot; i > 0 && slots[i * 2 + 1] > slots[i * 2 - 1]; i--) {
+      std::swap(slots[i * 2 + 0], slots[i * 2 - 2]);
+      std::swap(slots[i * 2 + 1], slots[i * 2 - 1]);
+    }
+  }
+}
+
+static bool open_render_buffers(const vector<string> &filepaths,
+                                vector<MergeRenderBuffers> &images,
+                                string &error)
+{
+  for (const string &filepath : filepaths) {
+    unique_ptr<ImageInput> in(ImageInput::open(filepath));
+    if (!in) {
+      error = "Couldn't open file: " + filepath;
+      return false;
+    }
+
+    const ImageSpec &spec = in->spec();
+    if (!is_render_buffers_image(spec)) {
+      error = "File does not contain render buffers: " + filepath;
+      return false;
+    }
+
+    if (images.size() > 0) {
+      const ImageSpec &base_spec = images[0].in->spec();
+      if (base_spec.width != spec.width || base_spec.height != spec.height ||
+          base_spec.channelnames != spec.channelnames) {
+        error = "Render buffers do not have matching size and passes: " + filepath;
+        return false;
+      }
+    }
+
+    MergeRenderBuffers image;
+    image.filepath = filepath;
+    image.sample_offset = spec.get_int_attribute(ATTR_BUFFER_SAMPLE_OFFSET, 0);
+    image.samples = spec.get_int_attribute(ATTR_BUFFER_SAMPLES, 0);
+    image.in = std::move(in);
+
+    images.push_back(std::move(image));
+  }
+
+  /* Merge in a fixed order, so that the result does not depend on the order of the inputs. */
+  std::sort(images.begin(),
+            images.end(),
+            [](const MergeRenderBuffers &a, const MergeRenderBuffers &b) {
+              if (a.sample_offset != b.sample_offset) {
+                return a.sample_offset < b.sample_offset;
+              }
+              return a.filepath < b.filepath;
+            });
+
+  return true;
+}
+
+/* Compute the total number of samples of the merged buffers. Files with the same range of
+ * samples contain different tiles of the frame, different ranges are not allowed to overlap. */
+static bool merge_sample_ranges(const vector<MergeRenderBuffers> &images,
+                                int &total_samples,
+                                string &error)
+{
+  total_samples = 0;
+
+  for (size_t i = 0; i < images.size(); i++) {
+    const MergeRenderBuffers &image = images[i];
+    if (i > 0) {
+      const MergeRenderBuffers &prev_image = images[i - 1];
+      if (image.sample_offset == prev_image.sample_offset &&
+          image.samples == prev_image.samples) {
+        continue;
+      }
+      if (image.sample_offset < prev_image.sample_offset + prev_image.samples) {
+        error = "Sample ranges of " + prev_image.filepath + " and " + image.filepath + " overlap";
+        return false;
+      }
+    }
+    total_samples += image.samples;
+  }
+
+  return true;
+}
+
+static bool merge_render_buffers_pixels(const vector<MergeRenderBuffers> &images,
+                                        const ImageSpec &out_spec,
+                                        array<float> &out_pixels,
+                                        string &error)
+{
+  alloc_pixels(out_spec, out_pixels);
+  memset(out_pixels.data(), 0, out_pixels.size() * sizeof(float));
+
+  const vector<vector<int>> id_slot_channels = parse_id_slot_channels(out_spec);
+
+  vector<bool> is_id_slot_channel(out_spec.nchannels, false);
+  for (const vector<int> &channels : id_slot_channels) {
+    for (const int channel : channels) {
+      is_id_slot_channel[channel] = true;
+    }
+  }
+
+  const size_t num_channels = out_spec.nchannels;
+  const size_t num_pixels = (size_t)out_spec.width * (size_t)out_spec.height;
+
+  for (const MergeRenderBuffers &image : images) {
+    array<float> pixels;
+    alloc_pixels(image.in->spec(), pixels);
+
+    if (!image.in->read_image(TypeDesc::FLOAT, pixels.data())) {
+      error = "Failed to read image: " + image.filepath;
+      return false;
+    }
+
+    for (size_t channel = 0; channel < num_channels; channel++) {
+      if (is_id_slot_channel[channel]) {
+        continue;
+      }
+      for (size_t offset = channel; offset < pixels.size(); offset += num_channels) {
+        out_pixels[offset] += pixels[offset];
+      }
+    }
+
+    for (const vector<int> &channels : id_slot_channels) {
+      const int num_slots = channels.size() / 2;
+      vector<float> slots(num_slots * 2), other_slots(num_slots * 2);
+
+      for (size_t pixel = 0; pixel < num_pixels; pixel++) {
+        float *out_pixel = out_pixels.data() + pixel * num_channels;
+        const float *pixel_data = pixels.data() + pixel * num_channels;
+
+        for (int i = 0; i < num_slots * 2; i++) {
+          slots[i] = out_pixel[channels[i]];
+          other_slots[i] = pixel_data[channels[i]];
+        }
+
+        merge_id_slots(slots.data(), other_slots.data(), num_slots);
+
+        for (int i = 0; i < num_slots * 2; i++) {
+          out_pixel[channels[i]] = slots[i];
+        }
+      }
+    }
+  }
+
+  return true;
+}
+
+static bool merge_render_buffers(const vector<string> &input,
+                                 const string &output,
+                                 string &error)
+{
+  vector<MergeRenderBuffers> images;
+  if (!open_render_buffers(input, images, error)) {
+    return false;
+  }
+
+  int total_samples;
+  if (!merge_sample_ranges(images, total_samples, error)) {
+    return false;
+  }
+
+  ImageSpec out_spec = images[0].in->spec();
+  out_spec.attribute(ATTR_BUFFER_SAMPLES, total_samples);
+  out_spec.attribute(ATTR_BUFFER_SAMPLE_OFFSET, images[0].sample_offset);
+
+  array<float> out_pixels;
+  if (!merge_render_buffers_pixels(images, out_spec, out_pixels, error)) {
+    return false;
+  }
+
+  images.clear();
+
+  return save_output(output, out_spec, out_pixels, error);
+}
+
 /* Image Merger */
 
 ImageMerger::ImageMerger()
@@ -488,6 +753,15 @@ bool ImageMerger::run()
     return false;
   }
 
+  /* Raw render buffers written by the tile manager are merged exactly. */
+  {
+    unique_ptr<ImageInput> in(ImageInput::open(input[0]));
+    if (in && is_render_buffers_image(in->spec())) {
+      in.reset();
+      return merge_render_buffers(input, output, error);
+    }
+  }
+
   /* Open images and verify they have matching layout. */
   vector<MergeImage> images;
   if (!open_images(input, images, error)) {
@@ -22,7 +22,10 @@
 
 CCL_NAMESPACE_BEGIN
 
-/* Merge OpenEXR multilayer renders. */
+/* Merge OpenEXR multilayer renders.
+ *
+ * Raw render buffers written to disk by the tile manager are merged exactly by adding their
+ * passes, with the number of samples being the total of all sample ranges. */
 
 class ImageMerger {
  public:
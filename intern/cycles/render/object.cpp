@@ -892,6 +892,10 @@ void ObjectManager::apply_static_transforms(DeviceScene *dscene, Scene *scene, P
     bool apply = (geometry_users[geom] == 1) && !geom->has_surface_bssrdf &&
                  !geom->has_true_displacement();
 
+    /* Keep deforming geometry in object space, so its BVH can be refit on the next update
+     * instead of rebuilding the whole scene BVH. */
+    apply = apply && !geom->is_deforming;
+
     if (geom->geometry_type == Geometry::MESH) {
       Mesh *mesh = static_cast<Mesh *>(geom);
       apply = apply && mesh->get_subdivision_type() == Mesh::SUBDIVISION_NONE;
@@ -94,6 +94,7 @@ const NodeEnum *Pass::get_type_enum()
     pass_type_enum.insert("aov_value", PASS_AOV_VALUE);
     pass_type_enum.insert("adaptive_aux_buffer", PASS_ADAPTIVE_AUX_BUFFER);
     pass_type_enum.insert("sample_count", PASS_SAMPLE_COUNT);
+    pass_type_enum.insert("adaptive_error", PASS_ADAPTIVE_ERROR);
     pass_type_enum.insert("diffuse_color", PASS_DIFFUSE_COLOR);
     pass_type_enum.insert("glossy_color", PASS_GLOSSY_COLOR);
     pass_type_enum.insert("transmission_color", PASS_TRANSMISSION_COLOR);
@@ -321,6 +322,11 @@ PassInfo Pass::get_info(const PassType type, const bool include_albedo)
       pass_info.num_components = 1;
       pass_info.use_exposure = false;
       break;
+    case PASS_ADAPTIVE_ERROR:
+      /* Not accumulated, so the value is not to be divided by the number of samples. */
+      pass_info.num_components = 1;
+      pass_info.use_filter = false;
+      break;
 
     case PASS_AOV_COLOR:
       pass_info.num_components = 3;
@@ -79,6 +79,11 @@ DeviceScene::DeviceScene(Device *device)
       lights(device, "__lights", MEM_GLOBAL),
       light_background_marginal_cdf(device, "__light_background_marginal_cdf", MEM_GLOBAL),
       light_background_conditional_cdf(device, "__light_background_conditional_cdf", MEM_GLOBAL),
+      light_tree_nodes(device, "__light_tree_nodes", MEM_GLOBAL),
+      light_tree_emitters(device, "__light_tree_emitters", MEM_GLOBAL),
+      light_to_tree(device, "__light_to_tree", MEM_GLOBAL),
+      object_to_tree(device, "__object_to_tree", MEM_GLOBAL),
+      triangle_to_tree(device, "__triangle_to_tree", MEM_GLOBAL),
       particles(device, "__particles", MEM_GLOBAL),
       svm_nodes(device, "__svm_nodes", MEM_GLOBAL),
       shaders(device, "__shaders", MEM_GLOBAL),
@@ -87,6 +92,24 @@ DeviceScene::DeviceScene(Device *device)
       ies_lights(device, "__ies", MEM_GLOBAL)
 {
   memset((void *)&data, 0, sizeof(data));
+
+  /* Data accessed for every step of the ray traversal, keep it in device memory for as long as
+   * possible when the scene does not fit. Shading attributes are only accessed once per hit. */
+  bvh_nodes.residency = MEM_RESIDENCY_HIGH;
+  bvh_leaf_nodes.residency = MEM_RESIDENCY_HIGH;
+  object_node.residency = MEM_RESIDENCY_HIGH;
+  prim_type.residency = MEM_RESIDENCY_HIGH;
+  prim_visibility.residency = MEM_RESIDENCY_HIGH;
+  prim_index.residency = MEM_RESIDENCY_HIGH;
+  prim_object.residency = MEM_RESIDENCY_HIGH;
+  tri_verts.residency = MEM_RESIDENCY_HIGH;
+  curves.residency = MEM_RESIDENCY_HIGH;
+  curve_keys.residency = MEM_RESIDENCY_HIGH;
+
+  attributes_float.residency = MEM_RESIDENCY_LOW;
+  attributes_float2.residency = MEM_RESIDENCY_LOW;
+  attributes_float3.residency = MEM_RESIDENCY_LOW;
+  attributes_uchar4.residency = MEM_RESIDENCY_LOW;
 }
 
 Scene::Scene(const SceneParams &params_, Device *device)
@@ -595,6 +618,7 @@ static void log_kernel_features(const uint features)
           << string_from_bool(features & KERNEL_FEATURE_PATCH_EVALUATION) << "\n";
   VLOG(2) << "Use Shadow Catcher " << string_from_bool(features & KERNEL_FEATURE_SHADOW_CATCHER)
           << "\n";
+  VLOG(2) << "Use OSL " << string_from_bool(features & KERNEL_FEATURE_OSL) << "\n";
 }
 
 bool Scene::load_kernels(Progress &progress, bool lock_scene)
@@ -261,6 +261,7 @@ RenderWork Session::run_update_for_next_iteration()
     path_trace_->set_adaptive_sampling(adaptive_sampling);
   }
 
+  render_scheduler_.set_start_sample(params.sample_offset);
   render_scheduler_.set_num_samples(params.samples);
   render_scheduler_.set_time_limit(params.time_limit);
 
@@ -310,7 +311,7 @@ RenderWork Session::run_update_for_next_iteration()
     const int height = max(1, buffer_params_.full_height / resolution);
 
     if (update_scene(width, height)) {
-      profiler.reset(scene->shaders.size(), scene->objects.size());
+      profiler.reset(scene->shaders.size(), scene->objects.size(), NODE_NUM);
     }
     progress.add_skip_time(update_timer, params.background);
   }
@@ -390,13 +391,22 @@ void Session::do_delayed_reset()
 
   /* Store parameters used for buffers access outside of scene graph.  */
   buffer_params_.samples = params.samples;
+  buffer_params_.sample_offset = params.sample_offset;
   buffer_params_.exposure = scene->film->get_exposure();
   buffer_params_.use_approximate_shadow_catcher =
       scene->film->get_use_approximate_shadow_catcher();
   buffer_params_.use_transparent_background = scene->background->get_transparent();
 
   /* Tile and work scheduling. */
+  tile_manager_.set_distribution(params.distributed_instance_index,
+                                 params.distributed_num_instances);
+  tile_manager_.set_use_full_buffer_file(params.use_full_buffer_file ||
+                                         params.distributed_num_instances > 1);
   tile_manager_.reset_scheduling(buffer_params_, get_effective_tile_size());
+  if (params.distributed_num_instances > tile_manager_.get_num_tiles()) {
+    LOG(WARNING) << "Frame is distributed over more instances than there are tiles, use a "
+                    "smaller tile size to keep all instances busy";
+  }
   render_scheduler_.reset(buffer_params_, params.samples);
 
   /* Passes. */
@@ -568,7 +578,7 @@ void Session::update_status_time(bool show_pause, bool show_done)
   string status, substatus;
 
   const int current_tile = progress.get_rendered_tiles();
-  const int num_tiles = tile_manager_.get_num_tiles();
+  const int num_tiles = tile_manager_.get_num_instance_tiles();
 
   const int current_sample = progress.get_current_sample();
   const int num_samples = render_scheduler_.get_num_samples();
@@ -617,6 +627,10 @@ void Session::collect_statistics(RenderStats *render_stats)
   if (params.use_profiling && (params.device.type == DEVICE_CPU)) {
     render_stats->collect_profiling(scene, profiler);
   }
+  render_stats->path_trace_occupancy = render_scheduler_.get_average_path_trace_occupancy();
+  render_stats->device_memory_used = stats.mem_used;
+  render_stats->device_memory_peak = stats.mem_peak;
+  render_stats->device_memory_host_mapped_peak = stats.mem_host_mapped_peak;
 }
 
 /* --------------------------------------------------------------------
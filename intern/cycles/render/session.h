@@ -66,6 +66,21 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Rendering of a frame distributed over several instances, each rendering a subset of the big
+   * tiles. See TileManager::set_distribution(). */
+  int distributed_instance_index;
+  int distributed_num_instances;
+
+  /* Index of the first sample to render. Together with the number of samples this defines the
+   * range of samples rendered by this session, for splitting the samples of a frame between
+   * several instances. */
+  int sample_offset;
+
+  /* Write the render buffers to the on-disk tile file instead of writing the result to the
+   * software, so that they can be merged with the results of other instances. This is always
+   * the case for rendering distributed over tiles. */
+  bool use_full_buffer_file;
+
   ShadingSystem shadingsystem;
 
   SessionParams()
@@ -84,6 +99,12 @@ class SessionParams {
     use_auto_tile = true;
     tile_size = 2048;
 
+    distributed_instance_index = 0;
+    distributed_num_instances = 1;
+
+    sample_offset = 0;
+    use_full_buffer_file = false;
+
     shadingsystem = SHADINGSYSTEM_SVM;
   }
 
@@ -95,7 +116,10 @@ class SessionParams {
              background == params.background && experimental == params.experimental &&
              pixel_size == params.pixel_size && threads == params.threads &&
              use_profiling == params.use_profiling && shadingsystem == params.shadingsystem &&
-             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size);
+             use_auto_tile == params.use_auto_tile && tile_size == params.tile_size &&
+             distributed_instance_index == params.distributed_instance_index &&
+             distributed_num_instances == params.distributed_num_instances &&
+             use_full_buffer_file == params.use_full_buffer_file);
   }
 };
 
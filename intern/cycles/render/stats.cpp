@@ -16,6 +16,7 @@
 
 #include "render/stats.h"
 #include "render/object.h"
+#include "render/svm.h"
 #include "util/util_algorithm.h"
 #include "util/util_foreach.h"
 #include "util/util_string.h"
@@ -51,6 +52,11 @@ bool namedSampleCountPairComparator(const NamedSampleCountPair &a, const NamedSa
   return a.samples > b.samples;
 }
 
+bool namedCountEntryComparator(const NamedCountEntry &a, const NamedCountEntry &b)
+{
+  return a.count > b.count;
+}
+
 }  // namespace
 
 NamedSizeEntry::NamedSizeEntry() : name(""), size(0)
@@ -224,6 +230,46 @@ string NamedSampleCountStats::full_report(int indent_level)
   return result;
 }
 
+/* Named count entry. */
+
+NamedCountEntry::NamedCountEntry(const string &name, uint64_t count) : name(name), count(count)
+{
+}
+
+NamedCountStats::NamedCountStats() : total_count(0)
+{
+}
+
+void NamedCountStats::add_entry(const NamedCountEntry &entry)
+{
+  total_count += entry.count;
+  entries.push_back(entry);
+}
+
+string NamedCountStats::full_report(int indent_level, bool sort_by_count)
+{
+  const string indent(indent_level * kIndentNumSpaces, ' ');
+
+  vector<NamedCountEntry> sorted_entries = entries;
+  if (sort_by_count) {
+    sort(sorted_entries.begin(), sorted_entries.end(), namedCountEntryComparator);
+  }
+
+  string result = "";
+  result += string_printf("%sTotal: %s\n",
+                          indent.c_str(),
+                          string_human_readable_number(total_count).c_str());
+  foreach (const NamedCountEntry &entry, sorted_entries) {
+    const double percentage = (total_count) ? 100.0 * entry.count / total_count : 0.0;
+    result += string_printf("%s%-32s: %s (%.2f%%)\n",
+                            (indent + indent).c_str(),
+                            entry.name.c_str(),
+                            string_human_readable_number(entry.count).c_str(),
+                            percentage);
+  }
+  return result;
+}
+
 /* Mesh statistics. */
 
 MeshStats::MeshStats()
@@ -257,6 +303,13 @@ string ImageStats::full_report(int indent_level)
 RenderStats::RenderStats()
 {
   has_profiling = false;
+  bvh_traversals = 0;
+  bvh_nodes = 0;
+  bvh_primitives = 0;
+  path_trace_occupancy = 0.0f;
+  device_memory_used = 0;
+  device_memory_peak = 0;
+  device_memory_host_mapped_peak = 0;
 }
 
 void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
@@ -308,6 +361,31 @@ void RenderStats::collect_profiling(Scene *scene, Profiler &prof)
       objects.add(object->name, samples, hits);
     }
   }
+
+  const ProfilingCounters &counters = prof.get_counters();
+
+  rays = NamedCountStats();
+  for (int bounce = 0; bounce < PROFILING_MAX_BOUNCES; bounce++) {
+    if (counters.rays[bounce] == 0) {
+      continue;
+    }
+    const string name = (bounce == PROFILING_MAX_BOUNCES - 1) ?
+                            string_printf("Bounce %d and deeper", bounce) :
+                            string_printf("Bounce %d", bounce);
+    rays.add_entry(NamedCountEntry(name, counters.rays[bounce]));
+  }
+  rays.add_entry(NamedCountEntry("Shadow", counters.shadow_rays));
+
+  bvh_traversals = counters.bvh_traversals;
+  bvh_nodes = counters.bvh_nodes;
+  bvh_primitives = counters.bvh_primitives;
+
+  svm_nodes = NamedCountStats();
+  for (int type = 0; type < counters.svm_nodes.size(); type++) {
+    if (counters.svm_nodes[type]) {
+      svm_nodes.add_entry(NamedCountEntry(svm_node_type_name(type), counters.svm_nodes[type]));
+    }
+  }
 }
 
 string RenderStats::full_report()
@@ -319,9 +397,36 @@ string RenderStats::full_report()
     result += "Kernel statistics:\n" + kernel.full_report(1);
     result += "Shader statistics:\n" + shaders.full_report(1);
     result += "Object statistics:\n" + objects.full_report(1);
+    result += "Ray statistics:\n" + rays.full_report(1);
+    result += "BVH statistics:\n";
+    if (bvh_traversals) {
+      result += string_printf("  Traversals: %s\n",
+                              string_human_readable_number(bvh_traversals).c_str());
+      result += string_printf("  Nodes per traversal: %.2f\n",
+                              (double)bvh_nodes / bvh_traversals);
+      result += string_printf("  Primitives per traversal: %.2f\n",
+                              (double)bvh_primitives / bvh_traversals);
+    }
+    else {
+      result += "  Not available (only works with the BVH2 layout)\n";
+    }
+    result += "SVM node statistics:\n" + svm_nodes.full_report(1, true);
   }
   else {
-    result += "Profiling information not available (only works with CPU rendering)";
+    result += "Profiling information not available (only works with CPU rendering)\n";
+  }
+  if (path_trace_occupancy > 0.0f) {
+    result += string_printf("Path tracing occupancy: %.2f%%\n", path_trace_occupancy * 100.0f);
+  }
+  if (device_memory_peak) {
+    result += "Device memory statistics:\n";
+    result += string_printf("  Used: %s\n", string_human_readable_size(device_memory_used).c_str());
+    result += string_printf("  Peak: %s\n", string_human_readable_size(device_memory_peak).c_str());
+    if (device_memory_host_mapped_peak) {
+      result += string_printf(
+          "  Peak in mapped host memory: %s\n",
+          string_human_readable_size(device_memory_host_mapped_peak).c_str());
+    }
   }
   return result;
 }
@@ -147,6 +147,33 @@ class NamedSampleCountStats {
   entry_map entries;
 };
 
+/* Named entry containing a count of processed items, like rays or executed shader nodes. */
+class NamedCountEntry {
+ public:
+  NamedCountEntry(const string &name, uint64_t count);
+
+  string name;
+  uint64_t count;
+};
+
+/* Contains counts as described above. */
+class NamedCountStats {
+ public:
+  NamedCountStats();
+
+  /* Add entry to the statistics. */
+  void add_entry(const NamedCountEntry &entry);
+
+  /* Generate full human-readable report. Entries are listed in the order they were added, or
+   * sorted by descending count. */
+  string full_report(int indent_level = 0, bool sort_by_count = false);
+
+  /* Total count of all entries. */
+  uint64_t total_count;
+
+  vector<NamedCountEntry> entries;
+};
+
 /* Statistics about mesh in the render database. */
 class MeshStats {
  public:
@@ -191,6 +218,23 @@ class RenderStats {
   NamedNestedSampleStats kernel;
   NamedSampleCountStats shaders;
   NamedSampleCountStats objects;
+
+  /* Counters of rendering work, only available when profiling. */
+  NamedCountStats rays;
+  NamedCountStats svm_nodes;
+  uint64_t bvh_traversals;
+  uint64_t bvh_nodes;
+  uint64_t bvh_primitives;
+
+  /* Average fraction of the integrator states of the devices which were busy path tracing. Zero
+   * when not measured. */
+  float path_trace_occupancy;
+
+  /* Device memory usage. The mapped host memory is the part of it which did not fit into the
+   * device memory and is accessed by the device from host memory instead. */
+  size_t device_memory_used;
+  size_t device_memory_peak;
+  size_t device_memory_host_mapped_peak;
 };
 
 class UpdateTimeStats {
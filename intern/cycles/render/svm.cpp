@@ -45,6 +45,111 @@ SVMShaderManager::~SVMShaderManager()
 
 void SVMShaderManager::reset(Scene * /*scene*/)
 {
+  compiled_shaders_.clear();
+}
+
+const char *svm_node_type_name(const int type)
+{
+  static const char *names[] = {
+      "End",
+      "Shader Jump",
+      "Closure BSDF",
+      "Closure Emission",
+      "Closure Background",
+      "Closure Set Weight",
+      "Closure Weight",
+      "Emission Weight",
+      "Mix Closure",
+      "Jump If Zero",
+      "Jump If One",
+      "Geometry",
+      "Convert",
+      "Tex Coord",
+      "Value F",
+      "Value V",
+      "Attr",
+      "Vertex Color",
+      "Geometry Bump DX",
+      "Geometry Bump DY",
+      "Set Displacement",
+      "Displacement",
+      "Vector Displacement",
+      "Tex Image",
+      "Tex Image Box",
+      "Tex Noise",
+      "Set Bump",
+      "Attr Bump DX",
+      "Attr Bump DY",
+      "Vertex Color Bump DX",
+      "Vertex Color Bump DY",
+      "Tex Coord Bump DX",
+      "Tex Coord Bump DY",
+      "Closure Set Normal",
+      "Enter Bump Eval",
+      "Leave Bump Eval",
+      "HSV",
+      "Closure Holdout",
+      "Fresnel",
+      "Layer Weight",
+      "Closure Volume",
+      "Principled Volume",
+      "Math",
+      "Vector Math",
+      "RGB Ramp",
+      "Gamma",
+      "Brightcontrast",
+      "Light Path",
+      "Object Info",
+      "Particle Info",
+      "Hair Info",
+      "Texture Mapping",
+      "Mapping",
+      "Min Max",
+      "Camera",
+      "Tex Environment",
+      "Tex Sky",
+      "Tex Gradient",
+      "Tex Voronoi",
+      "Tex Musgrave",
+      "Tex Wave",
+      "Tex Magic",
+      "Tex Checker",
+      "Tex Brick",
+      "Tex White Noise",
+      "Normal",
+      "Light Falloff",
+      "IES",
+      "RGB Curves",
+      "Vector Curves",
+      "Tangent",
+      "Normal Map",
+      "Invert",
+      "Mix",
+      "Separate Vector",
+      "Combine Vector",
+      "Separate HSV",
+      "Combine HSV",
+      "Vector Rotate",
+      "Vector Transform",
+      "Wireframe",
+      "Wavelength",
+      "Blackbody",
+      "Map Range",
+      "Clamp",
+      "Bevel",
+      "Ambient Occlusion",
+      "Tex Voxel",
+      "AOV Start",
+      "AOV Color",
+      "AOV Value",
+      "Float Curve",
+  };
+  static_assert(sizeof(names) / sizeof(*names) == NODE_NUM, "Missing SVM node type names");
+
+  if (type < 0 || type >= NODE_NUM) {
+    return "Unknown";
+  }
+  return names[type];
 }
 
 static void host_compile_shader(Scene *scene,
@@ -82,17 +187,49 @@ void SVMShaderManager::host_update_specific(Device * /*device*/, Scene *scene, P
   });
 
   const int num_shaders = scene->shaders.size();
+  const Shader *background_shader = scene->background->get_shader(scene);
+
+  /* Shaders with an integrator dependency read integrator settings (e.g. Filter Glossy) while
+   * compiling, without being tagged as modified when those change. */
+  const bool integrator_modified = (update_flags & INTEGRATOR_MODIFIED) != 0;
+
+  /* Reuse nodes of shaders which did not change since the previous update, and forget about
+   * shaders which were removed from the scene. */
+  map<const Shader *, CompiledShader> compiled_shaders;
+  vector<Shader *> shaders_to_compile;
+  foreach (Shader *shader, scene->shaders) {
+    const bool background = (shader == background_shader);
+    CompiledShader &compiled = compiled_shaders[shader];
+
+    map<const Shader *, CompiledShader>::iterator it = compiled_shaders_.find(shader);
+    if (it != compiled_shaders_.end() && !shader->is_modified() &&
+        !(integrator_modified && shader->has_integrator_dependency) &&
+        it->second.graph == shader->graph && it->second.background == background) {
+      compiled = std::move(it->second);
+      continue;
+    }
 
-  VLOG(1) << "Total " << num_shaders << " shaders.";
+    compiled.graph = shader->graph;
+    compiled.background = background;
+    shaders_to_compile.push_back(shader);
+  }
+  compiled_shaders_.swap(compiled_shaders);
 
-  /* Build all shaders. */
+  VLOG(1) << "Total " << num_shaders << " shaders, " << shaders_to_compile.size()
+          << " need to be compiled.";
+
+  /* Build modified shaders. */
   TaskPool task_pool;
-  shader_svm_nodes_.resize(num_shaders);
-  for (int i = 0; i < num_shaders; i++) {
+  foreach (Shader *shader, shaders_to_compile) {
     task_pool.push(function_bind(
-        host_compile_shader, scene, scene->shaders[i], &progress, &shader_svm_nodes_[i]));
+        host_compile_shader, scene, shader, &progress, &compiled_shaders_[shader].svm_nodes));
   }
   task_pool.wait_work();
+
+  if (progress.get_cancel()) {
+    /* Shaders might be compiled partially, don't reuse them. */
+    compiled_shaders_.clear();
+  }
 }
 
 void SVMShaderManager::device_update_specific(Device *device,
@@ -124,10 +261,12 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
+  vector<const array<int4> *> shader_svm_nodes(num_shaders);
   int svm_nodes_size = num_shaders;
   for (int i = 0; i < num_shaders; i++) {
+    shader_svm_nodes[i] = &compiled_shaders_[scene->shaders[i]].svm_nodes;
     /* Since we're not copying the local jump node, the size ends up being one node lower. */
-    svm_nodes_size += shader_svm_nodes_[i].size() - 1;
+    svm_nodes_size += shader_svm_nodes[i]->size() - 1;
   }
 
   int4 *svm_nodes = dscene->svm_nodes.alloc(svm_nodes_size);
@@ -145,22 +284,22 @@ void SVMShaderManager::device_update_specific(Device *device,
      * Each compiled shader starts with a jump node that has offsets local
      * to the shader, so copy those and add the offset into the global node list. */
     int4 &global_jump_node = svm_nodes[shader->id];
-    int4 &local_jump_node = shader_svm_nodes_[i][0];
+    const int4 &local_jump_node = (*shader_svm_nodes[i])[0];
 
     global_jump_node.x = NODE_SHADER_JUMP;
     global_jump_node.y = local_jump_node.y - 1 + node_offset;
     global_jump_node.z = local_jump_node.z - 1 + node_offset;
     global_jump_node.w = local_jump_node.w - 1 + node_offset;
 
-    node_offset += shader_svm_nodes_[i].size() - 1;
+    node_offset += shader_svm_nodes[i]->size() - 1;
   }
 
   /* Copy the nodes of each shader into the correct location. */
   svm_nodes += num_shaders;
   for (int i = 0; i < num_shaders; i++) {
-    int shader_size = shader_svm_nodes_[i].size() - 1;
+    int shader_size = shader_svm_nodes[i]->size() - 1;
 
-    memcpy(svm_nodes, &shader_svm_nodes_[i][1], sizeof(int4) * shader_size);
+    memcpy(svm_nodes, &(*shader_svm_nodes[i])[1], sizeof(int4) * shader_size);
     svm_nodes += shader_size;
   }
 
@@ -174,8 +313,6 @@ void SVMShaderManager::device_update_specific(Device *device,
 
   update_flags = UPDATE_NONE;
 
-  shader_svm_nodes_.clear();
-
   VLOG(1) << "Shader manager updated " << num_shaders << " shaders in " << time_dt() - start_time
           << " seconds.";
 }
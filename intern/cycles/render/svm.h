@@ -22,6 +22,7 @@
 #include "render/shader.h"
 
 #include "util/util_array.h"
+#include "util/util_map.h"
 #include "util/util_set.h"
 #include "util/util_string.h"
 #include "util/util_thread.h"
@@ -55,13 +56,25 @@ class SVMShaderManager : public ShaderManager {
   void device_free(Device *device, DeviceScene *dscene, Scene *scene) override;
 
  protected:
+  struct CompiledShader {
+    /* Graph and background state the nodes were compiled for. */
+    const ShaderGraph *graph = nullptr;
+    bool background = false;
+
+    array<int4> svm_nodes;
+  };
+
   /* Compiled shader nodes.
    *
    * The compilation happens in the `host_update_specific()`, and the `device_update_specific()`
-   * moves these nodes to the device. */
-  vector<array<int4>> shader_svm_nodes_;
+   * moves these nodes to the device. The nodes are kept between updates, so that only shaders
+   * which were modified since the previous update are compiled again. */
+  map<const Shader *, CompiledShader> compiled_shaders_;
 };
 
+/* Human readable name of an SVM node type, for statistics. */
+const char *svm_node_type_name(const int type);
+
 /* Graph Compiler */
 
 class SVMCompiler {
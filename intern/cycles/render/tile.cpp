@@ -357,10 +357,43 @@ void TileManager::reset_scheduling(const BufferParams &params, int2 tile_size)
   tile_state_.num_tiles = tile_state_.num_tiles_x * tile_state_.num_tiles_y;
 
   tile_state_.next_tile_index = 0;
+  skip_other_instances_tiles();
 
   tile_state_.current_tile = Tile();
 }
 
+void TileManager::set_distribution(int instance_index, int num_instances)
+{
+  DCHECK_GE(instance_index, 0);
+  DCHECK_LT(instance_index, num_instances);
+
+  distribution_.instance_index = instance_index;
+  distribution_.num_instances = num_instances;
+}
+
+void TileManager::set_use_full_buffer_file(bool use_full_buffer_file)
+{
+  distribution_.use_full_buffer_file = use_full_buffer_file;
+}
+
+int TileManager::get_num_instance_tiles() const
+{
+  return divide_up(max(tile_state_.num_tiles - distribution_.instance_index, 0),
+                   distribution_.num_instances);
+}
+
+bool TileManager::is_instance_tile(int index) const
+{
+  return index % distribution_.num_instances == distribution_.instance_index;
+}
+
+void TileManager::skip_other_instances_tiles()
+{
+  while (!done() && !is_instance_tile(tile_state_.next_tile_index)) {
+    ++tile_state_.next_tile_index;
+  }
+}
+
 void TileManager::update(const BufferParams &params, const Scene *scene)
 {
   DCHECK_NE(params.pass_stride, -1);
@@ -399,6 +432,7 @@ bool TileManager::next()
   tile_state_.current_tile = get_tile_for_index(tile_state_.next_tile_index);
 
   ++tile_state_.next_tile_index;
+  skip_other_instances_tiles();
 
   return true;
 }
@@ -553,12 +587,18 @@ void TileManager::finish_write_tiles()
     return;
   }
 
-  /* EXR expects all tiles to present in file. So explicitly write missing tiles as all-zero. */
+  /* EXR expects all tiles to present in file. So explicitly write missing tiles as all-zero.
+   * Tiles of this instance are rendered in order, so the missing ones are those after the last
+   * written tile of this instance and all tiles of other instances. */
   if (write_state_.num_tiles_written < tile_state_.num_tiles) {
     vector<float> pixel_storage(tile_size_.x * tile_size_.y * buffer_params_.pass_stride);
 
-    for (int tile_index = write_state_.num_tiles_written; tile_index < tile_state_.num_tiles;
-         ++tile_index) {
+    for (int tile_index = 0; tile_index < tile_state_.num_tiles; ++tile_index) {
+      if (is_instance_tile(tile_index) &&
+          tile_index / distribution_.num_instances < write_state_.num_tiles_written) {
+        continue;
+      }
+
       const Tile tile = get_tile_for_index(tile_index);
 
       const int tile_x = tile.x + tile.window_x;
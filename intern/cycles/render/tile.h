@@ -67,6 +67,18 @@ class TileManager {
    * cases of stretched renders. */
   void reset_scheduling(const BufferParams &params, int2 tile_size);
 
+  /* Configure rendering of a frame distributed over several Cycles instances, possibly running on
+   * different machines. This instance only renders every num_instances-th big tile, starting at
+   * the tile with the given index. Tiles rendered by other instances are written as all-zero to
+   * the tile file, so that the files of all instances can be merged by adding them together.
+   *
+   * Is to be called before reset_scheduling(). */
+  void set_distribution(int instance_index, int num_instances);
+
+  /* Write render buffers to the on-disk tile file even when the frame fits into a single tile, so
+   * that the result can be merged with results of other instances rendering the same frame. */
+  void set_use_full_buffer_file(bool use_full_buffer_file);
+
   /* Update for the known buffer passes and scene parameters.
    * Will store all parameters needed for buffers access outside of the scene graph. */
   void update(const BufferParams &params, const Scene *scene);
@@ -76,9 +88,14 @@ class TileManager {
     return tile_state_.num_tiles;
   }
 
+  /* Number of tiles rendered by this instance. */
+  int get_num_instance_tiles() const;
+
+  /* NOTE: When the full buffer file is forced the frame is considered to have multiple tiles,
+   * so that the result is always written to the tile file. */
   inline bool has_multiple_tiles() const
   {
-    return tile_state_.num_tiles > 1;
+    return tile_state_.num_tiles > 1 || distribution_.use_full_buffer_file;
   }
 
   inline int get_tile_overscan() const
@@ -127,6 +144,12 @@ class TileManager {
    * The tile index must be within [0, state_.tile_state_). */
   Tile get_tile_for_index(int index) const;
 
+  /* Check whether the tile of the given index is to be rendered by this instance. */
+  bool is_instance_tile(int index) const;
+
+  /* Advance the next tile index to the first tile from it which is rendered by this instance. */
+  void skip_other_instances_tiles();
+
   bool open_tile_output();
   bool close_tile_output();
 
@@ -141,6 +164,14 @@ class TileManager {
 
   BufferParams buffer_params_;
 
+  /* Distribution of tiles between Cycles instances which render the same frame. */
+  struct {
+    int instance_index = 0;
+    int num_instances = 1;
+
+    bool use_full_buffer_file = false;
+  } distribution_;
+
   /* Tile scheduling state. */
   struct {
     int num_tiles_x = 0;
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "testing/testing.h"
+
+#include "render/buffers.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+namespace {
+
+BufferParams make_buffer_params(const int width, const bool use_sample_count)
+{
+  BufferParams params;
+  params.width = params.full_width = params.window_width = width;
+  params.height = params.full_height = params.window_height = 1;
+
+  BufferPass combined;
+  combined.type = PASS_COMBINED;
+  combined.offset = 0;
+  params.passes.push_back(combined);
+
+  BufferPass denoised;
+  denoised.type = PASS_COMBINED;
+  denoised.mode = PassMode::DENOISED;
+  denoised.offset = 0;
+  params.passes.push_back(denoised);
+
+  if (use_sample_count) {
+    BufferPass sample_count;
+    sample_count.type = PASS_SAMPLE_COUNT;
+    sample_count.offset = 0;
+    params.passes.push_back(sample_count);
+  }
+
+  params.update_passes();
+
+  return params;
+}
+
+/* Simulate the denoiser: store the denoised pixel scaled by the number of samples. */
+void fill_denoised(RenderBuffers &buffers, const float pixel[4], const uint *num_samples)
+{
+  const BufferParams &params = buffers.params;
+  const int denoised_offset = params.get_pass_offset(PASS_COMBINED, PassMode::DENOISED);
+  const int sample_count_offset = params.get_pass_offset(PASS_SAMPLE_COUNT);
+
+  for (int i = 0; i < params.width; i++) {
+    float *buffer_pixel = buffers.buffer.data() + i * params.pass_stride;
+    for (int c = 0; c < 4; c++) {
+      buffer_pixel[denoised_offset + c] = pixel[c] * num_samples[i];
+    }
+    if (sample_count_offset != PASS_UNUSED) {
+      buffer_pixel[sample_count_offset] = __uint_as_float(num_samples[i]);
+    }
+  }
+}
+
+}  // namespace
+
+/* An asynchronous denoising result which is applied after more samples were rendered must be
+ * displayed as bright as a synchronous one, which is denoised at the final number of samples. */
+TEST(render_buffers_host_copy_denoised, rescale_num_samples)
+{
+  const BufferParams params = make_buffer_params(2, false);
+  const float pixel[4] = {0.5f, 0.25f, 0.125f, 1.0f};
+  const uint denoised_num_samples[2] = {4, 4};
+  const uint num_samples[2] = {16, 16};
+
+  RenderBuffers sync_buffers(nullptr);
+  sync_buffers.reset(params);
+  fill_denoised(sync_buffers, pixel, num_samples);
+
+  RenderBuffers async_result(nullptr);
+  async_result.reset(params);
+  fill_denoised(async_result, pixel, denoised_num_samples);
+
+  RenderBuffers async_buffers(nullptr);
+  async_buffers.reset(params);
+  fill_denoised(async_buffers, pixel, num_samples);
+  render_buffers_host_copy_denoised(&async_buffers, params, &async_result, params, 0, 4, 16);
+
+  const int denoised_offset = params.get_pass_offset(PASS_COMBINED, PassMode::DENOISED);
+  for (int i = 0; i < params.width; i++) {
+    const float *sync_pixel = sync_buffers.buffer.data() + i * params.pass_stride;
+    const float *async_pixel = async_buffers.buffer.data() + i * params.pass_stride;
+    for (int c = 0; c < 4; c++) {
+      /* The display divides by the number of samples in the buffer. */
+      EXPECT_FLOAT_EQ(async_pixel[denoised_offset + c] / num_samples[i], pixel[c]);
+      EXPECT_FLOAT_EQ(async_pixel[denoised_offset + c], sync_pixel[denoised_offset + c]);
+    }
+  }
+}
+
+TEST(render_buffers_host_copy_denoised, rescale_pixel_sample_count)
+{
+  const BufferParams params = make_buffer_params(2, true);
+  const float pixel[4] = {0.5f, 0.25f, 0.125f, 1.0f};
+  /* Adaptive sampling stopped sampling the second pixel before the denoising. */
+  const uint denoised_num_samples[2] = {4, 2};
+  const uint num_samples[2] = {16, 2};
+
+  RenderBuffers sync_buffers(nullptr);
+  sync_buffers.reset(params);
+  fill_denoised(sync_buffers, pixel, num_samples);
+
+  RenderBuffers async_result(nullptr);
+  async_result.reset(params);
+  fill_denoised(async_result, pixel, denoised_num_samples);
+
+  RenderBuffers async_buffers(nullptr);
+  async_buffers.reset(params);
+  fill_denoised(async_buffers, pixel, num_samples);
+  render_buffers_host_copy_denoised(&async_buffers, params, &async_result, params, 0, 4, 16);
+
+  const int denoised_offset = params.get_pass_offset(PASS_COMBINED, PassMode::DENOISED);
+  for (int i = 0; i < params.width; i++) {
+    const float *sync_pixel = sync_buffers.buffer.data() + i * params.pass_stride;
+    const float *async_pixel = async_buffers.buffer.data() + i * params.pass_stride;
+    for (int c = 0; c < 4; c++) {
+      EXPECT_FLOAT_EQ(async_pixel[denoised_offset + c] / num_samples[i], pixel[c]);
+      EXPECT_FLOAT_EQ(async_pixel[denoised_offset + c], sync_pixel[denoised_offset + c]);
+    }
+  }
+}
+
+CCL_NAMESPACE_END
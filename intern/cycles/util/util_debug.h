@@ -79,6 +79,10 @@ class DebugFlags {
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout;
+
+    /* Render batches of paths per thread, executing one kernel for all paths of the batch at a
+     * time with paths sorted by shader, instead of rendering paths one by one. */
+    bool wavefront;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
@@ -525,6 +525,46 @@ ccl_device_inline float3 ensure_finite3(float3 v)
   return v;
 }
 
+/* Octahedral encoding of a normal into 16 bits per component. The zero vector is encoded as
+ * zero, the (0, 0, -1) direction that would map to it uses the opposite corner instead. */
+ccl_device_inline uint encode_normal_octahedral(const float3 N)
+{
+  const float len = fabsf(N.x) + fabsf(N.y) + fabsf(N.z);
+  if (!(len > 0.0f)) {
+    return 0;
+  }
+
+  float x = N.x / len;
+  float y = N.y / len;
+  if (N.z < 0.0f) {
+    const float tx = x;
+    x = (1.0f - fabsf(y)) * signf(tx);
+    y = (1.0f - fabsf(tx)) * signf(y);
+  }
+
+  const uint ux = (uint)(saturate(x * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  const uint uy = (uint)(saturate(y * 0.5f + 0.5f) * 65535.0f + 0.5f);
+  const uint packed = ux | (uy << 16);
+  return (packed == 0) ? 0xffffffff : packed;
+}
+
+ccl_device_inline float3 decode_normal_octahedral(const uint packed)
+{
+  if (packed == 0) {
+    return zero_float3();
+  }
+
+  float x = (float)(packed & 0xffff) * (2.0f / 65535.0f) - 1.0f;
+  float y = (float)(packed >> 16) * (2.0f / 65535.0f) - 1.0f;
+  const float z = 1.0f - fabsf(x) - fabsf(y);
+  if (z < 0.0f) {
+    const float tx = x;
+    x = (1.0f - fabsf(y)) * signf(tx);
+    y = (1.0f - fabsf(tx)) * signf(y);
+  }
+  return normalize(make_float3(x, y, z));
+}
+
 CCL_NAMESPACE_END
 
 #endif /* __UTIL_MATH_FLOAT3_H__ */
@@ -21,6 +21,32 @@
 
 CCL_NAMESPACE_BEGIN
 
+void ProfilingCounters::reset(int num_svm_nodes)
+{
+  std::fill(rays, rays + PROFILING_MAX_BOUNCES, 0);
+  shadow_rays = 0;
+  bvh_traversals = 0;
+  bvh_nodes = 0;
+  bvh_primitives = 0;
+  svm_nodes.assign(num_svm_nodes, 0);
+}
+
+void ProfilingCounters::add(const ProfilingCounters &other)
+{
+  for (int i = 0; i < PROFILING_MAX_BOUNCES; i++) {
+    rays[i] += other.rays[i];
+  }
+  shadow_rays += other.shadow_rays;
+  bvh_traversals += other.bvh_traversals;
+  bvh_nodes += other.bvh_nodes;
+  bvh_primitives += other.bvh_primitives;
+
+  assert(svm_nodes.size() == other.svm_nodes.size());
+  for (int i = 0; i < svm_nodes.size(); i++) {
+    svm_nodes[i] += other.svm_nodes[i];
+  }
+}
+
 Profiler::Profiler() : do_stop_worker(true), worker(NULL)
 {
 }
@@ -66,7 +92,7 @@ void Profiler::run()
   }
 }
 
-void Profiler::reset(int num_shaders, int num_objects)
+void Profiler::reset(int num_shaders, int num_objects, int num_svm_nodes)
 {
   bool running = (worker != NULL);
   if (running) {
@@ -81,6 +107,8 @@ void Profiler::reset(int num_shaders, int num_objects)
   shader_samples.assign(num_shaders, 0);
   object_samples.assign(num_objects, 0);
 
+  counters.reset(num_svm_nodes);
+
   if (running) {
     start();
   }
@@ -115,6 +143,7 @@ void Profiler::add_state(ProfilingState *state)
   /* Resize thread-local hit counters. */
   state->shader_hits.assign(shader_hits.size(), 0);
   state->object_hits.assign(object_hits.size(), 0);
+  state->counters.reset(counters.svm_nodes.size());
 
   /* Initialize the state. */
   state->event = PROFILING_UNKNOWN;
@@ -141,6 +170,9 @@ void Profiler::remove_state(ProfilingState *state)
   for (int i = 0; i < object_hits.size(); i++) {
     object_hits[i] += state->object_hits[i];
   }
+
+  /* Merge thread-local counters. */
+  counters.add(state->counters);
 }
 
 uint64_t Profiler::get_event(ProfilingEvent event)
@@ -171,4 +203,10 @@ bool Profiler::get_object(int object, uint64_t &samples, uint64_t &hits)
   return true;
 }
 
+const ProfilingCounters &Profiler::get_counters()
+{
+  assert(worker == NULL);
+  return counters;
+}
+
 CCL_NAMESPACE_END
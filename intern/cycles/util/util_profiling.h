@@ -56,6 +56,29 @@ enum ProfilingEvent : uint32_t {
   PROFILING_NUM_EVENTS,
 };
 
+/* Rays of deeper bounces are counted together with the last bounce. */
+#define PROFILING_MAX_BOUNCES 16
+
+/* Counters of rendering work, to find out why a render is slow. Unlike the event samples, these
+ * are exact counts. */
+struct ProfilingCounters {
+  /* Rays traced for the path, per bounce. */
+  uint64_t rays[PROFILING_MAX_BOUNCES] = {0};
+  /* Rays traced for shadows, sampled lights and ambient occlusion. */
+  uint64_t shadow_rays = 0;
+
+  /* BVH2 traversals, and the nodes and primitives visited by them. */
+  uint64_t bvh_traversals = 0;
+  uint64_t bvh_nodes = 0;
+  uint64_t bvh_primitives = 0;
+
+  /* Executed SVM nodes, indexed by ShaderNodeType. */
+  vector<uint64_t> svm_nodes;
+
+  void reset(int num_svm_nodes);
+  void add(const ProfilingCounters &other);
+};
+
 /* Contains the current execution state of a worker thread.
  * These values are constantly updated by the worker.
  * Periodically the profiler thread will wake up, read them
@@ -77,6 +100,38 @@ struct ProfilingState {
 
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
+
+  ProfilingCounters counters;
+
+  inline void count_ray(const int bounce)
+  {
+    if (active) {
+      counters.rays[(bounce < PROFILING_MAX_BOUNCES) ? bounce : PROFILING_MAX_BOUNCES - 1]++;
+    }
+  }
+
+  inline void count_shadow_ray()
+  {
+    if (active) {
+      counters.shadow_rays++;
+    }
+  }
+
+  inline void count_bvh_traversal(const uint num_nodes, const uint num_primitives)
+  {
+    if (active) {
+      counters.bvh_traversals++;
+      counters.bvh_nodes += num_nodes;
+      counters.bvh_primitives += num_primitives;
+    }
+  }
+
+  inline void count_svm_node(const uint type)
+  {
+    if (active && type < counters.svm_nodes.size()) {
+      counters.svm_nodes[type]++;
+    }
+  }
 };
 
 class Profiler {
@@ -84,7 +139,7 @@ class Profiler {
   Profiler();
   ~Profiler();
 
-  void reset(int num_shaders, int num_objects);
+  void reset(int num_shaders, int num_objects, int num_svm_nodes = 0);
 
   void start();
   void stop();
@@ -95,6 +150,7 @@ class Profiler {
   uint64_t get_event(ProfilingEvent event);
   bool get_shader(int shader, uint64_t &samples, uint64_t &hits);
   bool get_object(int object, uint64_t &samples, uint64_t &hits);
+  const ProfilingCounters &get_counters();
 
  protected:
   void run();
@@ -113,6 +169,9 @@ class Profiler {
   vector<uint64_t> shader_hits;
   vector<uint64_t> object_hits;
 
+  /* Sum of the counters of all workers, merged when they are removed. */
+  ProfilingCounters counters;
+
   volatile bool do_stop_worker;
   thread *worker;
 
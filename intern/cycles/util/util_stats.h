@@ -26,7 +26,7 @@ class Stats {
  public:
   enum static_init_t { static_init = 0 };
 
-  Stats() : mem_used(0), mem_peak(0)
+  Stats() : mem_used(0), mem_peak(0), mem_host_mapped_used(0), mem_host_mapped_peak(0)
   {
   }
   explicit Stats(static_init_t)
@@ -45,8 +45,24 @@ class Stats {
     atomic_sub_and_fetch_z(&mem_used, size);
   }
 
+  /* Part of the device allocations which did not fit into the device memory, and which lives in
+   * host memory mapped to the device address space instead. */
+  void mem_host_mapped_alloc(size_t size)
+  {
+    atomic_add_and_fetch_z(&mem_host_mapped_used, size);
+    atomic_fetch_and_update_max_z(&mem_host_mapped_peak, mem_host_mapped_used);
+  }
+
+  void mem_host_mapped_free(size_t size)
+  {
+    assert(mem_host_mapped_used >= size);
+    atomic_sub_and_fetch_z(&mem_host_mapped_used, size);
+  }
+
   size_t mem_used;
   size_t mem_peak;
+  size_t mem_host_mapped_used;
+  size_t mem_host_mapped_peak;
 };
 
 CCL_NAMESPACE_END
@@ -91,6 +91,8 @@ typedef struct TextureInfo {
   uint width, height, depth;
   /* Transform for 3D textures. */
   uint use_transform_3d;
+  /* Data is a TextureCacheImage that loads pixels on demand, only on the CPU. */
+  uint use_cache;
   Transform transform_3d;
 } TextureInfo;
 
@@ -0,0 +1,187 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "util/util_texture_cache.h"
+
+#include <OpenImageIO/imagecache.h>
+
+#include "util/util_logging.h"
+#include "util/util_math.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Size of tiles read from files that are not tiled themselves. */
+static const int texture_cache_autotile_size = 64;
+
+static inline OIIO::ImageCache *get_image_cache(void *image_cache)
+{
+  return (OIIO::ImageCache *)image_cache;
+}
+
+/* Texture Cache */
+
+TextureCache::TextureCache(const size_t max_memory_mb)
+{
+  /* Use a separate cache, the shared one is also used by OSL and the rest of Blender. */
+  OIIO::ImageCache *cache = OIIO::ImageCache::create(false);
+  cache->attribute("autotile", texture_cache_autotile_size);
+  cache->attribute("autoscanline", 1);
+  /* Alpha is associated when reading pixels, so images can keep unassociated alpha. */
+  cache->attribute("unassociatedalpha", 1);
+  image_cache = cache;
+  set_max_memory(max_memory_mb);
+}
+
+TextureCache::~TextureCache()
+{
+  OIIO::ImageCache::destroy(get_image_cache(image_cache));
+}
+
+void TextureCache::set_max_memory(const size_t max_memory_mb)
+{
+  get_image_cache(image_cache)->attribute("max_memory_MB", (float)max_memory_mb);
+}
+
+void TextureCache::invalidate(const string &filepath)
+{
+  get_image_cache(image_cache)->invalidate(OIIO::ustring(filepath));
+}
+
+/* Texture Cache Image */
+
+TextureCacheImage *TextureCacheImage::create(TextureCache *cache,
+                                             const string &filepath,
+                                             const int max_size,
+                                             const bool associate_alpha,
+                                             const bool ignore_alpha)
+{
+  OIIO::ImageCache *image_cache = get_image_cache(cache->image_cache);
+  OIIO::ImageCache::Perthread *thread_info = image_cache->get_perthread_info();
+  OIIO::ImageCache::ImageHandle *handle = image_cache->get_image_handle(OIIO::ustring(filepath),
+                                                                         thread_info);
+  if (handle == NULL) {
+    return NULL;
+  }
+
+  int num_miplevels = 1;
+  image_cache->get_image_info(handle,
+                              thread_info,
+                              0,
+                              0,
+                              OIIO::ustring("miplevels"),
+                              OIIO::TypeDesc::INT,
+                              &num_miplevels);
+
+  /* Find the largest MIP level that fits the size limit. */
+  OIIO::ImageSpec spec;
+  int miplevel = 0;
+  for (; miplevel < num_miplevels; miplevel++) {
+    if (!image_cache->get_imagespec(handle, thread_info, spec, 0, miplevel)) {
+      return NULL;
+    }
+    if (max_size == 0 || max(spec.width, spec.height) <= max_size) {
+      break;
+    }
+  }
+  if (miplevel == num_miplevels || spec.width <= 0 || spec.height <= 0) {
+    return NULL;
+  }
+
+  TextureCacheImage *image = new TextureCacheImage();
+  image->width = spec.width;
+  image->height = spec.height;
+  image->image_cache = image_cache;
+  image->image_handle = handle;
+  image->miplevel = miplevel;
+  image->xbegin = spec.x;
+  image->ybegin = spec.y;
+  image->channels = min(spec.nchannels, 4);
+  /* Files with associated alpha are read as is. */
+  image->associate_alpha = associate_alpha && spec.get_int_attribute("oiio:UnassociatedAlpha");
+  image->ignore_alpha = ignore_alpha;
+
+  VLOG(1) << "Texture cache for " << filepath << ", MIP level " << miplevel << " of "
+          << num_miplevels << ", " << image->width << "x" << image->height << ".";
+
+  return image;
+}
+
+TextureCacheImage::~TextureCacheImage()
+{
+}
+
+float4 TextureCacheImage::fetch(const int x, const int y) const
+{
+  OIIO::ImageCache *cache = get_image_cache(image_cache);
+  OIIO::ImageCache::Perthread *thread_info = cache->get_perthread_info();
+
+  /* Images are stored with the first row at the bottom. */
+  const int file_x = xbegin + x;
+  const int file_y = ybegin + (height - 1 - y);
+
+  float pixel[4] = {0.0f, 0.0f, 0.0f, 1.0f};
+  if (!cache->get_pixels((OIIO::ImageCache::ImageHandle *)image_handle,
+                         thread_info,
+                         0,
+                         miplevel,
+                         file_x,
+                         file_x + 1,
+                         file_y,
+                         file_y + 1,
+                         0,
+                         1,
+                         0,
+                         channels,
+                         OIIO::TypeDesc::FLOAT,
+                         pixel)) {
+    return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+  }
+
+  float4 result;
+  switch (channels) {
+    case 1:
+      result = make_float4(pixel[0], pixel[0], pixel[0], 1.0f);
+      break;
+    case 2:
+      result = make_float4(pixel[0], pixel[0], pixel[0], pixel[1]);
+      break;
+    case 3:
+      result = make_float4(pixel[0], pixel[1], pixel[2], 1.0f);
+      break;
+    default:
+      result = make_float4(pixel[0], pixel[1], pixel[2], pixel[3]);
+      break;
+  }
+
+  if (ignore_alpha) {
+    result.w = 1.0f;
+  }
+  else if (associate_alpha) {
+    result.x *= result.w;
+    result.y *= result.w;
+    result.z *= result.w;
+  }
+
+  /* Make sure we don't have buggy values, same as when loading full images. */
+  if (!isfinite_safe(result.x) || !isfinite_safe(result.y) || !isfinite_safe(result.z) ||
+      !isfinite_safe(result.w)) {
+    return make_float4(0.0f, 0.0f, 0.0f, 0.0f);
+  }
+
+  return result;
+}
+
+CCL_NAMESPACE_END
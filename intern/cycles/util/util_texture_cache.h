@@ -0,0 +1,82 @@
+/*
+ * Copyright 2011-2021 Blender Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __UTIL_TEXTURE_CACHE_H__
+#define __UTIL_TEXTURE_CACHE_H__
+
+#include "util/util_string.h"
+#include "util/util_types.h"
+
+CCL_NAMESPACE_BEGIN
+
+/* Texture Cache
+ *
+ * On-demand loading of image textures for the CPU. Instead of reading the full image before
+ * rendering, pixels are read in tiles through the OpenImageIO image cache the first time they
+ * are accessed by the kernel. Least recently used tiles are freed when the cache exceeds its
+ * maximum size, so memory usage follows the parts of the images that are actually used. */
+
+class TextureCache {
+ public:
+  explicit TextureCache(const size_t max_memory_mb);
+  ~TextureCache();
+
+  void set_max_memory(const size_t max_memory_mb);
+
+  /* Free tiles and file handles of the image, for when the file changed on disk. */
+  void invalidate(const string &filepath);
+
+ protected:
+  /* OIIO::ImageCache, not exposed to keep OpenImageIO out of the kernel headers. */
+  void *image_cache;
+
+  friend class TextureCacheImage;
+};
+
+class TextureCacheImage {
+ public:
+  /* Returns NULL when the file can't be read. When max_size is not zero, the largest MIP level
+   * that fits the size is used, and NULL returned when the file has no such level. */
+  static TextureCacheImage *create(TextureCache *cache,
+                                   const string &filepath,
+                                   const int max_size,
+                                   const bool associate_alpha,
+                                   const bool ignore_alpha);
+  ~TextureCacheImage();
+
+  /* Pixel with the same conversions as images loaded by the image manager: RGBA with associated
+   * alpha when requested, and the first row at the bottom of the image. */
+  float4 fetch(const int x, const int y) const;
+
+  int width;
+  int height;
+
+ protected:
+  TextureCacheImage() = default;
+
+  void *image_cache;
+  void *image_handle;
+  int miplevel;
+  int xbegin;
+  int ybegin;
+  int channels;
+  bool associate_alpha;
+  bool ignore_alpha;
+};
+
+CCL_NAMESPACE_END
+
+#endif /* __UTIL_TEXTURE_CACHE_H__ */
@@ -187,6 +187,38 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including mmap allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Domains memory in use is attributed to, so it can be seen which part of Blender uses it.
+ * All allocations made by a thread count towards its current domain, until the domain is
+ * restored. Only the innermost domain counts, and threads start in #MEM_DOMAIN_OTHER.
+ */
+typedef enum eMEMDomain {
+  MEM_DOMAIN_OTHER = 0,
+  /** Attribute layers of meshes and other geometry. */
+  MEM_DOMAIN_MESH,
+  /** Data stored in undo steps. */
+  MEM_DOMAIN_UNDO,
+  /** Pixels of image buffers. */
+  MEM_DOMAIN_IMAGE,
+  /** Vertex and index data staged for uploading to the GPU. */
+  MEM_DOMAIN_GPU,
+  /** Copy-on-write copies of data-blocks made by the dependency graph. */
+  MEM_DOMAIN_DEPSGRAPH,
+  /** Allocations made while Python runs, which are not attributed to another domain. */
+  MEM_DOMAIN_PYTHON,
+  MEM_DOMAIN_NUM,
+} eMEMDomain;
+
+/**
+ * Make following allocations of the calling thread count towards \a domain.
+ * \return The previous domain, to be passed to #MEM_domain_end.
+ */
+eMEMDomain MEM_domain_begin(eMEMDomain domain);
+void MEM_domain_end(eMEMDomain previous_domain);
+/** Memory in use by blocks of a domain in bytes. */
+size_t MEM_get_memory_in_use_domain(eMEMDomain domain) ATTR_WARN_UNUSED_RESULT;
+const char *MEM_domain_name(eMEMDomain domain) ATTR_WARN_UNUSED_RESULT;
+
 #ifdef __GNUC__
 #  define MEM_SAFE_FREE(v) \
     do { \
@@ -321,6 +353,25 @@ template<class T> inline void OBJECT_GUARDED_DESTRUCTOR(T *what)
       } \
     } \
     (void)0
+
+/** Attribute allocations of the calling thread to a domain until the end of the scope. */
+class MEM_ScopedDomain {
+ private:
+  eMEMDomain previous_domain_;
+
+ public:
+  explicit MEM_ScopedDomain(const eMEMDomain domain) : previous_domain_(MEM_domain_begin(domain))
+  {
+  }
+
+  ~MEM_ScopedDomain()
+  {
+    MEM_domain_end(previous_domain_);
+  }
+
+  MEM_ScopedDomain(const MEM_ScopedDomain &other) = delete;
+  MEM_ScopedDomain &operator=(const MEM_ScopedDomain &other) = delete;
+};
 #endif /* __cplusplus */
 
 #endif /* __MEM_GUARDEDALLOC_H__ */
@@ -0,0 +1,98 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Attribution of memory in use to domains, see #eMEMDomain.
+ *
+ * Both allocators store the domain of a block in its memory head, so it is subtracted from the
+ * right counter when freed, independent of the thread freeing it. Memory of #MEM_DOMAIN_OTHER is
+ * not counted separately, it is what remains of the total memory in use.
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "atomic_ops.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+const char *domain_names[MEM_DOMAIN_NUM] = {
+    "Other",
+    "Mesh",
+    "Undo",
+    "Image",
+    "GPU",
+    "Depsgraph",
+    "Python",
+};
+
+size_t mem_in_use_domain[MEM_DOMAIN_NUM] = {0};
+
+thread_local eMEMDomain thread_domain = MEM_DOMAIN_OTHER;
+
+}  // namespace
+
+int mem_domain_current(void)
+{
+  return thread_domain;
+}
+
+void mem_domain_add(int domain, size_t len)
+{
+  if (domain != MEM_DOMAIN_OTHER) {
+    atomic_add_and_fetch_z(&mem_in_use_domain[domain], len);
+  }
+}
+
+void mem_domain_sub(int domain, size_t len)
+{
+  if (domain != MEM_DOMAIN_OTHER) {
+    atomic_sub_and_fetch_z(&mem_in_use_domain[domain], len);
+  }
+}
+
+eMEMDomain MEM_domain_begin(eMEMDomain domain)
+{
+  const eMEMDomain previous_domain = thread_domain;
+  thread_domain = domain;
+  return previous_domain;
+}
+
+void MEM_domain_end(eMEMDomain previous_domain)
+{
+  thread_domain = previous_domain;
+}
+
+size_t MEM_get_memory_in_use_domain(eMEMDomain domain)
+{
+  if (domain != MEM_DOMAIN_OTHER) {
+    return mem_in_use_domain[domain];
+  }
+  size_t attributed = 0;
+  for (int i = MEM_DOMAIN_OTHER + 1; i < MEM_DOMAIN_NUM; i++) {
+    attributed += mem_in_use_domain[i];
+  }
+  /* Counters are updated independently, don't underflow while other threads allocate. */
+  const size_t total = MEM_get_memory_in_use();
+  return (total > attributed) ? total - attributed : 0;
+}
+
+const char *MEM_domain_name(eMEMDomain domain)
+{
+  return domain_names[domain];
+}
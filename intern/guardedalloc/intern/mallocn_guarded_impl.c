@@ -97,7 +97,8 @@ typedef struct MemHead {
   const char *name;
   const char *nextname;
   int tag2;
-  short pad1;
+  /* Memory domain the block counts towards, see #eMEMDomain. */
+  short domain;
   /* if non-zero aligned allocation was used and alignment is stored here. */
   short alignment;
 #ifdef DEBUG_MEMCOUNTER
@@ -418,7 +419,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
   memh->name = str;
   memh->nextname = NULL;
   memh->len = len;
-  memh->pad1 = 0;
+  memh->domain = (short)mem_domain_current();
   memh->alignment = 0;
   memh->tag2 = MEMTAG2;
 
@@ -435,6 +436,7 @@ static void make_memhead_header(MemHead *memh, size_t len, const char *str)
 
   atomic_add_and_fetch_u(&totblock, 1);
   atomic_add_and_fetch_z(&mem_in_use, len);
+  mem_domain_add(memh->domain, len);
 
   mem_lock_thread();
   addtail(membase, &memh->next);
@@ -1006,6 +1008,7 @@ static void rem_memblock(MemHead *memh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, memh->len);
+  mem_domain_sub(memh->domain, memh->len);
 
 #ifdef DEBUG_MEMDUPLINAME
   if (memh->need_free_name)
@@ -106,6 +106,30 @@ void aligned_free(void *ptr);
 extern bool leak_detector_has_run;
 extern char free_after_leak_detection_message[];
 
+/* Per-thread cache of small blocks used by the lock-free allocator, see mallocn_thread_cache.cc.
+ * Block sizes include the memory head. */
+#define MEM_THREAD_CACHE_CLASS_SIZE 16
+#define MEM_THREAD_CACHE_NUM_CLASSES 64
+#define MEM_THREAD_CACHE_MAX_BLOCK_SIZE \
+  ((size_t)MEM_THREAD_CACHE_CLASS_SIZE * MEM_THREAD_CACHE_NUM_CLASSES)
+/* Size to allocate for a block, small blocks are rounded up to their size class so that any
+ * cached block of a class can be reused for all sizes of that class. */
+#define MEM_THREAD_CACHE_BLOCK_SIZE(size) \
+  (((size) <= MEM_THREAD_CACHE_MAX_BLOCK_SIZE) ? \
+       (((size) + (MEM_THREAD_CACHE_CLASS_SIZE - 1)) & ~(size_t)(MEM_THREAD_CACHE_CLASS_SIZE - 1)) : \
+       (size))
+
+/* Get a cached block of the given size freed by this thread before, NULL when there is none. */
+void *mem_thread_cache_pop(size_t block_size);
+/* Keep a block for reuse by this thread, returns false when it is to be freed instead. */
+bool mem_thread_cache_push(void *ptr, size_t block_size);
+
+/* Memory domain of allocations made by the calling thread, see mallocn_domain.cc. */
+int mem_domain_current(void);
+/* Update the memory in use of a domain, when a block of that domain is allocated or freed. */
+void mem_domain_add(int domain, size_t len);
+void mem_domain_sub(int domain, size_t len);
+
 /* Prototypes for counted allocator functions */
 size_t MEM_lockfree_allocN_len(const void *vmemh) ATTR_WARN_UNUSED_RESULT;
 void MEM_lockfree_freeN(void *vmemh);
@@ -21,6 +21,7 @@
  */
 
 #include <stdarg.h>
+#include <stdint.h> /* SIZE_MAX */
 #include <stdio.h> /* printf */
 #include <stdlib.h>
 #include <string.h> /* memcpy */
@@ -59,9 +60,35 @@ enum {
 #define MEMHEAD_ALIGNED_FROM_PTR(ptr) (((MemHeadAligned *)ptr) - 1)
 #define MEMHEAD_IS_ALIGNED(memhead) ((memhead)->len & (size_t)MEMHEAD_ALIGN_FLAG)
 
+/* The memory domain of a block is stored in the highest byte of its length, which is never used
+ * by 64 bit allocation sizes. On 32 bit systems all memory counts towards #MEM_DOMAIN_OTHER. */
+#if SIZE_MAX > 0xFFFFFFFFu
+#  define MEMHEAD_DOMAIN_SHIFT 56
+#  define MEMHEAD_LEN_MASK ((((size_t)1 << MEMHEAD_DOMAIN_SHIFT) - 1) & ~(size_t)MEMHEAD_ALIGN_FLAG)
+#  define MEMHEAD_DOMAIN(memhead) ((int)((memhead)->len >> MEMHEAD_DOMAIN_SHIFT))
+#  define MEMHEAD_DOMAIN_BITS(domain) ((size_t)(domain) << MEMHEAD_DOMAIN_SHIFT)
+#else
+#  define MEMHEAD_LEN_MASK (~(size_t)MEMHEAD_ALIGN_FLAG)
+#  define MEMHEAD_DOMAIN(memhead) ((void)(memhead), MEM_DOMAIN_OTHER)
+#  define MEMHEAD_DOMAIN_BITS(domain) ((void)(domain), (size_t)0)
+#endif
+
 /* Uncomment this to have proper peak counter. */
 #define USE_ATOMIC_MAX
 
+/* Reuse small freed blocks from a per-thread cache, avoiding contention in the system allocator
+ * when many threads allocate at once. Disabled with address sanitizer, which can only detect
+ * use after free of blocks which are really freed. */
+#if !defined(__SANITIZE_ADDRESS__)
+#  define USE_THREAD_CACHE
+#endif
+
+#ifdef USE_THREAD_CACHE
+#  define MEMHEAD_BLOCK_SIZE(len) MEM_THREAD_CACHE_BLOCK_SIZE((len) + sizeof(MemHead))
+#else
+#  define MEMHEAD_BLOCK_SIZE(len) ((len) + sizeof(MemHead))
+#endif
+
 MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 {
 #ifdef USE_ATOMIC_MAX
@@ -71,6 +98,43 @@ MEM_INLINE void update_maximum(size_t *maximum_value, size_t value)
 #endif
 }
 
+MEM_INLINE MemHead *memhead_alloc(size_t len)
+{
+  const size_t block_size = MEMHEAD_BLOCK_SIZE(len);
+#ifdef USE_THREAD_CACHE
+  MemHead *memh = (MemHead *)mem_thread_cache_pop(block_size);
+  if (memh) {
+    return memh;
+  }
+#endif
+  return (MemHead *)malloc(block_size);
+}
+
+MEM_INLINE MemHead *memhead_calloc(size_t len)
+{
+  const size_t block_size = MEMHEAD_BLOCK_SIZE(len);
+#ifdef USE_THREAD_CACHE
+  MemHead *memh = (MemHead *)mem_thread_cache_pop(block_size);
+  if (memh) {
+    memset(memh, 0, len + sizeof(MemHead));
+    return memh;
+  }
+#endif
+  return (MemHead *)calloc(1, block_size);
+}
+
+MEM_INLINE void memhead_free(MemHead *memh, size_t len)
+{
+#ifdef USE_THREAD_CACHE
+  if (mem_thread_cache_push(memh, MEMHEAD_BLOCK_SIZE(len))) {
+    return;
+  }
+#else
+  (void)len;
+#endif
+  free(memh);
+}
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 2)))
 #endif
@@ -93,7 +157,7 @@ print_error(const char *str, ...)
 size_t MEM_lockfree_allocN_len(const void *vmemh)
 {
   if (vmemh) {
-    return MEMHEAD_FROM_PTR(vmemh)->len & ~((size_t)(MEMHEAD_ALIGN_FLAG));
+    return MEMHEAD_FROM_PTR(vmemh)->len & MEMHEAD_LEN_MASK;
   }
 
   return 0;
@@ -118,6 +182,7 @@ void MEM_lockfree_freeN(void *vmemh)
 
   atomic_sub_and_fetch_u(&totblock, 1);
   atomic_sub_and_fetch_z(&mem_in_use, len);
+  mem_domain_sub(MEMHEAD_DOMAIN(memh), len);
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -127,7 +192,7 @@ void MEM_lockfree_freeN(void *vmemh)
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
   else {
-    free(memh);
+    memhead_free(memh, len);
   }
 }
 
@@ -233,12 +298,14 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = memhead_calloc(len);
 
   if (LIKELY(memh)) {
-    memh->len = len;
+    const int domain = mem_domain_current();
+    memh->len = len | MEMHEAD_DOMAIN_BITS(domain);
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
+    mem_domain_add(domain, len);
     update_maximum(&peak_mem, mem_in_use);
 
     return PTR_FROM_MEMHEAD(memh);
@@ -274,16 +341,18 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = memhead_alloc(len);
 
   if (LIKELY(memh)) {
     if (UNLIKELY(malloc_debug_memset && len)) {
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len;
+    const int domain = mem_domain_current();
+    memh->len = len | MEMHEAD_DOMAIN_BITS(domain);
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
+    mem_domain_add(domain, len);
     update_maximum(&peak_mem, mem_in_use);
 
     return PTR_FROM_MEMHEAD(memh);
@@ -351,10 +420,12 @@ void *MEM_lockfree_mallocN_aligned(size_t len, size_t alignment, const char *str
       memset(memh + 1, 255, len);
     }
 
-    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG;
+    const int domain = mem_domain_current();
+    memh->len = len | (size_t)MEMHEAD_ALIGN_FLAG | MEMHEAD_DOMAIN_BITS(domain);
     memh->alignment = (short)alignment;
     atomic_add_and_fetch_u(&totblock, 1);
     atomic_add_and_fetch_z(&mem_in_use, len);
+    mem_domain_add(domain, len);
     update_maximum(&peak_mem, mem_in_use);
 
     return PTR_FROM_MEMHEAD(memh);
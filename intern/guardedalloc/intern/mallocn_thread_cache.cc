@@ -0,0 +1,144 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup MEM
+ *
+ * Per-thread cache of freed small blocks for the lock-free allocator.
+ *
+ * Small blocks are allocated with a size rounded up to a size class. When freed, they are kept
+ * in a free list of the freeing thread, so following allocations of the same size class on that
+ * thread don't have to go through the system allocator (and its locks) at all.
+ * The cache of a thread is released to the system allocator when the thread exits.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.h"
+
+namespace {
+
+struct CachedBlock {
+  CachedBlock *next;
+};
+
+struct ThreadCache {
+  CachedBlock *blocks[MEM_THREAD_CACHE_NUM_CLASSES];
+  int blocks_num[MEM_THREAD_CACHE_NUM_CLASSES];
+  /* Total size of the blocks kept in this cache. */
+  size_t size;
+};
+
+/* Maximum number of free blocks kept per size class. */
+const int MAX_BLOCKS_PER_CLASS = 64;
+/* Maximum size of all free blocks kept by a single thread. */
+const size_t MAX_CACHE_SIZE = 256 * 1024;
+
+/* Set when the cache of this thread has been released at thread exit, blocks freed afterwards
+ * go directly to the system allocator. */
+#define THREAD_CACHE_RELEASED ((ThreadCache *)(uintptr_t)1)
+
+/* Trivially destructible, so it stays accessible while thread local destructors run. */
+thread_local ThreadCache *thread_cache = nullptr;
+
+class ThreadCacheReleaser {
+ public:
+  ~ThreadCacheReleaser()
+  {
+    ThreadCache *cache = thread_cache;
+    thread_cache = THREAD_CACHE_RELEASED;
+    if (cache == nullptr || cache == THREAD_CACHE_RELEASED) {
+      return;
+    }
+    for (int i = 0; i < MEM_THREAD_CACHE_NUM_CLASSES; i++) {
+      CachedBlock *block = cache->blocks[i];
+      while (block != nullptr) {
+        CachedBlock *next = block->next;
+        free(block);
+        block = next;
+      }
+    }
+    free(cache);
+  }
+};
+
+ThreadCache *thread_cache_ensure()
+{
+  ThreadCache *cache = thread_cache;
+  if (cache != nullptr) {
+    return (cache == THREAD_CACHE_RELEASED) ? nullptr : cache;
+  }
+  cache = (ThreadCache *)calloc(1, sizeof(ThreadCache));
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  /* Register releasing of the cache when the thread exits. */
+  static thread_local ThreadCacheReleaser releaser;
+  (void)releaser;
+  thread_cache = cache;
+  return cache;
+}
+
+inline int size_class_from_block_size(const size_t block_size)
+{
+  return (int)(block_size / MEM_THREAD_CACHE_CLASS_SIZE) - 1;
+}
+
+}  // namespace
+
+void *mem_thread_cache_pop(size_t block_size)
+{
+  if (block_size > MEM_THREAD_CACHE_MAX_BLOCK_SIZE) {
+    return nullptr;
+  }
+  ThreadCache *cache = thread_cache;
+  if (cache == nullptr || cache == THREAD_CACHE_RELEASED) {
+    return nullptr;
+  }
+  const int size_class = size_class_from_block_size(block_size);
+  CachedBlock *block = cache->blocks[size_class];
+  if (block == nullptr) {
+    return nullptr;
+  }
+  cache->blocks[size_class] = block->next;
+  cache->blocks_num[size_class]--;
+  cache->size -= block_size;
+  return block;
+}
+
+bool mem_thread_cache_push(void *ptr, size_t block_size)
+{
+  if (block_size > MEM_THREAD_CACHE_MAX_BLOCK_SIZE) {
+    return false;
+  }
+  ThreadCache *cache = thread_cache_ensure();
+  if (cache == nullptr) {
+    return false;
+  }
+  const int size_class = size_class_from_block_size(block_size);
+  if (cache->blocks_num[size_class] >= MAX_BLOCKS_PER_CLASS ||
+      cache->size + block_size > MAX_CACHE_SIZE) {
+    return false;
+  }
+  CachedBlock *block = (CachedBlock *)ptr;
+  block->next = cache->blocks[size_class];
+  cache->blocks[size_class] = block;
+  cache->blocks_num[size_class]++;
+  cache->size += block_size;
+  return true;
+}
@@ -0,0 +1,47 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void DomainAllocateAndFree()
+{
+  const size_t image_in_use = MEM_get_memory_in_use_domain(MEM_DOMAIN_IMAGE);
+
+  const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_IMAGE);
+  void *image_block = MEM_mallocN(1000, __func__);
+  void *aligned_block = MEM_mallocN_aligned(1000, 64, __func__);
+  MEM_domain_end(previous_domain);
+  EXPECT_EQ(MEM_get_memory_in_use_domain(MEM_DOMAIN_IMAGE), image_in_use + 2000);
+
+  /* Blocks count towards the domain they were allocated in, also when freed on another thread. */
+  std::thread thread([&]() {
+    {
+      MEM_ScopedDomain domain(MEM_DOMAIN_MESH);
+      MEM_freeN(image_block);
+    }
+    MEM_freeN(aligned_block);
+  });
+  thread.join();
+  EXPECT_EQ(MEM_get_memory_in_use_domain(MEM_DOMAIN_IMAGE), image_in_use);
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_domain)
+{
+  DomainAllocateAndFree();
+  void *block = MEM_mallocN(100, __func__);
+  EXPECT_EQ(MEM_allocN_len(block), (size_t)100);
+  MEM_freeN(block);
+}
+
+TEST_F(GuardedAllocatorTest, MEM_domain)
+{
+  DomainAllocateAndFree();
+}
@@ -0,0 +1,67 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include <thread>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+namespace {
+
+void AllocateAndFreeSmallBlocks()
+{
+  std::vector<void *> blocks;
+  for (int iteration = 0; iteration < 8; iteration++) {
+    for (size_t size = 1; size < 2048; size += 7) {
+      blocks.push_back(MEM_mallocN(size, __func__));
+    }
+    for (void *block : blocks) {
+      MEM_freeN(block);
+    }
+    blocks.clear();
+  }
+}
+
+}  // namespace
+
+TEST_F(LockFreeAllocatorTest, MEM_thread_cache_memory_in_use)
+{
+  const size_t memory_in_use = MEM_get_memory_in_use();
+  const unsigned int blocks_in_use = MEM_get_memory_blocks_in_use();
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; i++) {
+    threads.emplace_back(AllocateAndFreeSmallBlocks);
+  }
+  AllocateAndFreeSmallBlocks();
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+
+  /* Blocks kept in thread caches are not in use. */
+  EXPECT_EQ(MEM_get_memory_in_use(), memory_in_use);
+  EXPECT_EQ(MEM_get_memory_blocks_in_use(), blocks_in_use);
+}
+
+TEST_F(LockFreeAllocatorTest, MEM_thread_cache_reuse)
+{
+  /* Blocks reused from the cache keep reporting the requested size and callocN zeroes them. */
+  char *block = (char *)MEM_mallocN(60, __func__);
+  memset(block, 0xff, 60);
+  MEM_freeN(block);
+
+  block = (char *)MEM_callocN(52, __func__);
+  EXPECT_EQ(MEM_allocN_len(block), (size_t)52);
+  for (int i = 0; i < 52; i++) {
+    EXPECT_EQ(block[i], 0);
+  }
+
+  block = (char *)MEM_reallocN(block, 500);
+  EXPECT_EQ(MEM_allocN_len(block), (size_t)500);
+  for (int i = 0; i < 52; i++) {
+    EXPECT_EQ(block[i], 0);
+  }
+  MEM_freeN(block);
+}
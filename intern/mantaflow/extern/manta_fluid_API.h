@@ -71,6 +71,7 @@ bool manta_has_guiding(struct MANTA *fluid,
                        struct FluidModifierData *fmd,
                        int framenr,
                        bool domain);
+bool manta_wait_for_saves(struct MANTA *fluid);
 
 void manta_update_variables(struct MANTA *fluid, struct FluidModifierData *fmd);
 int manta_get_frame(struct MANTA *fluid);
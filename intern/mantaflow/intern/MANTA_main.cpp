@@ -21,6 +21,7 @@
  * \ingroup mantaflow
  */
 
+#include <algorithm>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -767,6 +768,7 @@ void MANTA::initializeRNAMap(FluidModifierData *fmd)
   mRNAMap["USING_DISSOLVE"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_DISSOLVE);
   mRNAMap["DOMAIN_CLOSED"] = getBooleanString(borderCollisions.compare("") == 0);
   mRNAMap["CACHE_RESUMABLE"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_RESUMABLE_CACHE);
+  mRNAMap["USING_ASYNC_SAVE"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_ASYNC_SAVE);
   mRNAMap["USING_ADAPTIVETIME"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_ADAPTIVE_TIME);
   mRNAMap["USING_SPEEDVECTORS"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_SPEED_VECTORS);
   mRNAMap["USING_FRACTIONS"] = getBooleanString(fds->flags & FLUID_DOMAIN_USE_FRACTIONS);
@@ -1180,7 +1182,7 @@ bool MANTA::writeData(FluidModifierData *fmd, int framenr)
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
   }
-  return runPythonString(pythonCommands);
+  return runSaveCommands(fmd, pythonCommands, FLUID_DOMAIN_DIR_DATA, framenr);
 }
 
 bool MANTA::writeNoise(FluidModifierData *fmd, int framenr)
@@ -1202,7 +1204,7 @@ bool MANTA::writeNoise(FluidModifierData *fmd, int framenr)
        << ", '" << volume_format << "', " << resumable_cache << ")";
     pythonCommands.push_back(ss.str());
   }
-  return runPythonString(pythonCommands);
+  return runSaveCommands(fmd, pythonCommands, FLUID_DOMAIN_DIR_NOISE, framenr);
 }
 
 bool MANTA::readConfiguration(FluidModifierData *fmd, int framenr)
@@ -1269,6 +1271,9 @@ bool MANTA::readData(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasData(fmd, framenr))
     return false;
 
+  if (!waitForSaves())
+    return false;
+
   if (mUsingSmoke) {
     ss.str("");
     ss << "smoke_load_data_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
@@ -1312,6 +1317,9 @@ bool MANTA::readNoise(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasNoise(fmd, framenr))
     return false;
 
+  if (!waitForSaves())
+    return false;
+
   ss.str("");
   ss << "smoke_load_noise_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
@@ -1340,6 +1348,9 @@ bool MANTA::readMesh(FluidModifierData *fmd, int framenr)
   if (!hasMesh(fmd, framenr))
     return false;
 
+  if (!waitForSaves())
+    return false;
+
   ss.str("");
   ss << "liquid_load_mesh_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << mesh_format << "')";
@@ -1381,6 +1392,9 @@ bool MANTA::readParticles(FluidModifierData *fmd, int framenr, bool resumable)
   if (!hasParticles(fmd, framenr))
     return false;
 
+  if (!waitForSaves())
+    return false;
+
   ss.str("");
   ss << "liquid_load_particles_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
      << ", '" << volume_format << "', " << resumable_cache << ")";
@@ -1411,6 +1425,9 @@ bool MANTA::readGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   if (!hasGuiding(fmd, framenr, sourceDomain))
     return false;
 
+  if (!waitForSaves())
+    return false;
+
   if (sourceDomain) {
     ss.str("");
     ss << "fluid_load_vel_" << mCurrentID << "('" << escapePath(directory) << "', " << framenr
@@ -1510,7 +1527,7 @@ bool MANTA::bakeMesh(FluidModifierData *fmd, int framenr)
      << volume_format << "', '" << mesh_format << "')";
   pythonCommands.push_back(ss.str());
 
-  return runPythonString(pythonCommands);
+  return runSaveCommands(fmd, pythonCommands, FLUID_DOMAIN_DIR_MESH, framenr);
 }
 
 bool MANTA::bakeParticles(FluidModifierData *fmd, int framenr)
@@ -1540,7 +1557,7 @@ bool MANTA::bakeParticles(FluidModifierData *fmd, int framenr)
      << framenr << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
 
-  return runPythonString(pythonCommands);
+  return runSaveCommands(fmd, pythonCommands, FLUID_DOMAIN_DIR_PARTICLES, framenr);
 }
 
 bool MANTA::bakeGuiding(FluidModifierData *fmd, int framenr)
@@ -1570,7 +1587,7 @@ bool MANTA::bakeGuiding(FluidModifierData *fmd, int framenr)
      << ", '" << volume_format << "', " << resumable_cache << ")";
   pythonCommands.push_back(ss.str());
 
-  return runPythonString(pythonCommands);
+  return runSaveCommands(fmd, pythonCommands, FLUID_DOMAIN_DIR_GUIDE, framenr);
 }
 
 bool MANTA::updateVariables(FluidModifierData *fmd)
@@ -2161,6 +2178,10 @@ bool MANTA::hasData(FluidModifierData *fmd, int framenr)
     string filename = (mUsingSmoke) ? FLUID_NAME_DENSITY : FLUID_NAME_PP;
     exists = BLI_exists(getFile(fmd, FLUID_DOMAIN_DIR_DATA, filename, extension, framenr).c_str());
   }
+  /* Files of a frame that is still being written count as present. */
+  if (!exists) {
+    exists = isSavePending(FLUID_DOMAIN_DIR_DATA, framenr);
+  }
   if (with_debug)
     cout << "Fluid: Has Data: " << exists << endl;
 
@@ -2187,6 +2208,10 @@ bool MANTA::hasNoise(FluidModifierData *fmd, int framenr)
         getFile(fmd, FLUID_DOMAIN_DIR_NOISE, FLUID_NAME_DENSITY_NOISE, extension, framenr)
             .c_str());
   }
+  /* Files of a frame that is still being written count as present. */
+  if (!exists) {
+    exists = isSavePending(FLUID_DOMAIN_DIR_NOISE, framenr);
+  }
   if (with_debug)
     cout << "Fluid: Has Noise: " << exists << endl;
 
@@ -2204,6 +2229,10 @@ bool MANTA::hasMesh(FluidModifierData *fmd, int framenr)
     exists = BLI_exists(
         getFile(fmd, FLUID_DOMAIN_DIR_MESH, FLUID_NAME_LMESH, extension, framenr).c_str());
   }
+  /* Files of a frame that is still being written count as present. */
+  if (!exists) {
+    exists = isSavePending(FLUID_DOMAIN_DIR_MESH, framenr);
+  }
   if (with_debug)
     cout << "Fluid: Has Mesh: " << exists << endl;
 
@@ -2230,6 +2259,10 @@ bool MANTA::hasParticles(FluidModifierData *fmd, int framenr)
         getFile(fmd, FLUID_DOMAIN_DIR_PARTICLES, FLUID_NAME_PP_PARTICLES, extension, framenr)
             .c_str());
   }
+  /* Files of a frame that is still being written count as present. */
+  if (!exists) {
+    exists = isSavePending(FLUID_DOMAIN_DIR_PARTICLES, framenr);
+  }
   if (with_debug)
     cout << "Fluid: Has Particles: " << exists << endl;
 
@@ -2248,6 +2281,9 @@ bool MANTA::hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
     filename = (sourceDomain) ? FLUID_NAME_VEL : FLUID_NAME_GUIDEVEL;
     exists = BLI_exists(getFile(fmd, subdirectory, filename, extension, framenr).c_str());
   }
+  if (!exists) {
+    exists = isSavePending(subdirectory, framenr);
+  }
 
   if (with_debug)
     cout << "Fluid: Has Guiding: " << exists << endl;
@@ -2255,6 +2291,57 @@ bool MANTA::hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain)
   return exists;
 }
 
+bool MANTA::waitForSaves()
+{
+  if (mPendingSaves.empty())
+    return true;
+
+  if (with_debug)
+    cout << "MANTA::waitForSaves()" << endl;
+
+  ostringstream ss;
+  vector<string> pythonCommands;
+  ss << "fluid_file_export_wait_s" << mCurrentID << "()";
+  pythonCommands.push_back(ss.str());
+
+  mPendingSaves.clear();
+  return runPythonString(pythonCommands);
+}
+
+bool MANTA::runSaveCommands(FluidModifierData *fmd,
+                            vector<string> &pythonCommands,
+                            string subdirectory,
+                            int framenr)
+{
+  if (!(fmd->domain->flags & FLUID_DOMAIN_USE_ASYNC_SAVE))
+    return runPythonString(pythonCommands);
+
+  addPendingSave(subdirectory, framenr);
+  if (runPythonString(pythonCommands))
+    return true;
+
+  /* Saving first waits for older asynchronous saves and fails when one of them failed. The files
+   * of pending frames can't be counted on anymore then. */
+  mPendingSaves.clear();
+  return false;
+}
+
+void MANTA::addPendingSave(string subdirectory, int framenr)
+{
+  vector<int> &frames = mPendingSaves[subdirectory];
+  if (frames.empty() || frames.back() != framenr)
+    frames.push_back(framenr);
+}
+
+bool MANTA::isSavePending(string subdirectory, int framenr)
+{
+  auto it = mPendingSaves.find(subdirectory);
+  if (it == mPendingSaves.end())
+    return false;
+  const vector<int> &frames = it->second;
+  return std::find(frames.begin(), frames.end(), framenr) != frames.end();
+}
+
 string MANTA::getDirectory(FluidModifierData *fmd, string subdirectory)
 {
   char directory[FILE_MAX];
@@ -116,6 +116,10 @@ struct MANTA {
   bool hasParticles(FluidModifierData *fmd, int framenr);
   bool hasGuiding(FluidModifierData *fmd, int framenr, bool sourceDomain);
 
+  /* Wait for the cache files that are still being written in the background.
+   * Returns false when writing one of them failed. */
+  bool waitForSaves();
+
   inline size_t getTotalCells()
   {
     return mTotalCells;
@@ -857,6 +861,9 @@ struct MANTA {
 
   /* Mesh fields. */
   vector<Node> *mMeshNodes;
+  /* Frames per cache subdirectory whose files may still be written in the background. */
+  unordered_map<string, vector<int>> mPendingSaves;
+
   vector<Triangle> *mMeshTriangles;
   vector<pVel> *mMeshVelocities;
 
@@ -886,6 +893,12 @@ struct MANTA {
                  string fname,
                  string extension,
                  int framenr);
+  bool runSaveCommands(FluidModifierData *fmd,
+                       vector<string> &pythonCommands,
+                       string subdirectory,
+                       int framenr);
+  void addPendingSave(string subdirectory, int framenr);
+  bool isSavePending(string subdirectory, int framenr);
 };
 
 #endif
@@ -149,6 +149,11 @@ bool manta_has_guiding(MANTA *fluid, FluidModifierData *fmd, int framenr, bool d
   return fluid->hasGuiding(fmd, framenr, domain);
 }
 
+bool manta_wait_for_saves(MANTA *fluid)
+{
+  return fluid->waitForSaves();
+}
+
 void manta_update_variables(MANTA *fluid, FluidModifierData *fmd)
 {
   fluid->updateVariables(fmd);
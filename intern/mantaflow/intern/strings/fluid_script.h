@@ -33,7 +33,8 @@ from manta import *\n\
 import os.path, shutil, math, sys, gc, multiprocessing, platform, time\n\
 \n\
 withMPBake = False # Bake files asynchronously\n\
-withMPSave = False # Save files asynchronously\n\
+withMPSave = platform.system() == 'Linux' # Allow saving files asynchronously (forked writer processes, opt-in per domain)\n\
+maxMPSave = 2 # Maximum number of pending asynchronous saves\n\
 isWindows = platform.system() != 'Darwin' and platform.system() != 'Linux'\n\
 # TODO(sebbas): Use this to simulate Windows multiprocessing (has default mode spawn)\n\
 #try:\n\
@@ -114,6 +115,7 @@ using_outflow_s$ID$      = $USING_OUTFLOW$\n\
 using_sndparts_s$ID$     = $USING_SNDPARTS$\n\
 using_speedvectors_s$ID$ = $USING_SPEEDVECTORS$\n\
 using_diffusion_s$ID$    = $USING_DIFFUSION$\n\
+using_async_save_s$ID$   = $USING_ASYNC_SAVE$\n\
 \n\
 # Fluid time params\n\
 timeScale_s$ID$    = $TIME_SCALE$\n\
@@ -423,6 +425,13 @@ def fluid_post_step_$ID$():\n\
 const std::string fluid_delete_all =
     "\n\
 mantaMsg('Deleting fluid')\n\
+# Finish pending asynchronous saves first, their failure doesn't matter anymore\n\
+if 'fluid_file_export_wait_s$ID$' in globals():\n\
+    try:\n\
+        fluid_file_export_wait_s$ID$()\n\
+    except Exception:\n\
+        pass\n\
+\n\
 # Clear all helper dictionaries first\n\
 mantaMsg('Clear helper dictionaries')\n\
 if 'liquid_data_dict_final_s$ID$' in globals(): liquid_data_dict_final_s$ID$.clear()\n\
@@ -725,17 +734,49 @@ def fluid_file_export_s$ID$(framenr, file_format, path, dict, file_name=None, mo
     \n\
     except Exception as e:\n\
         mantaMsg('Exception in Python fluid file export: ' + str(e))\n\
-        pass # Just skip file save errors for now\n";
+        return False # Just skip file save errors for now, unless saving asynchronously\n\
+\n\
+if 'fluid_save_processes_s$ID$' not in globals():\n\
+    fluid_save_processes_s$ID$ = []\n\
+\n\
+# Runs in the forked writer, the exit code reports a failed save to the parent.\n\
+def fluid_file_export_process_s$ID$(**kwargs):\n\
+    if fluid_file_export_s$ID$(**kwargs) is False:\n\
+        sys.exit(1)\n\
+\n\
+# Wait until at most max_pending asynchronous saves are left. Raises when one of them failed.\n\
+def fluid_file_export_wait_s$ID$(max_pending=0):\n\
+    failed = False\n\
+    while len(fluid_save_processes_s$ID$) > max_pending:\n\
+        p = fluid_save_processes_s$ID$.pop(0)\n\
+        p.join()\n\
+        failed = failed or p.exitcode != 0\n\
+    if failed:\n\
+        raise RuntimeError('Fluid: Asynchronous cache file export failed')\n\
+\n\
+# The forked writer saves a copy-on-write snapshot of the grids while the simulation continues.\n\
+# Memory pages are only duplicated once the solver overwrites them, and since at most maxMPSave\n\
+# saves are pending, so are at most maxMPSave snapshots.\n\
+def fluid_file_export_async_s$ID$(**kwargs):\n\
+    if kwargs.get('skip_subframes', True) and ((timePerFrame_s$ID$ + dt0_s$ID$) < frameLength_s$ID$):\n\
+        return\n\
+    fluid_file_export_wait_s$ID$(maxMPSave - 1)\n\
+    p = multiprocessing.Process(target=fluid_file_export_process_s$ID$, kwargs=kwargs)\n\
+    p.start()\n\
+    fluid_save_processes_s$ID$.append(p)\n\
+\n\
+def fluid_save_s$ID$(**kwargs):\n\
+    if not using_async_save_s$ID$ or not withMPSave or isWindows:\n\
+        fluid_file_export_s$ID$(**kwargs)\n\
+    else:\n\
+        fluid_file_export_async_s$ID$(**kwargs)\n";
 
 const std::string fluid_save_guiding =
     "\n\
 def fluid_save_guiding_$ID$(path, framenr, file_format, resumable):\n\
     mantaMsg('Fluid save guiding, frame ' + str(framenr))\n\
     dict = fluid_guiding_dict_s$ID$\n\
-    if not withMPSave or isWindows:\n\
-        fluid_file_export_s$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n\
-    else:\n\
-        fluid_cache_multiprocessing_start_$ID$(function=fluid_file_export_s$ID$, file_name=file_guiding_s$ID$, framenr=framenr, format_data=file_format, path_data=path, dict=dict, do_join=False)\n";
+    fluid_save_s$ID$(dict=dict, framenr=framenr, file_format=file_format, path=path, file_name=file_guiding_s$ID$)\n";
 
 //////////////////////////////////////////////////////////////////////
 // STANDALONE MODE
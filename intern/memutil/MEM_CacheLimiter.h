@@ -66,6 +66,9 @@ void MEM_CacheLimiter_set_maximum(size_t m);
 size_t MEM_CacheLimiter_get_maximum();
 void MEM_CacheLimiter_set_disabled(bool disabled);
 bool MEM_CacheLimiter_is_disabled(void);
+void MEM_CacheLimiter_external_memory_add(size_t size);
+void MEM_CacheLimiter_external_memory_sub(size_t size);
+size_t MEM_CacheLimiter_get_external_memory_in_use(void);
 };
 #endif
 
@@ -199,7 +202,8 @@ template<class T> class MEM_CacheLimiter {
       return;
     }
 
-    mem_in_use = get_memory_in_use();
+    /* Caches which are not managed by a limiter share the same maximum. */
+    mem_in_use = get_memory_in_use() + MEM_CacheLimiter_get_external_memory_in_use();
 
     if (mem_in_use <= max) {
       return;
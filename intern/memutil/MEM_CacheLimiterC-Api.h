@@ -50,6 +50,9 @@ void MEM_CacheLimiter_set_maximum(size_t m);
 size_t MEM_CacheLimiter_get_maximum(void);
 void MEM_CacheLimiter_set_disabled(bool disabled);
 bool MEM_CacheLimiter_is_disabled(void);
+void MEM_CacheLimiter_external_memory_add(size_t size);
+void MEM_CacheLimiter_external_memory_sub(size_t size);
+size_t MEM_CacheLimiter_get_external_memory_in_use(void);
 #endif /* __MEM_CACHELIMITER_H__ */
 
 /**
@@ -18,6 +18,7 @@
  * \ingroup memutil
  */
 
+#include <atomic>
 #include <cstddef>
 
 #include "MEM_CacheLimiter.h"
@@ -25,6 +26,10 @@
 
 static bool is_disabled = false;
 
+/* Memory used by caches which evict their own items, counted against the maximum of all
+ * limiters so the caches share one budget. */
+static std::atomic<size_t> external_memory_in_use(0);
+
 static size_t &get_max()
 {
   static size_t m = 32 * 1024 * 1024;
@@ -51,6 +56,21 @@ bool MEM_CacheLimiter_is_disabled(void)
   return is_disabled;
 }
 
+void MEM_CacheLimiter_external_memory_add(size_t size)
+{
+  external_memory_in_use += size;
+}
+
+void MEM_CacheLimiter_external_memory_sub(size_t size)
+{
+  external_memory_in_use -= size;
+}
+
+size_t MEM_CacheLimiter_get_external_memory_in_use(void)
+{
+  return external_memory_in_use;
+}
+
 class MEM_CacheLimiterHandleCClass;
 class MEM_CacheLimiterCClass;
 
@@ -285,6 +285,7 @@ class RENDER_PT_output(RenderOutputButtonsPanel, Panel):
         col = layout.column(heading="Saving")
         col.prop(rd, "use_file_extension")
         col.prop(rd, "use_render_cache")
+        col.prop(rd, "use_background_write")
 
         layout.template_image_settings(image_settings, color_management=False)
 
@@ -378,6 +379,7 @@ class RENDER_PT_encoding_video(RenderOutputButtonsPanel, Panel):
 
         # Encoding speed
         layout.prop(ffmpeg, "ffmpeg_preset")
+        layout.prop(ffmpeg, "threads")
         # I-frames
         layout.prop(ffmpeg, "gopsize")
         # B-Frames
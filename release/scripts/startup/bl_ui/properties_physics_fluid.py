@@ -1234,6 +1234,10 @@ class PHYSICS_PT_cache(PhysicButtonsPanel, Panel):
         row.enabled = not is_baking_any and not has_baked_data
         row.prop(domain, "cache_resumable", text="Is Resumable")
 
+        row = col.row()
+        row.enabled = not is_baking_any
+        row.prop(domain, "use_async_cache_save")
+
         row = col.row()
         row.enabled = not is_baking_any and not has_baked_data
         row.prop(domain, "cache_data_format", text="Format Volumes")
@@ -256,6 +256,9 @@ class NODE_MT_view(Menu):
         # Auto-offset nodes (called "insert_offset" in code)
         layout.prop(snode, "use_insert_offset")
 
+        if snode.tree_type in {'GeometryNodeTree', 'CompositorNodeTree'}:
+            layout.prop(snode, "show_timings")
+
         layout.separator()
 
         sub = layout.column()
@@ -676,6 +679,8 @@ class NODE_PT_quality(bpy.types.Panel):
         col.prop(tree, "use_groupnode_buffer")
         col.prop(tree, "use_two_pass")
         col.prop(tree, "use_viewer_border")
+        if prefs.experimental.use_full_frame_compositor and tree.execution_mode == 'FULL_FRAME':
+            col.prop(tree, "use_visible_region")
         col.separator()
         col.prop(snode, "use_auto_render")
 
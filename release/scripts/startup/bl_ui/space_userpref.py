@@ -675,6 +675,10 @@ class USERPREF_PT_system_video_sequencer(SystemPanel, CenterAlignMixIn, Panel):
 
         layout.prop(system, "sequencer_proxy_setup")
 
+        layout.separator()
+
+        layout.prop(system, "use_hardware_video_decode")
+
 
 # -----------------------------------------------------------------------------
 # Viewport Panels
@@ -739,6 +743,7 @@ class USERPREF_PT_viewport_textures(ViewportPanel, CenterAlignMixIn, Panel):
 
         col = layout.column()
         col.prop(system, "gl_texture_limit", text="Limit Size")
+        col.prop(system, "texture_memory_limit", text="Memory Limit")
         col.prop(system, "anisotropic_filter")
         col.prop(system, "gl_clip_alpha", slider=True)
         col.prop(system, "image_draw_method", text="Image Display Method")
@@ -2283,6 +2288,12 @@ class USERPREF_PT_experimental_prototypes(ExperimentalPanel, Panel):
                 ({"property": "use_new_hair_type"}, "T68981"),
                 ({"property": "use_new_point_cloud_type"}, "T75717"),
                 ({"property": "use_full_frame_compositor"}, "T88150"),
+                ({"property": "use_undo_skip_unchanged_ids"}, None),
+                ({"property": "use_autosave_async"}, None),
+                ({"property": "use_geometry_nodes_cache"}, None),
+                ({"property": "use_gpu_mesh_extraction"}, None),
+                ({"property": "use_shader_cache"}, None),
+                ({"property": "use_viewport_mesh_lod"}, None),
             ),
         )
 
@@ -364,6 +364,9 @@ void makeDerivedMesh(struct Depsgraph *depsgraph,
                      struct BMEditMesh *em,
                      const struct CustomData_MeshMasks *dataMask);
 
+/** Free the result of the modifier stack kept for modifiers with #eModifierFlag_CacheResult. */
+void BKE_mesh_modifier_stack_cache_free(struct Object *ob);
+
 void DM_calc_loop_tangents(DerivedMesh *dm,
                            bool calc_active_tangent,
                            const char (*tangent_names)[MAX_NAME],
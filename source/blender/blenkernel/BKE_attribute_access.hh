@@ -29,6 +29,8 @@
 #include "BLI_float2.hh"
 #include "BLI_float3.hh"
 #include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_set.hh"
 
 namespace blender::bke {
 
@@ -62,6 +64,21 @@ class AttributeIDRef {
 
 }  // namespace blender::bke
 
+namespace blender {
+
+/**
+ * Named attributes are hashed and compared as strings, so store the hash in the slots of maps and
+ * sets to avoid most string comparisons.
+ */
+template<typename Value> struct DefaultMapSlot<bke::AttributeIDRef, Value> {
+  using type = HashedMapSlot<bke::AttributeIDRef, Value>;
+};
+template<> struct DefaultSetSlot<bke::AttributeIDRef> {
+  using type = HashedSetSlot<bke::AttributeIDRef>;
+};
+
+}  // namespace blender
+
 /**
  * Contains information about an attribute in a geometry component.
  * More information can be added in the future. E.g. whether the attribute is builtin and how it is
@@ -274,6 +274,9 @@ bool bvhcache_has_tree(const struct BVHCache *bvh_cache, const BVHTree *tree);
 struct BVHCache *bvhcache_init(void);
 void bvhcache_free(struct BVHCache *bvh_cache);
 
+/* Trees shared between meshes with the same data. */
+void BKE_bvhtree_shared_cache_free(void);
+
 #ifdef __cplusplus
 }
 #endif
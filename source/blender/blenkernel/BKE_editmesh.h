@@ -89,6 +89,12 @@ typedef struct BMEditMesh {
    */
   char needs_flush_to_id;
 
+  /**
+   * Set by operations that only move vertices (transform), so the draw cache can keep
+   * the buffers that don't depend on positions. Cleared by #EDBM_update.
+   */
+  char is_deform_only_update;
+
 } BMEditMesh;
 
 /* editmesh.c */
@@ -373,6 +373,12 @@ class MeshComponent : public GeometryComponent {
  private:
   Mesh *mesh_ = nullptr;
   GeometryOwnershipType ownership_ = GeometryOwnershipType::Owned;
+  /**
+   * When set, custom data layers of the mesh may be references to the layers of the mesh in this
+   * component. Holding a user of that component keeps it alive and immutable, so that the shared
+   * layers don't change. Layers have to be duplicated before they are modified.
+   */
+  blender::UserCounter<const GeometryComponent> shared_layers_source_;
 
  public:
   MeshComponent();
@@ -386,6 +392,7 @@ class MeshComponent : public GeometryComponent {
 
   const Mesh *get_for_read() const;
   Mesh *get_for_write();
+  Mesh *get_for_write_with_shared_layers();
 
   int attribute_domain_size(const AttributeDomain domain) const final;
   std::unique_ptr<blender::fn::GVArray> attribute_try_adapt_domain(
@@ -38,6 +38,10 @@
 extern "C" {
 #endif
 
+struct GHash;
+struct ID;
+struct Main;
+
 /* BKE_libblock_free, delete are declared in BKE_lib_id.h for convenience. */
 
 /* Also IDRemap->flag. */
@@ -99,6 +103,12 @@ void BKE_libblock_remap_locked(struct Main *bmain,
                                const short remap_flags) ATTR_NONNULL(1, 2);
 void BKE_libblock_remap(struct Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
     ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple_locked(struct Main *bmain,
+                                        struct GHash *old_to_new,
+                                        const short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_remap_multiple(struct Main *bmain,
+                                 struct GHash *old_to_new,
+                                 const short remap_flags) ATTR_NONNULL(1, 2);
 
 void BKE_libblock_unlink(struct Main *bmain,
                          void *idv,
@@ -110,6 +120,10 @@ void BKE_libblock_relink_ex(struct Main *bmain,
                             void *old_idv,
                             void *new_idv,
                             const short remap_flags) ATTR_NONNULL(1, 2);
+void BKE_libblock_relink_multiple(struct Main *bmain,
+                                  void *idv,
+                                  struct GHash *old_to_new,
+                                  const short remap_flags) ATTR_NONNULL(1, 2, 3);
 
 void BKE_libblock_relink_to_newid(struct ID *id) ATTR_NONNULL();
 void BKE_libblock_relink_to_newid_new(struct Main *bmain, struct ID *id) ATTR_NONNULL();
@@ -36,6 +36,7 @@ struct Depsgraph;
 struct KeyBlock;
 struct MLoop;
 struct MLoopTri;
+struct MeshElemMap;
 struct MVertTri;
 struct Mesh;
 struct Object;
@@ -52,6 +53,10 @@ bool BKE_mesh_runtime_reset_edit_data(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_geometry(struct Mesh *mesh);
 void BKE_mesh_runtime_clear_cache(struct Mesh *mesh);
 
+const struct MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(const struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(const struct Mesh *mesh);
+const struct MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(const struct Mesh *mesh);
+
 void BKE_mesh_runtime_verttri_from_looptri(struct MVertTri *r_verttri,
                                            const struct MLoop *mloop,
                                            const struct MLoopTri *looptri,
@@ -56,6 +56,20 @@ typedef struct {
   float (*co)[3];
 } PBVHProxyNode;
 
+/* Copy of the unique vertices of a mesh leaf node, contiguous and in the order of the node
+ * vertex indices (which is also the order of the node proxies). */
+typedef struct {
+  float (*co)[3];
+  float (*no)[3];
+  /* Zero when the mesh has no paint mask. */
+  float *mask;
+  /* False for hidden vertices when the PBVH respects hiding. */
+  bool *visible;
+  /* Mesh vertex indices, owned by the node. */
+  const int *index;
+  int totvert;
+} PBVHVertexData;
+
 typedef struct {
   float (*color)[4];
 } PBVHColorBufferNode;
@@ -78,6 +92,9 @@ typedef enum {
 
   PBVH_UpdateTopology = 1 << 13,
   PBVH_UpdateColor = 1 << 14,
+  /* Only the mask or colors of the draw buffers are outdated, see #PBVH_UpdateDrawBuffers. */
+  PBVH_UpdateMaskDrawBuffers = 1 << 15,
+  PBVH_UpdateColorDrawBuffers = 1 << 16,
 } PBVHNodeFlags;
 
 typedef struct PBVHFrustumPlanes {
@@ -415,7 +432,8 @@ void pbvh_vertex_iter_init(PBVH *pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
           } \
         } \
         else if (vi.mverts) { \
-          vi.mvert = &vi.mverts[vi.vert_indices[vi.gx]]; \
+          vi.index = vi.vert_indices[vi.i]; \
+          vi.mvert = &vi.mverts[vi.index]; \
           if (vi.respect_hide) { \
             vi.visible = !(vi.mvert->flag & ME_HIDE); \
             if (mode == PBVH_ITER_UNIQUE && !vi.visible) { \
@@ -427,7 +445,6 @@ void pbvh_vertex_iter_init(PBVH *pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
           } \
           vi.co = vi.mvert->co; \
           vi.no = vi.mvert->no; \
-          vi.index = vi.vert_indices[vi.i]; \
           if (vi.vmask) { \
             vi.mask = &vi.vmask[vi.index]; \
           } \
@@ -463,6 +480,7 @@ void pbvh_vertex_iter_init(PBVH *pbvh, PBVHNode *node, PBVHVertexIter *vi, int m
 void BKE_pbvh_node_get_proxies(PBVHNode *node, PBVHProxyNode **proxies, int *proxy_count);
 void BKE_pbvh_node_free_proxies(PBVHNode *node);
 PBVHProxyNode *BKE_pbvh_node_add_proxy(PBVH *pbvh, PBVHNode *node);
+const PBVHVertexData *BKE_pbvh_node_vertex_data_gather(PBVH *pbvh, PBVHNode *node);
 void BKE_pbvh_gather_proxies(PBVH *pbvh, PBVHNode ***r_array, int *r_tot);
 void BKE_pbvh_node_get_bm_orco_data(PBVHNode *node,
                                     int (**r_orco_tris)[3],
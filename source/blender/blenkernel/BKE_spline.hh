@@ -20,10 +20,12 @@
  * \ingroup bke
  */
 
+#include <memory>
 #include <mutex>
 
 #include "FN_generic_virtual_array.hh"
 
+#include "BLI_array.hh"
 #include "BLI_float3.hh"
 #include "BLI_float4x4.hh"
 #include "BLI_vector.hh"
@@ -384,13 +386,18 @@ class NURBSpline final : public Spline {
   /** Method used to recalculate the knots vector when points are added or removed. */
   KnotsMode knots_mode;
 
+  /**
+   * The influences of the control points on each evaluated point, stored contiguously. Every
+   * evaluated point is influenced by #order() control points, starting at its start index (with
+   * trailing zero weights when fewer points have an influence). The raw allocator is used because
+   * caches of splines without custom weights are shared in a global cache.
+   */
   struct BasisCache {
-    /** The influence at each control point `i + #start_index`. */
-    blender::Vector<float> weights;
-    /**
-     * An offset for the start of #weights: the first control point index with a non-zero weight.
-     */
-    int start_index;
+    /** The influence of control point `start_indices[i] + j` on evaluated point `i` is stored at
+     * `i * order + j`. */
+    blender::RawArray<float> weights;
+    /** The first control point index with a non-zero weight for each evaluated point. */
+    blender::RawArray<int> start_indices;
   };
 
  private:
@@ -416,7 +423,7 @@ class NURBSpline final : public Spline {
   mutable bool knots_dirty_ = true;
 
   /** Cache of control point influences on each evaluated point. */
-  mutable blender::Vector<BasisCache> basis_cache_;
+  mutable std::shared_ptr<const BasisCache> basis_cache_;
   mutable std::mutex basis_cache_mutex_;
   mutable bool basis_cache_dirty_ = true;
 
@@ -484,7 +491,7 @@ class NURBSpline final : public Spline {
   void reverse_impl() override;
 
   void calculate_knots() const;
-  blender::Span<BasisCache> calculate_basis_cache() const;
+  const BasisCache &calculate_basis_cache() const;
 };
 
 /**
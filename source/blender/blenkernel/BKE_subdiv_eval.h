@@ -30,6 +30,7 @@ extern "C" {
 #endif
 
 struct Mesh;
+struct OpenSubdiv_PatchCoord;
 struct Subdiv;
 
 /* Returns true if evaluator is ready for use. */
@@ -145,6 +146,20 @@ void BKE_subdiv_eval_limit_patch_resolution_point_and_short_normal(struct Subdiv
                                                                    const int normal_offset,
                                                                    const int normal_stride);
 
+/* Batched queries.
+ *
+ * Evaluate points of a limit surface for many patch coordinates at once, which is much faster
+ * than single point queries. Normals are optional, when they are requested the derivatives
+ * arrays are used as temporary storage and must be of the same size. */
+void BKE_subdiv_eval_limit_patch_coords_and_normals(
+    struct Subdiv *subdiv,
+    const struct OpenSubdiv_PatchCoord *patch_coords,
+    const int num_patch_coords,
+    float (*r_P)[3],
+    float (*r_N)[3],
+    float (*r_dPdu)[3],
+    float (*r_dPdv)[3]);
+
 #ifdef __cplusplus
 }
 #endif
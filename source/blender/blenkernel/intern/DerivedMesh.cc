@@ -27,20 +27,26 @@
 #include "MEM_guardedalloc.h"
 
 #include "DNA_cloth_types.h"
+#include "DNA_color_types.h"
+#include "DNA_curveprofile_types.h"
 #include "DNA_customdata_types.h"
+#include "DNA_genfile.h"
 #include "DNA_key_types.h"
 #include "DNA_material_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_sdna_types.h"
 
 #include "BLI_array.h"
 #include "BLI_bitmap.h"
 #include "BLI_blenlib.h"
 #include "BLI_float2.hh"
+#include "BLI_hash_mm2a.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
+#include "BLI_session_uuid.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
@@ -968,6 +974,384 @@ static Mesh *modifier_modify_mesh_and_geometry_set(ModifierData *md,
   return mesh_output;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Modifier Stack Cache
+ *
+ * The result of the modifier stack up to a modifier with #eModifierFlag_CacheResult is kept in
+ * the runtime data of the evaluated object, so that changing a following modifier doesn't
+ * evaluate all the modifiers before it again.
+ *
+ * There is no way to tell which modifier or input changed since the previous evaluation, so the
+ * cache is keyed on a hash of the input mesh, of the settings of the modifiers up to the cached
+ * one and of the evaluation parameters. This is only done for modifiers depending on nothing
+ * else than the mesh and their settings, i.e. not on other data-blocks or time.
+ *
+ * The settings are hashed member by member using DNA, so that pointers are never hashed by
+ * address. Settings owned through a pointer are hashed by content for the known types
+ * (curve mappings and profiles), modifiers with other pointers that are set aren't cached.
+ * \{ */
+
+struct MeshModifierStackCache {
+  /** Modifier after which the result of the stack was cached. */
+  SessionUUID session_uuid;
+  uint64_t key;
+  Mesh *mesh;
+  /** Result of the leading deform modifiers, when requested. */
+  Mesh *mesh_deform;
+};
+
+void BKE_mesh_modifier_stack_cache_free(Object *ob)
+{
+  MeshModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == nullptr) {
+    return;
+  }
+  BKE_id_free(nullptr, cache->mesh);
+  if (cache->mesh_deform) {
+    BKE_id_free(nullptr, cache->mesh_deform);
+  }
+  MEM_freeN(cache);
+  ob->runtime.modifier_stack_cache = nullptr;
+}
+
+/**
+ * Combines two 32 bit hashes with different seeds into a 64 bit key, a collision would
+ * silently return the result of other input.
+ */
+struct ModifierStackCacheHash {
+  BLI_HashMurmur2A mm2[2];
+
+  ModifierStackCacheHash()
+  {
+    BLI_hash_mm2a_init(&mm2[0], 0);
+    BLI_hash_mm2a_init(&mm2[1], 0x9e3779b9);
+  }
+
+  void add(const void *data, const size_t len)
+  {
+    BLI_hash_mm2a_add(&mm2[0], (const unsigned char *)data, len);
+    BLI_hash_mm2a_add(&mm2[1], (const unsigned char *)data, len);
+  }
+
+  void add_int(const int value)
+  {
+    BLI_hash_mm2a_add_int(&mm2[0], value);
+    BLI_hash_mm2a_add_int(&mm2[1], value);
+  }
+
+  uint64_t end()
+  {
+    return (uint64_t(BLI_hash_mm2a_end(&mm2[0])) << 32) | uint64_t(BLI_hash_mm2a_end(&mm2[1]));
+  }
+};
+
+static void modifier_stack_cache_hash_curve_mapping(ModifierStackCacheHash &hash,
+                                                    const CurveMapping &cumap)
+{
+  hash.add_int(cumap.flag);
+  hash.add(&cumap.clipr, sizeof(cumap.clipr));
+  hash.add(cumap.black, sizeof(cumap.black));
+  hash.add(cumap.white, sizeof(cumap.white));
+  hash.add_int(cumap.tone);
+  for (const CurveMap &cuma : cumap.cm) {
+    hash.add_int(cuma.totpoint);
+    hash.add(cuma.ext_in, sizeof(cuma.ext_in));
+    hash.add(cuma.ext_out, sizeof(cuma.ext_out));
+    if (cuma.curve) {
+      hash.add(cuma.curve, sizeof(*cuma.curve) * size_t(cuma.totpoint));
+    }
+  }
+}
+
+static void modifier_stack_cache_hash_curve_profile(ModifierStackCacheHash &hash,
+                                                    const CurveProfile &profile)
+{
+  hash.add_int(profile.path_len);
+  hash.add_int(profile.segments_len);
+  hash.add_int(profile.preset);
+  hash.add_int(profile.flag);
+  for (int i = 0; i < profile.path_len; i++) {
+    /* Skip the runtime pointer back to the profile. */
+    const CurveProfilePoint &point = profile.path[i];
+    hash.add(&point, offsetof(CurveProfilePoint, profile));
+  }
+}
+
+/**
+ * Hash the members of a DNA struct. Pointers are never hashed by address, the data they point to
+ * is hashed for the known types that modifiers own. When \a hash is null, only check whether the
+ * struct can be hashed.
+ *
+ * \return false when the struct contains a pointer to unknown data, which may be owned settings or
+ * runtime data that can't be compared.
+ */
+static bool modifier_stack_cache_hash_dna_struct(ModifierStackCacheHash *hash,
+                                                 const SDNA *sdna,
+                                                 const int struct_nr,
+                                                 const char *data,
+                                                 const int first_member)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+  int offset = 0;
+  for (int i = 0; i < struct_info->members_len; i++) {
+    const SDNA_StructMember *member = &struct_info->members[i];
+    const char *name = sdna->names[member->name];
+    const char *type_name = sdna->types[member->type];
+    const int size = DNA_elem_size_nr(sdna, member->type, member->name);
+    const char *member_data = data + offset;
+    offset += size;
+    if (i < first_member) {
+      continue;
+    }
+
+    if (name[0] == '*' || name[0] == '(') {
+      const void *const *pointers = (const void *const *)member_data;
+      for (int j = 0; j < sdna->names_array_len[member->name]; j++) {
+        if (pointers[j] == nullptr) {
+          if (hash) {
+            hash->add_int(0);
+          }
+          continue;
+        }
+        /* Only plain pointers to a single struct, not pointers to pointers. */
+        if (name[1] == '*' || name[0] == '(') {
+          return false;
+        }
+        if (STREQ(type_name, "CurveMapping")) {
+          if (hash) {
+            modifier_stack_cache_hash_curve_mapping(*hash, *(const CurveMapping *)pointers[j]);
+          }
+        }
+        else if (STREQ(type_name, "CurveProfile")) {
+          if (hash) {
+            modifier_stack_cache_hash_curve_profile(*hash, *(const CurveProfile *)pointers[j]);
+          }
+        }
+        else {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    const int member_struct_nr = DNA_struct_find_nr(sdna, type_name);
+    if (member_struct_nr != -1) {
+      const int struct_size = sdna->types_size[member->type];
+      for (int j = 0; j < sdna->names_array_len[member->name]; j++) {
+        if (!modifier_stack_cache_hash_dna_struct(
+                hash, sdna, member_struct_nr, member_data + j * struct_size, 0)) {
+          return false;
+        }
+      }
+      continue;
+    }
+
+    if (hash) {
+      hash->add(member_data, size_t(size));
+    }
+  }
+  return true;
+}
+
+/**
+ * Hash the settings of the modifier type, following the common #ModifierData.
+ * When \a hash is null, only check whether the settings can be hashed.
+ */
+static bool modifier_stack_cache_hash_settings(ModifierStackCacheHash *hash,
+                                               const ModifierData *md)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+  const SDNA *sdna = DNA_sdna_current_get();
+  const int struct_nr = DNA_struct_find_nr(sdna, mti->structName);
+  if (struct_nr == -1) {
+    return false;
+  }
+  /* The first member of every modifier struct is the #ModifierData. */
+  BLI_assert(STREQ(sdna->types[sdna->structs[struct_nr]->members[0].type], "ModifierData"));
+  return modifier_stack_cache_hash_dna_struct(hash, sdna, struct_nr, (const char *)md, 1);
+}
+
+static void modifier_stack_cache_id_walk(void *user_data,
+                                         Object *UNUSED(ob),
+                                         ID **idpoin,
+                                         int UNUSED(cb_flag))
+{
+  if (*idpoin != nullptr) {
+    *(bool *)user_data = true;
+  }
+}
+
+/**
+ * Find the last modifier of the stack whose result can be cached, or nullptr if the modifiers
+ * with #eModifierFlag_CacheResult depend on something else than the mesh and their settings.
+ */
+static ModifierData *modifier_stack_cache_modifier_find(Scene *scene,
+                                                        Object *ob,
+                                                        ModifierData *firstmd,
+                                                        const CDMaskLink *datamasks,
+                                                        const CustomData_MeshMasks *final_datamask,
+                                                        const int required_mode)
+{
+  /* Virtual modifiers depend on the shape keys or the parent. */
+  if (firstmd != ob->modifiers.first) {
+    return nullptr;
+  }
+  /* Orco meshes are built next to the final mesh, which the cache doesn't restore. */
+  if (final_datamask->vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO)) {
+    return nullptr;
+  }
+  for (const CDMaskLink *md_datamask = datamasks; md_datamask; md_datamask = md_datamask->next) {
+    if (md_datamask->mask.vmask & (CD_MASK_ORCO | CD_MASK_CLOTH_ORCO)) {
+      return nullptr;
+    }
+  }
+
+  ModifierData *cache_md = nullptr;
+  for (ModifierData *md = firstmd; md; md = md->next) {
+    if (!BKE_modifier_is_enabled(scene, md, required_mode)) {
+      continue;
+    }
+    const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
+    if (BKE_modifier_depends_ontime(scene, md, DAG_EVAL_VIEWPORT)) {
+      break;
+    }
+    if (mti->foreachIDLink) {
+      bool uses_id = false;
+      mti->foreachIDLink(md, ob, modifier_stack_cache_id_walk, &uses_id);
+      if (uses_id) {
+        break;
+      }
+    }
+    if (!modifier_stack_cache_hash_settings(nullptr, md)) {
+      break;
+    }
+    /* Only constructive modifiers, the result of deform modifiers may not be applied yet. */
+    if ((md->flag & eModifierFlag_CacheResult) && mti->type != eModifierTypeType_OnlyDeform) {
+      cache_md = md;
+    }
+  }
+  return cache_md;
+}
+
+static void modifier_stack_cache_hash_customdata(ModifierStackCacheHash &hash,
+                                                 const CustomData *data,
+                                                 const int totelem,
+                                                 bool *r_is_valid)
+{
+  hash.add_int(totelem);
+  for (int i = 0; i < data->totlayer; i++) {
+    const CustomDataLayer *layer = &data->layers[i];
+    hash.add_int(layer->type);
+    hash.add_int(layer->flag);
+    hash.add(layer->name, strlen(layer->name));
+    if (layer->data == nullptr) {
+      continue;
+    }
+    if (ELEM(layer->type, CD_MDISPS, CD_GRID_PAINT_MASK)) {
+      /* Pointers to data which isn't worth hashing, multi-resolution meshes aren't cached. */
+      *r_is_valid = false;
+      return;
+    }
+    if (layer->type == CD_MDEFORMVERT) {
+      const MDeformVert *dvert = (const MDeformVert *)layer->data;
+      for (int j = 0; j < totelem; j++) {
+        hash.add(dvert[j].dw, sizeof(*dvert[j].dw) * dvert[j].totweight);
+        hash.add_int(dvert[j].totweight);
+      }
+      continue;
+    }
+    hash.add(layer->data, (size_t)CustomData_sizeof(layer->type) * (size_t)totelem);
+  }
+}
+
+/**
+ * Hash everything the result of the stack up to \a cache_md depends on. Returns false when the
+ * input can't be cached.
+ */
+static bool modifier_stack_cache_key_calc(Object *ob,
+                                          const Mesh *mesh_input,
+                                          ModifierData *cache_md,
+                                          const CustomData_MeshMasks *dataMask,
+                                          const bool need_mapping,
+                                          uint64_t *r_key)
+{
+  ModifierStackCacheHash hash;
+
+  bool is_valid = true;
+  modifier_stack_cache_hash_customdata(hash, &mesh_input->vdata, mesh_input->totvert, &is_valid);
+  modifier_stack_cache_hash_customdata(hash, &mesh_input->edata, mesh_input->totedge, &is_valid);
+  modifier_stack_cache_hash_customdata(hash, &mesh_input->ldata, mesh_input->totloop, &is_valid);
+  modifier_stack_cache_hash_customdata(hash, &mesh_input->pdata, mesh_input->totpoly, &is_valid);
+  if (!is_valid) {
+    return false;
+  }
+  LISTBASE_FOREACH (const bDeformGroup *, dg, &mesh_input->vertex_group_names) {
+    hash.add(dg->name, strlen(dg->name));
+  }
+  hash.add_int(mesh_input->flag);
+  hash.add_int(mesh_input->cd_flag);
+  hash.add_int(mesh_input->totcol);
+  hash.add(&mesh_input->smoothresh, sizeof(float));
+
+  hash.add_int(ob->totcol);
+  hash.add(ob->obmat, sizeof(ob->obmat));
+
+  hash.add(dataMask, sizeof(*dataMask));
+  hash.add_int(need_mapping);
+
+  for (ModifierData *md = (ModifierData *)ob->modifiers.first; md; md = md->next) {
+    hash.add_int(md->type);
+    hash.add_int(md->mode & ~eModifierMode_DisableTemporary);
+    hash.add_int(md->flag & ~eModifierFlag_Active);
+    if (!modifier_stack_cache_hash_settings(&hash, md)) {
+      return false;
+    }
+    if (md == cache_md) {
+      break;
+    }
+  }
+
+  *r_key = hash.end();
+  return true;
+}
+
+static void modifier_stack_cache_store(Object *ob,
+                                       ModifierData *cache_md,
+                                       const uint64_t key,
+                                       const Mesh *mesh,
+                                       const Mesh *mesh_deform)
+{
+  BKE_mesh_modifier_stack_cache_free(ob);
+
+  MeshModifierStackCache *cache = (MeshModifierStackCache *)MEM_callocN(sizeof(*cache),
+                                                                        __func__);
+  cache->session_uuid = cache_md->session_uuid;
+  cache->key = key;
+  cache->mesh = BKE_mesh_copy_for_eval(mesh, false);
+  if (mesh_deform) {
+    cache->mesh_deform = BKE_mesh_copy_for_eval(mesh_deform, false);
+  }
+  ob->runtime.modifier_stack_cache = cache;
+}
+
+static const MeshModifierStackCache *modifier_stack_cache_lookup(const Object *ob,
+                                                                 const ModifierData *cache_md,
+                                                                 const uint64_t key,
+                                                                 const bool need_deform)
+{
+  const MeshModifierStackCache *cache = ob->runtime.modifier_stack_cache;
+  if (cache == nullptr || cache->key != key ||
+      !BLI_session_uuid_is_equal(&cache->session_uuid, &cache_md->session_uuid)) {
+    return nullptr;
+  }
+  if (need_deform && cache->mesh_deform == nullptr) {
+    return nullptr;
+  }
+  return cache;
+}
+
+/** \} */
+
 static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
                                 Scene *scene,
                                 Object *ob,
@@ -1059,8 +1443,42 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   /* Clear errors before evaluation. */
   BKE_modifiers_clear_errors(ob);
 
+  /* Continue from the cached result of the stack up to a modifier, when its inputs didn't
+   * change since it was stored. */
+  ModifierData *cache_md = nullptr;
+  uint64_t cache_key = 0;
+  if (use_cache && (index == -1) && !use_render && !sculpt_mode && DEG_is_active(depsgraph)) {
+    cache_md = modifier_stack_cache_modifier_find(
+        scene, ob, firstmd, datamasks, &final_datamask, required_mode);
+    if (cache_md && !modifier_stack_cache_key_calc(
+                        ob, mesh_input, cache_md, dataMask, need_mapping, &cache_key)) {
+      cache_md = nullptr;
+    }
+    if (cache_md == nullptr) {
+      BKE_mesh_modifier_stack_cache_free(ob);
+    }
+  }
+  const MeshModifierStackCache *cache = nullptr;
+  if (cache_md) {
+    cache = modifier_stack_cache_lookup(ob, cache_md, cache_key, r_deform != nullptr);
+  }
+  if (cache) {
+    mesh_final = BKE_mesh_copy_for_eval(cache->mesh, false);
+    mesh_final->runtime.deformed_only = false;
+    if (r_deform) {
+      mesh_deform = BKE_mesh_copy_for_eval(cache->mesh_deform, false);
+    }
+
+    /* Skip the cached modifiers. */
+    for (; md != cache_md; md = md->next, md_datamask = md_datamask->next) {
+      /* Pass. */
+    }
+    md = md->next;
+    md_datamask = md_datamask->next;
+  }
+
   /* Apply all leading deform modifiers. */
-  if (use_deform) {
+  if (use_deform && (cache == nullptr)) {
     for (; md; md = md->next, md_datamask = md_datamask->next) {
       const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1108,7 +1526,7 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
   }
 
   /* Apply all remaining constructive and deforming modifiers. */
-  bool have_non_onlydeform_modifiers_appled = false;
+  bool have_non_onlydeform_modifiers_appled = (cache != nullptr);
   for (; md; md = md->next, md_datamask = md_datamask->next) {
     const ModifierTypeInfo *mti = BKE_modifier_get_info((ModifierType)md->type);
 
@@ -1372,6 +1790,11 @@ static void mesh_calc_modifiers(struct Depsgraph *depsgraph,
       }
 
       mesh_final->runtime.deformed_only = false;
+
+      if (md == cache_md && deformed_verts == nullptr && mesh_orco == nullptr &&
+          mesh_orco_cloth == nullptr && geometry_set_final.is_empty()) {
+        modifier_stack_cache_store(ob, cache_md, cache_key, mesh_final, mesh_deform);
+      }
     }
 
     isPrevDeform = (mti->type == eModifierTypeType_OnlyDeform);
@@ -35,6 +35,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_memarena.h"
 #include "BLI_string_utils.h"
 #include "BLI_utildefines.h"
 
@@ -596,6 +597,48 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
   }
 }
 
+/**
+ * The last resolved RNA path, F-Curves animating the elements of an array property are usually
+ * stored next to each other and don't need to parse the same path again.
+ */
+typedef struct AnimsysPathResolveCache {
+  const char *rna_path;
+  bool is_valid;
+  PathResolvedRNA result;
+  int array_len;
+} AnimsysPathResolveCache;
+
+static bool animsys_rna_path_resolve_cached(PointerRNA *ptr,
+                                            const char *rna_path,
+                                            const int array_index,
+                                            AnimsysPathResolveCache *cache,
+                                            PathResolvedRNA *r_result)
+{
+  if (rna_path == NULL) {
+    return false;
+  }
+
+  if (cache->rna_path == NULL || !STREQ(cache->rna_path, rna_path)) {
+    cache->rna_path = rna_path;
+    cache->is_valid = BKE_animsys_rna_path_resolve(ptr, rna_path, 0, &cache->result);
+    if (cache->is_valid) {
+      cache->array_len = RNA_property_array_length(&cache->result.ptr, cache->result.prop);
+    }
+  }
+
+  if (!cache->is_valid) {
+    return false;
+  }
+  if (cache->array_len && array_index >= cache->array_len) {
+    /* Let the regular resolve report the invalid index. */
+    return BKE_animsys_rna_path_resolve(ptr, rna_path, array_index, r_result);
+  }
+
+  *r_result = cache->result;
+  r_result->prop_index = cache->array_len ? array_index : -1;
+  return true;
+}
+
 /**
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
@@ -606,6 +649,13 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      const AnimationEvalContext *anim_eval_context,
                                      bool flush_to_original)
 {
+  AnimsysPathResolveCache path_cache = {NULL};
+  AnimsysPathResolveCache orig_path_cache = {NULL};
+  PointerRNA ptr_orig;
+  if (flush_to_original && !animsys_construct_orig_pointer_rna(ptr, &ptr_orig)) {
+    flush_to_original = false;
+  }
+
   /* Calculate then execute each curve. */
   LISTBASE_FOREACH (FCurve *, fcu, list) {
 
@@ -614,11 +664,16 @@ static void animsys_evaluate_fcurves(PointerRNA *ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+    if (animsys_rna_path_resolve_cached(
+            ptr, fcu->rna_path, fcu->array_index, &path_cache, &anim_rna)) {
       const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
       BKE_animsys_write_to_rna_path(&anim_rna, curval);
       if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
+        PathResolvedRNA orig_anim_rna;
+        if (animsys_rna_path_resolve_cached(
+                &ptr_orig, fcu->rna_path, fcu->array_index, &orig_path_cache, &orig_anim_rna)) {
+          BKE_animsys_write_to_rna_path(&orig_anim_rna, curval);
+        }
       }
     }
   }
@@ -1157,7 +1212,7 @@ static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
   int length = nec->base_snapshot.length;
 
   size_t byte_size = sizeof(NlaEvalChannelSnapshot) + sizeof(float) * length;
-  NlaEvalChannelSnapshot *nec_snapshot = MEM_callocN(byte_size, "NlaEvalChannelSnapshot");
+  NlaEvalChannelSnapshot *nec_snapshot = BLI_memarena_calloc(nec->owner->arena, byte_size);
 
   nec_snapshot->channel = nec;
   nec_snapshot->length = length;
@@ -1167,14 +1222,13 @@ static NlaEvalChannelSnapshot *nlaevalchan_snapshot_new(NlaEvalChannel *nec)
   return nec_snapshot;
 }
 
-/* Free a channel's blending value snapshot. */
+/* Free a channel's blending value snapshot, its own memory is owned by the #NlaEvalData arena. */
 static void nlaevalchan_snapshot_free(NlaEvalChannelSnapshot *nec_snapshot)
 {
   BLI_assert(!nec_snapshot->is_base);
 
   nlavalidmask_free(&nec_snapshot->blend_domain);
   nlavalidmask_free(&nec_snapshot->remap_domain);
-  MEM_freeN(nec_snapshot);
 }
 
 /* Copy all data in the snapshot. */
@@ -1298,6 +1352,7 @@ static void nlaeval_init(NlaEvalData *nlaeval)
   nlaeval->path_hash = BLI_ghash_str_new("NlaEvalData::path_hash");
   nlaeval->key_hash = BLI_ghash_new(
       nlaevalchan_keyhash, nlaevalchan_keycmp, "NlaEvalData::key_hash");
+  nlaeval->arena = BLI_memarena_new(BLI_MEMARENA_STD_BUFSIZE, "NlaEvalData::arena");
 }
 
 static void nlaeval_free(NlaEvalData *nlaeval)
@@ -1313,9 +1368,10 @@ static void nlaeval_free(NlaEvalData *nlaeval)
     nlaevalchan_free_data(nec);
   }
 
-  BLI_freelistN(&nlaeval->channels);
+  BLI_listbase_clear(&nlaeval->channels);
   BLI_ghash_free(nlaeval->path_hash, NULL, NULL);
   BLI_ghash_free(nlaeval->key_hash, NULL, NULL);
+  BLI_memarena_free(nlaeval->arena);
 }
 
 /* ---------------------- */
@@ -1471,8 +1527,8 @@ static NlaEvalChannel *nlaevalchan_verify_key(NlaEvalData *nlaeval,
   bool is_array = RNA_property_array_check(key->prop);
   int length = is_array ? RNA_property_array_length(&key->ptr, key->prop) : 1;
 
-  NlaEvalChannel *nec = MEM_callocN(sizeof(NlaEvalChannel) + sizeof(float) * length,
-                                    "NlaEvalChannel");
+  NlaEvalChannel *nec = BLI_memarena_calloc(nlaeval->arena,
+                                             sizeof(NlaEvalChannel) + sizeof(float) * length);
 
   /* Initialize the channel. */
   nec->rna_path = path;
@@ -121,17 +121,22 @@ static void b_bone_deform(const bPoseChannel *pchan,
       &quats[index + 1], mats[index + 2].mat, co, weight * blend, vec, dq, defmat);
 }
 
-/* using vec with dist to bone b1 - b2 */
-float distfactor_to_bone(
-    const float vec[3], const float b1[3], const float b2[3], float rad1, float rad2, float rdist)
+/**
+ * Envelope factor of a bone from b1 to b2, with its normalized direction \a bdelta and its
+ * length \a l known already.
+ */
+static float distfactor_to_bone_ex(const float vec[3],
+                                   const float b1[3],
+                                   const float b2[3],
+                                   const float bdelta[3],
+                                   float l,
+                                   float rad1,
+                                   float rad2,
+                                   float rdist)
 {
   float dist_sq;
-  float bdelta[3];
   float pdelta[3];
-  float hsqr, a, l, rad;
-
-  sub_v3_v3v3(bdelta, b2, b1);
-  l = normalize_v3(bdelta);
+  float hsqr, a, rad;
 
   sub_v3_v3v3(pdelta, vec, b1);
 
@@ -175,24 +180,82 @@ float distfactor_to_bone(
   return 1.0f - (a * a) / (rdist * rdist);
 }
 
-static float dist_bone_deform(
-    bPoseChannel *pchan, float vec[3], DualQuat *dq, float mat[3][3], const float co[3])
+/* using vec with dist to bone b1 - b2 */
+float distfactor_to_bone(
+    const float vec[3], const float b1[3], const float b2[3], float rad1, float rad2, float rdist)
 {
-  Bone *bone = pchan->bone;
-  float fac, contrib = 0.0;
+  float bdelta[3];
+  sub_v3_v3v3(bdelta, b2, b1);
+  const float l = normalize_v3(bdelta);
+  return distfactor_to_bone_ex(vec, b1, b2, bdelta, l, rad1, rad2, rdist);
+}
 
-  if (bone == NULL) {
-    return 0.0f;
-  }
+/**
+ * Deforming bone with the data needed per vertex gathered in one place, so evaluating vertices
+ * don't have to follow the pose channel and bone pointers for every weight, and the envelope
+ * direction isn't normalized again for every vertex.
+ */
+typedef struct ArmatureDeformBone {
+  bPoseChannel *pchan;
+  /** Deform by the B-Bone segments. */
+  bool use_bbone;
+  /** Multiply vertex group weights by the envelope, #BONE_MULT_VG_ENV. */
+  bool use_envelope_multiply;
+  /* Envelope in armature space. */
+  float head[3], tail[3];
+  /** Normalized direction from head to tail. */
+  float dir[3];
+  float length;
+  float rad_head, rad_tail, dist;
+  float weight;
+} ArmatureDeformBone;
+
+static void armature_deform_bone_init(ArmatureDeformBone *deform_bone, bPoseChannel *pchan)
+{
+  const Bone *bone = pchan->bone;
+  deform_bone->pchan = pchan;
+  deform_bone->use_bbone = (bone->segments > 1 &&
+                            pchan->runtime.bbone_segments == bone->segments);
+  deform_bone->use_envelope_multiply = (bone->flag & BONE_MULT_VG_ENV) != 0;
+  copy_v3_v3(deform_bone->head, bone->arm_head);
+  copy_v3_v3(deform_bone->tail, bone->arm_tail);
+  sub_v3_v3v3(deform_bone->dir, bone->arm_tail, bone->arm_head);
+  deform_bone->length = normalize_v3(deform_bone->dir);
+  deform_bone->rad_head = bone->rad_head;
+  deform_bone->rad_tail = bone->rad_tail;
+  deform_bone->dist = bone->dist;
+  deform_bone->weight = bone->weight;
+}
 
-  fac = distfactor_to_bone(
-      co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+static float armature_deform_bone_envelope_factor(const ArmatureDeformBone *deform_bone,
+                                                  const float co[3])
+{
+  return distfactor_to_bone_ex(co,
+                               deform_bone->head,
+                               deform_bone->tail,
+                               deform_bone->dir,
+                               deform_bone->length,
+                               deform_bone->rad_head,
+                               deform_bone->rad_tail,
+                               deform_bone->dist);
+}
+
+static float dist_bone_deform(const ArmatureDeformBone *deform_bone,
+                              float vec[3],
+                              DualQuat *dq,
+                              float mat[3][3],
+                              const float co[3])
+{
+  const bPoseChannel *pchan = deform_bone->pchan;
+  float fac, contrib = 0.0;
+
+  fac = armature_deform_bone_envelope_factor(deform_bone, co);
 
   if (fac > 0.0f) {
-    fac *= bone->weight;
+    fac *= deform_bone->weight;
     contrib = fac;
     if (contrib > 0.0f) {
-      if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+      if (deform_bone->use_bbone) {
         b_bone_deform(pchan, co, fac, vec, dq, mat);
       }
       else {
@@ -205,7 +268,7 @@ static float dist_bone_deform(
   return contrib;
 }
 
-static void pchan_bone_deform(bPoseChannel *pchan,
+static void pchan_bone_deform(const ArmatureDeformBone *deform_bone,
                               float weight,
                               float vec[3],
                               DualQuat *dq,
@@ -213,13 +276,13 @@ static void pchan_bone_deform(bPoseChannel *pchan,
                               const float co[3],
                               float *contrib)
 {
-  Bone *bone = pchan->bone;
+  const bPoseChannel *pchan = deform_bone->pchan;
 
   if (!weight) {
     return;
   }
 
-  if (bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) {
+  if (deform_bone->use_bbone) {
     b_bone_deform(pchan, co, weight, vec, dq, mat);
   }
   else {
@@ -256,9 +319,14 @@ typedef struct ArmatureUserdata {
   const MDeformVert *dverts;
   int dverts_len;
 
-  bPoseChannel **pchan_from_defbase;
+  /** Deforming bones by vertex group index, with a NULL pose channel for other groups. */
+  ArmatureDeformBone *deform_bones_from_defbase;
   int defbase_len;
 
+  /** All deforming bones, for envelope deformation. */
+  ArmatureDeformBone *envelope_bones;
+  int envelope_bones_len;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -281,7 +349,6 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   const int armature_def_nr = data->armature_def_nr;
 
   DualQuat sumdq, *dq = NULL;
-  bPoseChannel *pchan;
   float *co, dco[3];
   float sumvec[3], summat[3][3];
   float *vec = NULL, (*smat)[3] = NULL;
@@ -334,34 +401,32 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     unsigned int j;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
-      if (index < data->defbase_len && (pchan = data->pchan_from_defbase[index])) {
+      if (index >= data->defbase_len) {
+        continue;
+      }
+      const ArmatureDeformBone *deform_bone = &data->deform_bones_from_defbase[index];
+      if (deform_bone->pchan) {
         float weight = dw->weight;
-        Bone *bone = pchan->bone;
 
         deformed = 1;
 
-        if (bone && bone->flag & BONE_MULT_VG_ENV) {
-          weight *= distfactor_to_bone(
-              co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+        if (deform_bone->use_envelope_multiply) {
+          weight *= armature_deform_bone_envelope_factor(deform_bone, co);
         }
 
-        pchan_bone_deform(pchan, weight, vec, dq, smat, co, &contrib);
+        pchan_bone_deform(deform_bone, weight, vec, dq, smat, co, &contrib);
       }
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
-      for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
-        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-        }
+      for (int k = 0; k < data->envelope_bones_len; k++) {
+        contrib += dist_bone_deform(&data->envelope_bones[k], vec, dq, smat, co);
       }
     }
   }
   else if (use_envelope) {
-    for (pchan = data->ob_arm->pose->chanbase.first; pchan; pchan = pchan->next) {
-      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co);
-      }
+    for (int j = 0; j < data->envelope_bones_len; j++) {
+      contrib += dist_bone_deform(&data->envelope_bones[j], vec, dq, smat, co);
     }
   }
 
@@ -477,7 +542,9 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         bGPDstroke *gps_target)
 {
   bArmature *arm = ob_arm->data;
-  bPoseChannel **pchan_from_defbase = NULL;
+  ArmatureDeformBone *deform_bones_from_defbase = NULL;
+  ArmatureDeformBone *envelope_bones = NULL;
+  int envelope_bones_len = 0;
   const MDeformVert *dverts = NULL;
   bDeformGroup *dg;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
@@ -545,25 +612,35 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       }
 
       if (use_dverts) {
-        pchan_from_defbase = MEM_callocN(sizeof(*pchan_from_defbase) * defbase_len, "defnrToBone");
+        deform_bones_from_defbase = MEM_callocN(sizeof(*deform_bones_from_defbase) * defbase_len,
+                                                "defnrToBone");
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
          */
         const ListBase *defbase = BKE_object_defgroup_list(ob_target);
         for (i = 0, dg = defbase->first; dg; i++, dg = dg->next) {
-          pchan_from_defbase[i] = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
+          bPoseChannel *pchan = BKE_pose_channel_find_name(ob_arm->pose, dg->name);
           /* exclude non-deforming bones */
-          if (pchan_from_defbase[i]) {
-            if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
-              pchan_from_defbase[i] = NULL;
-            }
+          if (pchan && !(pchan->bone->flag & BONE_NO_DEFORM)) {
+            armature_deform_bone_init(&deform_bones_from_defbase[i], pchan);
           }
         }
       }
     }
   }
 
+  if (use_envelope) {
+    envelope_bones = MEM_malloc_arrayN(BLI_listbase_count(&ob_arm->pose->chanbase),
+                                       sizeof(*envelope_bones),
+                                       "envelope bones");
+    LISTBASE_FOREACH (bPoseChannel *, pchan, &ob_arm->pose->chanbase) {
+      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+        armature_deform_bone_init(&envelope_bones[envelope_bones_len++], pchan);
+      }
+    }
+  }
+
   ArmatureUserdata data = {
       .ob_arm = ob_arm,
       .ob_target = ob_target,
@@ -578,8 +655,10 @@ static void armature_deform_coords_impl(const Object *ob_arm,
       .armature_def_nr = armature_def_nr,
       .dverts = dverts,
       .dverts_len = dverts_len,
-      .pchan_from_defbase = pchan_from_defbase,
+      .deform_bones_from_defbase = deform_bones_from_defbase,
       .defbase_len = defbase_len,
+      .envelope_bones = envelope_bones,
+      .envelope_bones_len = envelope_bones_len,
       .bmesh =
           {
               .cd_dvert_offset = cd_dvert_offset,
@@ -616,9 +695,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     BLI_task_parallel_range(0, vert_coords_len, &data, armature_vert_task, &settings);
   }
 
-  if (pchan_from_defbase) {
-    MEM_freeN(pchan_from_defbase);
-  }
+  MEM_SAFE_FREE(deform_bones_from_defbase);
+  MEM_SAFE_FREE(envelope_bones);
 }
 
 void BKE_armature_deform_coords_with_gpencil_stroke(const Object *ob_arm,
@@ -2473,6 +2473,77 @@ float BKE_brush_curve_strength(const Brush *br, float p, const float len)
   return strength;
 }
 
+/**
+ * Same as #BKE_brush_curve_strength for \a tot distances. The curve preset is only checked
+ * once, so the loops over the distances can be vectorized.
+ * \a r_strength may be the same array as \a dist.
+ */
+void BKE_brush_curve_strength_array(
+    const Brush *br, const float *dist, const float len, const int tot, float *r_strength)
+{
+  /* Distance from the edge of the brush, zero outside of it. */
+  float *p = r_strength;
+  for (int i = 0; i < tot; i++) {
+    p[i] = max_ff(1.0f - dist[i] / len, 0.0f);
+  }
+
+  switch (br->curve_preset) {
+    case BRUSH_CURVE_CUSTOM:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = (p[i] > 0.0f) ? BKE_curvemapping_evaluateF(br->curve, 0, 1.0f - p[i]) :
+                                        0.0f;
+      }
+      break;
+    case BRUSH_CURVE_SHARP:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = p[i] * p[i];
+      }
+      break;
+    case BRUSH_CURVE_SMOOTH:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = 3.0f * p[i] * p[i] - 2.0f * p[i] * p[i] * p[i];
+      }
+      break;
+    case BRUSH_CURVE_SMOOTHER:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = pow3f(p[i]) * (p[i] * (p[i] * 6.0f - 15.0f) + 10.0f);
+      }
+      break;
+    case BRUSH_CURVE_ROOT:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = sqrtf(p[i]);
+      }
+      break;
+    case BRUSH_CURVE_LIN:
+      break;
+    case BRUSH_CURVE_CONSTANT:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = (p[i] > 0.0f) ? 1.0f : 0.0f;
+      }
+      break;
+    case BRUSH_CURVE_SPHERE:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = sqrtf(2 * p[i] - p[i] * p[i]);
+      }
+      break;
+    case BRUSH_CURVE_POW4:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = p[i] * p[i] * p[i] * p[i];
+      }
+      break;
+    case BRUSH_CURVE_INVSQUARE:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = p[i] * (2.0f - p[i]);
+      }
+      break;
+    default:
+      for (int i = 0; i < tot; i++) {
+        r_strength[i] = (p[i] > 0.0f) ? 1.0f : 0.0f;
+      }
+      break;
+  }
+}
+
 /* Uses the brush curve control to find a strength value between 0 and 1 */
 float BKE_brush_curve_strength_clamped(Brush *br, float p, const float len)
 {
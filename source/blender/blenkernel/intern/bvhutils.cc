@@ -24,16 +24,23 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <mutex>
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_hash_mm2a.h"
+#include "BLI_hash_mm3.h"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_math.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_bvhutils.h"
 #include "BKE_editmesh.h"
@@ -48,9 +55,13 @@
 
 struct BVHCacheItem {
   bool is_filled;
+  /* The tree is owned by the shared cache, see #bvhtree_shared_acquire. */
+  bool is_shared;
   BVHTree *tree;
 };
 
+static void bvhtree_shared_release(BVHTree *tree);
+
 struct BVHCache {
   BVHCacheItem items[BVHTREE_MAX_ITEM];
   ThreadMutex mutex;
@@ -139,12 +150,16 @@ BVHCache *bvhcache_init(void)
  * A call to this assumes that there was no previous cached tree of the given type
  * \warning The #BVHTree can be nullptr.
  */
-static void bvhcache_insert(BVHCache *bvh_cache, BVHTree *tree, BVHCacheType type)
+static void bvhcache_insert(BVHCache *bvh_cache,
+                            BVHTree *tree,
+                            BVHCacheType type,
+                            const bool is_shared = false)
 {
   BVHCacheItem *item = &bvh_cache->items[type];
   BLI_assert(!item->is_filled);
   item->tree = tree;
   item->is_filled = true;
+  item->is_shared = is_shared && tree != nullptr;
 }
 
 /**
@@ -154,7 +169,12 @@ void bvhcache_free(BVHCache *bvh_cache)
 {
   for (int index = 0; index < BVHTREE_MAX_ITEM; index++) {
     BVHCacheItem *item = &bvh_cache->items[index];
-    BLI_bvhtree_free(item->tree);
+    if (item->is_shared) {
+      bvhtree_shared_release(item->tree);
+    }
+    else {
+      BLI_bvhtree_free(item->tree);
+    }
     item->tree = nullptr;
   }
   BLI_mutex_end(&bvh_cache->mutex);
@@ -183,6 +203,262 @@ static void bvhtree_balance(BVHTree *tree, const bool isolate)
   }
 }
 
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Shared BVH Trees
+ *
+ * Meshes created during evaluation (e.g. by geometry nodes) don't keep their #BVHCache between
+ * evaluations, so the same tree would be built over and over again. Trees built for a
+ * #BVHCache are therefore also stored in a global cache, keyed on a hash of the arrays they are
+ * built from. A copy of the arrays is kept with every tree and compared in full before the tree is
+ * reused, so a hash collision never gives the tree of different data. A tree stays alive while a
+ * #BVHCache uses it. A few unused trees are kept around, so they can be reused by the next
+ * evaluation.
+ * \{ */
+
+/* Leaves are filled in parallel when there are more than this. */
+#define BVHTREE_INSERT_GRAIN_SIZE 4096
+/* Number of trees kept by the shared cache without being used by any mesh. */
+#define BVHTREE_SHARED_UNUSED_MAX 8
+
+struct SharedBVHKey {
+  BVHCacheType type;
+  int tree_type;
+  int axis;
+  float epsilon;
+  int elems_num;
+  /* Total size in bytes of the arrays the tree is built from. */
+  int64_t data_size;
+  uint64_t data_hash;
+
+  uint64_t hash() const
+  {
+    return blender::get_default_hash_3(type, elems_num, data_hash);
+  }
+
+  friend bool operator==(const SharedBVHKey &a, const SharedBVHKey &b)
+  {
+    return a.type == b.type && a.tree_type == b.tree_type && a.axis == b.axis &&
+           a.epsilon == b.epsilon && a.elems_num == b.elems_num && a.data_size == b.data_size &&
+           a.data_hash == b.data_hash;
+  }
+};
+
+/* The arrays a tree is built from, in the order they are hashed. */
+using SharedBVHData = blender::Vector<blender::Span<uint8_t>, 3>;
+
+struct SharedBVHEntry {
+  BVHTree *tree;
+  int users;
+  /* Used to find the least recently used tree when there are too many unused trees. */
+  uint64_t last_used;
+  /* Copy of the arrays the tree is built from, concatenated. Never stored inline, so it isn't
+   * moved when the map grows while it is compared outside of the lock. */
+  blender::Array<uint8_t, 0> data;
+};
+
+struct SharedBVHCache {
+  std::mutex mutex;
+  blender::Map<SharedBVHKey, SharedBVHEntry> entries;
+  blender::Map<const BVHTree *, SharedBVHKey> keys_by_tree;
+  uint64_t clock = 0;
+  int unused_num = 0;
+};
+
+static SharedBVHCache *shared_bvh_cache = nullptr;
+static std::mutex shared_bvh_cache_init_mutex;
+
+static SharedBVHCache &bvhtree_shared_cache_get()
+{
+  std::lock_guard lock{shared_bvh_cache_init_mutex};
+  if (shared_bvh_cache == nullptr) {
+    shared_bvh_cache = new SharedBVHCache();
+  }
+  return *shared_bvh_cache;
+}
+
+/**
+ * Hash an array in independent chunks in parallel. The chunk hashes use two different hash
+ * functions, so that the combined hash has 64 bits.
+ */
+static uint64_t bvhtree_hash_array(const void *data, const size_t size, const uint64_t hash)
+{
+  const size_t chunk_size = 1 << 16;
+  const int64_t chunks_num = (int64_t)((size + chunk_size - 1) / chunk_size);
+  blender::Array<uint64_t> chunk_hashes(chunks_num);
+  blender::threading::parallel_for(
+      blender::IndexRange(chunks_num), 16, [&](blender::IndexRange range) {
+        for (const int64_t i : range) {
+          const unsigned char *chunk = (const unsigned char *)data + i * chunk_size;
+          const size_t len = std::min(chunk_size, size - i * chunk_size);
+          chunk_hashes[i] = ((uint64_t)BLI_hash_mm3(chunk, len, 0) << 32) |
+                            BLI_hash_mm2(chunk, len, (uint32_t)i);
+        }
+      });
+  const unsigned char *hashes = (const unsigned char *)chunk_hashes.data();
+  const size_t hashes_size = sizeof(uint64_t) * (size_t)chunks_num;
+  const uint64_t array_hash = ((uint64_t)BLI_hash_mm3(hashes, hashes_size, (uint32_t)size) << 32) |
+                              BLI_hash_mm2(hashes, hashes_size, (uint32_t)size);
+  return blender::get_default_hash_2(hash, array_hash);
+}
+
+static bool bvhtree_shared_data_equals(const blender::Span<uint8_t> stored_data,
+                                       const SharedBVHData &data)
+{
+  int64_t offset = 0;
+  for (const blender::Span<uint8_t> array : data) {
+    if (offset + array.size() > stored_data.size() ||
+        memcmp(stored_data.data() + offset, array.data(), (size_t)array.size()) != 0) {
+      return false;
+    }
+    offset += array.size();
+  }
+  return offset == stored_data.size();
+}
+
+/**
+ * Find a shared tree for the key which is built from the same data, adding a user to it.
+ * Returns null when there is none.
+ */
+static BVHTree *bvhtree_shared_acquire(const SharedBVHKey &key, const SharedBVHData &data)
+{
+  SharedBVHCache &cache = bvhtree_shared_cache_get();
+  BVHTree *tree;
+  blender::Span<uint8_t> stored_data;
+  {
+    std::lock_guard lock{cache.mutex};
+    SharedBVHEntry *entry = cache.entries.lookup_ptr(key);
+    if (entry == nullptr) {
+      return nullptr;
+    }
+    if (entry->users == 0) {
+      cache.unused_num--;
+    }
+    entry->users++;
+    entry->last_used = cache.clock++;
+    tree = entry->tree;
+    stored_data = entry->data;
+  }
+
+  /* Compare outside of the lock, the entry isn't freed while it has a user. */
+  if (!bvhtree_shared_data_equals(stored_data, data)) {
+    bvhtree_shared_release(tree);
+    return nullptr;
+  }
+  return tree;
+}
+
+/**
+ * Add a newly built tree with a single user to the shared cache.
+ *
+ * \return false when the cache has a tree for the same key already (added by another thread in
+ * the meantime or built from different data with the same hash), the tree is not shared then.
+ */
+static bool bvhtree_shared_add(const SharedBVHKey &key, const SharedBVHData &data, BVHTree *tree)
+{
+  SharedBVHCache &cache = bvhtree_shared_cache_get();
+  {
+    std::lock_guard lock{cache.mutex};
+    if (cache.entries.contains(key)) {
+      return false;
+    }
+  }
+
+  /* Copy the data outside of the lock. */
+  blender::Array<uint8_t, 0> data_copy(key.data_size, blender::NoInitialization());
+  int64_t offset = 0;
+  for (const blender::Span<uint8_t> array : data) {
+    memcpy(data_copy.data() + offset, array.data(), (size_t)array.size());
+    offset += array.size();
+  }
+  BLI_assert(offset == key.data_size);
+
+  std::lock_guard lock{cache.mutex};
+  if (!cache.entries.add(key, {tree, 1, cache.clock++, std::move(data_copy)})) {
+    return false;
+  }
+  cache.keys_by_tree.add_new(tree, key);
+  return true;
+}
+
+static void bvhtree_shared_remove_least_recently_used(SharedBVHCache &cache)
+{
+  const SharedBVHKey *lru_key = nullptr;
+  uint64_t lru_time = UINT64_MAX;
+  for (blender::Map<SharedBVHKey, SharedBVHEntry>::Item item : cache.entries.items()) {
+    if (item.value.users == 0 && item.value.last_used < lru_time) {
+      lru_key = &item.key;
+      lru_time = item.value.last_used;
+    }
+  }
+  if (lru_key == nullptr) {
+    return;
+  }
+  /* Copy the key, because it is freed when the entry is removed. */
+  const SharedBVHKey key = *lru_key;
+  BVHTree *tree = cache.entries.pop(key).tree;
+  cache.keys_by_tree.remove(tree);
+  BLI_bvhtree_free(tree);
+  cache.unused_num--;
+}
+
+static void bvhtree_shared_release(BVHTree *tree)
+{
+  SharedBVHCache &cache = bvhtree_shared_cache_get();
+  std::lock_guard lock{cache.mutex};
+  const SharedBVHKey &key = cache.keys_by_tree.lookup(tree);
+  SharedBVHEntry &entry = cache.entries.lookup(key);
+  BLI_assert(entry.users > 0);
+  entry.users--;
+  if (entry.users == 0) {
+    cache.unused_num++;
+    if (cache.unused_num > BVHTREE_SHARED_UNUSED_MAX) {
+      bvhtree_shared_remove_least_recently_used(cache);
+    }
+  }
+}
+
+/**
+ * Free all trees of the shared cache, once no mesh uses them anymore (e.g. on exit).
+ */
+void BKE_bvhtree_shared_cache_free(void)
+{
+  if (shared_bvh_cache == nullptr) {
+    return;
+  }
+  for (SharedBVHEntry &entry : shared_bvh_cache->entries.values()) {
+    BLI_assert(entry.users == 0);
+    BLI_bvhtree_free(entry.tree);
+  }
+  delete shared_bvh_cache;
+  shared_bvh_cache = nullptr;
+}
+
+/**
+ * Build a tree with \a build_fn, reusing a tree built from the same data from the shared cache
+ * when possible. The returned tree has to be inserted into a #BVHCache, as shared tree when
+ * \a r_is_shared is set.
+ */
+template<typename BuildFn>
+static BVHTree *bvhtree_shared_ensure(const SharedBVHKey &key,
+                                      const SharedBVHData &data,
+                                      bool *r_is_shared,
+                                      const BuildFn &build_fn)
+{
+  *r_is_shared = false;
+  if (BVHTree *tree = bvhtree_shared_acquire(key, data)) {
+    *r_is_shared = true;
+    return tree;
+  }
+  BVHTree *tree = build_fn();
+  if (tree == nullptr) {
+    return nullptr;
+  }
+  *r_is_shared = bvhtree_shared_add(key, data, tree);
+  return tree;
+}
+
 /** \} */
 /* -------------------------------------------------------------------- */
 /** \name Local Callbacks
@@ -635,7 +911,16 @@ static BVHTree *bvhtree_from_mesh_verts_create_tree(float epsilon,
   if (verts_num_active) {
     tree = BLI_bvhtree_new(verts_num_active, epsilon, tree_type, axis);
 
-    if (tree) {
+    if (tree && verts_mask == nullptr) {
+      BLI_bvhtree_insert_reserve(tree, verts_num);
+      blender::threading::parallel_for(
+          blender::IndexRange(verts_num), BVHTREE_INSERT_GRAIN_SIZE, [&](blender::IndexRange range) {
+            for (const int i : range) {
+              BLI_bvhtree_insert_at(tree, i, i, vert[i].co, 1);
+            }
+          });
+    }
+    else if (tree) {
       for (int i = 0; i < verts_num; i++) {
         if (verts_mask && !BLI_BITMAP_TEST_BOOL(verts_mask, i)) {
           continue;
@@ -844,7 +1129,19 @@ static BVHTree *bvhtree_from_mesh_edges_create_tree(const MVert *vert,
   if (edges_num_active) {
     /* Create a BVH-tree of the given target */
     tree = BLI_bvhtree_new(edges_num_active, epsilon, tree_type, axis);
-    if (tree) {
+    if (tree && edges_mask == nullptr) {
+      BLI_bvhtree_insert_reserve(tree, edge_num);
+      blender::threading::parallel_for(
+          blender::IndexRange(edge_num), BVHTREE_INSERT_GRAIN_SIZE, [&](blender::IndexRange range) {
+            for (const int i : range) {
+              float co[2][3];
+              copy_v3_v3(co[0], vert[edge[i].v1].co);
+              copy_v3_v3(co[1], vert[edge[i].v2].co);
+              BLI_bvhtree_insert_at(tree, i, i, co[0], 2);
+            }
+          });
+    }
+    else if (tree) {
       for (int i = 0; i < edge_num; i++) {
         if (edges_mask && !BLI_BITMAP_TEST_BOOL(edges_mask, i)) {
           continue;
@@ -1209,7 +1506,22 @@ static BVHTree *bvhtree_from_mesh_looptri_create_tree(float epsilon,
     /* Create a BVH-tree of the given target */
     // printf("%s: building BVH, total=%d\n", __func__, numFaces);
     tree = BLI_bvhtree_new(looptri_num_active, epsilon, tree_type, axis);
-    if (tree) {
+    if (tree && vert && looptri && looptri_mask == nullptr) {
+      BLI_bvhtree_insert_reserve(tree, looptri_num);
+      blender::threading::parallel_for(
+          blender::IndexRange(looptri_num),
+          BVHTREE_INSERT_GRAIN_SIZE,
+          [&](blender::IndexRange range) {
+            for (const int i : range) {
+              float co[3][3];
+              copy_v3_v3(co[0], vert[mloop[looptri[i].tri[0]].v].co);
+              copy_v3_v3(co[1], vert[mloop[looptri[i].tri[1]].v].co);
+              copy_v3_v3(co[2], vert[mloop[looptri[i].tri[2]].v].co);
+              BLI_bvhtree_insert_at(tree, i, i, co[0], 3);
+            }
+          });
+    }
+    else if (tree) {
       if (vert && looptri) {
         for (int i = 0; i < looptri_num; i++) {
           float co[3][3];
@@ -1382,6 +1694,110 @@ BVHTree *bvhtree_from_mesh_looptri_ex(BVHTreeFromMesh *data,
   return tree;
 }
 
+static SharedBVHKey bvhtree_shared_key_from_mesh(const Mesh *mesh,
+                                                 const BVHCacheType bvh_cache_type,
+                                                 const int tree_type,
+                                                 SharedBVHData &r_data)
+{
+  SharedBVHKey key;
+  key.type = bvh_cache_type;
+  key.tree_type = tree_type;
+  key.axis = 6;
+  key.epsilon = 0.0f;
+  const auto add_array = [&](const void *array, const size_t size) {
+    r_data.append({(const uint8_t *)array, (int64_t)size});
+  };
+  add_array(mesh->mvert, sizeof(MVert) * (size_t)mesh->totvert);
+  switch (bvh_cache_type) {
+    case BVHTREE_FROM_VERTS:
+      key.elems_num = mesh->totvert;
+      break;
+    case BVHTREE_FROM_EDGES:
+      key.elems_num = mesh->totedge;
+      add_array(mesh->medge, sizeof(MEdge) * (size_t)mesh->totedge);
+      break;
+    case BVHTREE_FROM_LOOPTRI: {
+      key.elems_num = BKE_mesh_runtime_looptri_len(mesh);
+      add_array(mesh->mloop, sizeof(MLoop) * (size_t)mesh->totloop);
+      add_array(BKE_mesh_runtime_looptri_ensure(mesh), sizeof(MLoopTri) * (size_t)key.elems_num);
+      break;
+    }
+    default:
+      BLI_assert_unreachable();
+      key.elems_num = 0;
+      break;
+  }
+  key.data_size = 0;
+  key.data_hash = 0;
+  for (const blender::Span<uint8_t> array : r_data) {
+    key.data_size += array.size();
+    key.data_hash = bvhtree_hash_array(array.data(), (size_t)array.size(), key.data_hash);
+  }
+  return key;
+}
+
+/**
+ * Get the tree of the given type from the cache of the mesh, or from the shared cache when
+ * another mesh with the same data has built it already. Only types that don't depend on data
+ * other than positions and topology are supported.
+ */
+static BVHTree *bvhtree_from_mesh_get_shared(const Mesh *mesh,
+                                             const BVHCacheType bvh_cache_type,
+                                             const int tree_type)
+{
+  BVHCache **bvh_cache_p = (BVHCache **)&mesh->runtime.bvh_cache;
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+
+  BVHTree *tree = nullptr;
+  bool lock_started = false;
+  if (bvhcache_find(bvh_cache_p, bvh_cache_type, &tree, &lock_started, mesh_eval_mutex)) {
+    return tree;
+  }
+
+  SharedBVHData data;
+  const SharedBVHKey key = bvhtree_shared_key_from_mesh(mesh, bvh_cache_type, tree_type, data);
+  bool is_shared;
+  tree = bvhtree_shared_ensure(key, data, &is_shared, [&]() {
+    BVHTree *new_tree = nullptr;
+    switch (bvh_cache_type) {
+      case BVHTREE_FROM_VERTS:
+        new_tree = bvhtree_from_mesh_verts_create_tree(
+            key.epsilon, tree_type, key.axis, mesh->mvert, mesh->totvert, nullptr, -1);
+        break;
+      case BVHTREE_FROM_EDGES:
+        new_tree = bvhtree_from_mesh_edges_create_tree(mesh->mvert,
+                                                       mesh->medge,
+                                                       mesh->totedge,
+                                                       nullptr,
+                                                       -1,
+                                                       key.epsilon,
+                                                       tree_type,
+                                                       key.axis);
+        break;
+      case BVHTREE_FROM_LOOPTRI:
+        new_tree = bvhtree_from_mesh_looptri_create_tree(key.epsilon,
+                                                         tree_type,
+                                                         key.axis,
+                                                         mesh->mvert,
+                                                         mesh->mloop,
+                                                         BKE_mesh_runtime_looptri_ensure(mesh),
+                                                         key.elems_num,
+                                                         nullptr,
+                                                         -1);
+        break;
+      default:
+        BLI_assert_unreachable();
+        break;
+    }
+    bvhtree_balance(new_tree, true);
+    return new_tree;
+  });
+
+  bvhcache_insert(*bvh_cache_p, tree, bvh_cache_type, is_shared);
+  bvhcache_unlock(*bvh_cache_p, lock_started);
+  return tree;
+}
+
 static BLI_bitmap *loose_verts_map_get(const MEdge *medge,
                                        int edges_num,
                                        const MVert *UNUSED(mvert),
@@ -1486,7 +1902,11 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
   switch (bvh_cache_type) {
     case BVHTREE_FROM_VERTS:
     case BVHTREE_FROM_LOOSEVERTS:
-      if (is_cached == false) {
+      if (is_cached == false && bvh_cache_type == BVHTREE_FROM_VERTS) {
+        tree = bvhtree_from_mesh_get_shared(mesh, bvh_cache_type, tree_type);
+        bvhtree_from_mesh_verts_setup_data(data, tree, true, mesh->mvert, false);
+      }
+      else if (is_cached == false) {
         BLI_bitmap *loose_verts_mask = nullptr;
         int loose_vert_len = -1;
         int verts_len = mesh->totvert;
@@ -1521,7 +1941,12 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
 
     case BVHTREE_FROM_EDGES:
     case BVHTREE_FROM_LOOSEEDGES:
-      if (is_cached == false) {
+      if (is_cached == false && bvh_cache_type == BVHTREE_FROM_EDGES) {
+        tree = bvhtree_from_mesh_get_shared(mesh, bvh_cache_type, tree_type);
+        bvhtree_from_mesh_edges_setup_data(
+            data, tree, true, mesh->mvert, false, mesh->medge, false);
+      }
+      else if (is_cached == false) {
         BLI_bitmap *loose_edges_mask = nullptr;
         int loose_edges_len = -1;
         int edges_len = mesh->totedge;
@@ -1585,7 +2010,13 @@ BVHTree *BKE_bvhtree_from_mesh_get(struct BVHTreeFromMesh *data,
 
     case BVHTREE_FROM_LOOPTRI:
     case BVHTREE_FROM_LOOPTRI_NO_HIDDEN:
-      if (is_cached == false) {
+      if (is_cached == false && bvh_cache_type == BVHTREE_FROM_LOOPTRI) {
+        tree = bvhtree_from_mesh_get_shared(mesh, bvh_cache_type, tree_type);
+        const MLoopTri *mlooptri = BKE_mesh_runtime_looptri_ensure(mesh);
+        bvhtree_from_mesh_looptri_setup_data(
+            data, tree, true, mesh->mvert, false, mesh->mloop, false, mlooptri, false);
+      }
+      else if (is_cached == false) {
         const MLoopTri *mlooptri = BKE_mesh_runtime_looptri_ensure(mesh);
         int looptri_len = BKE_mesh_runtime_looptri_len(mesh);
 
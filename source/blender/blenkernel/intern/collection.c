@@ -1148,9 +1148,7 @@ bool BKE_collection_object_add(Main *bmain, Collection *collection, Object *ob)
     return false;
   }
 
-  if (BKE_collection_is_in_scene(collection)) {
-    BKE_main_collection_sync(bmain);
-  }
+  BKE_main_collection_sync_from_collection(bmain, collection);
 
   DEG_id_tag_update(&collection->id, ID_RECALC_GEOMETRY);
 
@@ -1201,9 +1199,7 @@ bool BKE_collection_object_remove(Main *bmain,
     return false;
   }
 
-  if (BKE_collection_is_in_scene(collection)) {
-    BKE_main_collection_sync(bmain);
-  }
+  BKE_main_collection_sync_from_collection(bmain, collection);
 
   DEG_id_tag_update(&collection->id, ID_RECALC_GEOMETRY);
 
@@ -1607,7 +1603,7 @@ bool BKE_collection_child_add(Main *bmain, Collection *parent, Collection *child
     return false;
   }
 
-  BKE_main_collection_sync(bmain);
+  BKE_main_collection_sync_from_collection(bmain, parent);
   return true;
 }
 
@@ -1622,7 +1618,7 @@ bool BKE_collection_child_remove(Main *bmain, Collection *parent, Collection *ch
     return false;
   }
 
-  BKE_main_collection_sync(bmain);
+  BKE_main_collection_sync_from_collection(bmain, parent);
   return true;
 }
 
@@ -213,27 +213,44 @@ static void spline_extrude_to_mesh_data(const ResultInfo &info,
   }
 }
 
-static inline int spline_extrude_vert_size(const Spline &curve, const Spline &profile)
+/** The evaluated sizes of a spline, retrieved once rather than for every combination. */
+struct SplineSizes {
+  int points;
+  int edges;
+};
+
+static Array<SplineSizes> get_evaluated_sizes(Span<SplinePtr> splines)
+{
+  Array<SplineSizes> sizes(splines.size());
+  /* Computing the sizes can fill the evaluated caches of the splines, so do it in parallel. */
+  threading::parallel_for(splines.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      sizes[i] = {splines[i]->evaluated_points_size(), splines[i]->evaluated_edges_size()};
+    }
+  });
+  return sizes;
+}
+
+static inline int spline_extrude_vert_size(const SplineSizes &curve, const SplineSizes &profile)
 {
-  return curve.evaluated_points_size() * profile.evaluated_points_size();
+  return curve.points * profile.points;
 }
 
-static inline int spline_extrude_edge_size(const Spline &curve, const Spline &profile)
+static inline int spline_extrude_edge_size(const SplineSizes &curve, const SplineSizes &profile)
 {
   /* Add the ring edges, with one ring for every curve vertex, and the edge loops
    * that run along the length of the curve, starting on the first profile. */
-  return curve.evaluated_points_size() * profile.evaluated_edges_size() +
-         curve.evaluated_edges_size() * profile.evaluated_points_size();
+  return curve.points * profile.edges + curve.edges * profile.points;
 }
 
-static inline int spline_extrude_loop_size(const Spline &curve, const Spline &profile)
+static inline int spline_extrude_loop_size(const SplineSizes &curve, const SplineSizes &profile)
 {
-  return curve.evaluated_edges_size() * profile.evaluated_edges_size() * 4;
+  return curve.edges * profile.edges * 4;
 }
 
-static inline int spline_extrude_poly_size(const Spline &curve, const Spline &profile)
+static inline int spline_extrude_poly_size(const SplineSizes &curve, const SplineSizes &profile)
 {
-  return curve.evaluated_edges_size() * profile.evaluated_edges_size();
+  return curve.edges * profile.edges;
 }
 
 struct ResultOffsets {
@@ -242,7 +259,8 @@ struct ResultOffsets {
   Array<int> loop;
   Array<int> poly;
 };
-static ResultOffsets calculate_result_offsets(Span<SplinePtr> profiles, Span<SplinePtr> curves)
+static ResultOffsets calculate_result_offsets(Span<SplineSizes> profiles,
+                                              Span<SplineSizes> curves)
 {
   const int total = profiles.size() * curves.size();
   Array<int> vert(total + 1);
@@ -261,10 +279,10 @@ static ResultOffsets calculate_result_offsets(Span<SplinePtr> profiles, Span<Spl
       edge[mesh_index] = edge_offset;
       loop[mesh_index] = loop_offset;
       poly[mesh_index] = poly_offset;
-      vert_offset += spline_extrude_vert_size(*curves[i_spline], *profiles[i_profile]);
-      edge_offset += spline_extrude_edge_size(*curves[i_spline], *profiles[i_profile]);
-      loop_offset += spline_extrude_loop_size(*curves[i_spline], *profiles[i_profile]);
-      poly_offset += spline_extrude_poly_size(*curves[i_spline], *profiles[i_profile]);
+      vert_offset += spline_extrude_vert_size(curves[i_spline], profiles[i_profile]);
+      edge_offset += spline_extrude_edge_size(curves[i_spline], profiles[i_profile]);
+      loop_offset += spline_extrude_loop_size(curves[i_spline], profiles[i_profile]);
+      poly_offset += spline_extrude_poly_size(curves[i_spline], profiles[i_profile]);
       mesh_index++;
     }
   }
@@ -571,9 +589,11 @@ static void copy_point_domain_attributes_to_mesh(const ResultInfo &info,
 template<typename T>
 static void copy_spline_data_to_mesh(Span<T> src, Span<int> offsets, MutableSpan<T> dst)
 {
-  for (const int i : IndexRange(src.size())) {
-    dst.slice(offsets[i], offsets[i + 1] - offsets[i]).fill(src[i]);
-  }
+  threading::parallel_for(src.index_range(), 512, [&](IndexRange range) {
+    for (const int i : range) {
+      dst.slice(offsets[i], offsets[i + 1] - offsets[i]).fill(src[i]);
+    }
+  });
 }
 
 /**
@@ -657,7 +677,10 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile)
   Span<SplinePtr> profiles = profile.splines();
   Span<SplinePtr> curves = curve.splines();
 
-  const ResultOffsets offsets = calculate_result_offsets(profiles, curves);
+  const Array<SplineSizes> profile_sizes = get_evaluated_sizes(profiles);
+  const Array<SplineSizes> curve_sizes = get_evaluated_sizes(curves);
+
+  const ResultOffsets offsets = calculate_result_offsets(profile_sizes, curve_sizes);
   if (offsets.vert.last() == 0) {
     return nullptr;
   }
@@ -671,39 +694,39 @@ Mesh *curve_to_mesh_sweep(const CurveEval &curve, const CurveEval &profile)
 
   ResultAttributes attributes = create_result_attributes(curve, profile, *mesh);
 
-  threading::parallel_for(curves.index_range(), 128, [&](IndexRange curves_range) {
-    for (const int i_spline : curves_range) {
-      const Spline &spline = *curves[i_spline];
-      if (spline.evaluated_points_size() == 0) {
+  /* Iterate over all combinations in a single loop rather than nesting a loop over the profiles,
+   * which had a large overhead for many short curves with a single profile. */
+  const int combinations_len = curves.size() * profiles.size();
+  threading::parallel_for(IndexRange(combinations_len), 128, [&](IndexRange range) {
+    for (const int i_mesh : range) {
+      const int i_spline = i_mesh / profiles.size();
+      const int i_profile = i_mesh % profiles.size();
+      const SplineSizes &spline_sizes = curve_sizes[i_spline];
+      if (spline_sizes.points == 0) {
         continue;
       }
-      const int spline_start_index = i_spline * profiles.size();
-      threading::parallel_for(profiles.index_range(), 128, [&](IndexRange profiles_range) {
-        for (const int i_profile : profiles_range) {
-          const Spline &profile = *profiles[i_profile];
-          const int i_mesh = spline_start_index + i_profile;
-          ResultInfo info{
-              spline,
-              profile,
-              offsets.vert[i_mesh],
-              offsets.edge[i_mesh],
-              offsets.loop[i_mesh],
-              offsets.poly[i_mesh],
-              spline.evaluated_points_size(),
-              spline.evaluated_edges_size(),
-              profile.evaluated_points_size(),
-              profile.evaluated_edges_size(),
-          };
-
-          spline_extrude_to_mesh_data(info,
-                                      {mesh->mvert, mesh->totvert},
-                                      {mesh->medge, mesh->totedge},
-                                      {mesh->mloop, mesh->totloop},
-                                      {mesh->mpoly, mesh->totpoly});
-
-          copy_point_domain_attributes_to_mesh(info, attributes);
-        }
-      });
+      const Spline &spline = *curves[i_spline];
+      const Spline &profile = *profiles[i_profile];
+      ResultInfo info{
+          spline,
+          profile,
+          offsets.vert[i_mesh],
+          offsets.edge[i_mesh],
+          offsets.loop[i_mesh],
+          offsets.poly[i_mesh],
+          spline_sizes.points,
+          spline_sizes.edges,
+          profile_sizes[i_profile].points,
+          profile_sizes[i_profile].edges,
+      };
+
+      spline_extrude_to_mesh_data(info,
+                                  {mesh->mvert, mesh->totvert},
+                                  {mesh->medge, mesh->totedge},
+                                  {mesh->mloop, mesh->totloop},
+                                  {mesh->mpoly, mesh->totpoly});
+
+      copy_point_domain_attributes_to_mesh(info, attributes);
     }
   });
 
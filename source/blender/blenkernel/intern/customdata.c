@@ -42,6 +42,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -2197,7 +2198,9 @@ void CustomData_realloc(CustomData *data, int totelem)
       continue;
     }
     typeInfo = layerType_getInfo(layer->type);
+    const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_MESH);
     layer->data = MEM_reallocN(layer->data, (size_t)totelem * typeInfo->size);
+    MEM_domain_end(previous_domain);
   }
 }
 
@@ -2544,6 +2547,9 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     return &data->layers[CustomData_get_layer_index(data, type)];
   }
 
+  /* Count the layer and the data owned by its elements towards mesh memory. */
+  const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_MESH);
+
   if (ELEM(alloctype, CD_ASSIGN, CD_REFERENCE)) {
     newlayerdata = layerdata;
   }
@@ -2556,6 +2562,7 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     }
 
     if (!newlayerdata) {
+      MEM_domain_end(previous_domain);
       return NULL;
     }
   }
@@ -2579,6 +2586,8 @@ static CustomDataLayer *customData_add_layer__internal(CustomData *data,
     flag |= CD_FLAG_NOFREE;
   }
 
+  MEM_domain_end(previous_domain);
+
   if (index >= data->maxlayer) {
     if (!customData_resize(data, CUSTOMDATA_GROW)) {
       if (newlayerdata != layerdata) {
@@ -2809,6 +2818,7 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
      * So in case a custom copy function is defined, use it!
      */
     const LayerTypeInfo *typeInfo = layerType_getInfo(layer->type);
+    const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_MESH);
 
     if (typeInfo->copy) {
       void *dst_data = MEM_malloc_arrayN(
@@ -2820,6 +2830,8 @@ static void *customData_duplicate_referenced_layer_index(CustomData *data,
       layer->data = MEM_dupallocN(layer->data);
     }
 
+    MEM_domain_end(previous_domain);
+
     layer->flag &= ~CD_FLAG_NOFREE;
   }
 
@@ -3032,6 +3044,173 @@ void CustomData_copy_data(
   }
 }
 
+/* Element types of common sizes, so gathering plain data copies whole elements at once. */
+typedef struct CustomDataElem8 {
+  uint32_t v[2];
+} CustomDataElem8;
+typedef struct CustomDataElem12 {
+  uint32_t v[3];
+} CustomDataElem12;
+typedef struct CustomDataElem16 {
+  uint32_t v[4];
+} CustomDataElem16;
+
+/**
+ * Copy elements `src_indices[start..end)` of \a src_data to elements `[start..end)` of
+ * \a dst_data, for layers without a copy callback.
+ */
+static void customdata_gather_plain(const void *src_data,
+                                    void *dst_data,
+                                    const int *src_indices,
+                                    const size_t size,
+                                    const int start,
+                                    const int end)
+{
+#define GATHER_TYPED(type) \
+  { \
+    const type *src = src_data; \
+    type *dst = dst_data; \
+    for (int i = start; i < end; i++) { \
+      dst[i] = src[src_indices[i]]; \
+    } \
+  } \
+  ((void)0)
+
+  switch (size) {
+    case 1:
+      GATHER_TYPED(uint8_t);
+      break;
+    case 2:
+      GATHER_TYPED(uint16_t);
+      break;
+    case 4:
+      GATHER_TYPED(uint32_t);
+      break;
+    case 8:
+      GATHER_TYPED(CustomDataElem8);
+      break;
+    case 12:
+      GATHER_TYPED(CustomDataElem12);
+      break;
+    case 16:
+      GATHER_TYPED(CustomDataElem16);
+      break;
+    default:
+      for (int i = start; i < end; i++) {
+        memcpy(POINTER_OFFSET(dst_data, (size_t)i * size),
+               POINTER_OFFSET(src_data, (size_t)src_indices[i] * size),
+               size);
+      }
+      break;
+  }
+
+#undef GATHER_TYPED
+}
+
+#define GATHER_CHUNK_SIZE 4096
+
+typedef struct CustomDataGatherData {
+  const void *src_data;
+  void *dst_data;
+  const int *src_indices;
+  size_t size;
+  int count;
+} CustomDataGatherData;
+
+static void customdata_gather_plain_chunk_cb(void *__restrict userdata,
+                                             const int chunk,
+                                             const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const CustomDataGatherData *data = userdata;
+  const int start = chunk * GATHER_CHUNK_SIZE;
+  const int end = min_ii(start + GATHER_CHUNK_SIZE, data->count);
+  customdata_gather_plain(
+      data->src_data, data->dst_data, data->src_indices, data->size, start, end);
+}
+
+/**
+ * Copy \a count elements at once: source element `src_indices[i]` is copied to destination
+ * element `dest_index + i`. Equivalent to calling #CustomData_copy_data for each element, but
+ * layers are only matched once, and plain data layers are copied with loops specialized for
+ * their element size, in parallel for large counts.
+ */
+void CustomData_copy_data_gather(const CustomData *source,
+                                 CustomData *dest,
+                                 const int *src_indices,
+                                 int dest_index,
+                                 int count)
+{
+  if (count <= 0) {
+    return;
+  }
+
+  /* copies a layer at a time */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+
+    /* find the first dest layer with type >= the source type
+     * (this should work because layers are ordered by type)
+     */
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+      dest_i++;
+    }
+
+    /* if there are no more dest layers, we're done */
+    if (dest_i >= dest->totlayer) {
+      return;
+    }
+
+    /* if we found a matching layer, copy the data */
+    if (dest->layers[dest_i].type == source->layers[src_i].type) {
+      const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+      const void *src_data = source->layers[src_i].data;
+      void *dst_data = dest->layers[dest_i].data;
+
+      if (!src_data || !dst_data) {
+        if (!(src_data == NULL && dst_data == NULL)) {
+          CLOG_WARN(&LOG,
+                    "null data for %s type (%p --> %p), skipping",
+                    layerType_getName(source->layers[src_i].type),
+                    (void *)src_data,
+                    (void *)dst_data);
+        }
+      }
+      else if (typeInfo->copy) {
+        for (int i = 0; i < count; i++) {
+          typeInfo->copy(POINTER_OFFSET(src_data, (size_t)src_indices[i] * typeInfo->size),
+                         POINTER_OFFSET(dst_data, (size_t)(dest_index + i) * typeInfo->size),
+                         1);
+        }
+      }
+      else {
+        CustomDataGatherData data = {
+            .src_data = src_data,
+            .dst_data = POINTER_OFFSET(dst_data, (size_t)dest_index * typeInfo->size),
+            .src_indices = src_indices,
+            .size = typeInfo->size,
+            .count = count,
+        };
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.use_threading = (count > GATHER_CHUNK_SIZE * 4);
+        BLI_task_parallel_range(0,
+                                (count + GATHER_CHUNK_SIZE - 1) / GATHER_CHUNK_SIZE,
+                                &data,
+                                customdata_gather_plain_chunk_cb,
+                                &settings);
+      }
+
+      /* if there are multiple source & dest layers of the same type,
+       * we don't want to copy all source layers to the same dest, so
+       * increment dest_i
+       */
+      dest_i++;
+    }
+  }
+}
+
+#undef GATHER_CHUNK_SIZE
+
 void CustomData_copy_layer_type_data(const CustomData *source,
                                      CustomData *destination,
                                      int type,
@@ -3167,6 +3346,177 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+/**
+ * Weighted sum of elements made of \a components floats, for all destination elements at once.
+ * Same as the interpolation callbacks of float property and color layers.
+ */
+static void customdata_interp_floats_batch(const float *src_data,
+                                           float *dst_data,
+                                           const int components,
+                                           const int *src_indices,
+                                           const float *weights,
+                                           const int sources_num,
+                                           const int *dest_indices,
+                                           const int count)
+{
+  BLI_assert(components <= 4);
+  for (int i = 0; i < count; i++) {
+    const int *elem_indices = &src_indices[i * sources_num];
+    const float *elem_weights = &weights[i * sources_num];
+    float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+    for (int j = 0; j < sources_num; j++) {
+      const float *src = &src_data[(size_t)elem_indices[j] * components];
+      for (int c = 0; c < components; c++) {
+        result[c] += src[c] * elem_weights[j];
+      }
+    }
+    float *dst = &dst_data[(size_t)dest_indices[i] * components];
+    for (int c = 0; c < components; c++) {
+      dst[c] = result[c];
+    }
+  }
+}
+
+/** Same as #layerInterp_mloopuv, for all destination elements at once. */
+static void customdata_interp_mloopuv_batch(const MLoopUV *src_data,
+                                            MLoopUV *dst_data,
+                                            const int *src_indices,
+                                            const float *weights,
+                                            const int sources_num,
+                                            const int *dest_indices,
+                                            const int count)
+{
+  for (int i = 0; i < count; i++) {
+    const int *elem_indices = &src_indices[i * sources_num];
+    const float *elem_weights = &weights[i * sources_num];
+    float uv[2] = {0.0f, 0.0f};
+    int flag = 0;
+    for (int j = 0; j < sources_num; j++) {
+      const MLoopUV *src = &src_data[elem_indices[j]];
+      madd_v2_v2fl(uv, src->uv, elem_weights[j]);
+      if (elem_weights[j] > 0.0f) {
+        flag |= src->flag;
+      }
+    }
+    MLoopUV *dst = &dst_data[dest_indices[i]];
+    copy_v2_v2(dst->uv, uv);
+    dst->flag = flag;
+  }
+}
+
+/**
+ * Interpolate \a count destination items at once, each from the same number of source items.
+ * Equivalent to calling #CustomData_interp for each destination item (without sub-weights), but
+ * layers are only matched once, and float, color and UV layers use interpolation loops which do
+ * not go through the per-type callbacks.
+ *
+ * \param src_indices: Indices of the source items, \a sources_num per destination item.
+ * \param weights: The weights of the source items, \a sources_num per destination item. If NULL,
+ * source items are averaged.
+ * \param dest_indices: The index of each destination item. \a source and \a dest must differ,
+ * since destination items are written while later ones are still being interpolated.
+ */
+void CustomData_interp_batch(const CustomData *source,
+                             CustomData *dest,
+                             const int *src_indices,
+                             const float *weights,
+                             int sources_num,
+                             const int *dest_indices,
+                             int count)
+{
+  BLI_assert(source != dest);
+  if (count <= 0 || sources_num <= 0) {
+    return;
+  }
+
+  /* If no weights are given, generate default ones to produce an average result. */
+  float *default_weights = NULL;
+  if (weights == NULL) {
+    default_weights = MEM_malloc_arrayN((size_t)count * sources_num, sizeof(float), __func__);
+    copy_vn_fl(default_weights, count * sources_num, 1.0f / sources_num);
+    weights = default_weights;
+  }
+
+  const void *source_buf[SOURCE_BUF_SIZE];
+  const void **sources = source_buf;
+  if (sources_num > SOURCE_BUF_SIZE) {
+    sources = MEM_malloc_arrayN(sources_num, sizeof(*sources), __func__);
+  }
+
+  /* interpolates a layer at a time */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    const int type = source->layers[src_i].type;
+    const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+
+    /* find the first dest layer with type >= the source type
+     * (this should work because layers are ordered by type)
+     */
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < type) {
+      dest_i++;
+    }
+
+    /* if there are no more dest layers, we're done */
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+
+    if (dest->layers[dest_i].type != type) {
+      continue;
+    }
+
+    const void *src_data = source->layers[src_i].data;
+    void *dst_data = dest->layers[dest_i].data;
+
+    switch (type) {
+      case CD_PROP_FLOAT:
+      case CD_PROP_FLOAT2:
+      case CD_PROP_FLOAT3:
+      case CD_PROP_COLOR:
+        customdata_interp_floats_batch(src_data,
+                                       dst_data,
+                                       (int)(typeInfo->size / sizeof(float)),
+                                       src_indices,
+                                       weights,
+                                       sources_num,
+                                       dest_indices,
+                                       count);
+        break;
+      case CD_MLOOPUV:
+        customdata_interp_mloopuv_batch(
+            src_data, dst_data, src_indices, weights, sources_num, dest_indices, count);
+        break;
+      default:
+        for (int i = 0; i < count; i++) {
+          for (int j = 0; j < sources_num; j++) {
+            sources[j] = POINTER_OFFSET(
+                src_data, (size_t)src_indices[i * sources_num + j] * typeInfo->size);
+          }
+          typeInfo->interp(sources,
+                           &weights[i * sources_num],
+                           NULL,
+                           sources_num,
+                           POINTER_OFFSET(dst_data, (size_t)dest_indices[i] * typeInfo->size));
+        }
+        break;
+    }
+
+    /* if there are multiple source & dest layers of the same type,
+     * we don't want to copy all source layers to the same dest, so
+     * increment dest_i
+     */
+    dest_i++;
+  }
+
+  if (sources_num > SOURCE_BUF_SIZE) {
+    MEM_freeN((void *)sources);
+  }
+  MEM_SAFE_FREE(default_weights);
+}
+
 /**
  * Swap data inside each item, for all layers.
  * This only applies to item types that may store several sub-item data
@@ -42,7 +42,9 @@
 #include "BLI_scanfill.h"
 #include "BLI_span.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_anim_path.h"
 #include "BKE_curve.h"
@@ -65,6 +67,7 @@
 #include "DEG_depsgraph_query.h"
 
 using blender::IndexRange;
+using blender::Vector;
 
 static void boundbox_displist_object(Object *ob);
 
@@ -274,6 +277,14 @@ static void curve_to_displist(const Curve *cu,
 {
   const bool editmode = (!for_render && (cu->editnurb || cu->editfont));
 
+  /* NURBS are evaluated after all display lists are allocated, so it can be done in parallel. */
+  struct NurbEvaluation {
+    const Nurb *nu;
+    DispList *dl;
+    int resolution;
+  };
+  Vector<NurbEvaluation> nurbs_to_evaluate;
+
   LISTBASE_FOREACH (Nurb *, nu, nubase) {
     if (nu->hide != 0 && editmode) {
       continue;
@@ -382,7 +393,7 @@ static void curve_to_displist(const Curve *cu,
       dl->charidx = nu->charidx;
       dl->type = is_cyclic ? DL_POLY : DL_SEGM;
 
-      BKE_nurb_makeCurve(nu, dl->verts, nullptr, nullptr, nullptr, resolution, sizeof(float[3]));
+      nurbs_to_evaluate.append({nu, dl, resolution});
     }
     else if (nu->type == CU_POLY) {
       const int len = nu->pntsu;
@@ -402,6 +413,18 @@ static void curve_to_displist(const Curve *cu,
       }
     }
   }
+
+  blender::threading::parallel_for(nurbs_to_evaluate.index_range(), 8, [&](IndexRange range) {
+    for (const NurbEvaluation &evaluation : nurbs_to_evaluate.as_span().slice(range)) {
+      BKE_nurb_makeCurve(evaluation.nu,
+                         evaluation.dl->verts,
+                         nullptr,
+                         nullptr,
+                         nullptr,
+                         evaluation.resolution,
+                         sizeof(float[3]));
+    }
+  });
 }
 
 /**
@@ -993,6 +1016,16 @@ static void evaluate_surface_object(Depsgraph *depsgraph,
 
   BKE_curve_calc_modifiers_pre(depsgraph, scene, ob, deformed_nurbs, deformed_nurbs, for_render);
 
+  /* Surfaces are evaluated after all display lists are allocated, so it can be done in
+   * parallel. */
+  struct SurfaceEvaluation {
+    const Nurb *nu;
+    DispList *dl;
+    int resolu;
+    int resolv;
+  };
+  Vector<SurfaceEvaluation> surfaces_to_evaluate;
+
   LISTBASE_FOREACH (const Nurb *, nu, deformed_nurbs) {
     if (!(for_render || nu->hide == 0) || !BKE_nurb_check_valid_uv(nu)) {
       continue;
@@ -1014,7 +1047,6 @@ static void evaluate_surface_object(Depsgraph *depsgraph,
       dl->charidx = nu->charidx;
       dl->rt = nu->flag;
 
-      float *data = dl->verts;
       if (nu->flagu & CU_NURB_CYCLIC) {
         dl->type = DL_POLY;
       }
@@ -1022,7 +1054,7 @@ static void evaluate_surface_object(Depsgraph *depsgraph,
         dl->type = DL_SEGM;
       }
 
-      BKE_nurb_makeCurve(nu, data, nullptr, nullptr, nullptr, resolu, sizeof(float[3]));
+      surfaces_to_evaluate.append({nu, dl, resolu, resolv});
     }
     else {
       const int len = (nu->pntsu * resolu) * (nu->pntsv * resolv);
@@ -1035,7 +1067,6 @@ static void evaluate_surface_object(Depsgraph *depsgraph,
       dl->charidx = nu->charidx;
       dl->rt = nu->flag;
 
-      float *data = dl->verts;
       dl->type = DL_SURF;
 
       dl->parts = (nu->pntsu * resolu); /* in reverse, because makeNurbfaces works that way */
@@ -1047,13 +1078,27 @@ static void evaluate_surface_object(Depsgraph *depsgraph,
         dl->flag |= DL_CYCL_V;
       }
 
-      BKE_nurb_makeFaces(nu, data, 0, resolu, resolv);
-
-      /* gl array drawing: using indices */
-      displist_surf_indices(dl);
+      surfaces_to_evaluate.append({nu, dl, resolu, resolv});
     }
   }
 
+  blender::threading::parallel_for(surfaces_to_evaluate.index_range(), 1, [&](IndexRange range) {
+    for (const SurfaceEvaluation &evaluation : surfaces_to_evaluate.as_span().slice(range)) {
+      const Nurb *nu = evaluation.nu;
+      DispList *dl = evaluation.dl;
+      if (nu->pntsv == 1) {
+        BKE_nurb_makeCurve(
+            nu, dl->verts, nullptr, nullptr, nullptr, evaluation.resolu, sizeof(float[3]));
+      }
+      else {
+        BKE_nurb_makeFaces(nu, dl->verts, 0, evaluation.resolu, evaluation.resolv);
+
+        /* gl array drawing: using indices */
+        displist_surf_indices(dl);
+      }
+    }
+  });
+
   curve_to_filledpoly(cu, r_dispbase);
   GeometrySet geometry_set = curve_calc_modifiers_post(
       depsgraph, scene, ob, r_dispbase, for_render);
@@ -51,7 +51,19 @@ GeometryComponent *MeshComponent::copy() const
 {
   MeshComponent *new_component = new MeshComponent();
   if (mesh_ != nullptr) {
-    new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    if (ownership_ == GeometryOwnershipType::Owned) {
+      /* Only reference the custom data layers. They are copied when they are modified, so that
+       * e.g. changing the positions does not require copying the topology and all other
+       * attributes. This component is kept alive and immutable as long as the copy uses its
+       * layers. A read-only mesh can't be referenced, because it is not owned by this component
+       * and might be freed by its owner. */
+      new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, true);
+      this->user_add();
+      new_component->shared_layers_source_ = blender::UserCounter<const GeometryComponent>(this);
+    }
+    else {
+      new_component->mesh_ = BKE_mesh_copy_for_eval(mesh_, false);
+    }
     new_component->ownership_ = GeometryOwnershipType::Owned;
   }
   return new_component;
@@ -66,6 +78,21 @@ void MeshComponent::clear()
     }
     mesh_ = nullptr;
   }
+  /* The mesh does not reference the layers of the source anymore. */
+  shared_layers_source_ = {};
+}
+
+/**
+ * Make sure that the mesh does not reference the custom data layers of another mesh anymore.
+ */
+static void mesh_duplicate_referenced_layers(Mesh &mesh)
+{
+  CustomData_duplicate_referenced_layers(&mesh.vdata, mesh.totvert);
+  CustomData_duplicate_referenced_layers(&mesh.edata, mesh.totedge);
+  CustomData_duplicate_referenced_layers(&mesh.ldata, mesh.totloop);
+  CustomData_duplicate_referenced_layers(&mesh.pdata, mesh.totpoly);
+  CustomData_duplicate_referenced_layers(&mesh.fdata, mesh.totface);
+  BKE_mesh_update_customdata_pointers(&mesh, false);
 }
 
 bool MeshComponent::has_mesh() const
@@ -88,6 +115,10 @@ Mesh *MeshComponent::release()
 {
   BLI_assert(this->is_mutable());
   Mesh *mesh = mesh_;
+  if (shared_layers_source_) {
+    mesh_duplicate_referenced_layers(*mesh);
+    shared_layers_source_ = {};
+  }
   mesh_ = nullptr;
   return mesh;
 }
@@ -102,6 +133,20 @@ const Mesh *MeshComponent::get_for_read() const
 /* Get the mesh from this component. This method can only be used when the component is mutable,
  * i.e. it is not shared. The returned mesh can be modified. No ownership is transferred. */
 Mesh *MeshComponent::get_for_write()
+{
+  Mesh *mesh = this->get_for_write_with_shared_layers();
+  if (shared_layers_source_) {
+    /* The caller may modify any layer directly. */
+    mesh_duplicate_referenced_layers(*mesh);
+    shared_layers_source_ = {};
+  }
+  return mesh;
+}
+
+/* Like #get_for_write, but the custom data layers of the returned mesh can still be shared with
+ * other meshes. Referenced layers (see #CD_FLAG_NOFREE) have to be duplicated before they are
+ * modified, like the attribute API does. */
+Mesh *MeshComponent::get_for_write_with_shared_layers()
 {
   BLI_assert(this->is_mutable());
   if (ownership_ == GeometryOwnershipType::ReadOnly) {
@@ -160,7 +205,7 @@ namespace blender::bke {
 
 template<typename T>
 static void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
-                                                   const VArray<T> &old_values,
+                                                   const Span<T> old_values,
                                                    MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -178,7 +223,7 @@ static void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
 /* A vertex is selected if all connected face corners were selected and it is not loose. */
 template<>
 void adapt_mesh_domain_corner_to_point_impl(const Mesh &mesh,
-                                            const VArray<bool> &old_values,
+                                            const Span<bool> old_values,
                                             MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -212,7 +257,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_point(const Mesh &mesh, GVArrayPtr
       /* We compute all interpolated values at once, because for this interpolation, one has to
        * iterate over all loops anyway. */
       Array<T> values(mesh.totvert);
-      adapt_mesh_domain_corner_to_point_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_corner_to_point_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -228,7 +273,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_point(const Mesh &mesh, GVArrayPtr
  */
 template<typename T>
 static void adapt_mesh_domain_point_to_corner_impl(const Mesh &mesh,
-                                                   const VArray<T> &old_values,
+                                                   const Span<T> old_values,
                                                    MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totloop);
@@ -245,7 +290,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_corner(const Mesh &mesh, GVArrayPtr
   attribute_math::convert_to_static_type(varray->type(), [&](auto dummy) {
     using T = decltype(dummy);
     Array<T> values(mesh.totloop);
-    adapt_mesh_domain_point_to_corner_impl<T>(mesh, varray->typed<T>(), values);
+    adapt_mesh_domain_point_to_corner_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
     new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
   });
   return new_varray;
@@ -258,7 +303,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_corner(const Mesh &mesh, GVArrayPtr
  */
 template<typename T>
 static void adapt_mesh_domain_corner_to_face_impl(const Mesh &mesh,
-                                                  const VArray<T> &old_values,
+                                                  const Span<T> old_values,
                                                   MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -278,7 +323,7 @@ static void adapt_mesh_domain_corner_to_face_impl(const Mesh &mesh,
 /* A face is selected if all of its corners were selected. */
 template<>
 void adapt_mesh_domain_corner_to_face_impl(const Mesh &mesh,
-                                           const VArray<bool> &old_values,
+                                           const Span<bool> old_values,
                                            MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -302,7 +347,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_face(const Mesh &mesh, GVArrayPtr
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totpoly);
-      adapt_mesh_domain_corner_to_face_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_corner_to_face_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -311,7 +356,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_face(const Mesh &mesh, GVArrayPtr
 
 template<typename T>
 static void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
-                                                  const VArray<T> &old_values,
+                                                  const Span<T> old_values,
                                                   MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -336,7 +381,7 @@ static void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
 /* An edge is selected if all corners on adjacent faces were selected. */
 template<>
 void adapt_mesh_domain_corner_to_edge_impl(const Mesh &mesh,
-                                           const VArray<bool> &old_values,
+                                           const Span<bool> old_values,
                                            MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -375,7 +420,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_edge(const Mesh &mesh, GVArrayPtr
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totedge);
-      adapt_mesh_domain_corner_to_edge_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_corner_to_edge_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -384,7 +429,7 @@ static GVArrayPtr adapt_mesh_domain_corner_to_edge(const Mesh &mesh, GVArrayPtr
 
 template<typename T>
 void adapt_mesh_domain_face_to_point_impl(const Mesh &mesh,
-                                          const VArray<T> &old_values,
+                                          const Span<T> old_values,
                                           MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -406,7 +451,7 @@ void adapt_mesh_domain_face_to_point_impl(const Mesh &mesh,
 /* A vertex is selected if any of the connected faces were selected. */
 template<>
 void adapt_mesh_domain_face_to_point_impl(const Mesh &mesh,
-                                          const VArray<bool> &old_values,
+                                          const Span<bool> old_values,
                                           MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -431,7 +476,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_point(const Mesh &mesh, GVArrayPtr v
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totvert);
-      adapt_mesh_domain_face_to_point_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_face_to_point_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -441,7 +486,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_point(const Mesh &mesh, GVArrayPtr v
 /* Each corner's value is simply a copy of the value at its face. */
 template<typename T>
 void adapt_mesh_domain_face_to_corner_impl(const Mesh &mesh,
-                                           const VArray<T> &old_values,
+                                           const Span<T> old_values,
                                            MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totloop);
@@ -460,7 +505,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_corner(const Mesh &mesh, GVArrayPtr
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totloop);
-      adapt_mesh_domain_face_to_corner_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_face_to_corner_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -469,7 +514,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_corner(const Mesh &mesh, GVArrayPtr
 
 template<typename T>
 void adapt_mesh_domain_face_to_edge_impl(const Mesh &mesh,
-                                         const VArray<T> &old_values,
+                                         const Span<T> old_values,
                                          MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -489,7 +534,7 @@ void adapt_mesh_domain_face_to_edge_impl(const Mesh &mesh,
 /* An edge is selected if any connected face was selected. */
 template<>
 void adapt_mesh_domain_face_to_edge_impl(const Mesh &mesh,
-                                         const VArray<bool> &old_values,
+                                         const Span<bool> old_values,
                                          MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -514,7 +559,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_edge(const Mesh &mesh, GVArrayPtr va
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totedge);
-      adapt_mesh_domain_face_to_edge_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_face_to_edge_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -528,7 +573,7 @@ static GVArrayPtr adapt_mesh_domain_face_to_edge(const Mesh &mesh, GVArrayPtr va
  */
 template<typename T>
 static void adapt_mesh_domain_point_to_face_impl(const Mesh &mesh,
-                                                 const VArray<T> &old_values,
+                                                 const Span<T> old_values,
                                                  MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -548,7 +593,7 @@ static void adapt_mesh_domain_point_to_face_impl(const Mesh &mesh,
 /* A face is selected if all of its vertices were selected too. */
 template<>
 void adapt_mesh_domain_point_to_face_impl(const Mesh &mesh,
-                                          const VArray<bool> &old_values,
+                                          const Span<bool> old_values,
                                           MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -574,7 +619,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_face(const Mesh &mesh, GVArrayPtr v
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totpoly);
-      adapt_mesh_domain_point_to_face_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_point_to_face_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -588,7 +633,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_face(const Mesh &mesh, GVArrayPtr v
  */
 template<typename T>
 static void adapt_mesh_domain_point_to_edge_impl(const Mesh &mesh,
-                                                 const VArray<T> &old_values,
+                                                 const Span<T> old_values,
                                                  MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -606,7 +651,7 @@ static void adapt_mesh_domain_point_to_edge_impl(const Mesh &mesh,
 /* An edge is selected if both of its vertices were selected. */
 template<>
 void adapt_mesh_domain_point_to_edge_impl(const Mesh &mesh,
-                                          const VArray<bool> &old_values,
+                                          const Span<bool> old_values,
                                           MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totedge);
@@ -624,7 +669,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_edge(const Mesh &mesh, GVArrayPtr v
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totedge);
-      adapt_mesh_domain_point_to_edge_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_point_to_edge_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -633,7 +678,7 @@ static GVArrayPtr adapt_mesh_domain_point_to_edge(const Mesh &mesh, GVArrayPtr v
 
 template<typename T>
 void adapt_mesh_domain_edge_to_corner_impl(const Mesh &mesh,
-                                           const VArray<T> &old_values,
+                                           const Span<T> old_values,
                                            MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totloop);
@@ -658,7 +703,7 @@ void adapt_mesh_domain_edge_to_corner_impl(const Mesh &mesh,
 /* A corner is selected if its two adjacent edges were selected. */
 template<>
 void adapt_mesh_domain_edge_to_corner_impl(const Mesh &mesh,
-                                           const VArray<bool> &old_values,
+                                           const Span<bool> old_values,
                                            MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totloop);
@@ -685,7 +730,7 @@ static GVArrayPtr adapt_mesh_domain_edge_to_corner(const Mesh &mesh, GVArrayPtr
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totloop);
-      adapt_mesh_domain_edge_to_corner_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_edge_to_corner_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -694,7 +739,7 @@ static GVArrayPtr adapt_mesh_domain_edge_to_corner(const Mesh &mesh, GVArrayPtr
 
 template<typename T>
 static void adapt_mesh_domain_edge_to_point_impl(const Mesh &mesh,
-                                                 const VArray<T> &old_values,
+                                                 const Span<T> old_values,
                                                  MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -713,7 +758,7 @@ static void adapt_mesh_domain_edge_to_point_impl(const Mesh &mesh,
 /* A vertex is selected if any connected edge was selected. */
 template<>
 void adapt_mesh_domain_edge_to_point_impl(const Mesh &mesh,
-                                          const VArray<bool> &old_values,
+                                          const Span<bool> old_values,
                                           MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totvert);
@@ -735,7 +780,7 @@ static GVArrayPtr adapt_mesh_domain_edge_to_point(const Mesh &mesh, GVArrayPtr v
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totvert);
-      adapt_mesh_domain_edge_to_point_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_edge_to_point_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -749,7 +794,7 @@ static GVArrayPtr adapt_mesh_domain_edge_to_point(const Mesh &mesh, GVArrayPtr v
  */
 template<typename T>
 static void adapt_mesh_domain_edge_to_face_impl(const Mesh &mesh,
-                                                const VArray<T> &old_values,
+                                                const Span<T> old_values,
                                                 MutableSpan<T> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -769,7 +814,7 @@ static void adapt_mesh_domain_edge_to_face_impl(const Mesh &mesh,
 /* A face is selected if all of its edges are selected. */
 template<>
 void adapt_mesh_domain_edge_to_face_impl(const Mesh &mesh,
-                                         const VArray<bool> &old_values,
+                                         const Span<bool> old_values,
                                          MutableSpan<bool> r_values)
 {
   BLI_assert(r_values.size() == mesh.totpoly);
@@ -795,7 +840,7 @@ static GVArrayPtr adapt_mesh_domain_edge_to_face(const Mesh &mesh, GVArrayPtr va
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<attribute_math::DefaultMixer<T>>) {
       Array<T> values(mesh.totpoly);
-      adapt_mesh_domain_edge_to_face_impl<T>(mesh, varray->typed<T>(), values);
+      adapt_mesh_domain_edge_to_face_impl<T>(mesh, fn::GVArray_Span<T>(*varray), values);
       new_varray = std::make_unique<fn::GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
@@ -883,7 +928,8 @@ static Mesh *get_mesh_from_component_for_write(GeometryComponent &component)
 {
   BLI_assert(component.type() == GEO_COMPONENT_TYPE_MESH);
   MeshComponent &mesh_component = static_cast<MeshComponent &>(component);
-  return mesh_component.get_for_write();
+  /* The attribute providers only duplicate the layers that are modified. */
+  return mesh_component.get_for_write_with_shared_layers();
 }
 
 static const Mesh *get_mesh_from_component_for_read(const GeometryComponent &component)
@@ -1082,7 +1128,7 @@ class VertexGroupsAttributeProvider final : public DynamicAttributesProvider {
       return {};
     }
     MeshComponent &mesh_component = static_cast<MeshComponent &>(component);
-    Mesh *mesh = mesh_component.get_for_write();
+    Mesh *mesh = mesh_component.get_for_write_with_shared_layers();
     if (mesh == nullptr) {
       return {};
     }
@@ -1115,7 +1161,7 @@ class VertexGroupsAttributeProvider final : public DynamicAttributesProvider {
       return false;
     }
     MeshComponent &mesh_component = static_cast<MeshComponent &>(component);
-    Mesh *mesh = mesh_component.get_for_write();
+    Mesh *mesh = mesh_component.get_for_write_with_shared_layers();
     if (mesh == nullptr) {
       return true;
     }
@@ -1129,6 +1175,8 @@ class VertexGroupsAttributeProvider final : public DynamicAttributesProvider {
     if (mesh->dvert == nullptr) {
       return true;
     }
+    mesh->dvert = (MDeformVert *)CustomData_duplicate_referenced_layer(
+        &mesh->vdata, CD_MDEFORMVERT, mesh->totvert);
     for (MDeformVert &dvert : MutableSpan(mesh->dvert, mesh->totvert)) {
       MDeformWeight *weight = BKE_defvert_find_index(&dvert, vertex_group_index);
       BKE_defvert_remove_group(&dvert, weight);
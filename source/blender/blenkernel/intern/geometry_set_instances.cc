@@ -23,6 +23,8 @@
 #include "BKE_pointcloud.h"
 #include "BKE_spline.hh"
 
+#include "BLI_task.hh"
+
 #include "DNA_collection_types.h"
 #include "DNA_layer_types.h"
 #include "DNA_mesh_types.h"
@@ -224,6 +226,18 @@ void geometry_set_gather_instances_attribute_info(Span<GeometryInstanceGroup> se
   }
 }
 
+/** A mesh or point cloud that is copied into the joined mesh with one transform. */
+struct MeshRealizeTask {
+  const Mesh *mesh = nullptr;
+  const PointCloud *pointcloud = nullptr;
+  const float4x4 *transform = nullptr;
+  int material_map_index = -1;
+  int vert_offset = 0;
+  int edge_offset = 0;
+  int loop_offset = 0;
+  int poly_offset = 0;
+};
+
 static Mesh *join_mesh_topology_and_builtin_attributes(Span<GeometryInstanceGroup> set_groups,
                                                        const bool convert_points_to_vertices)
 {
@@ -285,6 +299,10 @@ static Mesh *join_mesh_topology_and_builtin_attributes(Span<GeometryInstanceGrou
   new_mesh->runtime.cd_dirty_edge = cd_dirty_edge;
   new_mesh->runtime.cd_dirty_loop = cd_dirty_loop;
 
+  /* First compute where every instance is copied to, so that all instances can be copied in
+   * parallel afterwards. */
+  Vector<Array<int>> material_index_maps;
+  Vector<MeshRealizeTask> tasks;
   int vert_offset = 0;
   int loop_offset = 0;
   int edge_offset = 0;
@@ -294,7 +312,9 @@ static Mesh *join_mesh_topology_and_builtin_attributes(Span<GeometryInstanceGrou
     if (set.has_mesh()) {
       const Mesh &mesh = *set.get_mesh_for_read();
 
-      Array<int> material_index_map(mesh.totcol);
+      const int material_map_index = material_index_maps.size();
+      material_index_maps.append_as(mesh.totcol);
+      MutableSpan<int> material_index_map = material_index_maps.last();
       for (const int i : IndexRange(mesh.totcol)) {
         Material *material = mesh.mat[i];
         const int new_material_index = materials.index_of(material);
@@ -302,42 +322,15 @@ static Mesh *join_mesh_topology_and_builtin_attributes(Span<GeometryInstanceGrou
       }
 
       for (const float4x4 &transform : set_group.transforms) {
-        for (const int i : IndexRange(mesh.totvert)) {
-          const MVert &old_vert = mesh.mvert[i];
-          MVert &new_vert = new_mesh->mvert[vert_offset + i];
-
-          new_vert = old_vert;
-
-          const float3 new_position = transform * float3(old_vert.co);
-          copy_v3_v3(new_vert.co, new_position);
-        }
-        for (const int i : IndexRange(mesh.totedge)) {
-          const MEdge &old_edge = mesh.medge[i];
-          MEdge &new_edge = new_mesh->medge[edge_offset + i];
-          new_edge = old_edge;
-          new_edge.v1 += vert_offset;
-          new_edge.v2 += vert_offset;
-        }
-        for (const int i : IndexRange(mesh.totloop)) {
-          const MLoop &old_loop = mesh.mloop[i];
-          MLoop &new_loop = new_mesh->mloop[loop_offset + i];
-          new_loop = old_loop;
-          new_loop.v += vert_offset;
-          new_loop.e += edge_offset;
-        }
-        for (const int i : IndexRange(mesh.totpoly)) {
-          const MPoly &old_poly = mesh.mpoly[i];
-          MPoly &new_poly = new_mesh->mpoly[poly_offset + i];
-          new_poly = old_poly;
-          new_poly.loopstart += loop_offset;
-          if (old_poly.mat_nr >= 0 && old_poly.mat_nr < mesh.totcol) {
-            new_poly.mat_nr = material_index_map[new_poly.mat_nr];
-          }
-          else {
-            /* The material index was invalid before. */
-            new_poly.mat_nr = 0;
-          }
-        }
+        MeshRealizeTask task;
+        task.mesh = &mesh;
+        task.transform = &transform;
+        task.material_map_index = material_map_index;
+        task.vert_offset = vert_offset;
+        task.edge_offset = edge_offset;
+        task.loop_offset = loop_offset;
+        task.poly_offset = poly_offset;
+        tasks.append(task);
 
         vert_offset += mesh.totvert;
         loop_offset += mesh.totloop;
@@ -346,25 +339,92 @@ static Mesh *join_mesh_topology_and_builtin_attributes(Span<GeometryInstanceGrou
       }
     }
 
-    const float3 point_normal{0.0f, 0.0f, 1.0f};
-    short point_normal_short[3];
-    normal_float_to_short_v3(point_normal_short, point_normal);
-
     if (convert_points_to_vertices && set.has_pointcloud()) {
       const PointCloud &pointcloud = *set.get_pointcloud_for_read();
       for (const float4x4 &transform : set_group.transforms) {
-        for (const int i : IndexRange(pointcloud.totpoint)) {
-          MVert &new_vert = new_mesh->mvert[vert_offset + i];
-          const float3 old_position = pointcloud.co[i];
-          const float3 new_position = transform * old_position;
-          copy_v3_v3(new_vert.co, new_position);
-          memcpy(&new_vert.no, point_normal_short, sizeof(point_normal_short));
-        }
+        MeshRealizeTask task;
+        task.pointcloud = &pointcloud;
+        task.transform = &transform;
+        task.vert_offset = vert_offset;
+        tasks.append(task);
+
         vert_offset += pointcloud.totpoint;
       }
     }
   }
 
+  const float3 point_normal{0.0f, 0.0f, 1.0f};
+  short point_normal_short[3];
+  normal_float_to_short_v3(point_normal_short, point_normal);
+
+  threading::parallel_for_weighted(
+      tasks.index_range(),
+      4096,
+      [&](const IndexRange range) {
+        for (const int task_index : range) {
+          const MeshRealizeTask &task = tasks[task_index];
+          const float4x4 &transform = *task.transform;
+
+          if (task.pointcloud != nullptr) {
+            const PointCloud &pointcloud = *task.pointcloud;
+            for (const int i : IndexRange(pointcloud.totpoint)) {
+              MVert &new_vert = new_mesh->mvert[task.vert_offset + i];
+              const float3 old_position = pointcloud.co[i];
+              const float3 new_position = transform * old_position;
+              copy_v3_v3(new_vert.co, new_position);
+              memcpy(&new_vert.no, point_normal_short, sizeof(point_normal_short));
+            }
+            continue;
+          }
+
+          const Mesh &mesh = *task.mesh;
+          const Span<int> material_index_map = material_index_maps[task.material_map_index];
+          for (const int i : IndexRange(mesh.totvert)) {
+            const MVert &old_vert = mesh.mvert[i];
+            MVert &new_vert = new_mesh->mvert[task.vert_offset + i];
+
+            new_vert = old_vert;
+
+            const float3 new_position = transform * float3(old_vert.co);
+            copy_v3_v3(new_vert.co, new_position);
+          }
+          for (const int i : IndexRange(mesh.totedge)) {
+            const MEdge &old_edge = mesh.medge[i];
+            MEdge &new_edge = new_mesh->medge[task.edge_offset + i];
+            new_edge = old_edge;
+            new_edge.v1 += task.vert_offset;
+            new_edge.v2 += task.vert_offset;
+          }
+          for (const int i : IndexRange(mesh.totloop)) {
+            const MLoop &old_loop = mesh.mloop[i];
+            MLoop &new_loop = new_mesh->mloop[task.loop_offset + i];
+            new_loop = old_loop;
+            new_loop.v += task.vert_offset;
+            new_loop.e += task.edge_offset;
+          }
+          for (const int i : IndexRange(mesh.totpoly)) {
+            const MPoly &old_poly = mesh.mpoly[i];
+            MPoly &new_poly = new_mesh->mpoly[task.poly_offset + i];
+            new_poly = old_poly;
+            new_poly.loopstart += task.loop_offset;
+            if (old_poly.mat_nr >= 0 && old_poly.mat_nr < mesh.totcol) {
+              new_poly.mat_nr = material_index_map[new_poly.mat_nr];
+            }
+            else {
+              /* The material index was invalid before. */
+              new_poly.mat_nr = 0;
+            }
+          }
+        }
+      },
+      [&](const int task_index) -> int64_t {
+        const MeshRealizeTask &task = tasks[task_index];
+        if (task.pointcloud != nullptr) {
+          return task.pointcloud->totpoint;
+        }
+        return task.mesh->totvert + task.mesh->totedge + task.mesh->totloop + task.mesh->totpoly;
+      });
+
   /* A possible optimization is to only tag the normals dirty when there are transforms that change
    * normals. */
   BKE_mesh_normals_tag_dirty(new_mesh);
@@ -394,6 +454,16 @@ static void join_attributes(Span<GeometryInstanceGroup> set_groups,
 
     fn::GVMutableArray_GSpan dst_span{*write_attribute.varray};
 
+    /* Gather the source arrays and their offsets first, so that they can be copied in parallel. */
+    struct AttributeCopyTask {
+      const void *src_buffer;
+      int64_t offset;
+      int64_t size;
+    };
+    Vector<AttributeCopyTask> tasks;
+    Vector<GVArrayPtr> source_attributes;
+    Vector<std::unique_ptr<fn::GVArray_GSpan>> source_spans;
+
     int offset = 0;
     for (const GeometryInstanceGroup &set_group : set_groups) {
       const GeometrySet &set = set_group.geometry_set;
@@ -408,11 +478,11 @@ static void join_attributes(Span<GeometryInstanceGroup> set_groups,
               attribute_id, domain_output, data_type_output);
 
           if (source_attribute) {
-            fn::GVArray_GSpan src_span{*source_attribute};
-            const void *src_buffer = src_span.data();
+            source_spans.append(std::make_unique<fn::GVArray_GSpan>(*source_attribute));
+            const fn::GVArray_GSpan &src_span = *source_spans.last();
+            source_attributes.append(std::move(source_attribute));
             for (const int UNUSED(i) : set_group.transforms.index_range()) {
-              void *dst_buffer = dst_span[offset];
-              cpp_type->copy_assign_n(src_buffer, dst_buffer, domain_size);
+              tasks.append({src_span.data(), offset, domain_size});
               offset += domain_size;
             }
           }
@@ -423,6 +493,16 @@ static void join_attributes(Span<GeometryInstanceGroup> set_groups,
       }
     }
 
+    threading::parallel_for_weighted(
+        tasks.index_range(),
+        4096,
+        [&](const IndexRange range) {
+          for (const AttributeCopyTask &task : tasks.as_span().slice(range)) {
+            cpp_type->copy_assign_n(task.src_buffer, dst_span[task.offset], task.size);
+          }
+        },
+        [&](const int task_index) { return tasks[task_index].size; });
+
     dst_span.save();
   }
 }
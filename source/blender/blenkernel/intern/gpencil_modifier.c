@@ -29,6 +29,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -709,11 +710,44 @@ static void gpencil_assign_object_eval(Object *object)
   }
 }
 
+typedef struct GpencilFrameCopyData {
+  bGPDframe **frames_orig;
+  bGPDframe **frames_eval;
+} GpencilFrameCopyData;
+
+static void gpencil_copy_activeframe_to_eval_cb(void *__restrict userdata,
+                                                const int i,
+                                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  GpencilFrameCopyData *data = (GpencilFrameCopyData *)userdata;
+  bGPDframe *gpf_orig = data->frames_orig[i];
+  bGPDframe *gpf_eval = data->frames_eval[i];
+
+  /* Delete old strokes. */
+  BKE_gpencil_free_strokes(gpf_eval);
+  /* Copy again strokes. */
+  BKE_gpencil_frame_copy_strokes(gpf_orig, gpf_eval);
+
+  gpf_eval->runtime.gpf_orig = (bGPDframe *)gpf_orig;
+  BKE_gpencil_frame_original_pointers_update(gpf_orig, gpf_eval);
+}
+
 /* Helper: Copy active frame from original datablock to evaluated datablock for modifiers. */
 static void gpencil_copy_activeframe_to_eval(
     Depsgraph *depsgraph, Scene *scene, Object *ob, bGPdata *gpd_orig, bGPdata *gpd_eval)
 {
+  const int layers_len = BLI_listbase_count(&gpd_orig->layers);
+  if (layers_len == 0) {
+    return;
+  }
+
+  GpencilFrameCopyData data = {
+      .frames_orig = MEM_malloc_arrayN(layers_len, sizeof(bGPDframe *), __func__),
+      .frames_eval = MEM_malloc_arrayN(layers_len, sizeof(bGPDframe *), __func__),
+  };
+  int frames_len = 0;
 
+  /* Find the frames to copy first, the copies of different layers are independent. */
   bGPDlayer *gpl_eval = gpd_eval->layers.first;
   LISTBASE_FOREACH (bGPDlayer *, gpl_orig, &gpd_orig->layers) {
 
@@ -730,19 +764,23 @@ static void gpencil_copy_activeframe_to_eval(
         bGPDframe *gpf_eval = BLI_findlink(&gpl_eval->frames, gpf_index);
 
         if (gpf_eval != NULL) {
-          /* Delete old strokes. */
-          BKE_gpencil_free_strokes(gpf_eval);
-          /* Copy again strokes. */
-          BKE_gpencil_frame_copy_strokes(gpf_orig, gpf_eval);
-
-          gpf_eval->runtime.gpf_orig = (bGPDframe *)gpf_orig;
-          BKE_gpencil_frame_original_pointers_update(gpf_orig, gpf_eval);
+          data.frames_orig[frames_len] = gpf_orig;
+          data.frames_eval[frames_len] = gpf_eval;
+          frames_len++;
         }
       }
 
       gpl_eval = gpl_eval->next;
     }
   }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, frames_len, &data, gpencil_copy_activeframe_to_eval_cb, &settings);
+
+  MEM_freeN(data.frames_orig);
+  MEM_freeN(data.frames_eval);
 }
 
 static bGPdata *gpencil_copy_for_eval(bGPdata *gpd)
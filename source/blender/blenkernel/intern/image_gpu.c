@@ -610,11 +610,90 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+static size_t image_gpu_memory_size(const Image *ima)
+{
+  size_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      for (int resolution = 0; resolution < IMA_TEXTURE_RESOLUTION_LEN; resolution++) {
+        if (ima->gputexture[i][eye][resolution] != NULL) {
+          size += GPU_texture_memory_size(ima->gputexture[i][eye][resolution]);
+        }
+      }
+    }
+  }
+  return size;
+}
+
+typedef struct ImageGPUUsage {
+  Image *ima;
+  size_t size;
+} ImageGPUUsage;
+
+static int compare_image_gpu_usage(const void *a, const void *b)
+{
+  const ImageGPUUsage *usage_a = a;
+  const ImageGPUUsage *usage_b = b;
+  return usage_a->ima->lastused - usage_b->ima->lastused;
+}
+
+/**
+ * Free the textures of the least recently used images until the textures fit in
+ * #UserDef.texmemlimit. Images that were displayed during the last seconds are kept.
+ */
+static void image_free_gpu_over_limit(Main *bmain, const int ctime)
+{
+  if (U.texmemlimit == 0) {
+    return;
+  }
+  const size_t limit = (size_t)U.texmemlimit * 1024 * 1024;
+
+  size_t total_size = 0;
+  int candidates_len = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    const size_t size = image_gpu_memory_size(ima);
+    total_size += size;
+    if (size != 0 && (ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime - 1) {
+      candidates_len++;
+    }
+  }
+  if (total_size <= limit || candidates_len == 0) {
+    return;
+  }
+
+  ImageGPUUsage *candidates = MEM_mallocN(sizeof(*candidates) * candidates_len, __func__);
+  int i = 0;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    if ((ima->flag & IMA_NOCOLLECT) == 0 && ima->lastused < ctime - 1) {
+      const size_t size = image_gpu_memory_size(ima);
+      if (size != 0) {
+        candidates[i].ima = ima;
+        candidates[i].size = size;
+        i++;
+      }
+    }
+  }
+  qsort(candidates, candidates_len, sizeof(*candidates), compare_image_gpu_usage);
+
+  for (i = 0; i < candidates_len && total_size > limit; i++) {
+    BKE_image_free_gputextures(candidates[i].ima);
+    total_size -= candidates[i].size;
+  }
+  MEM_freeN(candidates);
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
   int ctime = (int)PIL_check_seconds_timer();
 
+  /* of course not! */
+  if (G.is_rendering) {
+    return;
+  }
+
+  image_free_gpu_over_limit(bmain, ctime);
+
   /*
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
@@ -623,11 +702,6 @@ void BKE_image_free_old_gputextures(Main *bmain)
     return;
   }
 
-  /* of course not! */
-  if (G.is_rendering) {
-    return;
-  }
-
   lasttime = ctime;
 
   LISTBASE_FOREACH (Image *, ima, &bmain->images) {
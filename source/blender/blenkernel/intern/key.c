@@ -31,6 +31,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_math_vector.h"
 #include "BLI_string_utils.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.h"
@@ -877,6 +878,146 @@ static void cp_cu_key(Curve *cu,
   }
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Relative Coordinate Keys
+ *
+ * Mesh and lattice shape keys only contain coordinates, so they are blended as typed float3
+ * arrays in parallel over blocks of elements, instead of walking the element string of every
+ * element for every key block.
+ * \{ */
+
+/* Number of key elements blended by one task, to apply all the key blocks to a block of elements
+ * which fits in cache. */
+#define KEY_RELATIVE_COORDS_BLOCK_SIZE 1024
+
+typedef struct KeyRelativeCoordsBlock {
+  const float (*from)[3];
+  const float (*reffrom)[3];
+  const float *weights;
+  float icuval;
+  char *freefrom;
+} KeyRelativeCoordsBlock;
+
+typedef struct KeyRelativeCoordsData {
+  float (*out)[3];
+  const KeyRelativeCoordsBlock *blocks;
+  int blocks_len;
+  int start;
+  int end;
+} KeyRelativeCoordsData;
+
+static bool key_evaluate_relative_coords_supported(const Key *key,
+                                                   const int mode,
+                                                   const int poinsize,
+                                                   const int step)
+{
+  return (mode != KEY_MODE_BEZTRIPLE && step == 1 && key->elemstr[0] == 1 &&
+          key->elemstr[1] == IPO_FLOAT && key->elemstr[2] == 0 &&
+          key->elemsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]) &&
+          poinsize == sizeof(float[KEYELEM_FLOAT_LEN_COORD]));
+}
+
+static void key_evaluate_relative_coords_task(void *__restrict userdata,
+                                              const int block_index,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const KeyRelativeCoordsData *data = userdata;
+  const int block_start = data->start + block_index * KEY_RELATIVE_COORDS_BLOCK_SIZE;
+  const int block_end = min_ii(block_start + KEY_RELATIVE_COORDS_BLOCK_SIZE, data->end);
+  float(*out)[3] = data->out;
+
+  /* Apply the key blocks in the same order as the generic code path, so the result matches. */
+  for (int i = 0; i < data->blocks_len; i++) {
+    const KeyRelativeCoordsBlock *block = &data->blocks[i];
+    const float(*from)[3] = block->from;
+    const float(*reffrom)[3] = block->reffrom;
+    const float icuval = block->icuval;
+    if (block->weights) {
+      /* Weights are indexed from the first evaluated element. */
+      const float *weights = block->weights - data->start;
+      for (int b = block_start; b < block_end; b++) {
+        const float weight = weights[b] * icuval;
+        if (weight != 0.0f) {
+          out[b][0] -= weight * (reffrom[b][0] - from[b][0]);
+          out[b][1] -= weight * (reffrom[b][1] - from[b][1]);
+          out[b][2] -= weight * (reffrom[b][2] - from[b][2]);
+        }
+      }
+    }
+    else {
+      for (int b = block_start; b < block_end; b++) {
+        out[b][0] -= icuval * (reffrom[b][0] - from[b][0]);
+        out[b][1] -= icuval * (reffrom[b][1] - from[b][1]);
+        out[b][2] -= icuval * (reffrom[b][2] - from[b][2]);
+      }
+    }
+  }
+}
+
+/**
+ * Blend relative coordinate key blocks on top of the basis already copied to \a basispoin.
+ */
+static void key_evaluate_relative_coords(const int start,
+                                         const int end,
+                                         const int tot,
+                                         char *basispoin,
+                                         Key *key,
+                                         KeyBlock *actkb,
+                                         float **per_keyblock_weights)
+{
+  KeyRelativeCoordsBlock *blocks = MEM_malloc_arrayN(
+      key->totkey, sizeof(*blocks), "KeyRelativeCoordsBlock");
+  int blocks_len = 0;
+  int keyblock_index = 0;
+
+  /* Gather the key blocks which contribute, skipping muted and zero value ones up-front. */
+  LISTBASE_FOREACH_INDEX (KeyBlock *, kb, &key->block, keyblock_index) {
+    if (kb == key->refkey) {
+      continue;
+    }
+    if ((kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f || kb->totelem != tot) {
+      continue;
+    }
+    /* reference now can be any block */
+    KeyBlock *refb = BLI_findlink(&key->block, kb->relative);
+    if (refb == NULL) {
+      continue;
+    }
+    KeyRelativeCoordsBlock *block = &blocks[blocks_len++];
+    block->from = (const float(*)[3])key_block_get_data(key, actkb, kb, &block->freefrom);
+    /* For meshes, use the original values instead of the bmesh values to
+     * maintain a constant offset. */
+    block->reffrom = refb->data;
+    block->weights = per_keyblock_weights ? per_keyblock_weights[keyblock_index] : NULL;
+    block->icuval = kb->curval;
+  }
+
+  if (blocks_len != 0 && end > start) {
+    KeyRelativeCoordsData data = {
+        .out = (float(*)[3])basispoin,
+        .blocks = blocks,
+        .blocks_len = blocks_len,
+        .start = start,
+        .end = end,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (end - start) > KEY_RELATIVE_COORDS_BLOCK_SIZE;
+    BLI_task_parallel_range(0,
+                            divide_ceil_u(end - start, KEY_RELATIVE_COORDS_BLOCK_SIZE),
+                            &data,
+                            key_evaluate_relative_coords_task,
+                            &settings);
+  }
+
+  for (int i = 0; i < blocks_len; i++) {
+    MEM_SAFE_FREE(blocks[i].freefrom);
+  }
+  MEM_freeN(blocks);
+}
+
+/** \} */
+
 static void key_evaluate_relative(const int start,
                                   int end,
                                   const int tot,
@@ -915,6 +1056,11 @@ static void key_evaluate_relative(const int start,
 
   /* step 2: do it */
 
+  if (key_evaluate_relative_coords_supported(key, mode, poinsize, step)) {
+    key_evaluate_relative_coords(start, end, tot, basispoin, key, actkb, per_keyblock_weights);
+    return;
+  }
+
   for (kb = key->block.first, keyblock_index = 0; kb; kb = kb->next, keyblock_index++) {
     if (kb != key->refkey) {
       float icuval = kb->curval;
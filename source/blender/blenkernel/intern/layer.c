@@ -76,6 +76,7 @@ static const short g_base_collection_flags = (BASE_VISIBLE_DEPSGRAPH | BASE_VISI
 
 /* prototype */
 static void object_bases_iterator_next(BLI_Iterator *iter, const int flag);
+static void layer_collection_local_sync_scene(const Main *bmain, const Scene *scene);
 
 /*********************** Layer Collections and bases *************************/
 
@@ -395,6 +396,27 @@ static void view_layer_bases_hash_create(ViewLayer *view_layer)
   }
 }
 
+/**
+ * Refill an existing object to base hash from the current bases, e.g. after object pointers were
+ * remapped. Keeps the allocated buckets, which avoids growing the hash again one insertion at a
+ * time for view layers with many objects.
+ */
+static void view_layer_bases_hash_refill(ViewLayer *view_layer)
+{
+  GHash *hash = view_layer->object_bases_hash;
+  BLI_ghash_clear_ex(hash, NULL, NULL, BLI_ghash_len(hash));
+
+  LISTBASE_FOREACH (Base *, base, &view_layer->object_bases) {
+    if (base->object) {
+      /* Same as in #view_layer_bases_hash_create, duplicates are cleaned up on next sync. */
+      void **val_pp;
+      if (!BLI_ghash_ensure_p(hash, base->object, &val_pp)) {
+        *val_pp = base;
+      }
+    }
+  }
+}
+
 Base *BKE_view_layer_base_find(ViewLayer *view_layer, Object *ob)
 {
   if (!view_layer->object_bases_hash) {
@@ -1343,6 +1365,46 @@ void BKE_main_collection_sync(const Main *bmain)
   BKE_layer_collection_local_sync_all(bmain);
 }
 
+static void collection_tag_scene_sync_recursive(Collection *collection, const bool tag)
+{
+  if (((collection->tag & COLLECTION_TAG_SCENE_SYNC) != 0) == tag) {
+    /* Already visited through another parent. */
+    return;
+  }
+  SET_FLAG_FROM_TEST(collection->tag, tag, COLLECTION_TAG_SCENE_SYNC);
+
+  LISTBASE_FOREACH (CollectionParent *, cparent, &collection->parents) {
+    collection_tag_scene_sync_recursive(cparent->collection, tag);
+  }
+}
+
+/**
+ * Same as #BKE_main_collection_sync, but only update the view layers of scenes which use
+ * \a collection, directly or through one of its parents. Meant for changes local to a single
+ * collection, like linking or unlinking objects or children, where the other scenes of \a bmain
+ * are unaffected.
+ */
+void BKE_main_collection_sync_from_collection(const Main *bmain, Collection *collection)
+{
+  if (no_resync) {
+    return;
+  }
+
+  /* Walk up the parents once to find all the master collections in reach, instead of searching
+   * the whole hierarchy of every scene for \a collection. */
+  collection_tag_scene_sync_recursive(collection, true);
+
+  for (const Scene *scene = bmain->scenes.first; scene; scene = scene->id.next) {
+    if (scene->master_collection &&
+        (scene->master_collection->tag & COLLECTION_TAG_SCENE_SYNC) != 0) {
+      BKE_scene_collection_sync(scene);
+      layer_collection_local_sync_scene(bmain, scene);
+    }
+  }
+
+  collection_tag_scene_sync_recursive(collection, false);
+}
+
 void BKE_main_collection_sync_remap(const Main *bmain)
 {
   if (no_resync) {
@@ -1356,9 +1418,10 @@ void BKE_main_collection_sync_remap(const Main *bmain)
     LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
       MEM_SAFE_FREE(view_layer->object_bases_array);
 
+      /* Object pointers of bases may have changed, refill the hash rather than freeing it so it
+       * does not have to be rebuilt from scratch by the next lookup. */
       if (view_layer->object_bases_hash) {
-        BLI_ghash_free(view_layer->object_bases_hash, NULL, NULL);
-        view_layer->object_bases_hash = NULL;
+        view_layer_bases_hash_refill(view_layer);
       }
     }
 
@@ -1667,6 +1730,23 @@ void BKE_layer_collection_local_sync(ViewLayer *view_layer, const View3D *v3d)
   }
 }
 
+static void layer_collection_local_sync_scene(const Main *bmain, const Scene *scene)
+{
+  LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
+    LISTBASE_FOREACH (bScreen *, screen, &bmain->screens) {
+      LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
+        if (area->spacetype != SPACE_VIEW3D) {
+          continue;
+        }
+        View3D *v3d = area->spacedata.first;
+        if (v3d->flag & V3D_LOCAL_COLLECTIONS) {
+          BKE_layer_collection_local_sync(view_layer, v3d);
+        }
+      }
+    }
+  }
+}
+
 /**
  * Sync the local collection for all the 3D Viewports.
  */
@@ -1677,19 +1757,7 @@ void BKE_layer_collection_local_sync_all(const Main *bmain)
   }
 
   LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
-    LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
-      LISTBASE_FOREACH (bScreen *, screen, &bmain->screens) {
-        LISTBASE_FOREACH (ScrArea *, area, &screen->areabase) {
-          if (area->spacetype != SPACE_VIEW3D) {
-            continue;
-          }
-          View3D *v3d = area->spacedata.first;
-          if (v3d->flag & V3D_LOCAL_COLLECTIONS) {
-            BKE_layer_collection_local_sync(view_layer, v3d);
-          }
-        }
-      }
-    }
+    layer_collection_local_sync_scene(bmain, scene);
   }
 }
 
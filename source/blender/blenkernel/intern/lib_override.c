@@ -1285,32 +1285,36 @@ bool BKE_lib_override_library_resync(Main *bmain,
   FOREACH_MAIN_LISTBASE_END;
 
   /* We need to remap old to new override usages in a separate loop, after all new overrides have
-   * been added to Main. */
+   * been added to Main. All of them are remapped at once, so that ID usages are only checked once
+   * instead of once per override. */
+  GHash *old_to_new_override = BLI_ghash_ptr_new(__func__);
   FOREACH_MAIN_ID_BEGIN (bmain, id) {
     if (id->tag & LIB_TAG_DOIT && id->newid != NULL && id->lib == id_root_reference->lib) {
       ID *id_override_new = id->newid;
       ID *id_override_old = BLI_ghash_lookup(linkedref_to_old_override, id);
 
       if (id_override_old != NULL) {
-        /* Remap all IDs to use the new override. */
-        BKE_libblock_remap(bmain, id_override_old, id_override_new, 0);
-        /* Remap no-main override IDs we just created too. */
-        GHashIterator linkedref_to_old_override_iter;
-        GHASH_ITER (linkedref_to_old_override_iter, linkedref_to_old_override) {
-          ID *id_override_old_iter = BLI_ghashIterator_getValue(&linkedref_to_old_override_iter);
-          if (id_override_old_iter->tag & LIB_TAG_NO_MAIN) {
-            BKE_libblock_relink_ex(bmain,
-                                   id_override_old_iter,
-                                   id_override_old,
-                                   id_override_new,
-                                   ID_REMAP_FORCE_USER_REFCOUNT | ID_REMAP_FORCE_NEVER_NULL_USAGE);
-          }
-        }
+        BLI_ghash_insert(old_to_new_override, id_override_old, id_override_new);
       }
     }
   }
   FOREACH_MAIN_ID_END;
 
+  /* Remap all IDs to use the new overrides. */
+  BKE_libblock_remap_multiple(bmain, old_to_new_override, 0);
+  /* Remap no-main override IDs we just created too. */
+  GHashIterator linkedref_to_old_override_iter;
+  GHASH_ITER (linkedref_to_old_override_iter, linkedref_to_old_override) {
+    ID *id_override_old_iter = BLI_ghashIterator_getValue(&linkedref_to_old_override_iter);
+    if (id_override_old_iter->tag & LIB_TAG_NO_MAIN) {
+      BKE_libblock_relink_multiple(bmain,
+                                   id_override_old_iter,
+                                   old_to_new_override,
+                                   ID_REMAP_FORCE_USER_REFCOUNT | ID_REMAP_FORCE_NEVER_NULL_USAGE);
+    }
+  }
+  BLI_ghash_free(old_to_new_override, NULL, NULL);
+
   BKE_main_collection_sync(bmain);
 
   /* We need to apply override rules in a separate loop, after all ID pointers have been properly
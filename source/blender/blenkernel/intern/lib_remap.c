@@ -22,6 +22,9 @@
 
 #include "CLG_log.h"
 
+#include "MEM_guardedalloc.h"
+
+#include "BLI_ghash.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_collection_types.h"
@@ -30,6 +33,7 @@
 #include "BKE_armature.h"
 #include "BKE_collection.h"
 #include "BKE_curve.h"
+#include "BKE_idtype.h"
 #include "BKE_layer.h"
 #include "BKE_lib_id.h"
 #include "BKE_lib_query.h"
@@ -70,6 +74,11 @@ typedef struct IDRemap {
   ID *new_id;
   /** The ID in which we are replacing old_id by new_id usages. */
   ID *id_owner;
+  /**
+   * When remapping several IDs in a single pass, map from each old ID to its own #IDRemap item,
+   * which holds its new ID and output data. `old_id` and `new_id` are unused then.
+   */
+  GHash *remap_items;
   short flag;
 
   /* 'Output' data. */
@@ -103,14 +112,23 @@ static int foreach_libblock_remap_callback(LibraryIDLinkCallbackData *cb_data)
   ID *id_self = cb_data->id_self;
   ID **id_p = cb_data->id_pointer;
   IDRemap *id_remap_data = cb_data->user_data;
-  ID *old_id = id_remap_data->old_id;
-  ID *new_id = id_remap_data->new_id;
 
   /* Those asserts ensure the general sanity of ID tags regarding 'embedded' ID data (root
    * nodetrees and co). */
   BLI_assert(id_owner == id_remap_data->id_owner);
   BLI_assert(id_self == id_owner || (id_self->flag & LIB_EMBEDDED_DATA) != 0);
 
+  if (id_remap_data->remap_items != NULL) {
+    /* Remapping several IDs at once, use the item of the ID used here, if it is remapped. */
+    id_remap_data = (*id_p != NULL) ? BLI_ghash_lookup(id_remap_data->remap_items, *id_p) : NULL;
+    if (id_remap_data == NULL) {
+      return IDWALK_RET_NOP;
+    }
+  }
+
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
+
   if (!old_id) { /* Used to cleanup all IDs used by a specific one. */
     BLI_assert(!new_id);
     old_id = *id_p;
@@ -244,6 +262,17 @@ static void libblock_remap_data_preprocess(IDRemap *r_id_remap_data)
   switch (GS(r_id_remap_data->id_owner->name)) {
     case ID_OB: {
       ID *old_id = r_id_remap_data->old_id;
+      if (r_id_remap_data->remap_items != NULL) {
+        /* Only the remapping of the object's own data matters here. */
+        Object *ob = (Object *)r_id_remap_data->id_owner;
+        old_id = (ob->data != NULL &&
+                  BLI_ghash_haskey(r_id_remap_data->remap_items, ob->data)) ?
+                     ob->data :
+                     NULL;
+        if (old_id == NULL) {
+          break;
+        }
+      }
       if (!old_id || GS(old_id->name) == ID_AR) {
         Object *ob = (Object *)r_id_remap_data->id_owner;
         /* Object's pose holds reference to armature bones. sic */
@@ -348,6 +377,53 @@ static void libblock_remap_data_postprocess_nodetree_update(Main *bmain, ID *new
   ntreeUpdateAllUsers(bmain, new_id, 0);
 }
 
+static int libblock_remap_foreach_id_flags(const short remap_flags)
+{
+  return ((remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
+              IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
+              IDWALK_NOP) |
+         ((remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0 ?
+              IDWALK_DO_INTERNAL_RUNTIME_POINTERS :
+              IDWALK_NOP);
+}
+
+/**
+ * Update user counts and linking status of the old and new IDs, once all their usages have been
+ * processed.
+ */
+static void libblock_remap_data_users_update(IDRemap *id_remap_data)
+{
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
+
+  if ((id_remap_data->flag & ID_REMAP_SKIP_USER_CLEAR) == 0) {
+    /* XXX We may not want to always 'transfer' fake-user from old to new id...
+     *     Think for now it's desired behavior though,
+     *     we can always add an option (flag) to control this later if needed. */
+    if (old_id && (old_id->flag & LIB_FAKEUSER)) {
+      id_fake_user_clear(old_id);
+      id_fake_user_set(new_id);
+    }
+
+    id_us_clear_real(old_id);
+  }
+
+  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
+      (id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
+    new_id->tag &= ~LIB_TAG_INDIRECT;
+    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
+    new_id->tag |= LIB_TAG_EXTERN;
+  }
+
+#ifdef DEBUG_PRINT
+  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
+         __func__,
+         id_remap_data->skipped_direct + id_remap_data->skipped_indirect,
+         id_remap_data->skipped_direct,
+         id_remap_data->skipped_indirect);
+#endif
+}
+
 /**
  * Execute the 'data' part of the remapping (that is, all ID pointers from other ID data-blocks).
  *
@@ -375,12 +451,7 @@ static void libblock_remap_data(
     Main *bmain, ID *id, ID *old_id, ID *new_id, const short remap_flags, IDRemap *r_id_remap_data)
 {
   IDRemap id_remap_data;
-  const int foreach_id_flags = ((remap_flags & ID_REMAP_NO_INDIRECT_PROXY_DATA_USAGE) != 0 ?
-                                    IDWALK_NO_INDIRECT_PROXY_DATA_USAGE :
-                                    IDWALK_NOP) |
-                               ((remap_flags & ID_REMAP_FORCE_INTERNAL_RUNTIME_POINTERS) != 0 ?
-                                    IDWALK_DO_INTERNAL_RUNTIME_POINTERS :
-                                    IDWALK_NOP);
+  const int foreach_id_flags = libblock_remap_foreach_id_flags(remap_flags);
 
   if (r_id_remap_data == NULL) {
     r_id_remap_data = &id_remap_data;
@@ -389,6 +460,7 @@ static void libblock_remap_data(
   r_id_remap_data->old_id = old_id;
   r_id_remap_data->new_id = new_id;
   r_id_remap_data->id_owner = NULL;
+  r_id_remap_data->remap_items = NULL;
   r_id_remap_data->flag = remap_flags;
   r_id_remap_data->status = 0;
   r_id_remap_data->skipped_direct = 0;
@@ -427,51 +499,103 @@ static void libblock_remap_data(
     FOREACH_MAIN_ID_END;
   }
 
-  if ((remap_flags & ID_REMAP_SKIP_USER_CLEAR) == 0) {
-    /* XXX We may not want to always 'transfer' fake-user from old to new id...
-     *     Think for now it's desired behavior though,
-     *     we can always add an option (flag) to control this later if needed. */
-    if (old_id && (old_id->flag & LIB_FAKEUSER)) {
-      id_fake_user_clear(old_id);
-      id_fake_user_set(new_id);
+  libblock_remap_data_users_update(r_id_remap_data);
+}
+
+/**
+ * Same as #libblock_remap_data, but remaps all the old IDs of \a items_num \a items in a single
+ * pass over the ID pointers, instead of one pass per old ID.
+ *
+ * \param id: the data-block to operate on, or NULL to operate over all IDs from \a bmain.
+ * \param items: the remap items, with their `old_id` and `new_id` set, and other data is
+ * initialized here. Old IDs must be unique and non-NULL.
+ */
+ATTR_NONNULL(1, 3)
+static void libblock_remap_data_multiple(
+    Main *bmain, ID *id, IDRemap *items, const int items_num, const short remap_flags)
+{
+  const int foreach_id_flags = libblock_remap_foreach_id_flags(remap_flags);
+
+  IDRemap id_remap_data = {
+      .bmain = bmain,
+      .remap_items = BLI_ghash_ptr_new_ex(__func__, (uint)items_num),
+      .flag = remap_flags,
+  };
+
+  /* Types of the remapped IDs, used to skip IDs which cannot use any of them. */
+  bool id_types_used[INDEX_ID_MAX] = {false};
+  short id_types[INDEX_ID_MAX];
+  int id_types_num = 0;
+
+  for (int i = 0; i < items_num; i++) {
+    IDRemap *item = &items[i];
+    BLI_assert(item->old_id != NULL);
+    BLI_assert((item->new_id == NULL) || GS(item->old_id->name) == GS(item->new_id->name));
+    BLI_assert(item->old_id != item->new_id);
+
+    item->bmain = bmain;
+    item->id_owner = NULL;
+    item->remap_items = NULL;
+    item->flag = remap_flags;
+    item->status = 0;
+    item->skipped_direct = 0;
+    item->skipped_indirect = 0;
+    item->skipped_refcounted = 0;
+    BLI_ghash_insert(id_remap_data.remap_items, item->old_id, item);
+
+    const short id_type = GS(item->old_id->name);
+    const int id_type_index = BKE_idtype_idcode_to_index(id_type);
+    if (!id_types_used[id_type_index]) {
+      id_types_used[id_type_index] = true;
+      id_types[id_types_num++] = id_type;
     }
+  }
 
-    id_us_clear_real(old_id);
+  if (id) {
+    id_remap_data.id_owner = id;
+    libblock_remap_data_preprocess(&id_remap_data);
+    BKE_library_foreach_ID_link(
+        NULL, id, foreach_libblock_remap_callback, (void *)&id_remap_data, foreach_id_flags);
   }
+  else {
+    ID *id_curr;
 
-  if (new_id && (new_id->tag & LIB_TAG_INDIRECT) &&
-      (r_id_remap_data->status & ID_REMAP_IS_LINKED_DIRECT)) {
-    new_id->tag &= ~LIB_TAG_INDIRECT;
-    new_id->flag &= ~LIB_INDIRECT_WEAK_LINK;
-    new_id->tag |= LIB_TAG_EXTERN;
+    FOREACH_MAIN_ID_BEGIN (bmain, id_curr) {
+      bool can_use_id_type = false;
+      for (int i = 0; i < id_types_num && !can_use_id_type; i++) {
+        can_use_id_type = BKE_library_id_can_use_idtype(id_curr, id_types[i]);
+      }
+      if (can_use_id_type) {
+        id_remap_data.id_owner = id_curr;
+        libblock_remap_data_preprocess(&id_remap_data);
+        BKE_library_foreach_ID_link(NULL,
+                                    id_curr,
+                                    foreach_libblock_remap_callback,
+                                    (void *)&id_remap_data,
+                                    foreach_id_flags);
+      }
+    }
+    FOREACH_MAIN_ID_END;
   }
 
-#ifdef DEBUG_PRINT
-  printf("%s: %d occurrences skipped (%d direct and %d indirect ones)\n",
-         __func__,
-         r_id_remap_data->skipped_direct + r_id_remap_data->skipped_indirect,
-         r_id_remap_data->skipped_direct,
-         r_id_remap_data->skipped_indirect);
-#endif
+  BLI_ghash_free(id_remap_data.remap_items, NULL, NULL);
+
+  for (int i = 0; i < items_num; i++) {
+    libblock_remap_data_users_update(&items[i]);
+  }
 }
 
 /**
- * Replace all references in given Main to \a old_id by \a new_id
- * (if \a new_id is NULL, it unlinks \a old_id).
+ * Final handling of \a old_id once all its usages in Main have been remapped: notify editors and
+ * update its user count and linking status.
  */
-void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+static void libblock_remap_old_id_finalize(IDRemap *id_remap_data)
 {
-  IDRemap id_remap_data;
-  ID *old_id = old_idv;
-  ID *new_id = new_idv;
+  ID *old_id = id_remap_data->old_id;
+  ID *new_id = id_remap_data->new_id;
+  const short remap_flags = id_remap_data->flag;
   int skipped_direct, skipped_refcounted;
 
-  BLI_assert(old_id != NULL);
-  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
-  BLI_assert(old_id != new_id);
-
-  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
-
   if (free_notifier_reference_cb) {
     free_notifier_reference_cb(old_id);
   }
@@ -483,15 +607,15 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
     remap_editor_id_reference_cb(old_id, new_id);
   }
 
-  skipped_direct = id_remap_data.skipped_direct;
-  skipped_refcounted = id_remap_data.skipped_refcounted;
+  skipped_direct = id_remap_data->skipped_direct;
+  skipped_refcounted = id_remap_data->skipped_refcounted;
 
   if ((remap_flags & ID_REMAP_SKIP_USER_CLEAR) == 0) {
     /* If old_id was used by some ugly 'user_one' stuff (like Image or Clip editors...), and user
      * count has actually been incremented for that, we have to decrease once more its user
      * count... unless we had to skip some 'user_one' cases. */
     if ((old_id->tag & LIB_TAG_EXTRAUSER_SET) &&
-        !(id_remap_data.status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
+        !(id_remap_data->status & ID_REMAP_IS_USER_ONE_SKIPPED)) {
       id_us_clear_real(old_id);
     }
   }
@@ -515,6 +639,25 @@ void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const
       old_id->tag |= LIB_TAG_INDIRECT;
     }
   }
+}
+
+/**
+ * Replace all references in given Main to \a old_id by \a new_id
+ * (if \a new_id is NULL, it unlinks \a old_id).
+ */
+void BKE_libblock_remap_locked(Main *bmain, void *old_idv, void *new_idv, const short remap_flags)
+{
+  IDRemap id_remap_data;
+  ID *old_id = old_idv;
+  ID *new_id = new_idv;
+
+  BLI_assert(old_id != NULL);
+  BLI_assert((new_id == NULL) || GS(old_id->name) == GS(new_id->name));
+  BLI_assert(old_id != new_id);
+
+  libblock_remap_data(bmain, NULL, old_id, new_id, remap_flags, &id_remap_data);
+
+  libblock_remap_old_id_finalize(&id_remap_data);
 
   /* Some after-process updates.
    * This is a bit ugly, but cannot see a way to avoid it.
@@ -564,6 +707,140 @@ void BKE_libblock_remap(Main *bmain, void *old_idv, void *new_idv, const short r
   BKE_main_unlock(bmain);
 }
 
+/**
+ * Build the remap items from a map of old to new IDs, returns NULL if there is nothing to remap.
+ */
+static IDRemap *libblock_remap_items_from_map(GHash *old_to_new, int *r_items_num)
+{
+  *r_items_num = (int)BLI_ghash_len(old_to_new);
+  if (*r_items_num == 0) {
+    return NULL;
+  }
+
+  IDRemap *items = MEM_calloc_arrayN((size_t)*r_items_num, sizeof(*items), __func__);
+  int i = 0;
+  GHashIterator gh_iter;
+  GHASH_ITER (gh_iter, old_to_new) {
+    items[i].old_id = BLI_ghashIterator_getKey(&gh_iter);
+    items[i].new_id = BLI_ghashIterator_getValue(&gh_iter);
+    i++;
+  }
+
+  return items;
+}
+
+/**
+ * Same as the object and collection cases of the after-process updates of
+ * #BKE_libblock_remap_locked, but done once for all remapped IDs.
+ *
+ * \param owner_collection: The only collection affected by the remapping, when known.
+ */
+static void libblock_remap_data_postprocess_multiple_collections_update(
+    Main *bmain, Collection *owner_collection, const IDRemap *items, const int items_num)
+{
+  bool is_object_remapped = false, is_object_unlinked = false;
+  bool is_collection_remapped = false, is_collection_unlinked = false;
+
+  for (int i = 0; i < items_num; i++) {
+    switch (GS(items[i].old_id->name)) {
+      case ID_OB:
+        is_object_remapped = true;
+        is_object_unlinked |= (items[i].new_id == NULL);
+        break;
+      case ID_GR:
+        is_collection_remapped |= (items[i].new_id != NULL);
+        is_collection_unlinked |= (items[i].new_id == NULL);
+        break;
+      default:
+        break;
+    }
+  }
+
+  if (is_collection_unlinked) {
+    BKE_collections_child_remove_nulls(bmain, owner_collection, NULL);
+  }
+  if (is_collection_remapped) {
+    BKE_main_collections_parent_relations_rebuild(bmain);
+  }
+  if (is_object_unlinked) {
+    BKE_collections_object_remove_nulls(bmain);
+  }
+  if (is_object_remapped || is_collection_remapped || is_collection_unlinked) {
+    BKE_main_collection_sync_remap(bmain);
+  }
+  if (is_object_remapped) {
+    for (Object *ob = bmain->objects.first; ob != NULL; ob = ob->id.next) {
+      if (ob->type == OB_MBALL && BKE_mball_is_basis(ob)) {
+        DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
+      }
+    }
+  }
+}
+
+/**
+ * Same as #BKE_libblock_remap_locked, for all old IDs of \a old_to_new at once.
+ *
+ * All ID pointers in Main are only checked once, instead of once per remapped ID, and the
+ * after-process updates (collections sync, depsgraph relations...) are also only done once.
+ *
+ * \param old_to_new: Map from old IDs to their new ID, which may be NULL to unlink them.
+ */
+void BKE_libblock_remap_multiple_locked(Main *bmain, GHash *old_to_new, const short remap_flags)
+{
+  int items_num;
+  IDRemap *items = libblock_remap_items_from_map(old_to_new, &items_num);
+  if (items == NULL) {
+    return;
+  }
+
+  libblock_remap_data_multiple(bmain, NULL, items, items_num, remap_flags);
+
+  GSet *new_obdata = NULL;
+  for (int i = 0; i < items_num; i++) {
+    libblock_remap_old_id_finalize(&items[i]);
+
+    ID *new_id = items[i].new_id;
+    if (new_id != NULL && ELEM(GS(new_id->name), ID_ME, ID_CU, ID_MB, ID_HA, ID_PT, ID_VO)) {
+      if (new_obdata == NULL) {
+        new_obdata = BLI_gset_ptr_new(__func__);
+      }
+      BLI_gset_add(new_obdata, new_id);
+    }
+  }
+
+  /* Some after-process updates, see #BKE_libblock_remap_locked. */
+  libblock_remap_data_postprocess_multiple_collections_update(bmain, NULL, items, items_num);
+  if (new_obdata != NULL) {
+    /* Only affects us in case obdata was relinked (changed). */
+    for (Object *ob = bmain->objects.first; ob; ob = ob->id.next) {
+      if (ob->data != NULL && BLI_gset_haskey(new_obdata, ob->data)) {
+        libblock_remap_data_postprocess_obdata_relink(bmain, ob, ob->data);
+      }
+    }
+    BLI_gset_free(new_obdata, NULL);
+  }
+
+  BKE_main_unlock(bmain);
+  for (int i = 0; i < items_num; i++) {
+    libblock_remap_data_postprocess_nodetree_update(bmain, items[i].new_id);
+  }
+  BKE_main_lock(bmain);
+
+  MEM_freeN(items);
+
+  /* Full rebuild of DEG! */
+  DEG_relations_tag_update(bmain);
+}
+
+void BKE_libblock_remap_multiple(Main *bmain, GHash *old_to_new, const short remap_flags)
+{
+  BKE_main_lock(bmain);
+
+  BKE_libblock_remap_multiple_locked(bmain, old_to_new, remap_flags);
+
+  BKE_main_unlock(bmain);
+}
+
 /**
  * Unlink given \a id from given \a bmain
  * (does not touch to indirect, i.e. library, usages of the ID).
@@ -669,6 +946,61 @@ void BKE_libblock_relink_ex(
   DEG_relations_tag_update(bmain);
 }
 
+/**
+ * Same as #BKE_libblock_relink_ex, for all old IDs of \a old_to_new at once, in a single pass
+ * over the ID pointers of given \a idv ID.
+ *
+ * \param old_to_new: Map from old IDs to their new ID, which may be NULL to unlink them.
+ */
+void BKE_libblock_relink_multiple(Main *bmain,
+                                  void *idv,
+                                  GHash *old_to_new,
+                                  const short remap_flags)
+{
+  ID *id = idv;
+
+  /* No need to lock here, we are only affecting given ID, not bmain database. */
+
+  BLI_assert(id);
+
+  int items_num;
+  IDRemap *items = libblock_remap_items_from_map(old_to_new, &items_num);
+  if (items == NULL) {
+    return;
+  }
+
+  libblock_remap_data_multiple(bmain, id, items, items_num, remap_flags);
+
+  /* Some after-process updates, see #BKE_libblock_relink_ex. */
+  switch (GS(id->name)) {
+    case ID_SCE:
+    case ID_GR: {
+      Collection *owner_collection = (GS(id->name) == ID_GR) ? (Collection *)id :
+                                                               ((Scene *)id)->master_collection;
+      libblock_remap_data_postprocess_multiple_collections_update(
+          bmain, owner_collection, items, items_num);
+      break;
+    }
+    case ID_OB: {
+      Object *ob = (Object *)id;
+      for (int i = 0; i < items_num; i++) {
+        /* Only affects us in case obdata was relinked (changed). */
+        if (items[i].new_id != NULL && ob->data == items[i].new_id) {
+          libblock_remap_data_postprocess_obdata_relink(bmain, ob, items[i].new_id);
+          break;
+        }
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  MEM_freeN(items);
+
+  DEG_relations_tag_update(bmain);
+}
+
 static int id_relink_to_newid_looper(LibraryIDLinkCallbackData *cb_data)
 {
   const int cb_flag = cb_data->cb_flag;
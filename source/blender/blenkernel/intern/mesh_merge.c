@@ -620,9 +620,8 @@ Mesh *BKE_mesh_merge_verts(Mesh *mesh,
 
     /* Can happen in case vtargetmap contains some double chains, we do not support that. */
     BLI_assert(med->v1 != med->v2);
-
-    CustomData_copy_data(&mesh->edata, &result->edata, olde[i], i, 1);
   }
+  CustomData_copy_data_gather(&mesh->edata, &result->edata, olde, 0, result->totedge);
 
   /* Update loop indices and copy customdata. */
   ml = mloop;
@@ -630,21 +629,14 @@ Mesh *BKE_mesh_merge_verts(Mesh *mesh,
     /* Edge remapping has already be done in main loop handling part above. */
     BLI_assert(newv[ml->v] != -1);
     ml->v = newv[ml->v];
-
-    CustomData_copy_data(&mesh->ldata, &result->ldata, oldl[i], i, 1);
   }
+  CustomData_copy_data_gather(&mesh->ldata, &result->ldata, oldl, 0, result->totloop);
 
   /* Copy vertex customdata. */
-  mv = mvert;
-  for (i = 0; i < result->totvert; i++, mv++) {
-    CustomData_copy_data(&mesh->vdata, &result->vdata, oldv[i], i, 1);
-  }
+  CustomData_copy_data_gather(&mesh->vdata, &result->vdata, oldv, 0, result->totvert);
 
   /* Copy poly customdata. */
-  mp = mpoly;
-  for (i = 0; i < result->totpoly; i++, mp++) {
-    CustomData_copy_data(&mesh->pdata, &result->pdata, oldp[i], i, 1);
-  }
+  CustomData_copy_data_gather(&mesh->pdata, &result->pdata, oldp, 0, result->totpoly);
 
   /* Copy over data. #CustomData_add_layer can do this, need to look it up. */
   memcpy(result->mvert, mvert, sizeof(MVert) * STACK_SIZE(mvert));
@@ -41,6 +41,7 @@
 #include "BLI_memarena.h"
 #include "BLI_stack.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_customdata.h"
@@ -115,24 +116,6 @@ void BKE_mesh_normals_tag_dirty(Mesh *mesh)
 /** \name Mesh Normal Calculation (Polygons)
  * \{ */
 
-struct MeshCalcNormalsData_Poly {
-  const MVert *mvert;
-  const MLoop *mloop;
-  const MPoly *mpoly;
-
-  /** Polygon normal output. */
-  float (*pnors)[3];
-};
-
-static void mesh_calc_normals_poly_fn(void *__restrict userdata,
-                                      const int pidx,
-                                      const TaskParallelTLS *__restrict UNUSED(tls))
-{
-  const MeshCalcNormalsData_Poly *data = (MeshCalcNormalsData_Poly *)userdata;
-  const MPoly *mp = &data->mpoly[pidx];
-  BKE_mesh_calc_poly_normal(mp, data->mloop + mp->loopstart, data->mvert, data->pnors[pidx]);
-}
-
 void BKE_mesh_calc_normals_poly(const MVert *mvert,
                                 int UNUSED(mvert_len),
                                 const MLoop *mloop,
@@ -141,19 +124,20 @@ void BKE_mesh_calc_normals_poly(const MVert *mvert,
                                 int mpoly_len,
                                 float (*r_poly_normals)[3])
 {
-  TaskParallelSettings settings;
-  BLI_parallel_range_settings_defaults(&settings);
-  settings.min_iter_per_thread = 1024;
-
   BLI_assert((r_poly_normals != nullptr) || (mpoly_len == 0));
 
-  MeshCalcNormalsData_Poly data = {};
-  data.mpoly = mpoly;
-  data.mloop = mloop;
-  data.mvert = mvert;
-  data.pnors = r_poly_normals;
-
-  BLI_task_parallel_range(0, mpoly_len, &data, mesh_calc_normals_poly_fn, &settings);
+  /* The cost per polygon is proportional to its number of corners, balance the tasks with it
+   * (about 1024 quads per task). */
+  blender::threading::parallel_for_weighted(
+      blender::IndexRange(mpoly_len),
+      4096,
+      [&](const blender::IndexRange range) {
+        for (const int pidx : range) {
+          const MPoly *mp = &mpoly[pidx];
+          BKE_mesh_calc_poly_normal(mp, mloop + mp->loopstart, mvert, r_poly_normals[pidx]);
+        }
+      },
+      [&](const int64_t pidx) { return int64_t(mpoly[pidx].totloop); });
 }
 
 /** \} */
@@ -241,14 +225,8 @@ static void mesh_calc_normals_poly_and_vertex_accum_fn(
   }
 }
 
-static void mesh_calc_normals_poly_and_vertex_finalize_fn(
-    void *__restrict userdata, const int vidx, const TaskParallelTLS *__restrict UNUSED(tls))
+static void mesh_calc_normals_poly_and_vertex_finalize(MVert *mv, float no[3])
 {
-  MeshCalcNormalsData_PolyAndVertex *data = (MeshCalcNormalsData_PolyAndVertex *)userdata;
-
-  MVert *mv = &data->mvert[vidx];
-  float *no = data->vnors[vidx];
-
   if (UNLIKELY(normalize_v3(no) == 0.0f)) {
     /* Following Mesh convention; we use vertex coordinate itself for normal in this case. */
     normalize_v3_v3(no, mv->co);
@@ -275,12 +253,16 @@ void BKE_mesh_calc_normals_poly_and_vertex(MVert *mvert,
 
   /* First go through and calculate normals for all the polys. */
   if (vnors == nullptr) {
-    vnors = (float(*)[3])MEM_calloc_arrayN((size_t)mvert_len, sizeof(*vnors), __func__);
+    vnors = (float(*)[3])MEM_malloc_arrayN((size_t)mvert_len, sizeof(*vnors), __func__);
     free_vnors = true;
   }
-  else {
-    memset(vnors, 0, sizeof(*vnors) * (size_t)mvert_len);
-  }
+  /* Clear the vertex normals with the same distribution over NUMA nodes as the loop that
+   * normalizes them. Newly allocated memory is placed on the node that touches it first,
+   * so it stays local to the threads that finalize the same vertices. */
+  blender::threading::parallel_for_numa(
+      blender::IndexRange(mvert_len), 4096, [&](const blender::IndexRange range) {
+        memset(vnors[range.start()], 0, sizeof(*vnors) * (size_t)range.size());
+      });
 
   MeshCalcNormalsData_PolyAndVertex data = {};
   data.mpoly = mpoly;
@@ -294,8 +276,12 @@ void BKE_mesh_calc_normals_poly_and_vertex(MVert *mvert,
       0, mpoly_len, &data, mesh_calc_normals_poly_and_vertex_accum_fn, &settings);
 
   /* Normalize and validate computed vertex normals (`vnors`). */
-  BLI_task_parallel_range(
-      0, mvert_len, &data, mesh_calc_normals_poly_and_vertex_finalize_fn, &settings);
+  blender::threading::parallel_for_numa(
+      blender::IndexRange(mvert_len), 1024, [&](const blender::IndexRange range) {
+        for (const int vidx : range) {
+          mesh_calc_normals_poly_and_vertex_finalize(&mvert[vidx], vnors[vidx]);
+        }
+      });
 
   if (free_vnors) {
     MEM_freeN(vnors);
@@ -787,6 +773,12 @@ struct LoopSplitTaskDataCommon {
   int numEdges;
   int numLoops;
   int numPolys;
+
+  /* Owned by #loop_split_generator. */
+  /** Lnor spaces of all fans, in the order of their first loop. */
+  MLoopNorSpace *lnor_spaces;
+  /** First lnor space of each polygon in #lnor_spaces. */
+  int *poly_lnor_space_offsets;
 };
 
 #define INDEX_UNSET INT_MIN
@@ -794,12 +786,36 @@ struct LoopSplitTaskDataCommon {
 /* See comment about edge_to_loops below. */
 #define IS_EDGE_SHARP(_e2l) (ELEM((_e2l)[1], INDEX_UNSET, INDEX_INVALID))
 
+static void mesh_edges_sharp_tag_prepare_fn(void *__restrict userdata,
+                                            const int mp_index,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *data = (LoopSplitTaskDataCommon *)userdata;
+  const MVert *mverts = data->mverts;
+  const MLoop *mloops = data->mloops;
+  float(*loopnors)[3] = data->loopnors; /* NOTE: loopnors may be nullptr here. */
+  int *loop_to_poly = data->loop_to_poly;
+
+  const MPoly *mp = &data->mpolys[mp_index];
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+
+  for (int ml_curr_index = mp->loopstart; ml_curr_index <= ml_last_index; ml_curr_index++) {
+    loop_to_poly[ml_curr_index] = mp_index;
+
+    /* Pre-populate all loop normals as if their verts were all-smooth,
+     * this way we don't have to compute those later!
+     */
+    if (loopnors) {
+      normal_short_to_float_v3(loopnors[ml_curr_index], mverts[mloops[ml_curr_index].v].no);
+    }
+  }
+}
+
 static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
                                  const bool check_angle,
                                  const float split_angle,
                                  const bool do_sharp_edges_tag)
 {
-  const MVert *mverts = data->mverts;
   const MEdge *medges = data->medges;
   const MLoop *mloops = data->mloops;
 
@@ -808,11 +824,10 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
   const int numEdges = data->numEdges;
   const int numPolys = data->numPolys;
 
-  float(*loopnors)[3] = data->loopnors; /* NOTE: loopnors may be nullptr here. */
   const float(*polynors)[3] = data->polynors;
 
   int(*edge_to_loops)[2] = data->edge_to_loops;
-  int *loop_to_poly = data->loop_to_poly;
+  const int *loop_to_poly = data->loop_to_poly;
 
   BLI_bitmap *sharp_edges = do_sharp_edges_tag ? BLI_BITMAP_NEW(numEdges, __func__) : nullptr;
 
@@ -821,6 +836,15 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
 
   const float split_angle_cos = check_angle ? cosf(split_angle) : -1.0f;
 
+  /* The loop to poly mapping has to be known for all loops before tagging edges, since it is used
+   * to find the polygon of the first loop of each edge. Edges themselves are tagged in order, the
+   * first two loops of an edge define whether it is smooth or not. */
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (data->numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
+  settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE;
+  BLI_task_parallel_range(0, numPolys, data, mesh_edges_sharp_tag_prepare_fn, &settings);
+
   for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
     const MLoop *ml_curr;
     int *e2l;
@@ -832,15 +856,6 @@ static void mesh_edges_sharp_tag(LoopSplitTaskDataCommon *data,
     for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++) {
       e2l = edge_to_loops[ml_curr->e];
 
-      loop_to_poly[ml_curr_index] = mp_index;
-
-      /* Pre-populate all loop normals as if their verts were all-smooth,
-       * this way we don't have to compute those later!
-       */
-      if (loopnors) {
-        normal_short_to_float_v3(loopnors[ml_curr_index], mverts[ml_curr->v].no);
-      }
-
       /* Check whether current edge might be smooth or sharp */
       if ((e2l[0] | e2l[1]) == 0) {
         /* 'Empty' edge until now, set e2l[0] (and e2l[1] to INDEX_UNSET to tag it as unset). */
@@ -939,6 +954,7 @@ void BKE_edges_sharp_from_angle_set(const struct MVert *mverts,
   common_data.loop_to_poly = loop_to_poly;
   common_data.polynors = polynors;
   common_data.numEdges = numEdges;
+  common_data.numLoops = numLoops;
   common_data.numPolys = numPolys;
 
   mesh_edges_sharp_tag(&common_data, true, split_angle, true);
@@ -1283,54 +1299,25 @@ static void loop_split_worker_do(LoopSplitTaskDataCommon *common_data,
   }
 }
 
-static void loop_split_worker(TaskPool *__restrict pool, void *taskdata)
-{
-  LoopSplitTaskDataCommon *common_data = (LoopSplitTaskDataCommon *)BLI_task_pool_user_data(pool);
-  LoopSplitTaskData *data = (LoopSplitTaskData *)taskdata;
-
-  /* Temp edge vectors stack, only used when computing lnor spacearr. */
-  BLI_Stack *edge_vectors = common_data->lnors_spacearr ?
-                                BLI_stack_new(sizeof(float[3]), __func__) :
-                                nullptr;
-
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_worker);
-#endif
-
-  for (int i = 0; i < LOOP_SPLIT_TASK_BLOCK_SIZE; i++, data++) {
-    /* A nullptr ml_curr is used to tag ended data! */
-    if (data->ml_curr == nullptr) {
-      break;
-    }
-
-    loop_split_worker_do(common_data, data, edge_vectors);
-  }
-
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
-  }
-
-#ifdef DEBUG_TIME
-  TIMEIT_END_AVERAGED(loop_split_worker);
-#endif
-}
-
 /**
- * Check whether given loop is part of an unknown-so-far cyclic smooth fan, or not.
+ * Check whether given loop is the entry point of a cyclic smooth fan, or not.
  * Needed because cyclic smooth fans have no obvious 'entry point',
  * and yet we need to walk them once, and only once.
+ *
+ * The loop of the fan with the lowest index is used as entry point, so that the check does not
+ * depend on the fans walked before and polygons can be handled in parallel.
  */
 static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
                                                          const MPoly *mpolys,
                                                          const int (*edge_to_loops)[2],
                                                          const int *loop_to_poly,
                                                          const int *e2l_prev,
-                                                         BLI_bitmap *skip_loops,
                                                          const MLoop *ml_curr,
                                                          const MLoop *ml_prev,
                                                          const int ml_curr_index,
                                                          const int ml_prev_index,
-                                                         const int mp_curr_index)
+                                                         const int mp_curr_index,
+                                                         const int numLoops)
 {
   const uint mv_pivot_index = ml_curr->v; /* The vertex we are "fanning" around! */
   const int *e2lfan_curr;
@@ -1354,10 +1341,7 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
   BLI_assert(mlfan_vert_index >= 0);
   BLI_assert(mpfan_curr_index >= 0);
 
-  BLI_assert(!BLI_BITMAP_TEST(skip_loops, mlfan_vert_index));
-  BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
-
-  while (true) {
+  for (int i = 0; i < numLoops; i++) {
     /* Find next loop of the smooth fan. */
     BKE_mesh_loop_manifold_fan_around_vert_next(mloops,
                                                 mpolys,
@@ -1376,192 +1360,244 @@ static bool loop_split_generator_check_cyclic_smooth_fan(const MLoop *mloops,
       return false;
     }
     /* Smooth loop/edge. */
-    if (BLI_BITMAP_TEST(skip_loops, mlfan_vert_index)) {
-      if (mlfan_vert_index == ml_curr_index) {
-        /* We walked around a whole cyclic smooth fan without finding any already-processed loop,
-         * means we can use initial `ml_curr` / `ml_prev` edge as start for this smooth fan. */
-        return true;
-      }
-      /* Already checked in some previous looping, we can abort. */
+    if (mlfan_vert_index == ml_curr_index) {
+      /* We walked around a whole cyclic smooth fan without finding any loop with a lower index,
+       * means we can use initial `ml_curr` / `ml_prev` edge as start for this smooth fan. */
+      return true;
+    }
+    if (mlfan_vert_index < ml_curr_index) {
+      /* The fan is (or will be) processed from another loop, we can abort. */
       return false;
     }
+  }
+
+  /* Only happens with invalid topology, where the walk never gets back to the initial loop. */
+  return false;
+}
+
+/**
+ * Whether the loop needs its own task data, i.e. if it is a 'single' loop or the entry point of
+ * a smooth fan, otherwise it is processed as part of the fan of another loop.
+ */
+static bool loop_split_generator_is_task_loop(const LoopSplitTaskDataCommon *common_data,
+                                              const MLoop *ml_curr,
+                                              const MLoop *ml_prev,
+                                              const int ml_curr_index,
+                                              const int ml_prev_index,
+                                              const int mp_index)
+{
+  const int(*edge_to_loops)[2] = common_data->edge_to_loops;
+  const int *e2l_curr = edge_to_loops[ml_curr->e];
+  const int *e2l_prev = edge_to_loops[ml_prev->e];
+
+#if 0
+  printf("Checking loop %d / edge %u / vert %u (sharp edge: %d)",
+         ml_curr_index,
+         ml_curr->e,
+         ml_curr->v,
+         IS_EDGE_SHARP(e2l_curr));
+#endif
 
-    /* We can skip it in future, and keep checking the smooth fan. */
-    BLI_BITMAP_ENABLE(skip_loops, mlfan_vert_index);
+  /* A smooth edge, we have to check for cyclic smooth fan case.
+   * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
+   * as 'entry point', otherwise we can skip it. */
+
+  /* NOTE: In theory, we could make #loop_split_generator_check_cyclic_smooth_fan() store
+   * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
+   * the vert during actual computation of `clnor` & `clnorspace`.
+   * However, this would complicate the code, add more memory usage, and despite its logical
+   * complexity, #loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
+   * so really think it's not worth it. */
+  return IS_EDGE_SHARP(e2l_curr) ||
+         loop_split_generator_check_cyclic_smooth_fan(common_data->mloops,
+                                                      common_data->mpolys,
+                                                      edge_to_loops,
+                                                      common_data->loop_to_poly,
+                                                      e2l_prev,
+                                                      ml_curr,
+                                                      ml_prev,
+                                                      ml_curr_index,
+                                                      ml_prev_index,
+                                                      mp_index,
+                                                      common_data->numLoops);
+}
+
+struct LoopSplitGeneratorTLS {
+  /** Temp edge vectors stack, only used when computing lnor spacearr, created on first use. */
+  BLI_Stack *edge_vectors;
+};
+
+/** Count the lnor spaces of each polygon, to allocate them all before computing the fans. */
+static void loop_split_generator_count_fn(void *__restrict userdata,
+                                          const int mp_index,
+                                          const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  LoopSplitTaskDataCommon *common_data = (LoopSplitTaskDataCommon *)userdata;
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  int ml_prev_index = ml_last_index;
+  int lnor_spaces_num = 0;
+
+  for (int ml_curr_index = mp->loopstart; ml_curr_index <= ml_last_index; ml_curr_index++) {
+    if (loop_split_generator_is_task_loop(common_data,
+                                          &common_data->mloops[ml_curr_index],
+                                          &common_data->mloops[ml_prev_index],
+                                          ml_curr_index,
+                                          ml_prev_index,
+                                          mp_index)) {
+      lnor_spaces_num++;
+    }
+    ml_prev_index = ml_curr_index;
   }
+
+  common_data->poly_lnor_space_offsets[mp_index] = lnor_spaces_num;
 }
 
-static void loop_split_generator(TaskPool *pool, LoopSplitTaskDataCommon *common_data)
+static void loop_split_generator_fn(void *__restrict userdata,
+                                    const int mp_index,
+                                    const TaskParallelTLS *__restrict tls)
 {
+  LoopSplitTaskDataCommon *common_data = (LoopSplitTaskDataCommon *)userdata;
+  LoopSplitGeneratorTLS *tls_data = (LoopSplitGeneratorTLS *)tls->userdata_chunk;
   MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
   float(*loopnors)[3] = common_data->loopnors;
 
   const MLoop *mloops = common_data->mloops;
-  const MPoly *mpolys = common_data->mpolys;
-  const int *loop_to_poly = common_data->loop_to_poly;
   const int(*edge_to_loops)[2] = common_data->edge_to_loops;
-  const int numLoops = common_data->numLoops;
-  const int numPolys = common_data->numPolys;
-
-  const MPoly *mp;
-  int mp_index;
-
-  const MLoop *ml_curr;
-  const MLoop *ml_prev;
-  int ml_curr_index;
-  int ml_prev_index;
 
-  BLI_bitmap *skip_loops = BLI_BITMAP_NEW(numLoops, __func__);
+  const MPoly *mp = &common_data->mpolys[mp_index];
+  const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
+  int ml_curr_index = mp->loopstart;
+  int ml_prev_index = ml_last_index;
 
-  LoopSplitTaskData *data_buff = nullptr;
-  int data_idx = 0;
+  const MLoop *ml_curr = &mloops[ml_curr_index];
+  const MLoop *ml_prev = &mloops[ml_prev_index];
+  float(*lnors)[3] = &loopnors[ml_curr_index];
 
-  /* Temp edge vectors stack, only used when computing lnor spacearr
-   * (and we are not multi-threading). */
-  BLI_Stack *edge_vectors = nullptr;
-
-#ifdef DEBUG_TIME
-  TIMEIT_START_AVERAGED(loop_split_generator);
-#endif
-
-  if (!pool) {
-    if (lnors_spacearr) {
-      edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
-    }
+  MLoopNorSpace *lnor_space = nullptr;
+  if (lnors_spacearr) {
+    lnor_space = &common_data->lnor_spaces[common_data->poly_lnor_space_offsets[mp_index]];
   }
 
   /* We now know edges that can be smoothed (with their vector, and their two loops),
    * and edges that will be hard! Now, time to generate the normals.
    */
-  for (mp = mpolys, mp_index = 0; mp_index < numPolys; mp++, mp_index++) {
-    float(*lnors)[3];
-    const int ml_last_index = (mp->loopstart + mp->totloop) - 1;
-    ml_curr_index = mp->loopstart;
-    ml_prev_index = ml_last_index;
-
-    ml_curr = &mloops[ml_curr_index];
-    ml_prev = &mloops[ml_prev_index];
-    lnors = &loopnors[ml_curr_index];
-
-    for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++, lnors++) {
+  for (; ml_curr_index <= ml_last_index; ml_curr++, ml_curr_index++, lnors++) {
+    if (loop_split_generator_is_task_loop(
+            common_data, ml_curr, ml_prev, ml_curr_index, ml_prev_index, mp_index)) {
       const int *e2l_curr = edge_to_loops[ml_curr->e];
       const int *e2l_prev = edge_to_loops[ml_prev->e];
+      LoopSplitTaskData data;
 
-#if 0
-      printf("Checking loop %d / edge %u / vert %u (sharp edge: %d, skiploop: %d)",
-             ml_curr_index,
-             ml_curr->e,
-             ml_curr->v,
-             IS_EDGE_SHARP(e2l_curr),
-             BLI_BITMAP_TEST_BOOL(skip_loops, ml_curr_index));
-#endif
-
-      /* A smooth edge, we have to check for cyclic smooth fan case.
-       * If we find a new, never-processed cyclic smooth fan, we can do it now using that loop/edge
-       * as 'entry point', otherwise we can skip it. */
-
-      /* NOTE: In theory, we could make #loop_split_generator_check_cyclic_smooth_fan() store
-       * mlfan_vert_index'es and edge indexes in two stacks, to avoid having to fan again around
-       * the vert during actual computation of `clnor` & `clnorspace`.
-       * However, this would complicate the code, add more memory usage, and despite its logical
-       * complexity, #loop_manifold_fan_around_vert_next() is quite cheap in term of CPU cycles,
-       * so really think it's not worth it. */
-      if (!IS_EDGE_SHARP(e2l_curr) && (BLI_BITMAP_TEST(skip_loops, ml_curr_index) ||
-                                       !loop_split_generator_check_cyclic_smooth_fan(mloops,
-                                                                                     mpolys,
-                                                                                     edge_to_loops,
-                                                                                     loop_to_poly,
-                                                                                     e2l_prev,
-                                                                                     skip_loops,
-                                                                                     ml_curr,
-                                                                                     ml_prev,
-                                                                                     ml_curr_index,
-                                                                                     ml_prev_index,
-                                                                                     mp_index))) {
-        // printf("SKIPPING!\n");
-      }
-      else {
-        LoopSplitTaskData *data, data_local;
+      // printf("PROCESSING!\n");
 
-        // printf("PROCESSING!\n");
-
-        if (pool) {
-          if (data_idx == 0) {
-            data_buff = (LoopSplitTaskData *)MEM_calloc_arrayN(
-                LOOP_SPLIT_TASK_BLOCK_SIZE, sizeof(*data_buff), __func__);
-          }
-          data = &data_buff[data_idx];
-        }
-        else {
-          data = &data_local;
-          memset(data, 0, sizeof(*data));
-        }
+      memset(&data, 0, sizeof(data));
 
-        if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
-          data->lnor = lnors;
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
+      if (IS_EDGE_SHARP(e2l_curr) && IS_EDGE_SHARP(e2l_prev)) {
+        data.lnor = lnors;
+        data.ml_curr = ml_curr;
+        data.ml_prev = ml_prev;
+        data.ml_curr_index = ml_curr_index;
 #if 0 /* Not needed for 'single' loop. */
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = nullptr; /* Tag as 'single' task. */
+        data.ml_prev_index = ml_prev_index;
+        data.e2l_prev = nullptr; /* Tag as 'single' task. */
 #endif
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
-        }
-        /* We *do not need* to check/tag loops as already computed!
-         * Due to the fact a loop only links to one of its two edges,
-         * a same fan *will never be walked more than once!*
-         * Since we consider edges having neighbor polys with inverted
-         * (flipped) normals as sharp, we are sure that no fan will be skipped,
-         * even only considering the case (sharp curr_edge, smooth prev_edge),
-         * and not the alternative (smooth curr_edge, sharp prev_edge).
-         * All this due/thanks to link between normals and loop ordering (i.e. winding).
-         */
-        else {
+        data.mp_index = mp_index;
+      }
+      /* We *do not need* to check/tag loops as already computed!
+       * Due to the fact a loop only links to one of its two edges,
+       * a same fan *will never be walked more than once!*
+       * Since we consider edges having neighbor polys with inverted
+       * (flipped) normals as sharp, we are sure that no fan will be skipped,
+       * even only considering the case (sharp curr_edge, smooth prev_edge),
+       * and not the alternative (smooth curr_edge, sharp prev_edge).
+       * All this due/thanks to link between normals and loop ordering (i.e. winding).
+       */
+      else {
 #if 0 /* Not needed for 'fan' loops. */
-          data->lnor = lnors;
+        data.lnor = lnors;
 #endif
-          data->ml_curr = ml_curr;
-          data->ml_prev = ml_prev;
-          data->ml_curr_index = ml_curr_index;
-          data->ml_prev_index = ml_prev_index;
-          data->e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
-          data->mp_index = mp_index;
-          if (lnors_spacearr) {
-            data->lnor_space = BKE_lnor_space_create(lnors_spacearr);
-          }
+        data.ml_curr = ml_curr;
+        data.ml_prev = ml_prev;
+        data.ml_curr_index = ml_curr_index;
+        data.ml_prev_index = ml_prev_index;
+        data.e2l_prev = e2l_prev; /* Also tag as 'fan' task. */
+        data.mp_index = mp_index;
+
+        if (lnors_spacearr && tls_data->edge_vectors == nullptr) {
+          tls_data->edge_vectors = BLI_stack_new(sizeof(float[3]), __func__);
         }
+      }
 
-        if (pool) {
-          data_idx++;
-          if (data_idx == LOOP_SPLIT_TASK_BLOCK_SIZE) {
-            BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
-            data_idx = 0;
-          }
-        }
-        else {
-          loop_split_worker_do(common_data, data, edge_vectors);
-        }
+      if (lnors_spacearr) {
+        data.lnor_space = lnor_space++;
       }
 
-      ml_prev = ml_curr;
-      ml_prev_index = ml_curr_index;
+      loop_split_worker_do(common_data, &data, tls_data->edge_vectors);
     }
+
+    ml_prev = ml_curr;
+    ml_prev_index = ml_curr_index;
   }
+}
 
-  /* Last block of data. Since it is calloc'ed and we use first nullptr item as stopper,
-   * everything is fine. */
-  if (pool && data_idx) {
-    BLI_task_pool_push(pool, loop_split_worker, data_buff, true, nullptr);
+static void loop_split_generator_free_fn(const void *__restrict UNUSED(userdata),
+                                         void *__restrict chunk)
+{
+  LoopSplitGeneratorTLS *tls_data = (LoopSplitGeneratorTLS *)chunk;
+  if (tls_data->edge_vectors) {
+    BLI_stack_free(tls_data->edge_vectors);
+    tls_data->edge_vectors = nullptr;
   }
+}
 
-  if (edge_vectors) {
-    BLI_stack_free(edge_vectors);
+static void loop_split_generator(LoopSplitTaskDataCommon *common_data, const bool use_threading)
+{
+  MLoopNorSpaceArray *lnors_spacearr = common_data->lnors_spacearr;
+  const int numPolys = common_data->numPolys;
+
+#ifdef DEBUG_TIME
+  TIMEIT_START_AVERAGED(loop_split_generator);
+#endif
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = use_threading;
+  settings.min_iter_per_thread = LOOP_SPLIT_TASK_BLOCK_SIZE;
+
+  common_data->lnor_spaces = nullptr;
+  common_data->poly_lnor_space_offsets = nullptr;
+
+  if (lnors_spacearr) {
+    /* #MemArena is not thread-safe, so all lnor spaces are allocated at once beforehand, in the
+     * same order as the fans they are used by. */
+    common_data->poly_lnor_space_offsets = (int *)MEM_malloc_arrayN(
+        (size_t)numPolys, sizeof(*common_data->poly_lnor_space_offsets), __func__);
+    BLI_task_parallel_range(0, numPolys, common_data, loop_split_generator_count_fn, &settings);
+
+    int lnor_spaces_num = 0;
+    for (int mp_index = 0; mp_index < numPolys; mp_index++) {
+      const int poly_lnor_spaces_num = common_data->poly_lnor_space_offsets[mp_index];
+      common_data->poly_lnor_space_offsets[mp_index] = lnor_spaces_num;
+      lnor_spaces_num += poly_lnor_spaces_num;
+    }
+
+    if (lnor_spaces_num) {
+      common_data->lnor_spaces = (MLoopNorSpace *)BLI_memarena_calloc(
+          lnors_spacearr->mem, sizeof(MLoopNorSpace) * (size_t)lnor_spaces_num);
+    }
+    lnors_spacearr->num_spaces += lnor_spaces_num;
   }
-  MEM_freeN(skip_loops);
+
+  LoopSplitGeneratorTLS tls_data = {nullptr};
+  settings.userdata_chunk = &tls_data;
+  settings.userdata_chunk_size = sizeof(tls_data);
+  settings.func_free = loop_split_generator_free_fn;
+
+  BLI_task_parallel_range(0, numPolys, common_data, loop_split_generator_fn, &settings);
+
+  MEM_SAFE_FREE(common_data->poly_lnor_space_offsets);
+  common_data->lnor_spaces = nullptr;
 
 #ifdef DEBUG_TIME
   TIMEIT_END_AVERAGED(loop_split_generator);
@@ -1681,19 +1717,8 @@ void BKE_mesh_normals_loop_split(const MVert *mverts,
   /* This first loop check which edges are actually smooth, and compute edge vectors. */
   mesh_edges_sharp_tag(&common_data, check_angle, split_angle, false);
 
-  if (numLoops < LOOP_SPLIT_TASK_BLOCK_SIZE * 8) {
-    /* Not enough loops to be worth the whole threading overhead. */
-    loop_split_generator(nullptr, &common_data);
-  }
-  else {
-    TaskPool *task_pool = BLI_task_pool_create(&common_data, TASK_PRIORITY_HIGH);
-
-    loop_split_generator(task_pool, &common_data);
-
-    BLI_task_pool_work_and_wait(task_pool);
-
-    BLI_task_pool_free(task_pool);
-  }
+  /* Not enough loops to be worth the whole threading overhead otherwise. */
+  loop_split_generator(&common_data, numLoops >= LOOP_SPLIT_TASK_BLOCK_SIZE * 8);
 
   MEM_freeN(edge_to_loops);
   if (!r_loop_to_poly) {
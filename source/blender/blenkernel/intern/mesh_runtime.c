@@ -36,10 +36,123 @@
 #include "BKE_bvhutils.h"
 #include "BKE_lib_id.h"
 #include "BKE_mesh.h"
+#include "BKE_mesh_mapping.h"
 #include "BKE_mesh_runtime.h"
 #include "BKE_shrinkwrap.h"
 #include "BKE_subdiv_ccg.h"
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh Topology Map Cache
+ *
+ * Topology maps which are built on demand and kept until the geometry of the mesh is cleared,
+ * so multiple modifiers or evaluations using the same mesh only build them once.
+ * \{ */
+
+typedef struct MeshTopologyMapCache {
+  MeshElemMap *vert_edge_map;
+  int *vert_edge_map_mem;
+  MeshElemMap *vert_poly_map;
+  int *vert_poly_map_mem;
+  MeshElemMap *edge_poly_map;
+  int *edge_poly_map_mem;
+} MeshTopologyMapCache;
+
+static void mesh_runtime_topology_map_cache_free(Mesh *mesh)
+{
+  MeshTopologyMapCache *cache = mesh->runtime.topology_map_cache;
+  if (cache == NULL) {
+    return;
+  }
+  MEM_SAFE_FREE(cache->vert_edge_map);
+  MEM_SAFE_FREE(cache->vert_edge_map_mem);
+  MEM_SAFE_FREE(cache->vert_poly_map);
+  MEM_SAFE_FREE(cache->vert_poly_map_mem);
+  MEM_SAFE_FREE(cache->edge_poly_map);
+  MEM_SAFE_FREE(cache->edge_poly_map_mem);
+  MEM_freeN(cache);
+  mesh->runtime.topology_map_cache = NULL;
+}
+
+/* Must be called with the mesh evaluation mutex locked. */
+static MeshTopologyMapCache *mesh_runtime_topology_map_cache_ensure(Mesh *mesh)
+{
+  if (mesh->runtime.topology_map_cache == NULL) {
+    mesh->runtime.topology_map_cache = MEM_callocN(sizeof(MeshTopologyMapCache), __func__);
+  }
+  return mesh->runtime.topology_map_cache;
+}
+
+/**
+ * The maps below are owned by the mesh, and stay valid until the geometry is cleared
+ * with #BKE_mesh_runtime_clear_geometry, callers must not free them.
+ *
+ * \note These functions only fill a cache, and therefore the mesh argument can
+ * be considered logically const. Concurrent access is protected by a mutex.
+ */
+const MeshElemMap *BKE_mesh_runtime_vert_edge_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  MeshTopologyMapCache *cache = mesh_runtime_topology_map_cache_ensure((Mesh *)mesh);
+  if (cache->vert_edge_map == NULL) {
+    BKE_mesh_vert_edge_map_create(&cache->vert_edge_map,
+                                  &cache->vert_edge_map_mem,
+                                  mesh->medge,
+                                  mesh->totvert,
+                                  mesh->totedge);
+  }
+  const MeshElemMap *map = cache->vert_edge_map;
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_vert_poly_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  MeshTopologyMapCache *cache = mesh_runtime_topology_map_cache_ensure((Mesh *)mesh);
+  if (cache->vert_poly_map == NULL) {
+    BKE_mesh_vert_poly_map_create(&cache->vert_poly_map,
+                                  &cache->vert_poly_map_mem,
+                                  mesh->mpoly,
+                                  mesh->mloop,
+                                  mesh->totvert,
+                                  mesh->totpoly,
+                                  mesh->totloop);
+  }
+  const MeshElemMap *map = cache->vert_poly_map;
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+  return map;
+}
+
+const MeshElemMap *BKE_mesh_runtime_edge_poly_map_ensure(const Mesh *mesh)
+{
+  ThreadMutex *mesh_eval_mutex = (ThreadMutex *)mesh->runtime.eval_mutex;
+  BLI_mutex_lock(mesh_eval_mutex);
+
+  MeshTopologyMapCache *cache = mesh_runtime_topology_map_cache_ensure((Mesh *)mesh);
+  if (cache->edge_poly_map == NULL) {
+    BKE_mesh_edge_poly_map_create(&cache->edge_poly_map,
+                                  &cache->edge_poly_map_mem,
+                                  mesh->medge,
+                                  mesh->totedge,
+                                  mesh->mpoly,
+                                  mesh->totpoly,
+                                  mesh->mloop,
+                                  mesh->totloop);
+  }
+  const MeshElemMap *map = cache->edge_poly_map;
+
+  BLI_mutex_unlock(mesh_eval_mutex);
+  return map;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Runtime Struct Utils
  * \{ */
@@ -68,6 +181,7 @@ void BKE_mesh_runtime_reset_on_copy(Mesh *mesh, const int UNUSED(flag))
   memset(&runtime->looptris, 0, sizeof(runtime->looptris));
   runtime->bvh_cache = NULL;
   runtime->shrinkwrap_data = NULL;
+  runtime->topology_map_cache = NULL;
 
   mesh->runtime.eval_mutex = MEM_mallocN(sizeof(ThreadMutex), "mesh runtime eval_mutex");
   BLI_mutex_init(mesh->runtime.eval_mutex);
@@ -242,6 +356,7 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
     mesh->runtime.bvh_cache = NULL;
   }
   MEM_SAFE_FREE(mesh->runtime.looptris.array);
+  mesh_runtime_topology_map_cache_free(mesh);
   /* TODO(sergey): Does this really belong here? */
   if (mesh->runtime.subdiv_ccg != NULL) {
     BKE_subdiv_ccg_destroy(mesh->runtime.subdiv_ccg);
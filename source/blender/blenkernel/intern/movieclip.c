@@ -48,6 +48,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_view3d_types.h"
 
 #include "BLI_utildefines.h"
@@ -618,8 +619,13 @@ static void movieclip_open_anim_file(MovieClip *clip)
     BLI_strncpy(str, clip->filepath, FILE_MAX);
     BLI_path_abs(str, ID_BLEND_PATH_FROM_GLOBAL(&clip->id));
 
+    int anim_flags = IB_rect;
+    if (U.video_decode_flag & USER_VIDEO_DECODE_HARDWARE) {
+      anim_flags |= IB_animhwdecode;
+    }
+
     /* FIXME: make several stream accessible in image editor, too */
-    clip->anim = openanim(str, IB_rect, 0, clip->colorspace_settings.name);
+    clip->anim = openanim(str, anim_flags, 0, clip->colorspace_settings.name);
 
     if (clip->anim) {
       if (clip->flag & MCLIP_USE_PROXY_CUSTOM_DIR) {
@@ -319,6 +319,8 @@ static void object_free_data(ID *id)
     ob->runtime.curve_cache = NULL;
   }
 
+  BKE_mesh_modifier_stack_cache_free(ob);
+
   BKE_previewimg_free(&ob->preview);
 }
 
@@ -5147,6 +5149,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
   runtime->object_as_temp_mesh = NULL;
   runtime->object_as_temp_curve = NULL;
   runtime->geometry_set_eval = NULL;
+  runtime->modifier_stack_cache = NULL;
 }
 
 /**
@@ -5157,8 +5160,8 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int UNUSED(flag))
  */
 void BKE_object_runtime_free_data(Object *object)
 {
-  /* Currently this is all that's needed. */
   BKE_object_free_derived_caches(object);
+  BKE_mesh_modifier_stack_cache_free(object);
 
   BKE_object_runtime_reset(object);
 }
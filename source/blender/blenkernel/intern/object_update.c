@@ -349,11 +349,27 @@ void BKE_object_eval_uber_transform(Depsgraph *depsgraph, Object *object)
   BKE_object_eval_proxy_copy(depsgraph, object);
 }
 
+/**
+ * Edit-mesh changes that only moved vertices keep the other draw buffers when there are no
+ * modifiers that could change the topology of the evaluated mesh.
+ */
+static eMeshBatchDirtyMode mesh_batch_cache_dirty_mode_get(const Mesh *mesh)
+{
+  const BMEditMesh *em = mesh->edit_mesh;
+  if (em && em->is_deform_only_update && em->mesh_eval_final &&
+      em->mesh_eval_final == em->mesh_eval_cage &&
+      em->mesh_eval_final->runtime.wrapper_type == ME_WRAPPER_TYPE_BMESH) {
+    return BKE_MESH_BATCH_DIRTY_DEFORM;
+  }
+  return BKE_MESH_BATCH_DIRTY_ALL;
+}
+
 void BKE_object_data_batch_cache_dirty_tag(ID *object_data)
 {
   switch (GS(object_data->name)) {
     case ID_ME:
-      BKE_mesh_batch_cache_dirty_tag((struct Mesh *)object_data, BKE_MESH_BATCH_DIRTY_ALL);
+      BKE_mesh_batch_cache_dirty_tag((struct Mesh *)object_data,
+                                     mesh_batch_cache_dirty_mode_get((struct Mesh *)object_data));
       break;
     case ID_LT:
       BKE_lattice_batch_cache_dirty_tag((struct Lattice *)object_data,
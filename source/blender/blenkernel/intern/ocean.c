@@ -818,6 +818,89 @@ bool BKE_ocean_init_from_modifier(struct Ocean *ocean,
                         omd->seed);
 }
 
+typedef struct OceanInitSpectrumData {
+  Ocean *o;
+  int seed;
+} OceanInitSpectrumData;
+
+/**
+ * Initialize a row of the k matrix and of the initial spectrum. The random numbers are seeded
+ * per element, so rows can be computed in parallel with the same result.
+ */
+static void ocean_init_spectrum_cb(void *__restrict userdata,
+                                   const int i,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  OceanInitSpectrumData *data = userdata;
+  Ocean *o = data->o;
+  const int seed = data->seed;
+
+  for (int j = 0; j <= o->_N / 2; j++) {
+    o->_k[(size_t)i * (1 + o->_N / 2) + j] = sqrt(o->_kx[i] * o->_kx[i] + o->_kz[j] * o->_kz[j]);
+  }
+
+  RNG *rng = BLI_rng_new(seed);
+
+  for (int j = 0; j < o->_N; j++) {
+    /* This ensures we get a value tied to the surface location, avoiding dramatic surface
+     * change with changing resolution.
+     * Explicitly cast to signed int first to ensure consistent behavior on all processors,
+     * since behavior of float to unsigned int cast is undefined in C. */
+    const int hash_x = o->_kx[i] * 360.0f;
+    const int hash_z = o->_kz[j] * 360.0f;
+    int new_seed = seed + BLI_hash_int_2d(hash_x, hash_z);
+
+    BLI_rng_seed(rng, new_seed);
+    float r1 = gaussRand(rng);
+    float r2 = gaussRand(rng);
+
+    fftw_complex r1r2;
+    init_complex(r1r2, r1, r2);
+    switch (o->_spectrum) {
+      case MOD_OCEAN_SPECTRUM_JONSWAP:
+        mul_complex_f(o->_h0[i * o->_N + j],
+                      r1r2,
+                      (float)(sqrt(BLI_ocean_spectrum_jonswap(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_jonswap(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+      case MOD_OCEAN_SPECTRUM_TEXEL_MARSEN_ARSLOE:
+        mul_complex_f(
+            o->_h0[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, -o->_kx[i], -o->_kz[j]) /
+                         2.0f)));
+        break;
+      case MOD_OCEAN_SPECTRUM_PIERSON_MOSKOWITZ:
+        mul_complex_f(
+            o->_h0[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(
+            o->_h0_minus[i * o->_N + j],
+            r1r2,
+            (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, -o->_kx[i], -o->_kz[j]) /
+                         2.0f)));
+        break;
+      default:
+        mul_complex_f(
+            o->_h0[i * o->_N + j], r1r2, (float)(sqrt(Ph(o, o->_kx[i], o->_kz[j]) / 2.0f)));
+        mul_complex_f(o->_h0_minus[i * o->_N + j],
+                      r1r2,
+                      (float)(sqrt(Ph(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
+        break;
+    }
+  }
+
+  BLI_rng_free(rng);
+}
+
 /**
  * Return true if the ocean data is valid and can be used.
  */
@@ -844,7 +927,7 @@ bool BKE_ocean_init(struct Ocean *o,
                     short do_jacobian,
                     int seed)
 {
-  int i, j, ii;
+  int i, ii;
 
   BLI_rw_mutex_lock(&o->oceanmutex, THREAD_LOCK_WRITE);
 
@@ -928,73 +1011,15 @@ bool BKE_ocean_init(struct Ocean *o,
     o->_kz[i] = -2.0f * (float)M_PI * ii / o->_Lz;
   }
 
-  /* pre-calculate the k matrix */
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j <= o->_N / 2; j++) {
-      o->_k[(size_t)i * (1 + o->_N / 2) + j] = sqrt(o->_kx[i] * o->_kx[i] + o->_kz[j] * o->_kz[j]);
-    }
-  }
-
-  RNG *rng = BLI_rng_new(seed);
-
-  for (i = 0; i < o->_M; i++) {
-    for (j = 0; j < o->_N; j++) {
-      /* This ensures we get a value tied to the surface location, avoiding dramatic surface
-       * change with changing resolution.
-       * Explicitly cast to signed int first to ensure consistent behavior on all processors,
-       * since behavior of float to unsigned int cast is undefined in C. */
-      const int hash_x = o->_kx[i] * 360.0f;
-      const int hash_z = o->_kz[j] * 360.0f;
-      int new_seed = seed + BLI_hash_int_2d(hash_x, hash_z);
-
-      BLI_rng_seed(rng, new_seed);
-      float r1 = gaussRand(rng);
-      float r2 = gaussRand(rng);
-
-      fftw_complex r1r2;
-      init_complex(r1r2, r1, r2);
-      switch (o->_spectrum) {
-        case MOD_OCEAN_SPECTRUM_JONSWAP:
-          mul_complex_f(o->_h0[i * o->_N + j],
-                        r1r2,
-                        (float)(sqrt(BLI_ocean_spectrum_jonswap(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_jonswap(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
-          break;
-        case MOD_OCEAN_SPECTRUM_TEXEL_MARSEN_ARSLOE:
-          mul_complex_f(
-              o->_h0[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_texelmarsenarsloe(o, -o->_kx[i], -o->_kz[j]) /
-                           2.0f)));
-          break;
-        case MOD_OCEAN_SPECTRUM_PIERSON_MOSKOWITZ:
-          mul_complex_f(
-              o->_h0[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(
-              o->_h0_minus[i * o->_N + j],
-              r1r2,
-              (float)(sqrt(BLI_ocean_spectrum_piersonmoskowitz(o, -o->_kx[i], -o->_kz[j]) /
-                           2.0f)));
-          break;
-        default:
-          mul_complex_f(
-              o->_h0[i * o->_N + j], r1r2, (float)(sqrt(Ph(o, o->_kx[i], o->_kz[j]) / 2.0f)));
-          mul_complex_f(o->_h0_minus[i * o->_N + j],
-                        r1r2,
-                        (float)(sqrt(Ph(o, -o->_kx[i], -o->_kz[j]) / 2.0f)));
-          break;
-      }
-    }
-  }
+  /* pre-calculate the k matrix and the initial spectrum */
+  OceanInitSpectrumData data = {
+      .o = o,
+      .seed = seed,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = (o->_M > 16);
+  BLI_task_parallel_range(0, o->_M, &data, ocean_init_spectrum_cb, &settings);
 
   o->_fft_in = (fftw_complex *)MEM_mallocN(o->_M * (1 + o->_N / 2) * sizeof(fftw_complex),
                                            "ocean_fft_in");
@@ -1057,8 +1082,6 @@ bool BKE_ocean_init(struct Ocean *o,
 
   set_height_normalize_factor(o);
 
-  BLI_rng_free(rng);
-
   return true;
 }
 
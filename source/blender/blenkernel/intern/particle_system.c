@@ -3819,6 +3819,84 @@ static void dynamics_step_sph_classical_integrate_task_cb_ex(void *__restrict us
   }
 }
 
+typedef struct DynamicStepNewtonTLS {
+  /* Random numbers of a thread, only used when their values don't change the result. */
+  RNG *rng;
+} DynamicStepNewtonTLS;
+
+static void dynamics_step_newton_task_cb_ex(void *__restrict userdata,
+                                            const int p,
+                                            const TaskParallelTLS *__restrict tls)
+{
+  DynamicStepSolverTaskData *data = userdata;
+  DynamicStepNewtonTLS *tls_data = tls->userdata_chunk;
+  ParticleSystem *psys = data->sim->psys;
+  ParticleSettings *part = psys->part;
+
+  ParticleData *pa;
+
+  if ((pa = psys->particles + p)->state.time <= 0.0f) {
+    return;
+  }
+
+  if (tls_data->rng == NULL) {
+    tls_data->rng = BLI_rng_new(0);
+  }
+  ParticleSimulationData sim = *data->sim;
+  sim.rng = tls_data->rng;
+
+  /* do global forces & effectors */
+  basic_integrate(&sim, p, pa->state.time, data->cfra);
+
+  /* deflection */
+  if (sim.colliders) {
+    collision_check(&sim, p, pa->state.time, data->cfra);
+  }
+
+  /* rotations */
+  basic_rotate(part, pa, pa->state.time, data->timestep);
+}
+
+static void dynamics_step_newton_free_fn(const void *__restrict UNUSED(userdata),
+                                         void *__restrict tls_v)
+{
+  DynamicStepNewtonTLS *tls_data = tls_v;
+  if (tls_data->rng) {
+    BLI_rng_free(tls_data->rng);
+  }
+}
+
+/**
+ * Newtonian particles only depend on their own state, but the random numbers for brownian
+ * motion, noisy force fields and random deflection come from generators shared by all particles,
+ * so the order of evaluation only doesn't matter when none of those is used.
+ */
+static bool dynamics_step_newton_is_order_independent(ParticleSimulationData *sim)
+{
+  if (sim->psys->part->brownfac != 0.0f) {
+    return false;
+  }
+
+  if (sim->psys->effectors) {
+    LISTBASE_FOREACH (EffectorCache *, eff, sim->psys->effectors) {
+      if (eff->pd && eff->pd->f_noise > 0.0f) {
+        return false;
+      }
+    }
+  }
+
+  if (sim->colliders) {
+    LISTBASE_FOREACH (ColliderCache *, coll, sim->colliders) {
+      const PartDeflect *pd = coll->ob->pd;
+      if (pd && (pd->pdef_perm != 0.0f || pd->pdef_rdamp != 0.0f || pd->pdef_rfrict != 0.0f)) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
 /* unbaked particles are calculated dynamically */
 static void dynamics_step(ParticleSimulationData *sim, float cfra)
 {
@@ -3947,6 +4025,25 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      if ((psys->totpart > 100) && dynamics_step_newton_is_order_independent(sim)) {
+        DynamicStepSolverTaskData task_data = {
+            .sim = sim,
+            .cfra = cfra,
+            .timestep = timestep,
+            .dtime = dtime,
+        };
+        DynamicStepNewtonTLS tls_data = {NULL};
+
+        TaskParallelSettings settings;
+        BLI_parallel_range_settings_defaults(&settings);
+        settings.userdata_chunk = &tls_data;
+        settings.userdata_chunk_size = sizeof(tls_data);
+        settings.func_free = dynamics_step_newton_free_fn;
+        BLI_task_parallel_range(
+            0, psys->totpart, &task_data, dynamics_step_newton_task_cb_ex, &settings);
+        break;
+      }
+
       LOOP_DYNAMIC_PARTICLES
       {
         /* do global forces & effectors */
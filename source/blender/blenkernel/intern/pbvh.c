@@ -249,56 +249,41 @@ void pbvh_grow_nodes(PBVH *pbvh, int totnode)
   pbvh->totnode = totnode;
 }
 
-/* Add a vertex to the map, with a positive value for unique vertices and
- * a negative value for additional vertices */
-static int map_insert_vert(
-    PBVH *pbvh, GHash *map, unsigned int *face_verts, unsigned int *uniq_verts, int vertex)
-{
-  void *key, **value_p;
+/* Vertices used by the faces of a mesh leaf node. Vertices shared by several nodes are unique
+ * vertices of the first node in build order, found once all nodes are built. */
+typedef struct PBVHLeafVerts {
+  /* Sorted vertices used by the faces of the node. */
+  int *verts;
+  /* Index of each vertex in the node vertex indices, with a positive value for unique vertices
+   * and a negative value for additional vertices. */
+  int *verts_map;
+  int totvert;
+  bool has_visible;
+} PBVHLeafVerts;
 
-  key = POINTER_FROM_INT(vertex);
-  if (!BLI_ghash_ensure_p(map, key, &value_p)) {
-    int value_i;
-    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
-      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
-      value_i = *uniq_verts;
-      (*uniq_verts)++;
-    }
-    else {
-      value_i = ~(*face_verts);
-      (*face_verts)++;
-    }
-    *value_p = POINTER_FROM_INT(value_i);
-    return value_i;
-  }
-
-  return POINTER_AS_INT(*value_p);
+static int compare_vert_indices(const void *a, const void *b)
+{
+  const int vert_a = *(const int *)a;
+  const int vert_b = *(const int *)b;
+  return (vert_a > vert_b) - (vert_a < vert_b);
 }
 
-/* Find vertices used by the faces in this node and update the draw buffers */
-static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
+/* Find vertices used by the faces in this node, faces store the index of their vertices in the
+ * sorted node vertices until unique vertices are assigned. Thread safe. */
+static void build_mesh_leaf_verts(const PBVH *pbvh, PBVHNode *node, PBVHLeafVerts *leaf_verts)
 {
-  bool has_visible = false;
-
-  node->uniq_verts = node->face_verts = 0;
   const int totface = node->totprim;
-
-  /* reserve size is rough guess */
-  GHash *map = BLI_ghash_int_new_ex("build_mesh_leaf_node gh", 2 * totface);
+  const int totcorner = totface * 3;
 
   int(*face_vert_indices)[3] = MEM_mallocN(sizeof(int[3]) * totface, "bvh node face vert indices");
+  int *verts = MEM_mallocN(sizeof(int) * totcorner, __func__);
 
-  node->face_vert_indices = (const int(*)[3])face_vert_indices;
-
-  if (pbvh->respect_hide == false) {
-    has_visible = true;
-  }
+  bool has_visible = !pbvh->respect_hide;
 
   for (int i = 0; i < totface; i++) {
     const MLoopTri *lt = &pbvh->looptri[node->prim_indices[i]];
     for (int j = 0; j < 3; j++) {
-      face_vert_indices[i][j] = map_insert_vert(
-          pbvh, map, &node->face_verts, &node->uniq_verts, pbvh->mloop[lt->tri[j]].v);
+      verts[i * 3 + j] = pbvh->mloop[lt->tri[j]].v;
     }
 
     if (has_visible == false) {
@@ -308,38 +293,81 @@ static void build_mesh_leaf_node(PBVH *pbvh, PBVHNode *node)
     }
   }
 
-  int *vert_indices = MEM_callocN(sizeof(int) * (node->uniq_verts + node->face_verts),
-                                  "bvh node vert indices");
-  node->vert_indices = vert_indices;
+  /* Sorting instead of a hash map keeps vertices local in memory for drawing as well. */
+  memcpy(face_vert_indices, verts, sizeof(int) * totcorner);
+  qsort(verts, totcorner, sizeof(int), compare_vert_indices);
 
-  /* Build the vertex list, unique verts first */
-  GHashIterator gh_iter;
-  GHASH_ITER (gh_iter, map) {
-    void *value = BLI_ghashIterator_getValue(&gh_iter);
-    int ndx = POINTER_AS_INT(value);
+  int totvert = 0;
+  for (int i = 0; i < totcorner; i++) {
+    if (totvert == 0 || verts[i] != verts[totvert - 1]) {
+      verts[totvert++] = verts[i];
+    }
+  }
 
-    if (ndx < 0) {
-      ndx = -ndx + node->uniq_verts - 1;
+  for (int i = 0; i < totface; i++) {
+    for (int j = 0; j < 3; j++) {
+      const int *vert = bsearch(
+          &face_vert_indices[i][j], verts, totvert, sizeof(int), compare_vert_indices);
+      face_vert_indices[i][j] = (int)(vert - verts);
     }
+  }
+
+  node->face_vert_indices = (const int(*)[3])face_vert_indices;
+  leaf_verts->verts = verts;
+  leaf_verts->verts_map = MEM_mallocN(sizeof(int) * totvert, __func__);
+  leaf_verts->totvert = totvert;
+  leaf_verts->has_visible = has_visible;
+}
 
-    vert_indices[ndx] = POINTER_AS_INT(BLI_ghashIterator_getKey(&gh_iter));
+/* Vertices not used by a previous node in build order become unique vertices of the node.
+ * Must be called for every node in build order. */
+static void assign_mesh_leaf_verts(PBVH *pbvh, PBVHNode *node, PBVHLeafVerts *leaf_verts)
+{
+  node->uniq_verts = node->face_verts = 0;
+
+  for (int i = 0; i < leaf_verts->totvert; i++) {
+    const int vertex = leaf_verts->verts[i];
+    if (BLI_BITMAP_TEST(pbvh->vert_bitmap, vertex) == 0) {
+      BLI_BITMAP_ENABLE(pbvh->vert_bitmap, vertex);
+      leaf_verts->verts_map[i] = node->uniq_verts;
+      node->uniq_verts++;
+    }
+    else {
+      leaf_verts->verts_map[i] = ~node->face_verts;
+      node->face_verts++;
+    }
   }
+}
 
-  for (int i = 0; i < totface; i++) {
-    const int sides = 3;
+/* Build the vertex list of the node, unique verts first, and update the draw buffers.
+ * Thread safe. */
+static void build_mesh_leaf_node(PBVHNode *node, PBVHLeafVerts *leaf_verts)
+{
+  int *vert_indices = MEM_mallocN(sizeof(int) * (node->uniq_verts + node->face_verts),
+                                  "bvh node vert indices");
+  node->vert_indices = vert_indices;
 
-    for (int j = 0; j < sides; j++) {
-      if (face_vert_indices[i][j] < 0) {
-        face_vert_indices[i][j] = -face_vert_indices[i][j] + node->uniq_verts - 1;
-      }
+  int *verts_map = leaf_verts->verts_map;
+  for (int i = 0; i < leaf_verts->totvert; i++) {
+    if (verts_map[i] < 0) {
+      verts_map[i] = ~verts_map[i] + node->uniq_verts;
+    }
+    vert_indices[verts_map[i]] = leaf_verts->verts[i];
+  }
+
+  int(*face_vert_indices)[3] = (int(*)[3])node->face_vert_indices;
+  for (int i = 0; i < node->totprim; i++) {
+    for (int j = 0; j < 3; j++) {
+      face_vert_indices[i][j] = verts_map[face_vert_indices[i][j]];
     }
   }
 
   BKE_pbvh_node_mark_rebuild_draw(node);
 
-  BKE_pbvh_node_fully_hidden_set(node, !has_visible);
+  BKE_pbvh_node_fully_hidden_set(node, !leaf_verts->has_visible);
 
-  BLI_ghash_free(map, NULL, NULL);
+  MEM_freeN(leaf_verts->verts);
+  MEM_freeN(leaf_verts->verts_map);
 }
 
 static void update_vb(PBVH *pbvh, PBVHNode *node, BBC *prim_bbc, int offset, int count)
@@ -412,6 +440,8 @@ static void build_grid_leaf_node(PBVH *pbvh, PBVHNode *node)
   BKE_pbvh_node_mark_rebuild_draw(node);
 }
 
+/* Leaf data depending on the other leaves is built once the whole tree is built,
+ * see #pbvh_build_leaves. */
 static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, int count)
 {
   pbvh->nodes[node_index].flag |= PBVH_Leaf;
@@ -421,13 +451,6 @@ static void build_leaf(PBVH *pbvh, int node_index, BBC *prim_bbc, int offset, in
 
   /* Still need vb for searches */
   update_vb(pbvh, &pbvh->nodes[node_index], prim_bbc, offset, count);
-
-  if (pbvh->looptri) {
-    build_mesh_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
-  else {
-    build_grid_leaf_node(pbvh, pbvh->nodes + node_index);
-  }
 }
 
 /* Return zero if all primitives in the node can be drawn with the
@@ -464,6 +487,39 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
   return false;
 }
 
+/* Subtree built by a task into its own nodes, added to the tree once built. */
+typedef struct PBVHBuildTask {
+  int node_index;
+  int offset;
+  int count;
+  /* Copy of the PBVH with the nodes of the subtree, the root of the subtree first. */
+  PBVH pbvh;
+} PBVHBuildTask;
+
+typedef struct PBVHBuildTasks {
+  PBVHBuildTask *tasks;
+  int tottask;
+  int task_mem_count;
+  /* Subtrees of up to this many primitives are built by a single task. */
+  int max_task_prims;
+  BBC *prim_bbc;
+} PBVHBuildTasks;
+
+/* Split in about this many subtrees built in parallel. */
+#define BUILD_TASK_SPLITS 64
+
+static void build_task_add(PBVHBuildTasks *tasks, int node_index, int offset, int count)
+{
+  if (tasks->tottask == tasks->task_mem_count) {
+    tasks->task_mem_count = max_ii(tasks->task_mem_count * 2, BUILD_TASK_SPLITS);
+    tasks->tasks = MEM_reallocN(tasks->tasks, sizeof(PBVHBuildTask) * tasks->task_mem_count);
+  }
+  PBVHBuildTask *task = &tasks->tasks[tasks->tottask++];
+  task->node_index = node_index;
+  task->offset = offset;
+  task->count = count;
+}
+
 /* Recursively build a node in the tree
  *
  * vb is the voxel box around all of the primitives contained in
@@ -473,13 +529,26 @@ static bool leaf_needs_material_split(PBVH *pbvh, int offset, int count)
  * contained in this node
  *
  * offset and start indicate a range in the array of primitive indices
+ *
+ * When tasks is given, subtrees small enough are added to them to be built later
  */
 
-static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int offset, int count)
+static void build_sub(PBVH *pbvh,
+                      int node_index,
+                      BB *cb,
+                      BBC *prim_bbc,
+                      int offset,
+                      int count,
+                      PBVHBuildTasks *tasks)
 {
   int end;
   BB cb_backing;
 
+  if (tasks && count <= tasks->max_task_prims) {
+    build_task_add(tasks, node_index, offset, count);
+    return;
+  }
+
   /* Decide whether this is a leaf or not */
   const bool below_leaf_limit = count <= pbvh->leaf_limit;
   if (below_leaf_limit) {
@@ -521,13 +590,141 @@ static void build_sub(PBVH *pbvh, int node_index, BB *cb, BBC *prim_bbc, int off
   }
 
   /* Build children */
-  build_sub(pbvh, pbvh->nodes[node_index].children_offset, NULL, prim_bbc, offset, end - offset);
+  build_sub(pbvh,
+            pbvh->nodes[node_index].children_offset,
+            NULL,
+            prim_bbc,
+            offset,
+            end - offset,
+            tasks);
   build_sub(pbvh,
             pbvh->nodes[node_index].children_offset + 1,
             NULL,
             prim_bbc,
             end,
-            offset + count - end);
+            offset + count - end,
+            tasks);
+}
+
+static void pbvh_build_task_cb(void *__restrict userdata,
+                               const int n,
+                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildTasks *tasks = userdata;
+  PBVHBuildTask *task = &tasks->tasks[n];
+  PBVH *task_pbvh = &task->pbvh;
+
+  task_pbvh->node_mem_count = max_ii(2 * task->count / task_pbvh->leaf_limit + 1, 16);
+  task_pbvh->nodes = MEM_callocN(sizeof(PBVHNode) * task_pbvh->node_mem_count,
+                                 "bvh task nodes");
+  task_pbvh->totnode = 1;
+  build_sub(task_pbvh, 0, NULL, tasks->prim_bbc, task->offset, task->count, NULL);
+}
+
+/* Add the nodes of a subtree built by a task to the tree. */
+static void pbvh_build_task_merge(PBVH *pbvh, PBVHBuildTask *task)
+{
+  PBVH *task_pbvh = &task->pbvh;
+  /* The root of the subtree replaces the node it was built for, other nodes are appended. */
+  const int offset = pbvh->totnode - 1;
+  pbvh_grow_nodes(pbvh, pbvh->totnode + task_pbvh->totnode - 1);
+
+  for (int i = 0; i < task_pbvh->totnode; i++) {
+    PBVHNode *node = &task_pbvh->nodes[i];
+    if (!(node->flag & PBVH_Leaf)) {
+      node->children_offset += offset;
+    }
+    pbvh->nodes[i == 0 ? task->node_index : offset + i] = *node;
+  }
+
+  MEM_freeN(task_pbvh->nodes);
+}
+
+/* Leaves in build order: the order they are reached depth-first, first children first. */
+static int *pbvh_build_leaves_get(PBVH *pbvh, int *r_totleaf)
+{
+  int *leaves = MEM_mallocN(sizeof(int) * pbvh->totnode, __func__);
+  int *stack = MEM_mallocN(sizeof(int) * pbvh->totnode, __func__);
+  int totleaf = 0;
+  int stacksize = 0;
+
+  stack[stacksize++] = 0;
+  while (stacksize > 0) {
+    const int node_index = stack[--stacksize];
+    const PBVHNode *node = &pbvh->nodes[node_index];
+    if (node->flag & PBVH_Leaf) {
+      leaves[totleaf++] = node_index;
+    }
+    else {
+      stack[stacksize++] = node->children_offset + 1;
+      stack[stacksize++] = node->children_offset;
+    }
+  }
+
+  MEM_freeN(stack);
+  *r_totleaf = totleaf;
+  return leaves;
+}
+
+typedef struct PBVHBuildLeavesData {
+  PBVH *pbvh;
+  const int *leaves;
+  PBVHLeafVerts *leaves_verts;
+} PBVHBuildLeavesData;
+
+static void pbvh_build_mesh_leaf_verts_task_cb(void *__restrict userdata,
+                                               const int n,
+                                               const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  PBVHNode *node = &data->pbvh->nodes[data->leaves[n]];
+  build_mesh_leaf_verts(data->pbvh, node, &data->leaves_verts[n]);
+}
+
+static void pbvh_build_mesh_leaf_node_task_cb(void *__restrict userdata,
+                                              const int n,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  PBVHNode *node = &data->pbvh->nodes[data->leaves[n]];
+  build_mesh_leaf_node(node, &data->leaves_verts[n]);
+}
+
+static void pbvh_build_grid_leaf_node_task_cb(void *__restrict userdata,
+                                              const int n,
+                                              const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  PBVHBuildLeavesData *data = userdata;
+  build_grid_leaf_node(data->pbvh, &data->pbvh->nodes[data->leaves[n]]);
+}
+
+static void pbvh_build_leaves(PBVH *pbvh)
+{
+  int totleaf;
+  int *leaves = pbvh_build_leaves_get(pbvh, &totleaf);
+
+  PBVHBuildLeavesData data = {
+      .pbvh = pbvh,
+      .leaves = leaves,
+  };
+
+  TaskParallelSettings settings;
+  BKE_pbvh_parallel_range_settings(&settings, true, totleaf);
+
+  if (pbvh->looptri) {
+    data.leaves_verts = MEM_mallocN(sizeof(PBVHLeafVerts) * totleaf, __func__);
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_mesh_leaf_verts_task_cb, &settings);
+    for (int i = 0; i < totleaf; i++) {
+      assign_mesh_leaf_verts(pbvh, &pbvh->nodes[leaves[i]], &data.leaves_verts[i]);
+    }
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_mesh_leaf_node_task_cb, &settings);
+    MEM_freeN(data.leaves_verts);
+  }
+  else {
+    BLI_task_parallel_range(0, totleaf, &data, pbvh_build_grid_leaf_node_task_cb, &settings);
+  }
+
+  MEM_freeN(leaves);
 }
 
 static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
@@ -552,7 +749,102 @@ static void pbvh_build(PBVH *pbvh, BB *cb, BBC *prim_bbc, int totprim)
   }
 
   pbvh->totnode = 1;
-  build_sub(pbvh, 0, cb, prim_bbc, 0, totprim);
+
+  /* Split the top of the tree, then build the subtrees in parallel. */
+  const int max_task_prims = max_ii(totprim / BUILD_TASK_SPLITS, pbvh->leaf_limit);
+  if (totprim > max_task_prims) {
+    PBVHBuildTasks tasks = {
+        .max_task_prims = max_task_prims,
+        .prim_bbc = prim_bbc,
+    };
+    build_sub(pbvh, 0, cb, prim_bbc, 0, totprim, &tasks);
+    for (int i = 0; i < tasks.tottask; i++) {
+      tasks.tasks[i].pbvh = *pbvh;
+    }
+
+    TaskParallelSettings settings;
+    BKE_pbvh_parallel_range_settings(&settings, true, tasks.tottask);
+    BLI_task_parallel_range(0, tasks.tottask, &tasks, pbvh_build_task_cb, &settings);
+
+    for (int i = 0; i < tasks.tottask; i++) {
+      pbvh_build_task_merge(pbvh, &tasks.tasks[i]);
+    }
+    MEM_SAFE_FREE(tasks.tasks);
+  }
+  else {
+    build_sub(pbvh, 0, cb, prim_bbc, 0, totprim, NULL);
+  }
+
+  pbvh_build_leaves(pbvh);
+}
+
+typedef struct PBVHPrimBBCData {
+  const PBVH *pbvh;
+  BBC *prim_bbc;
+} PBVHPrimBBCData;
+
+static void pbvh_mesh_prim_bbc_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBBCData *data = userdata;
+  const PBVH *pbvh = data->pbvh;
+  const MLoopTri *lt = &pbvh->looptri[i];
+  const int sides = 3;
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < sides; j++) {
+    BB_expand((BB *)bbc, pbvh->verts[pbvh->mloop[lt->tri[j]].v].co);
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_grid_prim_bbc_task_cb(void *__restrict userdata,
+                                       const int i,
+                                       const TaskParallelTLS *__restrict tls)
+{
+  PBVHPrimBBCData *data = userdata;
+  const CCGKey *key = &data->pbvh->gridkey;
+  CCGElem *grid = data->pbvh->grids[i];
+  BBC *bbc = data->prim_bbc + i;
+
+  BB_reset((BB *)bbc);
+
+  for (int j = 0; j < key->grid_area; j++) {
+    BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
+  }
+
+  BBC_update_centroid(bbc);
+
+  BB_expand(tls->userdata_chunk, bbc->bcentroid);
+}
+
+static void pbvh_prim_centroid_bb_reduce(const void *__restrict UNUSED(userdata),
+                                         void *__restrict chunk_join,
+                                         void *__restrict chunk)
+{
+  BB_expand_with_bb(chunk_join, chunk);
+}
+
+/* Store the AABB and the AABB centroid of each primitive, cb is expanded to include all
+ * centroids. */
+static void pbvh_prim_bbc_calc(PBVHPrimBBCData *data,
+                               int totprim,
+                               TaskParallelRangeFunc func,
+                               BB *cb)
+{
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  settings.userdata_chunk = cb;
+  settings.userdata_chunk_size = sizeof(*cb);
+  settings.func_reduce = pbvh_prim_centroid_bb_reduce;
+  BLI_task_parallel_range(0, totprim, data, func, &settings);
 }
 
 /**
@@ -597,21 +889,11 @@ void BKE_pbvh_build_mesh(PBVH *pbvh,
   /* For each face, store the AABB and the AABB centroid */
   prim_bbc = MEM_mallocN(sizeof(BBC) * looptri_num, "prim_bbc");
 
-  for (int i = 0; i < looptri_num; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const int sides = 3;
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < sides; j++) {
-      BB_expand((BB *)bbc, verts[pbvh->mloop[lt->tri[j]].v].co);
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBBCData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+  pbvh_prim_bbc_calc(&data, looptri_num, pbvh_mesh_prim_bbc_task_cb, &cb);
 
   if (looptri_num) {
     pbvh_build(pbvh, &cb, prim_bbc, looptri_num);
@@ -647,20 +929,11 @@ void BKE_pbvh_build_grids(PBVH *pbvh,
   /* For each grid, store the AABB and the AABB centroid */
   BBC *prim_bbc = MEM_mallocN(sizeof(BBC) * totgrid, "prim_bbc");
 
-  for (int i = 0; i < totgrid; i++) {
-    CCGElem *grid = grids[i];
-    BBC *bbc = prim_bbc + i;
-
-    BB_reset((BB *)bbc);
-
-    for (int j = 0; j < gridsize * gridsize; j++) {
-      BB_expand((BB *)bbc, CCG_elem_offset_co(key, grid, j));
-    }
-
-    BBC_update_centroid(bbc);
-
-    BB_expand(&cb, bbc->bcentroid);
-  }
+  PBVHPrimBBCData data = {
+      .pbvh = pbvh,
+      .prim_bbc = prim_bbc,
+  };
+  pbvh_prim_bbc_calc(&data, totgrid, pbvh_grid_prim_bbc_task_cb, &cb);
 
   if (totgrid) {
     pbvh_build(pbvh, &cb, prim_bbc, totgrid);
@@ -676,6 +949,20 @@ PBVH *BKE_pbvh_new(void)
   return pbvh;
 }
 
+static void pbvh_node_vertex_data_free(PBVHNode *node)
+{
+  PBVHVertexData *vdata = node->vertex_data;
+  if (vdata == NULL) {
+    return;
+  }
+  MEM_freeN(vdata->co);
+  MEM_freeN(vdata->no);
+  MEM_freeN(vdata->mask);
+  MEM_freeN(vdata->visible);
+  MEM_freeN(vdata);
+  node->vertex_data = NULL;
+}
+
 void BKE_pbvh_free(PBVH *pbvh)
 {
   for (int i = 0; i < pbvh->totnode; i++) {
@@ -700,6 +987,7 @@ void BKE_pbvh_free(PBVH *pbvh)
       if (node->bm_other_verts) {
         BLI_gset_free(node->bm_other_verts, NULL);
       }
+      pbvh_node_vertex_data_free(node);
     }
   }
 
@@ -723,6 +1011,8 @@ void BKE_pbvh_free(PBVH *pbvh)
     MEM_freeN(pbvh->prim_indices);
   }
 
+  MEM_SAFE_FREE(pbvh->vert_normals_accum);
+
   MEM_freeN(pbvh);
 }
 
@@ -1033,6 +1323,11 @@ static void pbvh_update_normals_accum_task_cb(void *__restrict userdata,
     const int *faces = node->prim_indices;
     const int totface = node->totprim;
 
+    /* Accumulate into node vertices first, only vertices shared with other nodes need
+     * atomics, once per vertex instead of once per face. */
+    const int totvert = node->uniq_verts + node->face_verts;
+    float(*node_vnors)[3] = MEM_callocN(sizeof(*node_vnors) * max_ii(totvert, 1), __func__);
+
     for (int i = 0; i < totface; i++) {
       const MLoopTri *lt = &pbvh->looptri[faces[i]];
       const unsigned int vtri[3] = {
@@ -1042,6 +1337,13 @@ static void pbvh_update_normals_accum_task_cb(void *__restrict userdata,
       };
       const int sides = 3;
 
+      /* Faces without moved vertices don't change any normal to update. */
+      if (!((pbvh->verts[vtri[0]].flag | pbvh->verts[vtri[1]].flag |
+             pbvh->verts[vtri[2]].flag) &
+            ME_VERT_PBVH_UPDATE)) {
+        continue;
+      }
+
       /* Face normal and mask */
       if (lt->poly != mpoly_prev) {
         const MPoly *mp = &pbvh->mpoly[lt->poly];
@@ -1053,16 +1355,26 @@ static void pbvh_update_normals_accum_task_cb(void *__restrict userdata,
         const int v = vtri[j];
 
         if (pbvh->verts[v].flag & ME_VERT_PBVH_UPDATE) {
-          /* NOTE: This avoids `lock, add_v3_v3, unlock`
-           * and is five to ten times quicker than a spin-lock.
-           * Not exact equivalent though, since atomicity is only ensured for one component
-           * of the vector at a time, but here it shall not make any sensible difference. */
-          for (int k = 3; k--;) {
-            atomic_add_and_fetch_fl(&vnors[v][k], fn[k]);
-          }
+          add_v3_v3(node_vnors[node->face_vert_indices[i][j]], fn);
+        }
+      }
+    }
+
+    /* Unique vertices are stored by this node once all nodes are accumulated. */
+    for (int i = node->uniq_verts; i < totvert; i++) {
+      const int v = node->vert_indices[i];
+      if (pbvh->verts[v].flag & ME_VERT_PBVH_UPDATE) {
+        /* NOTE: This avoids `lock, add_v3_v3, unlock`
+         * and is five to ten times quicker than a spin-lock.
+         * Not exact equivalent though, since atomicity is only ensured for one component
+         * of the vector at a time, but here it shall not make any sensible difference. */
+        for (int k = 3; k--;) {
+          atomic_add_and_fetch_fl(&vnors[v][k], node_vnors[i][k]);
         }
       }
     }
+
+    node->normals_accum = node_vnors;
   }
 }
 
@@ -1078,6 +1390,7 @@ static void pbvh_update_normals_store_task_cb(void *__restrict userdata,
   if (node->flag & PBVH_UpdateNormals) {
     const int *verts = node->vert_indices;
     const int totvert = node->uniq_verts;
+    float(*node_vnors)[3] = node->normals_accum;
 
     for (int i = 0; i < totvert; i++) {
       const int v = verts[i];
@@ -1086,21 +1399,29 @@ static void pbvh_update_normals_store_task_cb(void *__restrict userdata,
       /* No atomics necessary because we are iterating over uniq_verts only,
        * so we know only this thread will handle this vertex. */
       if (mvert->flag & ME_VERT_PBVH_UPDATE) {
-        normalize_v3(vnors[v]);
-        normal_float_to_short_v3(mvert->no, vnors[v]);
+        float no[3];
+        add_v3_v3v3(no, node_vnors[i], vnors[v]);
+        zero_v3(vnors[v]);
+        normalize_v3(no);
+        normal_float_to_short_v3(mvert->no, no);
         mvert->flag &= ~ME_VERT_PBVH_UPDATE;
       }
     }
 
+    MEM_freeN(node_vnors);
+    node->normals_accum = NULL;
     node->flag &= ~PBVH_UpdateNormals;
   }
 }
 
 static void pbvh_faces_update_normals(PBVH *pbvh, PBVHNode **nodes, int totnode)
 {
-  /* could be per node to save some memory, but also means
-   * we have to store for each vertex which node it is in */
-  float(*vnors)[3] = MEM_callocN(sizeof(*vnors) * pbvh->totvert, __func__);
+  /* Contributions of the nodes to their vertices shared with other nodes. Kept between updates
+   * as it's expensive to allocate for large meshes, stored vertices are zeroed again. */
+  if (pbvh->vert_normals_accum == NULL) {
+    pbvh->vert_normals_accum = MEM_callocN(sizeof(*pbvh->vert_normals_accum) * pbvh->totvert,
+                                           __func__);
+  }
 
   /* subtle assumptions:
    * - We know that for all edited vertices, the nodes with faces
@@ -1115,7 +1436,7 @@ static void pbvh_faces_update_normals(PBVH *pbvh, PBVHNode **nodes, int totnode)
   PBVHUpdateData data = {
       .pbvh = pbvh,
       .nodes = nodes,
-      .vnors = vnors,
+      .vnors = pbvh->vert_normals_accum,
   };
 
   TaskParallelSettings settings;
@@ -1123,8 +1444,6 @@ static void pbvh_faces_update_normals(PBVH *pbvh, PBVHNode **nodes, int totnode)
 
   BLI_task_parallel_range(0, totnode, &data, pbvh_update_normals_accum_task_cb, &settings);
   BLI_task_parallel_range(0, totnode, &data, pbvh_update_normals_store_task_cb, &settings);
-
-  MEM_freeN(vnors);
 }
 
 static void pbvh_update_mask_redraw_task_cb(void *__restrict userdata,
@@ -1251,10 +1570,25 @@ void pbvh_update_BB_redraw(PBVH *pbvh, PBVHNode **nodes, int totnode, int flag)
   BLI_task_parallel_range(0, totnode, &data, pbvh_update_BB_redraw_task_cb, &settings);
 }
 
-static int pbvh_get_buffers_update_flags(PBVH *UNUSED(pbvh))
+/* Any of the draw buffers of the node are outdated. */
+#define PBVH_ANY_DRAW_BUFFERS_UPDATE \
+  (PBVH_UpdateDrawBuffers | PBVH_UpdateMaskDrawBuffers | PBVH_UpdateColorDrawBuffers)
+
+static int pbvh_get_buffers_update_flags(PBVH *UNUSED(pbvh), const PBVHNode *node)
 {
   int update_flags = GPU_PBVH_BUFFERS_SHOW_VCOL | GPU_PBVH_BUFFERS_SHOW_MASK |
                      GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS;
+
+  /* Mesh buffers don't pack the positions and normals again for mask or color changes. */
+  if (node->flag & PBVH_UpdateDrawBuffers) {
+    update_flags |= GPU_PBVH_BUFFERS_UPDATE_VERTS;
+  }
+  if (node->flag & PBVH_UpdateMaskDrawBuffers) {
+    update_flags |= GPU_PBVH_BUFFERS_UPDATE_MASK;
+  }
+  if (node->flag & PBVH_UpdateColorDrawBuffers) {
+    update_flags |= GPU_PBVH_BUFFERS_UPDATE_VCOL;
+  }
   return update_flags;
 }
 
@@ -1292,8 +1626,8 @@ static void pbvh_update_draw_buffer_cb(void *__restrict userdata,
     }
   }
 
-  if (node->flag & PBVH_UpdateDrawBuffers) {
-    const int update_flags = pbvh_get_buffers_update_flags(pbvh);
+  if (node->flag & PBVH_ANY_DRAW_BUFFERS_UPDATE) {
+    const int update_flags = pbvh_get_buffers_update_flags(pbvh, node);
     switch (pbvh->type) {
       case PBVH_GRIDS:
         GPU_pbvh_grid_buffers_update(node->draw_buffers,
@@ -1341,7 +1675,7 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
         GPU_pbvh_buffers_free(node->draw_buffers);
         node->draw_buffers = NULL;
       }
-      else if ((node->flag & PBVH_UpdateDrawBuffers) && node->draw_buffers) {
+      else if ((node->flag & PBVH_ANY_DRAW_BUFFERS_UPDATE) && node->draw_buffers) {
         if (pbvh->type == PBVH_GRIDS) {
           GPU_pbvh_grid_buffers_update_free(
               node->draw_buffers, pbvh->grid_flag_mats, node->prim_indices);
@@ -1366,12 +1700,12 @@ static void pbvh_update_draw_buffers(PBVH *pbvh, PBVHNode **nodes, int totnode,
   for (int i = 0; i < totnode; i++) {
     PBVHNode *node = nodes[i];
 
-    if (node->flag & PBVH_UpdateDrawBuffers) {
+    if (node->flag & PBVH_ANY_DRAW_BUFFERS_UPDATE) {
       /* Flush buffers uses OpenGL, so not in parallel. */
       GPU_pbvh_buffers_update_flush(node->draw_buffers);
     }
 
-    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers);
+    node->flag &= ~(PBVH_RebuildDrawBuffers | PBVH_ANY_DRAW_BUFFERS_UPDATE);
   }
 }
 
@@ -1737,12 +2071,12 @@ void BKE_pbvh_node_mark_update(PBVHNode *node)
 
 void BKE_pbvh_node_mark_update_mask(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateMask | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateMask | PBVH_UpdateMaskDrawBuffers | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_color(PBVHNode *node)
 {
-  node->flag |= PBVH_UpdateColor | PBVH_UpdateDrawBuffers | PBVH_UpdateRedraw;
+  node->flag |= PBVH_UpdateColor | PBVH_UpdateColorDrawBuffers | PBVH_UpdateRedraw;
 }
 
 void BKE_pbvh_node_mark_update_visibility(PBVHNode *node)
@@ -2723,14 +3057,14 @@ void BKE_pbvh_draw_cb(PBVH *pbvh,
   }
   else {
     /* Get all nodes with draw updates, also those outside the view. */
-    const int search_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+    const int search_flag = PBVH_RebuildDrawBuffers | PBVH_ANY_DRAW_BUFFERS_UPDATE;
     BKE_pbvh_search_gather(
         pbvh, update_search_cb, POINTER_FROM_INT(search_flag), &nodes, &totnode);
-    update_flag = PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers;
+    update_flag = search_flag;
   }
 
   /* Update draw buffers. */
-  if (totnode != 0 && (update_flag & (PBVH_RebuildDrawBuffers | PBVH_UpdateDrawBuffers))) {
+  if (totnode != 0 && (update_flag & (PBVH_RebuildDrawBuffers | PBVH_ANY_DRAW_BUFFERS_UPDATE))) {
     pbvh_update_draw_buffers(pbvh, nodes, totnode, update_flag);
   }
   MEM_SAFE_FREE(nodes);
@@ -2877,6 +3211,50 @@ void BKE_pbvh_node_free_proxies(PBVHNode *node)
   node->proxies = NULL;
 
   node->proxy_count = 0;
+
+  /* The proxies have been applied, the copy of the coordinates is outdated. */
+  pbvh_node_vertex_data_free(node);
+}
+
+/**
+ * Copy the current coordinates, normals, masks and visibility of the unique vertices of a mesh
+ * leaf node into node-local arrays, so brush loops read them contiguously instead of indexing
+ * the mesh arrays. Brushes write their result to a proxy, applied to the mesh afterwards.
+ *
+ * The arrays are allocated once and refilled on every call, until the node proxies are freed.
+ * \return NULL for multires and dynamic topology PBVHs.
+ */
+const PBVHVertexData *BKE_pbvh_node_vertex_data_gather(PBVH *pbvh, PBVHNode *node)
+{
+  if (pbvh->type != PBVH_FACES) {
+    return NULL;
+  }
+
+  const int totvert = node->uniq_verts;
+  PBVHVertexData *vdata = node->vertex_data;
+  if (vdata == NULL) {
+    vdata = MEM_callocN(sizeof(*vdata), __func__);
+    vdata->co = MEM_malloc_arrayN(totvert, sizeof(*vdata->co), __func__);
+    vdata->no = MEM_malloc_arrayN(totvert, sizeof(*vdata->no), __func__);
+    vdata->mask = MEM_malloc_arrayN(totvert, sizeof(*vdata->mask), __func__);
+    vdata->visible = MEM_malloc_arrayN(totvert, sizeof(*vdata->visible), __func__);
+    vdata->index = node->vert_indices;
+    vdata->totvert = totvert;
+    node->vertex_data = vdata;
+  }
+
+  const MVert *mverts = pbvh->verts;
+  const float *vmask = CustomData_get_layer(pbvh->vdata, CD_PAINT_MASK);
+  for (int i = 0; i < totvert; i++) {
+    const int v = node->vert_indices[i];
+    const MVert *mv = &mverts[v];
+    copy_v3_v3(vdata->co[i], mv->co);
+    normal_short_to_float_v3(vdata->no[i], mv->no);
+    vdata->mask[i] = vmask ? vmask[v] : 0.0f;
+    vdata->visible[i] = !(pbvh->respect_hide && (mv->flag & ME_HIDE));
+  }
+
+  return vdata;
 }
 
 void BKE_pbvh_gather_proxies(PBVH *pbvh, PBVHNode ***r_array, int *r_tot)
@@ -69,6 +69,10 @@ struct PBVHNode {
    * they appear in another node's vert_indices array, they will
    * be above that node's 'uniq_verts' value.
    *
+   * Both parts of the array are sorted by vertex index, so that
+   * iterating over the node vertices goes through the mesh vertex
+   * arrays (coordinates, masks, colors) in memory order.
+   *
    * Used for leaf nodes in a mesh-based PBVH (not multires.)
    */
   const int *vert_indices;
@@ -84,9 +88,12 @@ struct PBVHNode {
    */
   const int (*face_vert_indices)[3];
 
+  /* Face normals accumulated into the node vertices, only during normals update. */
+  float (*normals_accum)[3];
+
   /* Indicates whether this node is a leaf or not; also used for
    * marking various updates that need to be applied. */
-  PBVHNodeFlags flag : 16;
+  PBVHNodeFlags flag : 32;
 
   /* Used for raycasting: how close bb is to the ray point. */
   float tmin;
@@ -97,6 +104,9 @@ struct PBVHNode {
   int proxy_count;
   PBVHProxyNode *proxies;
 
+  /* Node-local copy of the vertices for brushes, freed with the proxies. */
+  PBVHVertexData *vertex_data;
+
   /* Dyntopo */
   GSet *bm_faces;
   GSet *bm_unique_verts;
@@ -154,6 +164,10 @@ struct PBVH {
    * don't need to remain valid after */
   BLI_bitmap *vert_bitmap;
 
+  /* Face normals accumulated into vertices shared by several nodes during normals update,
+   * allocated on first update and zeroed again once normals are stored. */
+  float (*vert_normals_accum)[3];
+
 #ifdef PERFCNTRS
   int perf_modified;
 #endif
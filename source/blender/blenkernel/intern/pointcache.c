@@ -116,6 +116,9 @@
 /* could be made into a pointcache option */
 #define DURIAN_POINTCACHE_LIB_OK 1
 
+/* Number of points read or written at once in uncompressed cache files. */
+#define PTCACHE_FILE_POINTS_CHUNK 4096
+
 static CLG_LogRef LOG = {"bke.pointcache"};
 
 static int ptcache_data_size[] = {
@@ -1641,31 +1644,92 @@ static int ptcache_file_write(PTCacheFile *pf, const void *f, unsigned int tot,
 {
   return (fwrite(f, size, tot, pf->fp) == tot);
 }
-static int ptcache_file_data_read(PTCacheFile *pf)
+/* Size of all data types of one point, stored together in uncompressed files. */
+static unsigned int ptcache_file_point_size(unsigned int data_types)
 {
-  int i;
+  unsigned int size = 0;
+  for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+    if (data_types & (1 << i)) {
+      size += (unsigned int)ptcache_data_size[i];
+    }
+  }
+  return size;
+}
+/* Read all points of an uncompressed file in chunks, instead of per data type of each point. */
+static int ptcache_file_points_read(PTCacheFile *pf, PTCacheMem *pm)
+{
+  const unsigned int point_size = ptcache_file_point_size(pm->data_types);
+  const unsigned int chunk_len = MIN2(pm->totpoint, PTCACHE_FILE_POINTS_CHUNK);
+  int error = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_read(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  if (point_size == 0 || chunk_len == 0) {
+    return 1;
+  }
+
+  char *buf = MEM_mallocN((size_t)point_size * chunk_len, "PTCache file points");
+
+  for (unsigned int start = 0; start < pm->totpoint; start += chunk_len) {
+    const unsigned int len = MIN2(chunk_len, pm->totpoint - start);
+    if (!ptcache_file_read(pf, buf, len, point_size)) {
+      error = 1;
+      break;
+    }
+
+    const char *buf_cur = buf;
+    for (unsigned int p = start; p < start + len; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pm->data_types & (1 << i)) {
+          const size_t size = (size_t)ptcache_data_size[i];
+          memcpy((char *)pm->data[i] + p * size, buf_cur, size);
+          buf_cur += size;
+        }
+      }
     }
   }
 
-  return 1;
+  MEM_freeN(buf);
+  return error == 0;
 }
-static int ptcache_file_data_write(PTCacheFile *pf)
+/* Write all points to an uncompressed file in chunks, see #ptcache_file_points_read. */
+static int ptcache_file_points_write(PTCacheFile *pf, const PTCacheMem *pm)
 {
-  int i;
+  const unsigned int point_size = ptcache_file_point_size(pm->data_types);
+  const unsigned int chunk_len = MIN2(pm->totpoint, PTCACHE_FILE_POINTS_CHUNK);
+  int error = 0;
 
-  for (i = 0; i < BPHYS_TOT_DATA; i++) {
-    if ((pf->data_types & (1 << i)) &&
-        !ptcache_file_write(pf, pf->cur[i], 1, ptcache_data_size[i])) {
-      return 0;
+  if (point_size == 0 || chunk_len == 0) {
+    return 1;
+  }
+
+  char *buf = MEM_mallocN((size_t)point_size * chunk_len, "PTCache file points");
+
+  for (unsigned int start = 0; start < pm->totpoint; start += chunk_len) {
+    const unsigned int len = MIN2(chunk_len, pm->totpoint - start);
+
+    char *buf_cur = buf;
+    for (unsigned int p = start; p < start + len; p++) {
+      for (int i = 0; i < BPHYS_TOT_DATA; i++) {
+        if (pm->data_types & (1 << i)) {
+          const size_t size = (size_t)ptcache_data_size[i];
+          if (pm->data[i]) {
+            memcpy(buf_cur, (const char *)pm->data[i] + p * size, size);
+          }
+          else {
+            memset(buf_cur, 0, size);
+          }
+          buf_cur += size;
+        }
+      }
+    }
+
+    if (!ptcache_file_write(pf, buf, len, point_size)) {
+      error = 1;
+      break;
     }
   }
 
-  return 1;
+  MEM_freeN(buf);
+  return error == 0;
 }
 static int ptcache_file_header_begin_read(PTCacheFile *pf)
 {
@@ -1974,19 +2038,8 @@ static PTCacheMem *ptcache_disk_frame_to_mem(PTCacheID *pid, int cfra)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        if (!ptcache_file_data_read(pf)) {
-          error = 1;
-          break;
-        }
-        ptcache_data_copy(pf->cur, cur);
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_read(pf, pm)) {
+      error = 1;
     }
   }
 
@@ -2076,19 +2129,8 @@ static int ptcache_mem_frame_to_disk(PTCacheID *pid, PTCacheMem *pm)
         }
       }
     }
-    else {
-      void *cur[BPHYS_TOT_DATA];
-      BKE_ptcache_mem_pointers_init(pm, cur);
-      ptcache_file_pointers_init(pf);
-
-      for (i = 0; i < pm->totpoint; i++) {
-        ptcache_data_copy(cur, pf->cur);
-        if (!ptcache_file_data_write(pf)) {
-          error = 1;
-          break;
-        }
-        BKE_ptcache_mem_pointers_incr(cur);
-      }
+    else if (!ptcache_file_points_write(pf, pm)) {
+      error = 1;
     }
   }
 
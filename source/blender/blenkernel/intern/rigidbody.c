@@ -35,6 +35,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -1696,18 +1697,46 @@ static void rigidbody_update_sim_world(Scene *scene, RigidBodyWorld *rbw)
   rigidbody_update_ob_array(rbw);
 }
 
-static void rigidbody_update_sim_ob(
-    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object *ob, RigidBodyOb *rbo)
+/**
+ * Effectors evaluated once for all objects of the world, to update the objects in parallel.
+ * Only used when the evaluation of the effectors doesn't depend on the affected object.
+ */
+typedef struct RigidBodySharedEffectors {
+  ListBase *effectors;
+  bool use;
+} RigidBodySharedEffectors;
+
+/**
+ * Noise uses the random number generator stored in the effector settings, reseeded each time the
+ * effectors are created, and particle effectors evaluate the particle state of the effector.
+ * Neither can be shared between objects updated in parallel.
+ */
+static bool rigidbody_effectors_can_share(ListBase *effectors)
+{
+  if (effectors == NULL) {
+    return true;
+  }
+  LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+    if (eff->psys != NULL || eff->pd->f_noise > 0.0f) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void rigidbody_update_sim_ob(Depsgraph *depsgraph,
+                                    Scene *scene,
+                                    RigidBodyWorld *rbw,
+                                    Object *ob,
+                                    RigidBodyOb *rbo,
+                                    const bool is_selected,
+                                    const RigidBodySharedEffectors *shared_effectors)
 {
   /* only update if rigid body exists */
   if (rbo->shared->physics_object == NULL) {
     return;
   }
 
-  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
-  Base *base = BKE_view_layer_base_find(view_layer, ob);
-  const bool is_selected = base ? (base->flag & BASE_SELECTED) != 0 : false;
-
   if (rbo->shape == RB_SHAPE_TRIMESH && rbo->flag & RBO_FLAG_USE_DEFORM) {
     Mesh *mesh = ob->runtime.mesh_deform_eval;
     if (mesh) {
@@ -1757,7 +1786,9 @@ static void rigidbody_update_sim_ob(
     ListBase *effectors;
 
     /* get effectors present in the group specified by effector_weights */
-    effectors = BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
+    effectors = shared_effectors->use ?
+                    shared_effectors->effectors :
+                    BKE_effectors_create(depsgraph, ob, NULL, effector_weights, false);
     if (effectors) {
       float eff_force[3] = {0.0f, 0.0f, 0.0f};
       float eff_loc[3], eff_vel[3];
@@ -1792,7 +1823,9 @@ static void rigidbody_update_sim_ob(
     }
 
     /* cleanup */
-    BKE_effectors_free(effectors);
+    if (!shared_effectors->use) {
+      BKE_effectors_free(effectors);
+    }
   }
   /* NOTE: passive objects don't need to be updated since they don't move */
 
@@ -1801,6 +1834,85 @@ static void rigidbody_update_sim_ob(
    */
 }
 
+typedef struct RigidBodyUpdateSimObData {
+  Depsgraph *depsgraph;
+  Scene *scene;
+  RigidBodyWorld *rbw;
+  Object **objects;
+  bool *is_selected;
+  const RigidBodySharedEffectors *shared_effectors;
+} RigidBodyUpdateSimObData;
+
+static void rigidbody_update_sim_ob_task_cb(void *__restrict userdata,
+                                            const int i,
+                                            const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  RigidBodyUpdateSimObData *data = userdata;
+  Object *ob = data->objects[i];
+
+  rigidbody_update_sim_ob(data->depsgraph,
+                          data->scene,
+                          data->rbw,
+                          ob,
+                          ob->rigidbody_object,
+                          data->is_selected[i],
+                          data->shared_effectors);
+}
+
+/**
+ * Update the simulation objects of the world. Bullet bodies and shapes are separate per object,
+ * so objects can be updated in parallel once the effectors are known to be shareable.
+ */
+static void rigidbody_update_sim_objects(
+    Depsgraph *depsgraph, Scene *scene, RigidBodyWorld *rbw, Object **objects, int objects_num)
+{
+  if (objects_num == 0) {
+    return;
+  }
+
+  /* Look up the bases beforehand, the view layer creates its base hash lazily. */
+  ViewLayer *view_layer = DEG_get_input_view_layer(depsgraph);
+  bool *is_selected = MEM_malloc_arrayN(objects_num, sizeof(bool), __func__);
+  for (int i = 0; i < objects_num; i++) {
+    Base *base = BKE_view_layer_base_find(view_layer, objects[i]);
+    is_selected[i] = base ? (base->flag & BASE_SELECTED) != 0 : false;
+  }
+
+  RigidBodySharedEffectors shared_effectors;
+  shared_effectors.effectors = BKE_effectors_create(
+      depsgraph, NULL, NULL, rbw->effector_weights, false);
+  shared_effectors.use = rigidbody_effectors_can_share(shared_effectors.effectors);
+
+  if (shared_effectors.use) {
+    RigidBodyUpdateSimObData data = {
+        .depsgraph = depsgraph,
+        .scene = scene,
+        .rbw = rbw,
+        .objects = objects,
+        .is_selected = is_selected,
+        .shared_effectors = &shared_effectors,
+    };
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = (objects_num > 256);
+    BLI_task_parallel_range(0, objects_num, &data, rigidbody_update_sim_ob_task_cb, &settings);
+  }
+  else {
+    for (int i = 0; i < objects_num; i++) {
+      rigidbody_update_sim_ob(depsgraph,
+                              scene,
+                              rbw,
+                              objects[i],
+                              objects[i]->rigidbody_object,
+                              is_selected[i],
+                              &shared_effectors);
+    }
+  }
+
+  BKE_effectors_free(shared_effectors.effectors);
+  MEM_freeN(is_selected);
+}
+
 /**
  * Updates and validates world, bodies and shapes.
  *
@@ -1841,6 +1953,11 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
   }
 
   /* update objects */
+  ListBase group_objects = BKE_collection_object_cache_get(rbw->group);
+  Object **objects = MEM_malloc_arrayN(
+      BLI_listbase_count(&group_objects), sizeof(Object *), __func__);
+  int objects_num = 0;
+
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
       /* validate that we've got valid object set up here... */
@@ -1890,11 +2007,14 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
       rbo->flag &= ~(RBO_FLAG_NEEDS_VALIDATE | RBO_FLAG_NEEDS_RESHAPE);
 
       /* update simulation object... */
-      rigidbody_update_sim_ob(depsgraph, scene, rbw, ob, rbo);
+      objects[objects_num++] = ob;
     }
   }
   FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
 
+  rigidbody_update_sim_objects(depsgraph, scene, rbw, objects, objects_num);
+  MEM_freeN(objects);
+
   /* update constraints */
   if (rbw->constraints == NULL) { /* no constraints, move on */
     return;
@@ -15,6 +15,7 @@
  */
 
 #include "BLI_array.hh"
+#include "BLI_map.hh"
 #include "BLI_span.hh"
 #include "BLI_virtual_array.hh"
 
@@ -284,7 +285,8 @@ static void calculate_basis_for_point(const float parameter,
                                       const int order,
                                       Span<float> knots,
                                       MutableSpan<float> basis_buffer,
-                                      NURBSpline::BasisCache &basis_cache)
+                                      MutableSpan<float> r_weights,
+                                      int &r_start_index)
 {
   /* Clamp parameter due to floating point inaccuracy. */
   const float t = std::clamp(parameter, knots[0], knots[size + order - 1]);
@@ -333,74 +335,152 @@ static void calculate_basis_for_point(const float parameter,
     end--;
   }
 
-  basis_cache.weights.clear();
-  basis_cache.weights.extend(basis_buffer.slice(start, end - start + 1));
-  basis_cache.start_index = start;
+  const int weights_len = end - start + 1;
+  BLI_assert(weights_len <= order);
+  r_weights.take_front(weights_len).copy_from(basis_buffer.slice(start, weights_len));
+  r_weights.drop_front(weights_len).fill(0.0f);
+  r_start_index = start;
 }
 
-Span<NURBSpline::BasisCache> NURBSpline::calculate_basis_cache() const
+namespace {
+
+/** The parameters the knots (and so the basis without control point weights) depend on. */
+struct BasisCacheKey {
+  int size;
+  int resolution;
+  int order;
+  bool is_cyclic;
+  NURBSpline::KnotsMode knots_mode;
+
+  uint64_t hash() const
+  {
+    return blender::get_default_hash_3(size, resolution, order) ^
+           blender::get_default_hash_2(is_cyclic, static_cast<int>(knots_mode));
+  }
+
+  friend bool operator==(const BasisCacheKey &a, const BasisCacheKey &b)
+  {
+    return a.size == b.size && a.resolution == b.resolution && a.order == b.order &&
+           a.is_cyclic == b.is_cyclic && a.knots_mode == b.knots_mode;
+  }
+};
+
+}  // namespace
+
+/**
+ * Basis caches of splines without custom control point weights, which are identical for all
+ * splines with the same #BasisCacheKey. Many curves often share the same settings, e.g. for hair.
+ */
+static blender::RawMap<BasisCacheKey, std::shared_ptr<const NURBSpline::BasisCache>>
+    shared_basis_caches;
+static std::mutex shared_basis_caches_mutex;
+/** Avoid keeping the caches of too many different spline sizes alive. */
+static constexpr int SHARED_BASIS_CACHES_MAX = 256;
+
+static std::shared_ptr<NURBSpline::BasisCache> calculate_basis(const int size,
+                                                               const int order,
+                                                               const bool is_cyclic,
+                                                               const int eval_size,
+                                                               const int edges_size,
+                                                               Span<float> knots)
+{
+  std::shared_ptr<NURBSpline::BasisCache> basis = std::make_shared<NURBSpline::BasisCache>();
+  basis->weights.reinitialize(eval_size * order);
+  basis->start_indices.reinitialize(eval_size);
+
+  /* This buffer is reused by each basis calculation to store temporary values.
+   * Theoretically it could be optimized away in the future. */
+  Array<float> basis_buffer(knots.size());
+
+  const float start = knots[order - 1];
+  const float end = is_cyclic ? knots[size + order - 1] : knots[size];
+  const float step = (end - start) / edges_size;
+  float parameter = start;
+  for (const int i : IndexRange(eval_size)) {
+    calculate_basis_for_point(parameter,
+                              size + (is_cyclic ? order - 1 : 0),
+                              order,
+                              knots,
+                              basis_buffer,
+                              MutableSpan<float>(basis->weights).slice(i * order, order),
+                              basis->start_indices[i]);
+    parameter += step;
+  }
+  return basis;
+}
+
+const NURBSpline::BasisCache &NURBSpline::calculate_basis_cache() const
 {
   if (!basis_cache_dirty_) {
-    return basis_cache_;
+    return *basis_cache_;
   }
 
   std::lock_guard lock{basis_cache_mutex_};
   if (!basis_cache_dirty_) {
-    return basis_cache_;
+    return *basis_cache_;
   }
 
   const int size = this->size();
   const int eval_size = this->evaluated_points_size();
   if (eval_size == 0) {
-    return {};
+    static const BasisCache empty_basis_cache;
+    return empty_basis_cache;
   }
 
-  basis_cache_.resize(eval_size);
-
   const int order = this->order();
-  Span<float> control_weights = this->weights();
-  Span<float> knots = this->knots();
+  const BasisCacheKey key{size, resolution_, order, is_cyclic_, this->knots_mode};
 
-  MutableSpan<BasisCache> basis_cache(basis_cache_);
-
-  /* This buffer is reused by each basis calculation to store temporary values.
-   * Theoretically it could be optimized away in the future. */
-  Array<float> basis_buffer(this->knots_size());
+  std::shared_ptr<const BasisCache> basis;
+  {
+    std::lock_guard shared_lock{shared_basis_caches_mutex};
+    basis = shared_basis_caches.lookup_default(key, nullptr);
+  }
+  if (!basis) {
+    basis = calculate_basis(
+        size, order, is_cyclic_, eval_size, this->evaluated_edges_size(), this->knots());
 
-  const float start = knots[order - 1];
-  const float end = is_cyclic_ ? knots[size + order - 1] : knots[size];
-  const float step = (end - start) / this->evaluated_edges_size();
-  float parameter = start;
-  for (const int i : IndexRange(eval_size)) {
-    BasisCache &basis = basis_cache[i];
-    calculate_basis_for_point(
-        parameter, size + (is_cyclic_ ? order - 1 : 0), order, knots, basis_buffer, basis);
-    BLI_assert(basis.weights.size() <= order);
-
-    for (const int j : basis.weights.index_range()) {
-      const int point_index = (basis.start_index + j) % size;
-      basis.weights[j] *= control_weights[point_index];
+    std::lock_guard shared_lock{shared_basis_caches_mutex};
+    if (shared_basis_caches.size() >= SHARED_BASIS_CACHES_MAX) {
+      shared_basis_caches.clear();
     }
+    shared_basis_caches.add_overwrite(key, basis);
+  }
 
-    parameter += step;
+  Span<float> control_weights = this->weights();
+  const bool has_custom_weights = std::any_of(control_weights.begin(),
+                                              control_weights.end(),
+                                              [](const float weight) { return weight != 1.0f; });
+  if (has_custom_weights) {
+    std::shared_ptr<BasisCache> weighted_basis = std::make_shared<BasisCache>(*basis);
+    MutableSpan<float> weights = weighted_basis->weights;
+    for (const int i : IndexRange(eval_size)) {
+      const int start_index = weighted_basis->start_indices[i];
+      for (const int j : IndexRange(order)) {
+        const int point_index = (start_index + j) % size;
+        weights[i * order + j] *= control_weights[point_index];
+      }
+    }
+    basis = std::move(weighted_basis);
   }
 
+  basis_cache_ = std::move(basis);
   basis_cache_dirty_ = false;
-  return basis_cache_;
+  return *basis_cache_;
 }
 
 template<typename T>
-void interpolate_to_evaluated_impl(Span<NURBSpline::BasisCache> weights,
+void interpolate_to_evaluated_impl(const NURBSpline::BasisCache &basis_cache,
+                                   const int order,
                                    const blender::VArray<T> &src,
                                    MutableSpan<T> dst)
 {
   const int size = src.size();
-  BLI_assert(dst.size() == weights.size());
+  BLI_assert(dst.size() == basis_cache.start_indices.size());
   blender::attribute_math::DefaultMixer<T> mixer(dst);
 
   for (const int i : dst.index_range()) {
-    Span<float> point_weights = weights[i].weights;
-    const int start_index = weights[i].start_index;
+    Span<float> point_weights = basis_cache.weights.as_span().slice(i * order, order);
+    const int start_index = basis_cache.start_indices[i];
     for (const int j : point_weights.index_range()) {
       const int point_index = (start_index + j) % size;
       mixer.mix_in(i, src[point_index], point_weights[j]);
@@ -418,14 +498,14 @@ GVArrayPtr NURBSpline::interpolate_to_evaluated(const GVArray &src) const
     return src.shallow_copy();
   }
 
-  Span<BasisCache> basis_cache = this->calculate_basis_cache();
+  const BasisCache &basis_cache = this->calculate_basis_cache();
 
   GVArrayPtr new_varray;
   blender::attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
     using T = decltype(dummy);
     if constexpr (!std::is_void_v<blender::attribute_math::DefaultMixer<T>>) {
       Array<T> values(this->evaluated_points_size());
-      interpolate_to_evaluated_impl<T>(basis_cache, src.typed<T>(), values);
+      interpolate_to_evaluated_impl<T>(basis_cache, this->order(), src.typed<T>(), values);
       new_varray = std::make_unique<GVArray_For_ArrayContainer<Array<T>>>(std::move(values));
     }
   });
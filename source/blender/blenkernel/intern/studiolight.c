@@ -36,6 +36,7 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.h"
+#include "BLI_threads.h"
 
 #include "DNA_listBase.h"
 
@@ -51,6 +52,10 @@
 /* Statics */
 static ListBase studiolights;
 static int last_studiolight_id = 0;
+/* The studio-light files are only searched on first use, which background jobs often never need.
+ */
+static bool studiolight_files_added = false;
+static ThreadMutex studiolight_files_mutex = BLI_MUTEX_INITIALIZER;
 #define STUDIOLIGHT_RADIANCE_CUBEMAP_SIZE 96
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT 32
 #define STUDIOLIGHT_IRRADIANCE_EQUIRECT_WIDTH (STUDIOLIGHT_IRRADIANCE_EQUIRECT_HEIGHT * 2)
@@ -1403,16 +1408,8 @@ void BKE_studiolight_default(SolidLight lights[4], float light_ambient[3])
 }
 
 /* API */
-void BKE_studiolight_init(void)
+static void studiolight_add_files(void)
 {
-  /* Add default studio light */
-  StudioLight *sl = studiolight_create(
-      STUDIOLIGHT_INTERNAL | STUDIOLIGHT_SPHERICAL_HARMONICS_COEFFICIENTS_CALCULATED |
-      STUDIOLIGHT_TYPE_STUDIO | STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
-  BLI_strncpy(sl->name, "Default", FILE_MAXFILE);
-
-  BLI_addtail(&studiolights, sl);
-
   /* Go over the preset folder and add a studio-light for every image with its path. */
   /* For portable installs (where USER and SYSTEM paths are the same),
    * only go over LOCAL data-files once. */
@@ -1440,6 +1437,35 @@ void BKE_studiolight_init(void)
 
   /* sort studio lights on filename. */
   BLI_listbase_sort(&studiolights, studiolight_cmp);
+}
+
+/* Add the studio-lights of the data folders, if not done yet. */
+static void studiolight_ensure_files(void)
+{
+  if (studiolight_files_added) {
+    return;
+  }
+
+  BLI_mutex_lock(&studiolight_files_mutex);
+  if (!studiolight_files_added) {
+    studiolight_add_files();
+    studiolight_files_added = true;
+  }
+  BLI_mutex_unlock(&studiolight_files_mutex);
+}
+
+void BKE_studiolight_init(void)
+{
+  /* Add default studio light */
+  StudioLight *sl = studiolight_create(
+      STUDIOLIGHT_INTERNAL | STUDIOLIGHT_SPHERICAL_HARMONICS_COEFFICIENTS_CALCULATED |
+      STUDIOLIGHT_TYPE_STUDIO | STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
+  BLI_strncpy(sl->name, "Default", FILE_MAXFILE);
+
+  BLI_addtail(&studiolights, sl);
+
+  /* The files are added on first use of the studio-lights. */
+  studiolight_files_added = false;
 
   BKE_studiolight_default(sl->light, sl->light_ambient);
 }
@@ -1454,6 +1480,8 @@ void BKE_studiolight_free(void)
 
 struct StudioLight *BKE_studiolight_find_default(int flag)
 {
+  studiolight_ensure_files();
+
   const char *default_name = "";
 
   if (flag & STUDIOLIGHT_TYPE_WORLD) {
@@ -1479,6 +1507,8 @@ struct StudioLight *BKE_studiolight_find_default(int flag)
 
 struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 {
+  studiolight_ensure_files();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (STREQLEN(sl->name, name, FILE_MAXFILE)) {
       if (sl->flag & flag) {
@@ -1495,6 +1525,8 @@ struct StudioLight *BKE_studiolight_find(const char *name, int flag)
 
 struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 {
+  studiolight_ensure_files();
+
   LISTBASE_FOREACH (StudioLight *, sl, &studiolights) {
     if (sl->index == index) {
       return sl;
@@ -1506,6 +1538,8 @@ struct StudioLight *BKE_studiolight_findindex(int index, int flag)
 
 struct ListBase *BKE_studiolight_listbase(void)
 {
+  studiolight_ensure_files();
+
   return &studiolights;
 }
 
@@ -1582,6 +1616,8 @@ void BKE_studiolight_remove(StudioLight *sl)
 
 StudioLight *BKE_studiolight_load(const char *path, int type)
 {
+  studiolight_ensure_files();
+
   StudioLight *sl = studiolight_add_file(path, type | STUDIOLIGHT_USER_DEFINED);
   return sl;
 }
@@ -1590,6 +1626,8 @@ StudioLight *BKE_studiolight_create(const char *path,
                                     const SolidLight light[4],
                                     const float light_ambient[3])
 {
+  studiolight_ensure_files();
+
   StudioLight *sl = studiolight_create(STUDIOLIGHT_EXTERNAL_FILE | STUDIOLIGHT_USER_DEFINED |
                                        STUDIOLIGHT_TYPE_STUDIO |
                                        STUDIOLIGHT_SPECULAR_HIGHLIGHT_PASS);
@@ -40,6 +40,7 @@
 #include "BKE_subdiv.h"
 #include "BKE_subdiv_eval.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
 /* -------------------------------------------------------------------- */
@@ -183,6 +184,16 @@ typedef struct CCGEvalGridsData {
   SubdivCCGMaterialFlagsEvaluator *material_flags_evaluator;
 } CCGEvalGridsData;
 
+typedef struct CCGEvalGridsTLS {
+  /* Patch coordinates of the elements of a grid and their evaluated limit points, normals and
+   * derivatives, for batched evaluation. Allocated on first use. */
+  OpenSubdiv_PatchCoord *patch_coords;
+  float (*P)[3];
+  float (*N)[3];
+  float (*dPdu)[3];
+  float (*dPdv)[3];
+} CCGEvalGridsTLS;
+
 static void subdiv_ccg_eval_grid_element_limit(CCGEvalGridsData *data,
                                                const int ptex_face_index,
                                                const float u,
@@ -236,13 +247,54 @@ static void subdiv_ccg_eval_grid_element(CCGEvalGridsData *data,
   subdiv_ccg_eval_grid_element_mask(data, ptex_face_index, u, v, element);
 }
 
-static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_index)
+static void subdiv_ccg_eval_grid_elements(CCGEvalGridsData *data,
+                                          CCGEvalGridsTLS *tls,
+                                          unsigned char *grid)
+{
+  Subdiv *subdiv = data->subdiv;
+  SubdivCCG *subdiv_ccg = data->subdiv_ccg;
+  const int grid_area = subdiv_ccg->grid_size * subdiv_ccg->grid_size;
+  const int element_size = element_size_bytes_get(subdiv_ccg);
+  const OpenSubdiv_PatchCoord *patch_coords = tls->patch_coords;
+
+  /* Displacement needs the derivatives of each point, evaluate it per element. */
+  if (subdiv->displacement_evaluator != NULL) {
+    for (int i = 0; i < grid_area; i++) {
+      subdiv_ccg_eval_grid_element(data,
+                                   patch_coords[i].ptex_face,
+                                   patch_coords[i].u,
+                                   patch_coords[i].v,
+                                   &grid[(size_t)i * element_size]);
+    }
+    return;
+  }
+
+  BKE_subdiv_eval_limit_patch_coords_and_normals(subdiv,
+                                                 patch_coords,
+                                                 grid_area,
+                                                 tls->P,
+                                                 subdiv_ccg->has_normal ? tls->N : NULL,
+                                                 tls->dPdu,
+                                                 tls->dPdv);
+  for (int i = 0; i < grid_area; i++) {
+    unsigned char *element = &grid[(size_t)i * element_size];
+    copy_v3_v3((float *)element, tls->P[i]);
+    if (subdiv_ccg->has_normal) {
+      copy_v3_v3((float *)(element + subdiv_ccg->normal_offset), tls->N[i]);
+    }
+    subdiv_ccg_eval_grid_element_mask(
+        data, patch_coords[i].ptex_face, patch_coords[i].u, patch_coords[i].v, element);
+  }
+}
+
+static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data,
+                                         CCGEvalGridsTLS *tls,
+                                         const int face_index)
 {
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   const int ptex_face_index = data->face_ptex_offset[face_index];
   const int grid_size = subdiv_ccg->grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
@@ -253,13 +305,12 @@ static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_
       const float grid_v = y * grid_size_1_inv;
       for (int x = 0; x < grid_size; x++) {
         const float grid_u = x * grid_size_1_inv;
-        float u, v;
-        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &u, &v);
-        const size_t grid_element_index = (size_t)y * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+        OpenSubdiv_PatchCoord *patch_coord = &tls->patch_coords[(size_t)y * grid_size + x];
+        patch_coord->ptex_face = ptex_face_index;
+        BKE_subdiv_rotate_grid_to_quad(corner, grid_u, grid_v, &patch_coord->u, &patch_coord->v);
       }
     }
+    subdiv_ccg_eval_grid_elements(data, tls, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
@@ -268,12 +319,13 @@ static void subdiv_ccg_eval_regular_grid(CCGEvalGridsData *data, const int face_
   }
 }
 
-static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_index)
+static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data,
+                                         CCGEvalGridsTLS *tls,
+                                         const int face_index)
 {
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   const int grid_size = subdiv_ccg->grid_size;
   const float grid_size_1_inv = 1.0f / (grid_size - 1);
-  const int element_size = element_size_bytes_get(subdiv_ccg);
   SubdivCCGFace *faces = subdiv_ccg->faces;
   SubdivCCGFace **grid_faces = subdiv_ccg->grid_faces;
   const SubdivCCGFace *face = &faces[face_index];
@@ -285,11 +337,13 @@ static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_
       const float u = 1.0f - (y * grid_size_1_inv);
       for (int x = 0; x < grid_size; x++) {
         const float v = 1.0f - (x * grid_size_1_inv);
-        const size_t grid_element_index = (size_t)y * grid_size + x;
-        const size_t grid_element_offset = grid_element_index * element_size;
-        subdiv_ccg_eval_grid_element(data, ptex_face_index, u, v, &grid[grid_element_offset]);
+        OpenSubdiv_PatchCoord *patch_coord = &tls->patch_coords[(size_t)y * grid_size + x];
+        patch_coord->ptex_face = ptex_face_index;
+        patch_coord->u = u;
+        patch_coord->v = v;
       }
     }
+    subdiv_ccg_eval_grid_elements(data, tls, grid);
     /* Assign grid's face. */
     grid_faces[grid_index] = &faces[face_index];
     /* Assign material flags. */
@@ -300,19 +354,39 @@ static void subdiv_ccg_eval_special_grid(CCGEvalGridsData *data, const int face_
 
 static void subdiv_ccg_eval_grids_task(void *__restrict userdata_v,
                                        const int face_index,
-                                       const TaskParallelTLS *__restrict UNUSED(tls))
+                                       const TaskParallelTLS *__restrict tls_v)
 {
   CCGEvalGridsData *data = userdata_v;
+  CCGEvalGridsTLS *tls = tls_v->userdata_chunk;
   SubdivCCG *subdiv_ccg = data->subdiv_ccg;
   SubdivCCGFace *face = &subdiv_ccg->faces[face_index];
+  if (tls->patch_coords == NULL) {
+    const int grid_area = subdiv_ccg->grid_size * subdiv_ccg->grid_size;
+    tls->patch_coords = MEM_malloc_arrayN(grid_area, sizeof(*tls->patch_coords), __func__);
+    tls->P = MEM_malloc_arrayN(grid_area, sizeof(*tls->P), __func__);
+    tls->N = MEM_malloc_arrayN(grid_area, sizeof(*tls->N), __func__);
+    tls->dPdu = MEM_malloc_arrayN(grid_area, sizeof(*tls->dPdu), __func__);
+    tls->dPdv = MEM_malloc_arrayN(grid_area, sizeof(*tls->dPdv), __func__);
+  }
   if (face->num_grids == 4) {
-    subdiv_ccg_eval_regular_grid(data, face_index);
+    subdiv_ccg_eval_regular_grid(data, tls, face_index);
   }
   else {
-    subdiv_ccg_eval_special_grid(data, face_index);
+    subdiv_ccg_eval_special_grid(data, tls, face_index);
   }
 }
 
+static void subdiv_ccg_eval_grids_free(const void *__restrict UNUSED(userdata),
+                                       void *__restrict tls_v)
+{
+  CCGEvalGridsTLS *tls = tls_v;
+  MEM_SAFE_FREE(tls->patch_coords);
+  MEM_SAFE_FREE(tls->P);
+  MEM_SAFE_FREE(tls->N);
+  MEM_SAFE_FREE(tls->dPdu);
+  MEM_SAFE_FREE(tls->dPdv);
+}
+
 static bool subdiv_ccg_evaluate_grids(SubdivCCG *subdiv_ccg,
                                       Subdiv *subdiv,
                                       SubdivCCGMaskEvaluator *mask_evaluator,
@@ -328,8 +402,12 @@ static bool subdiv_ccg_evaluate_grids(SubdivCCG *subdiv_ccg,
   data.mask_evaluator = mask_evaluator;
   data.material_flags_evaluator = material_flags_evaluator;
   /* Threaded grids evaluation. */
+  CCGEvalGridsTLS tls = {NULL};
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
+  parallel_range_settings.userdata_chunk = &tls;
+  parallel_range_settings.userdata_chunk_size = sizeof(tls);
+  parallel_range_settings.func_free = subdiv_ccg_eval_grids_free;
   BLI_task_parallel_range(
       0, num_faces, &data, subdiv_ccg_eval_grids_task, &parallel_range_settings);
   /* If displacement is used, need to calculate normals after all final
@@ -35,6 +35,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.h"
 #include "opensubdiv_evaluator_capi.h"
 #include "opensubdiv_topology_refiner_capi.h"
 
@@ -80,21 +81,35 @@ static void set_coarse_positions(Subdiv *subdiv,
       BLI_BITMAP_ENABLE(vertex_used_map, loop->v);
     }
   }
-  for (int vertex_index = 0, manifold_vertex_index = 0; vertex_index < mesh->totvert;
-       vertex_index++) {
+  /* Upload contiguous ranges of used vertices at once, which in the common case of a mesh without
+   * loose vertices is a single range. This avoids going through the evaluator for every vertex
+   * on each update of the coarse cage. */
+  int manifold_vertex_index = 0;
+  int vertex_index = 0;
+  while (vertex_index < mesh->totvert) {
     if (!BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
+      vertex_index++;
       continue;
     }
-    const float *vertex_co;
+    const int range_start = vertex_index;
+    while (vertex_index < mesh->totvert && BLI_BITMAP_TEST_BOOL(vertex_used_map, vertex_index)) {
+      vertex_index++;
+    }
+    const int range_len = vertex_index - range_start;
     if (coarse_vertex_cos != NULL) {
-      vertex_co = coarse_vertex_cos[vertex_index];
+      subdiv->evaluator->setCoarsePositions(
+          subdiv->evaluator, coarse_vertex_cos[range_start], manifold_vertex_index, range_len);
     }
     else {
-      const MVert *vertex = &mvert[vertex_index];
-      vertex_co = vertex->co;
+      subdiv->evaluator->setCoarsePositionsFromBuffer(subdiv->evaluator,
+                                                      mvert,
+                                                      offsetof(MVert, co) +
+                                                          range_start * sizeof(MVert),
+                                                      sizeof(MVert),
+                                                      manifold_vertex_index,
+                                                      range_len);
     }
-    subdiv->evaluator->setCoarsePositions(subdiv->evaluator, vertex_co, manifold_vertex_index, 1);
-    manifold_vertex_index++;
+    manifold_vertex_index += range_len;
   }
   MEM_freeN(vertex_used_map);
 }
@@ -395,3 +410,42 @@ void BKE_subdiv_eval_limit_patch_resolution_point_and_short_normal(Subdiv *subdi
     }
   }
 }
+
+/* ============================ Batched queries ============================ */
+
+void BKE_subdiv_eval_limit_patch_coords_and_normals(Subdiv *subdiv,
+                                                    const OpenSubdiv_PatchCoord *patch_coords,
+                                                    const int num_patch_coords,
+                                                    float (*r_P)[3],
+                                                    float (*r_N)[3],
+                                                    float (*r_dPdu)[3],
+                                                    float (*r_dPdv)[3])
+{
+  if (r_N == NULL) {
+    subdiv->evaluator->evaluatePatchesLimit(
+        subdiv->evaluator, patch_coords, num_patch_coords, (float *)r_P, NULL, NULL);
+    return;
+  }
+
+  subdiv->evaluator->evaluatePatchesLimit(subdiv->evaluator,
+                                          patch_coords,
+                                          num_patch_coords,
+                                          (float *)r_P,
+                                          (float *)r_dPdu,
+                                          (float *)r_dPdv);
+  for (int i = 0; i < num_patch_coords; i++) {
+    /* Same workaround for degenerate derivatives as for single points, see
+     * #BKE_subdiv_eval_limit_point_and_derivatives. */
+    if ((is_zero_v3(r_dPdu[i]) || is_zero_v3(r_dPdv[i])) || equals_v3v3(r_dPdu[i], r_dPdv[i])) {
+      BKE_subdiv_eval_limit_point_and_derivatives(subdiv,
+                                                  patch_coords[i].ptex_face,
+                                                  patch_coords[i].u,
+                                                  patch_coords[i].v,
+                                                  r_P[i],
+                                                  r_dPdu[i],
+                                                  r_dPdv[i]);
+    }
+    cross_v3_v3v3(r_N[i], r_dPdu[i], r_dPdv[i]);
+    normalize_v3(r_N[i]);
+  }
+}
@@ -122,6 +122,12 @@ typedef struct SubdivForeachTaskContext {
    *   were already evaluated.
    */
   BLI_bitmap *coarse_edges_used_map;
+  /* Bitmaps indexed by coarse loop index, indicating whether the loop is the
+   * one which evaluates its vertex or edge in the single geometry pass. The
+   * owner is the first loop using the element, so the result does not depend
+   * on the order in which threads visit polygons. */
+  BLI_bitmap *coarse_loops_vertex_owner_map;
+  BLI_bitmap *coarse_loops_edge_owner_map;
 } SubdivForeachTaskContext;
 
 /** \} */
@@ -152,6 +158,12 @@ static void subdiv_foreach_tls_free(SubdivForeachTaskContext *ctx, void *tls)
   MEM_freeN(tls);
 }
 
+static void subdiv_foreach_free(const void *__restrict userdata, void *__restrict userdata_chunk)
+{
+  const SubdivForeachTaskContext *ctx = userdata;
+  ctx->foreach_context->user_data_tls_free(userdata_chunk);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -322,8 +334,8 @@ static void subdiv_foreach_corner_vertices_regular_do(
   const int ptex_face_index = ctx->face_ptex_offset[coarse_poly_index];
   for (int corner = 0; corner < coarse_poly->totloop; corner++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_vertices_used_map, coarse_loop->v)) {
+    if (check_usage && !BLI_BITMAP_TEST_BOOL(ctx->coarse_loops_vertex_owner_map,
+                                             coarse_poly->loopstart + corner)) {
       continue;
     }
     const int coarse_vertex_index = coarse_loop->v;
@@ -363,8 +375,8 @@ static void subdiv_foreach_corner_vertices_special_do(
   int ptex_face_index = ctx->face_ptex_offset[coarse_poly_index];
   for (int corner = 0; corner < coarse_poly->totloop; corner++, ptex_face_index++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_vertices_used_map, coarse_loop->v)) {
+    if (check_usage && !BLI_BITMAP_TEST_BOOL(ctx->coarse_loops_vertex_owner_map,
+                                             coarse_poly->loopstart + corner)) {
       continue;
     }
     const int coarse_vertex_index = coarse_loop->v;
@@ -457,8 +469,8 @@ static void subdiv_foreach_edge_vertices_regular_do(SubdivForeachTaskContext *ct
   for (int corner = 0; corner < coarse_poly->totloop; corner++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
     const int coarse_edge_index = coarse_loop->e;
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_edges_used_map, coarse_edge_index)) {
+    if (check_usage && !BLI_BITMAP_TEST_BOOL(ctx->coarse_loops_edge_owner_map,
+                                             coarse_poly->loopstart + corner)) {
       continue;
     }
     const MEdge *coarse_edge = &coarse_medge[coarse_edge_index];
@@ -525,8 +537,8 @@ static void subdiv_foreach_edge_vertices_special_do(SubdivForeachTaskContext *ct
   for (int corner = 0; corner < coarse_poly->totloop; corner++, ptex_face_index++) {
     const MLoop *coarse_loop = &coarse_mloop[coarse_poly->loopstart + corner];
     const int coarse_edge_index = coarse_loop->e;
-    if (check_usage &&
-        BLI_BITMAP_TEST_AND_SET_ATOMIC(ctx->coarse_edges_used_map, coarse_edge_index)) {
+    if (check_usage && !BLI_BITMAP_TEST_BOOL(ctx->coarse_loops_edge_owner_map,
+                                             coarse_poly->loopstart + corner)) {
       continue;
     }
     const MEdge *coarse_edge = &coarse_medge[coarse_edge_index];
@@ -1776,18 +1788,62 @@ static void subdiv_foreach_vertices_of_loose_edges_task(void *__restrict userdat
 /** \name Subdivision process entry points
  * \{ */
 
-static void subdiv_foreach_single_geometry_vertices(SubdivForeachTaskContext *ctx, void *tls)
+/* Tag the first loop using every coarse vertex and edge as its owner, and mark all the elements
+ * used by polygons as non-loose. */
+static void subdiv_foreach_single_geometry_owners_tag(SubdivForeachTaskContext *ctx)
+{
+  const Mesh *coarse_mesh = ctx->coarse_mesh;
+  const MLoop *coarse_mloop = coarse_mesh->mloop;
+  for (int loop_index = 0; loop_index < coarse_mesh->totloop; loop_index++) {
+    const MLoop *loop = &coarse_mloop[loop_index];
+    if (!BLI_BITMAP_TEST_BOOL(ctx->coarse_vertices_used_map, loop->v)) {
+      BLI_BITMAP_ENABLE(ctx->coarse_vertices_used_map, loop->v);
+      BLI_BITMAP_ENABLE(ctx->coarse_loops_vertex_owner_map, loop_index);
+    }
+    if (!BLI_BITMAP_TEST_BOOL(ctx->coarse_edges_used_map, loop->e)) {
+      BLI_BITMAP_ENABLE(ctx->coarse_edges_used_map, loop->e);
+      BLI_BITMAP_ENABLE(ctx->coarse_loops_edge_owner_map, loop_index);
+    }
+  }
+}
+
+static void subdiv_foreach_single_geometry_vertices_task(void *__restrict userdata,
+                                                         const int poly_index,
+                                                         const TaskParallelTLS *__restrict tls)
+{
+  SubdivForeachTaskContext *ctx = userdata;
+  const MPoly *coarse_poly = &ctx->coarse_mesh->mpoly[poly_index];
+  subdiv_foreach_corner_vertices(ctx, tls->userdata_chunk, coarse_poly);
+  subdiv_foreach_edge_vertices(ctx, tls->userdata_chunk, coarse_poly);
+}
+
+static void subdiv_foreach_single_geometry_vertices(SubdivForeachTaskContext *ctx)
 {
   if (ctx->foreach_context->vertex_corner == NULL) {
     return;
   }
   const Mesh *coarse_mesh = ctx->coarse_mesh;
-  const MPoly *coarse_mpoly = coarse_mesh->mpoly;
-  for (int poly_index = 0; poly_index < coarse_mesh->totpoly; poly_index++) {
-    const MPoly *coarse_poly = &coarse_mpoly[poly_index];
-    subdiv_foreach_corner_vertices(ctx, tls, coarse_poly);
-    subdiv_foreach_edge_vertices(ctx, tls, coarse_poly);
+  ctx->coarse_loops_vertex_owner_map = BLI_BITMAP_NEW(coarse_mesh->totloop,
+                                                      "loops vertex owner map");
+  ctx->coarse_loops_edge_owner_map = BLI_BITMAP_NEW(coarse_mesh->totloop, "loops edge owner map");
+  subdiv_foreach_single_geometry_owners_tag(ctx);
+  /* Every coarse vertex and edge is evaluated by its owner loop only, so polygons can be handled
+   * from multiple threads. */
+  const SubdivForeachContext *foreach_context = ctx->foreach_context;
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.userdata_chunk = foreach_context->user_data_tls;
+  settings.userdata_chunk_size = foreach_context->user_data_tls_size;
+  settings.min_iter_per_thread = 1;
+  if (foreach_context->user_data_tls_free != NULL) {
+    settings.func_free = subdiv_foreach_free;
   }
+  BLI_task_parallel_range(
+      0, coarse_mesh->totpoly, ctx, subdiv_foreach_single_geometry_vertices_task, &settings);
+  MEM_freeN(ctx->coarse_loops_vertex_owner_map);
+  MEM_freeN(ctx->coarse_loops_edge_owner_map);
+  ctx->coarse_loops_vertex_owner_map = NULL;
+  ctx->coarse_loops_edge_owner_map = NULL;
 }
 
 static void subdiv_foreach_mark_non_loose_geometry(SubdivForeachTaskContext *ctx)
@@ -1805,7 +1861,7 @@ static void subdiv_foreach_mark_non_loose_geometry(SubdivForeachTaskContext *ctx
   }
 }
 
-static void subdiv_foreach_single_thread_tasks(SubdivForeachTaskContext *ctx)
+static void subdiv_foreach_shared_geometry_tasks(SubdivForeachTaskContext *ctx)
 {
   /* NOTE: In theory, we can try to skip allocation of TLS here, but in
    * practice if the callbacks used here are not specified then TLS will not
@@ -1815,9 +1871,9 @@ static void subdiv_foreach_single_thread_tasks(SubdivForeachTaskContext *ctx)
    * and boundary edges. */
   subdiv_foreach_every_corner_vertices(ctx, tls);
   subdiv_foreach_every_edge_vertices(ctx, tls);
-  /* Run callbacks which are supposed to be run once per shared geometry. */
-  subdiv_foreach_single_geometry_vertices(ctx, tls);
   subdiv_foreach_tls_free(ctx, tls);
+  /* Run callbacks which are supposed to be run once per shared geometry. */
+  subdiv_foreach_single_geometry_vertices(ctx);
 
   const SubdivForeachContext *foreach_context = ctx->foreach_context;
   const bool is_loose_geometry_tagged = (foreach_context->vertex_every_edge != NULL &&
@@ -1856,12 +1912,6 @@ static void subdiv_foreach_boundary_edges_task(void *__restrict userdata,
   subdiv_foreach_boundary_edges(ctx, tls->userdata_chunk, edge_index);
 }
 
-static void subdiv_foreach_free(const void *__restrict userdata, void *__restrict userdata_chunk)
-{
-  const SubdivForeachTaskContext *ctx = userdata;
-  ctx->foreach_context->user_data_tls_free(userdata_chunk);
-}
-
 bool BKE_subdiv_foreach_subdiv_geometry(Subdiv *subdiv,
                                         const SubdivForeachContext *context,
                                         const SubdivToMeshSettings *mesh_settings,
@@ -1882,8 +1932,8 @@ bool BKE_subdiv_foreach_subdiv_geometry(Subdiv *subdiv,
       return false;
     }
   }
-  /* Run all the code which is not supposed to be run from threads. */
-  subdiv_foreach_single_thread_tasks(&ctx);
+  /* Evaluate geometry shared between polygons before the per-polygon traversal. */
+  subdiv_foreach_shared_geometry_tasks(&ctx);
   /* Threaded traversal of the rest of topology. */
   TaskParallelSettings parallel_range_settings;
   BLI_parallel_range_settings_defaults(&parallel_range_settings);
@@ -263,32 +263,25 @@ static void vertex_interpolation_from_corner(const SubdivMeshContext *ctx,
      *
      * TODO(sergey): Re-use one of interpolation results from previous
      * iteration. */
-    const float weights[2] = {0.5f, 0.5f};
+    const float weights[4] = {0.5f, 0.5f, 0.5f, 0.5f};
     const int first_loop_index = loops_of_ptex.first_loop - coarse_mloop;
     const int last_loop_index = loops_of_ptex.last_loop - coarse_mloop;
-    const int first_indices[2] = {
+    const int src_indices[4] = {
         coarse_mloop[first_loop_index].v,
         coarse_mloop[coarse_poly->loopstart +
                      (first_loop_index - coarse_poly->loopstart + 1) % coarse_poly->totloop]
-            .v};
-    const int last_indices[2] = {
+            .v,
         coarse_mloop[first_loop_index].v,
         coarse_mloop[last_loop_index].v,
     };
-    CustomData_interp(vertex_data,
-                      &vertex_interpolation->vertex_data_storage,
-                      first_indices,
-                      weights,
-                      NULL,
-                      2,
-                      1);
-    CustomData_interp(vertex_data,
-                      &vertex_interpolation->vertex_data_storage,
-                      last_indices,
-                      weights,
-                      NULL,
-                      2,
-                      3);
+    const int dest_indices[2] = {1, 3};
+    CustomData_interp_batch(vertex_data,
+                            &vertex_interpolation->vertex_data_storage,
+                            src_indices,
+                            weights,
+                            2,
+                            dest_indices,
+                            2);
   }
 }
 
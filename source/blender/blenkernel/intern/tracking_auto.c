@@ -31,6 +31,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math.h"
+#include "BLI_path_util.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
@@ -40,6 +41,9 @@
 #include "BKE_movieclip.h"
 #include "BKE_tracking.h"
 
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+
 #include "libmv-capi.h"
 #include "tracking_private.h"
 
@@ -139,6 +143,9 @@ typedef struct AutoTrackContext {
   int synchronized_scene_frame;
 
   SpinLock spin_lock;
+
+  /* Reads frames of image sequences ahead of the tracking process. */
+  TaskPool *prefetch_pool;
 } AutoTrackContext;
 
 /* -------------------------------------------------------------------- */
@@ -564,6 +571,8 @@ AutoTrackContext *BKE_autotrack_context_new(MovieClip *clip,
 
   BLI_spin_init(&context->spin_lock);
 
+  context->prefetch_pool = BLI_task_pool_create(context, TASK_PRIORITY_LOW);
+
   return context;
 }
 
@@ -657,12 +666,86 @@ static void autotrack_context_reduce(const void *__restrict UNUSED(userdata),
   BLI_movelisttolist(&autotrack_tls_join->results, &autotrack_tls->results);
 }
 
+typedef struct AutoTrackPrefetchFrame {
+  MovieClip *clip;
+  int scene_frame;
+} AutoTrackPrefetchFrame;
+
+static void autotrack_prefetch_frame_fn(TaskPool *__restrict UNUSED(pool), void *task_data)
+{
+  const AutoTrackPrefetchFrame *prefetch_frame = (const AutoTrackPrefetchFrame *)task_data;
+  MovieClip *clip = prefetch_frame->clip;
+
+  /* Same user as the image accessor, so the frame is found in the cache by the trackers. */
+  MovieClipUser user = {0};
+  BKE_movieclip_user_set_frame(&user, prefetch_frame->scene_frame);
+  user.render_size = MCLIP_PROXY_RENDER_SIZE_FULL;
+  user.render_flag = 0;
+
+  if (BKE_movieclip_has_cached_frame(clip, &user)) {
+    return;
+  }
+
+  char filepath[FILE_MAX];
+  BKE_movieclip_filename_for_frame(clip, &user, filepath);
+
+  /* Decode without holding the movie clip lock, which the trackers need to access frames. */
+  ImBuf *ibuf = IMB_loadiffname(filepath,
+                                IB_rect | IB_multilayer | IB_alphamode_detect | IB_metadata,
+                                clip->colorspace_settings.name);
+  if (ibuf == NULL) {
+    return;
+  }
+  BKE_movieclip_convert_multilayer_ibuf(ibuf);
+  BKE_movieclip_put_frame_if_possible(clip, &user, ibuf);
+  IMB_freeImBuf(ibuf);
+}
+
+/**
+ * Start reading the frames the markers will be tracked to in the step after the current one,
+ * so they are decoded while the current step is tracking.
+ *
+ * Only done for image sequences: frames of movies are decoded from the clip's animation handle,
+ * which is only accessed under the movie clip lock.
+ */
+static void autotrack_context_prefetch_frames(AutoTrackContext *context)
+{
+  const int frame_delta = context->is_backwards ? -1 : 1;
+  bool clip_is_prefetched[MAX_ACCESSOR_CLIP] = {false};
+
+  for (int i = 0; i < context->num_autotrack_markers; i++) {
+    const libmv_Marker *libmv_marker = &context->autotrack_markers[i].libmv_marker;
+    const int clip_index = libmv_marker->clip;
+    if (clip_is_prefetched[clip_index]) {
+      continue;
+    }
+    clip_is_prefetched[clip_index] = true;
+
+    MovieClip *clip = context->autotrack_clips[clip_index].clip;
+    if (clip->source != MCLIP_SRC_SEQUENCE) {
+      continue;
+    }
+
+    AutoTrackPrefetchFrame *prefetch_frame = MEM_mallocN(sizeof(AutoTrackPrefetchFrame),
+                                                         __func__);
+    prefetch_frame->clip = clip;
+    prefetch_frame->scene_frame = BKE_movieclip_remap_clip_to_scene_frame(
+        clip, libmv_marker->frame + 2 * frame_delta);
+    BLI_task_pool_push(
+        context->prefetch_pool, autotrack_prefetch_frame_fn, prefetch_frame, true, NULL);
+  }
+}
+
 bool BKE_autotrack_context_step(AutoTrackContext *context)
 {
   if (context->num_autotrack_markers == 0) {
     return false;
   }
 
+  /* Frames read ahead by the previous step are in the cache now, read the ones for the next. */
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  autotrack_context_prefetch_frames(context);
+
   AutoTrackTLS tls;
   BLI_listbase_clear(&tls.results);
 
@@ -817,6 +900,9 @@ void BKE_autotrack_context_finish(AutoTrackContext *context)
 
 void BKE_autotrack_context_free(AutoTrackContext *context)
 {
+  BLI_task_pool_work_and_wait(context->prefetch_pool);
+  BLI_task_pool_free(context->prefetch_pool);
+
   if (context->autotrack != NULL) {
     libmv_autoTrackDestroy(context->autotrack);
   }
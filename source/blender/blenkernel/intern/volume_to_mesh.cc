@@ -18,6 +18,7 @@
 
 #include "BLI_float3.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "DNA_mesh_types.h"
@@ -46,6 +47,8 @@ struct VolumeToMeshOp {
   std::vector<openvdb::Vec3s> verts;
   std::vector<openvdb::Vec3I> tris;
   std::vector<openvdb::Vec4I> quads;
+  /* Applied while copying the vertices into the mesh, to avoid another pass over them. */
+  openvdb::Vec3s vert_offset{0.0f};
 
   template<typename GridType> bool operator()()
   {
@@ -114,49 +117,56 @@ struct VolumeToMeshOp {
         grid, this->verts, this->tris, this->quads, this->threshold, this->adaptivity);
 
     /* Better align generated mesh with volume (see T85312). */
-    openvdb::Vec3s offset = grid.voxelSize() / 2.0f;
-    for (openvdb::Vec3s &position : this->verts) {
-      position += offset;
-    }
+    this->vert_offset = grid.voxelSize() / 2.0f;
   }
 };
 
 static Mesh *new_mesh_from_openvdb_data(Span<openvdb::Vec3s> verts,
                                         Span<openvdb::Vec3I> tris,
-                                        Span<openvdb::Vec4I> quads)
+                                        Span<openvdb::Vec4I> quads,
+                                        const openvdb::Vec3s &vert_offset)
 {
   const int tot_loops = 3 * tris.size() + 4 * quads.size();
   const int tot_polys = tris.size() + quads.size();
 
   Mesh *mesh = BKE_mesh_new_nomain(verts.size(), 0, 0, tot_loops, tot_polys);
+  MutableSpan<MVert> mverts{mesh->mvert, mesh->totvert};
+  MutableSpan<MPoly> mpolys{mesh->mpoly, mesh->totpoly};
+  MutableSpan<MLoop> mloops{mesh->mloop, mesh->totloop};
 
   /* Write vertices. */
-  for (const int i : verts.index_range()) {
-    const blender::float3 co = blender::float3(verts[i].asV());
-    copy_v3_v3(mesh->mvert[i].co, co);
-  }
+  threading::parallel_for(verts.index_range(), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      const openvdb::Vec3s co = verts[i] + vert_offset;
+      copy_v3_v3(mverts[i].co, co.asV());
+    }
+  });
 
   /* Write triangles. */
-  for (const int i : tris.index_range()) {
-    mesh->mpoly[i].loopstart = 3 * i;
-    mesh->mpoly[i].totloop = 3;
-    for (int j = 0; j < 3; j++) {
-      /* Reverse vertex order to get correct normals. */
-      mesh->mloop[3 * i + j].v = tris[i][2 - j];
+  threading::parallel_for(tris.index_range(), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      mpolys[i].loopstart = 3 * i;
+      mpolys[i].totloop = 3;
+      for (int j = 0; j < 3; j++) {
+        /* Reverse vertex order to get correct normals. */
+        mloops[3 * i + j].v = tris[i][2 - j];
+      }
     }
-  }
+  });
 
   /* Write quads. */
   const int poly_offset = tris.size();
   const int loop_offset = tris.size() * 3;
-  for (const int i : quads.index_range()) {
-    mesh->mpoly[poly_offset + i].loopstart = loop_offset + 4 * i;
-    mesh->mpoly[poly_offset + i].totloop = 4;
-    for (int j = 0; j < 4; j++) {
-      /* Reverse vertex order to get correct normals. */
-      mesh->mloop[loop_offset + 4 * i + j].v = quads[i][3 - j];
+  threading::parallel_for(quads.index_range(), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      mpolys[poly_offset + i].loopstart = loop_offset + 4 * i;
+      mpolys[poly_offset + i].totloop = 4;
+      for (int j = 0; j < 4; j++) {
+        /* Reverse vertex order to get correct normals. */
+        mloops[loop_offset + 4 * i + j].v = quads[i][3 - j];
+      }
     }
-  }
+  });
 
   BKE_mesh_calc_edges(mesh, false, false);
   BKE_mesh_normals_tag_dirty(mesh);
@@ -175,7 +185,8 @@ Mesh *volume_to_mesh(const openvdb::GridBase &grid,
     return nullptr;
   }
 
-  return new_mesh_from_openvdb_data(to_mesh_op.verts, to_mesh_op.tris, to_mesh_op.quads);
+  return new_mesh_from_openvdb_data(
+      to_mesh_op.verts, to_mesh_op.tris, to_mesh_op.quads, to_mesh_op.vert_offset);
 }
 
 #endif /* WITH_OPENVDB */
@@ -27,6 +27,8 @@
 
 #  include "MEM_guardedalloc.h"
 
+#  include "atomic_ops.h"
+
 #  include "DNA_scene_types.h"
 
 #  include "BLI_blenlib.h"
@@ -66,6 +68,23 @@
 
 struct StampData;
 
+/* Number of rendered frames that can wait for the encoder thread. */
+#  define FFMPEG_ENCODE_QUEUE_SIZE 3
+
+/* FFMpegContext.encode_flags */
+enum {
+  FFMPEG_ENCODE_FAILED = (1 << 0),
+  FFMPEG_ENCODE_AUTOSPLIT = (1 << 1),
+};
+
+typedef struct FFMpegEncodeFrame {
+  /* Rendered image in Blender's own pixel format, NULL when there is no video stream. */
+  AVFrame *rgb_frame;
+  int pts;
+  /* Audio is written up to this time after the video frame. */
+  double audio_to_pts;
+} FFMpegEncodeFrame;
+
 typedef struct FFMpegContext {
   int ffmpeg_type;
   int ffmpeg_codec;
@@ -86,12 +105,18 @@ typedef struct FFMpegContext {
   AVCodecContext *audio_codec;
   AVStream *video_stream;
   AVStream *audio_stream;
-  AVFrame *current_frame; /* Image frame in output pixel format. */
-
-  /* Image frame in Blender's own pixel format, may need conversion to the output pixel format. */
-  AVFrame *img_convert_frame;
+  AVFrame *current_frame; /* Image frame in output pixel format, if it needs conversion. */
   struct SwsContext *img_convert_ctx;
 
+  /* Conversion, encoding and writing of the frames (and of the audio) runs on a separate thread,
+   * so the next frame can be rendered meanwhile. The frames cycle between the two queues, which
+   * bounds the number of frames waiting to be encoded. */
+  ListBase encode_thread;
+  ThreadQueue *encode_queue;
+  ThreadQueue *encode_free_queue;
+  FFMpegEncodeFrame encode_frames[FFMPEG_ENCODE_QUEUE_SIZE];
+  int32_t encode_flags;
+
   uint8_t *audio_input_buffer;
   uint8_t *audio_deinterleave_buffer;
   int audio_input_samples;
@@ -115,6 +140,7 @@ typedef struct FFMpegContext {
 static void ffmpeg_dict_set_int(AVDictionary **dict, const char *key, int value);
 static void ffmpeg_dict_set_float(AVDictionary **dict, const char *key, float value);
 static void ffmpeg_set_expert_options(RenderData *rd);
+static void ffmpeg_encode_thread_start(FFMpegContext *context);
 static void ffmpeg_filepath_get(FFMpegContext *context,
                                 char *string,
                                 const struct RenderData *rd,
@@ -318,7 +344,7 @@ static const char **get_file_extensions(int format)
 }
 
 /* Write a frame to the output file */
-static int write_video_frame(FFMpegContext *context, int cfra, AVFrame *frame, ReportList *reports)
+static int write_video_frame(FFMpegContext *context, int cfra, AVFrame *frame)
 {
   int ret, success = 1;
   AVPacket *packet = av_packet_alloc();
@@ -358,8 +384,7 @@ static int write_video_frame(FFMpegContext *context, int cfra, AVFrame *frame, R
     }
   }
 
-  if (!success) {
-    BKE_report(reports, RPT_ERROR, "Error writing frame");
+  if (success < 0) {
     PRINT("Error writing frame: %s\n", av_err2str(ret));
   }
 
@@ -368,21 +393,11 @@ static int write_video_frame(FFMpegContext *context, int cfra, AVFrame *frame, R
   return success;
 }
 
-/* read and encode a frame of video from the buffer */
-static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixels)
+/* read a frame of video from the buffer */
+static void generate_video_frame(FFMpegContext *context, AVFrame *rgb_frame, const uint8_t *pixels)
 {
   AVCodecParameters *codec = context->video_stream->codecpar;
   int height = codec->height;
-  AVFrame *rgb_frame;
-
-  if (context->img_convert_frame != NULL) {
-    /* Pixel format conversion is needed. */
-    rgb_frame = context->img_convert_frame;
-  }
-  else {
-    /* The output pixel format is Blender's internal pixel format. */
-    rgb_frame = context->current_frame;
-  }
 
   /* Copy the Blender pixels into the FFmpeg datastructure, taking care of endianness and flipping
    * the image vertically. */
@@ -409,19 +424,24 @@ static AVFrame *generate_video_frame(FFMpegContext *context, const uint8_t *pixe
 #    error ENDIAN_ORDER should either be L_ENDIAN or B_ENDIAN.
 #  endif
   }
+}
 
-  /* Convert to the output pixel format, if it's different that Blender's internal one. */
-  if (context->img_convert_frame != NULL) {
-    BLI_assert(context->img_convert_ctx != NULL);
-    sws_scale(context->img_convert_ctx,
-              (const uint8_t *const *)rgb_frame->data,
-              rgb_frame->linesize,
-              0,
-              codec->height,
-              context->current_frame->data,
-              context->current_frame->linesize);
+/* Convert to the output pixel format, if it's different that Blender's internal one. */
+static AVFrame *convert_video_frame(FFMpegContext *context, AVFrame *rgb_frame)
+{
+  if (context->img_convert_ctx == NULL) {
+    /* The output pixel format is Blender's internal pixel format. */
+    return rgb_frame;
   }
 
+  sws_scale(context->img_convert_ctx,
+            (const uint8_t *const *)rgb_frame->data,
+            rgb_frame->linesize,
+            0,
+            context->video_stream->codecpar->height,
+            context->current_frame->data,
+            context->current_frame->linesize);
+
   return context->current_frame;
 }
 
@@ -753,7 +773,10 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
 
   set_ffmpeg_properties(rd, c, "video", &opts);
 
-  if (codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
+  if (rd->ffcodecdata.threads > 0) {
+    c->thread_count = rd->ffcodecdata.threads;
+  }
+  else if (codec->capabilities & AV_CODEC_CAP_AUTO_THREADS) {
     c->thread_count = 0;
   }
   else {
@@ -779,17 +802,15 @@ static AVStream *alloc_video_stream(FFMpegContext *context,
   }
   av_dict_free(&opts);
 
-  /* FFmpeg expects its data in the output pixel format. */
-  context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
-
   if (c->pix_fmt == AV_PIX_FMT_RGBA) {
     /* Output pixel format is the same we use internally, no conversion necessary. */
-    context->img_convert_frame = NULL;
+    context->current_frame = NULL;
     context->img_convert_ctx = NULL;
   }
   else {
-    /* Output pixel format is different, allocate frame for conversion. */
-    context->img_convert_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+    /* Output pixel format is different, allocate frame for conversion. FFmpeg expects its data
+     * in the output pixel format. */
+    context->current_frame = alloc_picture(c->pix_fmt, c->width, c->height);
     context->img_convert_ctx = sws_getContext(c->width,
                                               c->height,
                                               AV_PIX_FMT_RGBA,
@@ -1188,6 +1209,8 @@ static int start_ffmpeg_impl(FFMpegContext *context,
   av_dump_format(of, 0, name, 1);
   av_dict_free(&opts);
 
+  ffmpeg_encode_thread_start(context);
+
   return 1;
 
 fail:
@@ -1405,6 +1428,73 @@ static void write_audio_frames(FFMpegContext *context, double to_pts)
 }
 #  endif
 
+static void *ffmpeg_encode_thread(void *context_v)
+{
+  FFMpegContext *context = context_v;
+  FFMpegEncodeFrame *encode_frame;
+
+  while ((encode_frame = BLI_thread_queue_pop(context->encode_queue))) {
+    if (context->video_stream) {
+      AVFrame *avframe = convert_video_frame(context, encode_frame->rgb_frame);
+      if (write_video_frame(context, encode_frame->pts, avframe) < 0) {
+        atomic_fetch_and_or_int32(&context->encode_flags, FFMPEG_ENCODE_FAILED);
+      }
+    }
+
+#  ifdef WITH_AUDASPACE
+    write_audio_frames(context, encode_frame->audio_to_pts);
+#  endif
+
+    if (context->ffmpeg_autosplit && avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
+      atomic_fetch_and_or_int32(&context->encode_flags, FFMPEG_ENCODE_AUTOSPLIT);
+    }
+
+    BLI_thread_queue_push(context->encode_free_queue, encode_frame);
+  }
+
+  return NULL;
+}
+
+static void ffmpeg_encode_thread_start(FFMpegContext *context)
+{
+  context->encode_queue = BLI_thread_queue_init();
+  context->encode_free_queue = BLI_thread_queue_init();
+  context->encode_flags = 0;
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    FFMpegEncodeFrame *encode_frame = &context->encode_frames[i];
+    if (context->video_stream) {
+      AVCodecContext *c = context->video_codec;
+      encode_frame->rgb_frame = alloc_picture(AV_PIX_FMT_RGBA, c->width, c->height);
+    }
+    BLI_thread_queue_push(context->encode_free_queue, encode_frame);
+  }
+
+  BLI_threadpool_init(&context->encode_thread, ffmpeg_encode_thread, 1);
+  BLI_threadpool_insert(&context->encode_thread, context);
+}
+
+/* Wait for all queued frames to be written and stop the encoder thread. */
+static void ffmpeg_encode_thread_end(FFMpegContext *context)
+{
+  if (context->encode_queue == NULL) {
+    return;
+  }
+
+  BLI_thread_queue_nowait(context->encode_queue);
+  BLI_threadpool_end(&context->encode_thread);
+
+  BLI_thread_queue_free(context->encode_queue);
+  BLI_thread_queue_free(context->encode_free_queue);
+  context->encode_queue = NULL;
+  context->encode_free_queue = NULL;
+
+  for (int i = 0; i < FFMPEG_ENCODE_QUEUE_SIZE; i++) {
+    delete_picture(context->encode_frames[i].rgb_frame);
+    context->encode_frames[i].rgb_frame = NULL;
+  }
+}
+
 int BKE_ffmpeg_append(void *context_v,
                       RenderData *rd,
                       int start_frame,
@@ -1416,36 +1506,47 @@ int BKE_ffmpeg_append(void *context_v,
                       ReportList *reports)
 {
   FFMpegContext *context = context_v;
-  AVFrame *avframe;
-  int success = 1;
 
   PRINT("Writing frame %i, render width=%d, render height=%d\n", frame, rectx, recty);
 
-  if (context->video_stream) {
-    avframe = generate_video_frame(context, (unsigned char *)pixels);
-    success = (avframe && write_video_frame(context, frame - start_frame, avframe, reports));
-
-    if (context->ffmpeg_autosplit) {
-      if (avio_tell(context->outfile->pb) > FFMPEG_AUTOSPLIT_SIZE) {
-        end_ffmpeg_impl(context, true);
-        context->ffmpeg_autosplit_count++;
-        success &= start_ffmpeg_impl(context, rd, rectx, recty, suffix, reports);
-      }
+  if (atomic_fetch_and_or_int32(&context->encode_flags, 0) & FFMPEG_ENCODE_FAILED) {
+    BKE_report(reports, RPT_ERROR, "Error writing frame");
+    return 0;
+  }
+
+  /* The encoder thread noticed the file got too big after writing a previous frame. */
+  if (atomic_fetch_and_and_int32(&context->encode_flags, ~FFMPEG_ENCODE_AUTOSPLIT) &
+      FFMPEG_ENCODE_AUTOSPLIT) {
+    end_ffmpeg_impl(context, true);
+    context->ffmpeg_autosplit_count++;
+    if (!start_ffmpeg_impl(context, rd, rectx, recty, suffix, reports)) {
+      return 0;
     }
   }
 
-#  ifdef WITH_AUDASPACE
+  /* Waits for the encoder when it is too far behind. */
+  FFMpegEncodeFrame *encode_frame = BLI_thread_queue_pop(context->encode_free_queue);
+
+  if (context->video_stream) {
+    generate_video_frame(context, encode_frame->rgb_frame, (unsigned char *)pixels);
+  }
+  encode_frame->pts = frame - start_frame;
   /* Add +1 frame because we want to encode audio up until the next video frame. */
-  write_audio_frames(
-      context, (frame - start_frame + 1) / (((double)rd->frs_sec) / (double)rd->frs_sec_base));
-#  endif
-  return success;
+  encode_frame->audio_to_pts = (frame - start_frame + 1) /
+                               (((double)rd->frs_sec) / (double)rd->frs_sec_base);
+
+  BLI_thread_queue_push(context->encode_queue, encode_frame);
+
+  return 1;
 }
 
 static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
 {
   PRINT("Closing ffmpeg...\n");
 
+  /* Write the queued frames before anything gets freed. */
+  ffmpeg_encode_thread_end(context);
+
 #  ifdef WITH_AUDASPACE
   if (is_autosplit == false) {
     if (context->audio_mixdown_device) {
@@ -1487,10 +1588,6 @@ static void end_ffmpeg_impl(FFMpegContext *context, int is_autosplit)
     delete_picture(context->current_frame);
     context->current_frame = NULL;
   }
-  if (context->img_convert_frame != NULL) {
-    delete_picture(context->img_convert_frame);
-    context->img_convert_frame = NULL;
-  }
 
   if (context->outfile != NULL && context->outfile->oformat) {
     if (!(context->outfile->oformat->flags & AVFMT_NOFILE)) {
@@ -60,6 +60,7 @@ enum eNlaEvalStrip_StripMode {
   NES_TIME_TRANSITION_END,
 };
 
+struct MemArena;
 struct NlaEvalChannel;
 struct NlaEvalData;
 
@@ -146,6 +147,9 @@ typedef struct NlaEvalData {
 
   /* Evaluation result shapshot. */
   NlaEvalSnapshot eval_snapshot;
+
+  /* Memory of the channels and channel snapshots, which are all freed together. */
+  struct MemArena *arena;
 } NlaEvalData;
 
 /* Information about the currently edited strip and ones below it for keyframing. */
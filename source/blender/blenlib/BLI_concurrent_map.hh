@@ -0,0 +1,240 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::threading::ConcurrentMap<Key, Value>` is a hash table that can be accessed from
+ * multiple threads at the same time. It is mainly a wrapper for `tbb::concurrent_hash_map`. The
+ * wrapper is needed because we want to be able to build without tbb, in which case a single mutex
+ * protects a #blender::Map.
+ *
+ * Elements are accessed through accessors. While an accessor points to an element, that element
+ * is locked: a #MutableAccessor gives exclusive access, a #ConstAccessor shared read access.
+ * Other elements can be accessed concurrently. Accessors should be released as soon as possible
+ * (by letting them go out of scope or calling `release()`), and a thread must not hold more than
+ * one accessor at the same time to avoid dead-locks.
+ *
+ * \code
+ *   ConcurrentMap<int, Vector<int>> map;
+ *   threading::parallel_for(IndexRange(1000), 64, [&](IndexRange range) {
+ *     for (const int i : range) {
+ *       ConcurrentMap<int, Vector<int>>::MutableAccessor accessor;
+ *       map.add(accessor, i % 10);
+ *       accessor->second.append(i);
+ *     }
+ *   });
+ * \endcode
+ */
+
+#ifdef WITH_TBB
+#  include <tbb/concurrent_hash_map.h>
+#endif
+
+#include <mutex>
+
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::threading {
+
+template<typename Key,
+         typename Value,
+         typename Hash = DefaultHash<Key>,
+         typename IsEqual = DefaultEquality>
+class ConcurrentMap : NonCopyable, NonMovable {
+#ifdef WITH_TBB
+
+ private:
+  struct HashCompare {
+    static size_t hash(const Key &key)
+    {
+      return (size_t)Hash{}(key);
+    }
+
+    static bool equal(const Key &a, const Key &b)
+    {
+      return IsEqual{}(a, b);
+    }
+  };
+
+  using TBBMap = tbb::concurrent_hash_map<Key, Value, HashCompare>;
+  TBBMap map_;
+
+ public:
+  using MutableAccessor = typename TBBMap::accessor;
+  using ConstAccessor = typename TBBMap::const_accessor;
+
+  /**
+   * Find the element with the given key. Returns false when there is no such element, in which
+   * case the accessor is empty.
+   */
+  bool lookup(MutableAccessor &accessor, const Key &key)
+  {
+    return map_.find(accessor, key);
+  }
+  bool lookup(ConstAccessor &accessor, const Key &key) const
+  {
+    return map_.find(accessor, key);
+  }
+
+  /**
+   * Find the element with the given key or add it with a default constructed value. Returns true
+   * when the element has been added.
+   */
+  bool add(MutableAccessor &accessor, const Key &key)
+  {
+    return map_.insert(accessor, key);
+  }
+  bool add(ConstAccessor &accessor, const Key &key)
+  {
+    return map_.insert(accessor, key);
+  }
+
+  /**
+   * Remove the element with the given key. Returns true when it existed. This must not be called
+   * while the same thread holds an accessor to an element of the map.
+   */
+  bool remove(const Key &key)
+  {
+    return map_.erase(key);
+  }
+
+  /**
+   * Number of elements in the map. This is not thread-safe when other threads modify the map.
+   */
+  int64_t size() const
+  {
+    return (int64_t)map_.size();
+  }
+
+  /**
+   * Call the function with the key and value of every element. This is not thread-safe when other
+   * threads modify the map.
+   */
+  template<typename Fn> void foreach_item(const Fn &fn) const
+  {
+    for (const std::pair<const Key, Value> &item : map_) {
+      fn(item.first, item.second);
+    }
+  }
+
+#else /* WITH_TBB */
+
+ private:
+  /* Items are allocated separately, so that accessors stay valid when the map grows. */
+  using Item = std::pair<const Key, Value>;
+  using ItemMap = Map<Key, std::unique_ptr<Item>, 4, DefaultProbingStrategy, Hash, IsEqual>;
+
+  mutable std::mutex mutex_;
+  ItemMap map_;
+
+  template<typename ItemT> class AccessorBase : NonCopyable, NonMovable {
+   private:
+    std::unique_lock<std::mutex> lock_;
+    ItemT *item_ = nullptr;
+
+    friend ConcurrentMap;
+
+   public:
+    bool empty() const
+    {
+      return item_ == nullptr;
+    }
+
+    void release()
+    {
+      item_ = nullptr;
+      if (lock_.owns_lock()) {
+        lock_.unlock();
+      }
+    }
+
+    ItemT &operator*() const
+    {
+      BLI_assert(item_ != nullptr);
+      return *item_;
+    }
+
+    ItemT *operator->() const
+    {
+      BLI_assert(item_ != nullptr);
+      return item_;
+    }
+  };
+
+ public:
+  using MutableAccessor = AccessorBase<Item>;
+  using ConstAccessor = AccessorBase<const Item>;
+
+  template<typename Accessor> bool lookup(Accessor &accessor, const Key &key)
+  {
+    accessor.release();
+    accessor.lock_ = std::unique_lock(mutex_);
+    const std::unique_ptr<Item> *item = map_.lookup_ptr(key);
+    if (item == nullptr) {
+      accessor.lock_.unlock();
+      return false;
+    }
+    accessor.item_ = item->get();
+    return true;
+  }
+  bool lookup(ConstAccessor &accessor, const Key &key) const
+  {
+    return const_cast<ConcurrentMap *>(this)->lookup<ConstAccessor>(accessor, key);
+  }
+
+  template<typename Accessor> bool add(Accessor &accessor, const Key &key)
+  {
+    accessor.release();
+    accessor.lock_ = std::unique_lock(mutex_);
+    bool is_new = false;
+    const std::unique_ptr<Item> &item = map_.lookup_or_add_cb(key, [&]() {
+      is_new = true;
+      return std::make_unique<Item>(key, Value());
+    });
+    accessor.item_ = item.get();
+    return is_new;
+  }
+
+  bool remove(const Key &key)
+  {
+    std::lock_guard lock{mutex_};
+    return map_.remove(key);
+  }
+
+  int64_t size() const
+  {
+    std::lock_guard lock{mutex_};
+    return map_.size();
+  }
+
+  template<typename Fn> void foreach_item(const Fn &fn) const
+  {
+    std::lock_guard lock{mutex_};
+    for (const std::unique_ptr<Item> &item : map_.values()) {
+      fn(item->first, item->second);
+    }
+  }
+
+#endif /* WITH_TBB */
+};
+
+}  // namespace blender::threading
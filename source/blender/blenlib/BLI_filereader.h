@@ -46,12 +46,17 @@ struct FileReader;
 typedef ssize_t (*FileReaderReadFn)(struct FileReader *reader, void *buffer, size_t size);
 typedef off64_t (*FileReaderSeekFn)(struct FileReader *reader, off64_t offset, int whence);
 typedef void (*FileReaderCloseFn)(struct FileReader *reader);
+typedef const void *(*FileReaderPeekFn)(struct FileReader *reader, off64_t offset, size_t size);
 
 /* General structure for all FileReaders, implementations add custom fields at the end. */
 typedef struct FileReader {
   FileReaderReadFn read;
   FileReaderSeekFn seek;
   FileReaderCloseFn close;
+  /* Optional: returns a pointer to `size` bytes starting at `offset` without copying them,
+   * or NULL if that range is not directly accessible. The pointer stays valid until close().
+   * Only readers backed by memory (raw or memory-mapped) implement this. */
+  FileReaderPeekFn peek;
 
   off64_t offset;
 } FileReader;
@@ -87,6 +87,12 @@ enum {
    * order of allocation when no chunks have been freed.
    */
   BLI_MEMPOOL_ALLOW_ITER = (1 << 0),
+  /** Allow allocating and freeing elements from multiple threads at once.
+   *
+   * \note other operations (iterating, clearing, #BLI_mempool_len...) must still not run
+   * while elements are being allocated or freed.
+   */
+  BLI_MEMPOOL_THREADSAFE = (1 << 1),
 };
 
 void BLI_mempool_iternew(BLI_mempool *pool, BLI_mempool_iter *iter) ATTR_NONNULL();
@@ -48,6 +48,13 @@ void BLI_task_scheduler_init(void);
 void BLI_task_scheduler_exit(void);
 int BLI_task_scheduler_num_threads(void);
 
+/* Create a separate task arena for every NUMA node, with worker threads bound to that node.
+ * Only used by loops that explicitly distribute work over the nodes, see
+ * `blender::threading::parallel_for_numa`. Must be called before #BLI_task_scheduler_init. */
+void BLI_task_scheduler_use_numa_arenas_set(bool use_numa_arenas);
+/* Number of NUMA nodes with a separate task arena, 1 when NUMA arenas are not used. */
+int BLI_task_scheduler_num_numa_nodes(void);
+
 /* Task Pool
  *
  * Pool of tasks that will be executed by the central task scheduler. For each
@@ -43,8 +43,14 @@
 #  endif
 #endif
 
+#include <algorithm>
+#include <chrono>
+
+#include "BLI_function_ref.hh"
 #include "BLI_index_range.hh"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 namespace blender::threading {
 
@@ -77,6 +83,139 @@ void parallel_for(IndexRange range, int64_t grain_size, const Function &function
 #endif
 }
 
+/**
+ * Same as #parallel_for, but the grain size is chosen automatically. The first iterations are
+ * evaluated on the calling thread in chunks of growing size to measure the cost of a single
+ * iteration. The remaining range is then split into chunks that take roughly
+ * #adaptive_task_duration each.
+ *
+ * This is meant for loops where the cost per iteration is fairly uniform but hard to guess up
+ * front, for uneven loops use #parallel_for_weighted instead.
+ */
+template<typename Function> void parallel_for_adaptive(IndexRange range, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+#ifdef WITH_TBB
+  using Clock = std::chrono::steady_clock;
+  /* Time that a single task should take, long enough to hide the scheduling overhead. */
+  const std::chrono::duration<double> adaptive_task_duration{1e-4};
+
+  int64_t start = range.first();
+  const int64_t end = range.one_after_last();
+  int64_t chunk_size = 1;
+  std::chrono::duration<double> measured_duration{0.0};
+  while (start < end) {
+    const int64_t size = std::min(chunk_size, end - start);
+    const Clock::time_point chunk_start = Clock::now();
+    function(IndexRange(start, size));
+    measured_duration += Clock::now() - chunk_start;
+    start += size;
+    if (measured_duration * 2 >= adaptive_task_duration) {
+      break;
+    }
+    chunk_size *= 2;
+  }
+  if (start == end) {
+    return;
+  }
+
+  const int64_t measured_size = start - range.first();
+  const double iteration_duration = measured_duration.count() / measured_size;
+  const int64_t grain_size = std::clamp<int64_t>(
+      int64_t(adaptive_task_duration.count() / std::max(iteration_duration, 1e-12)),
+      1,
+      end - start);
+  tbb::parallel_for(tbb::blocked_range<int64_t>(start, end, grain_size),
+                    [&](const tbb::blocked_range<int64_t> &subrange) {
+                      function(IndexRange(subrange.begin(), subrange.size()));
+                    });
+#else
+  function(range);
+#endif
+}
+
+/**
+ * Same as #parallel_for, but for loops where iterations have very different costs. The range is
+ * split into chunks based on the weight of every index, as returned by `weight_fn`, so that each
+ * chunk has a total weight of at least `grain_size`. The weight should be proportional to the cost
+ * of an iteration, e.g. the number of points of a spline.
+ *
+ * Chunks never contain a part of an index, so a single index with a very large weight still
+ * becomes a single task.
+ */
+template<typename Function, typename WeightFn>
+void parallel_for_weighted(IndexRange range,
+                           int64_t grain_size,
+                           const Function &function,
+                           const WeightFn &weight_fn)
+{
+  if (range.size() == 0) {
+    return;
+  }
+#ifdef WITH_TBB
+  Vector<int64_t> chunk_offsets;
+  chunk_offsets.append(range.first());
+  int64_t chunk_weight = 0;
+  for (const int64_t i : range) {
+    chunk_weight += weight_fn(i);
+    if (chunk_weight >= grain_size) {
+      chunk_offsets.append(i + 1);
+      chunk_weight = 0;
+    }
+  }
+  if (chunk_offsets.last() != range.one_after_last()) {
+    chunk_offsets.append(range.one_after_last());
+  }
+
+  const int64_t chunks_num = chunk_offsets.size() - 1;
+  if (chunks_num == 1) {
+    function(range);
+    return;
+  }
+  tbb::parallel_for(tbb::blocked_range<int64_t>(0, chunks_num, 1),
+                    [&](const tbb::blocked_range<int64_t> &subrange) {
+                      for (const int64_t chunk : IndexRange(subrange.begin(), subrange.size())) {
+                        const int64_t chunk_start = chunk_offsets[chunk];
+                        function(IndexRange(chunk_start, chunk_offsets[chunk + 1] - chunk_start));
+                      }
+                    });
+#else
+  UNUSED_VARS(grain_size, weight_fn);
+  function(range);
+#endif
+}
+
+namespace detail {
+void parallel_for_numa_impl(IndexRange range,
+                            int64_t grain_size,
+                            FunctionRef<void(IndexRange)> function);
+}
+
+/**
+ * Same as #parallel_for, but the range is split into one contiguous part per NUMA node, and every
+ * part is only processed by threads of that node. Because memory pages are allocated on the node
+ * that touches them first, data initialized with this function stays local to the threads that
+ * process the same indices in later calls.
+ *
+ * Falls back to #parallel_for when the task scheduler has no separate NUMA arenas.
+ */
+template<typename Function>
+void parallel_for_numa(IndexRange range, int64_t grain_size, const Function &function)
+{
+  if (range.size() == 0) {
+    return;
+  }
+#ifdef WITH_TBB
+  if (BLI_task_scheduler_num_numa_nodes() > 1 && range.size() > grain_size) {
+    detail::parallel_for_numa_impl(range, grain_size, function);
+    return;
+  }
+#endif
+  parallel_for(range, grain_size, function);
+}
+
 template<typename Value, typename Function, typename Reduction>
 Value parallel_reduce(IndexRange range,
                       int64_t grain_size,
@@ -21,6 +21,7 @@
 #include <string>
 
 #include "BLI_sys_types.h"
+#include "BLI_trace.h"
 
 namespace blender::timeit {
 
@@ -45,6 +46,10 @@ class ScopedTimer {
   {
     const TimePoint end = Clock::now();
     const Nanoseconds duration = end - start_;
+    BLI_trace_event_add("timer",
+                        name_.c_str(),
+                        uint64_t(Nanoseconds(start_.time_since_epoch()).count()),
+                        uint64_t(Nanoseconds(end.time_since_epoch()).count()));
 
     std::cout << "Timer '" << name_ << "' took ";
     print_duration(duration);
@@ -0,0 +1,67 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Low overhead recording of timed events from any thread, written as a Chrome trace
+ * (`chrome://tracing` or https://ui.perfetto.dev) to correlate work of different subsystems.
+ * When recording is not enabled, emitting an event only costs a branch.
+ */
+
+#include "BLI_sys_types.h"
+#include "BLI_utildefines.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start recording events, the trace is written to \a filepath when recording stops.
+ * Does nothing when recording already started.
+ */
+void BLI_trace_start(const char *filepath);
+/**
+ * Stop recording and write the recorded events. Events emitted by other threads while this runs
+ * may be lost, so it should be called when no other work runs.
+ * \return false when writing the trace failed.
+ */
+bool BLI_trace_stop(void);
+bool BLI_trace_is_enabled(void);
+
+/** Name of the calling thread in the trace, threads without name are named automatically. */
+void BLI_trace_thread_name_set(const char *name);
+
+/** Time stamp in nanoseconds, the clock used for all events. */
+uint64_t BLI_trace_time_ns(void);
+
+/**
+ * Begin and end an event on the calling thread, events can be nested.
+ * The name is copied, so it does not have to outlive the call.
+ */
+void BLI_trace_event_begin(const char *category, const char *name);
+void BLI_trace_event_end(void);
+/** Add an event of which the start and end time stamps are already known. */
+void BLI_trace_event_add(const char *category,
+                         const char *name,
+                         uint64_t start_ns,
+                         uint64_t end_ns);
+
+#ifdef __cplusplus
+}
+#endif
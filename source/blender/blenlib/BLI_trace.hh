@@ -0,0 +1,56 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * C++ helpers for #BLI_trace.h.
+ */
+
+#include "BLI_trace.h"
+
+namespace blender::trace {
+
+/** Records an event from construction until destruction. */
+class ScopedEvent {
+ private:
+  bool is_enabled_;
+
+ public:
+  ScopedEvent(const char *category, const char *name) : is_enabled_(BLI_trace_is_enabled())
+  {
+    if (is_enabled_) {
+      BLI_trace_event_begin(category, name);
+    }
+  }
+
+  ~ScopedEvent()
+  {
+    if (is_enabled_) {
+      BLI_trace_event_end();
+    }
+  }
+
+  ScopedEvent(const ScopedEvent &other) = delete;
+  ScopedEvent &operator=(const ScopedEvent &other) = delete;
+};
+
+}  // namespace blender::trace
+
+#define TRACE_SCOPE(category, name) \
+  blender::trace::ScopedEvent scoped_trace_event(category, name)
@@ -659,4 +659,23 @@ inline void devirtualize_varray2(const VArray<T1> &varray1,
   func(varray1, varray2);
 }
 
+/**
+ * Same as `devirtualize_varray`, but for any number of virtual arrays. To keep the number of
+ * instantiations low, only the cases where all virtual arrays are spans or all are single values
+ * are optimized. Those are the most common cases, e.g. when all inputs are attributes.
+ */
+template<typename Func, typename... Ts>
+inline void devirtualize_varrays(const Func &func, const VArray<Ts> &...varrays)
+{
+  if ((varrays.is_span() && ...)) {
+    func(VArray_For_Span<Ts>{varrays.get_internal_span()}...);
+    return;
+  }
+  if ((varrays.is_single() && ...)) {
+    func(VArray_For_Single<Ts>{varrays.get_internal_single(), varrays.size()}...);
+    return;
+  }
+  func(varrays...);
+}
+
 }  // namespace blender
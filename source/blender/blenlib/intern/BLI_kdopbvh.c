@@ -70,6 +70,10 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/* Bounds of branches with more leafs than this are computed in parallel. This only happens for
+ * the top levels of big trees, which have too few branches to keep all threads busy otherwise. */
+#define KDOPBVH_THREAD_REFIT_THRESHOLD (1 << 16)
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -414,6 +418,68 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+typedef struct BVHRefitData {
+  const BVHTree *tree;
+  int start;
+  int chunk_size;
+  int end;
+  /* Bounds of every chunk, the node is only used as storage. */
+  BVHNode *chunk_nodes;
+} BVHRefitData;
+
+static void refit_kdop_hull_task_cb(void *__restrict userdata,
+                                    const int chunk,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHRefitData *data = userdata;
+  const int start = data->start + chunk * data->chunk_size;
+  const int end = min_ii(start + data->chunk_size, data->end);
+  refit_kdop_hull(data->tree, &data->chunk_nodes[chunk], start, end);
+}
+
+/**
+ * Same as #refit_kdop_hull, but computes the bounds of big ranges of leafs in parallel.
+ */
+static void refit_kdop_hull_threaded(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  if (end - start <= KDOPBVH_THREAD_REFIT_THRESHOLD) {
+    refit_kdop_hull(tree, node, start, end);
+    return;
+  }
+  const int chunk_size = KDOPBVH_THREAD_REFIT_THRESHOLD / 4;
+  const int chunks_num = (end - start + chunk_size - 1) / chunk_size;
+
+  BVHNode *chunk_nodes = MEM_malloc_arrayN((size_t)chunks_num, sizeof(BVHNode), __func__);
+  float *chunk_bv = MEM_malloc_arrayN((size_t)(chunks_num * tree->axis), sizeof(float), __func__);
+  for (int i = 0; i < chunks_num; i++) {
+    chunk_nodes[i].bv = &chunk_bv[i * tree->axis];
+  }
+
+  BVHRefitData data = {
+      .tree = tree,
+      .start = start,
+      .chunk_size = chunk_size,
+      .end = end,
+      .chunk_nodes = chunk_nodes,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, chunks_num, &data, refit_kdop_hull_task_cb, &settings);
+
+  float *__restrict bv = node->bv;
+  node_minmax_init(tree, node);
+  for (int i = 0; i < chunks_num; i++) {
+    const float *__restrict node_bv = chunk_nodes[i].bv;
+    for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+      bv[(2 * axis_iter)] = min_ff(bv[(2 * axis_iter)], node_bv[(2 * axis_iter)]);
+      bv[(2 * axis_iter) + 1] = max_ff(bv[(2 * axis_iter) + 1], node_bv[(2 * axis_iter) + 1]);
+    }
+  }
+
+  MEM_freeN(chunk_bv);
+  MEM_freeN(chunk_nodes);
+}
+
 /**
  * only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake */
@@ -720,7 +786,7 @@ static void non_recursive_bvh_div_nodes_task_cb(void *__restrict userdata,
 
   /* This calculates the bounding box of this branch
    * and chooses the largest axis as the axis to divide leafs */
-  refit_kdop_hull(data->tree, parent, parent_leafs_begin, parent_leafs_end);
+  refit_kdop_hull_threaded(data->tree, parent, parent_leafs_begin, parent_leafs_end);
   split_axis = get_largest_axis(parent->bv);
 
   /* Save split axis (this can be used on ray-tracing to speedup the query time) */
@@ -1013,6 +1079,38 @@ void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoin
   bvhtree_node_inflate(tree, node, tree->epsilon);
 }
 
+/**
+ * Reserve the first \a leafs_num leaf nodes, so they can be filled with #BLI_bvhtree_insert_at
+ * from multiple threads. Like #BLI_bvhtree_insert this has to be called before balancing.
+ */
+void BLI_bvhtree_insert_reserve(BVHTree *tree, int leafs_num)
+{
+  BLI_assert(tree->totbranch <= 0);
+  BLI_assert(tree->totleaf == 0);
+  BLI_assert((size_t)leafs_num <= MEM_allocN_len(tree->nodes) / sizeof(*(tree->nodes)));
+
+  for (int i = 0; i < leafs_num; i++) {
+    tree->nodes[i] = &tree->nodearray[i];
+  }
+  tree->totleaf = leafs_num;
+}
+
+/**
+ * Fill a leaf reserved with #BLI_bvhtree_insert_reserve. Different leaves can be filled
+ * concurrently.
+ */
+void BLI_bvhtree_insert_at(BVHTree *tree, int leaf, int index, const float co[3], int numpoints)
+{
+  BLI_assert(leaf < tree->totleaf);
+  BVHNode *node = tree->nodes[leaf];
+
+  create_kdop_hull(tree, node, co, numpoints, 0);
+  node->index = index;
+
+  /* inflate the bv with some epsilon */
+  bvhtree_node_inflate(tree, node, tree->epsilon);
+}
+
 /* call before BLI_bvhtree_update_tree() */
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints)
@@ -1415,6 +1513,121 @@ BVHTreeOverlap *BLI_bvhtree_overlap(
                                 BVH_OVERLAP_USE_THREADING | BVH_OVERLAP_RETURN_PAIRS);
 }
 
+/**
+ * Overlap of all the leaf pairs of a single tree, where children of the same node are only
+ * tested against each other in one order, so every pair is found only once.
+ */
+static void tree_overlap_traverse_self(BVHOverlapData_Thread *data_thread, const BVHNode *node)
+{
+  BVHOverlapData_Shared *data = data_thread->shared;
+
+  for (int j = 0; j < node->totnode; j++) {
+    const BVHNode *child = node->children[j];
+    tree_overlap_traverse_self(data_thread, child);
+
+    for (int k = j + 1; k < node->totnode; k++) {
+      if (data->callback) {
+        tree_overlap_traverse_cb(data_thread, child, node->children[k]);
+      }
+      else {
+        tree_overlap_traverse(data_thread, child, node->children[k]);
+      }
+    }
+  }
+}
+
+static void bvhtree_overlap_self_task_cb(void *__restrict userdata,
+                                         const int j,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BVHOverlapData_Thread *data = &((BVHOverlapData_Thread *)userdata)[j];
+  BVHOverlapData_Shared *data_shared = data->shared;
+  const BVHNode *root = data_shared->tree1->nodes[data_shared->tree1->totleaf];
+  const BVHNode *child = root->children[j];
+
+  tree_overlap_traverse_self(data, child);
+
+  for (int k = j + 1; k < root->totnode; k++) {
+    if (data_shared->callback) {
+      tree_overlap_traverse_cb(data, child, root->children[k]);
+    }
+    else {
+      tree_overlap_traverse(data, child, root->children[k]);
+    }
+  }
+}
+
+/**
+ * A version of #BLI_bvhtree_overlap for overlapping a tree with itself. Pairs of a leaf with
+ * itself are skipped and every other pair is only found once, in either order of the indices,
+ * instead of the two orders found when passing the same tree twice.
+ */
+BVHTreeOverlap *BLI_bvhtree_overlap_self(
+    const BVHTree *tree,
+    uint *r_overlap_tot,
+    /* optional callback to test the overlap before adding (must be thread-safe!) */
+    BVHTree_OverlapCallback callback,
+    void *userdata)
+{
+  const bool use_threading = tree->totleaf > KDOPBVH_THREAD_LEAF_THRESHOLD;
+  const int root_node_len = BLI_bvhtree_overlap_thread_num(tree);
+  const int thread_num = use_threading ? root_node_len : 1;
+  size_t total = 0;
+  BVHTreeOverlap *overlap = NULL, *to = NULL;
+  BVHOverlapData_Shared data_shared;
+  BVHOverlapData_Thread *data = BLI_array_alloca(data, (size_t)thread_num);
+
+  *r_overlap_tot = 0;
+
+  if (tree->totleaf < 2) {
+    return NULL;
+  }
+
+  data_shared.tree1 = tree;
+  data_shared.tree2 = tree;
+  data_shared.start_axis = tree->start_axis;
+  data_shared.stop_axis = tree->stop_axis;
+
+  /* can be NULL */
+  data_shared.callback = callback;
+  data_shared.userdata = userdata;
+
+  for (int j = 0; j < thread_num; j++) {
+    data[j].shared = &data_shared;
+    data[j].overlap = BLI_stack_new(sizeof(BVHTreeOverlap), __func__);
+    data[j].max_interactions = 0;
+
+    /* for callback */
+    data[j].thread = j;
+  }
+
+  if (use_threading) {
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 1;
+    BLI_task_parallel_range(0, root_node_len, data, bvhtree_overlap_self_task_cb, &settings);
+  }
+  else {
+    tree_overlap_traverse_self(data, tree->nodes[tree->totleaf]);
+  }
+
+  for (int j = 0; j < thread_num; j++) {
+    total += BLI_stack_count(data[j].overlap);
+  }
+
+  to = overlap = MEM_mallocN(sizeof(BVHTreeOverlap) * total, "BVHTreeOverlap");
+
+  for (int j = 0; j < thread_num; j++) {
+    uint count = (uint)BLI_stack_count(data[j].overlap);
+    BLI_stack_pop_n(data[j].overlap, to, count);
+    BLI_stack_free(data[j].overlap);
+    to += count;
+  }
+  *r_overlap_tot = (uint)total;
+
+  return overlap;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1486,6 +1699,31 @@ int *BLI_bvhtree_intersect_plane(BVHTree *tree, float plane[4], uint *r_intersec
 /** \name BLI_bvhtree_find_nearest
  * \{ */
 
+/**
+ * Fill \a r_order with the indices of the children closer than \a dist_max, sorted from the
+ * closest to the farthest. Children at the same distance keep their order.
+ * Returns the number of indices.
+ */
+static int bvh_children_sort_by_dist(const float *dist,
+                                     const int children_len,
+                                     const float dist_max,
+                                     int *r_order)
+{
+  int order_len = 0;
+  for (int i = 0; i < children_len; i++) {
+    if (dist[i] >= dist_max) {
+      continue;
+    }
+    int j = order_len++;
+    while (j > 0 && dist[r_order[j - 1]] > dist[i]) {
+      r_order[j] = r_order[j - 1];
+      j--;
+    }
+    r_order[j] = i;
+  }
+  return order_len;
+}
+
 /* Determines the nearest point of the given node BV.
  * Returns the squared distance to that point. */
 static float calc_nearest_point_squared(const float proj[3], BVHNode *node, float nearest[3])
@@ -1521,28 +1759,22 @@ static void dfs_find_nearest_dfs(BVHNearestData *data, BVHNode *node)
     }
   }
   else {
-    /* Better heuristic to pick the closest node to dive on */
-    int i;
+    /* Dive into the closest children first, so the remaining ones are more likely to be culled
+     * by the nearest distance found so far. */
     float nearest[3];
-
-    if (data->proj[node->main_axis] <= node->children[0]->bv[node->main_axis * 2 + 1]) {
-
-      for (i = 0; i != node->totnode; i++) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq) {
-          continue;
-        }
-        dfs_find_nearest_dfs(data, node->children[i]);
-      }
+    float children_dist_sq[MAX_TREETYPE];
+    int order[MAX_TREETYPE];
+    for (int i = 0; i != node->totnode; i++) {
+      children_dist_sq[i] = calc_nearest_point_squared(data->proj, node->children[i], nearest);
     }
-    else {
-      for (i = node->totnode - 1; i >= 0; i--) {
-        if (calc_nearest_point_squared(data->proj, node->children[i], nearest) >=
-            data->nearest.dist_sq) {
-          continue;
-        }
-        dfs_find_nearest_dfs(data, node->children[i]);
+    const int order_len = bvh_children_sort_by_dist(
+        children_dist_sq, node->totnode, data->nearest.dist_sq, order);
+
+    for (int i = 0; i < order_len; i++) {
+      if (children_dist_sq[order[i]] >= data->nearest.dist_sq) {
+        continue;
       }
+      dfs_find_nearest_dfs(data, node->children[order[i]]);
     }
   }
 }
@@ -1825,19 +2057,18 @@ static float fast_ray_nearest_hit(const BVHRayCastData *data, const BVHNode *nod
   return max_fff(t1x, t1y, t1z);
 }
 
-static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
+static float dfs_raycast_node_hit(const BVHRayCastData *data, const BVHNode *node)
 {
-  int i;
-
-  /* ray-bv is really fast.. and simple tests revealed its worth to test it
-   * before calling the ray-primitive functions */
   /* XXX: temporary solution for particles until fast_ray_nearest_hit supports ray.radius */
-  float dist = (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
-                                            ray_nearest_hit(data, node->bv);
-  if (dist >= data->hit.dist) {
-    return;
-  }
+  return (data->ray.radius == 0.0f) ? fast_ray_nearest_hit(data, node) :
+                                      ray_nearest_hit(data, node->bv);
+}
 
+/**
+ * Traverse a node whose bounding volume is hit at \a dist.
+ */
+static void dfs_raycast_hit(BVHRayCastData *data, BVHNode *node, const float dist)
+{
   if (node->totnode == 0) {
     if (data->callback) {
       data->callback(data->userdata, node->index, &data->ray, &data->hit);
@@ -1849,20 +2080,36 @@ static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
     }
   }
   else {
-    /* pick loop direction to dive into the tree (based on ray direction and split axis) */
-    if (data->ray_dot_axis[node->main_axis] > 0.0f) {
-      for (i = 0; i != node->totnode; i++) {
-        dfs_raycast(data, node->children[i]);
-      }
+    /* Test the bounding volumes of all children first, and dive into the closest ones first, so
+     * the hits found there can cull the children that are farther away. */
+    float children_dist[MAX_TREETYPE];
+    int order[MAX_TREETYPE];
+    for (int i = 0; i != node->totnode; i++) {
+      children_dist[i] = dfs_raycast_node_hit(data, node->children[i]);
     }
-    else {
-      for (i = node->totnode - 1; i >= 0; i--) {
-        dfs_raycast(data, node->children[i]);
+    const int order_len = bvh_children_sort_by_dist(
+        children_dist, node->totnode, data->hit.dist, order);
+
+    for (int i = 0; i < order_len; i++) {
+      if (children_dist[order[i]] >= data->hit.dist) {
+        continue;
       }
+      dfs_raycast_hit(data, node->children[order[i]], children_dist[order[i]]);
     }
   }
 }
 
+static void dfs_raycast(BVHRayCastData *data, BVHNode *node)
+{
+  /* ray-bv is really fast.. and simple tests revealed its worth to test it
+   * before calling the ray-primitive functions */
+  const float dist = dfs_raycast_node_hit(data, node);
+  if (dist >= data->hit.dist) {
+    return;
+  }
+  dfs_raycast_hit(data, node, dist);
+}
+
 /**
  * A version of #dfs_raycast with minor changes to reset the index & dist each ray cast.
  */
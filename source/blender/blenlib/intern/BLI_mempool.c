@@ -32,6 +32,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#ifdef WIN32
+#  include <windows.h>
+#else
+#  include <sched.h>
+#endif
+
 #include "atomic_ops.h"
 
 #include "BLI_utildefines.h"
@@ -132,6 +138,11 @@ struct BLI_mempool {
   uint maxchunks;
   /** Number of elements currently in use. */
   uint totused;
+  /**
+   * Protects allocating and freeing elements with #BLI_MEMPOOL_THREADSAFE.
+   * A plain atomic spin lock, `makesdna` and `makesrna` use pools without the threading API.
+   */
+  uint32_t lock;
 #ifdef USE_TOTALLOC
   /** Number of elements allocated in total. */
   uint totalloc;
@@ -317,6 +328,8 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
 #endif
   pool->totused = 0;
 
+  pool->lock = 0;
+
   if (totelem) {
     /* Allocate the actual chunks. */
     for (i = 0; i < maxchunks; i++) {
@@ -332,7 +345,39 @@ BLI_mempool *BLI_mempool_create(uint esize, uint totelem, uint pchunk, uint flag
   return pool;
 }
 
-void *BLI_mempool_alloc(BLI_mempool *pool)
+/* Number of checks of a held lock before giving up the time slice of the waiting thread. */
+#define MEMPOOL_LOCK_SPIN_COUNT 64
+
+static void mempool_lock_yield(void)
+{
+#ifdef WIN32
+  SwitchToThread();
+#else
+  sched_yield();
+#endif
+}
+
+static void mempool_lock(BLI_mempool *pool)
+{
+  int spin_count = 0;
+  while (atomic_cas_uint32(&pool->lock, 0, 1) != 0) {
+    /* Wait until the lock is released before trying to take it again, and yield when its holder
+     * keeps it longer, e.g. when it was preempted. */
+    while (*(volatile uint32_t *)&pool->lock != 0) {
+      if (++spin_count == MEMPOOL_LOCK_SPIN_COUNT) {
+        mempool_lock_yield();
+        spin_count = 0;
+      }
+    }
+  }
+}
+
+static void mempool_unlock(BLI_mempool *pool)
+{
+  atomic_fetch_and_and_uint32(&pool->lock, 0);
+}
+
+static void *mempool_alloc(BLI_mempool *pool)
 {
   BLI_freenode *free_pop;
 
@@ -360,6 +405,17 @@ void *BLI_mempool_alloc(BLI_mempool *pool)
   return (void *)free_pop;
 }
 
+void *BLI_mempool_alloc(BLI_mempool *pool)
+{
+  if (pool->flag & BLI_MEMPOOL_THREADSAFE) {
+    mempool_lock(pool);
+    void *retval = mempool_alloc(pool);
+    mempool_unlock(pool);
+    return retval;
+  }
+  return mempool_alloc(pool);
+}
+
 void *BLI_mempool_calloc(BLI_mempool *pool)
 {
   void *retval = BLI_mempool_alloc(pool);
@@ -367,12 +423,7 @@ void *BLI_mempool_calloc(BLI_mempool *pool)
   return retval;
 }
 
-/**
- * Free an element from the mempool.
- *
- * \note doesn't protect against double frees, take care!
- */
-void BLI_mempool_free(BLI_mempool *pool, void *addr)
+static void mempool_free(BLI_mempool *pool, void *addr)
 {
   BLI_freenode *newhead = addr;
 
@@ -452,6 +503,22 @@ void BLI_mempool_free(BLI_mempool *pool, void *addr)
   }
 }
 
+/**
+ * Free an element from the mempool.
+ *
+ * \note doesn't protect against double frees, take care!
+ */
+void BLI_mempool_free(BLI_mempool *pool, void *addr)
+{
+  if (pool->flag & BLI_MEMPOOL_THREADSAFE) {
+    mempool_lock(pool);
+    mempool_free(pool, addr);
+    mempool_unlock(pool);
+    return;
+  }
+  mempool_free(pool, addr);
+}
+
 int BLI_mempool_len(const BLI_mempool *pool)
 {
   return (int)pool->totused;
@@ -77,6 +77,16 @@ static off64_t memory_seek(FileReader *reader, off64_t offset, int whence)
   return mem->reader.offset;
 }
 
+static const void *memory_peek_raw(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length) {
+    return NULL;
+  }
+  return mem->data + offset;
+}
+
 static void memory_close_raw(FileReader *reader)
 {
   MEM_freeN(reader);
@@ -92,6 +102,7 @@ FileReader *BLI_filereader_new_memory(const void *data, size_t len)
   mem->reader.read = memory_read_raw;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_raw;
+  mem->reader.peek = memory_peek_raw;
 
   return (FileReader *)mem;
 }
@@ -118,6 +129,20 @@ static ssize_t memory_read_mmap(FileReader *reader, void *buffer, size_t size)
   return readsize;
 }
 
+/* Give direct access to the mapped pages, which avoids an intermediate copy when the caller only
+ * needs to read from them (e.g. to reconstruct DNA structs into a new allocation).
+ * IO errors while accessing the returned memory are not reported here: the failing pages read as
+ * zeroes and every following #memory_read_mmap call fails, so the error still surfaces. */
+static const void *memory_peek_mmap(FileReader *reader, off64_t offset, size_t size)
+{
+  MemoryReader *mem = (MemoryReader *)reader;
+
+  if (offset < 0 || (size_t)offset + size > mem->length || BLI_mmap_any_io_error(mem->mmap)) {
+    return NULL;
+  }
+  return (const char *)BLI_mmap_get_pointer(mem->mmap) + offset;
+}
+
 static void memory_close_mmap(FileReader *reader)
 {
   MemoryReader *mem = (MemoryReader *)reader;
@@ -140,6 +165,7 @@ FileReader *BLI_filereader_new_mmap(int filedes)
   mem->reader.read = memory_read_mmap;
   mem->reader.seek = memory_seek;
   mem->reader.close = memory_close_mmap;
+  mem->reader.peek = memory_peek_mmap;
 
   return (FileReader *)mem;
 }
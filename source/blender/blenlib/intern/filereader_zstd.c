@@ -31,6 +31,19 @@
 
 #include "MEM_guardedalloc.h"
 
+/* Number of decompressed frames kept around when seeking.
+ * Reading a data-block on demand jumps back to an earlier frame and then continues reading
+ * block headers where it left off, so caching a single frame would decompress the same
+ * frames over and over again. */
+#define ZSTD_FRAME_CACHE_SIZE 4
+
+typedef struct ZstdFrameCache {
+  char *content;
+  int frame;
+  /** Value of #ZstdReader.seek.cache_clock when this entry was last used. */
+  uint64_t last_used;
+} ZstdFrameCache;
+
 typedef struct {
   FileReader reader;
 
@@ -45,8 +58,8 @@ typedef struct {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
-    int cached_frame;
+    ZstdFrameCache cache[ZSTD_FRAME_CACHE_SIZE];
+    uint64_t cache_clock;
   } seek;
 } ZstdReader;
 
@@ -142,7 +155,9 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
     return false;
   }
 
-  zstd->seek.cached_frame = -1;
+  for (int i = 0; i < ZSTD_FRAME_CACHE_SIZE; i++) {
+    zstd->seek.cache[i].frame = -1;
+  }
 
   return true;
 }
@@ -170,16 +185,28 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+/* Ensure that the given frame is loaded in the cache. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
-    /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+  zstd->seek.cache_clock++;
+
+  ZstdFrameCache *cache_lru = &zstd->seek.cache[0];
+  for (int i = 0; i < ZSTD_FRAME_CACHE_SIZE; i++) {
+    ZstdFrameCache *cache = &zstd->seek.cache[i];
+    if (cache->frame == frame) {
+      /* Cached frame matches, so just return it. */
+      cache->last_used = zstd->seek.cache_clock;
+      return cache->content;
+    }
+    if (cache->last_used < cache_lru->last_used) {
+      cache_lru = cache;
+    }
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  /* Frame isn't cached, so discard the least recently used one and cache the wanted one
+   * instead. */
+  MEM_SAFE_FREE(cache_lru->content);
+  cache_lru->frame = -1;
 
   size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
   size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
@@ -202,8 +229,9 @@ static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
     return NULL;
   }
 
-  zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
+  cache_lru->frame = frame;
+  cache_lru->content = uncompressed_data;
+  cache_lru->last_used = zstd->seek.cache_clock;
   return uncompressed_data;
 }
 
@@ -297,7 +325,9 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    MEM_freeN(zstd->seek.cached_content);
+    for (int i = 0; i < ZSTD_FRAME_CACHE_SIZE; i++) {
+      MEM_SAFE_FREE(zstd->seek.cache[i].content);
+    }
   }
   else {
     MEM_freeN((void *)zstd->in_buf.src);
@@ -887,6 +887,54 @@ static const Vert *find_flap_vert(const Face &tri, const Edge e, bool *r_rev)
   return flapv;
 }
 
+/**
+ * Index of the #orient3d determinant, when the input coordinates have index 1,
+ * in the sense of the Burnikel, Funke and Seel paper (see mesh_intersect.cc).
+ * Differences have index 2, their products 5, the difference of those 6,
+ * the products with the third differences 9, and the sum of the three terms 11.
+ */
+constexpr int index_orient3d = 11;
+
+/**
+ * Return the sign of the #orient3d determinant of the exact coordinates of \a a, \a b, \a c
+ * and \a d, using only the double approximations of those coordinates.
+ * The answer is 0 when the double arithmetic can't decide, in which case
+ * the exact computation is needed.
+ */
+static int filter_orient3d(const double3 &a, const double3 &b, const double3 &c, const double3 &d)
+{
+  const double adx = a[0] - d[0];
+  const double bdx = b[0] - d[0];
+  const double cdx = c[0] - d[0];
+  const double ady = a[1] - d[1];
+  const double bdy = b[1] - d[1];
+  const double cdy = c[1] - d[1];
+  const double adz = a[2] - d[2];
+  const double bdz = b[2] - d[2];
+  const double cdz = c[2] - d[2];
+  const double det = adz * (bdx * cdy - cdx * bdy) + bdz * (cdx * ady - adx * cdy) +
+                     cdz * (adx * bdy - bdx * ady);
+  /* The supremum is the same expression on absolute values, using + everywhere. */
+  const double3 abs_a = double3::abs(a);
+  const double3 abs_b = double3::abs(b);
+  const double3 abs_c = double3::abs(c);
+  const double3 abs_d = double3::abs(d);
+  const double3 sad = abs_a + abs_d;
+  const double3 sbd = abs_b + abs_d;
+  const double3 scd = abs_c + abs_d;
+  const double supremum = sad[2] * (sbd[0] * scd[1] + scd[0] * sbd[1]) +
+                          sbd[2] * (scd[0] * sad[1] + sad[0] * scd[1]) +
+                          scd[2] * (sad[0] * sbd[1] + sbd[0] * sad[1]);
+  const double err_bound = supremum * index_orient3d * DBL_EPSILON;
+  if (det > err_bound) {
+    return 1;
+  }
+  if (det < -err_bound) {
+    return -1;
+  }
+  return 0;
+}
+
 /**
  * Triangle \a tri and tri0 share edge e.
  * Classify \a tri with respect to tri0 as described in
@@ -907,9 +955,6 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
   if (dbg_level > 0) {
     std::cout << "classify  e = " << e << "\n";
   }
-  mpq3 a0 = tri0[0]->co_exact;
-  mpq3 a1 = tri0[1]->co_exact;
-  mpq3 a2 = tri0[2]->co_exact;
   bool rev;
   bool rev0;
   const Vert *flapv0 = find_flap_vert(tri0, e, &rev0);
@@ -921,9 +966,13 @@ static int sort_tris_class(const Face &tri, const Face &tri0, const Edge e)
     std::cout << " rev = " << rev << " flapv = " << flapv << "\n";
   }
   BLI_assert(flapv != nullptr && flapv0 != nullptr);
-  const mpq3 flap = flapv->co_exact;
-  /* orient will be positive if flap is below oriented plane of a0,a1,a2. */
-  int orient = orient3d(a0, a1, a2, flap);
+  /* orient will be positive if flap is below oriented plane of a0,a1,a2.
+   * Only fall back to exact arithmetic when the double approximation is ambiguous. */
+  int orient = filter_orient3d(tri0[0]->co, tri0[1]->co, tri0[2]->co, flapv->co);
+  if (orient == 0) {
+    orient = orient3d(
+        tri0[0]->co_exact, tri0[1]->co_exact, tri0[2]->co_exact, flapv->co_exact);
+  }
   int ans;
   if (orient > 0) {
     ans = rev0 ? 4 : 3;
@@ -1082,27 +1131,24 @@ static Array<int> sort_tris_around_edge(
 }
 
 /**
- * Find the Cells around edge e.
+ * Find the Cells around edge e, with \a sorted_tris the triangles around e sorted by
+ * #sort_tris_around_edge.
  * This possibly makes new cells in \a cinfo, and sets up the
  * bipartite graph edges between cells and patches.
  * Will modify \a pinfo and \a cinfo and the patches and cells they contain.
  */
 static void find_cells_from_edge(const IMesh &tm,
-                                 const TriMeshTopology &tmtopo,
                                  PatchesInfo &pinfo,
                                  CellsInfo &cinfo,
-                                 const Edge e)
+                                 const Edge e,
+                                 const Span<int> sorted_tris)
 {
   const int dbg_level = 0;
   if (dbg_level > 0) {
     std::cout << "FIND_CELLS_FROM_EDGE " << e << "\n";
   }
-  const Vector<int> *edge_tris = tmtopo.edge_tris(e);
-  BLI_assert(edge_tris != nullptr);
-  Array<int> sorted_tris = sort_tris_around_edge(
-      tm, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
 
-  int n_edge_tris = edge_tris->size();
+  int n_edge_tris = sorted_tris.size();
   Array<int> edge_patches(n_edge_tris);
   for (int i = 0; i < n_edge_tris; ++i) {
     edge_patches[i] = pinfo.tri_patch(sorted_tris[i]);
@@ -1203,19 +1249,35 @@ static CellsInfo find_cells(const IMesh &tm, const TriMeshTopology &tmtopo, Patc
     std::cout << "\nFIND_CELLS\n";
   }
   CellsInfo cinfo;
-  /* For each unique edge shared between patch pairs, process it. */
+  /* Find each unique edge shared between patch pairs. */
   Set<Edge> processed_edges;
+  Vector<Edge> patch_edges;
   for (const auto item : pinfo.patch_patch_edge_map().items()) {
     int p = item.key.first;
     int q = item.key.second;
     if (p < q) {
       const Edge &e = item.value;
-      if (!processed_edges.contains(e)) {
-        processed_edges.add_new(e);
-        find_cells_from_edge(tm, tmtopo, pinfo, cinfo, e);
+      if (processed_edges.add(e)) {
+        patch_edges.append(e);
       }
     }
   }
+  /* Sorting the triangles around the edges only reads the mesh, and is where the exact
+   * orientation tests happen, so do it in parallel. Creating and merging cells depends on the
+   * order the edges are processed in, so is done afterwards in the same order as before. */
+  Array<Array<int>> patch_edges_sorted_tris(patch_edges.size());
+  threading::parallel_for(patch_edges.index_range(), 256, [&](IndexRange range) {
+    for (int i : range) {
+      const Edge e = patch_edges[i];
+      const Vector<int> *edge_tris = tmtopo.edge_tris(e);
+      BLI_assert(edge_tris != nullptr);
+      patch_edges_sorted_tris[i] = sort_tris_around_edge(
+          tm, e, Span<int>(*edge_tris), (*edge_tris)[0], nullptr);
+    }
+  });
+  for (int i : patch_edges.index_range()) {
+    find_cells_from_edge(tm, pinfo, cinfo, patch_edges[i], patch_edges_sorted_tris[i]);
+  }
   /* Some patches may have no cells at this point. These are either:
    * (a) a closed manifold patch only incident on itself (sphere, torus, klein bottle, etc.).
    * (b) an open manifold patch only incident on itself (has non-manifold boundaries).
@@ -20,15 +20,23 @@
  * Task scheduler initialization.
  */
 
+#include <memory>
+
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
+
+#include "numaapi.h"
 
 #ifdef WITH_TBB
 /* Need to include at least one header to get the version define. */
 #  include <tbb/blocked_range.h>
 #  include <tbb/task_arena.h>
+#  include <tbb/task_group.h>
+#  include <tbb/task_scheduler_observer.h>
 #  if TBB_INTERFACE_VERSION_MAJOR >= 10
 #    include <tbb/global_control.h>
 #    define WITH_TBB_GLOBAL_CONTROL
@@ -42,6 +50,154 @@ static int task_scheduler_num_threads = 1;
 static tbb::global_control *task_scheduler_global_control = nullptr;
 #endif
 
+/* NUMA Arenas */
+
+static bool task_scheduler_use_numa_arenas = false;
+
+#ifdef WITH_TBB
+namespace {
+
+/* Binds worker threads to the NUMA node of the arena they join. */
+class NumaNodeObserver : public tbb::task_scheduler_observer {
+ private:
+  int node_;
+
+ public:
+  NumaNodeObserver(tbb::task_arena &arena, const int node)
+      : tbb::task_scheduler_observer(arena), node_(node)
+  {
+    observe(true);
+  }
+
+  void on_scheduler_entry(bool is_worker) override
+  {
+    /* Don't bind the main thread, it only enters the arena to submit and wait for work. */
+    if (is_worker) {
+      numaAPI_RunThreadOnNode(node_);
+    }
+  }
+};
+
+struct NumaNodeArena {
+  tbb::task_arena arena;
+  NumaNodeObserver *observer;
+
+  NumaNodeArena(const int node, const int num_threads) : arena(num_threads)
+  {
+    arena.initialize();
+    observer = OBJECT_GUARDED_NEW(NumaNodeObserver, arena, node);
+  }
+
+  ~NumaNodeArena()
+  {
+    OBJECT_GUARDED_DELETE(observer, NumaNodeObserver);
+  }
+};
+
+}  // namespace
+
+static blender::Vector<NumaNodeArena *> numa_node_arenas;
+
+/**
+ * Create the arenas, the threads are distributed over the nodes in proportion to their number of
+ * processors, so that the total matches \a num_threads (e.g. set with `--threads`).
+ */
+static void task_scheduler_numa_arenas_init(const int num_threads)
+{
+  if (numaAPI_Initialize() != NUMAAPI_SUCCESS) {
+    return;
+  }
+  const int num_nodes = numaAPI_GetNumNodes();
+  if (num_nodes <= 1) {
+    return;
+  }
+  int num_processors_total = 0;
+  for (int node = 0; node < num_nodes; node++) {
+    num_processors_total += std::max(numaAPI_GetNumNodeProcessors(node), 0);
+  }
+  if (num_processors_total == 0) {
+    return;
+  }
+  int num_processors_before = 0;
+  for (int node = 0; node < num_nodes; node++) {
+    const int num_processors = std::max(numaAPI_GetNumNodeProcessors(node), 0);
+    /* Rounding both ends of the node's share of the threads makes the shares add up. */
+    const int threads_start = num_processors_before * num_threads / num_processors_total;
+    num_processors_before += num_processors;
+    const int threads_end = num_processors_before * num_threads / num_processors_total;
+    if (num_processors > 0 && threads_end > threads_start) {
+      numa_node_arenas.append(
+          OBJECT_GUARDED_NEW(NumaNodeArena, node, threads_end - threads_start));
+    }
+  }
+  if (numa_node_arenas.size() == 1) {
+    OBJECT_GUARDED_DELETE(numa_node_arenas[0], NumaNodeArena);
+    numa_node_arenas.clear();
+  }
+}
+
+static void task_scheduler_numa_arenas_exit()
+{
+  for (NumaNodeArena *node_arena : numa_node_arenas) {
+    OBJECT_GUARDED_DELETE(node_arena, NumaNodeArena);
+  }
+  numa_node_arenas.clear_and_make_inline();
+}
+#endif
+
+void BLI_task_scheduler_use_numa_arenas_set(bool use_numa_arenas)
+{
+  task_scheduler_use_numa_arenas = use_numa_arenas;
+}
+
+int BLI_task_scheduler_num_numa_nodes()
+{
+#ifdef WITH_TBB
+  return std::max<int>(numa_node_arenas.size(), 1);
+#else
+  return 1;
+#endif
+}
+
+namespace blender::threading::detail {
+
+void parallel_for_numa_impl(IndexRange range,
+                            int64_t grain_size,
+                            FunctionRef<void(IndexRange)> function)
+{
+#ifdef WITH_TBB
+  /* Split the range in contiguous parts, one for every node, so that the same indices are always
+   * processed on the same node. */
+  const int64_t num_nodes = numa_node_arenas.size();
+  const int64_t part_size = (range.size() + num_nodes - 1) / num_nodes;
+  /* Task groups are local to the call: this is called from several threads at once (e.g. mesh
+   * normals from the depsgraph), and a task group can't be waited on concurrently. */
+  std::unique_ptr<tbb::task_group[]> groups = std::make_unique<tbb::task_group[]>(num_nodes);
+  int64_t num_parts = 0;
+  for (const int64_t i : IndexRange(num_nodes)) {
+    const int64_t part_start = i * part_size;
+    if (part_start >= range.size()) {
+      break;
+    }
+    const int64_t part_len = std::min(part_size, range.size() - part_start);
+    const IndexRange part = range.slice(part_start, part_len);
+    tbb::task_group &group = groups[i];
+    numa_node_arenas[i]->arena.execute(
+        [&, part]() { group.run([=]() { parallel_for(part, grain_size, function); }); });
+    num_parts++;
+  }
+  for (const int64_t i : IndexRange(num_parts)) {
+    tbb::task_group &group = groups[i];
+    numa_node_arenas[i]->arena.execute([&]() { group.wait(); });
+  }
+#else
+  UNUSED_VARS(grain_size);
+  function(range);
+#endif
+}
+
+}  // namespace blender::threading::detail
+
 void BLI_task_scheduler_init()
 {
 #ifdef WITH_TBB_GLOBAL_CONTROL
@@ -61,6 +217,10 @@ void BLI_task_scheduler_init()
      * at all. */
     task_scheduler_num_threads = BLI_system_thread_count();
   }
+
+  if (task_scheduler_use_numa_arenas) {
+    task_scheduler_numa_arenas_init(task_scheduler_num_threads);
+  }
 #else
   task_scheduler_num_threads = BLI_system_thread_count();
 #endif
@@ -68,6 +228,9 @@ void BLI_task_scheduler_init()
 
 void BLI_task_scheduler_exit()
 {
+#ifdef WITH_TBB
+  task_scheduler_numa_arenas_exit();
+#endif
 #ifdef WITH_TBB_GLOBAL_CONTROL
   OBJECT_GUARDED_DELETE(task_scheduler_global_control, tbb::global_control);
 #endif
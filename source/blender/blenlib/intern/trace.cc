@@ -0,0 +1,236 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "BLI_fileops.h"
+#include "BLI_threads.h"
+#include "BLI_trace.h"
+
+namespace blender::trace {
+
+/* The recorded data uses standard library containers instead of the guarded allocator, the
+ * buffers of threads live until exit and would otherwise be reported as leaks. */
+
+struct Event {
+  uint64_t start_ns;
+  uint64_t end_ns;
+  /* Offsets in #ThreadBuffer::strings. */
+  int64_t category;
+  int64_t name;
+};
+
+struct ThreadBuffer {
+  /* Only contended while the trace is written. */
+  std::mutex mutex;
+  int id;
+  std::string thread_name;
+  std::vector<Event> events;
+  std::vector<char> strings;
+  /* Indices of events that began but did not end yet. */
+  std::vector<int64_t> open_events;
+
+  int64_t add_string(const char *str)
+  {
+    const int64_t offset = int64_t(strings.size());
+    strings.insert(strings.end(), str, str + strlen(str) + 1);
+    return offset;
+  }
+
+  void clear()
+  {
+    events.clear();
+    strings.clear();
+    open_events.clear();
+  }
+};
+
+static std::atomic<bool> is_enabled{false};
+static std::mutex buffers_mutex;
+static std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+static std::string output_filepath;
+static uint64_t trace_start_ns = 0;
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+
+static ThreadBuffer &thread_buffer_get()
+{
+  if (thread_buffer == nullptr) {
+    std::lock_guard lock{buffers_mutex};
+    buffers.push_back(std::make_unique<ThreadBuffer>());
+    thread_buffer = buffers.back().get();
+    thread_buffer->id = int(buffers.size());
+    thread_buffer->thread_name = BLI_thread_is_main() ?
+                                     std::string("Main") :
+                                     "Worker " + std::to_string(thread_buffer->id);
+  }
+  return *thread_buffer;
+}
+
+static void write_json_string(FILE *file, const char *str)
+{
+  fputc('"', file);
+  for (const char *c = str; *c; c++) {
+    if (ELEM(*c, '"', '\\')) {
+      fprintf(file, "\\%c", *c);
+    }
+    else if ((unsigned char)*c < 0x20) {
+      fprintf(file, "\\u%04x", (unsigned int)*c);
+    }
+    else {
+      fputc(*c, file);
+    }
+  }
+  fputc('"', file);
+}
+
+/* Write the events in the Chrome trace event format, time stamps are in microseconds. */
+static bool write_chrome_trace(const char *filepath)
+{
+  FILE *file = BLI_fopen(filepath, "w");
+  if (file == nullptr) {
+    fprintf(stderr, "Trace: cannot write '%s'\n", filepath);
+    return false;
+  }
+
+  fprintf(file, "{\"traceEvents\":[\n");
+  bool is_first = true;
+  std::lock_guard buffers_lock{buffers_mutex};
+  for (std::unique_ptr<ThreadBuffer> &buffer : buffers) {
+    std::lock_guard lock{buffer->mutex};
+    if (buffer->events.empty()) {
+      continue;
+    }
+
+    fprintf(file, "%s{\"ph\":\"M\",\"pid\":1,\"tid\":%d,", is_first ? "" : ",\n", buffer->id);
+    fprintf(file, "\"name\":\"thread_name\",\"args\":{\"name\":");
+    write_json_string(file, buffer->thread_name.c_str());
+    fprintf(file, "}}");
+    is_first = false;
+
+    for (const Event &event : buffer->events) {
+      /* Events that did not end are written up to the end of the trace. */
+      const uint64_t end_ns = (event.end_ns != 0) ? event.end_ns : BLI_trace_time_ns();
+      const uint64_t start_ns = std::max(event.start_ns, trace_start_ns);
+      fprintf(file, ",\n{\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"cat\":", buffer->id);
+      write_json_string(file, &buffer->strings[event.category]);
+      fprintf(file, ",\"name\":");
+      write_json_string(file, &buffer->strings[event.name]);
+      fprintf(file,
+              ",\"ts\":%.3f,\"dur\":%.3f}",
+              double(start_ns - trace_start_ns) / 1000.0,
+              double(std::max(end_ns, start_ns) - start_ns) / 1000.0);
+    }
+    buffer->clear();
+  }
+  fprintf(file, "\n]}\n");
+
+  return fclose(file) == 0;
+}
+
+}  // namespace blender::trace
+
+using namespace blender::trace;
+
+void BLI_trace_start(const char *filepath)
+{
+  std::lock_guard lock{buffers_mutex};
+  if (is_enabled) {
+    return;
+  }
+  output_filepath = filepath;
+  trace_start_ns = BLI_trace_time_ns();
+  is_enabled = true;
+}
+
+bool BLI_trace_stop(void)
+{
+  if (!is_enabled.exchange(false)) {
+    return true;
+  }
+  return write_chrome_trace(output_filepath.c_str());
+}
+
+bool BLI_trace_is_enabled(void)
+{
+  return is_enabled.load(std::memory_order_relaxed);
+}
+
+void BLI_trace_thread_name_set(const char *name)
+{
+  ThreadBuffer &buffer = thread_buffer_get();
+  std::lock_guard lock{buffer.mutex};
+  buffer.thread_name = name;
+}
+
+uint64_t BLI_trace_time_ns(void)
+{
+  return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count());
+}
+
+void BLI_trace_event_begin(const char *category, const char *name)
+{
+  if (!BLI_trace_is_enabled()) {
+    return;
+  }
+  ThreadBuffer &buffer = thread_buffer_get();
+  std::lock_guard lock{buffer.mutex};
+  buffer.open_events.push_back(int64_t(buffer.events.size()));
+  buffer.events.push_back(
+      {BLI_trace_time_ns(), 0, buffer.add_string(category), buffer.add_string(name)});
+}
+
+void BLI_trace_event_end(void)
+{
+  if (thread_buffer == nullptr) {
+    return;
+  }
+  ThreadBuffer &buffer = *thread_buffer;
+  std::lock_guard lock{buffer.mutex};
+  /* The buffer may have been written and cleared since the event began. */
+  if (buffer.open_events.empty()) {
+    return;
+  }
+  buffer.events[buffer.open_events.back()].end_ns = BLI_trace_time_ns();
+  buffer.open_events.pop_back();
+}
+
+void BLI_trace_event_add(const char *category,
+                         const char *name,
+                         uint64_t start_ns,
+                         uint64_t end_ns)
+{
+  if (!BLI_trace_is_enabled()) {
+    return;
+  }
+  ThreadBuffer &buffer = thread_buffer_get();
+  std::lock_guard lock{buffer.mutex};
+  buffer.events.push_back(
+      {start_ns, end_ns, buffer.add_string(category), buffer.add_string(name)});
+}
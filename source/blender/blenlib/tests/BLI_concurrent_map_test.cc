@@ -0,0 +1,74 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_concurrent_map.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+namespace blender::threading::tests {
+
+TEST(concurrent_map, AddLookupRemove)
+{
+  ConcurrentMap<int, int> map;
+  EXPECT_EQ(map.size(), 0);
+  {
+    ConcurrentMap<int, int>::MutableAccessor accessor;
+    EXPECT_TRUE(map.add(accessor, 3));
+    accessor->second = 10;
+  }
+  {
+    ConcurrentMap<int, int>::MutableAccessor accessor;
+    EXPECT_FALSE(map.add(accessor, 3));
+    EXPECT_EQ(accessor->second, 10);
+  }
+  {
+    ConcurrentMap<int, int>::ConstAccessor accessor;
+    EXPECT_TRUE(map.lookup(accessor, 3));
+    EXPECT_EQ(accessor->second, 10);
+    EXPECT_FALSE(map.lookup(accessor, 4));
+  }
+  EXPECT_EQ(map.size(), 1);
+  EXPECT_TRUE(map.remove(3));
+  EXPECT_FALSE(map.remove(3));
+  EXPECT_EQ(map.size(), 0);
+}
+
+TEST(concurrent_map, ParallelAdd)
+{
+  ConcurrentMap<int, Vector<int>> map;
+  parallel_for(IndexRange(10000), 64, [&](IndexRange range) {
+    for (const int i : range) {
+      ConcurrentMap<int, Vector<int>>::MutableAccessor accessor;
+      map.add(accessor, i % 100);
+      accessor->second.append(i);
+    }
+  });
+  EXPECT_EQ(map.size(), 100);
+
+  int64_t values_num = 0;
+  map.foreach_item([&](const int key, const Vector<int> &values) {
+    values_num += values.size();
+    for (const int value : values) {
+      EXPECT_EQ(value % 100, key);
+    }
+  });
+  EXPECT_EQ(values_num, 10000);
+}
+
+TEST(concurrent_map, StringKeys)
+{
+  ConcurrentMap<std::string, int> map;
+  {
+    ConcurrentMap<std::string, int>::MutableAccessor accessor;
+    map.add(accessor, "hello");
+    accessor->second = 5;
+  }
+  ConcurrentMap<std::string, int>::ConstAccessor accessor;
+  EXPECT_TRUE(map.lookup(accessor, "hello"));
+  EXPECT_EQ(accessor->second, 5);
+  accessor.release();
+  EXPECT_FALSE(map.lookup(accessor, "world"));
+}
+
+}  // namespace blender::threading::tests
@@ -2,7 +2,10 @@
 
 #include "testing/testing.h"
 
-/* TODO: ray intersection, overlap ... etc. */
+#include <set>
+#include <utility>
+
+/* TODO: ray intersection ... etc. */
 
 #include "MEM_guardedalloc.h"
 
@@ -47,6 +50,29 @@ TEST(kdopbvh, Single)
   BLI_bvhtree_free(tree);
 }
 
+TEST(kdopbvh, InsertAt)
+{
+  const int points_len = 100;
+  float points[points_len][3];
+  for (int i = 0; i < points_len; i++) {
+    copy_v3_fl3(points[i], (float)i, 0.0f, 0.0f);
+  }
+
+  BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+  BLI_bvhtree_insert_reserve(tree, points_len);
+  EXPECT_EQ(BLI_bvhtree_get_len(tree), points_len);
+  /* Leaves don't have to be filled in order. */
+  for (int i = points_len - 1; i >= 0; i--) {
+    BLI_bvhtree_insert_at(tree, i, i, points[i], 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  for (int i = 0; i < points_len; i++) {
+    EXPECT_EQ(BLI_bvhtree_find_nearest(tree, points[i], nullptr, nullptr, nullptr), i);
+  }
+  BLI_bvhtree_free(tree);
+}
+
 static void optimal_check_callback(void *userdata,
                                    int index,
                                    const float co[3],
@@ -119,6 +145,11 @@ TEST(kdopbvh, FindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12);
 }
+/* Big enough to compute the bounds of the top level branches in parallel. */
+TEST(kdopbvh, FindNearest_100000)
+{
+  find_nearest_points_test(100000, 1.0, 100000, 12);
+}
 
 TEST(kdopbvh, OptimalFindNearest_1)
 {
@@ -132,3 +163,70 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+static bool overlap_ordered_callback(void *UNUSED(userdata),
+                                     int index_a,
+                                     int index_b,
+                                     int UNUSED(thread))
+{
+  return index_a < index_b;
+}
+
+/**
+ * The self overlap of a tree should find the same pairs as the overlap of the tree with itself,
+ * only once each and without pairs of a leaf with itself.
+ */
+static void overlap_self_test(int points_len, float epsilon, int random_seed)
+{
+  struct RNG *rng = BLI_rng_new(random_seed);
+  BVHTree *tree = BLI_bvhtree_new(points_len, epsilon, 4, 26);
+
+  for (int i = 0; i < points_len; i++) {
+    float co[3];
+    rng_v3_round(co, 3, rng, 1000, 1.0f);
+    BLI_bvhtree_insert(tree, i, co, 1);
+  }
+  BLI_bvhtree_balance(tree);
+
+  uint overlap_len = 0;
+  BVHTreeOverlap *overlap = BLI_bvhtree_overlap(
+      tree, tree, &overlap_len, overlap_ordered_callback, nullptr);
+  std::set<std::pair<int, int>> pairs;
+  for (uint i = 0; i < overlap_len; i++) {
+    pairs.insert({overlap[i].indexA, overlap[i].indexB});
+  }
+
+  uint overlap_self_len = 0;
+  BVHTreeOverlap *overlap_self = BLI_bvhtree_overlap_self(
+      tree, &overlap_self_len, nullptr, nullptr);
+  std::set<std::pair<int, int>> pairs_self;
+  for (uint i = 0; i < overlap_self_len; i++) {
+    const int index_a = overlap_self[i].indexA;
+    const int index_b = overlap_self[i].indexB;
+    EXPECT_NE(index_a, index_b);
+    pairs_self.insert({MIN2(index_a, index_b), MAX2(index_a, index_b)});
+  }
+
+  EXPECT_EQ(overlap_len, overlap_self_len);
+  EXPECT_EQ(pairs.size(), pairs_self.size());
+  EXPECT_TRUE(pairs == pairs_self);
+
+  MEM_SAFE_FREE(overlap);
+  MEM_SAFE_FREE(overlap_self);
+  BLI_bvhtree_free(tree);
+  BLI_rng_free(rng);
+}
+
+TEST(kdopbvh, OverlapSelf_1)
+{
+  overlap_self_test(1, 0.1f, 1234);
+}
+TEST(kdopbvh, OverlapSelf_500)
+{
+  overlap_self_test(500, 0.05f, 12);
+}
+/* Big enough to overlap the top level branches in parallel. */
+TEST(kdopbvh, OverlapSelf_10000)
+{
+  overlap_self_test(10000, 0.01f, 12);
+}
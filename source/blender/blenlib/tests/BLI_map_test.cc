@@ -653,6 +653,34 @@ TEST(map, LookupKey)
   EXPECT_EQ(map.lookup_key_ptr("a"), map.lookup_key_ptr_as("a"));
 }
 
+TEST(map, HashedSlot)
+{
+  Map<int,
+      std::string,
+      4,
+      DefaultProbingStrategy,
+      DefaultHash<int>,
+      DefaultEquality,
+      HashedMapSlot<int, std::string>>
+      map;
+  for (int i = 0; i < 100; i++) {
+    map.add(i, std::to_string(i));
+  }
+  for (int i = 0; i < 100; i += 2) {
+    map.remove(i);
+  }
+  EXPECT_EQ(map.size(), 50);
+  EXPECT_FALSE(map.contains(4));
+  EXPECT_EQ(map.lookup(5), "5");
+  EXPECT_EQ(map.lookup_default(100, "none"), "none");
+
+  auto map_copy = map;
+  EXPECT_EQ(map_copy.lookup(99), "99");
+  auto map_moved = std::move(map_copy);
+  EXPECT_EQ(map_moved.size(), 50);
+  EXPECT_EQ(map_moved.lookup(1), "1");
+}
+
 /**
  * Set this to 1 to activate the benchmark. It is disabled by default, because it prints a lot.
  */
@@ -1,6 +1,7 @@
 /* Apache License, Version 2.0 */
 
 #include "testing/testing.h"
+#include <atomic>
 #include <cstring>
 
 #include "atomic_ops.h"
@@ -9,9 +10,11 @@
 
 #include "BLI_utildefines.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #define NUM_ITEMS 10000
 
@@ -233,6 +236,52 @@ TEST(task, MempoolIterTLS)
   BLI_threadapi_exit();
 }
 
+/* *** Parallel allocations from a thread-safe mempool. *** */
+
+static void task_mempool_alloc_func(void *userdata,
+                                    int index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BLI_mempool *mempool = (BLI_mempool *)userdata;
+  int *item = (int *)BLI_mempool_alloc(mempool);
+  *item = index;
+  /* Free some items to also reuse elements while allocating from other threads. */
+  if (index % 3 == 0) {
+    BLI_mempool_free(mempool, item);
+  }
+}
+
+TEST(task, MempoolThreadsafeAlloc)
+{
+  BLI_threadapi_init();
+
+  BLI_mempool *mempool = BLI_mempool_create(
+      sizeof(int), 0, 64, BLI_MEMPOOL_ALLOW_ITER | BLI_MEMPOOL_THREADSAFE);
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, NUM_ITEMS, mempool, task_mempool_alloc_func, &settings);
+
+  /* Every item which was not freed must be found exactly once. */
+  int *num_found = (int *)MEM_callocN(sizeof(int) * NUM_ITEMS, __func__);
+  BLI_mempool_iter iter;
+  BLI_mempool_iternew(mempool, &iter);
+  for (int *item = (int *)BLI_mempool_iterstep(&iter); item != nullptr;
+       item = (int *)BLI_mempool_iterstep(&iter)) {
+    ASSERT_TRUE(*item >= 0 && *item < NUM_ITEMS);
+    num_found[*item]++;
+  }
+  for (int i = 0; i < NUM_ITEMS; i++) {
+    EXPECT_EQ(num_found[i], (i % 3 == 0) ? 0 : 1);
+  }
+  EXPECT_EQ(BLI_mempool_len(mempool), NUM_ITEMS - (NUM_ITEMS + 2) / 3);
+
+  MEM_freeN(num_found);
+  BLI_mempool_destroy(mempool);
+  BLI_threadapi_exit();
+}
+
 /* *** Parallel iterations over double-linked list items. *** */
 
 static void task_listbase_iter_func(void *userdata,
@@ -280,3 +329,58 @@ TEST(task, ListBaseIter)
   MEM_freeN(items_buffer);
   BLI_threadapi_exit();
 }
+
+/* *** C++ parallel loops with automatic partitioning. *** */
+
+namespace blender::tests {
+
+TEST(task, ParallelForAdaptive)
+{
+  Array<int> data(NUM_ITEMS, 0);
+  threading::parallel_for_adaptive(IndexRange(NUM_ITEMS), [&](IndexRange range) {
+    for (const int64_t i : range) {
+      data[i]++;
+    }
+  });
+  for (const int i : data.index_range()) {
+    EXPECT_EQ(data[i], 1);
+  }
+}
+
+TEST(task, ParallelForWeighted)
+{
+  Array<int> data(NUM_ITEMS, 0);
+  std::atomic<int> chunks_num = 0;
+  threading::parallel_for_weighted(
+      IndexRange(NUM_ITEMS),
+      1000,
+      [&](IndexRange range) {
+        chunks_num++;
+        for (const int64_t i : range) {
+          data[i]++;
+        }
+      },
+      [&](const int64_t i) { return ((i + 1) % 100 == 0) ? 1000 : 1; });
+  for (const int i : data.index_range()) {
+    EXPECT_EQ(data[i], 1);
+  }
+  /* Every heavy index ends a chunk, the last index is heavy. */
+#ifdef WITH_TBB
+  EXPECT_EQ(chunks_num, NUM_ITEMS / 100);
+#endif
+}
+
+TEST(task, ParallelForNuma)
+{
+  Array<int> data(NUM_ITEMS, 0);
+  threading::parallel_for_numa(IndexRange(NUM_ITEMS), 64, [&](IndexRange range) {
+    for (const int64_t i : range) {
+      data[i]++;
+    }
+  });
+  for (const int i : data.index_range()) {
+    EXPECT_EQ(data[i], 1);
+  }
+}
+
+}  // namespace blender::tests
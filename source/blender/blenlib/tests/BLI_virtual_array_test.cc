@@ -151,4 +151,51 @@ TEST(virtual_array, DerivedSpan)
   }
 }
 
+TEST(virtual_array, DevirtualizeMultiple)
+{
+  std::array<int, 3> data1 = {1, 2, 3};
+  std::array<int, 3> data2 = {10, 20, 30};
+  VArray_For_Span<int> span1{data1};
+  VArray_For_Span<int> span2{data2};
+  VArray_For_Single<int> single1{5, 3};
+  VArray_For_Single<int> single2{7, 3};
+  auto get_func = [](int64_t index) { return (int)index; };
+  VArray_For_Func<int, decltype(get_func)> func{3, get_func};
+
+  int calls = 0;
+  devirtualize_varrays(
+      [&](const auto &a, const auto &b) {
+        using A = std::decay_t<decltype(a)>;
+        using B = std::decay_t<decltype(b)>;
+        EXPECT_TRUE((std::is_same_v<A, VArray_For_Span<int>>));
+        EXPECT_TRUE((std::is_same_v<B, VArray_For_Span<int>>));
+        EXPECT_EQ(a[2] + b[2], 33);
+        calls++;
+      },
+      span1,
+      span2);
+  devirtualize_varrays(
+      [&](const auto &a, const auto &b) {
+        using A = std::decay_t<decltype(a)>;
+        using B = std::decay_t<decltype(b)>;
+        EXPECT_TRUE((std::is_same_v<A, VArray_For_Single<int>>));
+        EXPECT_TRUE((std::is_same_v<B, VArray_For_Single<int>>));
+        EXPECT_EQ(a[1] + b[1], 12);
+        calls++;
+      },
+      single1,
+      single2);
+  /* Mixed cases use the virtual arrays directly. */
+  devirtualize_varrays(
+      [&](const auto &a, const auto &b) {
+        using A = std::decay_t<decltype(a)>;
+        EXPECT_TRUE((std::is_same_v<A, VArray<int>>));
+        EXPECT_EQ(a[2] + b[2], 7);
+        calls++;
+      },
+      (const VArray<int> &)func,
+      (const VArray<int> &)single1);
+  EXPECT_EQ(calls, 3);
+}
+
 }  // namespace blender::tests
@@ -0,0 +1,165 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_performance_test_utils.hh"
+
+#include "BLI_array.hh"
+#include "BLI_ghash.h"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
+#include "BLI_mempool.h"
+#include "BLI_rand.hh"
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+#include "BLI_vector_set.hh"
+
+namespace blender::tests {
+
+#define CONTAINER_ITEMS_NUM 1000000
+#define CONTAINER_RUNS 10
+
+static Vector<int> random_keys(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  Vector<int> keys(size);
+  for (int &key : keys) {
+    key = rng.get_int32();
+  }
+  return keys;
+}
+
+TEST(containers_performance, Map)
+{
+  const Vector<int> keys = random_keys(CONTAINER_ITEMS_NUM);
+  Map<int, int> map;
+
+  printf("\nMap<int, int>:\n");
+  print_throughput("Add", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     map.clear();
+                     for (const int key : keys) {
+                       map.add(key, key);
+                     }
+                   }));
+  int found = 0;
+  print_throughput("Lookup", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     for (const int key : keys) {
+                       found += map.lookup_default(key, 0) == key;
+                     }
+                   }));
+  EXPECT_GT(found, 0);
+}
+
+TEST(containers_performance, Set)
+{
+  const Vector<int> keys = random_keys(CONTAINER_ITEMS_NUM);
+  Set<int> set;
+
+  printf("\nSet<int>:\n");
+  print_throughput("Add", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     set.clear();
+                     for (const int key : keys) {
+                       set.add(key);
+                     }
+                   }));
+  int found = 0;
+  print_throughput("Contains", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     for (const int key : keys) {
+                       found += set.contains(key);
+                     }
+                   }));
+  EXPECT_GT(found, 0);
+}
+
+TEST(containers_performance, VectorSet)
+{
+  const Vector<int> keys = random_keys(CONTAINER_ITEMS_NUM);
+  VectorSet<int> vector_set;
+
+  printf("\nVectorSet<int>:\n");
+  print_throughput("Add", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     vector_set.clear();
+                     for (const int key : keys) {
+                       vector_set.add(key);
+                     }
+                   }));
+  int64_t index_sum = 0;
+  print_throughput("Index of", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     for (const int key : keys) {
+                       index_sum += vector_set.index_of(key);
+                     }
+                   }));
+  EXPECT_GT(index_sum, 0);
+}
+
+TEST(containers_performance, GHash)
+{
+  const Vector<int> keys = random_keys(CONTAINER_ITEMS_NUM);
+  GHash *ghash = BLI_ghash_int_new(__func__);
+
+  printf("\nGHash (int):\n");
+  print_throughput("Insert", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     BLI_ghash_clear(ghash, nullptr, nullptr);
+                     for (const int key : keys) {
+                       BLI_ghash_reinsert(ghash,
+                                          POINTER_FROM_INT(key),
+                                          POINTER_FROM_INT(key),
+                                          nullptr,
+                                          nullptr);
+                     }
+                   }));
+  int found = 0;
+  print_throughput("Lookup", keys.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     for (const int key : keys) {
+                       found += BLI_ghash_lookup(ghash, POINTER_FROM_INT(key)) != nullptr;
+                     }
+                   }));
+  EXPECT_GT(found, 0);
+
+  BLI_ghash_free(ghash, nullptr, nullptr);
+}
+
+TEST(containers_performance, MemPool)
+{
+  Vector<void *> elements(CONTAINER_ITEMS_NUM);
+  BLI_mempool *pool = BLI_mempool_create(sizeof(float[4]), 0, 512, BLI_MEMPOOL_NOP);
+
+  printf("\nBLI_mempool (16 bytes):\n");
+  print_throughput("Alloc and free", elements.size(), average_run_time(CONTAINER_RUNS, [&]() {
+                     for (void *&elem : elements) {
+                       elem = BLI_mempool_alloc(pool);
+                     }
+                     for (void *elem : elements) {
+                       BLI_mempool_free(pool, elem);
+                     }
+                   }));
+
+  BLI_mempool_destroy(pool);
+}
+
+TEST(containers_performance, IndexMask)
+{
+  Array<float> values(CONTAINER_ITEMS_NUM, 1.0f);
+  Vector<int64_t> every_other_index;
+  for (int64_t i = 0; i < values.size(); i += 2) {
+    every_other_index.append(i);
+  }
+  const IndexMask range_mask(values.size());
+  const IndexMask span_mask(every_other_index);
+
+  printf("\nIndexMask:\n");
+  float sum = 0.0f;
+  print_throughput("Foreach index (range)",
+                   range_mask.size(),
+                   average_run_time(CONTAINER_RUNS, [&]() {
+                     range_mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+                   }));
+  print_throughput("Foreach index (indices)",
+                   span_mask.size(),
+                   average_run_time(CONTAINER_RUNS, [&]() {
+                     span_mask.foreach_index([&](const int64_t i) { sum += values[i]; });
+                   }));
+  EXPECT_GT(sum, 0.0f);
+}
+
+}  // namespace blender::tests
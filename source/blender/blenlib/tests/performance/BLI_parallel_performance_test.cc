@@ -0,0 +1,74 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_performance_test_utils.hh"
+
+#include "BLI_array.hh"
+#include "BLI_float3.hh"
+#include "BLI_float4x4.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_vector.h"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+
+namespace blender::tests {
+
+#define PARALLEL_ITEMS_NUM 4000000
+#define PARALLEL_RUNS 10
+
+static Array<float3> random_vectors(const int64_t size)
+{
+  RandomNumberGenerator rng(0);
+  Array<float3> vectors(size);
+  for (float3 &vector : vectors) {
+    vector = float3(rng.get_float(), rng.get_float(), rng.get_float()) + float3(1.0f);
+  }
+  return vectors;
+}
+
+TEST(parallel_performance, ParallelForGrainSize)
+{
+  Array<float> values(PARALLEL_ITEMS_NUM, 1.0f);
+  /* Small grain sizes show the scheduling overhead, large ones the lack of load balancing. */
+  for (const int64_t grain_size : {64, 1024, 16384, 262144}) {
+    char id[64];
+    snprintf(id, sizeof(id), "parallel_for (grain size %d)", int(grain_size));
+    print_thread_scaling(id, values.size(), PARALLEL_RUNS, [&]() {
+      threading::parallel_for(values.index_range(), grain_size, [&](IndexRange range) {
+        for (const int64_t i : range) {
+          values[i] = sqrtf(values[i] + 1.0f);
+        }
+      });
+    });
+  }
+}
+
+TEST(parallel_performance, MathNormalize)
+{
+  Array<float3> vectors = random_vectors(PARALLEL_ITEMS_NUM);
+  print_thread_scaling("normalize_v3", vectors.size(), PARALLEL_RUNS, [&]() {
+    threading::parallel_for(vectors.index_range(), 4096, [&](IndexRange range) {
+      for (const int64_t i : range) {
+        normalize_v3(vectors[i]);
+      }
+    });
+  });
+}
+
+TEST(parallel_performance, MathTransform)
+{
+  Array<float3> vectors = random_vectors(PARALLEL_ITEMS_NUM);
+  float4x4 matrix;
+  loc_eulO_size_to_mat4(
+      matrix.values, float3(1.0f, 2.0f, 3.0f), float3(0.5f, 0.2f, 0.1f), float3(1.1f), 1);
+  print_thread_scaling("mul_m4_v3", vectors.size(), PARALLEL_RUNS, [&]() {
+    threading::parallel_for(vectors.index_range(), 4096, [&](IndexRange range) {
+      for (const int64_t i : range) {
+        mul_m4_v3(matrix.values, vectors[i]);
+      }
+    });
+  });
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,66 @@
+/* Apache License, Version 2.0 */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+
+#include "BLI_threads.h"
+#include "BLI_timeit.hh"
+
+#ifdef WITH_TBB
+#  include <tbb/task_arena.h>
+#endif
+
+namespace blender::tests {
+
+/**
+ * Average duration of one call of #fn in seconds. The first call is not measured, so caches and
+ * allocator pools are warm for the measured ones.
+ */
+template<typename Fn> double average_run_time(const int runs, const Fn &fn)
+{
+  fn();
+  const timeit::TimePoint start = timeit::Clock::now();
+  for (int i = 0; i < runs; i++) {
+    fn();
+  }
+  const timeit::TimePoint end = timeit::Clock::now();
+  return std::chrono::duration<double>(end - start).count() / runs;
+}
+
+inline void print_throughput(const char *id, const int64_t items_num, const double seconds)
+{
+  printf("\t%-44s %10.3f ms %12.2f M items/s\n",
+         id,
+         seconds * 1e3,
+         double(items_num) / seconds * 1e-6);
+}
+
+/**
+ * Print the throughput of #fn when it runs with 1, 2, 4, ... threads up to the number of threads
+ * of the system, so the scaling of parallel code can be compared between changes.
+ */
+template<typename Fn>
+void print_thread_scaling(const char *id, const int64_t items_num, const int runs, const Fn &fn)
+{
+  printf("\n%s:\n", id);
+  const int max_threads = BLI_system_thread_count();
+  for (int threads = 1;; threads = std::min(threads * 2, max_threads)) {
+    double seconds;
+#ifdef WITH_TBB
+    tbb::task_arena arena(threads);
+    arena.execute([&]() { seconds = average_run_time(runs, fn); });
+#else
+    seconds = average_run_time(runs, fn);
+#endif
+    char name[64];
+    snprintf(name, sizeof(name), "%d threads", threads);
+    print_throughput(name, items_num, seconds);
+    if (threads == max_threads) {
+      break;
+    }
+  }
+}
+
+}  // namespace blender::tests
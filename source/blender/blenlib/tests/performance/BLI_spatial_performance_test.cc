@@ -0,0 +1,91 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_performance_test_utils.hh"
+
+#include "BLI_float3.hh"
+#include "BLI_kdopbvh.h"
+#include "BLI_kdtree.h"
+#include "BLI_rand.hh"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
+
+namespace blender::tests {
+
+#define SPATIAL_POINTS_NUM 200000
+#define SPATIAL_RUNS 5
+
+static Vector<float3> random_points(const int64_t size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Vector<float3> points(size);
+  for (float3 &point : points) {
+    point = float3(rng.get_float(), rng.get_float(), rng.get_float());
+  }
+  return points;
+}
+
+TEST(spatial_performance, KDTree)
+{
+  const Vector<float3> points = random_points(SPATIAL_POINTS_NUM, 0);
+  const Vector<float3> queries = random_points(SPATIAL_POINTS_NUM, 1);
+
+  KDTree_3d *tree = nullptr;
+  printf("\nKDTree_3d:\n");
+  print_throughput("Build", points.size(), average_run_time(SPATIAL_RUNS, [&]() {
+                     if (tree) {
+                       BLI_kdtree_3d_free(tree);
+                     }
+                     tree = BLI_kdtree_3d_new(points.size());
+                     for (const int i : points.index_range()) {
+                       BLI_kdtree_3d_insert(tree, i, points[i]);
+                     }
+                     BLI_kdtree_3d_balance(tree);
+                   }));
+
+  print_thread_scaling("KDTree_3d find nearest", queries.size(), SPATIAL_RUNS, [&]() {
+    threading::parallel_for(queries.index_range(), 1024, [&](IndexRange range) {
+      for (const int i : range) {
+        KDTreeNearest_3d nearest;
+        BLI_kdtree_3d_find_nearest(tree, queries[i], &nearest);
+      }
+    });
+  });
+
+  BLI_kdtree_3d_free(tree);
+}
+
+TEST(spatial_performance, BVHTree)
+{
+  const Vector<float3> points = random_points(SPATIAL_POINTS_NUM, 0);
+  const Vector<float3> queries = random_points(SPATIAL_POINTS_NUM, 1);
+
+  BVHTree *tree = nullptr;
+  printf("\nBVHTree (points):\n");
+  print_throughput("Build", points.size(), average_run_time(SPATIAL_RUNS, [&]() {
+                     if (tree) {
+                       BLI_bvhtree_free(tree);
+                     }
+                     tree = BLI_bvhtree_new(points.size(), 0.0f, 2, 6);
+                     for (const int i : points.index_range()) {
+                       BLI_bvhtree_insert(tree, i, points[i], 1);
+                     }
+                     BLI_bvhtree_balance(tree);
+                   }));
+
+  print_thread_scaling("BVHTree find nearest", queries.size(), SPATIAL_RUNS, [&]() {
+    threading::parallel_for(queries.index_range(), 1024, [&](IndexRange range) {
+      for (const int i : range) {
+        BVHTreeNearest nearest;
+        nearest.index = -1;
+        nearest.dist_sq = FLT_MAX;
+        BLI_bvhtree_find_nearest(tree, queries[i], &nearest, nullptr, nullptr);
+      }
+    });
+  });
+
+  BLI_bvhtree_free(tree);
+}
+
+}  // namespace blender::tests
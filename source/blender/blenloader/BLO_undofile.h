@@ -27,6 +27,7 @@
 #include "BLI_filereader.h"
 
 struct GHash;
+struct ID;
 struct Scene;
 
 typedef struct {
@@ -40,6 +41,15 @@ typedef struct {
    * detect unchanged IDs).
    * Defined when writing the next step (i.e. last undo step has those always false). */
   bool is_identical_future;
+  /** When true, this chunk doesn't own the memory either, it shares it with a chunk of the
+   * previous #MemFile that has the same content at a different position (found by #hash).
+   * Unlike #is_identical this says nothing about whether the written data changed. */
+  bool is_shared;
+  /** Hash of the chunk content, used to find identical chunks regardless of their position. */
+  uint hash;
+  /** When non-zero, #buf holds this many bytes of zstd compressed data instead of the `size`
+   * bytes of the chunk itself, see #BLO_memfile_compress. */
+  size_t compressed_size;
   /** Session UUID of the ID being currently written (MAIN_ID_SESSION_UUID_UNSET when not writing
    * ID-related data). Used to find matching chunks in previous memundo step. */
   uint id_session_uuid;
@@ -59,6 +69,8 @@ typedef struct MemFileWriteData {
 
   /** Maps an ID session uuid to its first reference MemFileChunk, if existing. */
   struct GHash *id_session_uuid_mapping;
+  /** Maps a content hash to a reference MemFileChunk, if existing. */
+  struct GHash *chunk_hash_mapping;
 } MemFileWriteData;
 
 typedef struct MemFileUndoData {
@@ -85,11 +97,16 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+bool BLO_memfile_id_chunks_reuse(MemFileWriteData *mem_data,
+                                 const struct ID *id,
+                                 const struct ID *id_head);
 
 /* exports */
 extern void BLO_memfile_free(MemFile *memfile);
 extern void BLO_memfile_merge(MemFile *first, MemFile *second);
 extern void BLO_memfile_clear_future(MemFile *memfile);
+extern void BLO_memfile_compress(MemFile *memfile, const MemFile *memfile_next);
+extern bool BLO_memfile_copy(const MemFile *memfile, MemFile *r_memfile);
 
 /* utilities */
 extern struct Main *BLO_memfile_main_get(struct MemFile *memfile,
@@ -130,6 +130,35 @@ void BLO_blendhandle_print_sizes(BlendHandle *bh, void *fp)
   fprintf(fp, "]\n");
 }
 
+/**
+ * Read the ID block of \a entry from the offset stored in the index.
+ *
+ * \return NULL when the file doesn't match the index.
+ * \note The caller must call #blo_bhead_restart_at with #SIZEOFBLENDERHEADER once done,
+ * so further reading starts from the first block again.
+ */
+static BHead *blendhandle_index_id_bhead(FileData *fd, const BlendFileIndexEntry *entry)
+{
+  if (!blo_bhead_restart_at(fd, (off64_t)entry->offset)) {
+    return NULL;
+  }
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == DATA) {
+      continue;
+    }
+    if ((bhead->code == entry->code) && STREQ(blo_bhead_id_name(fd, bhead), entry->name)) {
+      return bhead;
+    }
+    break;
+  }
+  return NULL;
+}
+
+static bool blendhandle_idcode_has_previews(const int idcode)
+{
+  return ELEM(idcode, ID_MA, ID_TE, ID_IM, ID_WO, ID_LA, ID_OB, ID_GR, ID_SCE, ID_AC);
+}
+
 /**
  * Gets the names of all the data-blocks in a file of a certain type
  * (e.g. all the scene names in a file).
@@ -150,6 +179,28 @@ LinkNode *BLO_blendhandle_get_datablock_names(BlendHandle *bh,
   BHead *bhead;
   int tot = 0;
 
+  /* Answer from the index at the end of the file when there is one,
+   * instead of reading the header of every block. */
+  int entries_len;
+  BlendFileIndexEntry *entries = blo_read_file_index(fd, &entries_len);
+  if (entries != NULL) {
+    for (int i = 0; i < entries_len; i++) {
+      const BlendFileIndexEntry *entry = &entries[i];
+      if (entry->code != ofblocktype) {
+        continue;
+      }
+      if (use_assets_only && (entry->flag & BLEND_FILE_INDEX_ENTRY_IS_ASSET) == 0) {
+        continue;
+      }
+      BLI_linklist_prepend(&names, BLI_strdup(entry->name + 2));
+      tot++;
+    }
+    MEM_freeN(entries);
+
+    *r_tot_names = tot;
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
@@ -190,6 +241,40 @@ LinkNode *BLO_blendhandle_get_datablock_info(BlendHandle *bh,
   BHead *bhead;
   int tot = 0;
 
+  /* Use the index at the end of the file when there is one, only the blocks of assets have to
+   * be read then (to get their asset data). */
+  int entries_len;
+  BlendFileIndexEntry *entries = blo_read_file_index(fd, &entries_len);
+  if (entries != NULL) {
+    for (int i = 0; i < entries_len; i++) {
+      const BlendFileIndexEntry *entry = &entries[i];
+      const bool is_asset = (entry->flag & BLEND_FILE_INDEX_ENTRY_IS_ASSET) != 0;
+      if ((entry->code != ofblocktype) || (use_assets_only && !is_asset)) {
+        continue;
+      }
+
+      AssetMetaData *asset_meta_data = NULL;
+      if (is_asset && (bhead = blendhandle_index_id_bhead(fd, entry))) {
+        asset_meta_data = blo_bhead_id_asset_data_address(fd, bhead);
+        if (asset_meta_data) {
+          blo_read_asset_data_block(fd, bhead, &asset_meta_data);
+        }
+      }
+
+      struct BLODataBlockInfo *info = MEM_mallocN(sizeof(*info), __func__);
+      STRNCPY(info->name, entry->name + 2);
+      info->asset_data = asset_meta_data;
+
+      BLI_linklist_prepend(&infos, info);
+      tot++;
+    }
+    MEM_freeN(entries);
+    blo_bhead_restart_at(fd, SIZEOFBLENDERHEADER);
+
+    *r_tot_info_items = tot;
+    return infos;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ENDB) {
       break;
@@ -267,6 +352,34 @@ static BHead *blo_blendhandle_read_preview_rects(FileData *fd,
   return bhead;
 }
 
+/**
+ * Read the #PreviewImage from the #DATA blocks following the ID block \a bhead.
+ *
+ * \return PreviewImage or NULL when the ID has no preview. Caller owns the returned result.
+ */
+static PreviewImage *blendhandle_read_id_preview(FileData *fd, BHead *bhead)
+{
+  const int sdna_preview_image = DNA_struct_find_nr(fd->filesdna, "PreviewImage");
+
+  for (bhead = blo_bhead_next(fd, bhead); bhead && (bhead->code == DATA);
+       bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->SDNAnr == sdna_preview_image) {
+      PreviewImage *preview_from_file = BLO_library_read_struct(fd, bhead, "PreviewImage");
+
+      if (preview_from_file == NULL) {
+        break;
+      }
+
+      PreviewImage *result = MEM_dupallocN(preview_from_file);
+      blo_blendhandle_read_preview_rects(fd, bhead, result, preview_from_file);
+      MEM_freeN(preview_from_file);
+      return result;
+    }
+  }
+
+  return NULL;
+}
+
 /**
  * Get the PreviewImage of a single data block in a file.
  * (e.g. all the scene previews in a file).
@@ -281,33 +394,39 @@ PreviewImage *BLO_blendhandle_get_preview_for_id(BlendHandle *bh,
                                                  const char *name)
 {
   FileData *fd = (FileData *)bh;
-  bool looking = false;
-  const int sdna_preview_image = DNA_struct_find_nr(fd->filesdna, "PreviewImage");
-
-  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
-    if (bhead->code == DATA) {
-      if (looking && bhead->SDNAnr == sdna_preview_image) {
-        PreviewImage *preview_from_file = BLO_library_read_struct(fd, bhead, "PreviewImage");
 
-        if (preview_from_file == NULL) {
-          break;
+  /* With the index, only the blocks of the requested ID are read. */
+  int entries_len;
+  BlendFileIndexEntry *entries = blo_read_file_index(fd, &entries_len);
+  if (entries != NULL) {
+    PreviewImage *result = NULL;
+    for (int i = 0; i < entries_len; i++) {
+      const BlendFileIndexEntry *entry = &entries[i];
+      if ((entry->code != ofblocktype) || !STREQ(entry->name + 2, name)) {
+        continue;
+      }
+      if (entry->flag & BLEND_FILE_INDEX_ENTRY_HAS_PREVIEW) {
+        BHead *bhead = blendhandle_index_id_bhead(fd, entry);
+        if (bhead) {
+          result = blendhandle_read_id_preview(fd, bhead);
         }
-
-        PreviewImage *result = MEM_dupallocN(preview_from_file);
-        bhead = blo_blendhandle_read_preview_rects(fd, bhead, result, preview_from_file);
-        MEM_freeN(preview_from_file);
-        return result;
+        blo_bhead_restart_at(fd, SIZEOFBLENDERHEADER);
       }
+      break;
     }
-    else if (looking || bhead->code == ENDB) {
-      /* We were looking for a preview image, but didn't find any belonging to block. So it doesn't
-       * exist. */
+    MEM_freeN(entries);
+    return result;
+  }
+
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (bhead->code == ENDB) {
       break;
     }
-    else if (bhead->code == ofblocktype) {
+    if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
       if (STREQ(&idname[2], name)) {
-        looking = true;
+        /* When the preview doesn't directly follow the ID block, it doesn't exist. */
+        return blendhandle_read_id_preview(fd, bhead);
       }
     }
   }
@@ -334,26 +453,41 @@ LinkNode *BLO_blendhandle_get_previews(BlendHandle *bh, int ofblocktype, int *r_
   PreviewImage *new_prv = NULL;
   int tot = 0;
 
+  /* With the index, only the blocks of the IDs which have a preview are read. */
+  int entries_len;
+  BlendFileIndexEntry *entries = blo_read_file_index(fd, &entries_len);
+  if (entries != NULL) {
+    for (int i = 0; i < entries_len; i++) {
+      const BlendFileIndexEntry *entry = &entries[i];
+      if ((entry->code != ofblocktype) || !blendhandle_idcode_has_previews(entry->code)) {
+        continue;
+      }
+      new_prv = NULL;
+      if ((entry->flag & BLEND_FILE_INDEX_ENTRY_HAS_PREVIEW) &&
+          (bhead = blendhandle_index_id_bhead(fd, entry))) {
+        new_prv = blendhandle_read_id_preview(fd, bhead);
+      }
+      if (new_prv == NULL) {
+        new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
+      }
+      BLI_linklist_prepend(&previews, new_prv);
+      tot++;
+    }
+    MEM_freeN(entries);
+    blo_bhead_restart_at(fd, SIZEOFBLENDERHEADER);
+
+    *r_tot_prev = tot;
+    return previews;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ofblocktype) {
       const char *idname = blo_bhead_id_name(fd, bhead);
-      switch (GS(idname)) {
-        case ID_MA:  /* fall through */
-        case ID_TE:  /* fall through */
-        case ID_IM:  /* fall through */
-        case ID_WO:  /* fall through */
-        case ID_LA:  /* fall through */
-        case ID_OB:  /* fall through */
-        case ID_GR:  /* fall through */
-        case ID_SCE: /* fall through */
-        case ID_AC:  /* fall through */
-          new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
-          BLI_linklist_prepend(&previews, new_prv);
-          tot++;
-          looking = 1;
-          break;
-        default:
-          break;
+      if (blendhandle_idcode_has_previews(GS(idname))) {
+        new_prv = MEM_callocN(sizeof(PreviewImage), "newpreview");
+        BLI_linklist_prepend(&previews, new_prv);
+        tot++;
+        looking = 1;
       }
     }
     else if (bhead->code == DATA) {
@@ -397,6 +531,24 @@ LinkNode *BLO_blendhandle_get_linkable_groups(BlendHandle *bh)
   LinkNode *names = NULL;
   BHead *bhead;
 
+  int entries_len;
+  BlendFileIndexEntry *entries = blo_read_file_index(fd, &entries_len);
+  if (entries != NULL) {
+    for (int i = 0; i < entries_len; i++) {
+      const int code = entries[i].code;
+      if (BKE_idtype_idcode_is_valid(code) && BKE_idtype_idcode_is_linkable(code)) {
+        const char *str = BKE_idtype_idcode_to_name(code);
+        if (BLI_gset_add(gathered, (void *)str)) {
+          BLI_linklist_prepend(&names, BLI_strdup(str));
+        }
+      }
+    }
+    MEM_freeN(entries);
+
+    BLI_gset_free(gathered, NULL);
+    return names;
+  }
+
   for (bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
     if (bhead->code == ENDB) {
       break;
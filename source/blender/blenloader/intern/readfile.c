@@ -69,6 +69,7 @@
 #include "BLI_math.h"
 #include "BLI_memarena.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "PIL_time.h"
@@ -982,6 +983,23 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   return success;
 }
 
+/**
+ * Access the data of a block that wasn't read yet without copying it,
+ * only possible when the file is memory-mapped or already in memory.
+ *
+ * \return NULL when the reader doesn't support direct access, the caller must fall back to
+ * #blo_bhead_read_data or #blo_bhead_read_full then.
+ */
+static const void *blo_bhead_peek_data(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  if (fd->file->peek == NULL) {
+    return NULL;
+  }
+  return fd->file->peek(fd->file, new_bhead->file_offset, (size_t)new_bhead->bhead.len);
+}
+
 static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 {
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
@@ -998,6 +1016,100 @@ static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 }
 #endif /* USE_BHEAD_READ_ON_DEMAND */
 
+static BlendFileIndexEntry *read_file_index_entries(FileData *fd, int *r_entries_len)
+{
+  const off64_t bhead_size = (fd->flags & FD_FLAGS_FILE_POINTSIZE_IS_4) ? sizeof(BHead4) :
+                                                                          sizeof(BHead8);
+  /* Only the members common to #BHead4 and #BHead8 are used: `code` and `len` come first,
+   * `nr` comes last. */
+  int bhead_buf[sizeof(BHead8) / sizeof(int)];
+
+  /* The #ENDB block stores the size of the index block. */
+  if ((fd->file->seek(fd->file, -bhead_size, SEEK_END) == -1) ||
+      (fd->file->read(fd->file, bhead_buf, (size_t)bhead_size) != bhead_size) ||
+      (bhead_buf[0] != ENDB)) {
+    return NULL;
+  }
+  const int index_len = bhead_buf[bhead_size / sizeof(int) - 1];
+  if (index_len < bhead_size + (off64_t)sizeof(BlendFileIndexHeader)) {
+    return NULL;
+  }
+
+  BlendFileIndexHeader header;
+  if ((fd->file->seek(fd->file, -(bhead_size + index_len), SEEK_END) == -1) ||
+      (fd->file->read(fd->file, bhead_buf, (size_t)bhead_size) != bhead_size) ||
+      (bhead_buf[0] != DATA) || (bhead_buf[1] != index_len - bhead_size) ||
+      (fd->file->read(fd->file, &header, sizeof(header)) != sizeof(header)) ||
+      (header.code != BLEND_FILE_INDEX_CODE) || (header.entries_len <= 0) ||
+      ((size_t)header.entries_len * sizeof(BlendFileIndexEntry) >
+       (size_t)bhead_buf[1] - sizeof(header))) {
+    return NULL;
+  }
+
+  const size_t entries_size = (size_t)header.entries_len * sizeof(BlendFileIndexEntry);
+  BlendFileIndexEntry *entries = MEM_mallocN(entries_size, __func__);
+  if (fd->file->read(fd->file, entries, entries_size) != (ssize_t)entries_size) {
+    MEM_freeN(entries);
+    return NULL;
+  }
+  for (int i = 0; i < header.entries_len; i++) {
+    entries[i].name[sizeof(entries[i].name) - 1] = '\0';
+  }
+
+  *r_entries_len = header.entries_len;
+  return entries;
+}
+
+/**
+ * Read the index written at the end of the file, see #BlendFileIndexHeader.
+ *
+ * \return The entries (to be freed with #MEM_freeN), or NULL when the file has no index or
+ * it can't be read without scanning the file (compressed with gzip, different endianness...).
+ */
+BlendFileIndexEntry *blo_read_file_index(FileData *fd, int *r_entries_len)
+{
+  *r_entries_len = 0;
+
+  if ((fd->flags & (FD_FLAGS_SWITCH_ENDIAN | FD_FLAGS_IS_MEMFILE)) || (fd->file->seek == NULL)) {
+    return NULL;
+  }
+
+  const off64_t offset_backup = fd->file->offset;
+  BlendFileIndexEntry *entries = read_file_index_entries(fd, r_entries_len);
+
+  /* Blocks are read sequentially, continue where the reading stopped. */
+  if (fd->file->seek(fd->file, offset_backup, SEEK_SET) == -1) {
+    MEM_SAFE_FREE(entries);
+    *r_entries_len = 0;
+  }
+  return entries;
+}
+
+/**
+ * Free the blocks read so far and continue reading from \a offset, which must be the start of a
+ * block (#BlendFileIndexEntry.offset or #SIZEOFBLENDERHEADER to go back to the first block).
+ *
+ * Only meant for browsing files (#BlendHandle), where no block is referenced from elsewhere.
+ *
+ * \return false when reading can't continue from \a offset, #blo_bhead_first then returns NULL.
+ */
+bool blo_bhead_restart_at(FileData *fd, const off64_t offset)
+{
+  if ((fd->file->seek == NULL) || (fd->flags & FD_FLAGS_IS_MEMFILE)) {
+    return false;
+  }
+  BLI_assert(fd->bheadmap == NULL && fd->bhead_idname_hash == NULL);
+
+  BLI_freelistN(&fd->bhead_list);
+  fd->is_eof = false;
+
+  if ((offset < SIZEOFBLENDERHEADER) || (fd->file->seek(fd->file, offset, SEEK_SET) == -1)) {
+    fd->is_eof = true;
+    return false;
+  }
+  return true;
+}
+
 /* Warning! Caller's responsibility to ensure given bhead **is** an ID one! */
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead)
 {
@@ -1087,6 +1199,9 @@ static bool read_file_dna(FileData *fd, const char **r_error_message)
         fd->compflags = DNA_struct_get_compareflags(fd->filesdna, fd->memsdna);
         fd->reconstruct_info = DNA_reconstruct_info_create(
             fd->filesdna, fd->memsdna, fd->compflags);
+        if (do_endian_swap) {
+          fd->endian_switch_info = DNA_endian_switch_info_create(fd->filesdna);
+        }
         /* used to retrieve ID names from (bhead+1) */
         fd->id_name_offset = DNA_elem_offset(fd->filesdna, "ID", "char", "name[]");
         BLI_assert(fd->id_name_offset != -1);
@@ -1375,6 +1490,9 @@ void blo_filedata_free(FileData *fd)
     if (fd->reconstruct_info) {
       DNA_reconstruct_info_free(fd->reconstruct_info);
     }
+    if (fd->endian_switch_info) {
+      DNA_endian_switch_info_free(fd->endian_switch_info);
+    }
 
     if (fd->datamap) {
       oldnewmap_free(fd->datamap);
@@ -1892,20 +2010,11 @@ void blo_cache_storage_end(FileData *fd)
 /** \name DNA Struct Loading
  * \{ */
 
-static void switch_endian_structs(const struct SDNA *filesdna, BHead *bhead)
+static void switch_endian_structs(const struct DNA_EndianSwitchInfo *endian_switch_info,
+                                  BHead *bhead)
 {
-  int blocksize, nblocks;
-  char *data;
-
-  data = (char *)(bhead + 1);
-  blocksize = filesdna->types_size[filesdna->structs[bhead->SDNAnr]->type];
-
-  nblocks = bhead->nr;
-  while (nblocks--) {
-    DNA_struct_switch_endian(filesdna, bhead->SDNAnr, data);
-
-    data += blocksize;
-  }
+  DNA_struct_switch_endian_array(
+      endian_switch_info, bhead->SDNAnr, bhead->nr, (char *)(bhead + 1));
 }
 
 static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
@@ -1928,21 +2037,28 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname)
         }
       }
 #endif
-      switch_endian_structs(fd->filesdna, bh);
+      switch_endian_structs(fd->endian_switch_info, bh);
     }
 
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == NULL)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return NULL;
+          /* Reconstruct straight from the mapped file when possible,
+           * so the old struct layout never needs to be copied into a temporary block. */
+          data = blo_bhead_peek_data(fd, bh);
+          if (data == NULL) {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == NULL)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return NULL;
+            }
+            data = (bh + 1);
           }
         }
 #endif
-        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1));
+        temp = DNA_struct_reconstruct(fd->reconstruct_info, bh->SDNAnr, bh->nr, data);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -3101,11 +3217,121 @@ static bool direct_link_id(FileData *fd, Main *main, const int tag, ID *id, ID *
   return success;
 }
 
+#ifdef USE_BHEAD_READ_ON_DEMAND
+/* Only decode the data-blocks of an ID on multiple threads when there is enough data,
+ * below this the overhead of the task pool outweighs the gain. */
+#define READ_DATA_PARALLEL_MIN_SIZE (1 << 18)
+
+typedef struct ReadDataBlock {
+  BHead *bhead;
+  /** Direct access to the (not yet read) block data in the file, see #blo_bhead_peek_data. */
+  const void *data;
+  void *result;
+} ReadDataBlock;
+
+typedef struct ReadDataParallelData {
+  const FileData *fd;
+  ReadDataBlock *blocks;
+  const char *allocname;
+} ReadDataParallelData;
+
+static void read_data_parallel_fn(void *__restrict userdata,
+                                  const int index,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const ReadDataParallelData *data = userdata;
+  ReadDataBlock *block = &data->blocks[index];
+  const BHead *bh = block->bhead;
+
+  /* Equivalent to #read_struct, without the code-paths that need to seek in the file. */
+  switch (data->fd->compflags[bh->SDNAnr]) {
+    case SDNA_CMP_NOT_EQUAL:
+      block->result = DNA_struct_reconstruct(
+          data->fd->reconstruct_info, bh->SDNAnr, bh->nr, block->data);
+      break;
+    case SDNA_CMP_EQUAL:
+      block->result = MEM_mallocN(bh->len, data->allocname);
+      memcpy(block->result, block->data, bh->len);
+      break;
+    default:
+      block->result = NULL;
+      break;
+  }
+}
+
+/**
+ * Decode all data-blocks of an ID at once using multiple threads.
+ *
+ * This is only possible when the file can be accessed without seeking (memory-mapped or
+ * in-memory files) and the data doesn't need endian switching, which modifies the blocks.
+ *
+ * \return false when the blocks can't be decoded in parallel,
+ * the caller has to read them one by one then.
+ */
+static bool read_data_into_datamap_parallel(FileData *fd,
+                                            BHead *bhead_first,
+                                            const int blocks_num,
+                                            const char *allocname)
+{
+  ReadDataBlock *blocks = MEM_malloc_arrayN(blocks_num, sizeof(*blocks), __func__);
+
+  int i = 0;
+  for (BHead *bhead = bhead_first; i < blocks_num; bhead = blo_bhead_next(fd, bhead), i++) {
+    blocks[i].bhead = bhead;
+    blocks[i].result = NULL;
+    blocks[i].data = (bhead->len != 0) ? blo_bhead_peek_data(fd, bhead) : NULL;
+    if (bhead->len != 0 && blocks[i].data == NULL) {
+      MEM_freeN(blocks);
+      return false;
+    }
+  }
+
+  ReadDataParallelData data = {
+      .fd = fd,
+      .blocks = blocks,
+      .allocname = allocname,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(0, blocks_num, &data, read_data_parallel_fn, &settings);
+
+  /* Insert sequentially, so duplicate old addresses resolve the same way as when reading
+   * the blocks one by one. */
+  for (i = 0; i < blocks_num; i++) {
+    if (blocks[i].result) {
+      oldnewmap_insert(fd->datamap, blocks[i].bhead->old, blocks[i].result, 0);
+    }
+  }
+
+  MEM_freeN(blocks);
+  return true;
+}
+#endif /* USE_BHEAD_READ_ON_DEMAND */
+
 /* Read all data associated with a datablock into datamap. */
 static BHead *read_data_into_datamap(FileData *fd, BHead *bhead, const char *allocname)
 {
   bhead = blo_bhead_next(fd, bhead);
 
+#ifdef USE_BHEAD_READ_ON_DEMAND
+  if (fd->file->peek != NULL && fd->file->seek != NULL &&
+      (fd->flags & FD_FLAGS_SWITCH_ENDIAN) == 0) {
+    int blocks_num = 0;
+    size_t data_size = 0;
+    BHead *bhead_end = bhead;
+    for (; bhead_end && bhead_end->code == DATA; bhead_end = blo_bhead_next(fd, bhead_end)) {
+      blocks_num++;
+      data_size += (size_t)bhead_end->len;
+    }
+    if (blocks_num > 1 && data_size >= READ_DATA_PARALLEL_MIN_SIZE) {
+      if (read_data_into_datamap_parallel(fd, bhead, blocks_num, allocname)) {
+        return bhead_end;
+      }
+    }
+  }
+#endif
+
   while (bhead && bhead->code == DATA) {
     /* The code below is useful for debugging leaks in data read from the blend file.
      * Without this the messages only tell us what ID-type the memory came from,
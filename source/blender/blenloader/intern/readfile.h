@@ -81,6 +81,8 @@ typedef struct FileData {
   /** Array of #eSDNA_StructCompare. */
   const char *compflags;
   struct DNA_ReconstructInfo *reconstruct_info;
+  /** Only set when #FD_FLAGS_SWITCH_ENDIAN is set. */
+  struct DNA_EndianSwitchInfo *endian_switch_info;
 
   int fileversion;
   /** Used to retrieve ID names from (bhead+1). */
@@ -124,6 +126,46 @@ typedef struct FileData {
 
 #define SIZEOFBLENDERHEADER 12
 
+/**
+ * Index of the local ID's of a file, written by #write_file_handle right before #ENDB,
+ * so browsing a file doesn't need to scan all its blocks.
+ *
+ * It's stored as a #DATA block (skipped by versions that don't know about it) which starts with
+ * a #BlendFileIndexHeader followed by the entries. The #BHead.nr of #ENDB stores the size of that
+ * block (#BHead included) so it can be found from the end of the file.
+ *
+ * Each entry stores the offset of the blocks of its ID, so its asset data and preview can be
+ * read without scanning the file either, see #blo_bhead_restart_at.
+ */
+#define BLEND_FILE_INDEX_CODE BLEND_MAKE_ID('I', 'N', 'D', 'X')
+
+typedef struct BlendFileIndexHeader {
+  /** Always #BLEND_FILE_INDEX_CODE. */
+  int code;
+  int entries_len;
+} BlendFileIndexHeader;
+
+enum eBlendFileIndexEntryFlag {
+  BLEND_FILE_INDEX_ENTRY_IS_ASSET = 1 << 0,
+  /** A #PreviewImage is written in the #DATA blocks following the ID block. */
+  BLEND_FILE_INDEX_ENTRY_HAS_PREVIEW = 1 << 1,
+};
+
+typedef struct BlendFileIndexEntry {
+  /** The #BHead.code of the ID block. */
+  int code;
+  /** #eBlendFileIndexEntryFlag. */
+  int flag;
+  /** Full ID name, including the ID code. */
+  char name[66];
+  char _pad[6];
+  /**
+   * Offset in the (uncompressed) file where the blocks of the ID start. The ID block is the
+   * first non-#DATA block from there.
+   */
+  int64_t offset;
+} BlendFileIndexEntry;
+
 /***/
 struct Main;
 void blo_join_main(ListBase *mainlist);
@@ -157,6 +199,9 @@ BHead *blo_bhead_first(FileData *fd);
 BHead *blo_bhead_next(FileData *fd, BHead *thisblock);
 BHead *blo_bhead_prev(FileData *fd, BHead *thisblock);
 
+BlendFileIndexEntry *blo_read_file_index(FileData *fd, int *r_entries_len);
+bool blo_bhead_restart_at(FileData *fd, off64_t offset);
+
 const char *blo_bhead_id_name(const FileData *fd, const BHead *bhead);
 struct AssetMetaData *blo_bhead_id_asset_data_address(const FileData *fd, const BHead *bhead);
 
@@ -28,6 +28,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <zstd.h>
 
 /* open/close */
 #ifndef _WIN32
@@ -38,10 +39,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "DNA_ID.h"
 #include "DNA_listBase.h"
+#include "DNA_sdna_types.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_ghash.h"
+#include "BLI_hash_mm3.h"
+#include "BLI_task.h"
 
 #include "BLO_readfile.h"
 #include "BLO_undofile.h"
@@ -55,13 +60,25 @@
 
 /* **************** support for memory-write, for undo buffers *************** */
 
+/* Whether the chunk owns its buffer, or shares it with a chunk from a previous #MemFile. */
+static bool memfile_chunk_owns_buf(const MemFileChunk *chunk)
+{
+  return !(chunk->is_identical || chunk->is_shared);
+}
+
+/* Undo steps are not expected to be read often once they get compressed,
+ * so favor speed over compression ratio. */
+#define MEMFILE_COMPRESSION_LEVEL 1
+/* Chunks smaller than this are not worth compressing. */
+#define MEMFILE_COMPRESS_MIN_SIZE 4096
+
 /* not memfile itself */
 void BLO_memfile_free(MemFile *memfile)
 {
   MemFileChunk *chunk;
 
   while ((chunk = BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    if (memfile_chunk_owns_buf(chunk)) {
       MEM_freeN((void *)chunk->buf);
     }
     MEM_freeN(chunk);
@@ -80,19 +97,24 @@ void BLO_memfile_merge(MemFile *first, MemFile *second)
 
   /* First, detect all memchunks in second memfile that are not owned by it. */
   for (MemFileChunk *sc = second->chunks.first; sc != NULL; sc = sc->next) {
-    if (sc->is_identical) {
-      BLI_ghash_insert(buffer_to_second_memchunk, (void *)sc->buf, sc);
+    if (!memfile_chunk_owns_buf(sc)) {
+      /* Shared chunks may reference the same buffer several times, one owner is enough. */
+      void **entry;
+      if (!BLI_ghash_ensure_p(buffer_to_second_memchunk, (void *)sc->buf, &entry)) {
+        *entry = sc;
+      }
     }
   }
 
   /* Now, check all chunks from first memfile (the one we are removing), and if a memchunk owned by
    * it is also used by the second memfile, transfer the ownership. */
   for (MemFileChunk *fc = first->chunks.first; fc != NULL; fc = fc->next) {
-    if (!fc->is_identical) {
+    if (memfile_chunk_owns_buf(fc)) {
       MemFileChunk *sc = BLI_ghash_lookup(buffer_to_second_memchunk, fc->buf);
       if (sc != NULL) {
-        BLI_assert(sc->is_identical);
+        BLI_assert(!memfile_chunk_owns_buf(sc));
         sc->is_identical = false;
+        sc->is_shared = false;
         fc->is_identical = true;
       }
       /* Note that if the second memfile does not use that chunk, we assume that the first one
@@ -114,6 +136,153 @@ void BLO_memfile_clear_future(MemFile *memfile)
   }
 }
 
+typedef struct MemFileCompressData {
+  MemFileChunk **chunks;
+  /** Bytes saved for each chunk. */
+  size_t *saved_size;
+} MemFileCompressData;
+
+static void memfile_compress_chunk_fn(void *__restrict userdata,
+                                      const int index,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  MemFileCompressData *data = userdata;
+  MemFileChunk *chunk = data->chunks[index];
+  data->saved_size[index] = 0;
+
+  const size_t buf_len = ZSTD_compressBound(chunk->size);
+  char *buf = MEM_mallocN(buf_len, "Chunk buffer compressed");
+  const size_t compressed_size = ZSTD_compress(
+      buf, buf_len, chunk->buf, chunk->size, MEMFILE_COMPRESSION_LEVEL);
+  /* Keep the chunk as is if it doesn't compress well, it would only slow down reading it. */
+  if (ZSTD_isError(compressed_size) || compressed_size > chunk->size - chunk->size / 8) {
+    MEM_freeN(buf);
+    return;
+  }
+
+  MEM_freeN((void *)chunk->buf);
+  chunk->buf = MEM_reallocN(buf, compressed_size);
+  chunk->compressed_size = compressed_size;
+  data->saved_size[index] = chunk->size - compressed_size;
+}
+
+/**
+ * Compress the memory owned by \a memfile, for undo steps that are unlikely to be read again.
+ * The chunks are decompressed again when needed, see #memfile_chunk_decompress.
+ *
+ * \param memfile_next: The memfile of the following undo step, buffers it shares with
+ * \a memfile are kept as they are.
+ */
+void BLO_memfile_compress(MemFile *memfile, const MemFile *memfile_next)
+{
+  GSet *buffers_next = BLI_gset_ptr_new(__func__);
+  if (memfile_next != NULL) {
+    LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile_next->chunks) {
+      if (!memfile_chunk_owns_buf(chunk)) {
+        BLI_gset_add(buffers_next, (void *)chunk->buf);
+      }
+    }
+  }
+
+  int chunks_num = 0;
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (memfile_chunk_owns_buf(chunk) && chunk->compressed_size == 0 &&
+        chunk->size >= MEMFILE_COMPRESS_MIN_SIZE &&
+        !BLI_gset_haskey(buffers_next, chunk->buf)) {
+      chunks_num++;
+    }
+  }
+
+  if (chunks_num != 0) {
+    MemFileCompressData data;
+    data.chunks = MEM_malloc_arrayN((size_t)chunks_num, sizeof(*data.chunks), __func__);
+    data.saved_size = MEM_malloc_arrayN((size_t)chunks_num, sizeof(*data.saved_size), __func__);
+
+    int i = 0;
+    LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+      if (memfile_chunk_owns_buf(chunk) && chunk->compressed_size == 0 &&
+          chunk->size >= MEMFILE_COMPRESS_MIN_SIZE &&
+          !BLI_gset_haskey(buffers_next, chunk->buf)) {
+        data.chunks[i++] = chunk;
+      }
+    }
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, chunks_num, &data, memfile_compress_chunk_fn, &settings);
+
+    for (i = 0; i < chunks_num; i++) {
+      memfile->size -= data.saved_size[i];
+    }
+
+    MEM_freeN(data.chunks);
+    MEM_freeN(data.saved_size);
+  }
+
+  BLI_gset_free(buffers_next, NULL);
+}
+
+/* Restore the raw content of a chunk compressed by #BLO_memfile_compress. */
+static bool memfile_chunk_decompress_to_buf(const MemFileChunk *chunk, char *buf)
+{
+  const size_t size = ZSTD_decompress(buf, chunk->size, chunk->buf, chunk->compressed_size);
+  return !ZSTD_isError(size) && size == chunk->size;
+}
+
+static bool memfile_chunk_decompress(MemFile *memfile, MemFileChunk *chunk)
+{
+  BLI_assert(memfile_chunk_owns_buf(chunk));
+
+  char *buf = MEM_mallocN(chunk->size, "Chunk buffer");
+  if (!memfile_chunk_decompress_to_buf(chunk, buf)) {
+    MEM_freeN(buf);
+    return false;
+  }
+
+  MEM_freeN((void *)chunk->buf);
+  chunk->buf = buf;
+  memfile->size += chunk->size - chunk->compressed_size;
+  chunk->compressed_size = 0;
+  return true;
+}
+
+/**
+ * Copy the content of \a memfile into \a r_memfile, which owns all of its buffers afterwards.
+ * Compressed chunks are decompressed into the copy, \a memfile itself is left untouched.
+ *
+ * This allows to use the data of an undo step independently of the undo stack,
+ * e.g. to write it from another thread (see auto-save).
+ */
+bool BLO_memfile_copy(const MemFile *memfile, MemFile *r_memfile)
+{
+  BLI_listbase_clear(&r_memfile->chunks);
+  r_memfile->size = 0;
+
+  LISTBASE_FOREACH (const MemFileChunk *, chunk, &memfile->chunks) {
+    MemFileChunk *chunk_copy = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    char *buf = MEM_mallocN(chunk->size, "Chunk buffer");
+    *chunk_copy = *chunk;
+    chunk_copy->buf = buf;
+    chunk_copy->is_identical = false;
+    chunk_copy->is_identical_future = false;
+    chunk_copy->is_shared = false;
+    chunk_copy->compressed_size = 0;
+    BLI_addtail(&r_memfile->chunks, chunk_copy);
+    r_memfile->size += chunk->size;
+
+    if (chunk->compressed_size != 0) {
+      if (!memfile_chunk_decompress_to_buf(chunk, buf)) {
+        BLO_memfile_free(r_memfile);
+        return false;
+      }
+    }
+    else {
+      memcpy(buf, chunk->buf, chunk->size);
+    }
+  }
+  return true;
+}
+
 void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
@@ -145,6 +314,19 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
         }
       }
     }
+
+    /* Also map the content hashes of all reference chunks, so that data which moved to another
+     * position (e.g. because of re-ordering or because it is now owned by another ID) can still
+     * share its memory with the previous step. */
+    mem_data->chunk_hash_mapping = BLI_ghash_new(
+        BLI_ghashutil_inthash_p_simple, BLI_ghashutil_intcmp, __func__);
+    LISTBASE_FOREACH (MemFileChunk *, mem_chunk, &reference_memfile->chunks) {
+      void **entry;
+      if (!BLI_ghash_ensure_p(
+              mem_data->chunk_hash_mapping, POINTER_FROM_UINT(mem_chunk->hash), &entry)) {
+        *entry = mem_chunk;
+      }
+    }
   }
 }
 
@@ -153,6 +335,9 @@ void BLO_memfile_write_finalize(MemFileWriteData *mem_data)
   if (mem_data->id_session_uuid_mapping != NULL) {
     BLI_ghash_free(mem_data->id_session_uuid_mapping, NULL, NULL);
   }
+  if (mem_data->chunk_hash_mapping != NULL) {
+    BLI_ghash_free(mem_data->chunk_hash_mapping, NULL, NULL);
+  }
 }
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size)
@@ -164,6 +349,9 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   curchunk->size = size;
   curchunk->buf = NULL;
   curchunk->is_identical = false;
+  curchunk->is_shared = false;
+  curchunk->hash = 0;
+  curchunk->compressed_size = 0;
   /* This is unsafe in the sense that an app handler or other code that does not
    * perform an undo push may make changes after the last undo push that
    * will then not be undo. Though it's not entirely clear that is wrong behavior. */
@@ -174,9 +362,10 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   /* we compare compchunk with buf */
   if (*compchunk_step != NULL) {
     MemFileChunk *compchunk = *compchunk_step;
-    if (compchunk->size == curchunk->size) {
+    if (compchunk->size == curchunk->size && compchunk->compressed_size == 0) {
       if (memcmp(compchunk->buf, buf, size) == 0) {
         curchunk->buf = compchunk->buf;
+        curchunk->hash = compchunk->hash;
         curchunk->is_identical = true;
         compchunk->is_identical_future = true;
       }
@@ -184,6 +373,23 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
     *compchunk_step = compchunk->next;
   }
 
+  if (curchunk->buf == NULL) {
+    curchunk->hash = BLI_hash_mm3((const unsigned char *)buf, size, 0);
+  }
+
+  /* Not equal to the chunk at the same position, but its content may still exist elsewhere in the
+   * previous step. Only the memory is shared then, the chunk is not considered identical since
+   * the data it belongs to did change. */
+  if (curchunk->buf == NULL && mem_data->chunk_hash_mapping != NULL) {
+    MemFileChunk *hashchunk = BLI_ghash_lookup(mem_data->chunk_hash_mapping,
+                                               POINTER_FROM_UINT(curchunk->hash));
+    if (hashchunk != NULL && hashchunk->size == size && hashchunk->compressed_size == 0 &&
+        memcmp(hashchunk->buf, buf, size) == 0) {
+      curchunk->buf = hashchunk->buf;
+      curchunk->is_shared = true;
+    }
+  }
+
   /* not equal... */
   if (curchunk->buf == NULL) {
     char *buf_new = MEM_mallocN(size, "Chunk buffer");
@@ -193,6 +399,85 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+/**
+ * Check whether the chunks of an ID start with the #BHead and #ID struct it would be written
+ * with now. The ID struct is the first data written for an ID, but it may be split over several
+ * chunks.
+ */
+static bool memfile_id_chunks_match_head(const MemFileChunk *chunk,
+                                         const ID *id,
+                                         const ID *id_head)
+{
+  char head[sizeof(BHead) + sizeof(ID)];
+  size_t head_len = 0;
+  for (; chunk != NULL && chunk->id_session_uuid == id->session_uuid && head_len < sizeof(head);
+       chunk = chunk->next) {
+    const size_t len = MIN2(chunk->size, sizeof(head) - head_len);
+    memcpy(head + head_len, chunk->buf, len);
+    head_len += len;
+  }
+  if (head_len != sizeof(head)) {
+    return false;
+  }
+
+  BHead bhead;
+  memcpy(&bhead, head, sizeof(BHead));
+  return bhead.old == id && memcmp(head + sizeof(BHead), id_head, sizeof(ID)) == 0;
+}
+
+/**
+ * Add the chunks written for the given ID in the reference memfile to the written one again,
+ * instead of writing that ID. Only valid when the data of the ID is known to be unchanged.
+ *
+ * \param id_head: The #ID struct as writing \a id would store it. Changes to e.g. the name, users
+ * or flags of an ID are not tagged for an update, so the chunks are only reused when they
+ * contain the same ID struct.
+ *
+ * \return false when there is no matching chunk in the reference memfile (e.g. for new IDs),
+ * the ID has to be written as usual then.
+ */
+bool BLO_memfile_id_chunks_reuse(MemFileWriteData *mem_data, const ID *id, const ID *id_head)
+{
+  if (mem_data->id_session_uuid_mapping == NULL) {
+    return false;
+  }
+  const uint id_session_uuid = id->session_uuid;
+  MemFileChunk *refchunk = BLI_ghash_lookup(mem_data->id_session_uuid_mapping,
+                                            POINTER_FROM_UINT(id_session_uuid));
+  if (refchunk == NULL) {
+    return false;
+  }
+
+  /* Compressed chunks can't be shared, see #BLO_memfile_compress. */
+  for (MemFileChunk *chunk = refchunk; chunk != NULL && chunk->id_session_uuid == id_session_uuid;
+       chunk = chunk->next) {
+    if (chunk->compressed_size != 0) {
+      return false;
+    }
+  }
+
+  if (!memfile_id_chunks_match_head(refchunk, id, id_head)) {
+    return false;
+  }
+
+  MemFile *memfile = mem_data->written_memfile;
+  for (; refchunk != NULL && refchunk->id_session_uuid == id_session_uuid;
+       refchunk = refchunk->next) {
+    MemFileChunk *curchunk = MEM_mallocN(sizeof(MemFileChunk), "MemFileChunk");
+    *curchunk = *refchunk;
+    curchunk->next = curchunk->prev = NULL;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->is_shared = false;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    refchunk->is_identical_future = true;
+  }
+
+  mem_data->reference_current_chunk = refchunk;
+  return true;
+}
+
 struct Main *BLO_memfile_main_get(struct MemFile *memfile,
                                   struct Main *bmain,
                                   struct Scene **r_scene)
@@ -253,6 +538,9 @@ bool BLO_memfile_write_file(struct MemFile *memfile, const char *filename)
   }
 
   for (chunk = memfile->chunks.first; chunk; chunk = chunk->next) {
+    if (chunk->compressed_size != 0 && !memfile_chunk_decompress(memfile, chunk)) {
+      break;
+    }
 #ifdef _WIN32
     if ((size_t)write(file, chunk->buf, (uint)chunk->size) != chunk->size)
 #else
@@ -321,6 +609,12 @@ static ssize_t undo_read(FileReader *reader, void *buffer, size_t size)
         return 0;
       }
 
+      /* Chunks of old undo steps may be compressed, only restore them once they're needed. */
+      if (chunk->compressed_size != 0 && !memfile_chunk_decompress(undo->memfile, chunk)) {
+        printf("illegal read, chunk decompression failed\n");
+        return 0;
+      }
+
       chunkoffset = seek - offset;
       readsize = size - totread;
 
@@ -57,6 +57,10 @@
  * Preferred writing order: (not really a must, but why would you do it random?)
  * Any case: direct data is ALWAYS after the lib block.
  *
+ * - write #REND (#RenderInfo struct, one per scene).
+ * - write #TEST (128x128 blend file preview is optional).
+ * - write #GLOB (#FileGlobal struct) (some global vars).
+ * - write #DNA1 (#SDNA struct), early so readers can stop scanning once they found it.
  * (Local file data)
  * - for each LibBlock
  *   - write LibBlock
@@ -66,10 +70,9 @@
  *   - write library block
  *   - per LibBlock
  *     - write the ID of LibBlock
- * - write #TEST (#RenderInfo struct. 128x128 blend file preview is optional).
- * - write #GLOB (#FileGlobal struct) (some global vars).
- * - write #DNA1 (#SDNA struct)
  * - write #USER (#UserDef struct) if filename is `~/.config/blender/X.XX/config/startup.blend`.
+ * - write the index of the local ID's (#BlendFileIndexHeader), not for undo.
+ * - write #ENDB, its #BHead.nr is the size of the index block.
  */
 
 #include <fcntl.h>
@@ -111,6 +114,7 @@
 #include "BKE_blender_version.h"
 #include "BKE_bpath.h"
 #include "BKE_global.h" /* for G */
+#include "BKE_icons.h"
 #include "BKE_idprop.h"
 #include "BKE_idtype.h"
 #include "BKE_layer.h"
@@ -146,12 +150,12 @@
 
 #define ZSTD_BUFFER_SIZE (1 << 21) /* 2mb */
 #define ZSTD_CHUNK_SIZE (1 << 20)  /* 1mb */
+/* Large writes are split into frames of at most this size, so that they can be compressed
+ * by multiple threads at once (and for finer grained seeking when reading). */
+#define ZSTD_MAX_FRAME_SIZE ZSTD_BUFFER_SIZE
 
 #define ZSTD_COMPRESSION_LEVEL 3
 
-/** Use if we want to store how many bytes have been written to the file. */
-// #define USE_WRITE_DATA_LEN
-
 /* -------------------------------------------------------------------- */
 /** \name Internal Write Wrapper's (Abstracts Compression)
  * \{ */
@@ -191,6 +195,10 @@ struct WriteWrap {
     int level;
     ListBase frames;
 
+    /** Compression contexts (in #LinkData) that are reused between frames, protected by mutex.
+     * Creating a context is relatively expensive compared to compressing a single frame. */
+    ListBase contexts;
+
     bool write_error;
   } zstd;
 };
@@ -233,14 +241,39 @@ static void *zstd_write_task(void *userdata)
   ZstdWriteBlockTask *task = userdata;
   WriteWrap *ww = task->ww;
 
+  BLI_mutex_lock(&ww->zstd.mutex);
+  LinkData *context_link = BLI_pophead(&ww->zstd.contexts);
+  BLI_mutex_unlock(&ww->zstd.mutex);
+  if (context_link == NULL) {
+    ZSTD_CCtx *context = ZSTD_createCCtx();
+    if (context != NULL) {
+      context_link = BLI_genericNodeN(context);
+    }
+  }
+
   size_t out_buf_len = ZSTD_compressBound(task->size);
   void *out_buf = MEM_mallocN(out_buf_len, "Zstd out buffer");
-  size_t out_size = ZSTD_compress(
-      out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  size_t out_size;
+  if (context_link != NULL) {
+    out_size = ZSTD_compressCCtx(context_link->data,
+                                 out_buf,
+                                 out_buf_len,
+                                 task->data,
+                                 task->size,
+                                 ZSTD_COMPRESSION_LEVEL);
+  }
+  else {
+    /* No additional context could be created, let zstd use a temporary one. */
+    out_size = ZSTD_compress(
+        out_buf, out_buf_len, task->data, task->size, ZSTD_COMPRESSION_LEVEL);
+  }
 
   MEM_freeN(task->data);
 
   BLI_mutex_lock(&ww->zstd.mutex);
+  if (context_link != NULL) {
+    BLI_addtail(&ww->zstd.contexts, context_link);
+  }
 
   while (ww->zstd.next_frame != task->frame_number) {
     BLI_condition_wait(&ww->zstd.condition, &ww->zstd.mutex);
@@ -272,10 +305,22 @@ static void *zstd_write_task(void *userdata)
 
 static bool ww_open_zstd(WriteWrap *ww, const char *filepath)
 {
+  /* Creating a compression context only fails when out of memory,
+   * write the file uncompressed in that case instead of failing to save. */
+  ZSTD_CCtx *context = ZSTD_createCCtx();
+  if (context == NULL) {
+    ww->close = ww_close_none;
+    ww->write = ww_write_none;
+    return ww_open_none(ww, filepath);
+  }
+
   if (!ww_open_none(ww, filepath)) {
+    ZSTD_freeCCtx(context);
     return false;
   }
 
+  BLI_addtail(&ww->zstd.contexts, BLI_genericNodeN(context));
+
   /* Leave one thread open for the main writing logic, unless we only have one HW thread. */
   int num_threads = max_ii(1, BLI_system_thread_count() - 1);
   BLI_threadpool_init(&ww->zstd.threadpool, zstd_write_task, num_threads);
@@ -334,18 +379,19 @@ static bool ww_close_zstd(WriteWrap *ww)
   BLI_mutex_end(&ww->zstd.mutex);
   BLI_condition_end(&ww->zstd.condition);
 
+  LISTBASE_FOREACH (LinkData *, context_link, &ww->zstd.contexts) {
+    ZSTD_freeCCtx(context_link->data);
+  }
+  BLI_freelistN(&ww->zstd.contexts);
+
   zstd_write_seekable_frames(ww);
   BLI_freelistN(&ww->zstd.frames);
 
   return ww_close_none(ww) && !ww->zstd.write_error;
 }
 
-static size_t ww_write_zstd(WriteWrap *ww, const char *buf, size_t buf_len)
+static size_t ww_write_zstd_frame(WriteWrap *ww, const char *buf, size_t buf_len)
 {
-  if (ww->zstd.write_error) {
-    return 0;
-  }
-
   ZstdWriteBlockTask *task = MEM_mallocN(sizeof(ZstdWriteBlockTask), __func__);
   task->data = MEM_mallocN(buf_len, __func__);
   memcpy(task->data, buf, buf_len);
@@ -376,6 +422,22 @@ static size_t ww_write_zstd(WriteWrap *ww, const char *buf, size_t buf_len)
   return buf_len;
 }
 
+static size_t ww_write_zstd(WriteWrap *ww, const char *buf, size_t buf_len)
+{
+  if (ww->zstd.write_error) {
+    return 0;
+  }
+
+  /* Big blocks (bypassing the write buffer) would otherwise end up in a single frame,
+   * compressed by a single thread while the others sit idle. */
+  for (size_t offset = 0; offset < buf_len; offset += ZSTD_MAX_FRAME_SIZE) {
+    const size_t frame_len = MIN2(buf_len - offset, ZSTD_MAX_FRAME_SIZE);
+    ww_write_zstd_frame(ww, buf + offset, frame_len);
+  }
+
+  return buf_len;
+}
+
 /* --- end compression types --- */
 
 static void ww_handle_init(eWriteWrapType ww_type, WriteWrap *r_ww)
@@ -421,10 +483,8 @@ typedef struct {
     size_t chunk_size;
   } buffer;
 
-#ifdef USE_WRITE_DATA_LEN
-  /** Total number of bytes written. */
+  /** Total number of bytes written (before compression), the offsets stored in the index. */
   size_t write_len;
-#endif
 
   /** Set on unlikely case of an error (ignores further file writing). */
   bool error;
@@ -434,6 +494,13 @@ typedef struct {
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
 
+  /** Index of the written ID's, see #BlendFileIndexHeader (not used for undo). */
+  struct {
+    /** A #BlendFileIndexHeader followed by the entries. */
+    BlendFileIndexHeader *header;
+    int entries_len_alloc;
+  } index;
+
   /**
    * Wrap writing, so we can use zstd or
    * other compression types later, see: G_FILE_COMPRESS
@@ -500,6 +567,7 @@ static void writedata_free(WriteData *wd)
   if (wd->buffer.buf) {
     MEM_freeN(wd->buffer.buf);
   }
+  MEM_SAFE_FREE(wd->index.header);
   MEM_freeN(wd);
 }
 
@@ -537,9 +605,7 @@ static void mywrite(WriteData *wd, const void *adr, size_t len)
     return;
   }
 
-#ifdef USE_WRITE_DATA_LEN
   wd->write_len += len;
-#endif
 
   if (wd->buffer.buf == NULL) {
     writedata_do_write(wd, adr, len);
@@ -617,6 +683,54 @@ static bool mywrite_end(WriteData *wd)
   return err;
 }
 
+/**
+ * Whether writing the ID into an undo step can be skipped, re-using the memory chunks of the
+ * previous step instead.
+ *
+ * This relies on the update tags accumulated in #ID.recalc_after_undo_push by the depsgraph,
+ * so it is limited to geometry data-blocks, which are only modified through tagged updates.
+ * The #ID struct itself is compared by #BLO_memfile_id_chunks_reuse, since e.g. renaming an ID or
+ * changing its users is not tagged.
+ */
+static bool mywrite_id_is_unchanged(const WriteData *wd, const ID *id)
+{
+  if (!wd->use_memfile || !USER_EXPERIMENTAL_TEST(&U, use_undo_skip_unchanged_ids)) {
+    return false;
+  }
+  if (!ELEM(GS(id->name), ID_ME, ID_CU, ID_MB, ID_LT, ID_HA, ID_PT, ID_VO)) {
+    return false;
+  }
+  /* Any buffered data would end up in the chunks of the skipped ID. */
+  BLI_assert(wd->buffer.used_len == 0);
+  /* The previous step must also have been written without pending changes, otherwise its memory
+   * still stores a non-zero #ID.recalc_up_to_undo_push, which would be cleared when written now. */
+  return id->recalc_after_undo_push == 0 && id->recalc_up_to_undo_push == 0;
+}
+
+/**
+ * Clear runtime data of the copy of an ID that gets written,
+ * to reduce false detection of changed data in undo/redo context.
+ */
+static void write_id_buffer_clear_runtime(ID *id_buffer)
+{
+  id_buffer->tag = 0;
+  id_buffer->us = 0;
+  id_buffer->icon_id = 0;
+  /* Those listbase data change every time we add/remove an ID, and also often when
+   * renaming one (due to re-sorting). This avoids generating a lot of false 'is changed'
+   * detections between undo steps. */
+  id_buffer->prev = NULL;
+  id_buffer->next = NULL;
+  /* Those runtime pointers should never be set during writing stage, but just in case clear
+   * them too. */
+  id_buffer->orig_id = NULL;
+  id_buffer->newid = NULL;
+  /* Even though in theory we could be able to preserve this python instance across undo even
+   * when we need to re-read the ID into its original address, this is currently cleared in
+   * #direct_link_id_common in `readfile.c` anyway, */
+  id_buffer->py_instance = NULL;
+}
+
 /**
  * Start writing of data related to a single ID.
  *
@@ -1068,6 +1182,57 @@ static void write_global(WriteData *wd, int fileflags, Main *mainvar)
   writestruct(wd, GLOB, FileGlobal, 1, &fg);
 }
 
+/**
+ * \param id_offset: The offset of the first block written for \a id (#WriteData.write_len
+ * before #mywrite_id_begin).
+ */
+static void write_index_add_id(WriteData *wd, const ID *id, const size_t id_offset)
+{
+  BlendFileIndexHeader *header = wd->index.header;
+  if (header == NULL) {
+    wd->index.entries_len_alloc = 256;
+    header = wd->index.header = MEM_mallocN(
+        sizeof(*header) + sizeof(BlendFileIndexEntry) * (size_t)wd->index.entries_len_alloc,
+        __func__);
+    header->code = BLEND_FILE_INDEX_CODE;
+    header->entries_len = 0;
+  }
+  else if (header->entries_len == wd->index.entries_len_alloc) {
+    wd->index.entries_len_alloc *= 2;
+    header = wd->index.header = MEM_reallocN(
+        header,
+        sizeof(*header) + sizeof(BlendFileIndexEntry) * (size_t)wd->index.entries_len_alloc);
+  }
+
+  BlendFileIndexEntry *entry = &((BlendFileIndexEntry *)(header + 1))[header->entries_len++];
+  memset(entry, 0, sizeof(*entry));
+  entry->code = GS(id->name);
+  if (id->asset_data != NULL) {
+    entry->flag |= BLEND_FILE_INDEX_ENTRY_IS_ASSET;
+  }
+  if (BKE_previewimg_id_get(id) != NULL) {
+    entry->flag |= BLEND_FILE_INDEX_ENTRY_HAS_PREVIEW;
+  }
+  STRNCPY(entry->name, id->name);
+  entry->offset = (int64_t)id_offset;
+}
+
+/**
+ * Write the index of the ID's, see #BlendFileIndexHeader.
+ *
+ * \return the size of the written block (#BHead included), zero when nothing was written.
+ */
+static int write_index(WriteData *wd)
+{
+  const BlendFileIndexHeader *header = wd->index.header;
+  if (header == NULL) {
+    return 0;
+  }
+  const size_t len = sizeof(*header) + sizeof(BlendFileIndexEntry) * (size_t)header->entries_len;
+  writedata(wd, DATA, len, header);
+  return (int)(sizeof(BHead) + len);
+}
+
 /**
  * Preview image, first 2 values are width and height
  * second are an RGBA image (uchar).
@@ -1121,6 +1286,17 @@ static bool write_file_handle(Main *mainvar,
    * avoid thumbnail detecting changes because of this. */
   mywrite_flush(wd);
 
+  /* Write DNA right after #GLOB (which holds the sub-version needed to version the DNA itself),
+   * readers scan the blocks until they find it, so this avoids reading the headers of the whole
+   * file just to open it (e.g. for file browsing, asset listing or linking).
+   *
+   * Note that we *borrow* the pointer to 'DNAstr',
+   * so writing each time uses the same address and doesn't cause unnecessary undo overhead. */
+  writedata(wd, DNA1, (size_t)wd->sdna->data_len, wd->sdna->data);
+
+  /* So changes in #GLOB or the first ID don't cause 'DNA1' to be detected as changed on undo. */
+  mywrite_flush(wd);
+
   OverrideLibraryStorage *override_storage = wd->use_memfile ?
                                                  NULL :
                                                  BKE_lib_override_library_operations_store_init();
@@ -1169,6 +1345,14 @@ static bool write_file_handle(Main *mainvar,
           BKE_lib_override_library_operations_store_start(bmain, override_storage, id);
         }
 
+        if (mywrite_id_is_unchanged(wd, id)) {
+          ID id_head = *id;
+          write_id_buffer_clear_runtime(&id_head);
+          if (BLO_memfile_id_chunks_reuse(&wd->mem, id, &id_head)) {
+            continue;
+          }
+        }
+
         if (wd->use_memfile) {
           /* Record the changes that happened up to this undo push in
            * recalc_up_to_undo_push, and clear recalc_after_undo_push again
@@ -1191,27 +1375,11 @@ static bool write_file_handle(Main *mainvar,
           }
         }
 
+        const size_t id_offset = wd->write_len;
         mywrite_id_begin(wd, id);
 
         memcpy(id_buffer, id, idtype_struct_size);
-
-        /* Clear runtime data to reduce false detection of changed data in undo/redo context. */
-        ((ID *)id_buffer)->tag = 0;
-        ((ID *)id_buffer)->us = 0;
-        ((ID *)id_buffer)->icon_id = 0;
-        /* Those listbase data change every time we add/remove an ID, and also often when
-         * renaming one (due to re-sorting). This avoids generating a lot of false 'is changed'
-         * detections between undo steps. */
-        ((ID *)id_buffer)->prev = NULL;
-        ((ID *)id_buffer)->next = NULL;
-        /* Those runtime pointers should never be set during writing stage, but just in case clear
-         * them too. */
-        ((ID *)id_buffer)->orig_id = NULL;
-        ((ID *)id_buffer)->newid = NULL;
-        /* Even though in theory we could be able to preserve this python instance across undo even
-         * when we need to re-read the ID into its original address, this is currently cleared in
-         * #direct_link_id_common in `readfile.c` anyway, */
-        ((ID *)id_buffer)->py_instance = NULL;
+        write_id_buffer_clear_runtime((ID *)id_buffer);
 
         const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
         if (id_type->blend_write != NULL) {
@@ -1223,6 +1391,10 @@ static bool write_file_handle(Main *mainvar,
         }
 
         mywrite_id_end(wd, id);
+
+        if (!wd->use_memfile) {
+          write_index_add_id(wd, id, id_offset);
+        }
       }
 
       if (id_buffer != id_buffer_static) {
@@ -1241,22 +1413,20 @@ static bool write_file_handle(Main *mainvar,
   /* Special handling, operating over split Mains... */
   write_libraries(wd, mainvar->next);
 
-  /* So changes above don't cause a 'DNA1' to be detected as changed on undo. */
+  /* So changes above don't cause a 'USER' to be detected as changed on undo. */
   mywrite_flush(wd);
 
   if (use_userdef) {
     write_userdef(&writer, &U);
   }
 
-  /* Write DNA last, because (to be implemented) test for which structs are written.
-   *
-   * Note that we *borrow* the pointer to 'DNAstr',
-   * so writing each time uses the same address and doesn't cause unnecessary undo overhead. */
-  writedata(wd, DNA1, (size_t)wd->sdna->data_len, wd->sdna->data);
+  const int index_len = write_index(wd);
 
   /* end of file */
   memset(&bhead, 0, sizeof(BHead));
   bhead.code = ENDB;
+  /* Allows finding the index from the end of the file. */
+  bhead.nr = index_len;
   mywrite(wd, &bhead, sizeof(BHead));
 
   blo_join_main(&mainlist);
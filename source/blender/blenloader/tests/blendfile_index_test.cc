@@ -0,0 +1,173 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ */
+#include "blendfile_loading_base_test.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_linklist.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+
+#include "BKE_appdir.h"
+#include "BKE_asset.h"
+#include "BKE_icons.h"
+#include "BKE_lib_id.h"
+#include "BKE_main.h"
+
+#include "BLO_readfile.h"
+#include "BLO_writefile.h"
+
+#include "DNA_ID.h"
+#include "DNA_material_types.h"
+
+/* The ID's written to the test file. */
+#define ASSET_NAME "Asset"
+#define PLAIN_NAME "Plain"
+#define PREVIEW_SIZE 4
+#define PREVIEW_PIXEL 0xff00ff00u
+
+class BlendfileIndexTest : public BlendfileLoadingBaseTest {
+ protected:
+  char filepath[FILE_MAX] = "";
+
+  void SetUp() override
+  {
+    BlendfileLoadingBaseTest::SetUp();
+
+    BKE_tempdir_init(nullptr);
+    BLI_path_join(
+        filepath, sizeof(filepath), BKE_tempdir_session(), "blendfile_index_test.blend", NULL);
+  }
+
+  void TearDown() override
+  {
+    BLI_delete(filepath, false, false);
+    BlendfileLoadingBaseTest::TearDown();
+  }
+
+  /* Write a file with two materials, the first one being an asset with a preview. */
+  bool write_test_file()
+  {
+    Main *bmain = BKE_main_new();
+
+    ID *asset_id = static_cast<ID *>(BKE_id_new(bmain, ID_MA, ASSET_NAME));
+    asset_id->asset_data = BKE_asset_metadata_create();
+    PreviewImage *prv = BKE_previewimg_id_ensure(asset_id);
+    prv->w[ICON_SIZE_ICON] = prv->h[ICON_SIZE_ICON] = PREVIEW_SIZE;
+    prv->rect[ICON_SIZE_ICON] = static_cast<uint *>(
+        MEM_mallocN(sizeof(uint) * PREVIEW_SIZE * PREVIEW_SIZE, __func__));
+    for (int i = 0; i < PREVIEW_SIZE * PREVIEW_SIZE; i++) {
+      prv->rect[ICON_SIZE_ICON][i] = PREVIEW_PIXEL;
+    }
+
+    BKE_id_new(bmain, ID_MA, PLAIN_NAME);
+
+    BlendFileWriteParams params = {BLO_WRITE_PATH_REMAP_NONE};
+    const bool ok = BLO_write_file(bmain, filepath, 0, &params, nullptr);
+    BKE_main_free(bmain);
+    return ok;
+  }
+
+  /* Check what is read back from the handle matches what #write_test_file wrote. */
+  void expect_test_file_contents(BlendHandle *bh)
+  {
+    int tot;
+    LinkNode *names = BLO_blendhandle_get_datablock_names(bh, ID_MA, false, &tot);
+    EXPECT_EQ(tot, 2);
+    EXPECT_EQ(BLI_linklist_count(names), 2);
+    BLI_linklist_freeN(names);
+
+    names = BLO_blendhandle_get_datablock_names(bh, ID_MA, true, &tot);
+    ASSERT_EQ(tot, 1);
+    EXPECT_STREQ(static_cast<const char *>(names->link), ASSET_NAME);
+    BLI_linklist_freeN(names);
+
+    LinkNode *infos = BLO_blendhandle_get_datablock_info(bh, ID_MA, true, &tot);
+    ASSERT_EQ(tot, 1);
+    BLODataBlockInfo *info = static_cast<BLODataBlockInfo *>(infos->link);
+    EXPECT_STREQ(info->name, ASSET_NAME);
+    EXPECT_NE(info->asset_data, nullptr);
+    BKE_asset_metadata_free(&info->asset_data);
+    BLI_linklist_freeN(infos);
+
+    PreviewImage *prv = BLO_blendhandle_get_preview_for_id(bh, ID_MA, ASSET_NAME);
+    ASSERT_NE(prv, nullptr);
+    EXPECT_EQ(prv->w[ICON_SIZE_ICON], PREVIEW_SIZE);
+    ASSERT_NE(prv->rect[ICON_SIZE_ICON], nullptr);
+    EXPECT_EQ(prv->rect[ICON_SIZE_ICON][PREVIEW_SIZE * PREVIEW_SIZE - 1], PREVIEW_PIXEL);
+    BKE_previewimg_freefunc(prv);
+
+    EXPECT_EQ(BLO_blendhandle_get_preview_for_id(bh, ID_MA, PLAIN_NAME), nullptr);
+
+    LinkNode *previews = BLO_blendhandle_get_previews(bh, ID_MA, &tot);
+    EXPECT_EQ(tot, 2);
+    int tot_rects = 0;
+    for (LinkNode *link = previews; link; link = link->next) {
+      tot_rects += (static_cast<PreviewImage *>(link->link)->rect[ICON_SIZE_ICON] != nullptr);
+    }
+    EXPECT_EQ(tot_rects, 1);
+    BLI_linklist_free(previews, BKE_previewimg_freefunc);
+
+    LinkNode *groups = BLO_blendhandle_get_linkable_groups(bh);
+    bool has_material = false;
+    for (LinkNode *link = groups; link; link = link->next) {
+      has_material |= STREQ(static_cast<const char *>(link->link), "Material");
+    }
+    EXPECT_TRUE(has_material);
+    BLI_linklist_freeN(groups);
+
+    /* The names are still found after reading blocks at the offsets of the index. */
+    names = BLO_blendhandle_get_datablock_names(bh, ID_MA, false, &tot);
+    EXPECT_EQ(tot, 2);
+    BLI_linklist_freeN(names);
+  }
+};
+
+TEST_F(BlendfileIndexTest, RoundTrip)
+{
+  ASSERT_TRUE(write_test_file());
+
+  BlendHandle *bh = BLO_blendhandle_from_file(filepath, nullptr);
+  ASSERT_NE(bh, nullptr);
+  expect_test_file_contents(bh);
+  BLO_blendhandle_close(bh);
+}
+
+TEST_F(BlendfileIndexTest, FallbackWithoutIndex)
+{
+  ASSERT_TRUE(write_test_file());
+
+  size_t mem_size;
+  char *mem = static_cast<char *>(BLI_file_read_binary_as_mem(filepath, 0, &mem_size));
+  ASSERT_NE(mem, nullptr);
+
+  /* Files written without the index have a zero #BHead.nr in #ENDB, the last member of the
+   * last block of the file. Clearing it makes reading scan the blocks instead. */
+  int endb_nr;
+  memcpy(&endb_nr, mem + mem_size - sizeof(int), sizeof(int));
+  EXPECT_GT(endb_nr, 0);
+  memset(mem + mem_size - sizeof(int), 0, sizeof(int));
+
+  BlendHandle *bh = BLO_blendhandle_from_memory(mem, int(mem_size), nullptr);
+  ASSERT_NE(bh, nullptr);
+  expect_test_file_contents(bh);
+  BLO_blendhandle_close(bh);
+
+  MEM_freeN(mem);
+}
@@ -87,6 +87,23 @@ void BM_face_normal_flip(BMesh *bm, BMFace *f) ATTR_NONNULL();
 bool BM_face_point_inside_test(const BMFace *f, const float co[3]) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL();
 
+void BM_face_triangulate_calc(BMFace *f,
+                              const int quad_method,
+                              const int ngon_method,
+                              struct MemArena *pf_arena,
+                              struct Heap *pf_heap,
+                              BMLoop **r_loops,
+                              uint (*r_tris)[3]) ATTR_NONNULL(1, 6, 7);
+void BM_face_triangulate_from_tris(BMesh *bm,
+                                   BMFace *f,
+                                   BMLoop **loops,
+                                   const uint (*tris)[3],
+                                   BMFace **r_faces_new,
+                                   int *r_faces_new_tot,
+                                   BMEdge **r_edges_new,
+                                   int *r_edges_new_tot,
+                                   struct LinkNode **r_faces_double,
+                                   const bool use_tag) ATTR_NONNULL(1, 2, 3, 4);
 void BM_face_triangulate(BMesh *bm,
                          BMFace *f,
                          BMFace **r_faces_new,
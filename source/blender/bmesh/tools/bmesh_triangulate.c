@@ -28,6 +28,7 @@
 #include "BLI_heap.h"
 #include "BLI_linklist.h"
 #include "BLI_memarena.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 /* only for defines */
@@ -38,39 +39,91 @@
 
 #include "bmesh_triangulate.h" /* own include */
 
+/* -------------------------------------------------------------------- */
+/** \name Calculate Triangulation
+ *
+ * Calculating how faces are split only reads the mesh, so it's done for all faces
+ * from threads, before the new faces are created.
+ * \{ */
+
+typedef struct TriangulateCalcData {
+  BMFace **faces;
+  /** Offset of the loops of every face, the offset of its triangles follows from it. */
+  const int *loops_offset;
+  BMLoop **loops;
+  uint (*tris)[3];
+  int quad_method;
+  int ngon_method;
+} TriangulateCalcData;
+
+typedef struct TriangulateCalcTLS {
+  MemArena *pf_arena;
+  /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
+  Heap *pf_heap;
+} TriangulateCalcTLS;
+
+BLI_INLINE int triangulate_tris_offset(const int *loops_offset, const int face_index)
+{
+  /* Every face has two triangles less than it has loops. */
+  return loops_offset[face_index] - (face_index * 2);
+}
+
+static void triangulate_calc_task_cb(void *__restrict userdata,
+                                     const int face_index,
+                                     const TaskParallelTLS *__restrict tls)
+{
+  TriangulateCalcData *data = userdata;
+  TriangulateCalcTLS *tls_data = tls->userdata_chunk;
+  /* Quads don't use polyfill. */
+  BMFace *f = data->faces[face_index];
+  if (f->len > 4 && tls_data->pf_arena == NULL) {
+    tls_data->pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
+    if (data->ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
+      tls_data->pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+    }
+  }
+  BM_face_triangulate_calc(f,
+                           data->quad_method,
+                           data->ngon_method,
+                           tls_data->pf_arena,
+                           tls_data->pf_heap,
+                           &data->loops[data->loops_offset[face_index]],
+                           &data->tris[triangulate_tris_offset(data->loops_offset, face_index)]);
+}
+
+static void triangulate_calc_free_cb(const void *__restrict UNUSED(userdata),
+                                     void *__restrict tls_v)
+{
+  TriangulateCalcTLS *tls_data = tls_v;
+  if (tls_data->pf_arena) {
+    BLI_memarena_free(tls_data->pf_arena);
+  }
+  if (tls_data->pf_heap) {
+    BLI_heap_free(tls_data->pf_heap, NULL);
+  }
+}
+
+/** \} */
+
 /**
- * a version of #BM_face_triangulate that maps to #BMOpSlot
+ * a version of #BM_face_triangulate_from_tris that maps to #BMOpSlot
  */
 static void bm_face_triangulate_mapping(BMesh *bm,
                                         BMFace *face,
-                                        const int quad_method,
-                                        const int ngon_method,
+                                        BMLoop **loops,
+                                        const uint (*tris)[3],
                                         const bool use_tag,
                                         BMOperator *op,
                                         BMOpSlot *slot_facemap_out,
-                                        BMOpSlot *slot_facemap_double_out,
-
-                                        MemArena *pf_arena,
-                                        /* use for MOD_TRIANGULATE_NGON_BEAUTY only! */
-                                        struct Heap *pf_heap)
+                                        BMOpSlot *slot_facemap_double_out)
 {
   int faces_array_tot = face->len - 3;
   BMFace **faces_array = BLI_array_alloca(faces_array, faces_array_tot);
   LinkNode *faces_double = NULL;
   BLI_assert(face->len > 3);
 
-  BM_face_triangulate(bm,
-                      face,
-                      faces_array,
-                      &faces_array_tot,
-                      NULL,
-                      NULL,
-                      &faces_double,
-                      quad_method,
-                      ngon_method,
-                      use_tag,
-                      pf_arena,
-                      pf_heap);
+  BM_face_triangulate_from_tris(
+      bm, face, loops, tris, faces_array, &faces_array_tot, NULL, NULL, &faces_double, use_tag);
 
   if (faces_array_tot) {
     int i;
@@ -99,57 +152,77 @@ void BM_mesh_triangulate(BMesh *bm,
 {
   BMIter iter;
   BMFace *face;
-  MemArena *pf_arena;
-  Heap *pf_heap;
 
-  pf_arena = BLI_memarena_new(BLI_POLYFILL_ARENA_SIZE, __func__);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    pf_heap = BLI_heap_new_ex(BLI_POLYFILL_ALLOC_NGON_RESERVE);
+  /* Gather the faces to triangulate first, the mesh changes while splitting them. */
+  BMFace **faces = MEM_malloc_arrayN(bm->totface, sizeof(*faces), __func__);
+  int *loops_offset = MEM_malloc_arrayN(bm->totface, sizeof(*loops_offset), __func__);
+  int faces_len = 0;
+  int loops_len = 0;
+  BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
+    if (face->len >= min_vertices) {
+      if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
+        BLI_assert(face->len > 3);
+        faces[faces_len] = face;
+        loops_offset[faces_len] = loops_len;
+        faces_len++;
+        loops_len += face->len;
+      }
+    }
   }
-  else {
-    pf_heap = NULL;
+
+  BMLoop **loops = MEM_malloc_arrayN(loops_len, sizeof(*loops), __func__);
+  uint(*tris)[3] = MEM_malloc_arrayN(loops_len - (faces_len * 2), sizeof(*tris), __func__);
+
+  {
+    TriangulateCalcData data = {
+        .faces = faces,
+        .loops_offset = loops_offset,
+        .loops = loops,
+        .tris = tris,
+        .quad_method = quad_method,
+        .ngon_method = ngon_method,
+    };
+    TriangulateCalcTLS tls = {NULL};
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.use_threading = faces_len >= BM_OMP_LIMIT;
+    settings.userdata_chunk = &tls;
+    settings.userdata_chunk_size = sizeof(tls);
+    settings.func_free = triangulate_calc_free_cb;
+    BLI_task_parallel_range(0, faces_len, &data, triangulate_calc_task_cb, &settings);
   }
 
   if (slot_facemap_out) {
     /* same as below but call: bm_face_triangulate_mapping() */
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          bm_face_triangulate_mapping(bm,
-                                      face,
-                                      quad_method,
-                                      ngon_method,
-                                      tag_only,
-                                      op,
-                                      slot_facemap_out,
-                                      slot_facemap_double_out,
-                                      pf_arena,
-                                      pf_heap);
-        }
-      }
+    for (int i = 0; i < faces_len; i++) {
+      const int tris_offset = triangulate_tris_offset(loops_offset, i);
+      const uint(*face_tris)[3] = (const uint(*)[3])&tris[tris_offset];
+      bm_face_triangulate_mapping(bm,
+                                  faces[i],
+                                  &loops[loops_offset[i]],
+                                  face_tris,
+                                  tag_only,
+                                  op,
+                                  slot_facemap_out,
+                                  slot_facemap_double_out);
     }
   }
   else {
     LinkNode *faces_double = NULL;
 
-    BM_ITER_MESH (face, &iter, bm, BM_FACES_OF_MESH) {
-      if (face->len >= min_vertices) {
-        if (tag_only == false || BM_elem_flag_test(face, BM_ELEM_TAG)) {
-          BM_face_triangulate(bm,
-                              face,
-                              NULL,
-                              NULL,
-                              NULL,
-                              NULL,
-                              &faces_double,
-                              quad_method,
-                              ngon_method,
-                              tag_only,
-                              pf_arena,
-                              pf_heap);
-        }
-      }
+    for (int i = 0; i < faces_len; i++) {
+      const int tris_offset = triangulate_tris_offset(loops_offset, i);
+      const uint(*face_tris)[3] = (const uint(*)[3])&tris[tris_offset];
+      BM_face_triangulate_from_tris(bm,
+                                    faces[i],
+                                    &loops[loops_offset[i]],
+                                    face_tris,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    NULL,
+                                    &faces_double,
+                                    tag_only);
     }
 
     while (faces_double) {
@@ -160,9 +233,8 @@ void BM_mesh_triangulate(BMesh *bm,
     }
   }
 
-  BLI_memarena_free(pf_arena);
-
-  if (ngon_method == MOD_TRIANGULATE_NGON_BEAUTY) {
-    BLI_heap_free(pf_heap, NULL);
-  }
+  MEM_freeN(faces);
+  MEM_freeN(loops_offset);
+  MEM_freeN(loops);
+  MEM_freeN(tris);
 }
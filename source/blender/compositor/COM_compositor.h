@@ -347,6 +347,30 @@ void COM_execute(RenderData *render_data,
                  const ColorManagedDisplaySettings *display_settings,
                  const char *view_name);
 
+/**
+ * \brief Statistics of the last execution of a node, summed over the operations it was converted
+ * to. For group nodes they are the sum of the nodes inside of them.
+ */
+typedef struct COM_NodeExecutionStats {
+  /** Time from the start to the end of the execution, in seconds. */
+  double wall_time;
+  /** Time summed over the compositor threads, in seconds. */
+  double thread_time;
+  /** Number of rendered pixels. */
+  int64_t area;
+  /** Bytes allocated for the output buffers. */
+  int64_t memory;
+} COM_NodeExecutionStats;
+
+/**
+ * \brief Get the statistics of the last execution of a node of the scene compositing tree.
+ * \param key: Instance key of the node, see #BKE_node_instance_key.
+ * \return false when the node wasn't executed.
+ */
+bool COM_node_execution_stats_get(const struct Scene *scene,
+                                  bNodeInstanceKey key,
+                                  COM_NodeExecutionStats *r_stats);
+
 /**
  * \brief Deinitialize the compositor caches and allocated memory.
  * Use COM_clear_caches to only free the caches.
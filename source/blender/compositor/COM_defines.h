@@ -123,6 +123,8 @@ enum class ChunkOrdering {
 constexpr float COM_PREVIEW_SIZE = 140.f;
 constexpr float COM_RULE_OF_THIRDS_DIVIDER = 100.0f;
 constexpr float COM_BLUR_BOKEH_PIXELS = 512;
+/** Memory budget in bytes of the results cached between executions. */
+constexpr size_t COM_RESULT_CACHE_MAX_SIZE = 1024 * 1024 * 1024;
 
 constexpr rcti COM_AREA_NONE = {0, 0, 0, 0};
 constexpr rcti COM_CONSTANT_INPUT_AREA_OF_INTEREST = COM_AREA_NONE;
@@ -19,8 +19,11 @@
 #include "COM_CPUDevice.h"
 
 #include "COM_ExecutionGroup.h"
+#include "COM_ExecutionSystem.h"
 #include "COM_NodeOperation.h"
 
+#include "PIL_time.h"
+
 namespace blender::compositor {
 
 CPUDevice::CPUDevice(int thread_id) : thread_id_(thread_id)
@@ -34,7 +37,13 @@ void CPUDevice::execute(WorkPackage *work_package)
       const unsigned int chunk_number = work_package->chunk_number;
       ExecutionGroup *execution_group = work_package->execution_group;
 
-      execution_group->get_output_operation()->execute_region(&work_package->rect, chunk_number);
+      NodeOperation *operation = execution_group->get_output_operation();
+
+      const double start_time = PIL_check_seconds_timer();
+      operation->execute_region(&work_package->rect, chunk_number);
+      operation->get_execution_system()->get_profiler().chunk_executed(
+          operation, work_package->rect, start_time, PIL_check_seconds_timer());
+
       execution_group->finalize_chunk_execution(chunk_number, nullptr);
       break;
     }
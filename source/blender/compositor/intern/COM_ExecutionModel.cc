@@ -32,6 +32,13 @@ ExecutionModel::ExecutionModel(CompositorContext &context, Span<NodeOperation *>
                               viewer_border->ymin < viewer_border->ymax;
   border_.viewer_border = viewer_border;
 
+  const rctf *visible_region = &node_tree->visible_region;
+  border_.use_visible_region = !context.is_rendering() &&
+                               (node_tree->flag & NTREE_VISIBLE_REGION) &&
+                               visible_region->xmin < visible_region->xmax &&
+                               visible_region->ymin < visible_region->ymax;
+  border_.visible_region = visible_region;
+
   const RenderData *rd = context_.get_render_data();
   /* Case when cropping to render border happens is handled in
    * compositor output and render layer nodes. */
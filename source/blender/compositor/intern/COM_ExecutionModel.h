@@ -38,13 +38,16 @@ class NodeOperation;
 class ExecutionModel {
  protected:
   /**
-   * Render and viewer border info. Coordinates are normalized.
+   * Render and viewer border info, and the part of viewers visible in editors. Coordinates are
+   * normalized.
    */
   struct {
     bool use_render_border;
     const rctf *render_border;
     bool use_viewer_border;
     const rctf *viewer_border;
+    bool use_visible_region;
+    const rctf *visible_region;
   } border_;
 
   /**
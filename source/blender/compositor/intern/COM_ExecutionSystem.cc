@@ -27,6 +27,8 @@
 #include "COM_WorkPackage.h"
 #include "COM_WorkScheduler.h"
 
+#include "PIL_time.h"
+
 #ifdef WITH_CXX_GUARDEDALLOC
 #  include "MEM_guardedalloc.h"
 #endif
@@ -116,6 +118,10 @@ void ExecutionSystem::execute()
     op->init_data();
   }
   execution_model_->execute(*this);
+
+  if (!is_breaked()) {
+    profiler_.finish(context_.get_scene(), context_.get_bnodetree());
+  }
 }
 
 /**
@@ -155,7 +161,9 @@ void ExecutionSystem::execute_work(const rcti &work_rect,
       rcti split_rect;
       BLI_rcti_init(
           &split_rect, work_rect.xmin, work_rect.xmax, sub_work_y, sub_work_y + sub_work_height);
+      const double start_time = PIL_check_seconds_timer();
       work_func(split_rect);
+      profiler_.add_work_time(PIL_check_seconds_timer() - start_time);
     };
     sub_work.executed_fn = [&]() {
       BLI_mutex_lock(&work_mutex_);
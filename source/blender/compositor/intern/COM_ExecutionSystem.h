@@ -27,6 +27,7 @@
 #include "BLI_vector.hh"
 
 #include "COM_CompositorContext.h"
+#include "COM_Profiler.h"
 #include "COM_SharedOperationBuffers.h"
 
 #include "DNA_color_types.h"
@@ -162,6 +163,8 @@ class ExecutionSystem {
   ThreadMutex work_mutex_;
   ThreadCondition work_finished_cond_;
 
+  Profiler profiler_;
+
  public:
   /**
    * \brief Create a new ExecutionSystem and initialize it with the
@@ -208,6 +211,11 @@ class ExecutionSystem {
     return active_buffers_;
   }
 
+  Profiler &get_profiler()
+  {
+    return profiler_;
+  }
+
   void execute_work(const rcti &work_rect, std::function<void(const rcti &split_rect)> work_func);
 
   /**
@@ -18,9 +18,14 @@
 
 #include "COM_FullFrameExecutionModel.h"
 
+#include "BLI_set.hh"
+
 #include "BLT_translation.h"
 
 #include "COM_Debug.h"
+#include "COM_ExecutionSystem.h"
+#include "COM_OperationResultCache.h"
+#include "COM_SharedOperationBuffers.h"
 #include "COM_ViewerOperation.h"
 #include "COM_WorkScheduler.h"
 
@@ -97,14 +102,34 @@ Vector<MemoryBuffer *> FullFrameExecutionModel::get_input_buffers(NodeOperation
   return inputs_buffers;
 }
 
+/**
+ * Whether operation buffer only needs to cover the areas to render instead of the whole canvas.
+ * Pixel-wise operations only write the given areas and are only read in them.
+ */
+static bool can_crop_operation_buffer(const NodeOperation *op)
+{
+  const NodeOperationFlags flags = op->get_flags();
+  return flags.can_be_fused && !flags.is_constant_operation && !flags.can_cache_result;
+}
+
 MemoryBuffer *FullFrameExecutionModel::create_operation_buffer(NodeOperation *op,
                                                                const int output_x,
-                                                               const int output_y)
+                                                               const int output_y,
+                                                               Span<rcti> areas)
 {
   rcti rect;
   BLI_rcti_init(
       &rect, output_x, output_x + op->get_width(), output_y, output_y + op->get_height());
 
+  /* Readers may need a small part of the canvas only, don't allocate the rest. */
+  if (can_crop_operation_buffer(op) && !areas.is_empty()) {
+    rcti areas_bounds = areas[0];
+    for (const rcti &area : areas.drop_front(1)) {
+      BLI_rcti_union(&areas_bounds, &area);
+    }
+    BLI_rcti_isect(&rect, &areas_bounds, &rect);
+  }
+
   const DataType data_type = op->get_output_socket(0)->get_data_type();
   const bool is_a_single_elem = op->get_flags().is_constant_operation;
   return new MemoryBuffer(data_type, rect, is_a_single_elem);
@@ -116,15 +141,30 @@ void FullFrameExecutionModel::render_operation(NodeOperation *op)
   constexpr int output_x = 0;
   constexpr int output_y = 0;
 
+  Profiler &profiler = op->get_execution_system()->get_profiler();
+  profiler.operation_started(op);
+
+  const int op_offset_x = output_x - op->get_canvas().xmin;
+  const int op_offset_y = output_y - op->get_canvas().ymin;
+  Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
+
   const bool has_outputs = op->get_number_of_output_sockets() > 0;
-  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y) : nullptr;
+  MemoryBuffer *op_buf = has_outputs ? create_operation_buffer(op, output_x, output_y, areas) :
+                                       nullptr;
   if (op->get_width() > 0 && op->get_height() > 0) {
     Vector<MemoryBuffer *> input_bufs = get_input_buffers(op, output_x, output_y);
-    const int op_offset_x = output_x - op->get_canvas().xmin;
-    const int op_offset_y = output_y - op->get_canvas().ymin;
-    Vector<rcti> areas = active_buffers_.get_areas_to_render(op, op_offset_x, op_offset_y);
-    op->render(op_buf, areas, input_bufs);
+    std::optional<OperationResultKey> cache_key = OperationResultCache::get_key(
+        op, input_bufs, areas);
+    if (!cache_key || !OperationResultCache::read(*cache_key, op_buf)) {
+      op->render(op_buf, areas, input_bufs);
+      /* Don't cache results of cancelled executions, they may be incomplete. */
+      const bNodeTree *node_tree = context_.get_bnodetree();
+      if (cache_key && !(node_tree && node_tree->test_break(node_tree->tbh))) {
+        OperationResultCache::add(std::move(*cache_key), *op_buf);
+      }
+    }
     DebugInfo::operation_rendered(op, op_buf);
+    profiler.operation_finished(op, op_buf, areas);
 
     for (MemoryBuffer *buf : input_bufs) {
       delete buf;
@@ -163,40 +203,119 @@ void FullFrameExecutionModel::render_operations()
 }
 
 /**
- * Returns all dependencies from inputs to outputs. A dependency may be repeated when
- * several operations depend on it.
+ * Estimated bytes of the output buffer of given operation.
  */
-static Vector<NodeOperation *> get_operation_dependencies(NodeOperation *operation)
+static int64_t get_buffer_bytes_estimate(NodeOperation *op)
 {
-  /* Get dependencies from outputs to inputs. */
-  Vector<NodeOperation *> dependencies;
-  Vector<NodeOperation *> next_outputs;
-  next_outputs.append(operation);
-  while (next_outputs.size() > 0) {
-    Vector<NodeOperation *> outputs(next_outputs);
-    next_outputs.clear();
-    for (NodeOperation *output : outputs) {
-      for (int i = 0; i < output->get_number_of_input_sockets(); i++) {
-        next_outputs.append(output->get_input_operation(i));
+  if (op->get_number_of_output_sockets() == 0) {
+    return 0;
+  }
+  const int64_t num_elems = op->get_flags().is_constant_operation ?
+                                1 :
+                                (int64_t)op->get_width() * op->get_height();
+  const DataType data_type = op->get_output_socket(0)->get_data_type();
+  return num_elems * COM_data_type_num_channels(data_type) * sizeof(float);
+}
+
+/**
+ * Plans the order operations are rendered in to lower peak memory usage. Inputs of an operation
+ * are rendered depth-first, the one needing most memory first (Sethi-Ullman order), so that
+ * buffers are freed as soon as their readers finish instead of keeping the buffers of whole
+ * levels of the tree alive at once.
+ */
+class RenderOrderPlanner {
+ private:
+  SharedOperationBuffers &buffers_;
+  /** Estimated peak memory needed to render an operation and its unrendered dependencies. */
+  Map<NodeOperation *, int64_t> peak_memory_;
+  /** Unrendered inputs of an operation in render order. */
+  Map<NodeOperation *, Vector<NodeOperation *>> inputs_order_;
+
+ public:
+  RenderOrderPlanner(SharedOperationBuffers &buffers) : buffers_(buffers)
+  {
+  }
+
+  /**
+   * Returns all unrendered dependencies of given operation in render order, from inputs to
+   * outputs.
+   */
+  Vector<NodeOperation *> get_dependencies(NodeOperation *operation)
+  {
+    estimate_peak_memory(operation);
+
+    Vector<NodeOperation *> dependencies;
+    Set<NodeOperation *> visited;
+    add_dependencies(operation, visited, dependencies);
+    return dependencies;
+  }
+
+ private:
+  int64_t estimate_peak_memory(NodeOperation *op)
+  {
+    if (buffers_.is_operation_rendered(op)) {
+      return 0;
+    }
+    const int64_t *peak_memory = peak_memory_.lookup_ptr(op);
+    if (peak_memory) {
+      return *peak_memory;
+    }
+
+    Vector<NodeOperation *> inputs;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperation *input = op->get_input_operation(i);
+      if (!buffers_.is_operation_rendered(input)) {
+        inputs.append_non_duplicates(input);
       }
     }
-    dependencies.extend(next_outputs);
-  }
+    for (NodeOperation *input : inputs) {
+      estimate_peak_memory(input);
+    }
 
-  /* Reverse to get dependencies from inputs to outputs. */
-  std::reverse(dependencies.begin(), dependencies.end());
+    /* Render first the inputs that free the most memory between their peak and their result,
+     * results of the inputs rendered before are kept while rendering the next ones. */
+    std::stable_sort(inputs.begin(), inputs.end(), [&](NodeOperation *a, NodeOperation *b) {
+      return peak_memory_.lookup(a) - get_buffer_bytes_estimate(a) >
+             peak_memory_.lookup(b) - get_buffer_bytes_estimate(b);
+    });
+    int64_t peak = 0;
+    int64_t inputs_bytes = 0;
+    for (NodeOperation *input : inputs) {
+      peak = std::max(peak, inputs_bytes + peak_memory_.lookup(input));
+      inputs_bytes += get_buffer_bytes_estimate(input);
+    }
+    peak = std::max(peak, inputs_bytes + get_buffer_bytes_estimate(op));
 
-  return dependencies;
-}
+    peak_memory_.add_new(op, peak);
+    inputs_order_.add_new(op, std::move(inputs));
+    return peak;
+  }
+
+  void add_dependencies(NodeOperation *op,
+                        Set<NodeOperation *> &visited,
+                        Vector<NodeOperation *> &r_dependencies)
+  {
+    const Vector<NodeOperation *> *inputs = inputs_order_.lookup_ptr(op);
+    if (inputs == nullptr) {
+      return;
+    }
+    for (NodeOperation *input : *inputs) {
+      if (visited.add(input)) {
+        add_dependencies(input, visited, r_dependencies);
+        r_dependencies.append(input);
+      }
+    }
+  }
+};
 
 void FullFrameExecutionModel::render_output_dependencies(NodeOperation *output_op)
 {
   BLI_assert(output_op->is_output_operation(context_.is_rendering()));
-  Vector<NodeOperation *> dependencies = get_operation_dependencies(output_op);
+  RenderOrderPlanner planner(active_buffers_);
+  Vector<NodeOperation *> dependencies = planner.get_dependencies(output_op);
   for (NodeOperation *op : dependencies) {
-    if (!active_buffers_.is_operation_rendered(op)) {
-      render_operation(op);
-    }
+    BLI_assert(!active_buffers_.is_operation_rendered(op));
+    render_operation(op);
   }
 }
 
@@ -260,7 +379,7 @@ void FullFrameExecutionModel::determine_reads(NodeOperation *output_op)
 
 /**
  * Calculates given output operation area to be rendered taking into account viewer and render
- * borders.
+ * borders, and the visible region of viewers.
  */
 void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, rcti &r_area)
 {
@@ -286,6 +405,22 @@ void FullFrameExecutionModel::get_output_render_area(NodeOperation *output_op, r
     r_area.ymin = canvas.ymin + norm_border->ymin * h;
     r_area.ymax = canvas.ymin + norm_border->ymax * h;
   }
+
+  /* Only the visible part of viewers is needed, which in turn only needs the areas of interest
+   * of their inputs to be rendered. Rounded outwards for partially visible pixels. */
+  if (border_.use_visible_region && output_op->get_flags().is_viewer_operation) {
+    const rctf *region = border_.visible_region;
+    const int w = output_op->get_width();
+    const int h = output_op->get_height();
+    rcti visible_area;
+    visible_area.xmin = canvas.xmin + floorf(region->xmin * w);
+    visible_area.xmax = canvas.xmin + ceilf(region->xmax * w);
+    visible_area.ymin = canvas.ymin + floorf(region->ymin * h);
+    visible_area.ymax = canvas.ymin + ceilf(region->ymax * h);
+    if (!BLI_rcti_isect(&r_area, &visible_area, &r_area)) {
+      BLI_rcti_init(&r_area, 0, 0, 0, 0);
+    }
+  }
 }
 
 void FullFrameExecutionModel::operation_finished(NodeOperation *operation)
@@ -71,7 +71,10 @@ class FullFrameExecutionModel : public ExecutionModel {
   Vector<MemoryBuffer *> get_input_buffers(NodeOperation *op,
                                            const int output_x,
                                            const int output_y);
-  MemoryBuffer *create_operation_buffer(NodeOperation *op, const int output_x, const int output_y);
+  MemoryBuffer *create_operation_buffer(NodeOperation *op,
+                                        const int output_x,
+                                        const int output_y,
+                                        Span<rcti> areas);
   void render_operation(NodeOperation *op);
 
   void operation_finished(NodeOperation *operation);
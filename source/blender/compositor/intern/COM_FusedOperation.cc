@@ -0,0 +1,147 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_map.hh"
+
+#include "COM_FusedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Maximum number of elements evaluated at once per fused operation. Inner operations buffers
+ * are kept small enough to stay in the CPU cache.
+ */
+constexpr int FUSED_BLOCK_ELEMS = 4096;
+
+FusedOperation::FusedOperation(Span<NodeOperation *> operations,
+                               Vector<NodeOperationOutput *> &r_input_links)
+{
+  BLI_assert(operations.size() > 1);
+  Map<NodeOperation *, int> operations_indices;
+  Map<NodeOperationOutput *, int> input_links_indices;
+  for (NodeOperation *op : operations) {
+    BLI_assert(op->get_flags().can_be_fused);
+    BLI_assert(BLI_rcti_compare(&op->get_canvas(), &operations.last()->get_canvas()));
+
+    Vector<FusedInput> op_inputs;
+    for (int i = 0; i < op->get_number_of_input_sockets(); i++) {
+      NodeOperationOutput *link = op->get_input_socket(i)->get_link();
+      BLI_assert(link != nullptr);
+      const int *op_index = operations_indices.lookup_ptr(&link->get_operation());
+      if (op_index) {
+        op_inputs.append({true, *op_index});
+      }
+      else {
+        const int input_index = input_links_indices.lookup_or_add_cb(link, [&]() {
+          this->add_input_socket(link->get_data_type());
+          r_input_links.append(link);
+          return r_input_links.size() - 1;
+        });
+        op_inputs.append({false, input_index});
+      }
+    }
+
+    operations_indices.add_new(op, operations_.size());
+    operations_.append(static_cast<MultiThreadedOperation *>(op));
+    operations_inputs_.append(std::move(op_inputs));
+  }
+
+  NodeOperation *last_op = operations.last();
+  this->add_output_socket(last_op->get_output_socket()->get_data_type());
+  this->set_canvas(last_op->get_canvas());
+  this->set_name(last_op->get_name());
+  /* Pixel-wise as the operations it evaluates, chains are fused only once. */
+  flags_.can_be_fused = true;
+}
+
+FusedOperation::~FusedOperation()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    delete op;
+  }
+}
+
+void FusedOperation::init_data()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    op->init_data();
+  }
+}
+
+void FusedOperation::init_execution()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    op->set_bnodetree(get_bnodetree());
+    op->init_execution();
+  }
+}
+
+void FusedOperation::deinit_execution()
+{
+  for (MultiThreadedOperation *op : operations_) {
+    op->deinit_execution();
+  }
+}
+
+void FusedOperation::update_memory_buffer_partial(MemoryBuffer *output,
+                                                  const rcti &area,
+                                                  Span<MemoryBuffer *> inputs)
+{
+  const int width = BLI_rcti_size_x(&area);
+  const int block_height = MAX2(FUSED_BLOCK_ELEMS / MAX2(width, 1), 1);
+  const int num_inner_ops = operations_.size() - 1;
+
+  /* Allocate inner buffers once for all blocks. */
+  Array<Array<float>> inner_data(num_inner_ops);
+  for (int i = 0; i < num_inner_ops; i++) {
+    const DataType data_type = operations_[i]->get_output_socket()->get_data_type();
+    inner_data[i].reinitialize((int64_t)width * block_height *
+                               COM_data_type_num_channels(data_type));
+  }
+
+  Vector<MemoryBuffer> inner_bufs;
+  inner_bufs.reserve(num_inner_ops);
+  Vector<MemoryBuffer *> op_inputs;
+  for (int y = area.ymin; y < area.ymax; y += block_height) {
+    rcti block;
+    BLI_rcti_init(&block, area.xmin, area.xmax, y, MIN2(y + block_height, area.ymax));
+
+    inner_bufs.clear();
+    for (int i = 0; i < operations_.size(); i++) {
+      MultiThreadedOperation *op = operations_[i];
+
+      op_inputs.clear();
+      for (const FusedInput &input : operations_inputs_[i]) {
+        op_inputs.append(input.is_fused ? &inner_bufs[input.index] : inputs[input.index]);
+      }
+
+      if (i == num_inner_ops) {
+        op->update_memory_buffer_partial(output, block, op_inputs);
+      }
+      else {
+        const DataType data_type = op->get_output_socket()->get_data_type();
+        inner_bufs.append_as(
+            inner_data[i].data(), COM_data_type_num_channels(data_type), block, false);
+        op->update_memory_buffer_partial(&inner_bufs.last(), block, op_inputs);
+      }
+    }
+  }
+}
+
+}  // namespace blender::compositor
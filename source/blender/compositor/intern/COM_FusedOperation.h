@@ -0,0 +1,71 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include "COM_MultiThreadedOperation.h"
+
+namespace blender::compositor {
+
+/**
+ * Evaluates a chain of operations that can be fused (see NodeOperationFlags.can_be_fused) as a
+ * single operation. Output of inner operations is only written into small per-thread buffers
+ * that are read back right away by the next operation of the chain, instead of full canvas
+ * buffers.
+ *
+ * Fused operations are owned by this operation. They keep their original input links, so
+ * their tiled readers stay valid, but they are not part of the execution system anymore.
+ */
+class FusedOperation : public MultiThreadedOperation {
+ private:
+  /** Where a fused operation reads an input from. */
+  struct FusedInput {
+    /** When true #index is a fused operation, else an input socket of this operation. */
+    bool is_fused;
+    int index;
+  };
+
+  /** Fused operations in execution order. Last one writes to the output of this operation. */
+  Vector<MultiThreadedOperation *> operations_;
+  Vector<Vector<FusedInput>> operations_inputs_;
+
+ public:
+  /**
+   * \param operations: Operations in execution order where every operation but the last one is
+   * only read by later operations of the chain. All must have the same canvas.
+   * \param r_input_links: Outputs to link to the created input sockets, in order.
+   */
+  FusedOperation(Span<NodeOperation *> operations, Vector<NodeOperationOutput *> &r_input_links);
+  ~FusedOperation();
+
+  int get_num_fused_operations() const
+  {
+    return operations_.size();
+  }
+
+  void init_data() override;
+  void init_execution() override;
+  void deinit_execution() override;
+
+ protected:
+  void update_memory_buffer_partial(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
+};
+
+}  // namespace blender::compositor
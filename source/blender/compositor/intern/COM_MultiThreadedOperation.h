@@ -23,6 +23,10 @@
 namespace blender::compositor {
 
 class MultiThreadedOperation : public NodeOperation {
+ private:
+  /* Calls #update_memory_buffer_partial of the operations it fuses. */
+  friend class FusedOperation;
+
  protected:
   /**
    * Number of execution passes.
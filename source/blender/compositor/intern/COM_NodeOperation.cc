@@ -18,6 +18,8 @@
 
 #include <cstdio>
 
+#include "BKE_node.h"
+
 #include "COM_BufferOperation.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_ReadBufferOperation.h"
@@ -35,6 +37,7 @@ NodeOperation::NodeOperation()
   canvas_input_index_ = 0;
   canvas_ = COM_AREA_NONE;
   btree_ = nullptr;
+  node_instance_key_ = NODE_INSTANCE_KEY_NONE;
 }
 
 /** Get constant value when operation is constant, otherwise return default_value. */
@@ -249,6 +249,20 @@ struct NodeOperationFlags {
    */
   bool can_be_constant : 1;
 
+  /**
+   * Whether operation computes every output element in a single pass from the input elements
+   * at the same coordinates only. Chains of such operations are evaluated together by a
+   * #FusedOperation in full frame execution.
+   */
+  bool can_be_fused : 1;
+
+  /**
+   * Whether the operation result is kept in the #OperationResultCache between executions. For
+   * expensive operations whose result only depends on their inputs and on the params hashed by
+   * #hash_output_params.
+   */
+  bool can_cache_result : 1;
+
   NodeOperationFlags()
   {
     complex = false;
@@ -267,6 +281,8 @@ struct NodeOperationFlags {
     is_fullframe_operation = false;
     is_constant_operation = false;
     can_be_constant = false;
+    can_be_fused = false;
+    can_cache_result = false;
   }
 };
 
@@ -286,6 +302,12 @@ struct NodeOperationHash {
     return operation_;
   }
 
+  /** Hash of the operation type and output params, it doesn't depend on its inputs. */
+  uint64_t get_type_and_params_hash() const
+  {
+    return get_default_hash_2(type_hash_, params_hash_);
+  }
+
   bool operator==(const NodeOperationHash &other) const
   {
     return type_hash_ == other.type_hash_ && parents_hash_ == other.parents_hash_ &&
@@ -345,6 +367,11 @@ class NodeOperation {
    */
   const bNodeTree *btree_;
 
+  /**
+   * Instance key of the node the operation was created for, used for profiling.
+   */
+  bNodeInstanceKey node_instance_key_;
+
  protected:
   /**
    * Compositor execution model.
@@ -385,6 +412,16 @@ class NodeOperation {
     return id_;
   }
 
+  void set_node_instance_key(const bNodeInstanceKey key)
+  {
+    node_instance_key_ = key;
+  }
+
+  const bNodeInstanceKey get_node_instance_key() const
+  {
+    return node_instance_key_;
+  }
+
   float get_constant_value_default(float default_value);
   const float *get_constant_elem_default(const float *default_elem);
 
@@ -440,11 +477,21 @@ class NodeOperation {
     btree_ = tree;
   }
 
+  const bNodeTree *get_bnodetree() const
+  {
+    return btree_;
+  }
+
   void set_execution_system(ExecutionSystem *system)
   {
     exec_system_ = system;
   }
 
+  ExecutionSystem *get_execution_system() const
+  {
+    return exec_system_;
+  }
+
   /**
    * Initializes operation data needed after operations are linked and resolutions determined. For
    * rendering heap memory data use init_execution().
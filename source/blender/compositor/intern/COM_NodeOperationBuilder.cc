@@ -24,6 +24,7 @@
 #include "COM_Debug.h"
 
 #include "COM_ExecutionGroup.h"
+#include "COM_FusedOperation.h"
 #include "COM_PreviewOperation.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_SetColorOperation.h"
@@ -107,6 +108,11 @@ void NodeOperationBuilder::convert_to_operations(ExecutionSystem *system)
   save_graphviz("compositor_prior_merging");
   merge_equal_operations();
 
+  if (context_->get_execution_model() == eExecutionModel::FullFrame) {
+    save_graphviz("compositor_prior_fusing");
+    fuse_operations();
+  }
+
   if (context_->get_execution_model() == eExecutionModel::Tiled) {
     /* surround complex ops with read/write buffer */
     add_complex_operation_buffers();
@@ -136,6 +142,7 @@ void NodeOperationBuilder::add_operation(NodeOperation *operation)
   operations_.append(operation);
   if (current_node_) {
     operation->set_name(current_node_->get_bnode()->name);
+    operation->set_node_instance_key(current_node_->get_instance_key());
   }
   operation->set_execution_model(context_->get_execution_model());
   operation->set_execution_system(exec_system_);
@@ -513,6 +520,95 @@ void NodeOperationBuilder::merge_equal_operations(NodeOperation *from, NodeOpera
   delete from;
 }
 
+static bool can_be_fused(const NodeOperation *operation)
+{
+  return operation->get_flags().can_be_fused && !operation->get_flags().is_constant_operation &&
+         operation->get_number_of_output_sockets() == 1;
+}
+
+/**
+ * Whether operation is evaluated as part of the operation reading it. It must be its only
+ * reader, be fusable too and have the same canvas.
+ */
+static bool is_fused_into_reader(
+    NodeOperation *operation, const MultiValueMap<NodeOperation *, NodeOperationInput *> &readers)
+{
+  if (!can_be_fused(operation)) {
+    return false;
+  }
+  const Span<NodeOperationInput *> op_readers = readers.lookup(operation);
+  if (op_readers.size() != 1) {
+    return false;
+  }
+  const NodeOperation &reader = op_readers[0]->get_operation();
+  return can_be_fused(&reader) && BLI_rcti_compare(&operation->get_canvas(), &reader.get_canvas());
+}
+
+/**
+ * Adds operations fused into given operation in execution order, followed by the operation.
+ */
+static void collect_fused_operations(
+    NodeOperation *operation,
+    const MultiValueMap<NodeOperation *, NodeOperationInput *> &readers,
+    Vector<NodeOperation *> &r_operations)
+{
+  for (int i = 0; i < operation->get_number_of_input_sockets(); i++) {
+    NodeOperation *input_op = operation->get_input_operation(i);
+    if (is_fused_into_reader(input_op, readers)) {
+      collect_fused_operations(input_op, readers, r_operations);
+    }
+  }
+  r_operations.append(operation);
+}
+
+/**
+ * Replace chains of pixel-wise operations by a #FusedOperation, so that intermediate results
+ * are not written into full canvas buffers.
+ */
+void NodeOperationBuilder::fuse_operations()
+{
+  MultiValueMap<NodeOperation *, NodeOperationInput *> readers;
+  for (const Link &link : links_) {
+    readers.add(&link.from()->get_operation(), link.to());
+  }
+
+  Vector<Vector<NodeOperation *>> chains;
+  for (NodeOperation *op : operations_) {
+    if (can_be_fused(op) && !is_fused_into_reader(op, readers)) {
+      Vector<NodeOperation *> chain;
+      collect_fused_operations(op, readers, chain);
+      if (chain.size() > 1) {
+        chains.append(std::move(chain));
+      }
+    }
+  }
+
+  for (Span<NodeOperation *> chain : chains) {
+    Vector<NodeOperationOutput *> input_links;
+    FusedOperation *fused_op = new FusedOperation(chain, input_links);
+    add_operation(fused_op);
+    /* Profile the chain as part of the node of its output. */
+    fused_op->set_node_instance_key(chain.last()->get_node_instance_key());
+    for (int i = 0; i < input_links.size(); i++) {
+      add_link(input_links[i], fused_op->get_input_socket(i));
+    }
+
+    /* Readers of the last operation read the fused operation instead. Links of fused
+     * operations inputs are kept untouched. */
+    NodeOperationOutput *last_output = chain.last()->get_output_socket();
+    for (Link &link : links_) {
+      if (link.from() == last_output) {
+        link.to()->set_link(fused_op->get_output_socket());
+        link = Link(fused_op->get_output_socket(), link.to());
+      }
+    }
+
+    for (NodeOperation *op : chain) {
+      operations_.remove_first_occurrence_and_reorder(op);
+    }
+  }
+}
+
 Vector<NodeOperationInput *> NodeOperationBuilder::cache_output_links(
     NodeOperationOutput *output) const
 {
@@ -561,6 +657,7 @@ void NodeOperationBuilder::add_input_buffers(NodeOperation * /*operation*/,
     writeoperation = new WriteBufferOperation(output->get_data_type());
     writeoperation->set_bnodetree(context_->get_bnodetree());
     add_operation(writeoperation);
+    writeoperation->set_node_instance_key(output->get_operation().get_node_instance_key());
 
     add_link(output, writeoperation->get_input_socket(0));
 
@@ -604,6 +701,7 @@ void NodeOperationBuilder::add_output_buffers(NodeOperation *operation,
     write_operation = new WriteBufferOperation(operation->get_output_socket()->get_data_type());
     write_operation->set_bnodetree(context_->get_bnodetree());
     add_operation(write_operation);
+    write_operation->set_node_instance_key(operation->get_node_instance_key());
 
     add_link(output, write_operation->get_input_socket(0));
   }
@@ -0,0 +1,185 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_hash_mm2a.h"
+#include "BLI_task.hh"
+
+#include "MEM_CacheLimiterC-Api.h"
+
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+#include "COM_OperationResultCache.h"
+
+namespace blender::compositor {
+
+struct CachedResult {
+  OperationResultKey key;
+  std::unique_ptr<MemoryBuffer> buffer;
+  size_t size;
+  uint64_t last_used;
+};
+
+static struct {
+  Vector<CachedResult> results;
+  size_t size_total = 0;
+  uint64_t use_counter = 0;
+} g_result_cache;
+
+bool OperationResultKey::operator==(const OperationResultKey &other) const
+{
+  if (params_hash != other.params_hash || inputs_hashes != other.inputs_hashes ||
+      areas.size() != other.areas.size()) {
+    return false;
+  }
+  for (int i = 0; i < areas.size(); i++) {
+    if (!BLI_rcti_compare(&areas[i], &other.areas[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Hash buffer content within given area, which is the only part the operation reads. Rows are
+ * hashed in parallel, input buffers of expensive operations are often big.
+ */
+static uint32_t hash_buffer_area(MemoryBuffer &buffer, const rcti &area)
+{
+  rcti hashed_area;
+  if (buffer.is_a_single_elem()) {
+    BLI_rcti_init(&hashed_area, 0, 1, 0, 1);
+  }
+  else if (!BLI_rcti_isect(&area, &buffer.get_rect(), &hashed_area)) {
+    hashed_area = COM_AREA_NONE;
+  }
+
+  const int width = BLI_rcti_size_x(&hashed_area);
+  const int height = BLI_rcti_size_y(&hashed_area);
+  const size_t row_size = sizeof(float) * buffer.get_num_channels() * width;
+
+  Array<uint32_t> rows_hashes(height + 1);
+  threading::parallel_for(IndexRange(height), 64, [&](const IndexRange rows) {
+    for (const int64_t y : rows) {
+      const float *row = buffer.is_a_single_elem() ?
+                             buffer.get_buffer() :
+                             buffer.get_elem(hashed_area.xmin, hashed_area.ymin + y);
+      rows_hashes[y] = BLI_hash_mm2(
+          reinterpret_cast<const unsigned char *>(row), row_size, (uint32_t)y);
+    }
+  });
+  rows_hashes[height] = (uint32_t)get_default_hash_3(
+      get_default_hash_2(hashed_area.xmin, hashed_area.xmax),
+      get_default_hash_2(hashed_area.ymin, hashed_area.ymax),
+      get_default_hash_2(buffer.get_num_channels(), buffer.is_a_single_elem()));
+
+  return BLI_hash_mm2(reinterpret_cast<const unsigned char *>(rows_hashes.data()),
+                      sizeof(uint32_t) * rows_hashes.size(),
+                      0);
+}
+
+std::optional<OperationResultKey> OperationResultCache::get_key(NodeOperation *operation,
+                                                                Span<MemoryBuffer *> inputs,
+                                                                Span<rcti> areas)
+{
+  if (!operation->get_flags().can_cache_result || operation->get_number_of_output_sockets() == 0) {
+    return std::nullopt;
+  }
+  std::optional<NodeOperationHash> hash = operation->generate_hash();
+  if (!hash) {
+    return std::nullopt;
+  }
+
+  OperationResultKey key;
+  key.params_hash = hash->get_type_and_params_hash();
+  for (int i = 0; i < inputs.size(); i++) {
+    rcti input_area = COM_AREA_NONE;
+    for (const rcti &area : areas) {
+      rcti area_of_interest;
+      operation->get_area_of_interest(i, area, area_of_interest);
+      if (BLI_rcti_is_empty(&input_area)) {
+        input_area = area_of_interest;
+      }
+      else {
+        BLI_rcti_union(&input_area, &area_of_interest);
+      }
+    }
+    key.inputs_hashes.append(hash_buffer_area(*inputs[i], input_area));
+  }
+  key.areas.extend(areas);
+  return key;
+}
+
+bool OperationResultCache::read(const OperationResultKey &key, MemoryBuffer *r_output)
+{
+  for (CachedResult &result : g_result_cache.results) {
+    if (result.key == key) {
+      BLI_assert(BLI_rcti_compare(&result.buffer->get_rect(), &r_output->get_rect()));
+      r_output->copy_from(result.buffer.get(), r_output->get_rect());
+      result.last_used = ++g_result_cache.use_counter;
+      return true;
+    }
+  }
+  return false;
+}
+
+static void free_least_recently_used(const size_t size_needed)
+{
+  while (g_result_cache.results.size() > 0 &&
+         g_result_cache.size_total + size_needed > COM_RESULT_CACHE_MAX_SIZE) {
+    int oldest = 0;
+    for (int i = 1; i < g_result_cache.results.size(); i++) {
+      if (g_result_cache.results[i].last_used < g_result_cache.results[oldest].last_used) {
+        oldest = i;
+      }
+    }
+    g_result_cache.size_total -= g_result_cache.results[oldest].size;
+    MEM_CacheLimiter_external_memory_sub(g_result_cache.results[oldest].size);
+    g_result_cache.results.remove_and_reorder(oldest);
+  }
+}
+
+void OperationResultCache::add(OperationResultKey key, const MemoryBuffer &output)
+{
+  /* Cached copy is never a single element buffer. */
+  const size_t size = sizeof(float) * output.get_num_channels() * output.get_width() *
+                      output.get_height();
+  if (size > COM_RESULT_CACHE_MAX_SIZE) {
+    return;
+  }
+  free_least_recently_used(size);
+
+  CachedResult result;
+  result.key = std::move(key);
+  result.buffer = std::make_unique<MemoryBuffer>(output);
+  result.size = size;
+  result.last_used = ++g_result_cache.use_counter;
+  g_result_cache.results.append(std::move(result));
+  g_result_cache.size_total += size;
+  /* Counted in the shared cache limit, so image and sequencer caches make room for it. */
+  MEM_CacheLimiter_external_memory_add(size);
+}
+
+void OperationResultCache::clear()
+{
+  g_result_cache.results.clear();
+  MEM_CacheLimiter_external_memory_sub(g_result_cache.size_total);
+  g_result_cache.size_total = 0;
+}
+
+}  // namespace blender::compositor
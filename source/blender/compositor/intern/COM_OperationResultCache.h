@@ -0,0 +1,72 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <memory>
+#include <optional>
+
+#include "BLI_rect.h"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * Identifies an operation result by the operation type and parameters, the content of its input
+ * buffers and the rendered areas.
+ */
+struct OperationResultKey {
+  uint64_t params_hash;
+  Vector<uint32_t> inputs_hashes;
+  Vector<rcti> areas;
+
+  bool operator==(const OperationResultKey &other) const;
+};
+
+/**
+ * Keeps the output of expensive operations (flagged with NodeOperationFlags.can_cache_result)
+ * between compositor executions, so that editing nodes after them doesn't render them again.
+ * Operations downstream of a change get different input buffers, which invalidates their
+ * results implicitly. Least recently used results are freed when exceeding
+ * #COM_RESULT_CACHE_MAX_SIZE.
+ *
+ * Only accessed from #COM_execute, which is serialized by the compositor mutex.
+ */
+struct OperationResultCache {
+  /**
+   * Returns the key of the operation result, or nothing when the operation result can't be
+   * cached.
+   */
+  static std::optional<OperationResultKey> get_key(NodeOperation *operation,
+                                                   Span<MemoryBuffer *> inputs,
+                                                   Span<rcti> areas);
+
+  /** Copy the cached result into given buffer. Returns false when there is none. */
+  static bool read(const OperationResultKey &key, MemoryBuffer *r_output);
+
+  static void add(OperationResultKey key, const MemoryBuffer &output);
+
+  /** Free all cached results. */
+  static void clear();
+};
+
+}  // namespace blender::compositor
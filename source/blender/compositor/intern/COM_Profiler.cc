@@ -0,0 +1,193 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include "COM_Profiler.h"
+#include "COM_MemoryBuffer.h"
+#include "COM_NodeOperation.h"
+
+#include "BLI_listbase.h"
+#include "BLI_trace.h"
+
+#include "BKE_node.h"
+
+#include "DNA_scene_types.h"
+
+#include "PIL_time.h"
+
+namespace blender::compositor {
+
+static struct {
+  /** Statistics per node instance key, for each scene by session UUID. */
+  Map<uint32_t, Map<uint32_t, ExecutionStats>> scenes_stats;
+  ThreadMutex mutex = BLI_MUTEX_INITIALIZER;
+} g_profiles;
+
+void ExecutionStats::add(const ExecutionStats &other)
+{
+  wall_time += other.wall_time;
+  thread_time += other.thread_time;
+  area += other.area;
+  memory += other.memory;
+}
+
+static int64_t get_buffer_memory(const MemoryBuffer *buffer)
+{
+  if (buffer == nullptr) {
+    return 0;
+  }
+  return (int64_t)buffer->get_memory_width() * buffer->get_memory_height() *
+         buffer->get_elem_bytes_len();
+}
+
+Profiler::Profiler()
+    : current_operation_(nullptr), current_start_time_(0.0), current_work_time_(0.0)
+{
+  BLI_mutex_init(&mutex_);
+}
+
+Profiler::~Profiler()
+{
+  BLI_mutex_end(&mutex_);
+}
+
+void Profiler::operation_started(const NodeOperation *operation)
+{
+  current_operation_ = operation;
+  current_start_time_ = PIL_check_seconds_timer();
+  current_work_time_ = 0.0;
+  BLI_trace_event_begin("compositor", operation->get_name().c_str());
+}
+
+void Profiler::operation_finished(const NodeOperation *operation,
+                                  const MemoryBuffer *output,
+                                  Span<rcti> areas)
+{
+  BLI_assert(operation == current_operation_);
+  BLI_trace_event_end();
+  const double wall_time = PIL_check_seconds_timer() - current_start_time_;
+  ExecutionStats &stats = operations_stats_.lookup_or_add_default(operation);
+  stats.wall_time += wall_time;
+  /* Operations rendering without work packages run on the compositor thread only. */
+  stats.thread_time += current_work_time_ > 0.0 ? current_work_time_ : wall_time;
+  for (const rcti &area : areas) {
+    stats.area += (int64_t)BLI_rcti_size_x(&area) * BLI_rcti_size_y(&area);
+  }
+  stats.memory += get_buffer_memory(output);
+  current_operation_ = nullptr;
+}
+
+void Profiler::add_work_time(const double time)
+{
+  BLI_mutex_lock(&mutex_);
+  current_work_time_ += time;
+  BLI_mutex_unlock(&mutex_);
+}
+
+void Profiler::chunk_executed(const NodeOperation *operation,
+                              const rcti &rect,
+                              const double start_time,
+                              const double end_time)
+{
+  BLI_mutex_lock(&mutex_);
+  ExecutionStats &stats = operations_stats_.lookup_or_add_default(operation);
+  stats.thread_time += end_time - start_time;
+  stats.area += (int64_t)BLI_rcti_size_x(&rect) * BLI_rcti_size_y(&rect);
+
+  std::pair<double, double> &time_range = chunks_time_range_.lookup_or_add(
+      operation, std::make_pair(start_time, end_time));
+  time_range.first = MIN2(time_range.first, start_time);
+  time_range.second = MAX2(time_range.second, end_time);
+  stats.wall_time = time_range.second - time_range.first;
+  BLI_mutex_unlock(&mutex_);
+}
+
+void Profiler::buffer_allocated(const NodeOperation *operation, const MemoryBuffer *buffer)
+{
+  const int64_t memory = get_buffer_memory(buffer);
+  if (memory > 0) {
+    operations_stats_.lookup_or_add_default(operation).memory += memory;
+  }
+}
+
+static ExecutionStats sum_group_stats(Map<uint32_t, ExecutionStats> &nodes_stats,
+                                      const bNodeTree *node_tree,
+                                      const bNodeInstanceKey parent_key)
+{
+  ExecutionStats group_stats;
+  LISTBASE_FOREACH (const bNode *, node, &node_tree->nodes) {
+    const bNodeInstanceKey key = BKE_node_instance_key(parent_key, node_tree, node);
+    if (node->type == NODE_GROUP && node->id) {
+      const ExecutionStats stats = sum_group_stats(
+          nodes_stats, (const bNodeTree *)node->id, key);
+      if (stats.wall_time > 0.0) {
+        nodes_stats.add_overwrite(key.value, stats);
+      }
+    }
+
+    const ExecutionStats *stats = nodes_stats.lookup_ptr(key.value);
+    if (stats) {
+      group_stats.add(*stats);
+    }
+  }
+  return group_stats;
+}
+
+void Profiler::finish(const Scene *scene, const bNodeTree *node_tree)
+{
+  Map<uint32_t, ExecutionStats> nodes_stats;
+  for (const auto item : operations_stats_.items()) {
+    const bNodeInstanceKey key = item.key->get_node_instance_key();
+    if (key.value != NODE_INSTANCE_KEY_NONE.value) {
+      nodes_stats.lookup_or_add_default(key.value).add(item.value);
+    }
+  }
+  sum_group_stats(nodes_stats, node_tree, NODE_INSTANCE_KEY_BASE);
+
+  /* Copy-on-write scenes of renders share the session UUID of the original scene. */
+  BLI_mutex_lock(&g_profiles.mutex);
+  g_profiles.scenes_stats.add_overwrite(scene->id.session_uuid, std::move(nodes_stats));
+  BLI_mutex_unlock(&g_profiles.mutex);
+}
+
+bool Profiler::get_node_stats(const Scene *scene,
+                              const bNodeInstanceKey key,
+                              ExecutionStats &r_stats)
+{
+  bool found = false;
+  BLI_mutex_lock(&g_profiles.mutex);
+  const Map<uint32_t, ExecutionStats> *nodes_stats = g_profiles.scenes_stats.lookup_ptr(
+      scene->id.session_uuid);
+  if (nodes_stats) {
+    const ExecutionStats *stats = nodes_stats->lookup_ptr(key.value);
+    if (stats) {
+      r_stats = *stats;
+      found = true;
+    }
+  }
+  BLI_mutex_unlock(&g_profiles.mutex);
+  return found;
+}
+
+void Profiler::clear()
+{
+  BLI_mutex_lock(&g_profiles.mutex);
+  g_profiles.scenes_stats.clear();
+  BLI_mutex_unlock(&g_profiles.mutex);
+}
+
+}  // namespace blender::compositor
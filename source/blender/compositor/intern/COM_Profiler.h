@@ -0,0 +1,110 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include <utility>
+
+#include "BLI_map.hh"
+#include "BLI_rect.h"
+#include "BLI_span.hh"
+#include "BLI_threads.h"
+
+#include "DNA_node_types.h"
+
+struct Scene;
+
+namespace blender::compositor {
+
+class MemoryBuffer;
+class NodeOperation;
+
+/**
+ * Execution statistics of an operation, or of a node summing the statistics of its operations.
+ */
+struct ExecutionStats {
+  /** Time from the start to the end of the execution, in seconds. */
+  double wall_time = 0.0;
+  /** Time summed over the compositor threads, in seconds. */
+  double thread_time = 0.0;
+  /** Number of rendered pixels. */
+  int64_t area = 0;
+  /** Bytes allocated for the output buffers. */
+  int64_t memory = 0;
+
+  void add(const ExecutionStats &other);
+};
+
+/**
+ * Measures the execution of the operations of an #ExecutionSystem and sums the results per node,
+ * to find out which nodes make a tree slow. The statistics of the last execution of each scene
+ * are kept for the node editor and Python.
+ *
+ * In the tiled execution model operations are executed per chunk by their execution group, the
+ * statistics of a group go to the node of its output operation.
+ */
+class Profiler {
+ private:
+  Map<const NodeOperation *, ExecutionStats> operations_stats_;
+
+  /** Operation rendered by the full frame execution model. */
+  const NodeOperation *current_operation_;
+  double current_start_time_;
+  double current_work_time_;
+
+  /** First chunk start and last chunk end of the operations in the tiled execution model. */
+  Map<const NodeOperation *, std::pair<double, double>> chunks_time_range_;
+
+  ThreadMutex mutex_;
+
+ public:
+  Profiler();
+  ~Profiler();
+
+  /* Full frame execution model. */
+  void operation_started(const NodeOperation *operation);
+  void operation_finished(const NodeOperation *operation,
+                          const MemoryBuffer *output,
+                          Span<rcti> areas);
+  /** Add the time a thread spent on a work package of the operation being rendered. */
+  void add_work_time(double time);
+
+  /* Tiled execution model. */
+  void chunk_executed(const NodeOperation *operation,
+                      const rcti &rect,
+                      double start_time,
+                      double end_time);
+  void buffer_allocated(const NodeOperation *operation, const MemoryBuffer *buffer);
+
+  /**
+   * Sum the statistics per node, group nodes summing the nodes inside of them, and keep them as
+   * the last execution of the scene.
+   */
+  void finish(const Scene *scene, const bNodeTree *node_tree);
+
+  /**
+   * Get the statistics of the last execution of a node of the scene compositing tree. Returns
+   * false when the node wasn't executed.
+   */
+  static bool get_node_stats(const Scene *scene, bNodeInstanceKey key, ExecutionStats &r_stats);
+
+  /** Free the statistics of all scenes. */
+  static void clear();
+};
+
+}  // namespace blender::compositor
@@ -19,8 +19,10 @@
 #include "COM_TiledExecutionModel.h"
 #include "COM_Debug.h"
 #include "COM_ExecutionGroup.h"
+#include "COM_ExecutionSystem.h"
 #include "COM_ReadBufferOperation.h"
 #include "COM_WorkScheduler.h"
+#include "COM_WriteBufferOperation.h"
 
 #include "BLT_translation.h"
 
@@ -133,6 +135,14 @@ void TiledExecutionModel::execute(ExecutionSystem &exec_system)
   WorkScheduler::finish();
   WorkScheduler::stop();
 
+  for (NodeOperation *operation : operations_) {
+    if (operation->get_flags().is_write_buffer_operation) {
+      WriteBufferOperation *write_operation = static_cast<WriteBufferOperation *>(operation);
+      exec_system.get_profiler().buffer_allocated(
+          operation, write_operation->get_memory_proxy()->get_buffer());
+    }
+  }
+
   editingtree->stats_draw(editingtree->sdh, TIP_("Compositing | De-initializing execution"));
 
   for (NodeOperation *operation : operations_) {
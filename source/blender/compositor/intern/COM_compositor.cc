@@ -23,7 +23,10 @@
 #include "BKE_node.h"
 #include "BKE_scene.h"
 
+#include "COM_DenoiseOperation.h"
 #include "COM_ExecutionSystem.h"
+#include "COM_OperationResultCache.h"
+#include "COM_Profiler.h"
 #include "COM_WorkScheduler.h"
 #include "COM_compositor.h"
 
@@ -123,8 +126,26 @@ void COM_deinitialize()
   if (g_compositor.is_initialized) {
     BLI_mutex_lock(&g_compositor.mutex);
     blender::compositor::WorkScheduler::deinitialize();
+    blender::compositor::OperationResultCache::clear();
+    blender::compositor::Profiler::clear();
+    blender::compositor::COM_denoise_free_cache();
     g_compositor.is_initialized = false;
     BLI_mutex_unlock(&g_compositor.mutex);
     BLI_mutex_end(&g_compositor.mutex);
   }
 }
+
+bool COM_node_execution_stats_get(const Scene *scene,
+                                  bNodeInstanceKey key,
+                                  COM_NodeExecutionStats *r_stats)
+{
+  blender::compositor::ExecutionStats stats;
+  if (!blender::compositor::Profiler::get_node_stats(scene, key, stats)) {
+    return false;
+  }
+  r_stats->wall_time = stats.wall_time;
+  r_stats->thread_time = stats.thread_time;
+  r_stats->area = stats.area;
+  r_stats->memory = stats.memory;
+  return true;
+}
@@ -18,6 +18,7 @@
 
 #include "COM_BokehBlurOperation.h"
 #include "COM_ConstantOperation.h"
+#include "COM_FFTConvolution.h"
 
 #include "COM_OpenCLDevice.h"
 
@@ -28,6 +29,9 @@ constexpr int BOKEH_INPUT_INDEX = 1;
 constexpr int BOUNDING_BOX_INPUT_INDEX = 2;
 constexpr int SIZE_INPUT_INDEX = 3;
 
+/* Blur radius from which an FFT convolution is faster than gathering the pixels. */
+constexpr int FFT_MIN_PIXEL_SIZE = 16;
+
 BokehBlurOperation::BokehBlurOperation()
 {
   this->add_input_socket(DataType::Color);
@@ -46,6 +50,7 @@ BokehBlurOperation::BokehBlurOperation()
   input_bounding_box_reader_ = nullptr;
 
   extend_bounds_ = false;
+  fft_radius_ = 0;
 }
 
 void BokehBlurOperation::init_data()
@@ -321,10 +326,96 @@ void BokehBlurOperation::get_area_of_interest(const int input_idx,
   }
 }
 
+void BokehBlurOperation::update_memory_buffer_started(MemoryBuffer *output,
+                                                      const rcti &area,
+                                                      Span<MemoryBuffer *> inputs)
+{
+  const float max_dim = MAX2(this->get_width(), this->get_height());
+  const int pixel_size = size_ * max_dim / 100.0f;
+  /* Lower qualities skip pixels, which the convolution can't do. */
+  fft_radius_ = (pixel_size >= FFT_MIN_PIXEL_SIZE && get_step() == 1) ? pixel_size : 0;
+  if (fft_radius_ == 0) {
+    return;
+  }
+
+  /* Kernel elements weight the pixels at an offset of `pixel_size - index`, sampling the bokeh
+   * like #update_memory_buffer_partial does for offsets in `[-pixel_size, pixel_size)`. */
+  const MemoryBuffer *bokeh_input = inputs[BOKEH_INPUT_INDEX];
+  const float m = bokehDimension_ / pixel_size;
+  const int kernel_size = 2 * pixel_size + 1;
+  rcti kernel_rect;
+  BLI_rcti_init(&kernel_rect, 0, kernel_size, 0, kernel_size);
+  MemoryBuffer kernel(DataType::Color, kernel_rect);
+  kernel.clear();
+  for (int y = 1; y < kernel_size; y++) {
+    const float v = bokeh_mid_y_ - (pixel_size - y) * m;
+    for (int x = 1; x < kernel_size; x++) {
+      const float u = bokeh_mid_x_ - (pixel_size - x) * m;
+      bokeh_input->read_elem_checked(u, v, kernel.get_elem(x, y));
+    }
+  }
+
+  const int sums_row_len = (kernel_size + 1) * COM_DATA_TYPE_COLOR_CHANNELS;
+  kernel_sums_.reinitialize(sums_row_len * (kernel_size + 1));
+  kernel_sums_.fill(0.0);
+  for (int y = 0; y < kernel_size; y++) {
+    for (int x = 0; x < kernel_size; x++) {
+      const float *weight = kernel.get_elem(x, y);
+      double *sum = &kernel_sums_[(y + 1) * sums_row_len + (x + 1) * COM_DATA_TYPE_COLOR_CHANNELS];
+      for (int ch = 0; ch < COM_DATA_TYPE_COLOR_CHANNELS; ch++) {
+        sum[ch] = weight[ch] + sum[ch - sums_row_len] + sum[ch - COM_DATA_TYPE_COLOR_CHANNELS] -
+                  sum[ch - sums_row_len - COM_DATA_TYPE_COLOR_CHANNELS];
+      }
+    }
+  }
+
+  convolve_fft(*inputs[IMAGE_INPUT_INDEX], kernel, COM_DATA_TYPE_COLOR_CHANNELS, *output, area);
+}
+
+void BokehBlurOperation::normalize_fft_convolution(MemoryBuffer *output,
+                                                   const rcti &area,
+                                                   Span<MemoryBuffer *> inputs)
+{
+  const int kernel_size = 2 * fft_radius_ + 1;
+  const int sums_row_len = (kernel_size + 1) * COM_DATA_TYPE_COLOR_CHANNELS;
+  const MemoryBuffer *image_input = inputs[IMAGE_INPUT_INDEX];
+  MemoryBuffer *bounding_input = inputs[BOUNDING_BOX_INPUT_INDEX];
+  const rcti &image_rect = image_input->get_rect();
+  auto get_kernel_sum = [&](const int x, const int y) {
+    return &kernel_sums_[y * sums_row_len + x * COM_DATA_TYPE_COLOR_CHANNELS];
+  };
+  for (BuffersIterator<float> it = output->iterate_with({bounding_input}, area); !it.is_end();
+       ++it) {
+    if (*it.in(0) <= 0.0f) {
+      image_input->read_elem(it.x, it.y, it.out);
+      continue;
+    }
+
+    /* Divide by the sum of the kernel elements that weighted pixels inside of the image. */
+    const int xmin = clamp_i(it.x + fft_radius_ + 1 - image_rect.xmax, 0, kernel_size);
+    const int xmax = clamp_i(it.x + fft_radius_ + 1 - image_rect.xmin, 0, kernel_size);
+    const int ymin = clamp_i(it.y + fft_radius_ + 1 - image_rect.ymax, 0, kernel_size);
+    const int ymax = clamp_i(it.y + fft_radius_ + 1 - image_rect.ymin, 0, kernel_size);
+    const double *sum_min_min = get_kernel_sum(xmin, ymin);
+    const double *sum_min_max = get_kernel_sum(xmax, ymin);
+    const double *sum_max_min = get_kernel_sum(xmin, ymax);
+    const double *sum_max_max = get_kernel_sum(xmax, ymax);
+    for (int ch = 0; ch < COM_DATA_TYPE_COLOR_CHANNELS; ch++) {
+      const float weight = sum_max_max[ch] - sum_min_max[ch] - sum_max_min[ch] + sum_min_min[ch];
+      it.out[ch] *= 1.0f / weight;
+    }
+  }
+}
+
 void BokehBlurOperation::update_memory_buffer_partial(MemoryBuffer *output,
                                                       const rcti &area,
                                                       Span<MemoryBuffer *> inputs)
 {
+  if (fft_radius_ > 0) {
+    normalize_fft_convolution(output, area, inputs);
+    return;
+  }
+
   const float max_dim = MAX2(this->get_width(), this->get_height());
   const int pixel_size = size_ * max_dim / 100.0f;
   const float m = bokehDimension_ / pixel_size;
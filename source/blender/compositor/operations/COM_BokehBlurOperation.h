@@ -18,6 +18,8 @@
 
 #pragma once
 
+#include "BLI_array.hh"
+
 #include "COM_MultiThreadedOperation.h"
 #include "COM_QualityStepHelper.h"
 
@@ -37,6 +39,15 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   float bokehDimension_;
   bool extend_bounds_;
 
+  /* Radius of the blur when it is done by FFT convolution, zero otherwise. */
+  int fft_radius_;
+  /* Summed area table of the FFT convolution kernel, for normalizing the result. */
+  Array<double> kernel_sums_;
+
+  void normalize_fft_convolution(MemoryBuffer *output,
+                                 const rcti &area,
+                                 Span<MemoryBuffer *> inputs);
+
  public:
   BokehBlurOperation();
 
@@ -83,6 +94,9 @@ class BokehBlurOperation : public MultiThreadedOperation, public QualityStepHelp
   void determine_canvas(const rcti &preferred_area, rcti &r_area) override;
 
   void get_area_of_interest(int input_idx, const rcti &output_area, rcti &r_input_area) override;
+  void update_memory_buffer_started(MemoryBuffer *output,
+                                    const rcti &area,
+                                    Span<MemoryBuffer *> inputs) override;
   void update_memory_buffer_partial(MemoryBuffer *output,
                                     const rcti &area,
                                     Span<MemoryBuffer *> inputs) override;
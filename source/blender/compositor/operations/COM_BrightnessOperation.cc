@@ -29,6 +29,7 @@ BrightnessOperation::BrightnessOperation()
   input_program_ = nullptr;
   use_premultiply_ = false;
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 
 void BrightnessOperation::set_use_premultiply(bool use_premultiply)
@@ -36,6 +36,7 @@ ColorCurveOperation::ColorCurveOperation()
   input_white_program_ = nullptr;
 
   this->set_canvas_input_index(1);
+  flags_.can_be_fused = true;
 }
 void ColorCurveOperation::init_execution()
 {
@@ -138,6 +139,7 @@ ConstantLevelColorCurveOperation::ConstantLevelColorCurveOperation()
   input_image_program_ = nullptr;
 
   this->set_canvas_input_index(1);
+  flags_.can_be_fused = true;
 }
 void ConstantLevelColorCurveOperation::init_execution()
 {
@@ -30,6 +30,7 @@ ColorRampOperation::ColorRampOperation()
   input_program_ = nullptr;
   color_band_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 void ColorRampOperation::init_execution()
 {
@@ -28,6 +28,7 @@ ConvertBaseOperation::ConvertBaseOperation()
 {
   input_operation_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 
 void ConvertBaseOperation::init_execution()
@@ -20,6 +20,7 @@
 #include "BLI_system.h"
 #ifdef WITH_OPENIMAGEDENOISE
 #  include "BLI_threads.h"
+#  include "BLI_vector.hh"
 #  include <OpenImageDenoise/oidn.hpp>
 static pthread_mutex_t oidn_lock = BLI_MUTEX_INITIALIZER;
 #endif
@@ -41,10 +42,62 @@ bool COM_is_denoise_supported()
 #endif
 }
 
+#ifdef WITH_OPENIMAGEDENOISE
+/**
+ * OpenImageDenoise device and filters kept between executions, guarded by #oidn_lock. Creating
+ * them is expensive (thread pool, network weights and scratch memory), filters are reused when
+ * denoising the same kind of images with the same size again, like the frames of an animation.
+ */
+static struct {
+  oidn::DeviceRef device;
+  struct CachedFilter {
+    std::string id;
+    int width;
+    int height;
+    oidn::FilterRef filter;
+  };
+  blender::Vector<CachedFilter> filters;
+} g_denoisers;
+
+static oidn::FilterRef get_cached_filter(const StringRef id, const int width, const int height)
+{
+  if (!g_denoisers.device) {
+    g_denoisers.device = oidn::newDevice();
+    g_denoisers.device.commit();
+  }
+
+  for (auto &cached : g_denoisers.filters) {
+    if (cached.id == id && cached.width == width && cached.height == height) {
+      return cached.filter;
+    }
+  }
+
+  /* Scratch memory of filters grows with the image size, only keep filters of one size. */
+  for (int i = g_denoisers.filters.size() - 1; i >= 0; i--) {
+    const auto &cached = g_denoisers.filters[i];
+    if (cached.width != width || cached.height != height) {
+      g_denoisers.filters.remove_and_reorder(i);
+    }
+  }
+  oidn::FilterRef filter = g_denoisers.device.newFilter("RT");
+  g_denoisers.filters.append({id, width, height, filter});
+  return filter;
+}
+#endif
+
+void COM_denoise_free_cache()
+{
+#ifdef WITH_OPENIMAGEDENOISE
+  BLI_mutex_lock(&oidn_lock);
+  g_denoisers.filters.clear();
+  g_denoisers.device = nullptr;
+  BLI_mutex_unlock(&oidn_lock);
+#endif
+}
+
 class DenoiseFilter {
  private:
 #ifdef WITH_OPENIMAGEDENOISE
-  oidn::DeviceRef device;
   oidn::FilterRef filter;
 #endif
   bool initialized_ = false;
@@ -56,22 +109,24 @@ class DenoiseFilter {
   }
 
 #ifdef WITH_OPENIMAGEDENOISE
-  void init_and_lock_denoiser(MemoryBuffer *output)
+  /**
+   * \param filter_id: Identifies the images set to the filter, for reusing a cached filter.
+   */
+  void init_and_lock_denoiser(MemoryBuffer *output, const StringRef filter_id)
   {
     /* Since it's memory intensive, it's better to run only one instance of OIDN at a time.
      * OpenImageDenoise is multithreaded internally and should use all available cores
      * nonetheless. */
     BLI_mutex_lock(&oidn_lock);
 
-    device = oidn::newDevice();
-    device.commit();
-    filter = device.newFilter("RT");
+    filter = get_cached_filter(filter_id, output->get_width(), output->get_height());
     initialized_ = true;
     set_image("output", output);
   }
 
   void deinit_and_unlock_denoiser()
   {
+    filter = nullptr;
     BLI_mutex_unlock(&oidn_lock);
     initialized_ = false;
   }
@@ -103,7 +158,7 @@ class DenoiseFilter {
   }
 
 #else
-  void init_and_lock_denoiser(MemoryBuffer *UNUSED(output))
+  void init_and_lock_denoiser(MemoryBuffer *UNUSED(output), const StringRef UNUSED(filter_id))
   {
   }
 
@@ -160,6 +215,7 @@ DenoiseOperation::DenoiseOperation()
   this->add_input_socket(DataType::Color);
   this->add_output_socket(DataType::Color);
   settings_ = nullptr;
+  flags_.can_cache_result = true;
 }
 void DenoiseOperation::init_execution()
 {
@@ -233,7 +289,7 @@ void DenoiseOperation::generate_denoise(MemoryBuffer *output,
                                  input_albedo;
 
   DenoiseFilter filter;
-  filter.init_and_lock_denoiser(output);
+  filter.init_and_lock_denoiser(output, "denoise");
 
   filter.set_image("color", buf_color);
   filter.set_image("normal", buf_normal);
@@ -279,6 +335,7 @@ DenoisePrefilterOperation::DenoisePrefilterOperation(DataType data_type)
   this->add_input_socket(data_type);
   this->add_output_socket(data_type);
   image_name_ = "";
+  flags_.can_cache_result = true;
 }
 
 void DenoisePrefilterOperation::hash_output_params()
@@ -306,7 +363,7 @@ void DenoisePrefilterOperation::generate_denoise(MemoryBuffer *output, MemoryBuf
   MemoryBuffer *input_buf = input->is_a_single_elem() ? input->inflate() : input;
 
   DenoiseFilter filter;
-  filter.init_and_lock_denoiser(output);
+  filter.init_and_lock_denoiser(output, image_name_);
   filter.set_image(image_name_, input_buf);
   filter.execute();
   filter.deinit_and_unlock_denoiser();
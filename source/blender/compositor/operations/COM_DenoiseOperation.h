@@ -24,6 +24,8 @@
 namespace blender::compositor {
 
 bool COM_is_denoise_supported();
+/** Free the denoising device and filters kept between executions. */
+void COM_denoise_free_cache();
 
 class DenoiseBaseOperation : public SingleThreadedOperation {
  protected:
@@ -0,0 +1,564 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#include <algorithm>
+
+#ifdef WITH_FFTW3
+#  include "fftw3.h"
+#endif
+
+#include "BLI_task.hh"
+#include "BLI_threads.h"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+#include "MEM_guardedalloc.h"
+
+#include "COM_FFTConvolution.h"
+
+namespace blender::compositor {
+
+#ifdef WITH_FFTW3
+
+using fREAL = double;
+
+/* FFTW is fastest for sizes made of small prime factors. */
+static int fft_size(int size)
+{
+  for (;; size++) {
+    int remainder = size;
+    for (const int factor : {2, 3, 5, 7}) {
+      while (remainder % factor == 0) {
+        remainder /= factor;
+      }
+    }
+    if (remainder == 1) {
+      return size;
+    }
+  }
+}
+
+/**
+ * Convolves blocks of one size with the channels of a kernel, using real to complex FFTW
+ * transforms. Plans are created once and executed on the buffers of each thread.
+ */
+class BlockConvolver : NonCopyable, NonMovable {
+ private:
+  int width_;
+  int height_;
+  int spectrum_len_;
+  fftw_plan forward_plan_;
+  fftw_plan inverse_plan_;
+  Vector<fftw_complex *> kernel_spectra_;
+
+ public:
+  /** Buffers of a thread, #data holds the block to convolve and then the result. */
+  struct Buffers : NonCopyable, NonMovable {
+    fREAL *data;
+    fftw_complex *spectrum;
+
+    Buffers(const BlockConvolver &convolver)
+    {
+      /* Allocated by FFTW, for the alignment to match the arrays the plans were made with. */
+      data = static_cast<fREAL *>(
+          fftw_malloc(sizeof(fREAL) * convolver.width_ * convolver.height_));
+      spectrum = static_cast<fftw_complex *>(
+          fftw_malloc(sizeof(fftw_complex) * convolver.spectrum_len_));
+      memset(data, 0, sizeof(fREAL) * convolver.width_ * convolver.height_);
+    }
+
+    ~Buffers()
+    {
+      fftw_free(data);
+      fftw_free(spectrum);
+    }
+  };
+
+  BlockConvolver(const int width, const int height, const int num_channels)
+      : width_(width), height_(height), spectrum_len_(height * (width / 2 + 1))
+  {
+    kernel_spectra_.resize(num_channels, nullptr);
+    Buffers buffers(*this);
+    /* The planner isn't thread-safe. */
+    BLI_thread_lock(LOCK_FFTW);
+    forward_plan_ = fftw_plan_dft_r2c_2d(
+        height, width, buffers.data, buffers.spectrum, FFTW_ESTIMATE);
+    inverse_plan_ = fftw_plan_dft_c2r_2d(
+        height, width, buffers.spectrum, buffers.data, FFTW_ESTIMATE);
+    BLI_thread_unlock(LOCK_FFTW);
+  }
+
+  ~BlockConvolver()
+  {
+    for (fftw_complex *spectrum : kernel_spectra_) {
+      fftw_free(spectrum);
+    }
+    BLI_thread_lock(LOCK_FFTW);
+    fftw_destroy_plan(forward_plan_);
+    fftw_destroy_plan(inverse_plan_);
+    BLI_thread_unlock(LOCK_FFTW);
+  }
+
+  /** Transform the kernel channel in the buffers data, \a num_rows being its height. */
+  void set_kernel(const int channel, Buffers &buffers, const int UNUSED(num_rows))
+  {
+    fftw_complex *spectrum = static_cast<fftw_complex *>(
+        fftw_malloc(sizeof(fftw_complex) * spectrum_len_));
+    fftw_execute_dft_r2c(forward_plan_, buffers.data, spectrum);
+    kernel_spectra_[channel] = spectrum;
+  }
+
+  /** Convolve the block in the buffers data, which has \a num_rows rows that aren't zero. */
+  void convolve(const int channel, Buffers &buffers, const int UNUSED(num_rows)) const
+  {
+    fftw_execute_dft_r2c(forward_plan_, buffers.data, buffers.spectrum);
+    const fftw_complex *kernel_spectrum = kernel_spectra_[channel];
+    /* Transforms aren't normalized. */
+    const fREAL scale = 1.0 / ((fREAL)width_ * height_);
+    for (int i = 0; i < spectrum_len_; i++) {
+      const fREAL re = buffers.spectrum[i][0] * kernel_spectrum[i][0] -
+                       buffers.spectrum[i][1] * kernel_spectrum[i][1];
+      const fREAL im = buffers.spectrum[i][0] * kernel_spectrum[i][1] +
+                       buffers.spectrum[i][1] * kernel_spectrum[i][0];
+      buffers.spectrum[i][0] = re * scale;
+      buffers.spectrum[i][1] = im * scale;
+    }
+    fftw_execute_dft_c2r(inverse_plan_, buffers.spectrum, buffers.data);
+  }
+};
+
+#else /* WITH_FFTW3 */
+
+/*
+ *  2D Fast Hartley Transform, used for convolution
+ */
+
+using fREAL = float;
+
+/* Returns next highest power of 2 of x, as well its log2 in L2. */
+static unsigned int next_pow2(unsigned int x, unsigned int *L2)
+{
+  unsigned int pw, x_notpow2 = x & (x - 1);
+  *L2 = 0;
+  while (x >>= 1) {
+    ++(*L2);
+  }
+  pw = 1 << (*L2);
+  if (x_notpow2) {
+    (*L2)++;
+    pw <<= 1;
+  }
+  return pw;
+}
+
+//------------------------------------------------------------------------------
+
+/* From FXT library by Joerg Arndt, faster in order bit-reversal
+ * use: `r = revbin_upd(r, h)` where `h = N>>1`. */
+static unsigned int revbin_upd(unsigned int r, unsigned int h)
+{
+  while (!((r ^= h) & h)) {
+    h >>= 1;
+  }
+  return r;
+}
+//------------------------------------------------------------------------------
+static void FHT(fREAL *data, unsigned int M, unsigned int inverse)
+{
+  double tt, fc, dc, fs, ds, a = M_PI;
+  fREAL t1, t2;
+  int n2, bd, bl, istep, k, len = 1 << M, n = 1;
+
+  int i, j = 0;
+  unsigned int Nh = len >> 1;
+  for (i = 1; i < (len - 1); i++) {
+    j = revbin_upd(j, Nh);
+    if (j > i) {
+      t1 = data[i];
+      data[i] = data[j];
+      data[j] = t1;
+    }
+  }
+
+  do {
+    fREAL *data_n = &data[n];
+
+    istep = n << 1;
+    for (k = 0; k < len; k += istep) {
+      t1 = data_n[k];
+      data_n[k] = data[k] - t1;
+      data[k] += t1;
+    }
+
+    n2 = n >> 1;
+    if (n > 2) {
+      fc = dc = cos(a);
+      fs = ds = sqrt(1.0 - fc * fc);  // sin(a);
+      bd = n - 2;
+      for (bl = 1; bl < n2; bl++) {
+        fREAL *data_nbd = &data_n[bd];
+        fREAL *data_bd = &data[bd];
+        for (k = bl; k < len; k += istep) {
+          t1 = fc * (double)data_n[k] + fs * (double)data_nbd[k];
+          t2 = fs * (double)data_n[k] - fc * (double)data_nbd[k];
+          data_n[k] = data[k] - t1;
+          data_nbd[k] = data_bd[k] - t2;
+          data[k] += t1;
+          data_bd[k] += t2;
+        }
+        tt = fc * dc - fs * ds;
+        fs = fs * dc + fc * ds;
+        fc = tt;
+        bd -= 2;
+      }
+    }
+
+    if (n > 1) {
+      for (k = n2; k < len; k += istep) {
+        t1 = data_n[k];
+        data_n[k] = data[k] - t1;
+        data[k] += t1;
+      }
+    }
+
+    n = istep;
+    a *= 0.5;
+  } while (n < len);
+
+  if (inverse) {
+    fREAL sc = (fREAL)1 / (fREAL)len;
+    for (k = 0; k < len; k++) {
+      data[k] *= sc;
+    }
+  }
+}
+//------------------------------------------------------------------------------
+/* 2D Fast Hartley Transform, Mx/My -> log2 of width/height,
+ * nzp -> the row where zero pad data starts,
+ * inverse -> see above. */
+static void FHT2D(
+    fREAL *data, unsigned int Mx, unsigned int My, unsigned int nzp, unsigned int inverse)
+{
+  unsigned int i, j, Nx, Ny, maxy;
+
+  Nx = 1 << Mx;
+  Ny = 1 << My;
+
+  /* Rows (forward transform skips 0 pad data). */
+  maxy = inverse ? Ny : nzp;
+  for (j = 0; j < maxy; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Transpose data. */
+  if (Nx == Ny) { /* Square. */
+    for (j = 0; j < Ny; j++) {
+      for (i = j + 1; i < Nx; i++) {
+        unsigned int op = i + (j << Mx), np = j + (i << My);
+        SWAP(fREAL, data[op], data[np]);
+      }
+    }
+  }
+  else { /* Rectangular. */
+    unsigned int k, Nym = Ny - 1, stm = 1 << (Mx + My);
+    for (i = 0; stm > 0; i++) {
+#define PRED(k) (((k & Nym) << Mx) + (k >> My))
+      for (j = PRED(i); j > i; j = PRED(j)) {
+        /* Pass. */
+      }
+      if (j < i) {
+        continue;
+      }
+      for (k = i, j = PRED(i); j != i; k = j, j = PRED(j), stm--) {
+        SWAP(fREAL, data[j], data[k]);
+      }
+#undef PRED
+      stm--;
+    }
+  }
+
+  SWAP(unsigned int, Nx, Ny);
+  SWAP(unsigned int, Mx, My);
+
+  /* Now columns == transposed rows. */
+  for (j = 0; j < Ny; j++) {
+    FHT(&data[Nx * j], Mx, inverse);
+  }
+
+  /* Finalize. */
+  for (j = 0; j <= (Ny >> 1); j++) {
+    unsigned int jm = (Ny - j) & (Ny - 1);
+    unsigned int ji = j << Mx;
+    unsigned int jmi = jm << Mx;
+    for (i = 0; i <= (Nx >> 1); i++) {
+      unsigned int im = (Nx - i) & (Nx - 1);
+      fREAL A = data[ji + i];
+      fREAL B = data[jmi + i];
+      fREAL C = data[ji + im];
+      fREAL D = data[jmi + im];
+      fREAL E = (fREAL)0.5 * ((A + D) - (B + C));
+      data[ji + i] = A - E;
+      data[jmi + i] = B + E;
+      data[ji + im] = C + E;
+      data[jmi + im] = D - E;
+    }
+  }
+}
+
+//------------------------------------------------------------------------------
+
+/* 2D convolution calc, d1 *= d2, M/N - > log2 of width/height. */
+static void fht_convolve(fREAL *d1, const fREAL *d2, unsigned int M, unsigned int N)
+{
+  fREAL a, b;
+  unsigned int i, j, k, L, mj, mL;
+  unsigned int m = 1 << M, n = 1 << N;
+  unsigned int m2 = 1 << (M - 1), n2 = 1 << (N - 1);
+  unsigned int mn2 = m << (N - 1);
+
+  d1[0] *= d2[0];
+  d1[mn2] *= d2[mn2];
+  d1[m2] *= d2[m2];
+  d1[m2 + mn2] *= d2[m2 + mn2];
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    a = d1[i] * d2[i] - d1[k] * d2[k];
+    b = d1[k] * d2[i] + d1[i] * d2[k];
+    d1[i] = (b + a) * (fREAL)0.5;
+    d1[k] = (b - a) * (fREAL)0.5;
+    a = d1[i + mn2] * d2[i + mn2] - d1[k + mn2] * d2[k + mn2];
+    b = d1[k + mn2] * d2[i + mn2] + d1[i + mn2] * d2[k + mn2];
+    d1[i + mn2] = (b + a) * (fREAL)0.5;
+    d1[k + mn2] = (b - a) * (fREAL)0.5;
+  }
+  for (j = 1; j < n2; j++) {
+    L = n - j;
+    mj = j << M;
+    mL = L << M;
+    a = d1[mj] * d2[mj] - d1[mL] * d2[mL];
+    b = d1[mL] * d2[mj] + d1[mj] * d2[mL];
+    d1[mj] = (b + a) * (fREAL)0.5;
+    d1[mL] = (b - a) * (fREAL)0.5;
+    a = d1[m2 + mj] * d2[m2 + mj] - d1[m2 + mL] * d2[m2 + mL];
+    b = d1[m2 + mL] * d2[m2 + mj] + d1[m2 + mj] * d2[m2 + mL];
+    d1[m2 + mj] = (b + a) * (fREAL)0.5;
+    d1[m2 + mL] = (b - a) * (fREAL)0.5;
+  }
+  for (i = 1; i < m2; i++) {
+    k = m - i;
+    for (j = 1; j < n2; j++) {
+      L = n - j;
+      mj = j << M;
+      mL = L << M;
+      a = d1[i + mj] * d2[i + mj] - d1[k + mL] * d2[k + mL];
+      b = d1[k + mL] * d2[i + mj] + d1[i + mj] * d2[k + mL];
+      d1[i + mj] = (b + a) * (fREAL)0.5;
+      d1[k + mL] = (b - a) * (fREAL)0.5;
+      a = d1[i + mL] * d2[i + mL] - d1[k + mj] * d2[k + mj];
+      b = d1[k + mj] * d2[i + mL] + d1[i + mL] * d2[k + mj];
+      d1[i + mL] = (b + a) * (fREAL)0.5;
+      d1[k + mj] = (b - a) * (fREAL)0.5;
+    }
+  }
+}
+
+static int fft_size(const int size)
+{
+  return power_of_2_max_i(size);
+}
+
+/**
+ * Convolves blocks of one power of two size with the channels of a kernel, using Fast Hartley
+ * Transforms.
+ */
+class BlockConvolver : NonCopyable, NonMovable {
+ private:
+  int width_;
+  int height_;
+  unsigned int log2_width_;
+  unsigned int log2_height_;
+  Vector<fREAL *> kernel_spectra_;
+
+ public:
+  /** Buffers of a thread, #data holds the block to convolve and then the result. */
+  struct Buffers : NonCopyable, NonMovable {
+    fREAL *data;
+
+    Buffers(const BlockConvolver &convolver)
+    {
+      data = static_cast<fREAL *>(MEM_callocN(
+          sizeof(fREAL) * convolver.width_ * convolver.height_, "BlockConvolver data"));
+    }
+
+    ~Buffers()
+    {
+      MEM_freeN(data);
+    }
+  };
+
+  BlockConvolver(const int width, const int height, const int num_channels)
+      : width_(width), height_(height)
+  {
+    next_pow2(width, &log2_width_);
+    next_pow2(height, &log2_height_);
+    kernel_spectra_.resize(num_channels, nullptr);
+  }
+
+  ~BlockConvolver()
+  {
+    for (fREAL *spectrum : kernel_spectra_) {
+      MEM_freeN(spectrum);
+    }
+  }
+
+  /** Transform the kernel channel in the buffers data, \a num_rows being its height. */
+  void set_kernel(const int channel, Buffers &buffers, const int num_rows)
+  {
+    fREAL *spectrum = static_cast<fREAL *>(MEM_dupallocN(buffers.data));
+    FHT2D(spectrum, log2_width_, log2_height_, num_rows, 0);
+    kernel_spectra_[channel] = spectrum;
+  }
+
+  /** Convolve the block in the buffers data, which has \a num_rows rows that aren't zero. */
+  void convolve(const int channel, Buffers &buffers, const int num_rows) const
+  {
+    /* Transforms transpose the data, so the convolution is done with rows and columns swapped,
+     * and the inverse transform puts them back in order. */
+    FHT2D(buffers.data, log2_width_, log2_height_, num_rows, 0);
+    fht_convolve(buffers.data, kernel_spectra_[channel], log2_height_, log2_width_);
+    FHT2D(buffers.data, log2_height_, log2_width_, 0, 1);
+  }
+};
+
+#endif /* WITH_FFTW3 */
+
+void convolve_fft(const MemoryBuffer &image,
+                  const MemoryBuffer &kernel,
+                  const int num_channels,
+                  MemoryBuffer &r_output,
+                  const rcti &area)
+{
+  BLI_assert(!image.is_a_single_elem() && !kernel.is_a_single_elem());
+  BLI_assert(num_channels <= image.get_num_channels() &&
+             num_channels <= kernel.get_num_channels() &&
+             num_channels <= r_output.get_num_channels());
+  BLI_assert(BLI_rcti_inside_rcti(&r_output.get_rect(), &area));
+
+  const rcti &image_rect = image.get_rect();
+  const rcti &kernel_rect = kernel.get_rect();
+  const int image_width = image.get_width();
+  const int image_height = image.get_height();
+  const int kernel_width = kernel.get_width();
+  const int kernel_height = kernel.get_height();
+
+  threading::parallel_for(IndexRange(area.ymin, BLI_rcti_size_y(&area)), 32, [&](IndexRange ys) {
+    for (const int y : ys) {
+      float *out = r_output.get_elem(area.xmin, y);
+      for (int x = area.xmin; x < area.xmax; x++, out += r_output.elem_stride) {
+        for (int ch = 0; ch < num_channels; ch++) {
+          out[ch] = 0.0f;
+        }
+      }
+    }
+  });
+  if (image_width == 0 || image_height == 0 || BLI_rcti_is_empty(&area)) {
+    return;
+  }
+
+  /* Transforms are large enough for the linear convolution of a block to not wrap around. Blocks
+   * are about the kernel size, unless the whole image fits. */
+  const int fft_width = std::min(fft_size(2 * kernel_width - 1),
+                                 fft_size(image_width + kernel_width - 1));
+  const int fft_height = std::min(fft_size(2 * kernel_height - 1),
+                                  fft_size(image_height + kernel_height - 1));
+  const int block_width = fft_width + 1 - kernel_width;
+  const int block_height = fft_height + 1 - kernel_height;
+  const int num_blocks_x = divide_ceil_u(image_width, block_width);
+  const int num_blocks_y = divide_ceil_u(image_height, block_height);
+  const int kernel_half_width = kernel_width >> 1;
+  const int kernel_half_height = kernel_height >> 1;
+
+  BlockConvolver convolver(fft_width, fft_height, num_channels);
+  threading::parallel_for(IndexRange(num_channels), 1, [&](const IndexRange channels) {
+    for (const int ch : channels) {
+      BlockConvolver::Buffers buffers(convolver);
+      for (int y = 0; y < kernel_height; y++) {
+        fREAL *row = &buffers.data[y * fft_width];
+        const float *elem = kernel.get_elem(kernel_rect.xmin, kernel_rect.ymin + y);
+        for (int x = 0; x < kernel_width; x++, elem += kernel.elem_stride) {
+          row[x] = elem[ch];
+        }
+      }
+      convolver.set_kernel(ch, buffers, kernel_height);
+    }
+  });
+
+  /* The results of neighbor blocks overlap, as blocks are at least as large as the kernel only
+   * the direct neighbors do. Blocks are split in four passes such that blocks of a pass are never
+   * neighbors, and are convolved and added to the output in parallel. */
+  for (const int pass : IndexRange(4)) {
+    const int pass_blocks_x = divide_ceil_u(num_blocks_x - (pass & 1), 2);
+    const int pass_blocks_y = divide_ceil_u(num_blocks_y - (pass >> 1), 2);
+    const int pass_blocks_len = pass_blocks_x * pass_blocks_y;
+    if (pass_blocks_len <= 0) {
+      continue;
+    }
+    threading::parallel_for(IndexRange(pass_blocks_len), 1, [&](const IndexRange blocks) {
+      BlockConvolver::Buffers buffers(convolver);
+      for (const int block : blocks) {
+        const int xbl = (block % pass_blocks_x) * 2 + (pass & 1);
+        const int ybl = (block / pass_blocks_x) * 2 + (pass >> 1);
+        const int block_x = xbl * block_width;
+        const int block_y = ybl * block_height;
+        const int block_x_len = std::min(block_width, image_width - block_x);
+        const int block_y_len = std::min(block_height, image_height - block_y);
+
+        for (int ch = 0; ch < num_channels; ch++) {
+          memset(buffers.data, 0, sizeof(fREAL) * fft_width * fft_height);
+          for (int y = 0; y < block_y_len; y++) {
+            fREAL *row = &buffers.data[y * fft_width];
+            const float *elem = image.get_elem(image_rect.xmin + block_x,
+                                               image_rect.ymin + block_y + y);
+            for (int x = 0; x < block_x_len; x++, elem += image.elem_stride) {
+              row[x] = elem[ch];
+            }
+          }
+
+          convolver.convolve(ch, buffers, block_y_len);
+
+          /* Overlap-add the result, which extends by the kernel size past the block. */
+          const int result_x = image_rect.xmin + block_x - kernel_half_width;
+          const int result_y = image_rect.ymin + block_y - kernel_half_height;
+          const int xmin = std::max(area.xmin, result_x);
+          const int xmax = std::min(area.xmax, result_x + block_x_len + kernel_width - 1);
+          const int ymin = std::max(area.ymin, result_y);
+          const int ymax = std::min(area.ymax, result_y + block_y_len + kernel_height - 1);
+          for (int y = ymin; y < ymax; y++) {
+            const fREAL *row = &buffers.data[(y - result_y) * fft_width];
+            float *out = r_output.get_elem(xmin, y);
+            for (int x = xmin; x < xmax; x++, out += r_output.elem_stride) {
+              out[ch] += row[x - result_x];
+            }
+          }
+        }
+      }
+    });
+  }
+}
+
+}  // namespace blender::compositor
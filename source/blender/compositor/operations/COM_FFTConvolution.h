@@ -0,0 +1,42 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Copyright 2021, Blender Foundation.
+ */
+
+#pragma once
+
+#include "COM_MemoryBuffer.h"
+
+namespace blender::compositor {
+
+/**
+ * Convolve the first \a num_channels channels of \a image with the same channels of \a kernel
+ * using fast Fourier transforms, writing the result of those channels into \a r_output over
+ * \a area. Other channels are left untouched.
+ *
+ * The kernel is centered on its `(width / 2, height / 2)` element and pixels outside of \a image
+ * are zero. The image is split into blocks of about twice the kernel size, which are convolved
+ * in parallel and overlap-added to the output, so the cost doesn't depend on the kernel size.
+ *
+ * Uses FFTW when available, otherwise a power of two Fast Hartley Transform.
+ */
+void convolve_fft(const MemoryBuffer &image,
+                  const MemoryBuffer &kernel,
+                  int num_channels,
+                  MemoryBuffer &r_output,
+                  const rcti &area);
+
+}  // namespace blender::compositor
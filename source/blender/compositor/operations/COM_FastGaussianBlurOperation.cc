@@ -16,7 +16,8 @@
  * Copyright 2011, Blender Foundation.
  */
 
-#include <climits>
+#include "BLI_array.hh"
+#include "BLI_task.hh"
 
 #include "COM_FastGaussianBlurOperation.h"
 
@@ -117,18 +118,50 @@ void *FastGaussianBlurOperation::initialize_tile_data(rcti *rect)
   return iirgaus_;
 }
 
+/**
+ * Young/van Vliet recursive filter of a line of \a L elements, with a forward pass into \a W
+ * and a backward pass into \a Y. Expects lines of at least 3 elements.
+ */
+static void yvv_filter(const double *X,
+                       double *W,
+                       double *Y,
+                       const unsigned int L,
+                       const double cf[4],
+                       const double tsM[9])
+{
+  double tsu[3], tsv[3];
+  W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0];
+  W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0];
+  for (unsigned int i = 3; i < L; i++) {
+    W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3];
+  }
+  tsu[0] = W[L - 1] - X[L - 1];
+  tsu[1] = W[L - 2] - X[L - 1];
+  tsu[2] = W[L - 3] - X[L - 1];
+  tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1];
+  tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1];
+  tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1];
+  Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2];
+  Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1];
+  Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0];
+  for (int i = (int)L - 4; i >= 0; i--) {
+    Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3];
+  }
+}
+
+/**
+ * Rows and columns are filtered in parallel, each line being independent.
+ */
 void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                                           float sigma,
                                           unsigned int chan,
                                           unsigned int xy)
 {
   BLI_assert(!src->is_a_single_elem());
-  double q, q2, sc, cf[4], tsM[9], tsu[3], tsv[3];
-  double *X, *Y, *W;
+  double q, q2, sc, cf[4], tsM[9];
   const unsigned int src_width = src->get_width();
   const unsigned int src_height = src->get_height();
-  unsigned int x, y, sz;
-  unsigned int i;
   float *buffer = src->get_buffer();
   const uint8_t num_channels = src->get_num_channels();
 
@@ -141,7 +174,7 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
     xy = 3;
   }
 
-  /* XXX The YVV macro defined below explicitly expects sources of at least 3x3 pixels,
+  /* XXX #yvv_filter explicitly expects sources of at least 3x3 pixels,
    *     so just skipping blur along faulty direction if src's def is below that limit! */
   if (src_width < 3) {
     xy &= ~1;
@@ -192,75 +225,53 @@ void FastGaussianBlurOperation::IIR_gauss(MemoryBuffer *src,
                  cf[3] * cf[3] * cf[3] - cf[3] * cf[2] + cf[3]);
   tsM[8] = sc * (cf[3] * (cf[1] + cf[3] * cf[2]));
 
-#define YVV(L) \
-  { \
-    W[0] = cf[0] * X[0] + cf[1] * X[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[1] = cf[0] * X[1] + cf[1] * W[0] + cf[2] * X[0] + cf[3] * X[0]; \
-    W[2] = cf[0] * X[2] + cf[1] * W[1] + cf[2] * W[0] + cf[3] * X[0]; \
-    for (i = 3; i < L; i++) { \
-      W[i] = cf[0] * X[i] + cf[1] * W[i - 1] + cf[2] * W[i - 2] + cf[3] * W[i - 3]; \
-    } \
-    tsu[0] = W[L - 1] - X[L - 1]; \
-    tsu[1] = W[L - 2] - X[L - 1]; \
-    tsu[2] = W[L - 3] - X[L - 1]; \
-    tsv[0] = tsM[0] * tsu[0] + tsM[1] * tsu[1] + tsM[2] * tsu[2] + X[L - 1]; \
-    tsv[1] = tsM[3] * tsu[0] + tsM[4] * tsu[1] + tsM[5] * tsu[2] + X[L - 1]; \
-    tsv[2] = tsM[6] * tsu[0] + tsM[7] * tsu[1] + tsM[8] * tsu[2] + X[L - 1]; \
-    Y[L - 1] = cf[0] * W[L - 1] + cf[1] * tsv[0] + cf[2] * tsv[1] + cf[3] * tsv[2]; \
-    Y[L - 2] = cf[0] * W[L - 2] + cf[1] * Y[L - 1] + cf[2] * tsv[0] + cf[3] * tsv[1]; \
-    Y[L - 3] = cf[0] * W[L - 3] + cf[1] * Y[L - 2] + cf[2] * Y[L - 1] + cf[3] * tsv[0]; \
-    /* 'i != UINT_MAX' is really 'i >= 0', but necessary for unsigned int wrapping */ \
-    for (i = L - 4; i != UINT_MAX; i--) { \
-      Y[i] = cf[0] * W[i] + cf[1] * Y[i + 1] + cf[2] * Y[i + 2] + cf[3] * Y[i + 3]; \
-    } \
-  } \
-  (void)0
-
-  /* Intermediate buffers. */
-  sz = MAX2(src_width, src_height);
-  X = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss X buf");
-  Y = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss Y buf");
-  W = (double *)MEM_callocN(sz * sizeof(double), "IIR_gauss W buf");
   if (xy & 1) { /* H. */
-    int offset;
-    for (y = 0; y < src_height; y++) {
-      const int yx = y * src_width;
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        X[x] = buffer[offset];
-        offset += num_channels;
-      }
-      YVV(src_width);
-      offset = yx * num_channels + chan;
-      for (x = 0; x < src_width; x++) {
-        buffer[offset] = Y[x];
-        offset += num_channels;
+    threading::parallel_for(IndexRange(src_height), 16, [&](const IndexRange rows) {
+      Array<double> X(src_width), Y(src_width), W(src_width);
+      for (const int64_t y : rows) {
+        float *row = buffer + (size_t)y * src_width * num_channels + chan;
+        for (unsigned int x = 0; x < src_width; x++) {
+          X[x] = row[x * num_channels];
+        }
+        yvv_filter(X.data(), W.data(), Y.data(), src_width, cf, tsM);
+        for (unsigned int x = 0; x < src_width; x++) {
+          row[x * num_channels] = Y[x];
+        }
       }
-    }
+    });
   }
   if (xy & 2) { /* V. */
-    int offset;
-    const int add = src_width * num_channels;
-
-    for (x = 0; x < src_width; x++) {
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        X[y] = buffer[offset];
-        offset += add;
-      }
-      YVV(src_height);
-      offset = x * num_channels + chan;
-      for (y = 0; y < src_height; y++) {
-        buffer[offset] = Y[y];
-        offset += add;
+    /* Columns are filtered in blocks that are gathered row by row, to read memory contiguously
+     * instead of one element per row for every column. */
+    constexpr unsigned int block_size = 16;
+    const unsigned int num_blocks = divide_ceil_u(src_width, block_size);
+    threading::parallel_for(IndexRange(num_blocks), 1, [&](const IndexRange blocks) {
+      Array<double> X((size_t)block_size * src_height), Y(src_height), W(src_height);
+      for (const int64_t block : blocks) {
+        const unsigned int x_start = block * block_size;
+        const unsigned int block_width = MIN2(block_size, src_width - x_start);
+        for (unsigned int y = 0; y < src_height; y++) {
+          const float *row = buffer + ((size_t)y * src_width + x_start) * num_channels + chan;
+          for (unsigned int x = 0; x < block_width; x++) {
+            X[(size_t)x * src_height + y] = row[x * num_channels];
+          }
+        }
+        for (unsigned int x = 0; x < block_width; x++) {
+          double *column = &X[(size_t)x * src_height];
+          yvv_filter(column, W.data(), Y.data(), src_height, cf, tsM);
+          for (unsigned int y = 0; y < src_height; y++) {
+            column[y] = Y[y];
+          }
+        }
+        for (unsigned int y = 0; y < src_height; y++) {
+          float *row = buffer + ((size_t)y * src_width + x_start) * num_channels + chan;
+          for (unsigned int x = 0; x < block_width; x++) {
+            row[x * num_channels] = X[(size_t)x * src_height + y];
+          }
+        }
       }
-    }
+    });
   }
-
-  MEM_freeN(X);
-  MEM_freeN(W);
-  MEM_freeN(Y);
-#undef YVV
 }
 
 void FastGaussianBlurOperation::get_area_of_interest(const int input_idx,
@@ -281,8 +292,7 @@ void FastGaussianBlurOperation::update_memory_buffer_started(MemoryBuffer *outpu
                                                              const rcti &area,
                                                              Span<MemoryBuffer *> inputs)
 {
-  /* TODO(manzanilla): Add a render test and make #IIR_gauss multi-threaded with support for
-   * an output buffer. */
+  /* TODO(manzanilla): Add a render test and make #IIR_gauss support an output buffer. */
   const MemoryBuffer *input = inputs[IMAGE_INPUT_INDEX];
   MemoryBuffer *image = nullptr;
   const bool is_full_output = BLI_rcti_compare(&output->get_rect(), &area);
@@ -27,6 +27,7 @@ GlareBaseOperation::GlareBaseOperation()
   settings_ = nullptr;
   flags_.is_fullframe_operation = true;
   is_output_rendered_ = false;
+  flags_.can_cache_result = true;
 }
 void GlareBaseOperation::init_execution()
 {
@@ -40,6 +41,16 @@ void GlareBaseOperation::deinit_execution()
   SingleThreadedOperation::deinit_execution();
 }
 
+void GlareBaseOperation::hash_output_params()
+{
+  if (settings_) {
+    hash_params((int)settings_->quality, (int)settings_->type, (int)settings_->iter);
+    hash_params((int)settings_->size, (int)settings_->star_45, (int)settings_->streaks);
+    hash_params(settings_->colmod, settings_->mix, settings_->threshold);
+    hash_params(settings_->fade, settings_->angle_ofs);
+  }
+}
+
 MemoryBuffer *GlareBaseOperation::create_memory_buffer(rcti *rect2)
 {
   MemoryBuffer *tile = (MemoryBuffer *)input_program_->initialize_tile_data(rect2);
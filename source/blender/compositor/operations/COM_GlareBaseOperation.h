@@ -81,6 +81,8 @@ class GlareBaseOperation : public SingleThreadedOperation {
  protected:
   GlareBaseOperation();
 
+  void hash_output_params() override;
+
   virtual void generate_glare(float *data, MemoryBuffer *input_tile, NodeGlare *settings) = 0;
 
   MemoryBuffer *create_memory_buffer(rcti *rect) override;
@@ -31,6 +31,7 @@ InvertOperation::InvertOperation()
   alpha_ = false;
   set_canvas_input_index(1);
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 void InvertOperation::init_execution()
 {
@@ -34,6 +34,7 @@ MixBaseOperation::MixBaseOperation()
   this->set_use_value_alpha_multiply(false);
   this->set_use_clamp(false);
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 
 void MixBaseOperation::init_execution()
@@ -55,6 +55,11 @@ class QualityStepHelper {
   {
     quality_ = quality;
   }
+
+  eCompositorQuality get_quality() const
+  {
+    return quality_;
+  }
 };
 
 }  // namespace blender::compositor
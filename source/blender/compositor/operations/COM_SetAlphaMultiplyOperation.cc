@@ -29,6 +29,7 @@ SetAlphaMultiplyOperation::SetAlphaMultiplyOperation()
   input_color_ = nullptr;
   input_alpha_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 
 void SetAlphaMultiplyOperation::init_execution()
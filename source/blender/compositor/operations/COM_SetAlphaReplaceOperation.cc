@@ -29,6 +29,7 @@ SetAlphaReplaceOperation::SetAlphaReplaceOperation()
   input_color_ = nullptr;
   input_alpha_ = nullptr;
   flags_.can_be_constant = true;
+  flags_.can_be_fused = true;
 }
 
 void SetAlphaReplaceOperation::init_execution()
@@ -43,6 +43,13 @@ VariableSizeBokehBlurOperation::VariableSizeBokehBlurOperation()
 #ifdef COM_DEFOCUS_SEARCH
   input_search_program_ = nullptr;
 #endif
+  flags_.can_cache_result = true;
+}
+
+void VariableSizeBokehBlurOperation::hash_output_params()
+{
+  hash_params(max_blur_, threshold_, do_size_scale_);
+  hash_param(get_quality());
 }
 
 void VariableSizeBokehBlurOperation::init_execution()
@@ -53,6 +53,7 @@ VectorBlurOperation::VectorBlurOperation()
   input_zprogram_ = nullptr;
   flags_.complex = true;
   flags_.is_fullframe_operation = true;
+  flags_.can_cache_result = true;
 }
 void VectorBlurOperation::init_execution()
 {
@@ -71,6 +72,15 @@ void VectorBlurOperation::execute_pixel(float output[4], int x, int y, void *dat
   copy_v4_v4(output, &buffer[index]);
 }
 
+void VectorBlurOperation::hash_output_params()
+{
+  if (settings_) {
+    hash_params(settings_->samples, settings_->maxspeed, settings_->minspeed);
+    hash_params(settings_->curved, settings_->fac);
+  }
+  hash_param(get_quality());
+}
+
 void VectorBlurOperation::deinit_execution()
 {
   deinit_mutex();
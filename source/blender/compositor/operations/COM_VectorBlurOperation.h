@@ -80,6 +80,8 @@ class VectorBlurOperation : public NodeOperation, public QualityStepHelper {
                             Span<MemoryBuffer *> inputs) override;
 
  protected:
+  void hash_output_params() override;
+
   void generate_vector_blur(float *data,
                             MemoryBuffer *input_image,
                             MemoryBuffer *input_speed,
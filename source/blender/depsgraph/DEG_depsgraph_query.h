@@ -161,6 +161,10 @@ typedef struct DEGObjectIterData {
   /* Temporary storage to report fully populated DNA to the render engine or
    * other users of the iterator. */
   struct Object temp_dupli_object;
+  /* Bounding box of the temporary object when it instances other data than the data of the
+   * original object, see #deg_iterator_duplis_step. */
+  struct BoundBox temp_dupli_object_bb;
+  struct ID *temp_dupli_object_bb_data;
 
   /* **** Iteration over ID nodes **** */
   size_t id_node_index;
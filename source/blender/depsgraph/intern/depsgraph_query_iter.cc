@@ -169,7 +169,18 @@ bool deg_iterator_duplis_step(DEGObjectIterData *data)
     copy_v4_v4(temp_dupli_object->color, dupli_parent->color);
     temp_dupli_object->runtime.select_id = dupli_parent->runtime.select_id;
     if (dob->ob->data != dob->ob_data) {
+      /* Don't overwrite the bounding box of the original object with the bounds of the instanced
+       * data. Consecutive instances often share the same data, so keep the bounds when they have
+       * been computed already, instead of looping over all the vertices for every instance. */
+      BoundBox *bb = &data->temp_dupli_object_bb;
+      const bool bb_is_valid = data->temp_dupli_object_bb_data == dob->ob_data &&
+                               (bb->flag & BOUNDBOX_DIRTY) == 0;
+      temp_dupli_object->runtime.bb = bb;
       BKE_object_replace_data_on_shallow_copy(temp_dupli_object, dob->ob_data);
+      if (bb_is_valid) {
+        bb->flag &= ~BOUNDBOX_DIRTY;
+      }
+      data->temp_dupli_object_bb_data = dob->ob_data;
     }
 
     /* Duplicated elements shouldn't care whether their original collection is visible or not. */
@@ -284,6 +295,8 @@ void DEG_iterator_objects_begin(BLI_Iterator *iter, DEGObjectIterData *data)
   data->dupli_list = nullptr;
   data->dupli_object_next = nullptr;
   data->dupli_object_current = nullptr;
+  data->temp_dupli_object_bb.flag = BOUNDBOX_DIRTY;
+  data->temp_dupli_object_bb_data = nullptr;
   data->scene = DEG_get_evaluated_scene(depsgraph);
   data->id_node_index = 0;
   data->num_id_nodes = num_id_nodes;
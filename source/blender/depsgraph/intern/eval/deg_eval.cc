@@ -25,11 +25,16 @@
 
 #include "intern/eval/deg_eval.h"
 
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
 #include "PIL_time.h"
 
 #include "BLI_compiler_attrs.h"
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
+#include "BLI_trace.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_global.h"
@@ -66,6 +71,7 @@ namespace {
 struct DepsgraphEvalState;
 
 void deg_task_run_func(TaskPool *pool, void *taskdata);
+void deg_task_run_batch_func(TaskPool *pool, void *taskdata);
 
 template<typename ScheduleFunction, typename... ScheduleFunctionArgs>
 void schedule_children(DepsgraphEvalState *state,
@@ -78,6 +84,57 @@ void schedule_node_to_pool(OperationNode *node, const int UNUSED(thread_id), Tas
   BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
 }
 
+/* Operations for which the operation itself and all operations depending on it took less than
+ * this time (in seconds) during the previous evaluation are considered cheap. Cheap operations
+ * are evaluated in batches, since pushing them to the pool one by one costs more than
+ * evaluating them. */
+constexpr float CHEAP_OPERATION_TIME = 2e-5f;
+/* Maximum number of cheap operations evaluated by a single task. */
+constexpr int MAX_CHEAP_OPERATIONS_BATCH = 64;
+
+bool is_cheap_operation(const OperationNode *node)
+{
+  /* Operations which were never evaluated have no estimate yet. */
+  return node->critical_path_time > 0.0f && node->critical_path_time < CHEAP_OPERATION_TIME;
+}
+
+/* Batch of cheap operations pushed to the pool as a single task. */
+struct OperationBatch {
+  int size;
+  OperationNode *operations[MAX_CHEAP_OPERATIONS_BATCH];
+};
+
+/* Scheduling of the children of an operation which has just been evaluated by a task. */
+struct TaskScheduleState {
+  TaskPool *pool;
+  /* Ready operation with the longest critical path, which is evaluated next by the same task
+   * instead of going through the pool. */
+  OperationNode *next_operation;
+  /* Ready cheap operations, evaluated by the same task as well. */
+  Vector<OperationNode *, MAX_CHEAP_OPERATIONS_BATCH> cheap_operations;
+};
+
+void schedule_node_to_task(OperationNode *node,
+                           const int thread_id,
+                           TaskScheduleState *task_schedule_state)
+{
+  if (is_cheap_operation(node) &&
+      task_schedule_state->cheap_operations.size() < MAX_CHEAP_OPERATIONS_BATCH) {
+    task_schedule_state->cheap_operations.append(node);
+    return;
+  }
+  OperationNode *next_operation = task_schedule_state->next_operation;
+  if (next_operation == nullptr) {
+    task_schedule_state->next_operation = node;
+    return;
+  }
+  if (node->critical_path_time > next_operation->critical_path_time) {
+    task_schedule_state->next_operation = node;
+    node = next_operation;
+  }
+  schedule_node_to_pool(node, thread_id, task_schedule_state->pool);
+}
+
 /* Denotes which part of dependency graph is being evaluated. */
 enum class EvaluationStage {
   /* Stage 1: Only  Copy-on-Write operations are to be evaluated, prior to anything else.
@@ -100,22 +157,64 @@ struct DepsgraphEvalState {
   bool do_stats;
   EvaluationStage stage;
   bool need_single_thread_pass;
+  /* Operations in the order they were evaluated in, used to update critical path estimates.
+   * Sized to the number of operations in the graph, every operation is evaluated at most once. */
+  Vector<OperationNode *> evaluated_operations;
+  uint32_t num_evaluated_operations;
 };
 
-void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_node)
+void tag_operation_evaluated(DepsgraphEvalState *state, OperationNode *operation_node)
+{
+  const uint32_t index = atomic_fetch_and_add_uint32(&state->num_evaluated_operations, 1);
+  state->evaluated_operations[index] = operation_node;
+}
+
+void evaluate_node(DepsgraphEvalState *state, OperationNode *operation_node)
 {
   ::Depsgraph *depsgraph = reinterpret_cast<::Depsgraph *>(state->graph);
 
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
-  /* Perform operation. */
+  /* Perform operation. Always measure the time, it is needed for the critical path. */
+  const bool do_trace = BLI_trace_is_enabled();
+  const uint64_t trace_start_ns = do_trace ? BLI_trace_time_ns() : 0;
+  const double start_time = PIL_check_seconds_timer();
+  operation_node->evaluate(depsgraph);
+  const double evaluation_time = PIL_check_seconds_timer() - start_time;
+  if (do_trace) {
+    BLI_trace_event_add("depsgraph",
+                        operation_node->full_identifier().c_str(),
+                        trace_start_ns,
+                        BLI_trace_time_ns());
+  }
+  operation_node->evaluation_time = (float)evaluation_time;
   if (state->do_stats) {
-    const double start_time = PIL_check_seconds_timer();
-    operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += PIL_check_seconds_timer() - start_time;
+    operation_node->stats.current_time += evaluation_time;
   }
-  else {
-    operation_node->evaluate(depsgraph);
+  tag_operation_evaluated(state, operation_node);
+}
+
+/* Evaluate operations of the task schedule state, until there are none left. */
+void evaluate_task_operations(DepsgraphEvalState *state, TaskScheduleState *task_schedule_state)
+{
+  while (true) {
+    OperationNode *operation_node = task_schedule_state->next_operation;
+    if (operation_node != nullptr) {
+      task_schedule_state->next_operation = nullptr;
+    }
+    else if (!task_schedule_state->cheap_operations.is_empty()) {
+      operation_node = task_schedule_state->cheap_operations.pop_last();
+    }
+    else {
+      break;
+    }
+
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
+
+    /* Schedule children, continue with the one which has the longest critical path right away,
+     * so that long chains of operations are not delayed behind cheap ones. */
+    schedule_children(state, operation_node, schedule_node_to_task, task_schedule_state);
   }
 }
 
@@ -124,12 +223,23 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
-  OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  TaskScheduleState task_schedule_state;
+  task_schedule_state.pool = pool;
+  task_schedule_state.next_operation = reinterpret_cast<OperationNode *>(taskdata);
+  evaluate_task_operations(state, &task_schedule_state);
+}
+
+void deg_task_run_batch_func(TaskPool *pool, void *taskdata)
+{
+  void *userdata_v = BLI_task_pool_user_data(pool);
+  DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
+  const OperationBatch *batch = reinterpret_cast<const OperationBatch *>(taskdata);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, schedule_node_to_pool, pool);
+  TaskScheduleState task_schedule_state;
+  task_schedule_state.pool = pool;
+  task_schedule_state.next_operation = nullptr;
+  task_schedule_state.cheap_operations.extend(Span(batch->operations, batch->size));
+  evaluate_task_operations(state, &task_schedule_state);
 }
 
 bool check_operation_node_visible(OperationNode *op_node)
@@ -185,6 +295,8 @@ void calculate_pending_parents(Depsgraph *graph)
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   const bool do_stats = state->do_stats;
+  state->evaluated_operations.resize(graph->operations.size());
+  state->num_evaluated_operations = 0;
   calculate_pending_parents(graph);
   /* Clear tags and other things which needs to be clear. */
   for (OperationNode *node : graph->operations) {
@@ -271,6 +383,7 @@ void schedule_node(DepsgraphEvalState *state,
   if (!is_scheduled) {
     if (node->is_noop()) {
       /* skip NOOP node, schedule children right away */
+      tag_operation_evaluated(state, node);
       schedule_children(state, node, schedule_function, schedule_function_args...);
     }
     else {
@@ -311,6 +424,46 @@ void schedule_children(DepsgraphEvalState *state,
   }
 }
 
+void schedule_node_to_vector(OperationNode *node,
+                             const int /*thread_id*/,
+                             Vector<OperationNode *> *operations)
+{
+  operations->append(node);
+}
+
+void schedule_graph_to_pool(DepsgraphEvalState *state, TaskPool *pool)
+{
+  Vector<OperationNode *> ready_operations;
+  schedule_graph(state, schedule_node_to_vector, &ready_operations);
+  /* Push operations with the longest critical path first, so that they are the first ones to be
+   * picked up by the worker threads. */
+  std::stable_sort(ready_operations.begin(),
+                   ready_operations.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->critical_path_time > b->critical_path_time;
+                   });
+  OperationBatch *batch = nullptr;
+  for (OperationNode *operation_node : ready_operations) {
+    if (!is_cheap_operation(operation_node)) {
+      schedule_node_to_pool(operation_node, 0, pool);
+      continue;
+    }
+    /* Group cheap operations, the task overhead would dominate their evaluation otherwise. */
+    if (batch == nullptr) {
+      batch = (OperationBatch *)MEM_mallocN(sizeof(OperationBatch), __func__);
+      batch->size = 0;
+    }
+    batch->operations[batch->size++] = operation_node;
+    if (batch->size == MAX_CHEAP_OPERATIONS_BATCH) {
+      BLI_task_pool_push(pool, deg_task_run_batch_func, batch, true, nullptr);
+      batch = nullptr;
+    }
+  }
+  if (batch != nullptr) {
+    BLI_task_pool_push(pool, deg_task_run_batch_func, batch, true, nullptr);
+  }
+}
+
 void schedule_node_to_queue(OperationNode *node,
                             const int /*thread_id*/,
                             GSQueue *evaluation_queue)
@@ -377,6 +530,7 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
     return;
   }
 
+  TRACE_SCOPE("depsgraph", "Evaluate");
   graph->debug.begin_graph_evaluation();
 
 #ifdef WITH_PYTHON
@@ -398,14 +552,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   /* First, process all Copy-On-Write nodes. */
   state.stage = EvaluationStage::COPY_ON_WRITE;
   TaskPool *task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
   /* After that, process all other nodes. */
   state.stage = EvaluationStage::THREADED_EVALUATION;
   task_pool = deg_evaluate_task_pool_create(&state);
-  schedule_graph(&state, schedule_node_to_pool, task_pool);
+  schedule_graph_to_pool(&state, task_pool);
   BLI_task_pool_work_and_wait(task_pool);
   BLI_task_pool_free(task_pool);
 
@@ -420,6 +574,8 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  deg_eval_stats_update_critical_path(
+      state.evaluated_operations.as_span().take_front(state.num_evaluated_operations));
   /* Clear any uncleared tags - just in case. */
   deg_graph_clear_tags(graph);
   graph->is_evaluating = false;
@@ -817,6 +817,9 @@ ID *deg_expand_copy_on_write_datablock(const Depsgraph *depsgraph, const IDNode
     return id_cow;
   }
 
+  /* Attribute layers of copied geometry still count as mesh memory. */
+  MEM_ScopedDomain domain(MEM_DOMAIN_DEPSGRAPH);
+
   DEG_COW_PRINT(
       "Expanding datablock for %s: id_orig=%p id_cow=%p\n", id_orig->name, id_orig, id_cow);
 
@@ -26,6 +26,7 @@
 #include "BLI_utildefines.h"
 
 #include "intern/depsgraph.h"
+#include "intern/depsgraph_relation.h"
 
 #include "intern/node/deg_node.h"
 #include "intern/node/deg_node_component.h"
@@ -54,4 +55,22 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+void deg_eval_stats_update_critical_path(Span<OperationNode *> evaluated_operations)
+{
+  /* Walk in reverse order, so that operations which depend on an operation are updated before
+   * it. Operations which were not evaluated this time keep their estimate from before. */
+  for (int i = evaluated_operations.size() - 1; i >= 0; i--) {
+    OperationNode *op_node = evaluated_operations[i];
+    float children_time = 0.0f;
+    for (Relation *rel : op_node->outlinks) {
+      if (rel->flag & RELATION_FLAG_CYCLIC) {
+        continue;
+      }
+      const OperationNode *child = (OperationNode *)rel->to;
+      children_time = max(children_time, child->critical_path_time);
+    }
+    op_node->critical_path_time = op_node->evaluation_time + children_time;
+  }
+}
+
 }  // namespace blender::deg
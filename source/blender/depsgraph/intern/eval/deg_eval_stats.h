@@ -23,13 +23,21 @@
 
 #pragma once
 
+#include "BLI_span.hh"
+
 namespace blender {
 namespace deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Update critical path time of evaluated operations from their evaluation time.
+ * Operations are to be passed in the order they were evaluated in, so that every operation
+ * comes after the operations it depends on. */
+void deg_eval_stats_update_critical_path(Span<OperationNode *> evaluated_operations);
+
 }  // namespace deg
 }  // namespace blender
@@ -265,6 +265,13 @@ struct OperationNode : public Node {
   uint32_t num_links_pending;
   bool scheduled;
 
+  /* Time in seconds the last evaluation of this operation took. */
+  float evaluation_time;
+  /* Estimated time in seconds of the longest chain of operations which starts with this one,
+   * based on the previous evaluations. Ready operations with the longest critical path are
+   * evaluated first. */
+  float critical_path_time;
+
   /* Identifier for the operation being performed. */
   OperationCode opcode;
   int name_tag;
@@ -78,6 +78,11 @@ typedef struct SELECTID_Context {
   /* To check for updates. */
   float persmat[4][4];
   bool is_dirty;
+
+  /* Copy of the whole select id texture, read back the first time it is queried after being
+   * drawn. Following queries are answered from it without reading back from the GPU.
+   * NULL when the texture has been drawn again. */
+  uint *buffer_cache;
 } SELECTID_Context;
 
 /* draw_select_buffer.c */
@@ -212,6 +212,7 @@ void EEVEE_view_layer_data_free(void *storage)
   /* Lights */
   MEM_SAFE_FREE(sldata->lights);
   DRW_UBO_FREE_SAFE(sldata->light_ubo);
+  DRW_UBO_FREE_SAFE(sldata->light_cluster_ubo);
   DRW_UBO_FREE_SAFE(sldata->shadow_ubo);
   GPU_FRAMEBUFFER_FREE_SAFE(sldata->shadow_fb);
   DRW_TEXTURE_FREE_SAFE(sldata->shadow_cube_pool);
@@ -75,6 +75,10 @@
   (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_X) * \
       (IRRADIANCE_MAX_POOL_SIZE / IRRADIANCE_SAMPLE_SIZE_Y)
 
+/* Time in seconds after which a batch of samples stops. Samples of a batch share the same draw
+ * cache, but the GPU context is locked for the whole batch, which can freeze the UI. */
+#define LIGHTBAKE_BATCH_TIME 0.1
+
 /* TODO: should be replace by a more elegant alternative. */
 extern void DRW_opengl_context_enable(void);
 extern void DRW_opengl_context_disable(void);
@@ -1052,6 +1056,8 @@ static void eevee_lightbake_render_world_sample(void *ved, void *user_data)
 
   lcache->flag |= LIGHTCACHE_CUBE_READY | LIGHTCACHE_GRID_READY;
   lcache->flag &= ~LIGHTCACHE_UPDATE_WORLD;
+
+  lbake->done += 1;
 }
 
 static void cell_id_to_grid_loc(EEVEE_LightGrid *egrid, int cell_idx, int r_local_cell[3])
@@ -1112,12 +1118,10 @@ static void grid_loc_to_world_loc(EEVEE_LightGrid *egrid, const int local_cell[3
   madd_v3_v3fl(r_pos, egrid->increment_z, local_cell[2]);
 }
 
-static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
+static void eevee_lightbake_render_grid_sample(EEVEE_Data *vedata, EEVEE_LightBake *lbake)
 {
-  EEVEE_Data *vedata = (EEVEE_Data *)ved;
-  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
+  EEVEE_ViewLayerData *sldata = lbake->sldata;
   EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
-  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   EEVEE_LightGrid *egrid = lbake->grid;
   LightProbe *prb = *lbake->probe;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
@@ -1133,10 +1137,6 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   /* Use the previous bounce for rendering this bounce. */
   SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
 
-  /* TODO: do this once for the whole bake when we have independent DRWManagers.
-   * Warning: Some of the things above require this. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Compute sample position */
   compute_cell_id(egrid, prb, lbake->grid_sample, &sample_id, grid_loc, &stride);
   sample_offset = egrid->offset + sample_id;
@@ -1197,22 +1197,45 @@ static void eevee_lightbake_render_grid_sample(void *ved, void *user_data)
   }
 }
 
-static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
+/* Render samples of the current grid, starting at `lbake->grid_sample`, until the grid is done
+ * or the batch time is exceeded. The draw cache only depends on the grid visibility collection,
+ * so it is created once for all of them. */
+static void eevee_lightbake_render_grid_samples(void *ved, void *user_data)
 {
   EEVEE_Data *vedata = (EEVEE_Data *)ved;
-  EEVEE_ViewLayerData *sldata = EEVEE_view_layer_data_ensure();
-  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
   EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
   Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
   LightCache *lcache = scene_eval->eevee.light_cache_data;
+  const double batch_start = PIL_check_seconds_timer();
+
+  /* No bias for rendering the probe. */
+  lbake->grid->level_bias = 1.0f;
+
+  /* TODO: do this once for the whole bake when we have independent DRWManagers.
+   * Warning: Some of the things above require this. */
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+  eevee_lightbake_cache_create(vedata, lbake);
+  SWAP(GPUTexture *, lbake->grid_prev, lcache->grid_tx.tex);
+
+  do {
+    eevee_lightbake_render_grid_sample(vedata, lbake);
+    lbake->grid_sample++;
+    lbake->done += 1;
+  } while ((lbake->grid_sample < lbake->grid_sample_len) &&
+           (PIL_check_seconds_timer() - batch_start < LIGHTBAKE_BATCH_TIME));
+}
+
+static void eevee_lightbake_render_probe_sample(EEVEE_Data *vedata, EEVEE_LightBake *lbake)
+{
+  EEVEE_ViewLayerData *sldata = lbake->sldata;
+  EEVEE_CommonUniformBuffer *common_data = &sldata->common_data;
+  Scene *scene_eval = DEG_get_evaluated_scene(lbake->depsgraph);
+  LightCache *lcache = scene_eval->eevee.light_cache_data;
   EEVEE_LightProbe *eprobe = lbake->cube;
   LightProbe *prb = *lbake->probe;
   float clamp = scene_eval->eevee.gi_glossy_clamp;
   float filter_quality = scene_eval->eevee.gi_filter_quality;
 
-  /* TODO: do this once for the whole bake when we have independent DRWManagers. */
-  eevee_lightbake_cache_create(vedata, lbake);
-
   /* Disable specular lighting when rendering probes to avoid feedback loops (looks bad). */
   common_data->spec_toggle = false;
   common_data->sss_toggle = false;
@@ -1242,6 +1265,40 @@ static void eevee_lightbake_render_probe_sample(void *ved, void *user_data)
   }
 }
 
+static bool eevee_lightbake_probe_same_visibility(const LightProbe *prb_a,
+                                                  const LightProbe *prb_b)
+{
+  return (prb_a->visibility_grp == prb_b->visibility_grp) &&
+         ((prb_a->flag & LIGHTPROBE_FLAG_INVERT_GROUP) ==
+          (prb_b->flag & LIGHTPROBE_FLAG_INVERT_GROUP));
+}
+
+/* Render reflection probes, starting at `lbake->cube_offset`, until the batch time is exceeded.
+ * Consecutive probes with the same visibility collection share the same draw cache. */
+static void eevee_lightbake_render_probe_samples(void *ved, void *user_data)
+{
+  EEVEE_Data *vedata = (EEVEE_Data *)ved;
+  EEVEE_LightBake *lbake = (EEVEE_LightBake *)user_data;
+  const double batch_start = PIL_check_seconds_timer();
+
+  /* TODO: do this once for the whole bake when we have independent DRWManagers. */
+  eevee_lightbake_cache_create(vedata, lbake);
+
+  while (true) {
+    eevee_lightbake_render_probe_sample(vedata, lbake);
+    lbake->done += 1;
+
+    if ((lbake->cube_offset == lbake->cube_len - 1) ||
+        !eevee_lightbake_probe_same_visibility(lbake->probe[0], lbake->probe[1]) ||
+        (PIL_check_seconds_timer() - batch_start >= LIGHTBAKE_BATCH_TIME)) {
+      break;
+    }
+    lbake->cube_offset++;
+    lbake->probe++;
+    lbake->cube++;
+  }
+}
+
 static float eevee_lightbake_grid_influence_volume(EEVEE_LightGrid *grid)
 {
   return mat4_to_scale(grid->mat);
@@ -1364,7 +1421,6 @@ static bool lightbake_do_sample(EEVEE_LightBake *lbake,
   /* TODO: make DRW manager instantiable (and only lock on drawing) */
   eevee_lightbake_context_enable(lbake);
   DRW_custom_pipeline(&draw_engine_eevee_type, depsgraph, render_callback, lbake);
-  lbake->done += 1;
   *lbake->progress = lbake->done / (float)lbake->total;
   *lbake->do_update = 1;
   eevee_lightbake_context_disable(lbake);
@@ -1442,9 +1498,12 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
         LightProbe *prb = *lbake->probe;
         lbake->grid_sample_len = prb->grid_resolution_x * prb->grid_resolution_y *
                                  prb->grid_resolution_z;
-        for (lbake->grid_sample = 0; lbake->grid_sample < lbake->grid_sample_len;
-             ++lbake->grid_sample) {
-          lightbake_do_sample(lbake, eevee_lightbake_render_grid_sample);
+        /* The samples are rendered in batches, each advancing `lbake->grid_sample`. */
+        lbake->grid_sample = 0;
+        while (lbake->grid_sample < lbake->grid_sample_len) {
+          if (!lightbake_do_sample(lbake, eevee_lightbake_render_grid_samples)) {
+            break;
+          }
         }
       }
     }
@@ -1455,9 +1514,13 @@ void EEVEE_lightbake_job(void *custom_data, short *stop, short *do_update, float
     /* Bypass world, start at 1. */
     lbake->probe = lbake->cube_prb + 1;
     lbake->cube = lcache->cube_data + 1;
+    /* The probes are rendered in batches, each advancing `lbake->cube_offset` to the last
+     * probe it rendered. */
     for (lbake->cube_offset = 1; lbake->cube_offset < lbake->cube_len;
          lbake->cube_offset++, lbake->probe++, lbake->cube++) {
-      lightbake_do_sample(lbake, eevee_lightbake_render_probe_sample);
+      if (!lightbake_do_sample(lbake, eevee_lightbake_render_probe_samples)) {
+        break;
+      }
     }
   }
 
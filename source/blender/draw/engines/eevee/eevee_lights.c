@@ -243,6 +243,113 @@ void EEVEE_lights_cache_add(EEVEE_ViewLayerData *sldata, Object *ob)
   linfo->num_light++;
 }
 
+static void light_cluster_range_clamp(float min, float max, int len, int r_range[2])
+{
+  r_range[0] = max_ii(0, (int)floorf(min));
+  r_range[1] = min_ii(len - 1, (int)floorf(max));
+}
+
+/**
+ * Fill the bitmask of the lights affecting each cluster of a grid following the default view.
+ * Shading points only evaluate the lights of the cluster they are inside of.
+ */
+static void eevee_light_clusters_update(EEVEE_LightsInfo *linfo)
+{
+  EEVEE_LightClusters *clusters = &linfo->light_clusters;
+  memset(clusters->masks, 0, sizeof(clusters->masks));
+
+  const DRWView *view = DRW_view_default_get();
+  if (view == NULL) {
+    /* Evaluate all lights everywhere. */
+    zero_v4(clusters->params);
+    return;
+  }
+
+  float winmat[4][4];
+  DRW_view_persmat_get(view, clusters->persmat, false);
+  DRW_view_winmat_get(view, winmat, false);
+  const bool is_persp = DRW_view_is_persp_get(view);
+  const float near = -DRW_view_near_distance_get(view);
+  const float far = -DRW_view_far_distance_get(view);
+  clusters->params[0] = is_persp ? 1.0f : 0.0f;
+  clusters->params[1] = near;
+  clusters->params[2] = is_persp ? LIGHT_CLUSTER_Z / log2f(far / near) : 0.0f;
+  clusters->params[3] = 1.0f;
+
+  for (int i = 0; i < linfo->num_light; i++) {
+    const EEVEE_Light *evli = linfo->light_data + i;
+    int range_x[2] = {0, LIGHT_CLUSTER_X - 1};
+    int range_y[2] = {0, LIGHT_CLUSTER_Y - 1};
+    int range_z[2] = {0, LIGHT_CLUSTER_Z - 1};
+
+    if (evli->light_type != LA_SUN) {
+      const float radius = 1.0f / sqrtf(evli->invsqrdist);
+
+      /* Depth slices. */
+      if (is_persp) {
+        const float w = mul_project_m4_v3_zfac(clusters->persmat, evli->position);
+        const float w_min = w - radius, w_max = w + radius;
+        if (w_max < near) {
+          continue;
+        }
+        const float slice_scale = clusters->params[2];
+        light_cluster_range_clamp((w_min > near) ? log2f(w_min / near) * slice_scale : 0.0f,
+                                  log2f(w_max / near) * slice_scale,
+                                  LIGHT_CLUSTER_Z,
+                                  range_z);
+      }
+      else {
+        float co[3];
+        mul_v3_project_m4_v3(co, clusters->persmat, evli->position);
+        const float delta = radius * fabsf(winmat[2][2]);
+        light_cluster_range_clamp(((co[2] - delta) * 0.5f + 0.5f) * LIGHT_CLUSTER_Z,
+                                  ((co[2] + delta) * 0.5f + 0.5f) * LIGHT_CLUSTER_Z,
+                                  LIGHT_CLUSTER_Z,
+                                  range_z);
+      }
+
+      /* Screen tiles, from the projection of the bounding box of the influence sphere. */
+      float ndc_min[2] = {FLT_MAX, FLT_MAX}, ndc_max[2] = {-FLT_MAX, -FLT_MAX};
+      bool is_clipped = false;
+      for (int corner = 0; corner < 8; corner++) {
+        float co[4] = {evli->position[0] + ((corner & 1) ? radius : -radius),
+                       evli->position[1] + ((corner & 2) ? radius : -radius),
+                       evli->position[2] + ((corner & 4) ? radius : -radius),
+                       1.0f};
+        mul_m4_v4(clusters->persmat, co);
+        if (co[3] <= 1e-6f) {
+          is_clipped = true;
+          break;
+        }
+        for (int axis = 0; axis < 2; axis++) {
+          ndc_min[axis] = min_ff(ndc_min[axis], co[axis] / co[3]);
+          ndc_max[axis] = max_ff(ndc_max[axis], co[axis] / co[3]);
+        }
+      }
+      if (!is_clipped) {
+        light_cluster_range_clamp((ndc_min[0] * 0.5f + 0.5f) * LIGHT_CLUSTER_X,
+                                  (ndc_max[0] * 0.5f + 0.5f) * LIGHT_CLUSTER_X,
+                                  LIGHT_CLUSTER_X,
+                                  range_x);
+        light_cluster_range_clamp((ndc_min[1] * 0.5f + 0.5f) * LIGHT_CLUSTER_Y,
+                                  (ndc_max[1] * 0.5f + 0.5f) * LIGHT_CLUSTER_Y,
+                                  LIGHT_CLUSTER_Y,
+                                  range_y);
+      }
+    }
+
+    const uint bit = 1u << (i % 32);
+    for (int z = range_z[0]; z <= range_z[1]; z++) {
+      for (int y = range_y[0]; y <= range_y[1]; y++) {
+        for (int x = range_x[0]; x <= range_x[1]; x++) {
+          const int cluster = (z * LIGHT_CLUSTER_Y + y) * LIGHT_CLUSTER_X + x;
+          clusters->masks[cluster][i / 32] |= bit;
+        }
+      }
+    }
+  }
+}
+
 void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
 {
   EEVEE_LightsInfo *linfo = sldata->lights;
@@ -265,5 +372,8 @@ void EEVEE_lights_cache_finish(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  eevee_light_clusters_update(linfo);
+
   GPU_uniformbuf_update(sldata->light_ubo, &linfo->light_data);
+  GPU_uniformbuf_update(sldata->light_cluster_ubo, &linfo->light_clusters);
 }
@@ -53,6 +53,11 @@ extern struct DrawEngineType draw_engine_eevee_type;
 #define MAX_SHADOW_CASCADE 8
 #define MAX_SHADOW_CUBE (MAX_SHADOW - MAX_CASCADE_NUM * MAX_SHADOW_CASCADE)
 #define MAX_BLOOM_STEP 16
+/* Light culling grid, in screen tiles and depth slices. One bit per light in each cluster. */
+#define LIGHT_CLUSTER_X 16
+#define LIGHT_CLUSTER_Y 8
+#define LIGHT_CLUSTER_Z 6
+#define LIGHT_CLUSTER_LEN (LIGHT_CLUSTER_X * LIGHT_CLUSTER_Y * LIGHT_CLUSTER_Z)
 #define MAX_AOVS 64
 
 /* Special value chosen to not be altered by depth of field sample count. */
@@ -82,6 +87,10 @@ extern struct DrawEngineType draw_engine_eevee_type;
   "#define MAX_SHADOW_CUBE " STRINGIFY(MAX_SHADOW_CUBE) "\n" \
   "#define MAX_SHADOW_CASCADE " STRINGIFY(MAX_SHADOW_CASCADE) "\n" \
   "#define MAX_CASCADE_NUM " STRINGIFY(MAX_CASCADE_NUM) "\n" \
+  "#define LIGHT_CLUSTER_X " STRINGIFY(LIGHT_CLUSTER_X) "\n" \
+  "#define LIGHT_CLUSTER_Y " STRINGIFY(LIGHT_CLUSTER_Y) "\n" \
+  "#define LIGHT_CLUSTER_Z " STRINGIFY(LIGHT_CLUSTER_Z) "\n" \
+  "#define LIGHT_CLUSTER_LEN " STRINGIFY(LIGHT_CLUSTER_LEN) "\n" \
   SHADER_IRRADIANCE
 /* clang-format on */
 
@@ -492,6 +501,17 @@ typedef struct EEVEE_Light {
   float diff, spec, volume, volume_radius;
 } EEVEE_Light;
 
+/* Lights affecting each cluster of the light culling grid, matches lights_lib.glsl. */
+typedef struct EEVEE_LightClusters {
+  /* Matrix the grid is defined with. Shading points outside of it use all lights. */
+  float persmat[4][4];
+  /* x: is perspective, y: near distance, z: depth slice scale, w: is valid. */
+  float params[4];
+  uint masks[LIGHT_CLUSTER_LEN][4];
+} EEVEE_LightClusters;
+
+BLI_STATIC_ASSERT(MAX_LIGHT <= 128, "Light cluster masks are limited to 128 lights")
+
 /* Special type for elliptic area lights, matches lamps_lib.glsl */
 #define LAMPTYPE_AREA_ELLIPSE 100.0f
 
@@ -523,14 +543,23 @@ typedef struct EEVEE_ShadowCascadeRender {
   float cascade_exponent;
   float cascade_fade;
   int cascade_count;
+  /* State of the cascades the last time they were rendered, to skip rendering them again when
+   * nothing changed. */
+  float rendered_shadowmat[MAX_CASCADE_NUM][4][4];
+  int rendered_tex_id;
 } EEVEE_ShadowCascadeRender;
 
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Light, 16)
+BLI_STATIC_ASSERT_ALIGN(EEVEE_LightClusters, 16)
 BLI_STATIC_ASSERT_ALIGN(EEVEE_Shadow, 16)
 BLI_STATIC_ASSERT_ALIGN(EEVEE_ShadowCube, 16)
 BLI_STATIC_ASSERT_ALIGN(EEVEE_ShadowCascade, 16)
 BLI_STATIC_ASSERT_ALIGN(EEVEE_RenderPassData, 16)
 
+/* The light UBO is already full with #MAX_LIGHT lights, the clusters have their own. */
+BLI_STATIC_ASSERT(sizeof(EEVEE_Light) * MAX_LIGHT <= 16384, "Light UBO is too big!!!")
+BLI_STATIC_ASSERT(sizeof(EEVEE_LightClusters) <= 16384, "Light cluster UBO is too big!!!")
+
 BLI_STATIC_ASSERT(sizeof(EEVEE_Shadow) * MAX_SHADOW +
                           sizeof(EEVEE_ShadowCascade) * MAX_SHADOW_CASCADE +
                           sizeof(EEVEE_ShadowCube) * MAX_SHADOW_CUBE <
@@ -554,6 +583,7 @@ typedef struct EEVEE_LightsInfo {
   bool shadow_high_bitdepth, soft_shadows;
   /* UBO Storage : data used by UBO */
   struct EEVEE_Light light_data[MAX_LIGHT];
+  struct EEVEE_LightClusters light_clusters;
   struct EEVEE_Shadow shadow_data[MAX_SHADOW];
   struct EEVEE_ShadowCube shadow_cube_data[MAX_SHADOW_CUBE];
   struct EEVEE_ShadowCascade shadow_cascade_data[MAX_SHADOW_CASCADE];
@@ -564,6 +594,7 @@ typedef struct EEVEE_LightsInfo {
   uchar shadow_cascade_light_indices[MAX_SHADOW_CASCADE];
   /* Update bitmap. */
   BLI_bitmap sh_cube_update[BLI_BITMAP_SIZE(MAX_SHADOW_CUBE)];
+  BLI_bitmap sh_cascade_update[BLI_BITMAP_SIZE(MAX_SHADOW_CASCADE)];
   /* Lights tracking */
   struct BoundSphere shadow_bounds[MAX_LIGHT]; /* Tightly packed light bounds. */
   /* List of bbox and update bitmap. Double buffered. */
@@ -908,6 +939,7 @@ typedef struct EEVEE_ViewLayerData {
   struct EEVEE_LightsInfo *lights;
 
   struct GPUUniformBuf *light_ubo;
+  struct GPUUniformBuf *light_cluster_ubo;
   struct GPUUniformBuf *shadow_ubo;
   struct GPUUniformBuf *shadow_samples_ubo;
 
@@ -50,6 +50,8 @@ void EEVEE_shadows_init(EEVEE_ViewLayerData *sldata)
   if (!sldata->lights) {
     sldata->lights = MEM_callocN(sizeof(EEVEE_LightsInfo), "EEVEE_LightsInfo");
     sldata->light_ubo = GPU_uniformbuf_create_ex(sizeof(EEVEE_Light) * MAX_LIGHT, NULL, "evLight");
+    sldata->light_cluster_ubo = GPU_uniformbuf_create_ex(
+        sizeof(EEVEE_LightClusters), NULL, "evLightCluster");
     sldata->shadow_ubo = GPU_uniformbuf_create_ex(shadow_ubo_size, NULL, "evShadow");
 
     for (int i = 0; i < 2; i++) {
@@ -241,6 +243,8 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
                                                               shadow_pool_format,
                                                               DRW_TEX_FILTER | DRW_TEX_COMPARE,
                                                               NULL);
+    /* Content of the new pool is undefined. */
+    BLI_bitmap_set_all(&linfo->sh_cascade_update[0], true, MAX_SHADOW_CASCADE);
   }
 
   if (sldata->shadow_fb == NULL) {
@@ -256,6 +260,9 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  /* Cascades cover the whole view, any caster update invalidates them. */
+  bool any_caster_update = false;
+
   /* TODO(fclem): This part can be slow, optimize it. */
   EEVEE_BoundBox *bbox = backbuffer->bbox;
   BoundSphere *bsphere = linfo->shadow_bounds;
@@ -263,6 +270,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < backbuffer->count; i++) {
     /* If the shadow-caster has been deleted or updated. */
     if (BLI_BITMAP_TEST(backbuffer->update, i)) {
+      any_caster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -277,6 +285,7 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
   for (int i = 0; i < frontbuffer->count; i++) {
     /* If the shadow-caster has been updated. */
     if (BLI_BITMAP_TEST(frontbuffer->update, i)) {
+      any_caster_update = true;
       for (int j = 0; j < linfo->cube_len; j++) {
         if (!BLI_BITMAP_TEST(&linfo->sh_cube_update[0], j)) {
           if (sphere_bbox_intersect(&bsphere[j], &bbox[i])) {
@@ -287,6 +296,10 @@ void EEVEE_shadows_update(EEVEE_ViewLayerData *sldata, EEVEE_Data *vedata)
     }
   }
 
+  if (any_caster_update) {
+    BLI_bitmap_set_all(&linfo->sh_cascade_update[0], true, MAX_SHADOW_CASCADE);
+  }
+
   /* Resize shcasters buffers if too big. */
   if (frontbuffer->alloc_count - frontbuffer->count > SH_CASTER_ALLOC_CHUNK) {
     frontbuffer->alloc_count = (frontbuffer->count / SH_CASTER_ALLOC_CHUNK) *
@@ -381,6 +394,7 @@ void EEVEE_shadow_output_init(EEVEE_ViewLayerData *sldata,
   DRW_shgroup_uniform_block(grp, "grid_block", sldata->grid_ubo);
   DRW_shgroup_uniform_block(grp, "planar_block", sldata->planar_ubo);
   DRW_shgroup_uniform_block(grp, "light_block", sldata->light_ubo);
+  DRW_shgroup_uniform_block(grp, "light_cluster_block", sldata->light_cluster_ubo);
   DRW_shgroup_uniform_block(grp, "shadow_block", sldata->shadow_ubo);
   DRW_shgroup_uniform_block(grp, "common_block", sldata->common_ubo);
   DRW_shgroup_uniform_block(grp, "renderpass_block", sldata->renderpass_ubo.combined);
@@ -40,6 +40,20 @@ void EEVEE_shadows_cascade_add(EEVEE_LightsInfo *linfo, EEVEE_Light *evli, Objec
   EEVEE_ShadowCascade *csm_data = linfo->shadow_cascade_data + linfo->cascade_len;
   EEVEE_ShadowCascadeRender *csm_render = linfo->shadow_cascade_render + linfo->cascade_len;
 
+  /* Same as for cube shadows, dupli lights are always updated. */
+  bool update = (ob->base_flag & BASE_FROM_DUPLI) != 0;
+  if (!update) {
+    EEVEE_LightEngineData *led = EEVEE_light_data_ensure(ob);
+    if (led->need_update) {
+      update = true;
+      led->need_update = false;
+    }
+  }
+
+  if (update) {
+    BLI_BITMAP_ENABLE(&linfo->sh_cascade_update[0], linfo->cascade_len);
+  }
+
   eevee_contact_shadow_setup(la, sh_data);
 
   linfo->shadow_cascade_light_indices[linfo->cascade_len] = linfo->num_light;
@@ -417,6 +431,16 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
 
   eevee_shadow_cascade_setup(linfo, evli, view, near, far, effects->taa_current_sample - 1);
 
+  /* Reuse the shadow maps if neither the casters, the light nor the cascades changed since they
+   * were rendered. This is the case for every sample of a still view without soft shadows. */
+  if (!BLI_BITMAP_TEST(linfo->sh_cascade_update, cascade_index) &&
+      (csm_render->rendered_tex_id == csm_data->tex_id) &&
+      (memcmp(csm_render->rendered_shadowmat,
+              csm_data->shadowmat,
+              sizeof(csm_data->shadowmat[0]) * csm_render->cascade_count) == 0)) {
+    return;
+  }
+
   /* Meh, Reusing the cube views. */
   BLI_assert(MAX_CASCADE_NUM <= 6);
   eevee_ensure_cascade_views(csm_render, g_data->cube_views);
@@ -434,4 +458,10 @@ void EEVEE_shadows_draw_cascades(EEVEE_ViewLayerData *sldata,
     GPU_framebuffer_clear_depth(sldata->shadow_fb, 1.0f);
     DRW_draw_pass(psl->shadow_pass);
   }
+
+  memcpy(csm_render->rendered_shadowmat,
+         csm_data->shadowmat,
+         sizeof(csm_data->shadowmat[0]) * csm_render->cascade_count);
+  csm_render->rendered_tex_id = csm_data->tex_id;
+  BLI_BITMAP_SET(linfo->sh_cascade_update, cascade_index, false);
 }
@@ -91,10 +91,19 @@
         CLOSURE_META_SUBROUTINE_DATA(planar_eval, planar, t0, t1, t2, t3); \
       } \
 \
-      for (int i = 0; i < laNumLight && i < MAX_LIGHT; i++) { \
-        ClosureLightData light = closure_light_eval_init(cl_common, i); \
-        if (light.vis > 1e-8) { \
-          CLOSURE_META_SUBROUTINE_DATA(light_eval, light, t0, t1, t2, t3); \
+      /* Only iterate over the lights of the cluster containing the shading point. */ \
+      uvec4 light_mask = light_cluster_mask_get(cl_common.P); \
+      for (int w = 0; w < 4 && w * 32 < laNumLight; w++) { \
+        uint light_bits = light_mask[w]; \
+        for (int i = w * 32; light_bits != 0u && i < laNumLight && i < MAX_LIGHT; \
+             i++, light_bits >>= 1u) { \
+          if ((light_bits & 1u) == 0u) { \
+            continue; \
+          } \
+          ClosureLightData light = closure_light_eval_init(cl_common, i); \
+          if (light.vis > 1e-8) { \
+            CLOSURE_META_SUBROUTINE_DATA(light_eval, light, t0, t1, t2, t3); \
+          } \
         } \
       } \
 \
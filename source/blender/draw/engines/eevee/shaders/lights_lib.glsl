@@ -89,6 +89,14 @@ layout(std140) uniform light_block
   LightData lights_data[MAX_LIGHT];
 };
 
+/* Light culling grid, see #EEVEE_LightClusters. */
+layout(std140) uniform light_cluster_block
+{
+  mat4 lightClusterPersmat;
+  vec4 lightClusterParams;
+  uvec4 lightClusterMasks[LIGHT_CLUSTER_LEN];
+};
+
 uniform sampler2DArrayShadow shadowCubeTexture;
 uniform sampler2DArrayShadow shadowCascadeTexture;
 
@@ -242,6 +250,32 @@ float spot_attenuation(LightData ld, vec3 l_vector)
   return spotmask;
 }
 
+/* Return one bit per light that can affect the shading point. */
+uvec4 light_cluster_mask_get(vec3 P)
+{
+  const uvec4 all_lights = uvec4(0xFFFFFFFFu);
+  if (lightClusterParams.w == 0.0) {
+    return all_lights;
+  }
+  vec4 clip = lightClusterPersmat * vec4(P, 1.0);
+  if (clip.w <= 0.0) {
+    return all_lights;
+  }
+  vec3 ndc = clip.xyz / clip.w;
+  float slice = (lightClusterParams.x != 0.0) ?
+                    log2(clip.w / lightClusterParams.y) * lightClusterParams.z :
+                    (ndc.z * 0.5 + 0.5) * float(LIGHT_CLUSTER_Z);
+  vec2 tile = (ndc.xy * 0.5 + 0.5) * vec2(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y);
+  ivec3 cluster = ivec3(floor(vec3(tile, slice)));
+  if (any(lessThan(cluster, ivec3(0))) ||
+      any(greaterThanEqual(cluster, ivec3(LIGHT_CLUSTER_X, LIGHT_CLUSTER_Y, LIGHT_CLUSTER_Z)))) {
+    /* Outside of the grid. */
+    return all_lights;
+  }
+  return lightClusterMasks[(cluster.z * LIGHT_CLUSTER_Y + cluster.y) * LIGHT_CLUSTER_X +
+                           cluster.x];
+}
+
 float light_attenuation(LightData ld, vec4 l_vector)
 {
   float vis = 1.0;
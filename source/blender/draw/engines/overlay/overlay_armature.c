@@ -30,8 +30,11 @@
 #include "DNA_scene_types.h"
 #include "DNA_view3d_types.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "DRW_render.h"
 
+#include "BLI_hash_mm2a.h"
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 
@@ -50,6 +53,7 @@
 #include "draw_common.h"
 #include "draw_manager_text.h"
 
+#include "overlay_engine.h"
 #include "overlay_private.h"
 
 #define BONE_VAR(eBone, pchan, var) ((eBone) ? (eBone->var) : (pchan->var))
@@ -138,6 +142,8 @@ void OVERLAY_armature_cache_init(OVERLAY_Data *vedata)
   pd->armature.do_pose_fade_geom = pd->armature.do_pose_xray &&
                                    ((draw_ctx->object_mode & OB_MODE_WEIGHT_PAINT) == 0) &&
                                    draw_ctx->object_pose != NULL;
+  pd->armature.theme_hash = BLI_hash_mm2(
+      (const uchar *)&G_draw.block, sizeof(G_draw.block), 0);
   DRWState state;
 
   if (pd->armature.do_pose_fade_geom) {
@@ -2210,6 +2216,162 @@ void OVERLAY_pose_armature_cache_populate(OVERLAY_Data *vedata, Object *ob)
   draw_armature_pose(&arm_ctx);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Object Mode Instance Data Cache
+ *
+ * In object mode all bones are drawn using constant colors, so the instance data only changes
+ * when the pose or the display settings change. The data is kept on the object and copied back
+ * into the call buffers for as long as the object isn't tagged for update.
+ * \{ */
+
+#define ARMATURE_CACHE_SLOT_LEN 5
+
+typedef struct OVERLAY_ArmatureCacheKey {
+  float const_color[4];
+  float const_wire;
+  uint theme_hash;
+  int arm_flag;
+  uint arm_layer;
+  char arm_drawtype;
+  char ob_dt;
+  bool transparent;
+  char _pad;
+} OVERLAY_ArmatureCacheKey;
+
+typedef struct OVERLAY_ArmatureCache {
+  DrawData dd;
+  OVERLAY_ArmatureCacheKey key;
+  bool is_valid;
+  /* Cached entries of each call buffer written by #draw_armature_pose. */
+  void *data[ARMATURE_CACHE_SLOT_LEN];
+  uint len[ARMATURE_CACHE_SLOT_LEN];
+} OVERLAY_ArmatureCache;
+
+static void armature_cache_clear(OVERLAY_ArmatureCache *cache)
+{
+  for (int i = 0; i < ARMATURE_CACHE_SLOT_LEN; i++) {
+    MEM_SAFE_FREE(cache->data[i]);
+    cache->len[i] = 0;
+  }
+  cache->is_valid = false;
+}
+
+static void armature_cache_free(DrawData *dd)
+{
+  armature_cache_clear((OVERLAY_ArmatureCache *)dd);
+}
+
+static void armature_cache_slots_get(ArmatureDrawContext *ctx,
+                                     DRWCallBuffer *r_slots[ARMATURE_CACHE_SLOT_LEN])
+{
+  /* Envelope and stick buffers alias these in the union. */
+  r_slots[0] = ctx->outline;
+  r_slots[1] = ctx->solid;
+  r_slots[2] = ctx->wire;
+  r_slots[3] = ctx->point_solid;
+  r_slots[4] = ctx->point_outline;
+}
+
+static void armature_cache_key_get(const ArmatureDrawContext *ctx,
+                                   const OVERLAY_PrivateData *pd,
+                                   OVERLAY_ArmatureCacheKey *r_key)
+{
+  const Object *ob = ctx->ob;
+  const bArmature *arm = ob->data;
+  memset(r_key, 0, sizeof(*r_key));
+  copy_v4_v4(r_key->const_color, ctx->const_color);
+  r_key->const_wire = ctx->const_wire;
+  r_key->theme_hash = pd->armature.theme_hash;
+  r_key->arm_flag = arm->flag;
+  r_key->arm_layer = arm->layer;
+  r_key->arm_drawtype = arm->drawtype;
+  r_key->ob_dt = ob->dt;
+  r_key->transparent = pd->armature.transparent;
+}
+
+/**
+ * Only plain bones are cached. Custom shapes, names and axes are not written to the instance
+ * buffers of the armature context.
+ */
+static bool armature_cache_is_supported(const ArmatureDrawContext *ctx)
+{
+  const DRWContextState *draw_ctx = DRW_context_state_get();
+  const Object *ob = ctx->ob;
+  const bArmature *arm = ob->data;
+
+  if (DRW_state_is_select() || (ob->base_flag & BASE_FROM_DUPLI) || (ob->mode & OB_MODE_POSE) ||
+      (ob == draw_ctx->object_pose)) {
+    return false;
+  }
+  if (arm->flag & (ARM_DRAWNAMES | ARM_DRAWAXES)) {
+    return false;
+  }
+  if ((arm->flag & ARM_NO_CUSTOM) == 0) {
+    LISTBASE_FOREACH (const bPoseChannel *, pchan, &ob->pose->chanbase) {
+      if (pchan->custom) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+static void draw_armature_pose_cached(ArmatureDrawContext *ctx, OVERLAY_PrivateData *pd)
+{
+  Object *ob = ctx->ob;
+
+  if (!armature_cache_is_supported(ctx)) {
+    draw_armature_pose(ctx);
+    return;
+  }
+
+  OVERLAY_ArmatureCache *cache = (OVERLAY_ArmatureCache *)DRW_drawdata_ensure(
+      &ob->id, &draw_engine_overlay_type, sizeof(OVERLAY_ArmatureCache), NULL, armature_cache_free);
+
+  OVERLAY_ArmatureCacheKey key;
+  armature_cache_key_get(ctx, pd, &key);
+
+  DRWCallBuffer *slots[ARMATURE_CACHE_SLOT_LEN];
+  armature_cache_slots_get(ctx, slots);
+
+  if (cache->is_valid && cache->dd.recalc == 0 && memcmp(&key, &cache->key, sizeof(key)) == 0) {
+    for (int i = 0; i < ARMATURE_CACHE_SLOT_LEN; i++) {
+      if (cache->len[i] > 0) {
+        DRW_buffer_add_entries(slots[i], cache->data[i], cache->len[i]);
+      }
+    }
+    return;
+  }
+
+  armature_cache_clear(cache);
+
+  uint start[ARMATURE_CACHE_SLOT_LEN];
+  for (int i = 0; i < ARMATURE_CACHE_SLOT_LEN; i++) {
+    start[i] = slots[i] ? DRW_buffer_len_get(slots[i]) : 0;
+  }
+
+  draw_armature_pose(ctx);
+
+  for (int i = 0; i < ARMATURE_CACHE_SLOT_LEN; i++) {
+    if (slots[i] == NULL) {
+      continue;
+    }
+    const uint len = DRW_buffer_len_get(slots[i]) - start[i];
+    if (len > 0) {
+      cache->data[i] = MEM_mallocN(len * DRW_buffer_entry_size_get(slots[i]), __func__);
+      DRW_buffer_entries_read(slots[i], start[i], len, cache->data[i]);
+      cache->len[i] = len;
+    }
+  }
+
+  cache->key = key;
+  /* A pose that wasn't evaluated yet draws nothing, don't keep that. */
+  cache->is_valid = (ob->pose->flag & POSE_RECALC) == 0;
+  cache->dd.recalc = 0;
+}
+
+/** \} */
+
 void OVERLAY_armature_cache_populate(OVERLAY_Data *vedata, Object *ob)
 {
   const DRWContextState *draw_ctx = DRW_context_state_get();
@@ -2223,7 +2385,7 @@ void OVERLAY_armature_cache_populate(OVERLAY_Data *vedata, Object *ob)
 
   DRW_object_wire_theme_get(ob, draw_ctx->view_layer, &color);
   armature_context_setup(&arm_ctx, pd, ob, false, false, false, color);
-  draw_armature_pose(&arm_ctx);
+  draw_armature_pose_cached(&arm_ctx, pd);
 }
 
 static bool POSE_is_driven_by_active_armature(Object *ob)
@@ -409,6 +409,8 @@ typedef struct OVERLAY_PrivateData {
     bool show_relations;
     bool do_pose_xray;
     bool do_pose_fade_geom;
+    /* Hash of the theme colors, invalidates the cached object mode instance data. */
+    uint theme_hash;
   } armature;
   struct {
     bool in_front;
@@ -218,6 +218,7 @@ static void select_cache_init(void *vedata)
     copy_m4_m4(e_data.context.persmat, persmat);
     e_data.context.objects_drawn_len = 0;
     e_data.context.index_drawn_len = 1;
+    MEM_SAFE_FREE(e_data.context.buffer_cache);
     select_engine_framebuffer_setup();
     GPU_framebuffer_bind(e_data.framebuffer_select_id);
     GPU_framebuffer_clear_color_depth(e_data.framebuffer_select_id, (const float[4]){0.0f}, 1.0f);
@@ -308,6 +309,8 @@ static void select_draw_scene(void *vedata)
     return;
   }
 
+  MEM_SAFE_FREE(e_data.context.buffer_cache);
+
   DRW_view_set_active(stl->g_data->view_faces);
 
   if (!DRW_pass_is_empty(psl->depth_only_pass)) {
@@ -346,6 +349,7 @@ static void select_engine_free(void)
   MEM_SAFE_FREE(e_data.context.objects);
   MEM_SAFE_FREE(e_data.context.index_offsets);
   MEM_SAFE_FREE(e_data.context.objects_drawn);
+  MEM_SAFE_FREE(e_data.context.buffer_cache);
 }
 
 /** \} */
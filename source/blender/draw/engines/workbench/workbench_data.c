@@ -38,15 +38,25 @@
 /** \name World Data
  * \{ */
 
-GPUUniformBuf *workbench_material_ubo_alloc(WORKBENCH_PrivateData *wpd)
+static GPUUniformBuf *workbench_ubo_alloc(BLI_memblock *ubo_pool)
 {
-  struct GPUUniformBuf **ubo = BLI_memblock_alloc(wpd->material_ubo);
+  struct GPUUniformBuf **ubo = BLI_memblock_alloc(ubo_pool);
   if (*ubo == NULL) {
     *ubo = GPU_uniformbuf_create(sizeof(WORKBENCH_UBO_Material) * MAX_MATERIAL);
   }
   return *ubo;
 }
 
+GPUUniformBuf *workbench_material_ubo_alloc(WORKBENCH_PrivateData *wpd)
+{
+  return workbench_ubo_alloc(wpd->material_ubo);
+}
+
+GPUUniformBuf *workbench_object_ubo_alloc(WORKBENCH_PrivateData *wpd)
+{
+  return workbench_ubo_alloc(wpd->object_ubo);
+}
+
 static void workbench_ubo_free(void *elem)
 {
   GPUUniformBuf **ubo = elem;
@@ -64,6 +74,8 @@ static void workbench_view_layer_data_free(void *storage)
 
   BLI_memblock_destroy(vldata->material_ubo_data, NULL);
   BLI_memblock_destroy(vldata->material_ubo, workbench_ubo_free);
+  BLI_memblock_destroy(vldata->object_ubo_data, NULL);
+  BLI_memblock_destroy(vldata->object_ubo, workbench_ubo_free);
 }
 
 static WORKBENCH_ViewLayerData *workbench_view_layer_data_ensure_ex(struct ViewLayer *view_layer)
@@ -78,6 +90,8 @@ static WORKBENCH_ViewLayerData *workbench_view_layer_data_ensure_ex(struct ViewL
     size_t matbuf_size = sizeof(WORKBENCH_UBO_Material) * MAX_MATERIAL;
     (*vldata)->material_ubo_data = BLI_memblock_create_ex(matbuf_size, matbuf_size * 2);
     (*vldata)->material_ubo = BLI_memblock_create_ex(sizeof(void *), sizeof(void *) * 8);
+    (*vldata)->object_ubo_data = BLI_memblock_create_ex(matbuf_size, matbuf_size * 2);
+    (*vldata)->object_ubo = BLI_memblock_create_ex(sizeof(void *), sizeof(void *) * 8);
     (*vldata)->world_ubo = GPU_uniformbuf_create_ex(sizeof(WORKBENCH_UBO_World), NULL, "wb_World");
   }
 
@@ -279,6 +293,14 @@ void workbench_private_data_init(WORKBENCH_PrivateData *wpd)
     /* Init default material used by vertex color & texture. */
     workbench_material_ubo_data(
         wpd, NULL, NULL, &wpd->material_ubo_data_curr[0], V3D_SHADING_MATERIAL_COLOR);
+
+    /* Object chunks are allocated on first use. */
+    wpd->object_ubo_data = vldata->object_ubo_data;
+    wpd->object_ubo = vldata->object_ubo;
+    wpd->object_ubo_data_curr = NULL;
+    wpd->object_ubo_curr = NULL;
+    wpd->object_chunk_count = 0;
+    wpd->object_chunk_curr = -1;
   }
 }
 
@@ -300,14 +322,11 @@ void workbench_update_world_ubo(WORKBENCH_PrivateData *wpd)
   GPU_uniformbuf_update(wpd->world_ubo, &wd);
 }
 
-void workbench_update_material_ubos(WORKBENCH_PrivateData *UNUSED(wpd))
+static void workbench_update_ubo_pool(BLI_memblock *ubo_pool, BLI_memblock *data_pool)
 {
-  const DRWContextState *draw_ctx = DRW_context_state_get();
-  WORKBENCH_ViewLayerData *vldata = workbench_view_layer_data_ensure_ex(draw_ctx->view_layer);
-
   BLI_memblock_iter iter, iter_data;
-  BLI_memblock_iternew(vldata->material_ubo, &iter);
-  BLI_memblock_iternew(vldata->material_ubo_data, &iter_data);
+  BLI_memblock_iternew(ubo_pool, &iter);
+  BLI_memblock_iternew(data_pool, &iter_data);
   WORKBENCH_UBO_Material *matchunk;
   while ((matchunk = BLI_memblock_iterstep(&iter_data))) {
     GPUUniformBuf **ubo = BLI_memblock_iterstep(&iter);
@@ -315,6 +334,15 @@ void workbench_update_material_ubos(WORKBENCH_PrivateData *UNUSED(wpd))
     GPU_uniformbuf_update(*ubo, matchunk);
   }
 
-  BLI_memblock_clear(vldata->material_ubo, workbench_ubo_free);
-  BLI_memblock_clear(vldata->material_ubo_data, NULL);
+  BLI_memblock_clear(ubo_pool, workbench_ubo_free);
+  BLI_memblock_clear(data_pool, NULL);
+}
+
+void workbench_update_material_ubos(WORKBENCH_PrivateData *UNUSED(wpd))
+{
+  const DRWContextState *draw_ctx = DRW_context_state_get();
+  WORKBENCH_ViewLayerData *vldata = workbench_view_layer_data_ensure_ex(draw_ctx->view_layer);
+
+  workbench_update_ubo_pool(vldata->material_ubo, vldata->material_ubo_data);
+  workbench_update_ubo_pool(vldata->object_ubo, vldata->object_ubo_data);
 }
@@ -158,6 +158,25 @@ BLI_INLINE bool workbench_material_chunk_select(WORKBENCH_PrivateData *wpd,
   return resource_changed;
 }
 
+/* Same as #workbench_material_chunk_select but for the chunks indexed by object resource id. */
+BLI_INLINE void workbench_object_chunk_select(WORKBENCH_PrivateData *wpd,
+                                              uint32_t id,
+                                              uint32_t *r_mat_id)
+{
+  int chunk = (int)(id >> 12u);
+  *r_mat_id = id & 0xFFFu;
+  while (chunk >= wpd->object_chunk_count) {
+    wpd->object_chunk_count++;
+    BLI_memblock_alloc(wpd->object_ubo_data);
+    workbench_object_ubo_alloc(wpd);
+  }
+  if (wpd->object_chunk_curr != chunk) {
+    wpd->object_ubo_data_curr = BLI_memblock_elem_get(wpd->object_ubo_data, 0, chunk);
+    wpd->object_ubo_curr = BLI_memblock_elem_get(wpd->object_ubo, 0, chunk);
+    wpd->object_chunk_curr = chunk;
+  }
+}
+
 DRWShadingGroup *workbench_material_setup_ex(WORKBENCH_PrivateData *wpd,
                                              Object *ob,
                                              int mat_nr,
@@ -197,6 +216,20 @@ DRWShadingGroup *workbench_material_setup_ex(WORKBENCH_PrivateData *wpd,
         *r_transp = true;
       }
 
+      /* Objects with a single material keep it in their own slot and share one shading group. */
+      if (datatype == WORKBENCH_DATATYPE_MESH && DRW_cache_object_material_count_get(ob) == 1) {
+        uint32_t mat_id;
+        workbench_object_chunk_select(wpd, DRW_object_resource_id_get(ob), &mat_id);
+        workbench_material_ubo_data(wpd, ob, ma, &wpd->object_ubo_data_curr[mat_id], color_type);
+
+        if (prepass->object_chunk != wpd->object_chunk_curr) {
+          prepass->object_chunk = wpd->object_chunk_curr;
+          prepass->object_shgrp = DRW_shgroup_create_sub(prepass->common_shgrp);
+          DRW_shgroup_uniform_block(prepass->object_shgrp, "material_block", wpd->object_ubo_curr);
+        }
+        return prepass->object_shgrp;
+      }
+
       DRWShadingGroup **grp_mat = NULL;
       /* A hashmap stores material shgroups to pack all similar drawcalls together. */
       if (BLI_ghash_ensure_p(prepass->material_hash, ma, (void ***)&grp_mat)) {
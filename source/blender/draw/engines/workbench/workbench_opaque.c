@@ -84,6 +84,8 @@ void workbench_opaque_cache_init(WORKBENCH_Data *vedata)
 
       for (eWORKBENCH_DataType data = 0; data < WORKBENCH_DATATYPE_MAX; data++) {
         wpd->prepass[opaque][infront][data].material_hash = BLI_ghash_ptr_new(__func__);
+        wpd->prepass[opaque][infront][data].object_shgrp = NULL;
+        wpd->prepass[opaque][infront][data].object_chunk = -1;
 
         sh = workbench_shader_opaque_get(wpd, data);
 
@@ -234,6 +234,9 @@ typedef struct WORKBENCH_Prepass {
   struct DRWShadingGroup *image_shgrp;
   /** First UDIM (tiled image) shading group to created subgroups. */
   struct DRWShadingGroup *image_tiled_shgrp;
+  /** Shading group for objects with a single material, bound to the object chunk below. */
+  struct DRWShadingGroup *object_shgrp;
+  int object_chunk;
 } WORKBENCH_Prepass;
 
 typedef struct WORKBENCH_PrivateData {
@@ -338,6 +341,16 @@ typedef struct WORKBENCH_PrivateData {
   int material_chunk_curr;
   /** Index of current material inside the material chunk. Only for material coloring mode. */
   int material_index;
+  /**
+   * Same as above, but indexed by object resource id. Used in material coloring mode by objects
+   * with a single material, so that they don't need a shading group per material.
+   */
+  struct BLI_memblock *object_ubo;
+  struct BLI_memblock *object_ubo_data;
+  WORKBENCH_UBO_Material *object_ubo_data_curr;
+  struct GPUUniformBuf *object_ubo_curr;
+  int object_chunk_count;
+  int object_chunk_curr;
 
   /* Volumes */
   /** List of smoke domain textures to free after drawing. */
@@ -392,6 +405,8 @@ typedef struct WORKBENCH_ViewLayerData {
   /** Materials UBO's allocated in a memblock for easy bookkeeping. */
   struct BLI_memblock *material_ubo;
   struct BLI_memblock *material_ubo_data;
+  struct BLI_memblock *object_ubo;
+  struct BLI_memblock *object_ubo_data;
   /** Number of samples for which cavity_sample_ubo is valid. */
   int cavity_sample_count;
 } WORKBENCH_ViewLayerData;
@@ -518,6 +533,7 @@ void workbench_private_data_init(WORKBENCH_PrivateData *wpd);
 void workbench_update_world_ubo(WORKBENCH_PrivateData *wpd);
 void workbench_update_material_ubos(WORKBENCH_PrivateData *wpd);
 struct GPUUniformBuf *workbench_material_ubo_alloc(WORKBENCH_PrivateData *wpd);
+struct GPUUniformBuf *workbench_object_ubo_alloc(WORKBENCH_PrivateData *wpd);
 
 /* workbench_volume.c */
 void workbench_volume_engine_init(WORKBENCH_Data *vedata);
@@ -107,6 +107,8 @@ void workbench_transparent_cache_init(WORKBENCH_Data *vedata)
 
       for (eWORKBENCH_DataType data = 0; data < WORKBENCH_DATATYPE_MAX; data++) {
         wpd->prepass[transp][infront][data].material_hash = BLI_ghash_ptr_new(__func__);
+        wpd->prepass[transp][infront][data].object_shgrp = NULL;
+        wpd->prepass[transp][infront][data].object_chunk = -1;
 
         sh = workbench_shader_transparent_get(wpd, data);
 
@@ -468,6 +468,10 @@ DRWCallBuffer *DRW_shgroup_call_buffer_instance(DRWShadingGroup *shgroup,
 
 void DRW_buffer_add_entry_struct(DRWCallBuffer *callbuf, const void *data);
 void DRW_buffer_add_entry_array(DRWCallBuffer *callbuf, const void *attr[], uint attr_len);
+uint DRW_buffer_len_get(const DRWCallBuffer *callbuf);
+uint DRW_buffer_entry_size_get(const DRWCallBuffer *callbuf);
+void DRW_buffer_entries_read(const DRWCallBuffer *callbuf, uint start, uint len, void *r_data);
+void DRW_buffer_add_entries(DRWCallBuffer *callbuf, const void *data, uint len);
 
 #define DRW_buffer_add_entry(buffer, ...) \
   do { \
@@ -28,6 +28,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_pointcloud_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_volume_types.h"
 
 #include "UI_resources.h"
@@ -2860,9 +2861,53 @@ GPUBatch *DRW_cache_mesh_edge_detection_get(Object *ob, bool *r_is_manifold)
   return DRW_mesh_batch_cache_get_edge_detection(ob->data, r_is_manifold);
 }
 
+/* Diameter in pixels of the bounding sphere of the object in the default view. */
+static float drw_object_screen_size_get(Object *ob)
+{
+  const BoundBox *bb = BKE_object_boundbox_get(ob);
+  if (bb == NULL) {
+    return FLT_MAX;
+  }
+  float center[3], corner[3];
+  mid_v3_v3v3(center, bb->vec[0], bb->vec[6]);
+  mul_v3_m4v3(corner, ob->obmat, bb->vec[0]);
+  mul_m4_v3(ob->obmat, center);
+  const float radius = len_v3v3(center, corner);
+
+  float persmat[4][4], winmat[4][4];
+  DRW_view_persmat_get(NULL, persmat, false);
+  DRW_view_winmat_get(NULL, winmat, false);
+  float w = 1.0f;
+  if (DRW_view_is_persp_get(NULL)) {
+    w = mul_project_m4_v3_zfac(persmat, center);
+    if (w <= radius) {
+      /* The view is inside or too close to the object. */
+      return FLT_MAX;
+    }
+  }
+  return radius * winmat[1][1] / w * DRW_viewport_size_get()[1];
+}
+
+static bool drw_mesh_use_lod(Object *ob)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_viewport_mesh_lod)) {
+    return false;
+  }
+  if (DRW_state_is_image_render() || DRW_state_is_select() || DRW_state_is_depth()) {
+    return false;
+  }
+  if (DRW_view_default_get() == NULL || DRW_object_is_in_edit_mode(ob)) {
+    return false;
+  }
+  return true;
+}
+
 GPUBatch *DRW_cache_mesh_surface_get(Object *ob)
 {
   BLI_assert(ob->type == OB_MESH);
+  if (drw_mesh_use_lod(ob)) {
+    return DRW_mesh_batch_cache_get_surface_lod(ob->data, drw_object_screen_size_get(ob));
+  }
   return DRW_mesh_batch_cache_get_surface(ob->data);
 }
 
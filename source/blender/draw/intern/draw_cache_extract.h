@@ -101,6 +101,18 @@ BLI_INLINE int mesh_render_mat_len_get(const Mesh *me)
   return MAX2(1, me->totcol);
 }
 
+/* Meshes with fewer triangles are always drawn at full resolution. */
+#define MESH_LOD_MIN_TRI_LEN 4096
+
+/**
+ * Number of cells per axis of the grid the vertices of the LOD surface are clustered in.
+ * A surface goes through about N^2 cells of a N^3 grid, aim for one vertex out of 64.
+ */
+BLI_INLINE int mesh_render_lod_grid_size_get(const int vert_len)
+{
+  return MAX2(4, MIN2((int)sqrtf(vert_len / 64.0f), 256));
+}
+
 typedef struct MeshBufferList {
   /* Every VBO below contains at least enough
    * data for every loops in the mesh (except fdots and skin roots).
@@ -139,6 +151,7 @@ typedef struct MeshBufferList {
   struct {
     /* Indices to vloops. */
     GPUIndexBuf *tris;        /* Ordered per material. */
+    GPUIndexBuf *tris_lod;    /* Simplified triangles, single material. */
     GPUIndexBuf *lines;       /* Loose edges last. */
     GPUIndexBuf *lines_loose; /* sub buffer of `lines` only containing the loose edges. */
     GPUIndexBuf *points;
@@ -157,6 +170,7 @@ typedef struct MeshBufferList {
 typedef struct MeshBatchList {
   /* Surfaces / Render */
   GPUBatch *surface;
+  GPUBatch *surface_lod;
   GPUBatch *surface_weights;
   /* Edit mode */
   GPUBatch *edit_triangles;
@@ -198,6 +212,7 @@ typedef struct MeshBatchList {
 
 typedef enum DRWBatchFlag {
   MBC_SURFACE = (1u << MBC_BATCH_INDEX(surface)),
+  MBC_SURFACE_LOD = (1u << MBC_BATCH_INDEX(surface_lod)),
   MBC_SURFACE_WEIGHTS = (1u << MBC_BATCH_INDEX(surface_weights)),
   MBC_EDIT_TRIANGLES = (1u << MBC_BATCH_INDEX(edit_triangles)),
   MBC_EDIT_VERTICES = (1u << MBC_BATCH_INDEX(edit_vertices)),
@@ -41,6 +41,7 @@
 #include "GPU_capabilities.h"
 
 #include "draw_cache_extract.h"
+#include "draw_cache_impl.h"
 #include "draw_cache_inline.h"
 
 #include "mesh_extractors/extract_mesh.h"
@@ -612,6 +613,7 @@ static void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   const bool do_hq_normals = (scene->r.perf_flag & SCE_PERF_HQ_NORMALS) != 0 ||
                              GPU_use_hq_normals_workaround();
   const bool override_single_mat = mesh_render_mat_len_get(me) <= 1;
+  const bool do_gpu_extraction = DRW_mesh_extract_gpu_support();
 
   /* Create an array containing all the extractors that needs to be executed. */
   ExtractorRunDatas extractors;
@@ -622,7 +624,7 @@ static void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   do { \
     if (DRW_##type##_requested(mbuflist->type.name)) { \
       const MeshExtract *extractor = mesh_extract_override_get( \
-          &extract_##name, do_hq_normals, override_single_mat); \
+          &extract_##name, do_hq_normals, override_single_mat, do_gpu_extraction); \
       extractors.append(extractor); \
     } \
   } while (0)
@@ -652,6 +654,7 @@ static void mesh_buffer_cache_create_requested(struct TaskGraph *task_graph,
   EXTRACT_ADD_REQUESTED(vbo, skin_roots);
 
   EXTRACT_ADD_REQUESTED(ibo, tris);
+  EXTRACT_ADD_REQUESTED(ibo, tris_lod);
   if (DRW_ibo_requested(mbuflist->ibo.lines_loose)) {
     /* `ibo.lines_loose` require the `ibo.lines` buffer. */
     if (mbuflist->ibo.lines == nullptr) {
@@ -170,12 +170,18 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
                                            const struct Scene *scene,
                                            const bool is_paint_mode,
                                            const bool use_hide);
+/* Extraction of mesh buffers with compute shaders, see `extract_mesh_vbo_pos_nor.cc`. */
+bool DRW_mesh_extract_gpu_support(void);
+/* Run the compute shaders queued by the extraction, must be called after the extraction tasks
+ * finished, from the thread owning the GPU context. */
+void DRW_mesh_extract_gpu_flush(void);
 
 struct GPUBatch *DRW_mesh_batch_cache_get_all_verts(struct Mesh *me);
 struct GPUBatch *DRW_mesh_batch_cache_get_all_edges(struct Mesh *me);
 struct GPUBatch *DRW_mesh_batch_cache_get_loose_edges(struct Mesh *me);
 struct GPUBatch *DRW_mesh_batch_cache_get_edge_detection(struct Mesh *me, bool *r_is_manifold);
 struct GPUBatch *DRW_mesh_batch_cache_get_surface(struct Mesh *me);
+struct GPUBatch *DRW_mesh_batch_cache_get_surface_lod(struct Mesh *me, const float screen_size);
 struct GPUBatch *DRW_mesh_batch_cache_get_surface_edges(struct Mesh *me);
 struct GPUBatch **DRW_mesh_batch_cache_get_surface_shaded(struct Mesh *me,
                                                           struct GPUMaterial **gpumat_array,
@@ -40,6 +40,7 @@
 
 #include "BLI_hash.h"
 #include "BLI_polyfill_2d.h"
+#include "BLI_task.h"
 
 #include "draw_cache.h"
 #include "draw_cache_impl.h"
@@ -255,6 +256,9 @@ typedef struct gpIterData {
   gpStrokeVert *verts;
   gpColorVert *cols;
   GPUIndexBufBuilder ibo;
+  /** Visible strokes, gathered so their vertices can be written in parallel. */
+  bGPDstroke **strokes;
+  int stroke_len;
   int vert_len;
   int tri_len;
   int curve_len;
@@ -378,12 +382,21 @@ static void gpencil_stroke_iter_cb(bGPDlayer *UNUSED(gpl),
                                    void *thunk)
 {
   gpIterData *iter = (gpIterData *)thunk;
-  gpencil_buffer_add_stroke(iter->verts, iter->cols, gps);
+  /* Only gather the stroke here, vertices are written in #gpencil_stroke_vert_fill_cb. */
+  iter->strokes[iter->stroke_len++] = gps;
   if (gps->tot_triangles > 0) {
     gpencil_buffer_add_fill(&iter->ibo, gps);
   }
 }
 
+static void gpencil_stroke_vert_fill_cb(void *__restrict userdata,
+                                        const int i,
+                                        const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  gpIterData *iter = (gpIterData *)userdata;
+  gpencil_buffer_add_stroke(iter->verts, iter->cols, iter->strokes[i]);
+}
+
 static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
                                           bGPDframe *UNUSED(gpf),
                                           bGPDstroke *gps,
@@ -396,6 +409,7 @@ static void gpencil_object_verts_count_cb(bGPDlayer *UNUSED(gpl),
   gps->runtime.fill_start = iter->tri_len;
   iter->vert_len += gps->totpoints + 2 + gpencil_stroke_is_cyclic(gps);
   iter->tri_len += gps->tot_triangles;
+  iter->stroke_len++;
 }
 
 static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfra)
@@ -418,6 +432,8 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
         .gpd = gpd,
         .verts = NULL,
         .ibo = {0},
+        .strokes = NULL,
+        .stroke_len = 0,
         .vert_len = 1, /* Start at 1 for the gl_InstanceID trick to work (see vert shader). */
         .tri_len = 0,
         .curve_len = 0,
@@ -438,9 +454,23 @@ static void gpencil_batches_ensure(Object *ob, GpencilBatchCache *cache, int cfr
     /* Create IBO. */
     GPU_indexbuf_init(&iter.ibo, GPU_PRIM_TRIS, iter.tri_len, iter.vert_len);
 
-    /* Fill buffers with data. */
+    iter.strokes = MEM_malloc_arrayN(max_ii(iter.stroke_len, 1), sizeof(*iter.strokes), __func__);
+    const int stroke_len = iter.stroke_len;
+    iter.stroke_len = 0;
+
+    /* Fill the IBO and gather the strokes. */
     BKE_gpencil_visible_stroke_advanced_iter(
         NULL, ob, NULL, gpencil_stroke_iter_cb, &iter, do_onion, cfra);
+    BLI_assert(iter.stroke_len == stroke_len);
+    UNUSED_VARS_NDEBUG(stroke_len);
+
+    /* Every stroke writes its own range of vertices (see #gpencil_object_verts_count_cb),
+     * so the vertex buffers can be filled in parallel. */
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    settings.min_iter_per_thread = 64;
+    BLI_task_parallel_range(0, iter.stroke_len, &iter, gpencil_stroke_vert_fill_cb, &settings);
+    MEM_freeN(iter.strokes);
 
     /* Mark last 2 verts as invalid. */
     for (int i = 0; i < 2; i++) {
@@ -158,8 +158,9 @@ static const DRWBatchFlag g_buffer_deps[] = {
                                              wire_edges,
                                              wire_loops,
                                              sculpt_overlays) |
-                                  SURFACE_PER_MAT_FLAG,
-    [BUFFER_INDEX(vbo.lnor)] = BATCH_FLAG(surface, edit_lnor, wire_loops) | SURFACE_PER_MAT_FLAG,
+                                  BATCH_FLAG(surface_lod) | SURFACE_PER_MAT_FLAG,
+    [BUFFER_INDEX(vbo.lnor)] = BATCH_FLAG(surface, surface_lod, edit_lnor, wire_loops) |
+                               SURFACE_PER_MAT_FLAG,
     [BUFFER_INDEX(vbo.edge_fac)] = BATCH_FLAG(wire_edges),
     [BUFFER_INDEX(vbo.weights)] = BATCH_FLAG(surface_weights),
     [BUFFER_INDEX(vbo.uv)] = BATCH_FLAG(surface,
@@ -200,6 +201,7 @@ static const DRWBatchFlag g_buffer_deps[] = {
                                           edit_mesh_analysis,
                                           edit_selection_faces,
                                           sculpt_overlays),
+    [BUFFER_INDEX(ibo.tris_lod)] = BATCH_FLAG(surface_lod),
     [BUFFER_INDEX(ibo.lines)] = BATCH_FLAG(
         edit_edges, edit_selection_edges, all_edges, wire_edges),
     [BUFFER_INDEX(ibo.lines_loose)] = BATCH_FLAG(loose_edges),
@@ -821,6 +823,41 @@ void DRW_mesh_batch_cache_dirty_tag(Mesh *me, eMeshBatchDirtyMode mode)
     case BKE_MESH_BATCH_DIRTY_ALL:
       cache->is_dirty = true;
       break;
+    case BKE_MESH_BATCH_DIRTY_DEFORM:
+      /* Only discard the buffers depending on vertex positions. The edit-mesh triangulation
+       * can change when moving vertices, so the triangle indices are discarded too. */
+      FOREACH_MESH_BUFFER_CACHE (cache, mbc) {
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.pos_nor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.lnor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.tan);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.orco);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edge_fac);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.mesh_analysis);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_pos);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.fdots_nor);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_area);
+        GPU_VERTBUF_DISCARD_SAFE(mbc->buff.vbo.edituv_stretch_angle);
+        GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris);
+        GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.tris_lod);
+        GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.lines_adjacency);
+        GPU_INDEXBUF_DISCARD_SAFE(mbc->buff.ibo.edituv_tris);
+      }
+      batch_map = BATCH_MAP(vbo.pos_nor,
+                            vbo.lnor,
+                            vbo.tan,
+                            vbo.orco,
+                            vbo.edge_fac,
+                            vbo.mesh_analysis,
+                            vbo.fdots_pos,
+                            vbo.fdots_nor,
+                            vbo.edituv_stretch_area,
+                            vbo.edituv_stretch_angle);
+      batch_map |= BATCH_MAP(ibo.tris, ibo.tris_lod, ibo.lines_adjacency, ibo.edituv_tris);
+      mesh_batch_cache_discard_batch(cache, batch_map);
+
+      cache->tot_area = 0.0f;
+      cache->tot_uv_area = 0.0f;
+      break;
     case BKE_MESH_BATCH_DIRTY_SHADING:
       mesh_batch_cache_discard_shaded_tri(cache);
       mesh_batch_cache_discard_uvedit(cache);
@@ -966,6 +1003,24 @@ GPUBatch *DRW_mesh_batch_cache_get_surface(Mesh *me)
   return cache->batch.surface;
 }
 
+/**
+ * Return the simplified surface if the mesh is heavy enough and is displayed small enough for
+ * the simplification not to be noticeable, or the regular surface otherwise.
+ * \param screen_size: Diameter of the mesh on screen in pixels.
+ */
+GPUBatch *DRW_mesh_batch_cache_get_surface_lod(Mesh *me, const float screen_size)
+{
+  /* Don't let the clusters cover more than two pixels. */
+  const int grid_size = mesh_render_lod_grid_size_get(me->totvert);
+  if (poly_to_tri_count(me->totpoly, me->totloop) < MESH_LOD_MIN_TRI_LEN ||
+      screen_size > grid_size * 2.0f) {
+    return DRW_mesh_batch_cache_get_surface(me);
+  }
+  MeshBatchCache *cache = mesh_batch_cache_get(me);
+  mesh_batch_cache_add_request(cache, MBC_SURFACE_LOD);
+  return DRW_batch_request(&cache->batch.surface_lod);
+}
+
 GPUBatch *DRW_mesh_batch_cache_get_loose_edges(Mesh *me)
 {
   MeshBatchCache *cache = mesh_batch_cache_get(me);
@@ -1519,6 +1574,12 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
       DRW_vbo_request(cache->batch.surface, &mbuflist->vbo.vcol);
     }
   }
+  MDEPS_ASSERT(surface_lod, ibo.tris_lod, vbo.lnor, vbo.pos_nor);
+  if (DRW_batch_requested(cache->batch.surface_lod, GPU_PRIM_TRIS)) {
+    DRW_ibo_request(cache->batch.surface_lod, &mbuflist->ibo.tris_lod);
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.lnor);
+    DRW_vbo_request(cache->batch.surface_lod, &mbuflist->vbo.pos_nor);
+  }
   MDEPS_ASSERT(all_verts, vbo.pos_nor);
   if (DRW_batch_requested(cache->batch.all_verts, GPU_PRIM_POINTS)) {
     DRW_vbo_request(cache->batch.all_verts, &mbuflist->vbo.pos_nor);
@@ -1753,6 +1814,7 @@ void DRW_mesh_batch_cache_create_requested(struct TaskGraph *task_graph,
   MDEPS_ASSERT_MAP(vbo.fdots_edituv_data);
 
   MDEPS_ASSERT_MAP(ibo.tris);
+  MDEPS_ASSERT_MAP(ibo.tris_lod);
   MDEPS_ASSERT_MAP(ibo.lines);
   MDEPS_ASSERT_MAP(ibo.lines_loose);
   MDEPS_ASSERT_MAP(ibo.lines_adjacency);
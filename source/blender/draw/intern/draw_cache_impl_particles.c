@@ -86,6 +86,14 @@ typedef struct ParticleBatchCache {
   GPUBatch *edit_tip_points;
   int edit_tip_point_len;
 
+  /**
+   * Refined strands buffers and index buffers of the hair cache before it was invalidated.
+   * They only depend on the number of strands, so they are reused if it didn't change, which
+   * is the case when the hair is only deformed.
+   */
+  ParticleHairFinalCache retained_final[MAX_HAIR_SUBDIV];
+  int retained_strands_len;
+
   /* Settings to determine if cache is invalid. */
   bool is_dirty;
   bool edit_is_weight;
@@ -153,8 +161,22 @@ static void particle_batch_cache_init(ParticleSystem *psys)
 static ParticleBatchCache *particle_batch_cache_get(ParticleSystem *psys)
 {
   if (!particle_batch_cache_valid(psys)) {
+    ParticleBatchCache *cache = psys->batch_cache;
+    ParticleHairFinalCache final[MAX_HAIR_SUBDIV] = {{NULL}};
+    int strands_len = 0;
+    if (cache != NULL && cache->hair.proc_point_buf != NULL) {
+      /* Take the final buffers out of the cache so they survive the clear. */
+      memcpy(final, cache->hair.final, sizeof(final));
+      memset(cache->hair.final, 0, sizeof(cache->hair.final));
+      strands_len = cache->hair.strands_len;
+    }
+
     particle_batch_cache_clear(psys);
     particle_batch_cache_init(psys);
+
+    cache = psys->batch_cache;
+    memcpy(cache->retained_final, final, sizeof(final));
+    cache->retained_strands_len = strands_len;
   }
   return psys->batch_cache;
 }
@@ -180,6 +202,15 @@ static void particle_batch_cache_clear_point(ParticlePointCache *point_cache)
   GPU_VERTBUF_DISCARD_SAFE(point_cache->pos);
 }
 
+static void particle_batch_cache_clear_hair_final(ParticleHairFinalCache *final)
+{
+  GPU_VERTBUF_DISCARD_SAFE(final->proc_buf);
+  DRW_TEXTURE_FREE_SAFE(final->proc_tex);
+  for (int j = 0; j < MAX_THICKRES; j++) {
+    GPU_BATCH_DISCARD_SAFE(final->proc_hairs[j]);
+  }
+}
+
 void particle_batch_cache_clear_hair(ParticleHairCache *hair_cache)
 {
   /* TODO: more granular update tagging. */
@@ -202,11 +233,7 @@ void particle_batch_cache_clear_hair(ParticleHairCache *hair_cache)
     DRW_TEXTURE_FREE_SAFE(hair_cache->col_tex[i]);
   }
   for (int i = 0; i < MAX_HAIR_SUBDIV; i++) {
-    GPU_VERTBUF_DISCARD_SAFE(hair_cache->final[i].proc_buf);
-    DRW_TEXTURE_FREE_SAFE(hair_cache->final[i].proc_tex);
-    for (int j = 0; j < MAX_THICKRES; j++) {
-      GPU_BATCH_DISCARD_SAFE(hair_cache->final[i].proc_hairs[j]);
-    }
+    particle_batch_cache_clear_hair_final(&hair_cache->final[i]);
   }
 
   /* "Normal" legacy hairs */
@@ -227,6 +254,10 @@ static void particle_batch_cache_clear(ParticleSystem *psys)
 
   particle_batch_cache_clear_hair(&cache->edit_hair);
 
+  for (int i = 0; i < MAX_HAIR_SUBDIV; i++) {
+    particle_batch_cache_clear_hair_final(&cache->retained_final[i]);
+  }
+
   GPU_BATCH_DISCARD_SAFE(cache->edit_inner_points);
   GPU_VERTBUF_DISCARD_SAFE(cache->edit_inner_pos);
   GPU_BATCH_DISCARD_SAFE(cache->edit_tip_points);
@@ -1711,6 +1742,16 @@ bool particles_ensure_procedural_data(Object *object,
         source.edit, source.psys, source.md, &cache->hair);
   }
 
+  /* Deformed hair: the strand count is the same, only the refinement needs to run again. */
+  ParticleHairFinalCache *retained = &cache->retained_final[subdiv];
+  if ((*r_hair_cache)->final[subdiv].proc_buf == NULL && retained->proc_buf != NULL &&
+      cache->retained_strands_len == (*r_hair_cache)->strands_len &&
+      retained->strands_res == (*r_hair_cache)->final[subdiv].strands_res) {
+    (*r_hair_cache)->final[subdiv] = *retained;
+    memset(retained, 0, sizeof(*retained));
+    need_ft_update = true;
+  }
+
   /* Refreshed only on subdiv count change. */
   if ((*r_hair_cache)->final[subdiv].proc_buf == NULL) {
     particle_batch_cache_ensure_procedural_final_points(&cache->hair, subdiv);
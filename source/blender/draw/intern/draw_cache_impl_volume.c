@@ -284,6 +284,53 @@ GPUBatch *DRW_volume_batch_cache_get_selection_surface(Volume *volume)
   return cache->selection_surface;
 }
 
+/* Maximum number of values uploaded for one grid, 256 MiB in half float. Larger grids display at
+ * a lower resolution instead of exhausting video memory. */
+#define VOLUME_GRID_TEXTURE_BUDGET (128 * 1024 * 1024)
+
+/* Halve the resolution of the grid along every axis, averaging the voxels. */
+static void volume_dense_grid_downsample(DenseFloatVolumeGrid *dense_grid)
+{
+  const int channels = dense_grid->channels;
+  const int *res = dense_grid->resolution;
+  int new_res[3];
+  for (int i = 0; i < 3; i++) {
+    new_res[i] = max_ii(1, (res[i] + 1) / 2);
+  }
+
+  const size_t new_len = (size_t)new_res[0] * (size_t)new_res[1] * (size_t)new_res[2];
+  float *voxels = MEM_malloc_arrayN(new_len, sizeof(float) * channels, __func__);
+
+  for (int z = 0; z < new_res[2]; z++) {
+    for (int y = 0; y < new_res[1]; y++) {
+      for (int x = 0; x < new_res[0]; x++) {
+        float *dst = &voxels[(((size_t)z * new_res[1] + y) * new_res[0] + x) * channels];
+        float sum[3] = {0.0f, 0.0f, 0.0f};
+        int count = 0;
+        for (int sz = z * 2; sz < min_ii(z * 2 + 2, res[2]); sz++) {
+          for (int sy = y * 2; sy < min_ii(y * 2 + 2, res[1]); sy++) {
+            for (int sx = x * 2; sx < min_ii(x * 2 + 2, res[0]); sx++) {
+              const float *src =
+                  &dense_grid->voxels[(((size_t)sz * res[1] + sy) * res[0] + sx) * channels];
+              for (int c = 0; c < channels; c++) {
+                sum[c] += src[c];
+              }
+              count++;
+            }
+          }
+        }
+        for (int c = 0; c < channels; c++) {
+          dst[c] = sum[c] / count;
+        }
+      }
+    }
+  }
+
+  MEM_freeN(dense_grid->voxels);
+  dense_grid->voxels = voxels;
+  copy_v3_v3_int(dense_grid->resolution, new_res);
+}
+
 static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
                                             const VolumeGrid *grid,
                                             VolumeBatchCache *cache)
@@ -322,6 +369,15 @@ static DRWVolumeGrid *volume_grid_cache_get(const Volume *volume,
     copy_m4_m4(cache_grid->texture_to_object, dense_grid.texture_to_object);
     invert_m4_m4(cache_grid->object_to_texture, dense_grid.texture_to_object);
 
+    /* The texture space matrices don't depend on the resolution. */
+    const int max_size = GPU_max_texture_size();
+    while ((size_t)dense_grid.resolution[0] * dense_grid.resolution[1] *
+                   dense_grid.resolution[2] * channels >
+               VOLUME_GRID_TEXTURE_BUDGET ||
+           max_iii(UNPACK3(dense_grid.resolution)) > max_size) {
+      volume_dense_grid_downsample(&dense_grid);
+    }
+
     /* Create GPU texture. */
     eGPUTextureFormat format = (channels == 3) ? GPU_RGB16F : GPU_R16F;
     cache_grid->texture = GPU_texture_create_3d("volume_grid",
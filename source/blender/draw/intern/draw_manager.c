@@ -29,6 +29,7 @@
 #include "BLI_string.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
+#include "BLI_trace.h"
 
 #include "BLF_api.h"
 
@@ -176,6 +177,7 @@ static void drw_task_graph_deinit(void)
   BLI_gset_free(DST.delayed_extraction, (void (*)(void *key))drw_batch_cache_generate_requested);
   DST.delayed_extraction = NULL;
   BLI_task_graph_work_and_wait(DST.task_graph);
+  DRW_mesh_extract_gpu_flush();
 
   BLI_task_graph_free(DST.task_graph);
   DST.task_graph = NULL;
@@ -1637,6 +1639,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
 
   /* Cache filling */
   {
+    BLI_trace_event_begin("draw", "Cache Populate");
     PROFILE_START(stime);
     drw_engines_cache_init();
     drw_engines_world_update(scene);
@@ -1663,13 +1666,19 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
     drw_duplidata_free();
     drw_engines_cache_finish();
 
+    PROFILE_START(etime);
     drw_task_graph_deinit();
+#ifdef USE_PROFILE
+    double *extraction_time = DRW_view_data_extraction_time_get(DST.view_data_active);
+    PROFILE_END_UPDATE(*extraction_time, etime);
+#endif
     DRW_render_instance_buffer_finish();
 
 #ifdef USE_PROFILE
     double *cache_time = DRW_view_data_cache_time_get(DST.view_data_active);
     PROFILE_END_UPDATE(*cache_time, stime);
 #endif
+    BLI_trace_event_end();
   }
 
   DRW_stats_begin();
@@ -1677,6 +1686,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   GPU_framebuffer_bind(DST.default_framebuffer);
 
   /* Start Drawing */
+  BLI_trace_event_begin("draw", "Draw Scene");
   DRW_state_reset();
 
   GPU_framebuffer_bind(DST.default_framebuffer);
@@ -1694,6 +1704,7 @@ void DRW_draw_render_loop_ex(struct Depsgraph *depsgraph,
   DRW_stats_reset();
 
   DRW_draw_callbacks_post_scene();
+  BLI_trace_event_end();
 
   if (WM_draw_region_get_bound_viewport(region)) {
     /* Don't unbind the frame-buffer yet in this case and let
@@ -2662,6 +2673,7 @@ void DRW_draw_select_id(Depsgraph *depsgraph, ARegion *region, View3D *v3d, cons
     sel_ctx->is_dirty = true;
     sel_ctx->objects_drawn_len = 0;
     sel_ctx->index_drawn_len = 1;
+    MEM_SAFE_FREE(sel_ctx->buffer_cache);
     return;
   }
 
@@ -2777,6 +2789,7 @@ void DRW_draw_depth_object(
       DRW_mesh_batch_cache_create_requested(task_graph, object, me, scene, false, true);
       BLI_task_graph_work_and_wait(task_graph);
       BLI_task_graph_free(task_graph);
+      DRW_mesh_extract_gpu_flush();
 
       const eGPUShaderConfig sh_cfg = world_clip_planes ? GPU_SHADER_CFG_CLIPPED :
                                                           GPU_SHADER_CFG_DEFAULT;
@@ -41,6 +41,7 @@
 #include "BLI_listbase.h"
 #include "BLI_memblock.h"
 #include "BLI_mempool.h"
+#include "BLI_task.h"
 
 #ifdef DRW_DEBUG_CULLING
 #  include "BLI_math_bits.h"
@@ -87,6 +88,21 @@ static void draw_call_sort(DRWCommand *array, DRWCommand *array_tmp, int array_l
   memcpy(array, array_tmp, sizeof(*array) * array_len);
 }
 
+static void draw_call_chunk_sort_fn(void *__restrict userdata,
+                                    const int index,
+                                    const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DRWCommandChunk *chunk = ((DRWCommandChunk **)userdata)[index];
+  /* We can only sort chunks that contain #DRWCommandDraw only. */
+  for (int i = 0; i < ARRAY_SIZE(chunk->command_type); i++) {
+    if (chunk->command_type[i] != 0) {
+      return;
+    }
+  }
+  DRWCommand commands_tmp[ARRAY_SIZE(chunk->commands)];
+  draw_call_sort(chunk->commands, commands_tmp, chunk->command_used);
+}
+
 void drw_resource_buffer_finish(DRWData *vmempool)
 {
   int chunk_id = DRW_handle_chunk_get(&DST.resource_handle);
@@ -131,24 +147,30 @@ void drw_resource_buffer_finish(DRWData *vmempool)
 
   DRW_uniform_attrs_pool_flush_all(vmempool->obattrs_ubo_pool);
 
-  /* Aligned alloc to avoid unaligned memcpy. */
-  DRWCommandChunk *chunk_tmp = MEM_mallocN_aligned(sizeof(DRWCommandChunk), 16, "tmp call chunk");
-  DRWCommandChunk *chunk;
+  /* Command chunks are sorted independently of each others, split them over threads.
+   * Scenes with many objects fill thousands of chunks. */
+  int chunk_len = 0;
   BLI_memblock_iter iter;
   BLI_memblock_iternew(vmempool->commands, &iter);
-  while ((chunk = BLI_memblock_iterstep(&iter))) {
-    bool sortable = true;
-    /* We can only sort chunks that contain #DRWCommandDraw only. */
-    for (int i = 0; i < ARRAY_SIZE(chunk->command_type) && sortable; i++) {
-      if (chunk->command_type[i] != 0) {
-        sortable = false;
-      }
-    }
-    if (sortable) {
-      draw_call_sort(chunk->commands, chunk_tmp->commands, chunk->command_used);
-    }
+  while (BLI_memblock_iterstep(&iter)) {
+    chunk_len++;
+  }
+  if (chunk_len == 0) {
+    return;
   }
-  MEM_freeN(chunk_tmp);
+
+  DRWCommandChunk **chunks = MEM_mallocN(sizeof(*chunks) * chunk_len, __func__);
+  BLI_memblock_iternew(vmempool->commands, &iter);
+  for (int i = 0; i < chunk_len; i++) {
+    chunks[i] = BLI_memblock_iterstep(&iter);
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 32;
+  BLI_task_parallel_range(0, chunk_len, chunks, draw_call_chunk_sort_fn, &settings);
+
+  MEM_freeN(chunks);
 }
 
 /** \} */
@@ -1227,6 +1249,60 @@ void DRW_buffer_add_entry_array(DRWCallBuffer *callbuf, const void *attr[], uint
   callbuf->count++;
 }
 
+uint DRW_buffer_len_get(const DRWCallBuffer *callbuf)
+{
+  return callbuf->count;
+}
+
+uint DRW_buffer_entry_size_get(const DRWCallBuffer *callbuf)
+{
+  return GPU_vertbuf_get_format(callbuf->buf)->stride;
+}
+
+/**
+ * Copy \a len entries starting at \a start to \a r_data.
+ * Size of \a r_data must be at least `len * DRW_buffer_entry_size_get(callbuf)`.
+ */
+void DRW_buffer_entries_read(const DRWCallBuffer *callbuf, uint start, uint len, void *r_data)
+{
+  BLI_assert(start + len <= callbuf->count);
+  const uint stride = DRW_buffer_entry_size_get(callbuf);
+  const char *data = GPU_vertbuf_get_data(callbuf->buf);
+  memcpy(r_data, data + start * stride, len * stride);
+}
+
+/**
+ * Append \a len entries previously read using #DRW_buffer_entries_read.
+ * Avoids recomputing the attributes of entries that didn't change.
+ */
+void DRW_buffer_add_entries(DRWCallBuffer *callbuf, const void *data, uint len)
+{
+  GPUVertBuf *buf = callbuf->buf;
+  const uint stride = DRW_buffer_entry_size_get(callbuf);
+  const uint alloc_len = GPU_vertbuf_get_vertex_alloc(buf);
+  const bool resize = (callbuf->count + len > alloc_len);
+
+  if (UNLIKELY(resize)) {
+    /* Keep the allocation size a multiple of the chunk size. */
+    const uint new_len = (callbuf->count + len + DRW_BUFFER_VERTS_CHUNK - 1) /
+                         DRW_BUFFER_VERTS_CHUNK * DRW_BUFFER_VERTS_CHUNK;
+    GPU_vertbuf_data_resize(buf, new_len);
+    if (G.f & G_FLAG_PICKSEL) {
+      GPU_vertbuf_data_resize(callbuf->buf_select, new_len);
+    }
+  }
+
+  const char *entry = data;
+  for (uint i = 0; i < len; i++, entry += stride) {
+    GPU_vertbuf_vert_set(buf, callbuf->count + i, entry);
+    if (G.f & G_FLAG_PICKSEL) {
+      GPU_vertbuf_attr_set(callbuf->buf_select, 0, callbuf->count + i, &DST.select_id);
+    }
+  }
+
+  callbuf->count += len;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -45,7 +45,8 @@
 #define GPU_TIMER_FALLOFF 0.1
 
 typedef struct DRWTimer {
-  uint32_t query[2];
+  /* Index of the timer query inside each of the #DRWTimerPool.query_pools, -1 if none issued. */
+  int query[2];
   uint64_t time_average;
   char name[MAX_TIMER_NAME];
   int lvl;       /* Hierarchy level for nested timer. */
@@ -54,6 +55,9 @@ typedef struct DRWTimer {
 
 static struct DRWTimerPool {
   DRWTimer *timers;
+  /* Queries of a frame are read at the end of the next one, avoiding to wait for the GPU. */
+  GPUTimerPool *query_pools[2];
+  int query_pool_index; /* Pool receiving the queries of the current frame. */
   int chunk_count;     /* Number of chunk allocated. */
   int timer_count;     /* chunk_count * CHUNK_SIZE */
   int timer_increment; /* Keep track of where we are in the stack. */
@@ -65,10 +69,10 @@ static struct DRWTimerPool {
 void DRW_stats_free(void)
 {
   if (DTP.timers != NULL) {
-    // for (int i = 0; i < DTP.timer_count; i++) {
-    // DRWTimer *timer = &DTP.timers[i];
-    // glDeleteQueries(2, timer->query);
-    // }
+    for (int i = 0; i < 2; i++) {
+      GPU_timer_pool_free(DTP.query_pools[i]);
+      DTP.query_pools[i] = NULL;
+    }
     MEM_freeN(DTP.timers);
     DTP.timers = NULL;
   }
@@ -84,11 +88,22 @@ void DRW_stats_begin(void)
     DTP.chunk_count = 1;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = MEM_callocN(sizeof(DRWTimer) * DTP.timer_count, "DRWTimer stack");
+    for (int i = 0; i < DTP.timer_count; i++) {
+      DTP.timers[i].query[0] = DTP.timers[i].query[1] = -1;
+    }
+    for (int i = 0; i < 2; i++) {
+      DTP.query_pools[i] = GPU_timer_pool_create();
+    }
+    DTP.query_pool_index = 0;
   }
   else if (!DTP.is_recording && DTP.timers != NULL) {
     DRW_stats_free();
   }
 
+  if (DTP.is_recording) {
+    GPU_timer_pool_reset(DTP.query_pools[DTP.query_pool_index]);
+  }
+
   DTP.is_querying = false;
   DTP.timer_increment = 0;
   DTP.end_increment = 0;
@@ -101,6 +116,9 @@ static DRWTimer *drw_stats_timer_get(void)
     DTP.chunk_count++;
     DTP.timer_count = DTP.chunk_count * MIM_RANGE_LEN;
     DTP.timers = MEM_recallocN(DTP.timers, sizeof(DRWTimer) * DTP.timer_count);
+    for (int i = DTP.timer_increment; i < DTP.timer_count; i++) {
+      DTP.timers[i].query[0] = DTP.timers[i].query[1] = -1;
+    }
   }
 
   return &DTP.timers[DTP.timer_increment++];
@@ -117,15 +135,13 @@ static void drw_stats_timer_start_ex(const char *name, const bool is_query)
     /* Queries cannot be nested or interleaved. */
     BLI_assert(!DTP.is_querying);
     if (timer->is_query) {
-      if (timer->query[0] == 0) {
-        // glGenQueries(1, timer->query);
-      }
-
-      // glFinish();
-      /* Issue query for the next frame */
-      // glBeginQuery(GL_TIME_ELAPSED, timer->query[0]);
+      const int pool_index = DTP.query_pool_index;
+      timer->query[pool_index] = GPU_timer_begin(DTP.query_pools[pool_index]);
       DTP.is_querying = true;
     }
+    else {
+      timer->query[DTP.query_pool_index] = -1;
+    }
   }
 }
 
@@ -160,7 +176,7 @@ void DRW_stats_query_end(void)
   if (DTP.is_recording) {
     DTP.end_increment++;
     BLI_assert(DTP.is_querying);
-    // glEndQuery(GL_TIME_ELAPSED);
+    GPU_timer_end(DTP.query_pools[DTP.query_pool_index]);
     DTP.is_querying = false;
   }
 }
@@ -174,26 +190,28 @@ void DRW_stats_reset(void)
 
   if (DTP.is_recording) {
     uint64_t lvl_time[MAX_NESTED_TIMER] = {0};
+    /* Read the queries of the previous frame, the GPU should be done with them by now. */
+    const int prev_pool_index = !DTP.query_pool_index;
+    GPUTimerPool *prev_pool = DTP.query_pools[prev_pool_index];
+    const int prev_pool_len = GPU_timer_pool_len(prev_pool);
 
-    /* Swap queries for the next frame and sum up each lvl time. */
+    /* Sum up each lvl time. */
     for (int i = DTP.timer_increment - 1; i >= 0; i--) {
       DRWTimer *timer = &DTP.timers[i];
-      SWAP(uint32_t, timer->query[0], timer->query[1]);
 
       BLI_assert(timer->lvl < MAX_NESTED_TIMER);
 
       if (timer->is_query) {
-        uint64_t time = 0;
-        if (timer->query[0] != 0) {
-          // glGetQueryObjectui64v(timer->query[0], GL_QUERY_RESULT, &time);
-        }
-        else {
-          time = 1000000000; /* 1ms default */
+        const int query = timer->query[prev_pool_index];
+        uint64_t time;
+        /* Keep the previous average if the result is not available yet, not to stall. */
+        if (query != -1 && query < prev_pool_len &&
+            GPU_timer_result_get(prev_pool, query, &time)) {
+          timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
+                                time * GPU_TIMER_FALLOFF;
+          timer->time_average = MIN2(timer->time_average, 1000000000);
         }
-
-        timer->time_average = timer->time_average * (1.0 - GPU_TIMER_FALLOFF) +
-                              time * GPU_TIMER_FALLOFF;
-        timer->time_average = MIN2(timer->time_average, 1000000000);
+        timer->query[prev_pool_index] = -1;
       }
       else {
         timer->time_average = lvl_time[timer->lvl + 1];
@@ -203,6 +221,13 @@ void DRW_stats_reset(void)
       lvl_time[timer->lvl] += timer->time_average;
     }
 
+    /* Timers not used this frame must not be read at the end of the next one. */
+    for (int i = DTP.timer_increment; i < DTP.timer_count; i++) {
+      DTP.timers[i].query[DTP.query_pool_index] = -1;
+    }
+
+    /* Queries of the next frame go to the pool that has just been read. */
+    DTP.query_pool_index = prev_pool_index;
     DTP.is_recording = false;
   }
 }
@@ -300,6 +325,14 @@ void DRW_stats_draw(const rcti *rect)
   draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
   sprintf(time_to_txt, "%.2fms", *cache_time);
   draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
+  v++;
+
+  u = 0;
+  double *extraction_time = DRW_view_data_extraction_time_get(DST.view_data_active);
+  sprintf(col_label, "Extraction Wait");
+  draw_stat_5row(rect, u++, v, col_label, sizeof(col_label));
+  sprintf(time_to_txt, "%.2fms", *extraction_time);
+  draw_stat_5row(rect, u++, v, time_to_txt, sizeof(time_to_txt));
   v += 2;
 
   /* ------------------------------------------ */
@@ -61,6 +61,9 @@ extern char datatoc_common_fullscreen_vert_glsl[];
  *
  * \{ */
 
+/* Number of materials whose compilation is issued before waiting for the driver. */
+#define DRW_DEFERRED_SHADER_BATCH_SIZE 8
+
 typedef struct DRWDeferredShader {
   struct DRWDeferredShader *prev, *next;
 
@@ -72,7 +75,7 @@ typedef struct DRWShaderCompiler {
   ListBase queue_conclude; /* DRWDeferredShader */
   SpinLock list_lock;
 
-  DRWDeferredShader *mat_compiling;
+  ListBase queue_compiling; /* DRWDeferredShader */
   ThreadMutex compilation_lock;
 
   void *gl_context;
@@ -131,22 +134,32 @@ static void drw_deferred_shader_compilation_exec(
     }
 
     /* Pop tail because it will be less likely to lock the main thread
-     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()). */
-    comp->mat_compiling = BLI_poptail(&comp->queue);
-    if (comp->mat_compiling == NULL) {
+     * if all GPUMaterials are to be freed (see DRW_deferred_shader_remove()).
+     * Several materials are compiled at once so the driver can compile them in parallel. */
+    GPUMaterial *materials[DRW_DEFERRED_SHADER_BATCH_SIZE];
+    int materials_len = 0;
+    while (materials_len < DRW_DEFERRED_SHADER_BATCH_SIZE) {
+      DRWDeferredShader *dsh = BLI_poptail(&comp->queue);
+      if (dsh == NULL) {
+        break;
+      }
+      BLI_addtail(&comp->queue_compiling, dsh);
+      materials[materials_len++] = dsh->mat;
+    }
+    if (materials_len == 0) {
       /* No more Shader to compile. */
       BLI_spin_unlock(&comp->list_lock);
       break;
     }
 
-    comp->shaders_done++;
+    comp->shaders_done += materials_len;
     int total = BLI_listbase_count(&comp->queue) + comp->shaders_done;
 
     BLI_mutex_lock(&comp->compilation_lock);
     BLI_spin_unlock(&comp->list_lock);
 
     /* Do the compilation. */
-    GPU_material_compile(comp->mat_compiling->mat);
+    GPU_materials_compile(materials, materials_len);
 
     *progress = (float)comp->shaders_done / (float)total;
     *do_update = true;
@@ -155,13 +168,15 @@ static void drw_deferred_shader_compilation_exec(
     BLI_mutex_unlock(&comp->compilation_lock);
 
     BLI_spin_lock(&comp->list_lock);
-    if (GPU_material_status(comp->mat_compiling->mat) == GPU_MAT_QUEUED) {
-      BLI_addtail(&comp->queue_conclude, comp->mat_compiling);
-    }
-    else {
-      drw_deferred_shader_free(comp->mat_compiling);
+    DRWDeferredShader *dsh;
+    while ((dsh = BLI_pophead(&comp->queue_compiling))) {
+      if (GPU_material_status(dsh->mat) == GPU_MAT_QUEUED) {
+        BLI_addtail(&comp->queue_conclude, dsh);
+      }
+      else {
+        drw_deferred_shader_free(dsh);
+      }
     }
-    comp->mat_compiling = NULL;
     BLI_spin_unlock(&comp->list_lock);
   }
 
@@ -308,7 +323,7 @@ void DRW_deferred_shader_remove(GPUMaterial *mat)
         }
 
         /* Wait for compilation to finish */
-        if ((comp->mat_compiling != NULL) && (comp->mat_compiling->mat == mat)) {
+        if (BLI_findptr(&comp->queue_compiling, mat, offsetof(DRWDeferredShader, mat))) {
           BLI_mutex_lock(&comp->compilation_lock);
           BLI_mutex_unlock(&comp->compilation_lock);
         }
@@ -79,21 +79,26 @@ uint *DRW_select_buffer_read(struct Depsgraph *depsgraph,
       BLI_assert(region->winx == GPU_texture_width(DRW_engine_select_texture_get()) &&
                  region->winy == GPU_texture_height(DRW_engine_select_texture_get()));
 
-      /* Read the UI32 pixels. */
+      /* Read the whole texture once, so that queries on an unchanged drawing (for example
+       * every step of circle select) don't wait for the GPU. */
+      if (select_ctx->buffer_cache == NULL) {
+        select_ctx->buffer_cache = GPU_texture_read(
+            DRW_engine_select_texture_get(), GPU_DATA_UINT, 0);
+      }
+
+      /* Copy the UI32 pixels. */
       buf_len = BLI_rcti_size_x(rect) * BLI_rcti_size_y(rect);
       r_buf = MEM_mallocN(buf_len * sizeof(*r_buf), __func__);
 
-      GPUFrameBuffer *select_id_fb = DRW_engine_select_framebuffer_get();
-      GPU_framebuffer_bind(select_id_fb);
-      GPU_framebuffer_read_color(select_id_fb,
-                                 rect_clamp.xmin,
-                                 rect_clamp.ymin,
-                                 BLI_rcti_size_x(&rect_clamp),
-                                 BLI_rcti_size_y(&rect_clamp),
-                                 1,
-                                 0,
-                                 GPU_DATA_UINT,
-                                 r_buf);
+      const int rect_clamp_len_x = BLI_rcti_size_x(&rect_clamp);
+      const uint *cache_row = select_ctx->buffer_cache + rect_clamp.ymin * region->winx +
+                              rect_clamp.xmin;
+      uint *buf_row = r_buf;
+      for (int y = rect_clamp.ymin; y < rect_clamp.ymax; y++) {
+        memcpy(buf_row, cache_row, sizeof(*r_buf) * rect_clamp_len_x);
+        cache_row += region->winx;
+        buf_row += rect_clamp_len_x;
+      }
 
       if (!BLI_rcti_compare(rect, &rect_clamp)) {
         /* The rect has been clamped so you need to realign the buffer and fill in the blanks */
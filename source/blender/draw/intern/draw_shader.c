@@ -35,10 +35,12 @@ extern char datatoc_common_hair_lib_glsl[];
 
 extern char datatoc_common_hair_refine_vert_glsl[];
 extern char datatoc_common_hair_refine_comp_glsl[];
+extern char datatoc_common_mesh_pos_nor_comp_glsl[];
 extern char datatoc_gpu_shader_3D_smooth_color_frag_glsl[];
 
 static struct {
   struct GPUShader *hair_refine_sh[PART_REFINE_MAX_SHADER];
+  struct GPUShader *mesh_pos_nor_extract_sh;
 } e_data = {{NULL}};
 
 /* -------------------------------------------------------------------- */
@@ -114,9 +116,25 @@ GPUShader *DRW_shader_hair_refine_get(ParticleRefineShader refinement,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Mesh extraction
+ * \{ */
+
+GPUShader *DRW_shader_mesh_pos_nor_extract_get(void)
+{
+  if (e_data.mesh_pos_nor_extract_sh == NULL) {
+    e_data.mesh_pos_nor_extract_sh = GPU_shader_create_compute(
+        datatoc_common_mesh_pos_nor_comp_glsl, NULL, NULL, __func__);
+  }
+  return e_data.mesh_pos_nor_extract_sh;
+}
+
+/** \} */
+
 void DRW_shaders_free(void)
 {
   for (int i = 0; i < PART_REFINE_MAX_SHADER; i++) {
     DRW_SHADER_FREE_SAFE(e_data.hair_refine_sh[i]);
   }
+  DRW_SHADER_FREE_SAFE(e_data.mesh_pos_nor_extract_sh);
 }
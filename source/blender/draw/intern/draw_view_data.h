@@ -112,6 +112,7 @@ void DRW_view_data_use_engine(DRWViewData *view_data, struct DrawEngineType *eng
 void DRW_view_data_reset(DRWViewData *view_data);
 void DRW_view_data_free_unused(DRWViewData *view_data);
 double *DRW_view_data_cache_time_get(DRWViewData *view_data);
+double *DRW_view_data_extraction_time_get(DRWViewData *view_data);
 DefaultFramebufferList *DRW_view_data_default_framebuffer_list_get(DRWViewData *view_data);
 DefaultTextureList *DRW_view_data_default_texture_list_get(DRWViewData *view_data);
 
@@ -84,13 +84,26 @@ static const MeshExtract *mesh_extract_override_single_material(const MeshExtrac
   return extractor;
 }
 
+static const MeshExtract *mesh_extract_override_gpu(const MeshExtract *extractor)
+{
+  if (extractor == &extract_pos_nor) {
+    return &extract_pos_nor_gpu;
+  }
+  return extractor;
+}
+
 const MeshExtract *mesh_extract_override_get(const MeshExtract *extractor,
                                              const bool do_hq_normals,
-                                             const bool do_single_mat)
+                                             const bool do_single_mat,
+                                             const bool do_gpu_extraction)
 {
   if (do_hq_normals) {
     extractor = mesh_extract_override_hq_normals(extractor);
   }
+  else if (do_gpu_extraction) {
+    /* The GPU extractors only support low precision normals. */
+    extractor = mesh_extract_override_gpu(extractor);
+  }
 
   if (do_single_mat) {
     extractor = mesh_extract_override_single_material(extractor);
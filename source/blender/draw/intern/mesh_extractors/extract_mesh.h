@@ -97,7 +97,7 @@ typedef struct MeshRenderData {
   BMFace *efa_act;
   BMFace *efa_act_uv;
   /* Data created on-demand (usually not for #BMesh based data). */
-  MLoopTri *mlooptri;
+  const MLoopTri *mlooptri;
   float (*loop_normals)[3];
   float (*poly_normals)[3];
   int *lverts, *ledges;
@@ -274,7 +274,8 @@ void *mesh_extract_buffer_get(const MeshExtract *extractor, MeshBufferList *mbuf
 eMRIterType mesh_extract_iter_type(const MeshExtract *ext);
 const MeshExtract *mesh_extract_override_get(const MeshExtract *extractor,
                                              const bool do_hq_normals,
-                                             const bool do_single_mat);
+                                             const bool do_single_mat,
+                                             const bool do_gpu_extraction);
 void mesh_render_data_face_flag(const MeshRenderData *mr,
                                 const BMFace *efa,
                                 const int cd_ofs,
@@ -290,6 +291,7 @@ void mesh_render_data_loop_edge_flag(const MeshRenderData *mr,
 
 extern const MeshExtract extract_tris;
 extern const MeshExtract extract_tris_single_mat;
+extern const MeshExtract extract_tris_lod;
 extern const MeshExtract extract_lines;
 extern const MeshExtract extract_lines_with_lines_loose;
 extern const MeshExtract extract_lines_loose_only;
@@ -303,6 +305,7 @@ extern const MeshExtract extract_edituv_points;
 extern const MeshExtract extract_edituv_fdots;
 extern const MeshExtract extract_pos_nor;
 extern const MeshExtract extract_pos_nor_hq;
+extern const MeshExtract extract_pos_nor_gpu;
 extern const MeshExtract extract_lnor_hq;
 extern const MeshExtract extract_lnor;
 extern const MeshExtract extract_uv;
@@ -0,0 +1,186 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2021 by Blender Foundation.
+ * All rights reserved.
+ */
+
+/** \file
+ * \ingroup draw
+ */
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_map.hh"
+#include "BLI_math_vector.h"
+
+#include "extract_mesh.h"
+
+namespace blender::draw {
+
+/* ---------------------------------------------------------------------- */
+/** \name Extract Simplified Triangles Indices
+ *
+ * Vertices are clustered on a regular grid over the bounds of the mesh. Every loop is replaced
+ * by the first loop found in the same cell, and triangles that collapse are skipped.
+ * The indices still refer to the loops of the full resolution mesh, so the vertex buffers are
+ * shared with the regular surface.
+ * \{ */
+
+struct MeshExtract_TrisLOD_Data {
+  GPUIndexBufBuilder elb;
+  /* Loop used in place of each loop. */
+  int *loop_cluster;
+};
+
+static int lod_cell_index_get(const float co[3],
+                              const float min[3],
+                              const float cell_size_inv[3],
+                              const int grid_size)
+{
+  int cell[3];
+  for (int i = 0; i < 3; i++) {
+    cell[i] = min_ii((int)((co[i] - min[i]) * cell_size_inv[i]), grid_size - 1);
+  }
+  return (cell[2] * grid_size + cell[1]) * grid_size + cell[0];
+}
+
+static void extract_tris_lod_init(const MeshRenderData *mr,
+                                  struct MeshBatchCache *UNUSED(cache),
+                                  void *UNUSED(ibo),
+                                  void *tls_data)
+{
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(tls_data);
+  GPU_indexbuf_init(&data->elb, GPU_PRIM_TRIS, mr->tri_len, mr->loop_len);
+  data->loop_cluster = static_cast<int *>(
+      MEM_mallocN(sizeof(int) * mr->loop_len, "MeshExtract_TrisLOD_Data.loop_cluster"));
+
+  const int grid_size = mesh_render_lod_grid_size_get(mr->vert_len);
+
+  float min[3], max[3];
+  INIT_MINMAX(min, max);
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    BM_ITER_MESH (eve, &iter, mr->bm, BM_VERTS_OF_MESH) {
+      minmax_v3v3_v3(min, max, bm_vert_co_get(mr, eve));
+    }
+  }
+  else {
+    for (int v = 0; v < mr->vert_len; v++) {
+      minmax_v3v3_v3(min, max, mr->mvert[v].co);
+    }
+  }
+
+  float cell_size_inv[3];
+  for (int i = 0; i < 3; i++) {
+    const float size = max[i] - min[i];
+    cell_size_inv[i] = (size > 0.0f) ? grid_size / size : 0.0f;
+  }
+
+  Map<int, int> cell_loops;
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMFace *efa;
+    BM_ITER_MESH (efa, &iter, mr->bm, BM_FACES_OF_MESH) {
+      BMLoop *l_iter, *l_first;
+      l_iter = l_first = BM_FACE_FIRST_LOOP(efa);
+      do {
+        const int l_index = BM_elem_index_get(l_iter);
+        const int cell = lod_cell_index_get(
+            bm_vert_co_get(mr, l_iter->v), min, cell_size_inv, grid_size);
+        data->loop_cluster[l_index] = cell_loops.lookup_or_add(cell, l_index);
+      } while ((l_iter = l_iter->next) != l_first);
+    }
+  }
+  else {
+    for (int ml_index = 0; ml_index < mr->loop_len; ml_index++) {
+      const float *co = mr->mvert[mr->mloop[ml_index].v].co;
+      const int cell = lod_cell_index_get(co, min, cell_size_inv, grid_size);
+      data->loop_cluster[ml_index] = cell_loops.lookup_or_add(cell, ml_index);
+    }
+  }
+}
+
+BLI_INLINE void extract_tris_lod_add(MeshExtract_TrisLOD_Data *data, int l0, int l1, int l2)
+{
+  l0 = data->loop_cluster[l0];
+  l1 = data->loop_cluster[l1];
+  l2 = data->loop_cluster[l2];
+  if (l0 != l1 && l1 != l2 && l2 != l0) {
+    GPU_indexbuf_add_tri_verts(&data->elb, l0, l1, l2);
+  }
+}
+
+static void extract_tris_lod_iter_looptri_bm(const MeshRenderData *UNUSED(mr),
+                                             BMLoop **elt,
+                                             const int UNUSED(elt_index),
+                                             void *_data)
+{
+  if (!BM_elem_flag_test(elt[0]->f, BM_ELEM_HIDDEN)) {
+    extract_tris_lod_add(static_cast<MeshExtract_TrisLOD_Data *>(_data),
+                         BM_elem_index_get(elt[0]),
+                         BM_elem_index_get(elt[1]),
+                         BM_elem_index_get(elt[2]));
+  }
+}
+
+static void extract_tris_lod_iter_looptri_mesh(const MeshRenderData *mr,
+                                               const MLoopTri *mlt,
+                                               const int UNUSED(mlt_index),
+                                               void *_data)
+{
+  const MPoly *mp = &mr->mpoly[mlt->poly];
+  if (!(mr->use_hide && (mp->flag & ME_HIDE))) {
+    extract_tris_lod_add(static_cast<MeshExtract_TrisLOD_Data *>(_data),
+                         mlt->tri[0],
+                         mlt->tri[1],
+                         mlt->tri[2]);
+  }
+}
+
+static void extract_tris_lod_finish(const MeshRenderData *UNUSED(mr),
+                                    struct MeshBatchCache *UNUSED(cache),
+                                    void *buf,
+                                    void *_data)
+{
+  GPUIndexBuf *ibo = static_cast<GPUIndexBuf *>(buf);
+  MeshExtract_TrisLOD_Data *data = static_cast<MeshExtract_TrisLOD_Data *>(_data);
+  GPU_indexbuf_build_in_place(&data->elb, ibo);
+  MEM_freeN(data->loop_cluster);
+}
+
+constexpr MeshExtract create_extractor_tris_lod()
+{
+  MeshExtract extractor = {nullptr};
+  extractor.init = extract_tris_lod_init;
+  extractor.iter_looptri_bm = extract_tris_lod_iter_looptri_bm;
+  extractor.iter_looptri_mesh = extract_tris_lod_iter_looptri_mesh;
+  extractor.finish = extract_tris_lod_finish;
+  extractor.data_type = MR_DATA_LOOPTRI;
+  extractor.data_size = sizeof(MeshExtract_TrisLOD_Data);
+  /* Triangles are compacted, which needs them to be added in order. */
+  extractor.use_threading = false;
+  extractor.mesh_buffer_offset = offsetof(MeshBufferList, ibo.tris_lod);
+  return extractor;
+}
+
+/** \} */
+
+}  // namespace blender::draw
+
+extern "C" {
+const MeshExtract extract_tris_lod = blender::draw::create_extractor_tris_lod();
+}
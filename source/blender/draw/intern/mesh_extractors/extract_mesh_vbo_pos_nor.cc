@@ -21,10 +21,25 @@
  * \ingroup draw
  */
 
+#include <mutex>
+
 #include "MEM_guardedalloc.h"
 
+#include "BLI_vector.hh"
+
+#include "DNA_userdef_types.h"
+
+#include "GPU_capabilities.h"
+#include "GPU_compute.h"
+#include "GPU_shader.h"
+#include "GPU_state.h"
+
+#include "draw_cache_impl.h"
+
 #include "extract_mesh.h"
 
+#include "draw_shader.h"
+
 namespace blender::draw {
 
 /* ---------------------------------------------------------------------- */
@@ -407,9 +422,258 @@ constexpr MeshExtract create_extractor_pos_nor_hq()
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Extract Position and Vertex Normal on the GPU
+ *
+ * Only the positions and normals of the vertices are uploaded, together with the vertex index of
+ * every loop. A compute shader expands them into the device only `pos_nor` buffer. This avoids
+ * filling and uploading a position and normal per loop, which dominates the extraction of
+ * deforming meshes.
+ *
+ * Extraction runs in worker threads without a GPU context, so the compute dispatches are queued
+ * and run by #DRW_mesh_extract_gpu_flush once all extraction tasks are done.
+ * \{ */
+
+struct MeshExtract_PosNorGPU_Data {
+  GPUVertBuf *vert_vbo;
+  GPUVertBuf *loop_vbo;
+  uint32_t *loop_data;
+};
+
+/* Matches `local_size_x` of the compute shader. */
+#define POS_NOR_GPU_GROUP_SIZE 64
+
+struct PosNorGPUJob {
+  GPUVertBuf *vert_vbo;
+  GPUVertBuf *loop_vbo;
+  GPUVertBuf *pos_nor_vbo;
+};
+
+static std::mutex pos_nor_gpu_jobs_mutex;
+static Vector<PosNorGPUJob> pos_nor_gpu_jobs;
+
+/* The value of the normal `w` component is stored in the upper 2 bits, like in the packed
+ * normal. */
+BLI_INLINE uint32_t pos_nor_gpu_loop_pack(const int v_index, const int nor_w)
+{
+  return (uint32_t)v_index | ((uint32_t)nor_w << 30);
+}
+
+static void extract_pos_nor_gpu_init(const MeshRenderData *mr,
+                                     struct MeshBatchCache *UNUSED(cache),
+                                     void *buf,
+                                     void *tls_data)
+{
+  GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
+  static GPUVertFormat format = {0};
+  if (format.attr_len == 0) {
+    /* WARNING Adjust #PosNorLoop struct accordingly. */
+    GPU_vertformat_attr_add(&format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    GPU_vertformat_attr_add(&format, "nor", GPU_COMP_I10, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    GPU_vertformat_alias_add(&format, "vnor");
+  }
+  static GPUVertFormat loop_format = {0};
+  if (loop_format.attr_len == 0) {
+    GPU_vertformat_attr_add(&loop_format, "v", GPU_COMP_U32, 1, GPU_FETCH_INT);
+  }
+  GPU_vertbuf_init_with_format_ex(vbo, &format, GPU_USAGE_DEVICE_ONLY);
+  GPU_vertbuf_data_alloc(vbo, mr->loop_len + mr->loop_loose_len);
+
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(tls_data);
+  data->vert_vbo = GPU_vertbuf_create_with_format_ex(&format, GPU_USAGE_STREAM);
+  GPU_vertbuf_data_alloc(data->vert_vbo, max_ii(mr->vert_len, 1));
+  data->loop_vbo = GPU_vertbuf_create_with_format_ex(&loop_format, GPU_USAGE_STREAM);
+  GPU_vertbuf_data_alloc(data->loop_vbo, max_ii(mr->loop_len + mr->loop_loose_len, 1));
+  data->loop_data = static_cast<uint32_t *>(GPU_vertbuf_get_data(data->loop_vbo));
+
+  PosNorLoop *vert_data = static_cast<PosNorLoop *>(GPU_vertbuf_get_data(data->vert_vbo));
+  if (mr->extract_type == MR_EXTRACT_BMESH) {
+    BMIter iter;
+    BMVert *eve;
+    int v;
+    BM_ITER_MESH_INDEX (eve, &iter, mr->bm, BM_VERTS_OF_MESH, v) {
+      copy_v3_v3(vert_data[v].pos, bm_vert_co_get(mr, eve));
+      vert_data[v].nor = GPU_normal_convert_i10_v3(bm_vert_no_get(mr, eve));
+    }
+  }
+  else {
+    const MVert *mv = mr->mvert;
+    for (int v = 0; v < mr->vert_len; v++, mv++) {
+      copy_v3_v3(vert_data[v].pos, mv->co);
+      vert_data[v].nor = GPU_normal_convert_i10_s3(mv->no);
+    }
+  }
+}
+
+static void extract_pos_nor_gpu_iter_poly_bm(const MeshRenderData *UNUSED(mr),
+                                             const BMFace *f,
+                                             const int UNUSED(f_index),
+                                             void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  const int nor_w = BM_elem_flag_test(f, BM_ELEM_HIDDEN) ? -1 : 0;
+  BMLoop *l_iter, *l_first;
+  l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+  do {
+    const int l_index = BM_elem_index_get(l_iter);
+    data->loop_data[l_index] = pos_nor_gpu_loop_pack(BM_elem_index_get(l_iter->v), nor_w);
+  } while ((l_iter = l_iter->next) != l_first);
+}
+
+static void extract_pos_nor_gpu_iter_poly_mesh(const MeshRenderData *mr,
+                                               const MPoly *mp,
+                                               const int UNUSED(mp_index),
+                                               void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+
+  const MLoop *mloop = mr->mloop;
+  const int ml_index_end = mp->loopstart + mp->totloop;
+  for (int ml_index = mp->loopstart; ml_index < ml_index_end; ml_index += 1) {
+    const MLoop *ml = &mloop[ml_index];
+    const MVert *mv = &mr->mvert[ml->v];
+    int nor_w;
+    /* Flag for paint mode overlay. */
+    if (mp->flag & ME_HIDE || mv->flag & ME_HIDE ||
+        ((mr->extract_type == MR_EXTRACT_MAPPED) && (mr->v_origindex) &&
+         (mr->v_origindex[ml->v] == ORIGINDEX_NONE))) {
+      nor_w = -1;
+    }
+    else if (mv->flag & SELECT) {
+      nor_w = 1;
+    }
+    else {
+      nor_w = 0;
+    }
+    data->loop_data[ml_index] = pos_nor_gpu_loop_pack(ml->v, nor_w);
+  }
+}
+
+static void extract_pos_nor_gpu_iter_ledge_bm(const MeshRenderData *mr,
+                                              const BMEdge *eed,
+                                              const int ledge_index,
+                                              void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  const int l_index = mr->loop_len + ledge_index * 2;
+  data->loop_data[l_index] = pos_nor_gpu_loop_pack(BM_elem_index_get(eed->v1), 0);
+  data->loop_data[l_index + 1] = pos_nor_gpu_loop_pack(BM_elem_index_get(eed->v2), 0);
+}
+
+static void extract_pos_nor_gpu_iter_ledge_mesh(const MeshRenderData *mr,
+                                                const MEdge *med,
+                                                const int ledge_index,
+                                                void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  const int ml_index = mr->loop_len + ledge_index * 2;
+  data->loop_data[ml_index] = pos_nor_gpu_loop_pack(med->v1, 0);
+  data->loop_data[ml_index + 1] = pos_nor_gpu_loop_pack(med->v2, 0);
+}
+
+static void extract_pos_nor_gpu_iter_lvert_bm(const MeshRenderData *mr,
+                                              const BMVert *eve,
+                                              const int lvert_index,
+                                              void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  const int offset = mr->loop_len + (mr->edge_loose_len * 2);
+  data->loop_data[offset + lvert_index] = pos_nor_gpu_loop_pack(BM_elem_index_get(eve), 0);
+}
+
+static void extract_pos_nor_gpu_iter_lvert_mesh(const MeshRenderData *mr,
+                                                const MVert *UNUSED(mv),
+                                                const int lvert_index,
+                                                void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  const int offset = mr->loop_len + (mr->edge_loose_len * 2);
+  data->loop_data[offset + lvert_index] = pos_nor_gpu_loop_pack(mr->lverts[lvert_index], 0);
+}
+
+static void extract_pos_nor_gpu_finish(const MeshRenderData *UNUSED(mr),
+                                       struct MeshBatchCache *UNUSED(cache),
+                                       void *buf,
+                                       void *_data)
+{
+  MeshExtract_PosNorGPU_Data *data = static_cast<MeshExtract_PosNorGPU_Data *>(_data);
+  GPUVertBuf *vbo = static_cast<GPUVertBuf *>(buf);
+  std::lock_guard lock{pos_nor_gpu_jobs_mutex};
+  pos_nor_gpu_jobs.append({data->vert_vbo, data->loop_vbo, vbo});
+}
+
+constexpr MeshExtract create_extractor_pos_nor_gpu()
+{
+  MeshExtract extractor = {nullptr};
+  extractor.init = extract_pos_nor_gpu_init;
+  extractor.iter_poly_bm = extract_pos_nor_gpu_iter_poly_bm;
+  extractor.iter_poly_mesh = extract_pos_nor_gpu_iter_poly_mesh;
+  extractor.iter_ledge_bm = extract_pos_nor_gpu_iter_ledge_bm;
+  extractor.iter_ledge_mesh = extract_pos_nor_gpu_iter_ledge_mesh;
+  extractor.iter_lvert_bm = extract_pos_nor_gpu_iter_lvert_bm;
+  extractor.iter_lvert_mesh = extract_pos_nor_gpu_iter_lvert_mesh;
+  extractor.finish = extract_pos_nor_gpu_finish;
+  extractor.data_type = MR_DATA_NONE;
+  extractor.data_size = sizeof(MeshExtract_PosNorGPU_Data);
+  extractor.use_threading = true;
+  extractor.mesh_buffer_offset = offsetof(MeshBufferList, vbo.pos_nor);
+  return extractor;
+}
+
+static void pos_nor_gpu_jobs_run()
+{
+  std::lock_guard lock{pos_nor_gpu_jobs_mutex};
+  if (pos_nor_gpu_jobs.is_empty()) {
+    return;
+  }
+
+  GPUShader *shader = DRW_shader_mesh_pos_nor_extract_get();
+  GPU_shader_bind(shader);
+  const int vert_binding = GPU_shader_get_ssbo(shader, "vertPosNorBuffer");
+  const int loop_binding = GPU_shader_get_ssbo(shader, "loopVertBuffer");
+  const int pos_nor_binding = GPU_shader_get_ssbo(shader, "loopPosNorBuffer");
+  const int max_groups = GPU_max_work_group_count(0);
+
+  for (const PosNorGPUJob &job : pos_nor_gpu_jobs) {
+    const int loop_len = GPU_vertbuf_get_vertex_len(job.pos_nor_vbo);
+    if (loop_len > 0) {
+      GPU_vertbuf_bind_as_ssbo(job.vert_vbo, vert_binding);
+      GPU_vertbuf_bind_as_ssbo(job.loop_vbo, loop_binding);
+      GPU_vertbuf_bind_as_ssbo(job.pos_nor_vbo, pos_nor_binding);
+      GPU_shader_uniform_1i(shader, "loopLen", loop_len);
+
+      const int groups_len = divide_ceil_u(loop_len, POS_NOR_GPU_GROUP_SIZE);
+      for (int group_start = 0; group_start < groups_len; group_start += max_groups) {
+        GPU_shader_uniform_1i(shader, "loopStart", group_start * POS_NOR_GPU_GROUP_SIZE);
+        GPU_compute_dispatch(shader, min_ii(groups_len - group_start, max_groups), 1, 1);
+      }
+    }
+    GPU_vertbuf_discard(job.vert_vbo);
+    GPU_vertbuf_discard(job.loop_vbo);
+  }
+  pos_nor_gpu_jobs.clear();
+
+  GPU_shader_unbind();
+  /* The buffers are used as vertex attributes and as texture buffers (hair on meshes). */
+  GPU_memory_barrier(GPU_BARRIER_VERTEX_ATTRIB_ARRAY | GPU_BARRIER_TEXTURE_FETCH);
+}
+
+/** \} */
+
 }  // namespace blender::draw
 
 extern "C" {
 const MeshExtract extract_pos_nor = blender::draw::create_extractor_pos_nor();
 const MeshExtract extract_pos_nor_hq = blender::draw::create_extractor_pos_nor_hq();
+const MeshExtract extract_pos_nor_gpu = blender::draw::create_extractor_pos_nor_gpu();
+
+bool DRW_mesh_extract_gpu_support(void)
+{
+  return GPU_compute_shader_support() && USER_EXPERIMENTAL_TEST(&U, use_gpu_mesh_extraction);
+}
+
+void DRW_mesh_extract_gpu_flush(void)
+{
+  blender::draw::pos_nor_gpu_jobs_run();
+}
 }
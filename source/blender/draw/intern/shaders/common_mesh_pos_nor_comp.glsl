@@ -0,0 +1,43 @@
+/*
+ * Expand the positions and normals of mesh vertices to the loops of the `pos_nor` vertex buffer.
+ * Every element is a `vec3` position followed by a 10_10_10_2 packed normal, read and written as
+ * raw words so no conversion happens.
+ */
+
+layout(local_size_x = 64) in;
+
+layout(std430, binding = 0) readonly buffer vertPosNorBuffer
+{
+  uint vert_pos_nor[];
+};
+
+/* Vertex index in the lower 30 bits, the value of the normal `w` component in the upper 2 bits. */
+layout(std430, binding = 1) readonly buffer loopVertBuffer
+{
+  uint loop_vert[];
+};
+
+layout(std430, binding = 2) writeonly buffer loopPosNorBuffer
+{
+  uint loop_pos_nor[];
+};
+
+uniform int loopStart;
+uniform int loopLen;
+
+void main()
+{
+  uint loop = uint(loopStart) + gl_GlobalInvocationID.x;
+  if (loop >= uint(loopLen)) {
+    return;
+  }
+
+  uint packed_vert = loop_vert[loop];
+  uint vert = packed_vert & 0x3FFFFFFFu;
+
+  loop_pos_nor[loop * 4u + 0u] = vert_pos_nor[vert * 4u + 0u];
+  loop_pos_nor[loop * 4u + 1u] = vert_pos_nor[vert * 4u + 1u];
+  loop_pos_nor[loop * 4u + 2u] = vert_pos_nor[vert * 4u + 2u];
+  loop_pos_nor[loop * 4u + 3u] = (vert_pos_nor[vert * 4u + 3u] & 0x3FFFFFFFu) |
+                                 (packed_vert & 0xC0000000u);
+}
@@ -4,6 +4,7 @@
 
 #include "draw_testing.hh"
 
+#include "GPU_capabilities.h"
 #include "GPU_context.h"
 #include "GPU_index_buffer.h"
 #include "GPU_init_exit.h"
@@ -391,6 +392,12 @@ static void test_draw_glsl_shaders()
   test_draw_shaders(PART_REFINE_SHADER_COMPUTE);
 #endif
   test_draw_shaders(PART_REFINE_SHADER_TRANSFORM_FEEDBACK_WORKAROUND);
+
+  if (GPU_compute_shader_support()) {
+    DRW_shaders_free();
+    EXPECT_NE(DRW_shader_mesh_pos_nor_extract_get(), nullptr);
+    DRW_shaders_free();
+  }
 }
 DRAW_TEST(draw_glsl_shaders)
 
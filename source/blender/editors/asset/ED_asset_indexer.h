@@ -0,0 +1,42 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup edasset
+ *
+ * Index of the assets of a `.blend` file, cached on disk. Listing the assets of a library only
+ * has to open the `.blend` files that changed since they were last indexed.
+ */
+
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct AssetIndex;
+struct LinkNode;
+
+struct AssetIndex *ED_asset_indexer_open(const char *blendfile_path);
+void ED_asset_indexer_free(struct AssetIndex *index);
+
+struct LinkNode * /* BLODataBlockInfo */ ED_asset_indexer_get_datablock_info(
+    struct AssetIndex *index, const int idcode, int *r_tot_info_items);
+struct LinkNode *ED_asset_indexer_get_linkable_groups(const struct AssetIndex *index);
+
+#ifdef __cplusplus
+}
+#endif
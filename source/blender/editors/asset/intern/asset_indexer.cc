@@ -0,0 +1,447 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup edasset
+ *
+ * The index of a `.blend` file stores the linkable ID types it contains and the names and
+ * meta-data of its assets. Index files are stored in the cache folder of the user, named after
+ * the hash of the `.blend` file path. They are only used while the size and the modification
+ * time of the `.blend` file match the ones stored in the index.
+ *
+ * Assets with custom properties are not indexed (ID properties have no compact serialization
+ * here), the `.blend` files containing them are always read directly.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.h"
+#include "BLI_hash.h"
+#include "BLI_linklist.h"
+#include "BLI_listbase.h"
+#include "BLI_path_util.h"
+#include "BLI_string.h"
+#include "BLI_vector.hh"
+
+#include "BKE_appdir.h"
+#include "BKE_asset.h"
+#include "BKE_idtype.h"
+
+#include "BLO_readfile.h"
+
+#include "DNA_asset_types.h"
+
+#include "ED_asset_indexer.h"
+
+namespace blender::ed::asset::index {
+
+struct IndexedAsset {
+  short idcode;
+  char name[64]; /* MAX_NAME */
+  /** Owned by the index, until it's moved to a #BLODataBlockInfo. */
+  AssetMetaData *asset_data;
+};
+
+}  // namespace blender::ed::asset::index
+
+struct AssetIndex {
+  blender::Vector<short> linkable_idcodes;
+  blender::Vector<blender::ed::asset::index::IndexedAsset> assets;
+};
+
+namespace blender::ed::asset::index {
+
+static constexpr char INDEX_FILE_MAGIC[8] = {'B', 'A', 'S', 'S', 'I', 'D', 'X', '\0'};
+/** Increase when the layout of index files changes, so outdated files get recreated. */
+static constexpr int32_t INDEX_FILE_VERSION = 1;
+
+static void index_free_contents(AssetIndex &index)
+{
+  for (IndexedAsset &asset : index.assets) {
+    if (asset.asset_data) {
+      BKE_asset_metadata_free(&asset.asset_data);
+    }
+  }
+  index.assets.clear();
+  index.linkable_idcodes.clear();
+}
+
+static bool index_file_path_get(const char *blendfile_path, char *r_index_path, size_t maxlen)
+{
+  char cache_dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_dir, sizeof(cache_dir))) {
+    return false;
+  }
+  char index_name[FILE_MAXFILE];
+  BLI_snprintf(index_name, sizeof(index_name), "%08x.index", BLI_hash_string(blendfile_path));
+  BLI_path_join(r_index_path, maxlen, cache_dir, "asset-library-indices", index_name, nullptr);
+  return true;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Reading Index Files
+ * \{ */
+
+class IndexReader {
+  const char *pos_;
+  const char *end_;
+
+ public:
+  IndexReader(const char *data, const size_t size) : pos_(data), end_(data + size)
+  {
+  }
+
+  bool read(void *r_data, const size_t size)
+  {
+    if (size > size_t(end_ - pos_)) {
+      return false;
+    }
+    memcpy(r_data, pos_, size);
+    pos_ += size;
+    return true;
+  }
+
+  template<typename T> bool read(T &r_value)
+  {
+    return read(&r_value, sizeof(T));
+  }
+
+  /** A length of -1 is a null string. */
+  bool read_string(std::string &r_str, bool *r_is_null = nullptr)
+  {
+    int32_t len;
+    if (!read(len) || len < -1 || len > end_ - pos_) {
+      return false;
+    }
+    if (r_is_null) {
+      *r_is_null = (len == -1);
+    }
+    r_str.assign(pos_, std::max(len, 0));
+    pos_ += std::max(len, 0);
+    return true;
+  }
+};
+
+static bool index_read_asset(IndexReader &reader, IndexedAsset &r_asset)
+{
+  std::string name;
+  if (!reader.read(r_asset.idcode) || !reader.read_string(name)) {
+    return false;
+  }
+  STRNCPY(r_asset.name, name.c_str());
+
+  AssetMetaData *asset_data = BKE_asset_metadata_create();
+  r_asset.asset_data = asset_data;
+
+  std::string catalog_simple_name, description;
+  bool description_is_null;
+  int32_t tags_len;
+  if (!reader.read(asset_data->catalog_id) || !reader.read_string(catalog_simple_name) ||
+      !reader.read_string(description, &description_is_null) || !reader.read(tags_len) ||
+      !reader.read(asset_data->active_tag)) {
+    return false;
+  }
+  STRNCPY(asset_data->catalog_simple_name, catalog_simple_name.c_str());
+  if (!description_is_null) {
+    asset_data->description = BLI_strdupn(description.c_str(), description.size());
+  }
+  for (int i = 0; i < tags_len; i++) {
+    std::string tag_name;
+    if (!reader.read_string(tag_name)) {
+      return false;
+    }
+    BKE_asset_metadata_tag_add(asset_data, tag_name.c_str());
+  }
+  return true;
+}
+
+static bool index_read_from_file(const char *index_path,
+                                 const char *blendfile_path,
+                                 const BLI_stat_t &blendfile_stat,
+                                 AssetIndex &index)
+{
+  size_t size;
+  char *data = static_cast<char *>(BLI_file_read_binary_as_mem(index_path, 0, &size));
+  if (!data) {
+    return false;
+  }
+
+  IndexReader reader(data, size);
+  char magic[sizeof(INDEX_FILE_MAGIC)];
+  int32_t version;
+  int64_t file_size, file_mtime;
+  std::string path;
+  int32_t idcodes_len, assets_len;
+
+  /* The size and modification time of the `.blend` file must match, and the path must too, to
+   * detect collisions of the path hashes. */
+  bool ok = reader.read(magic, sizeof(magic)) &&
+            memcmp(magic, INDEX_FILE_MAGIC, sizeof(magic)) == 0 && reader.read(version) &&
+            version == INDEX_FILE_VERSION && reader.read(file_size) &&
+            file_size == int64_t(blendfile_stat.st_size) && reader.read(file_mtime) &&
+            file_mtime == int64_t(blendfile_stat.st_mtime) && reader.read_string(path) &&
+            path == blendfile_path && reader.read(idcodes_len) && idcodes_len >= 0;
+
+  for (int i = 0; ok && i < idcodes_len; i++) {
+    short idcode;
+    ok = reader.read(idcode);
+    index.linkable_idcodes.append(idcode);
+  }
+
+  ok = ok && reader.read(assets_len) && assets_len >= 0;
+  for (int i = 0; ok && i < assets_len; i++) {
+    IndexedAsset asset = {0, "", nullptr};
+    ok = index_read_asset(reader, asset);
+    /* Also on failure, so the meta-data is freed with the index. */
+    index.assets.append(asset);
+  }
+
+  MEM_freeN(data);
+
+  if (!ok) {
+    index_free_contents(index);
+  }
+  return ok;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Writing Index Files
+ * \{ */
+
+class IndexWriter {
+  std::ofstream &stream_;
+
+ public:
+  explicit IndexWriter(std::ofstream &stream) : stream_(stream)
+  {
+  }
+
+  void write(const void *data, const size_t size)
+  {
+    stream_.write(static_cast<const char *>(data), size);
+  }
+
+  template<typename T> void write(const T &value)
+  {
+    write(&value, sizeof(T));
+  }
+
+  void write_string(const char *str)
+  {
+    const int32_t len = str ? int32_t(strlen(str)) : -1;
+    write(len);
+    if (str) {
+      write(str, size_t(len));
+    }
+  }
+};
+
+static void index_write_to_file(const char *index_path,
+                                const char *blendfile_path,
+                                const BLI_stat_t &blendfile_stat,
+                                const AssetIndex &index)
+{
+  if (!BLI_make_existing_file(index_path)) {
+    return;
+  }
+
+  /* Write to a temporary file first, so other instances never read a partially written index. */
+  char tmp_path[FILE_MAX];
+  BLI_snprintf(tmp_path, sizeof(tmp_path), "%s@", index_path);
+
+  {
+    std::ofstream stream(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!stream) {
+      return;
+    }
+    IndexWriter writer(stream);
+    writer.write(INDEX_FILE_MAGIC, sizeof(INDEX_FILE_MAGIC));
+    writer.write(INDEX_FILE_VERSION);
+    writer.write(int64_t(blendfile_stat.st_size));
+    writer.write(int64_t(blendfile_stat.st_mtime));
+    writer.write_string(blendfile_path);
+
+    writer.write(int32_t(index.linkable_idcodes.size()));
+    for (const short idcode : index.linkable_idcodes) {
+      writer.write(idcode);
+    }
+
+    writer.write(int32_t(index.assets.size()));
+    for (const IndexedAsset &asset : index.assets) {
+      const AssetMetaData *asset_data = asset.asset_data;
+      writer.write(asset.idcode);
+      writer.write_string(asset.name);
+      writer.write(asset_data->catalog_id);
+      writer.write_string(asset_data->catalog_simple_name);
+      writer.write_string(asset_data->description);
+      writer.write(int32_t(BLI_listbase_count(&asset_data->tags)));
+      writer.write(asset_data->active_tag);
+      LISTBASE_FOREACH (const AssetTag *, tag, &asset_data->tags) {
+        writer.write_string(tag->name);
+      }
+    }
+
+    if (!stream) {
+      stream.close();
+      BLI_delete(tmp_path, false, false);
+      return;
+    }
+  }
+
+  if (BLI_rename(tmp_path, index_path) != 0) {
+    BLI_delete(tmp_path, false, false);
+  }
+}
+
+/** \} */
+
+/**
+ * Read the ID types and assets of the `.blend` file itself.
+ * \return false if the file couldn't be opened.
+ */
+static bool index_read_from_blendfile(const char *blendfile_path,
+                                      AssetIndex &index,
+                                      bool &r_is_indexable)
+{
+  BlendFileReadReport bf_reports = {nullptr};
+  BlendHandle *bh = BLO_blendhandle_from_file(blendfile_path, &bf_reports);
+  if (bh == nullptr) {
+    return false;
+  }
+
+  r_is_indexable = true;
+
+  /* Keep the orders of the lists returned by the BLO API, so listings from the index and from the
+   * `.blend` file don't differ. */
+  LinkNode *groups = BLO_blendhandle_get_linkable_groups(bh);
+  for (LinkNode *ln = groups; ln; ln = ln->next) {
+    const short idcode = BKE_idtype_idcode_from_name(static_cast<const char *>(ln->link));
+    index.linkable_idcodes.append(idcode);
+
+    int infos_len;
+    LinkNode *infos = BLO_blendhandle_get_datablock_info(bh, idcode, true, &infos_len);
+    for (LinkNode *ln_info = infos; ln_info; ln_info = ln_info->next) {
+      BLODataBlockInfo *info = static_cast<BLODataBlockInfo *>(ln_info->link);
+      IndexedAsset asset;
+      asset.idcode = idcode;
+      STRNCPY(asset.name, info->name);
+      asset.asset_data = info->asset_data;
+      if (asset.asset_data->properties) {
+        r_is_indexable = false;
+      }
+      index.assets.append(asset);
+    }
+    BLI_linklist_freeN(infos);
+  }
+  BLI_linklist_freeN(groups);
+
+  BLO_blendhandle_close(bh);
+  return true;
+}
+
+}  // namespace blender::ed::asset::index
+
+using namespace blender::ed::asset::index;
+
+/**
+ * Get the index of the given `.blend` file, from the index file when it's up to date, otherwise
+ * by reading the `.blend` file (and updating its index file).
+ * \return null if the `.blend` file couldn't be read.
+ */
+AssetIndex *ED_asset_indexer_open(const char *blendfile_path)
+{
+  BLI_stat_t blendfile_stat;
+  if (BLI_stat(blendfile_path, &blendfile_stat) != 0) {
+    return nullptr;
+  }
+
+  char index_path[FILE_MAX];
+  const bool has_index_path = index_file_path_get(blendfile_path, index_path, sizeof(index_path));
+
+  AssetIndex *index = new AssetIndex();
+  if (has_index_path &&
+      index_read_from_file(index_path, blendfile_path, blendfile_stat, *index)) {
+    return index;
+  }
+
+  bool is_indexable;
+  if (!index_read_from_blendfile(blendfile_path, *index, is_indexable)) {
+    delete index;
+    return nullptr;
+  }
+  if (has_index_path && is_indexable) {
+    index_write_to_file(index_path, blendfile_path, blendfile_stat, *index);
+  }
+  return index;
+}
+
+void ED_asset_indexer_free(AssetIndex *index)
+{
+  index_free_contents(*index);
+  delete index;
+}
+
+/**
+ * Same as #BLO_blendhandle_get_datablock_info() with `use_assets_only` enabled.
+ *
+ * \note Ownership of the asset meta-data is moved to the returned items, so this must be called
+ * only once per ID type.
+ */
+LinkNode *ED_asset_indexer_get_datablock_info(AssetIndex *index,
+                                              const int idcode,
+                                              int *r_tot_info_items)
+{
+  LinkNode *infos = nullptr;
+  int tot = 0;
+
+  for (int i = index->assets.size() - 1; i >= 0; i--) {
+    IndexedAsset &asset = index->assets[i];
+    if (asset.idcode != idcode || asset.asset_data == nullptr) {
+      continue;
+    }
+    BLODataBlockInfo *info = static_cast<BLODataBlockInfo *>(
+        MEM_mallocN(sizeof(*info), __func__));
+    STRNCPY(info->name, asset.name);
+    info->asset_data = asset.asset_data;
+    asset.asset_data = nullptr;
+
+    BLI_linklist_prepend(&infos, info);
+    tot++;
+  }
+
+  *r_tot_info_items = tot;
+  return infos;
+}
+
+/**
+ * Same as #BLO_blendhandle_get_linkable_groups().
+ */
+LinkNode *ED_asset_indexer_get_linkable_groups(const AssetIndex *index)
+{
+  LinkNode *names = nullptr;
+  for (int i = index->linkable_idcodes.size() - 1; i >= 0; i--) {
+    const char *name = BKE_idtype_idcode_to_name(index->linkable_idcodes[i]);
+    BLI_linklist_prepend(&names, BLI_strdup(name));
+  }
+  return names;
+}
@@ -38,6 +38,7 @@ void ED_operatortypes_asset(void);
 
 #include "../asset/ED_asset_filter.h"
 #include "../asset/ED_asset_handle.h"
+#include "../asset/ED_asset_indexer.h"
 #include "../asset/ED_asset_library.h"
 #include "../asset/ED_asset_list.h"
 #include "../asset/ED_asset_mark_clear.h"
@@ -27,6 +27,7 @@
 extern "C" {
 #endif
 
+struct ARegion;
 struct ID;
 struct Main;
 struct Scene;
@@ -41,6 +42,7 @@ struct bNodeSocketType;
 struct bNodeTree;
 struct bNodeTreeType;
 struct bNodeType;
+struct rctf;
 
 typedef enum {
   NODE_TOP = 1,
@@ -124,6 +126,21 @@ void ED_node_set_active(struct Main *bmain,
 void ED_node_composite_job(const struct bContext *C,
                            struct bNodeTree *nodetree,
                            struct Scene *scene_owner);
+/**
+ * Part of a backdrop image of the given size visible in the node editor, in normalized
+ * coordinates.
+ */
+void ED_node_backdrop_visible_region_get(const struct SpaceNode *snode,
+                                         const struct ARegion *region,
+                                         int width,
+                                         int height,
+                                         struct rctf *r_region);
+/**
+ * Whether the compositor has to run again for the visible part of the viewer image, in
+ * normalized coordinates, to be calculated. Only with #NTREE_VISIBLE_REGION.
+ */
+bool ED_node_composite_visible_region_outdated(const struct bNodeTree *ntree,
+                                               const struct rctf *visible_region);
 
 /* node_ops.c */
 void ED_operatormacros_node(void);
@@ -301,6 +301,8 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   const bool import_subdiv = RNA_boolean_get(op->ptr, "import_subdiv");
 
   const bool import_instance_proxies = RNA_boolean_get(op->ptr, "import_instance_proxies");
+  const bool use_instancing = RNA_boolean_get(op->ptr, "use_instancing");
+  const bool import_payloads = RNA_boolean_get(op->ptr, "import_payloads");
 
   const bool import_visible_only = RNA_boolean_get(op->ptr, "import_visible_only");
 
@@ -330,7 +332,6 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
   }
 
   const bool validate_meshes = false;
-  const bool use_instancing = false;
 
   struct USDImportParams params = {.scale = scale,
                                    .is_sequence = is_sequence,
@@ -354,6 +355,7 @@ static int wm_usd_import_exec(bContext *C, wmOperator *op)
                                    .import_render = import_render,
                                    .import_visible_only = import_visible_only,
                                    .use_instancing = use_instancing,
+                                   .import_payloads = import_payloads,
                                    .import_usd_preview = import_usd_preview,
                                    .set_material_blend = set_material_blend,
                                    .light_intensity_scale = light_intensity_scale};
@@ -389,6 +391,7 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Include"));
   uiItemR(col, ptr, "import_subdiv", 0, IFACE_("Subdivision"), ICON_NONE);
   uiItemR(col, ptr, "import_instance_proxies", 0, NULL, ICON_NONE);
+  uiItemR(col, ptr, "import_payloads", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_visible_only", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_guide", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "import_proxy", 0, NULL, ICON_NONE);
@@ -398,13 +401,16 @@ static void wm_usd_import_draw(bContext *UNUSED(C), wmOperator *op)
   uiItemR(col, ptr, "set_frame_range", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "relative_path", 0, NULL, ICON_NONE);
   uiItemR(col, ptr, "create_collection", 0, NULL, ICON_NONE);
+  uiLayout *row = uiLayoutRow(col, true);
+  uiItemR(row, ptr, "use_instancing", 0, NULL, ICON_NONE);
+  uiLayoutSetEnabled(row, RNA_boolean_get(ptr, "import_instance_proxies"));
   uiItemR(box, ptr, "light_intensity_scale", 0, NULL, ICON_NONE);
 
   box = uiLayoutBox(layout);
   col = uiLayoutColumnWithHeading(box, true, IFACE_("Experimental"));
   uiItemR(col, ptr, "import_usd_preview", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(col, RNA_boolean_get(ptr, "import_materials"));
-  uiLayout *row = uiLayoutRow(col, true);
+  row = uiLayoutRow(col, true);
   uiItemR(row, ptr, "set_material_blend", 0, NULL, ICON_NONE);
   uiLayoutSetEnabled(row, RNA_boolean_get(ptr, "import_usd_preview"));
 }
@@ -465,6 +471,21 @@ void WM_OT_usd_import(struct wmOperatorType *ot)
                   "Import Instance Proxies",
                   "Create unique Blender objects for USD instances");
 
+  RNA_def_boolean(ot->srna,
+                  "use_instancing",
+                  true,
+                  "Instancing",
+                  "Share the mesh data of instance proxies of the same USD prototype, "
+                  "instead of creating a mesh for every instance");
+
+  RNA_def_boolean(ot->srna,
+                  "import_payloads",
+                  true,
+                  "Payloads",
+                  "Load the payloads of the USD stage. When disabled, primitives that are "
+                  "only defined in payloads are not imported, which keeps importing large "
+                  "set dressing layers fast");
+
   RNA_def_boolean(ot->srna,
                   "import_visible_only",
                   true,
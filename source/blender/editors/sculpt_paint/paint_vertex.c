@@ -29,6 +29,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_array_utils.h"
+#include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_rect.h"
@@ -1471,6 +1472,8 @@ struct WPaintData {
   /* original weight values for use in blur/smear */
   float *precomputed_weight;
   bool precomputed_weight_ready;
+  /* Nodes painted since the weights were precomputed, when accumulating. */
+  GSet *precomputed_weight_outdated_nodes;
 };
 
 /* Initialize the stroke cache invariants from operator properties */
@@ -1720,6 +1723,7 @@ static bool wpaint_stroke_test_start(bContext *C, wmOperator *op, const float mo
 
   if (ELEM(vp->paint.brush->weightpaint_tool, WPAINT_TOOL_SMEAR, WPAINT_TOOL_BLUR)) {
     wpd->precomputed_weight = MEM_mallocN(sizeof(float) * me->totvert, __func__);
+    wpd->precomputed_weight_outdated_nodes = BLI_gset_ptr_new(__func__);
   }
 
   /* If not previously created, create vertex/weight paint mode session data */
@@ -1789,6 +1793,23 @@ static void do_wpaint_precompute_weight_cb_ex(void *__restrict userdata,
   data->wpd->precomputed_weight[n] = wpaint_get_active_weight(dv, data->wpi);
 }
 
+static void do_wpaint_precompute_node_weight_cb_ex(void *__restrict userdata,
+                                                   const int n,
+                                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptThreadedTaskData *data = userdata;
+  SculptSession *ss = data->ob->sculpt;
+
+  PBVHVertexIter vd;
+  BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
+    const int v_index = vd.vert_indices[vd.i];
+    const MDeformVert *dv = &data->me->dvert[v_index];
+
+    data->wpd->precomputed_weight[v_index] = wpaint_get_active_weight(dv, data->wpi);
+  }
+  BKE_pbvh_vertex_iter_end;
+}
+
 static void precompute_weight_values(
     bContext *C, Object *ob, Brush *brush, struct WPaintData *wpd, WeightPaintInfo *wpi, Mesh *me)
 {
@@ -1805,10 +1826,38 @@ static void precompute_weight_values(
       .me = me,
   };
 
+  /* When accumulating, only the weights of the vertices painted by the previous steps changed.
+   * Mesh nodes own their unique vertices, mirrored vertices may be outside the painted nodes. */
+  if (wpd->precomputed_weight_ready && BKE_pbvh_type(ob->sculpt->pbvh) == PBVH_FACES &&
+      !ME_USING_MIRROR_X_VERTEX_GROUPS(me)) {
+    const int totnode = BLI_gset_len(wpd->precomputed_weight_outdated_nodes);
+    if (totnode == 0) {
+      return;
+    }
+
+    PBVHNode **nodes = MEM_mallocN(sizeof(*nodes) * totnode, __func__);
+    int i = 0;
+    GSET_FOREACH_BEGIN (PBVHNode *, node, wpd->precomputed_weight_outdated_nodes) {
+      nodes[i++] = node;
+    }
+    GSET_FOREACH_END();
+    BLI_gset_clear(wpd->precomputed_weight_outdated_nodes, NULL);
+
+    data.nodes = nodes;
+
+    TaskParallelSettings settings;
+    BKE_pbvh_parallel_range_settings(&settings, true, totnode);
+    BLI_task_parallel_range(0, totnode, &data, do_wpaint_precompute_node_weight_cb_ex, &settings);
+
+    MEM_freeN(nodes);
+    return;
+  }
+
   TaskParallelSettings settings;
   BLI_parallel_range_settings_defaults(&settings);
   BLI_task_parallel_range(0, me->totvert, &data, do_wpaint_precompute_weight_cb_ex, &settings);
 
+  BLI_gset_clear(wpd->precomputed_weight_outdated_nodes, NULL);
   wpd->precomputed_weight_ready = true;
 }
 
@@ -2279,6 +2328,12 @@ static void wpaint_do_paint(bContext *C,
 
   wpaint_paint_leaves(C, ob, sd, wp, wpd, wpi, me, nodes, totnode);
 
+  if (wpd->precomputed_weight && brush_use_accumulate_ex(brush, ob->mode)) {
+    for (int n = 0; n < totnode; n++) {
+      BLI_gset_add(wpd->precomputed_weight_outdated_nodes, nodes[n]);
+    }
+  }
+
   if (nodes) {
     MEM_freeN(nodes);
   }
@@ -2486,6 +2541,7 @@ static void wpaint_stroke_done(const bContext *C, struct PaintStroke *stroke)
     }
     if (wpd->precomputed_weight) {
       MEM_freeN(wpd->precomputed_weight);
+      BLI_gset_free(wpd->precomputed_weight_outdated_nodes, NULL);
     }
 
     MEM_freeN(wpd);
@@ -2463,15 +2463,11 @@ static float brush_strength(const Sculpt *sd,
 }
 
 /* Return a multiplier for brush strength on a particular vertex. */
-float SCULPT_brush_strength_factor(SculptSession *ss,
-                                   const Brush *br,
-                                   const float brush_point[3],
-                                   const float len,
-                                   const short vno[3],
-                                   const float fno[3],
-                                   const float mask,
-                                   const int vertex_index,
-                                   const int thread_id)
+/* Strength of the brush texture at \a brush_point. */
+static float sculpt_brush_texture_factor(SculptSession *ss,
+                                         const Brush *br,
+                                         const float brush_point[3],
+                                         const int thread_id)
 {
   StrokeCache *cache = ss->cache;
   const Scene *scene = cache->vc->scene;
@@ -2532,7 +2528,12 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     }
   }
 
-  /* Hardness. */
+  return avg;
+}
+
+/* Distance to evaluate the falloff curve at, after applying the brush hardness. */
+BLI_INLINE float sculpt_brush_hardness_len(const StrokeCache *cache, const float len)
+{
   float final_len = len;
   const float hardness = cache->paint_brush.hardness;
   float p = len / cache->radius;
@@ -2546,6 +2547,24 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
     p = (p - hardness) / (1.0f - hardness);
     final_len = p * cache->radius;
   }
+  return final_len;
+}
+
+float SCULPT_brush_strength_factor(SculptSession *ss,
+                                   const Brush *br,
+                                   const float brush_point[3],
+                                   const float len,
+                                   const short vno[3],
+                                   const float fno[3],
+                                   const float mask,
+                                   const int vertex_index,
+                                   const int thread_id)
+{
+  StrokeCache *cache = ss->cache;
+  float avg = sculpt_brush_texture_factor(ss, br, brush_point, thread_id);
+
+  /* Hardness. */
+  const float final_len = sculpt_brush_hardness_len(cache, len);
 
   /* Falloff curve. */
   avg *= BKE_brush_curve_strength(br, final_len, cache->radius);
@@ -2560,6 +2579,57 @@ float SCULPT_brush_strength_factor(SculptSession *ss,
   return avg;
 }
 
+/**
+ * Same as #SCULPT_brush_strength_factor for all the vertices gathered from a node with
+ * #BKE_pbvh_node_vertex_data_gather, \a dist being their distances to the brush test.
+ * The falloff, mask and front face factors are evaluated over the whole arrays.
+ */
+void SCULPT_brush_strength_factor_array(SculptSession *ss,
+                                        const Brush *br,
+                                        const PBVHVertexData *vdata,
+                                        const float *dist,
+                                        const int thread_id,
+                                        float *r_factor)
+{
+  StrokeCache *cache = ss->cache;
+  const int totvert = vdata->totvert;
+
+  /* Hardness and falloff curve. */
+  for (int i = 0; i < totvert; i++) {
+    r_factor[i] = sculpt_brush_hardness_len(cache, dist[i]);
+  }
+  BKE_brush_curve_strength_array(br, r_factor, cache->radius, totvert, r_factor);
+
+  if (br->flag & BRUSH_FRONTFACE) {
+    const float *view_normal = cache->view_normal;
+    for (int i = 0; i < totvert; i++) {
+      r_factor[i] *= max_ff(dot_v3v3(vdata->no[i], view_normal), 0.0f);
+    }
+  }
+
+  /* Paint mask. */
+  for (int i = 0; i < totvert; i++) {
+    r_factor[i] *= 1.0f - vdata->mask[i];
+  }
+
+  if (br->mtex.tex) {
+    for (int i = 0; i < totvert; i++) {
+      if (r_factor[i] != 0.0f) {
+        r_factor[i] *= sculpt_brush_texture_factor(ss, br, vdata->co[i], thread_id);
+      }
+    }
+  }
+
+  /* Auto-masking. */
+  if (cache->automasking) {
+    for (int i = 0; i < totvert; i++) {
+      if (r_factor[i] != 0.0f) {
+        r_factor[i] *= SCULPT_automasking_factor_get(cache->automasking, ss, vdata->index[i]);
+      }
+    }
+  }
+}
+
 /* Test AABB against sphere. */
 bool SCULPT_search_sphere_cb(PBVHNode *node, void *data_v)
 {
@@ -3278,6 +3348,35 @@ static void do_draw_brush_task_cb_ex(void *__restrict userdata,
       ss, &test, data->brush->falloff_shape);
   const int thread_id = BLI_task_parallel_thread_id(tls);
 
+  /* Evaluate the falloff over the contiguous copy of the node vertices when possible. */
+  const PBVHVertexData *vdata = BKE_pbvh_node_vertex_data_gather(ss->pbvh, data->nodes[n]);
+  if (vdata != NULL) {
+    MVert *mverts;
+    BKE_pbvh_node_get_verts(ss->pbvh, data->nodes[n], NULL, &mverts);
+
+    float *dist = MEM_malloc_arrayN(vdata->totvert, sizeof(float), __func__);
+    float *fade = MEM_malloc_arrayN(vdata->totvert, sizeof(float), __func__);
+    for (int i = 0; i < vdata->totvert; i++) {
+      dist[i] = (vdata->visible[i] && sculpt_brush_test_sq_fn(&test, vdata->co[i])) ?
+                    sqrtf(test.dist) :
+                    FLT_MAX;
+    }
+    SCULPT_brush_strength_factor_array(ss, brush, vdata, dist, thread_id, fade);
+
+    for (int i = 0; i < vdata->totvert; i++) {
+      if (dist[i] == FLT_MAX) {
+        continue;
+      }
+      /* Offset vertex. */
+      mul_v3_v3fl(proxy[i], offset, fade[i]);
+      mverts[vdata->index[i]].flag |= ME_VERT_PBVH_UPDATE;
+    }
+
+    MEM_freeN(dist);
+    MEM_freeN(fade);
+    return;
+  }
+
   BKE_pbvh_vertex_iter_begin (ss->pbvh, data->nodes[n], vd, PBVH_ITER_UNIQUE) {
     if (!sculpt_brush_test_sq_fn(&test, vd.co)) {
       continue;
@@ -203,6 +203,58 @@ static bool automask_floodfill_cb(
               SCULPT_vertex_co_get(ss, to_v), data->location, data->radius, data->symm));
 }
 
+/* Connected components of the active vertex and its symmetric vertices, as in
+ * #SCULPT_floodfill_add_active. Returns the number of components. */
+static int automask_active_connected_components_get(Sculpt *sd,
+                                                    Object *ob,
+                                                    const float radius,
+                                                    int r_components[PAINT_SYMM_AREAS])
+{
+  SculptSession *ss = ob->sculpt;
+  const char symm = SCULPT_mesh_symmetry_xyz_get(ob);
+  int components_len = 0;
+  for (char i = 0; i <= symm; ++i) {
+    if (!SCULPT_is_symmetry_iteration_valid(i, symm)) {
+      continue;
+    }
+    int v = -1;
+    if (i == 0) {
+      v = SCULPT_active_vertex_get(ss);
+    }
+    else if (radius > 0.0f) {
+      float location[3];
+      flip_v3_v3(location, SCULPT_active_vertex_co_get(ss), i);
+      v = SCULPT_nearest_vertex_get(sd, ob, location, radius, false);
+    }
+
+    if (v != -1) {
+      r_components[components_len++] = ss->vertex_info.connected_component[v];
+    }
+  }
+  return components_len;
+}
+
+typedef struct AutomaskConnectedComponentsData {
+  SculptSession *ss;
+  float *automask_factor;
+  const int *components;
+  int components_len;
+} AutomaskConnectedComponentsData;
+
+static void automask_connected_components_task_cb(void *__restrict userdata,
+                                                  const int i,
+                                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AutomaskConnectedComponentsData *data = userdata;
+  const int component = data->ss->vertex_info.connected_component[i];
+  for (int j = 0; j < data->components_len; j++) {
+    if (component == data->components[j]) {
+      data->automask_factor[i] = 1.0f;
+      return;
+    }
+  }
+}
+
 static float *SCULPT_topology_automasking_init(Sculpt *sd, Object *ob, float *automask_factor)
 {
   SculptSession *ss = ob->sculpt;
@@ -218,17 +270,37 @@ static float *SCULPT_topology_automasking_init(Sculpt *sd, Object *ob, float *au
     automask_factor[i] = 0.0f;
   }
 
-  /* Flood fill automask to connected vertices. Limited to vertices inside
-   * the brush radius if the tool requires it. */
+  const float radius = ss->cache ? ss->cache->radius : FLT_MAX;
+  const bool use_radius = ss->cache && sculpt_automasking_is_constrained_by_radius(brush);
+
+  /* Without a radius the automasking covers the connected components of the active vertices. The
+   * components are kept in the sculpt session between strokes until the topology changes. */
+  if (!use_radius) {
+    SCULPT_connected_components_ensure(ob);
+
+    int components[PAINT_SYMM_AREAS];
+    AutomaskConnectedComponentsData data = {
+        .ss = ss,
+        .automask_factor = automask_factor,
+        .components = components,
+        .components_len = automask_active_connected_components_get(sd, ob, radius, components),
+    };
+
+    TaskParallelSettings settings;
+    BLI_parallel_range_settings_defaults(&settings);
+    BLI_task_parallel_range(0, totvert, &data, automask_connected_components_task_cb, &settings);
+    return automask_factor;
+  }
+
+  /* Flood fill automask to connected vertices inside the brush radius. */
   SculptFloodFill flood;
   SCULPT_floodfill_init(ss, &flood);
-  const float radius = ss->cache ? ss->cache->radius : FLT_MAX;
   SCULPT_floodfill_add_active(sd, ob, ss, &flood, radius);
 
   AutomaskFloodFillData fdata = {
       .automask_factor = automask_factor,
       .radius = radius,
-      .use_radius = ss->cache && sculpt_automasking_is_constrained_by_radius(brush),
+      .use_radius = use_radius,
       .symm = SCULPT_mesh_symmetry_xyz_get(ob),
   };
   copy_v3_v3(fdata.location, SCULPT_active_vertex_co_get(ss));
@@ -265,6 +337,33 @@ static float *sculpt_face_sets_automasking_init(Sculpt *sd, Object *ob, float *a
 
 #define EDGE_DISTANCE_INF -1
 
+typedef struct AutomaskBoundaryPropagationData {
+  SculptSession *ss;
+  int *edge_distance;
+  int propagation_it;
+} AutomaskBoundaryPropagationData;
+
+static void automask_boundary_propagation_task_cb(void *__restrict userdata,
+                                                  const int i,
+                                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  AutomaskBoundaryPropagationData *data = userdata;
+  int *edge_distance = data->edge_distance;
+  if (edge_distance[i] != EDGE_DISTANCE_INF) {
+    return;
+  }
+
+  /* Vertices of the current wavefront don't change in this iteration, so the neighbors can be
+   * read while other vertices are updated. */
+  SculptVertexNeighborIter ni;
+  SCULPT_VERTEX_NEIGHBORS_ITER_BEGIN (data->ss, i, ni) {
+    if (edge_distance[ni.index] == data->propagation_it) {
+      edge_distance[i] = data->propagation_it + 1;
+    }
+  }
+  SCULPT_VERTEX_NEIGHBORS_ITER_END(ni);
+}
+
 float *SCULPT_boundary_automasking_init(Object *ob,
                                         eBoundaryAutomaskMode mode,
                                         int propagation_steps,
@@ -296,19 +395,15 @@ float *SCULPT_boundary_automasking_init(Object *ob,
     }
   }
 
+  AutomaskBoundaryPropagationData data = {
+      .ss = ss,
+      .edge_distance = edge_distance,
+  };
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
   for (int propagation_it = 0; propagation_it < propagation_steps; propagation_it++) {
-    for (int i = 0; i < totvert; i++) {
-      if (edge_distance[i] != EDGE_DISTANCE_INF) {
-        continue;
-      }
-      SculptVertexNeighborIter ni;
-      SCULPT_VERTEX_NEIGHBORS_ITER_BEGIN (ss, i, ni) {
-        if (edge_distance[ni.index] == propagation_it) {
-          edge_distance[i] = propagation_it + 1;
-        }
-      }
-      SCULPT_VERTEX_NEIGHBORS_ITER_END(ni);
-    }
+    data.propagation_it = propagation_it;
+    BLI_task_parallel_range(0, totvert, &data, automask_boundary_propagation_task_cb, &settings);
   }
 
   for (int i = 0; i < totvert; i++) {
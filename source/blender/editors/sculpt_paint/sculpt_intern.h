@@ -672,6 +672,13 @@ typedef struct SculptUndoNode {
   /* Sculpt Face Sets */
   int *face_sets;
 
+  /* Coordinates, normals, colors and masks of undo steps unlikely to be restored again are kept
+   * compressed, with the arrays freed until the step is restored. */
+  void *compressed_data;
+  size_t compressed_size;
+  /* Size of each compressed array, zero for arrays that weren't allocated. */
+  size_t compressed_arrays_size[5];
+
   size_t undo_size;
 } SculptUndoNode;
 
@@ -868,6 +875,12 @@ float SCULPT_brush_strength_factor(struct SculptSession *ss,
                                    const float mask,
                                    const int vertex_index,
                                    const int thread_id);
+void SCULPT_brush_strength_factor_array(struct SculptSession *ss,
+                                        const struct Brush *br,
+                                        const PBVHVertexData *vdata,
+                                        const float *dist,
+                                        const int thread_id,
+                                        float *r_factor);
 
 /* Tilts a normal by the x and y tilt values using the view axis. */
 void SCULPT_tilt_apply_to_normal(float r_normal[3],
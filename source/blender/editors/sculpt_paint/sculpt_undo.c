@@ -23,6 +23,7 @@
  */
 
 #include <stddef.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -116,6 +117,7 @@ typedef struct UndoSculpt {
 } UndoSculpt;
 
 static UndoSculpt *sculpt_undo_get_nodes(void);
+static UndoSculpt *sculpt_undosys_step_get_nodes(UndoStep *us_p);
 
 static void update_cb(PBVHNode *node, void *rebuild)
 {
@@ -635,6 +637,230 @@ static void sculpt_undo_refine_subdiv(Depsgraph *depsgraph,
   MEM_freeN(deformed_verts);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Undo Nodes Compression
+ *
+ * Nodes of undo steps unlikely to be restored again get their arrays compressed together,
+ * they are decompressed again when the step is restored.
+ * \{ */
+
+/* Number of sculpt steps behind the newest one after which a step gets compressed. */
+#define SCULPT_UNDO_COMPRESS_STEP_OFFSET 2
+/* Favor speed over compression ratio, like for memfile undo steps. */
+#define SCULPT_UNDO_COMPRESSION_LEVEL 1
+/* Nodes with less data are not worth compressing. */
+#define SCULPT_UNDO_COMPRESS_MIN_SIZE 4096
+
+#define SCULPT_UNDO_COMPRESSED_ARRAYS_NUM 5
+
+typedef struct SculptUndoNodeArray {
+  void **data;
+  /* Size of the array elements components, for splitting them into byte planes. */
+  int component_size;
+  const char *name;
+} SculptUndoNodeArray;
+
+static void sculpt_undo_node_arrays_get(SculptUndoNode *unode,
+                                        SculptUndoNodeArray r_arrays[])
+{
+  r_arrays[0] = (SculptUndoNodeArray){(void **)&unode->co, sizeof(float), "SculptUndoNode.co"};
+  r_arrays[1] = (SculptUndoNodeArray){
+      (void **)&unode->orig_co, sizeof(float), "undoSculpt orig_cos"};
+  r_arrays[2] = (SculptUndoNodeArray){(void **)&unode->no, sizeof(short), "SculptUndoNode.no"};
+  r_arrays[3] = (SculptUndoNodeArray){(void **)&unode->col, sizeof(float), "SculptUndoNode.col"};
+  r_arrays[4] = (SculptUndoNodeArray){
+      (void **)&unode->mask, sizeof(float), "SculptUndoNode.mask"};
+}
+
+/* Store the bytes of the components in separate planes: the similar exponent and high bytes of
+ * floats next to each other compress much better. */
+static void sculpt_undo_bytes_split(char *dst, const char *src, size_t size, int component_size)
+{
+  const size_t num = size / (size_t)component_size;
+  for (int b = 0; b < component_size; b++) {
+    for (size_t i = 0; i < num; i++) {
+      dst[b * num + i] = src[i * component_size + b];
+    }
+  }
+}
+
+static void sculpt_undo_bytes_join(char *dst, const char *src, size_t size, int component_size)
+{
+  const size_t num = size / (size_t)component_size;
+  for (int b = 0; b < component_size; b++) {
+    for (size_t i = 0; i < num; i++) {
+      dst[i * component_size + b] = src[b * num + i];
+    }
+  }
+}
+
+/* Returns the number of saved bytes. */
+static size_t sculpt_undo_node_compress(SculptUndoNode *unode)
+{
+  if (unode->compressed_data || unode->bm_entry) {
+    return 0;
+  }
+
+  SculptUndoNodeArray arrays[SCULPT_UNDO_COMPRESSED_ARRAYS_NUM];
+  sculpt_undo_node_arrays_get(unode, arrays);
+
+  size_t size = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESSED_ARRAYS_NUM; i++) {
+    const void *data = *arrays[i].data;
+    unode->compressed_arrays_size[i] = data ? MEM_allocN_len(data) : 0;
+    size += unode->compressed_arrays_size[i];
+  }
+  if (size < SCULPT_UNDO_COMPRESS_MIN_SIZE) {
+    return 0;
+  }
+
+  char *buf_raw = MEM_mallocN(size, __func__);
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESSED_ARRAYS_NUM; i++) {
+    const size_t array_size = unode->compressed_arrays_size[i];
+    if (array_size) {
+      sculpt_undo_bytes_split(
+          buf_raw + offset, *arrays[i].data, array_size, arrays[i].component_size);
+      offset += array_size;
+    }
+  }
+
+  const size_t buf_len = ZSTD_compressBound(size);
+  char *buf = MEM_mallocN(buf_len, "SculptUndoNode.compressed_data");
+  const size_t compressed_size = ZSTD_compress(
+      buf, buf_len, buf_raw, size, SCULPT_UNDO_COMPRESSION_LEVEL);
+  MEM_freeN(buf_raw);
+  /* Keep the arrays as they are if they don't compress well. */
+  if (ZSTD_isError(compressed_size) || compressed_size > size - size / 8) {
+    MEM_freeN(buf);
+    return 0;
+  }
+
+  for (int i = 0; i < SCULPT_UNDO_COMPRESSED_ARRAYS_NUM; i++) {
+    MEM_SAFE_FREE(*arrays[i].data);
+  }
+  unode->compressed_data = MEM_reallocN(buf, compressed_size);
+  unode->compressed_size = compressed_size;
+  return size - compressed_size;
+}
+
+/* Returns the number of bytes added back. */
+static size_t sculpt_undo_node_decompress(SculptUndoNode *unode)
+{
+  if (unode->compressed_data == NULL) {
+    return 0;
+  }
+
+  SculptUndoNodeArray arrays[SCULPT_UNDO_COMPRESSED_ARRAYS_NUM];
+  sculpt_undo_node_arrays_get(unode, arrays);
+
+  size_t size = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESSED_ARRAYS_NUM; i++) {
+    size += unode->compressed_arrays_size[i];
+  }
+
+  char *buf_raw = MEM_mallocN(size, __func__);
+  const size_t decompressed_size = ZSTD_decompress(
+      buf_raw, size, unode->compressed_data, unode->compressed_size);
+  BLI_assert(!ZSTD_isError(decompressed_size) && decompressed_size == size);
+  UNUSED_VARS_NDEBUG(decompressed_size);
+
+  size_t offset = 0;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESSED_ARRAYS_NUM; i++) {
+    const size_t array_size = unode->compressed_arrays_size[i];
+    if (array_size) {
+      *arrays[i].data = MEM_mallocN(array_size, arrays[i].name);
+      sculpt_undo_bytes_join(
+          *arrays[i].data, buf_raw + offset, array_size, arrays[i].component_size);
+      offset += array_size;
+    }
+  }
+  MEM_freeN(buf_raw);
+
+  const size_t added_size = size - unode->compressed_size;
+  MEM_freeN(unode->compressed_data);
+  unode->compressed_data = NULL;
+  unode->compressed_size = 0;
+  return added_size;
+}
+
+typedef struct SculptUndoCompressData {
+  SculptUndoNode **nodes;
+  /* Bytes saved or added back for each node. */
+  size_t *sizes;
+  bool decompress;
+} SculptUndoCompressData;
+
+static void sculpt_undo_compress_node_fn(void *__restrict userdata,
+                                         const int index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  SculptUndoCompressData *data = userdata;
+  SculptUndoNode *unode = data->nodes[index];
+  data->sizes[index] = data->decompress ? sculpt_undo_node_decompress(unode) :
+                                          sculpt_undo_node_compress(unode);
+}
+
+/* Compress or decompress all nodes of the list in parallel, returns the bytes saved or added
+ * back. */
+static size_t sculpt_undo_compress_nodes_ex(ListBase *lb, const bool decompress)
+{
+  const int nodes_num = BLI_listbase_count(lb);
+  if (nodes_num == 0) {
+    return 0;
+  }
+
+  SculptUndoCompressData data;
+  data.nodes = MEM_malloc_arrayN((size_t)nodes_num, sizeof(*data.nodes), __func__);
+  data.sizes = MEM_malloc_arrayN((size_t)nodes_num, sizeof(*data.sizes), __func__);
+  data.decompress = decompress;
+
+  int i = 0;
+  LISTBASE_FOREACH (SculptUndoNode *, unode, lb) {
+    data.nodes[i++] = unode;
+  }
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, nodes_num, &data, sculpt_undo_compress_node_fn, &settings);
+
+  size_t size = 0;
+  for (i = 0; i < nodes_num; i++) {
+    size += data.sizes[i];
+  }
+
+  MEM_freeN(data.nodes);
+  MEM_freeN(data.sizes);
+  return size;
+}
+
+/* Decompress the nodes of a step before restoring it. */
+static void sculpt_undo_step_decompress(UndoStep *us)
+{
+  UndoSculpt *usculpt = sculpt_undosys_step_get_nodes(us);
+  const size_t added_size = sculpt_undo_compress_nodes_ex(&usculpt->nodes, true);
+  usculpt->undo_size += added_size;
+  us->data_size += added_size;
+}
+
+/* Compress the steps older than #SCULPT_UNDO_COMPRESS_STEP_OFFSET, steps decompressed to be
+ * restored get compressed again once they are that far back. */
+static void sculpt_undo_compress_old_steps(UndoStep *us_newest)
+{
+  UndoStep *us = us_newest;
+  for (int i = 0; i < SCULPT_UNDO_COMPRESS_STEP_OFFSET && us != NULL; i++) {
+    us = BKE_undosys_step_same_type_prev(us);
+  }
+  for (; us != NULL; us = BKE_undosys_step_same_type_prev(us)) {
+    UndoSculpt *usculpt = sculpt_undosys_step_get_nodes(us);
+    const size_t saved_size = sculpt_undo_compress_nodes_ex(&usculpt->nodes, false);
+    usculpt->undo_size -= saved_size;
+    us->data_size -= saved_size;
+  }
+}
+
+/** \} */
+
 static void sculpt_undo_restore_list(bContext *C, Depsgraph *depsgraph, ListBase *lb)
 {
   Scene *scene = CTX_data_scene(C);
@@ -885,6 +1111,12 @@ static void sculpt_undo_free_list(ListBase *lb)
     if (unode->mask) {
       MEM_freeN(unode->mask);
     }
+    if (unode->col) {
+      MEM_freeN(unode->col);
+    }
+    if (unode->compressed_data) {
+      MEM_freeN(unode->compressed_data);
+    }
 
     if (unode->bm_entry) {
       BM_log_entry_drop(unode->bm_entry);
@@ -1287,7 +1519,7 @@ static SculptUndoNode *sculpt_undo_bmesh_push(Object *ob, PBVHNode *node, Sculpt
   return unode;
 }
 
-SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType type)
+static SculptUndoNode *sculpt_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType type)
 {
   SculptSession *ss = ob->sculpt;
   SculptUndoNode *unode;
@@ -1378,6 +1610,15 @@ SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType
   return unode;
 }
 
+SculptUndoNode *SCULPT_undo_push_node(Object *ob, PBVHNode *node, SculptUndoType type)
+{
+  /* Undo nodes are filled while the stroke runs, before the undo step is encoded. */
+  const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_UNDO);
+  SculptUndoNode *unode = sculpt_undo_push_node(ob, node, type);
+  MEM_domain_end(previous_domain);
+  return unode;
+}
+
 void SCULPT_undo_push_begin(Object *ob, const char *name)
 {
   UndoStack *ustack = ED_undo_stack_get();
@@ -1462,6 +1703,8 @@ static bool sculpt_undosys_step_encode(struct bContext *UNUSED(C),
     bmain->is_memfile_undo_flush_needed = true;
   }
 
+  sculpt_undo_compress_old_steps(&us->step);
+
   return true;
 }
 
@@ -1470,6 +1713,7 @@ static void sculpt_undosys_step_decode_undo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
+  sculpt_undo_step_decompress(&us->step);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
   us->step.is_applied = false;
 }
@@ -1479,6 +1723,7 @@ static void sculpt_undosys_step_decode_redo_impl(struct bContext *C,
                                                  SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == false);
+  sculpt_undo_step_decompress(&us->step);
   sculpt_undo_restore_list(C, depsgraph, &us->data.nodes);
   us->step.is_applied = true;
 }
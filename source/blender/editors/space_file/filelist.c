@@ -46,7 +46,6 @@
 #include "BLI_ghash.h"
 #include "BLI_linklist.h"
 #include "BLI_math.h"
-#include "BLI_stack.h"
 #include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
@@ -71,6 +70,7 @@
 #include "DNA_asset_types.h"
 #include "DNA_space_types.h"
 
+#include "ED_asset.h"
 #include "ED_datafiles.h"
 #include "ED_fileselect.h"
 #include "ED_screen.h"
@@ -3027,6 +3027,20 @@ static void filelist_readjob_list_lib_add_datablocks(ListBase *entries,
   }
 }
 
+static LinkNode *filelist_readjob_list_lib_datablock_info(struct BlendHandle *libfiledata,
+                                                          struct AssetIndex *asset_index,
+                                                          const int idcode,
+                                                          const bool use_assets_only,
+                                                          int *r_tot_info_items)
+{
+  if (asset_index) {
+    BLI_assert(use_assets_only);
+    return ED_asset_indexer_get_datablock_info(asset_index, idcode, r_tot_info_items);
+  }
+  return BLO_blendhandle_get_datablock_info(
+      libfiledata, idcode, use_assets_only, r_tot_info_items);
+}
+
 static int filelist_readjob_list_lib(const char *root,
                                      ListBase *entries,
                                      const ListLibOptions options)
@@ -3034,6 +3048,7 @@ static int filelist_readjob_list_lib(const char *root,
   char dir[FILE_MAX_LIBEXTRA], *group;
 
   struct BlendHandle *libfiledata = NULL;
+  struct AssetIndex *asset_index = NULL;
 
   /* Check if the given root is actually a library. All folders are passed to
    * `filelist_readjob_list_lib` and based on the number of found entries `filelist_readjob_do`
@@ -3045,11 +3060,20 @@ static int filelist_readjob_list_lib(const char *root,
     return 0;
   }
 
-  /* Open the library file. */
-  BlendFileReadReport bf_reports = {.reports = NULL};
-  libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
-  if (libfiledata == NULL) {
-    return 0;
+  /* Open the library file. Asset libraries are listed from the asset index of the file, which
+   * avoids reading it when the index is up to date. */
+  if (options & LIST_LIB_ASSETS_ONLY) {
+    asset_index = ED_asset_indexer_open(dir);
+    if (asset_index == NULL) {
+      return 0;
+    }
+  }
+  else {
+    BlendFileReadReport bf_reports = {.reports = NULL};
+    libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
+    if (libfiledata == NULL) {
+      return 0;
+    }
   }
 
   /* Add current parent when requested. */
@@ -3067,13 +3091,14 @@ static int filelist_readjob_list_lib(const char *root,
   const bool group_came_from_path = group != NULL;
   if (group_came_from_path) {
     const int idcode = groupname_to_code(group);
-    LinkNode *datablock_infos = BLO_blendhandle_get_datablock_info(
-        libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &datablock_len);
+    LinkNode *datablock_infos = filelist_readjob_list_lib_datablock_info(
+        libfiledata, asset_index, idcode, options & LIST_LIB_ASSETS_ONLY, &datablock_len);
     filelist_readjob_list_lib_add_datablocks(entries, datablock_infos, false, idcode, group);
     BLI_linklist_freeN(datablock_infos);
   }
   else {
-    LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
+    LinkNode *groups = asset_index ? ED_asset_indexer_get_linkable_groups(asset_index) :
+                                     BLO_blendhandle_get_linkable_groups(libfiledata);
     group_len = BLI_linklist_count(groups);
 
     for (LinkNode *ln = groups; ln; ln = ln->next) {
@@ -3085,8 +3110,12 @@ static int filelist_readjob_list_lib(const char *root,
 
       if (options & LIST_LIB_RECURSIVE) {
         int group_datablock_len;
-        LinkNode *group_datablock_infos = BLO_blendhandle_get_datablock_info(
-            libfiledata, idcode, options & LIST_LIB_ASSETS_ONLY, &group_datablock_len);
+        LinkNode *group_datablock_infos = filelist_readjob_list_lib_datablock_info(
+            libfiledata,
+            asset_index,
+            idcode,
+            options & LIST_LIB_ASSETS_ONLY,
+            &group_datablock_len);
         filelist_readjob_list_lib_add_datablocks(
             entries, group_datablock_infos, true, idcode, group_name);
         BLI_linklist_freeN(group_datablock_infos);
@@ -3097,7 +3126,12 @@ static int filelist_readjob_list_lib(const char *root,
     BLI_linklist_freeN(groups);
   }
 
-  BLO_blendhandle_close(libfiledata);
+  if (asset_index) {
+    ED_asset_indexer_free(asset_index);
+  }
+  else {
+    BLO_blendhandle_close(libfiledata);
+  }
 
   /* Return the number of items added to entries. */
   int added_entries_len = group_len + datablock_len + parent_len;
@@ -3333,6 +3367,142 @@ static bool filelist_readjob_should_recurse_into_entry(const int max_recursion,
   return true;
 }
 
+/** Shared state of the tasks listing the directories of #filelist_readjob_do. */
+typedef struct FileListReadDirsData {
+  FileListReadJob *job_params;
+  bool do_lib;
+  const short *stop;
+  short *do_update;
+  float *progress;
+
+  char filter_glob[FILE_MAXFILE];
+
+  /** Protects the directory counters and the post-processing of listed entries, which may query
+   * font names through FreeType (not thread-safe). */
+  ThreadMutex lock;
+  int nbr_done_dirs, nbr_todo_dirs;
+} FileListReadDirsData;
+
+static void filelist_readjob_dir_task_free(TaskPool *UNUSED(pool), void *taskdata)
+{
+  TodoDir *td_dir = taskdata;
+  MEM_freeN(td_dir->dir);
+  MEM_freeN(td_dir);
+}
+
+static void filelist_readjob_dir_task(TaskPool *__restrict pool, void *taskdata)
+{
+  FileListReadDirsData *data = BLI_task_pool_user_data(pool);
+  FileListReadJob *job_params = data->job_params;
+  FileList *filelist = job_params->tmp_filelist;
+  const TodoDir *td_dir = taskdata;
+  const char *root = filelist->filelist.root;
+  const int max_recursion = filelist->max_recursion;
+  const char *subdir = td_dir->dir;
+  const int recursion_level = td_dir->level;
+  const bool skip_currpar = (recursion_level > 1);
+
+  ListBase entries = {0};
+  FileListInternEntry *entry;
+  int nbr_entries = 0;
+  char dir[FILE_MAX_LIBEXTRA];
+  char rel_subdir[FILE_MAX_LIBEXTRA];
+
+  if (*data->stop || BLI_task_pool_current_canceled(pool)) {
+    return;
+  }
+
+  /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
+   * entry->relpath itself (nor any path containing it), since it may actually be a datablock
+   * name inside .blend file, which can have slashes and backslashes! See T46827.
+   * Note that in the end, this means we 'cache' valid relative subdir once here,
+   * this is actually better. */
+  BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
+  BLI_path_normalize_dir(root, rel_subdir);
+  BLI_path_rel(rel_subdir, root);
+
+  bool is_lib = false;
+  if (data->do_lib) {
+    ListLibOptions list_lib_options = 0;
+    if (!skip_currpar) {
+      list_lib_options |= LIST_LIB_ADD_PARENT;
+    }
+
+    /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
+     * still a recursion level over. */
+    if (max_recursion > 0) {
+      list_lib_options |= LIST_LIB_RECURSIVE;
+    }
+    /* Only load assets when browsing an asset library. For normal file browsing we return all
+     * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user.*/
+    if (filelist->asset_library_ref) {
+      list_lib_options |= LIST_LIB_ASSETS_ONLY;
+    }
+    nbr_entries = filelist_readjob_list_lib(subdir, &entries, list_lib_options);
+    if (nbr_entries > 0) {
+      is_lib = true;
+    }
+  }
+
+  if (!is_lib) {
+    nbr_entries = filelist_readjob_list_dir(subdir,
+                                            &entries,
+                                            data->filter_glob,
+                                            data->do_lib,
+                                            job_params->main_name,
+                                            skip_currpar);
+  }
+
+  BLI_mutex_lock(&data->lock);
+
+  for (entry = entries.first; entry; entry = entry->next) {
+    entry->uid = filelist_uid_generate(filelist);
+
+    /* When loading entries recursive, the rel_path should be relative from the root dir.
+     * we combine the relative path to the subdir with the relative path of the entry. */
+    BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
+    MEM_freeN(entry->relpath);
+    entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
+                                           * added by BLI_path_rel to rel_subdir. */
+    entry->name = fileentry_uiname(root, entry->relpath, entry->typeflag, dir);
+    entry->free_name = true;
+
+    if (filelist_readjob_should_recurse_into_entry(
+            max_recursion, is_lib, recursion_level, entry)) {
+      /* We have a directory we want to list, add it to todo list! */
+      TodoDir *td_subdir = MEM_mallocN(sizeof(*td_subdir), __func__);
+      BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
+      BLI_path_normalize_dir(job_params->main_name, dir);
+      td_subdir->level = recursion_level + 1;
+      td_subdir->dir = BLI_strdup(dir);
+      data->nbr_todo_dirs++;
+      BLI_task_pool_push(
+          pool, filelist_readjob_dir_task, td_subdir, true, filelist_readjob_dir_task_free);
+    }
+  }
+
+  data->nbr_done_dirs++;
+  *data->progress = (float)data->nbr_done_dirs / (float)data->nbr_todo_dirs;
+
+  BLI_mutex_unlock(&data->lock);
+
+  if (nbr_entries) {
+    BLI_mutex_lock(&job_params->lock);
+
+    *data->do_update = true;
+
+    BLI_movelisttolist(&filelist->filelist.entries, &entries);
+    filelist->filelist.nbr_entries += nbr_entries;
+
+    BLI_mutex_unlock(&job_params->lock);
+  }
+}
+
+/**
+ * List the root directory and all directories and libraries found in it (up to the max recursion
+ * level). Each directory is listed in its own task, so the latency of reading many directories
+ * and `.blend` files (e.g. asset libraries on network drives) overlaps.
+ */
 static void filelist_readjob_do(const bool do_lib,
                                 FileListReadJob *job_params,
                                 const short *stop,
@@ -3340,14 +3510,16 @@ static void filelist_readjob_do(const bool do_lib,
                                 float *progress)
 {
   FileList *filelist = job_params->tmp_filelist; /* Use the thread-safe filelist queue. */
-  ListBase entries = {0};
-  BLI_Stack *todo_dirs;
-  TodoDir *td_dir;
+  FileListReadDirsData data = {
+      .job_params = job_params,
+      .do_lib = do_lib,
+      .stop = stop,
+      .do_update = do_update,
+      .progress = progress,
+      .nbr_done_dirs = 0,
+      .nbr_todo_dirs = 1,
+  };
   char dir[FILE_MAX_LIBEXTRA];
-  char filter_glob[FILE_MAXFILE];
-  const char *root = filelist->filelist.root;
-  const int max_recursion = filelist->max_recursion;
-  int nbr_done_dirs = 0, nbr_todo_dirs = 1;
 
   //  BLI_assert(filelist->filtered == NULL);
   BLI_assert(BLI_listbase_is_empty(&filelist->filelist.entries) &&
@@ -3356,117 +3528,23 @@ static void filelist_readjob_do(const bool do_lib,
   /* A valid, but empty directory from now. */
   filelist->filelist.nbr_entries = 0;
 
-  todo_dirs = BLI_stack_new(sizeof(*td_dir), __func__);
-  td_dir = BLI_stack_push_r(todo_dirs);
-  td_dir->level = 1;
-
   BLI_strncpy(dir, filelist->filelist.root, sizeof(dir));
-  BLI_strncpy(filter_glob, filelist->filter_data.filter_glob, sizeof(filter_glob));
-
+  BLI_strncpy(data.filter_glob, filelist->filter_data.filter_glob, sizeof(data.filter_glob));
   BLI_path_normalize_dir(job_params->main_name, dir);
-  td_dir->dir = BLI_strdup(dir);
-
-  while (!BLI_stack_is_empty(todo_dirs) && !(*stop)) {
-    FileListInternEntry *entry;
-    int nbr_entries = 0;
-
-    char *subdir;
-    char rel_subdir[FILE_MAX_LIBEXTRA];
-    int recursion_level;
-    bool skip_currpar;
-
-    td_dir = BLI_stack_peek(todo_dirs);
-    subdir = td_dir->dir;
-    recursion_level = td_dir->level;
-    skip_currpar = (recursion_level > 1);
-
-    BLI_stack_discard(todo_dirs);
-
-    /* ARRRG! We have to be very careful *not to use* common BLI_path_util helpers over
-     * entry->relpath itself (nor any path containing it), since it may actually be a datablock
-     * name inside .blend file, which can have slashes and backslashes! See T46827.
-     * Note that in the end, this means we 'cache' valid relative subdir once here,
-     * this is actually better. */
-    BLI_strncpy(rel_subdir, subdir, sizeof(rel_subdir));
-    BLI_path_normalize_dir(root, rel_subdir);
-    BLI_path_rel(rel_subdir, root);
-
-    bool is_lib = false;
-    if (do_lib) {
-      ListLibOptions list_lib_options = 0;
-      if (!skip_currpar) {
-        list_lib_options |= LIST_LIB_ADD_PARENT;
-      }
-
-      /* Libraries are loaded recursively when max_recursion is set. It doesn't check if there is
-       * still a recursion level over. */
-      if (max_recursion > 0) {
-        list_lib_options |= LIST_LIB_RECURSIVE;
-      }
-      /* Only load assets when browsing an asset library. For normal file browsing we return all
-       * entries. `FLF_ASSETS_ONLY` filter can be enabled/disabled by the user.*/
-      if (filelist->asset_library_ref) {
-        list_lib_options |= LIST_LIB_ASSETS_ONLY;
-      }
-      nbr_entries = filelist_readjob_list_lib(subdir, &entries, list_lib_options);
-      if (nbr_entries > 0) {
-        is_lib = true;
-      }
-    }
-
-    if (!is_lib) {
-      nbr_entries = filelist_readjob_list_dir(
-          subdir, &entries, filter_glob, do_lib, job_params->main_name, skip_currpar);
-    }
-
-    for (entry = entries.first; entry; entry = entry->next) {
-      entry->uid = filelist_uid_generate(filelist);
-
-      /* When loading entries recursive, the rel_path should be relative from the root dir.
-       * we combine the relative path to the subdir with the relative path of the entry. */
-      BLI_join_dirfile(dir, sizeof(dir), rel_subdir, entry->relpath);
-      MEM_freeN(entry->relpath);
-      entry->relpath = BLI_strdup(dir + 2); /* + 2 to remove '//'
-                                             * added by BLI_path_rel to rel_subdir. */
-      entry->name = fileentry_uiname(root, entry->relpath, entry->typeflag, dir);
-      entry->free_name = true;
-
-      if (filelist_readjob_should_recurse_into_entry(
-              max_recursion, is_lib, recursion_level, entry)) {
-        /* We have a directory we want to list, add it to todo list! */
-        BLI_join_dirfile(dir, sizeof(dir), root, entry->relpath);
-        BLI_path_normalize_dir(job_params->main_name, dir);
-        td_dir = BLI_stack_push_r(todo_dirs);
-        td_dir->level = recursion_level + 1;
-        td_dir->dir = BLI_strdup(dir);
-        nbr_todo_dirs++;
-      }
-    }
-
-    if (nbr_entries) {
-      BLI_mutex_lock(&job_params->lock);
-
-      *do_update = true;
 
-      BLI_movelisttolist(&filelist->filelist.entries, &entries);
-      filelist->filelist.nbr_entries += nbr_entries;
+  TodoDir *td_dir = MEM_mallocN(sizeof(*td_dir), __func__);
+  td_dir->level = 1;
+  td_dir->dir = BLI_strdup(dir);
 
-      BLI_mutex_unlock(&job_params->lock);
-    }
+  BLI_mutex_init(&data.lock);
 
-    nbr_done_dirs++;
-    *progress = (float)nbr_done_dirs / (float)nbr_todo_dirs;
-    MEM_freeN(subdir);
-  }
+  TaskPool *task_pool = BLI_task_pool_create(&data, TASK_PRIORITY_HIGH);
+  BLI_task_pool_push(
+      task_pool, filelist_readjob_dir_task, td_dir, true, filelist_readjob_dir_task_free);
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
 
-  /* If we were interrupted by stop, stack may not be empty and we need to free
-   * pending dir paths. */
-  while (!BLI_stack_is_empty(todo_dirs)) {
-    td_dir = BLI_stack_peek(todo_dirs);
-    MEM_freeN(td_dir->dir);
-    BLI_stack_discard(todo_dirs);
-  }
-  BLI_stack_free(todo_dirs);
+  BLI_mutex_end(&data.lock);
 }
 
 static void filelist_readjob_dir(FileListReadJob *job_params,
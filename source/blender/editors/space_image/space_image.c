@@ -306,6 +306,12 @@ static void image_refresh(const bContext *C, ScrArea *area)
       }
     }
   }
+  else if (ima && ima->type == IMA_TYPE_COMPOSITE && scene->nodetree) {
+    ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+    if (region && ED_node_composite_visible_region_outdated(scene->nodetree, &region->v2d.cur)) {
+      ED_node_composite_job(C, scene->nodetree, scene);
+    }
+  }
 }
 
 static void image_listener(const wmSpaceTypeListenerParams *params)
@@ -641,6 +647,12 @@ static void image_main_region_draw(const bContext *C, ARegion *region)
   /* we set view2d from own zoom and offset each time */
   image_main_region_set_view2d(sima, region);
 
+  /* Calculate the parts of the viewer that come into view. */
+  if (image && image->type == IMA_TYPE_COMPOSITE && scene->nodetree &&
+      ED_node_composite_visible_region_outdated(scene->nodetree, &v2d->cur)) {
+    ED_area_tag_refresh(CTX_wm_area(C));
+  }
+
   /* check for mask (delay draw) */
   if (!ED_space_image_show_uvedit(sima, obedit) && sima->mode == SI_MODE_MASK) {
     mask = ED_space_image_get_mask(sima);
@@ -659,6 +659,25 @@ static const char *info_statusbar_string(Main *bmain,
     uintptr_t mem_in_use = MEM_get_memory_in_use();
     BLI_str_format_byte_unit(formatted_mem, mem_in_use, false);
     ofs += BLI_snprintf_rlen(info + ofs, len, TIP_("Memory: %s"), formatted_mem);
+
+    /* Show what most of the memory is used for, when it's known. */
+    eMEMDomain largest_domain = MEM_DOMAIN_OTHER;
+    size_t largest_domain_mem = 0;
+    for (int i = MEM_DOMAIN_OTHER + 1; i < MEM_DOMAIN_NUM; i++) {
+      const size_t domain_mem = MEM_get_memory_in_use_domain((eMEMDomain)i);
+      if (domain_mem > largest_domain_mem) {
+        largest_domain = (eMEMDomain)i;
+        largest_domain_mem = domain_mem;
+      }
+    }
+    if (largest_domain_mem > mem_in_use / 4) {
+      BLI_str_format_byte_unit(formatted_mem, largest_domain_mem, false);
+      ofs += BLI_snprintf_rlen(info + ofs,
+                               len - ofs,
+                               TIP_(" (%s: %s)"),
+                               MEM_domain_name(largest_domain),
+                               formatted_mem);
+    }
   }
 
   /* GPU VRAM status. */
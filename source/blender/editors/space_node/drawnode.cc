@@ -60,6 +60,7 @@
 #include "RNA_define.h"
 
 #include "ED_node.h"
+#include "ED_screen.h"
 #include "ED_space_api.h"
 
 #include "WM_api.h"
@@ -3752,6 +3753,13 @@ void draw_nodespace_back_pix(const bContext *C,
     const float x = (region->winx - snode->zoom * ibuf->x) / 2 + snode->xof;
     const float y = (region->winy - snode->zoom * ibuf->y) / 2 + snode->yof;
 
+    /* Calculate the parts of the viewer that come into view. */
+    rctf visible_region;
+    ED_node_backdrop_visible_region_get(snode, region, ibuf->x, ibuf->y, &visible_region);
+    if (ED_node_composite_visible_region_outdated(snode->nodetree, &visible_region)) {
+      ED_area_tag_refresh(CTX_wm_area(C));
+    }
+
     /** \note draw selected info on backdrop */
     if (snode->edittree) {
       bNode *node = (bNode *)snode->edittree->nodes.first;
@@ -1576,6 +1576,87 @@ static void node_add_error_message_button(
   UI_block_emboss_set(node.block, UI_EMBOSS);
 }
 
+static std::optional<std::chrono::microseconds> node_get_execution_time(const SpaceNode &snode,
+                                                                       const bNode &node)
+{
+  if (node.type == NODE_GROUP) {
+    /* The time of a group node is the time of all the nodes inside of it. */
+    const geo_log::TreeLog *tree_log = geo_log::ModifierLog::find_tree_by_node_editor_context(
+        snode);
+    if (tree_log == nullptr) {
+      return std::nullopt;
+    }
+    const geo_log::TreeLog *child_log = tree_log->lookup_child_log(node.name);
+    if (child_log == nullptr) {
+      return std::nullopt;
+    }
+    return child_log->execution_time();
+  }
+  const geo_log::NodeLog *node_log = geo_log::ModifierLog::find_node_by_node_editor_context(snode,
+                                                                                            node);
+  if (node_log == nullptr) {
+    return std::nullopt;
+  }
+  return node_log->execution_time();
+}
+
+static std::optional<std::chrono::microseconds> node_get_compositor_execution_time(
+    const SpaceNode &snode, const bNodeInstanceKey key)
+{
+#ifdef WITH_COMPOSITOR
+  COM_NodeExecutionStats stats;
+  if (snode.id && GS(snode.id->name) == ID_SCE &&
+      COM_node_execution_stats_get((const Scene *)snode.id, key, &stats)) {
+    return std::chrono::microseconds((int64_t)(stats.wall_time * 1e6));
+  }
+#else
+  UNUSED_VARS(snode, key);
+#endif
+  return std::nullopt;
+}
+
+static void node_add_execution_time_label(const SpaceNode &snode,
+                                          const bNodeTree &ntree,
+                                          bNode &node,
+                                          const bNodeInstanceKey key,
+                                          const rctf &rect)
+{
+  if (!(snode.flag & SNODE_SHOW_TIMINGS)) {
+    return;
+  }
+  const std::optional<std::chrono::microseconds> exec_time =
+      (ntree.type == NTREE_COMPOSIT) ? node_get_compositor_execution_time(snode, key) :
+                                       node_get_execution_time(snode, node);
+  if (!exec_time.has_value()) {
+    return;
+  }
+
+  const double exec_time_ms = exec_time->count() / 1000.0;
+  char str[32];
+  if (exec_time_ms < 0.1) {
+    BLI_strncpy(str, "< 0.1 ms", sizeof(str));
+  }
+  else {
+    BLI_snprintf(str, sizeof(str), "%.1f ms", exec_time_ms);
+  }
+
+  /* Draw the time above the node header. */
+  uiDefBut(node.block,
+           UI_BTYPE_LABEL,
+           0,
+           str,
+           rect.xmin,
+           rect.ymax,
+           BLI_rctf_size_x(&rect),
+           UI_UNIT_Y,
+           nullptr,
+           0,
+           0,
+           0,
+           0,
+           "");
+}
+
 static void node_draw_basis(const bContext *C,
                             const View2D *v2d,
                             const SpaceNode *snode,
@@ -1694,6 +1775,7 @@ static void node_draw_basis(const bContext *C,
   }
 
   node_add_error_message_button(C, *ntree, *node, *rct, iconofs);
+  node_add_execution_time_label(*snode, *ntree, *node, key, *rct);
 
   /* Title. */
   if (node->flag & SELECT) {
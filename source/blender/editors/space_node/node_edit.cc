@@ -43,6 +43,7 @@
 #include "BKE_node.h"
 #include "BKE_report.h"
 #include "BKE_scene.h"
+#include "BKE_screen.h"
 #include "BKE_workspace.h"
 
 #include "DEG_depsgraph.h"
@@ -320,6 +321,96 @@ static void compo_startjob(void *cjv,
   ntree->progress = nullptr;
 }
 
+void ED_node_backdrop_visible_region_get(const SpaceNode *snode,
+                                         const ARegion *region,
+                                         const int width,
+                                         const int height,
+                                         rctf *r_region)
+{
+  /* Same placement as the backdrop drawing. */
+  const float x = (region->winx - snode->zoom * width) / 2 + snode->xof;
+  const float y = (region->winy - snode->zoom * height) / 2 + snode->yof;
+  r_region->xmin = -x / (snode->zoom * width);
+  r_region->xmax = (region->winx - x) / (snode->zoom * width);
+  r_region->ymin = -y / (snode->zoom * height);
+  r_region->ymax = (region->winy - y) / (snode->zoom * height);
+}
+
+bool ED_node_composite_visible_region_outdated(const bNodeTree *ntree, const rctf *visible_region)
+{
+  if (!(ntree->flag & NTREE_VISIBLE_REGION)) {
+    return false;
+  }
+  rctf region;
+  const rctf unit = {0.0f, 1.0f, 0.0f, 1.0f};
+  if (!BLI_rctf_isect(visible_region, &unit, &region)) {
+    return false;
+  }
+  return !BLI_rctf_inside_rctf(&ntree->visible_region, &region);
+}
+
+/**
+ * Union of the parts of the viewer image shown by node editor backdrops and image editors, in
+ * normalized coordinates. Returns false when it isn't known, in which case all of it is needed.
+ */
+static bool compo_visible_region_get(const bContext *C, const bNodeTree *nodetree, rctf *r_region)
+{
+  Main *bmain = CTX_data_main(C);
+  wmWindowManager *wm = CTX_wm_manager(C);
+  Image *ima = BKE_image_ensure_viewer(bmain, IMA_TYPE_COMPOSITE, "Viewer Node");
+
+  void *lock;
+  ImBuf *ibuf = BKE_image_acquire_ibuf(ima, nullptr, &lock);
+  const int width = ibuf ? ibuf->x : 0;
+  const int height = ibuf ? ibuf->y : 0;
+  BKE_image_release_ibuf(ima, ibuf, lock);
+  if (width == 0 || height == 0) {
+    return false;
+  }
+
+  bool found = false;
+  const rctf unit = {0.0f, 1.0f, 0.0f, 1.0f};
+  LISTBASE_FOREACH (wmWindow *, win, &wm->windows) {
+    const bScreen *screen = WM_window_get_active_screen(win);
+    ED_screen_areas_iter (win, screen, area) {
+      const ARegion *region = BKE_area_find_region_type(area, RGN_TYPE_WINDOW);
+      if (region == nullptr) {
+        continue;
+      }
+      rctf visible_region;
+      if (area->spacetype == SPACE_NODE) {
+        const SpaceNode *snode = (const SpaceNode *)area->spacedata.first;
+        if (snode->nodetree != nodetree || !(snode->flag & SNODE_BACKDRAW)) {
+          continue;
+        }
+        ED_node_backdrop_visible_region_get(snode, region, width, height, &visible_region);
+      }
+      else if (area->spacetype == SPACE_IMAGE) {
+        const SpaceImage *sima = (const SpaceImage *)area->spacedata.first;
+        if (sima->image != ima) {
+          continue;
+        }
+        visible_region = region->v2d.cur;
+      }
+      else {
+        continue;
+      }
+
+      if (!BLI_rctf_isect(&visible_region, &unit, &visible_region)) {
+        continue;
+      }
+      if (found) {
+        BLI_rctf_union(r_region, &visible_region);
+      }
+      else {
+        *r_region = visible_region;
+        found = true;
+      }
+    }
+  }
+  return found;
+}
+
 /**
  * \param scene_owner: is the owner of the job,
  * we don't use it for anything else currently so could also be a void pointer,
@@ -360,6 +451,12 @@ void ED_node_composite_job(const bContext *C, struct bNodeTree *nodetree, Scene
   cj->ntree = nodetree;
   cj->recalc_flags = compo_get_recalc_flags(C);
 
+  /* Copied to the evaluated tree, from which the compositor reads it. */
+  if ((nodetree->flag & NTREE_VISIBLE_REGION) &&
+      !compo_visible_region_get(C, nodetree, &nodetree->visible_region)) {
+    BLI_rctf_init(&nodetree->visible_region, 0.0f, 1.0f, 0.0f, 1.0f);
+  }
+
   /* setup job */
   WM_jobs_customdata_set(wm_job, cj, compo_freejob);
   WM_jobs_timer(wm_job, 0.1, NC_SCENE | ND_COMPO_RESULT, NC_SCENE | ND_COMPO_RESULT);
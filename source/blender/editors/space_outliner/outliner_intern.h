@@ -260,6 +260,7 @@ void outliner_build_tree(struct Main *mainvar,
 
 bool outliner_requires_rebuild_on_select_or_active_change(
     const struct SpaceOutliner *space_outliner);
+bool outliner_requires_rebuild_on_frame_change(const struct SpaceOutliner *space_outliner);
 bool outliner_requires_rebuild_on_open_change(const struct SpaceOutliner *space_outliner);
 
 typedef struct IDsSelectedData {
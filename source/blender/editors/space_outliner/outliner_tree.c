@@ -235,6 +235,16 @@ bool outliner_requires_rebuild_on_select_or_active_change(const SpaceOutliner *s
   return exclude_flags & (SO_FILTER_OB_STATE_SELECTED | SO_FILTER_OB_STATE_ACTIVE);
 }
 
+/**
+ * Check if the tree depends on the current frame. The tree structure itself doesn't change with
+ * the frame, only filtering on the object state can, since visibility can be animated.
+ */
+bool outliner_requires_rebuild_on_frame_change(const SpaceOutliner *space_outliner)
+{
+  int exclude_flags = outliner_exclude_filter_get(space_outliner);
+  return exclude_flags & (SO_FILTER_OB_STATE_VISIBLE | SO_FILTER_OB_STATE_SELECTABLE);
+}
+
 /**
  * Check if a display mode needs a full rebuild if the open/collapsed state changes.
  * Element types in these modes don't actually add children if collapsed, so the rebuild is needed.
@@ -25,6 +25,7 @@
 #include "DNA_sound_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 
 #include "BKE_context.h"
@@ -66,54 +67,74 @@ static void free_preview_job(void *data)
   MEM_freeN(pj);
 }
 
-/* Only this runs inside thread. */
-static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
-{
-  PreviewJob *pj = data;
-  PreviewJobAudio *previewjb;
+typedef struct PreviewJobWorker {
+  PreviewJob *pj;
+  short *stop;
+  short *do_update;
+  float *progress;
+} PreviewJobWorker;
 
+static PreviewJobAudio *preview_job_pop(PreviewJob *pj)
+{
   BLI_mutex_lock(pj->mutex);
-  previewjb = pj->previews.first;
+  PreviewJobAudio *previewjb = BLI_pophead(&pj->previews);
   BLI_mutex_unlock(pj->mutex);
+  return previewjb;
+}
 
-  while (previewjb) {
-    PreviewJobAudio *preview_next;
-    bSound *sound = previewjb->sound;
-
-    BKE_sound_read_waveform(previewjb->bmain, sound, stop);
-
-    if (*stop || G.is_break) {
-      BLI_mutex_lock(pj->mutex);
-      previewjb = previewjb->next;
-      BLI_mutex_unlock(pj->mutex);
-      while (previewjb) {
-        sound = previewjb->sound;
-
-        /* Make sure we cleanup the loading flag! */
-        BLI_spin_lock(sound->spinlock);
-        sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
-        BLI_spin_unlock(sound->spinlock);
-
-        BLI_mutex_lock(pj->mutex);
-        previewjb = previewjb->next;
-        BLI_mutex_unlock(pj->mutex);
-      }
-
-      BLI_mutex_lock(pj->mutex);
-      BLI_freelistN(&pj->previews);
-      pj->total = 0;
-      pj->processed = 0;
-      BLI_mutex_unlock(pj->mutex);
-      break;
-    }
+/* Every worker reads waveforms of sounds from the job until it is empty or stopped. */
+static void preview_worker_task(TaskPool *__restrict pool, void *UNUSED(taskdata))
+{
+  PreviewJobWorker *worker = BLI_task_pool_user_data(pool);
+  PreviewJob *pj = worker->pj;
+  PreviewJobAudio *previewjb;
+
+  while (!(*worker->stop || G.is_break) && (previewjb = preview_job_pop(pj))) {
+    BKE_sound_read_waveform(previewjb->bmain, previewjb->sound, worker->stop);
+    MEM_freeN(previewjb);
 
     BLI_mutex_lock(pj->mutex);
-    preview_next = previewjb->next;
-    BLI_freelinkN(&pj->previews, previewjb);
-    previewjb = preview_next;
     pj->processed++;
-    *progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
-    *do_update = true;
+    *worker->progress = (pj->total > 0) ? (float)pj->processed / (float)pj->total : 1.0f;
+    *worker->do_update = true;
+    BLI_mutex_unlock(pj->mutex);
+  }
+}
+
+/* Only this runs inside thread. */
+static void preview_startjob(void *data, short *stop, short *do_update, float *progress)
+{
+  PreviewJob *pj = data;
+
+  /* Sounds are independent, read the waveforms of several of them at once. Sounds added while
+   * the job runs are picked up by the workers. */
+  PreviewJobWorker worker = {
+      .pj = pj,
+      .stop = stop,
+      .do_update = do_update,
+      .progress = progress,
+  };
+  TaskPool *task_pool = BLI_task_pool_create(&worker, TASK_PRIORITY_LOW);
+  const int tot_thread = BLI_task_scheduler_num_threads();
+  for (int i = 0; i < tot_thread; i++) {
+    BLI_task_pool_push(task_pool, preview_worker_task, NULL, false, NULL);
+  }
+  BLI_task_pool_work_and_wait(task_pool);
+  BLI_task_pool_free(task_pool);
+
+  if (*stop || G.is_break) {
+    BLI_mutex_lock(pj->mutex);
+    LISTBASE_FOREACH (PreviewJobAudio *, previewjb, &pj->previews) {
+      bSound *sound = previewjb->sound;
+
+      /* Make sure we cleanup the loading flag! */
+      BLI_spin_lock(sound->spinlock);
+      sound->tags &= ~SOUND_TAGS_WAVEFORM_LOADING;
+      BLI_spin_unlock(sound->spinlock);
+    }
+    BLI_freelistN(&pj->previews);
+    pj->total = 0;
+    pj->processed = 0;
     BLI_mutex_unlock(pj->mutex);
   }
 }
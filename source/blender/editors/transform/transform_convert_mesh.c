@@ -2094,6 +2094,11 @@ void recalcData_mesh(TransInfo *t)
   tc_mesh_partial_types_calc(t, &partial_state);
 
   FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    /* Custom-data correction changes UV's too, other buffers than positions need updating. */
+    struct TransCustomDataMesh *tcmd = tc->custom.type.data;
+    BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+    em->is_deform_only_update = (tcmd == NULL) || (tcmd->cd_layer_correct == NULL);
+
     DEG_id_tag_update(tc->obedit->data, ID_RECALC_GEOMETRY);
 
     tc_mesh_partial_update(t, tc, &partial_state);
@@ -2110,6 +2115,11 @@ void special_aftertrans_update__mesh(bContext *UNUSED(C), TransInfo *t)
   const bool is_canceling = (t->state == TRANS_CANCEL);
   const bool use_automerge = !is_canceling && (t->flag & (T_AUTOMERGE | T_AUTOSPLIT)) != 0;
 
+  FOREACH_TRANS_DATA_CONTAINER (t, tc) {
+    BMEditMesh *em = BKE_editmesh_from_object(tc->obedit);
+    em->is_deform_only_update = false;
+  }
+
   if (!is_canceling && ELEM(t->mode, TFM_EDGE_SLIDE, TFM_VERT_SLIDE)) {
     /* NOTE(joeedh): Handle multi-res re-projection,
      * done on transform completion since it's really slow. */
@@ -520,6 +520,117 @@ static void iter_snap_objects(SnapObjectContext *sctx,
   }
 }
 
+/**
+ * An object to snap to, as passed to #IterSnapObjsCallback.
+ */
+typedef struct SnapObjectCandidate {
+  Object *ob_eval;
+  /* May not be #Object.obmat with dupli-instances. */
+  float obmat[4][4];
+  bool is_object_active;
+  /** Sort key, e.g. the distance along a ray to the world space bounds of the object. */
+  float depth;
+} SnapObjectCandidate;
+
+typedef struct SnapObjectCandidates {
+  SnapObjectCandidate *data;
+  int len;
+  int len_alloc;
+} SnapObjectCandidates;
+
+static void snap_object_candidates_add_fn(SnapObjectContext *UNUSED(sctx),
+                                          Object *ob_eval,
+                                          float obmat[4][4],
+                                          eSnapEditType UNUSED(edit_mode_type),
+                                          bool UNUSED(use_backface_culling),
+                                          bool is_object_active,
+                                          void *data)
+{
+  SnapObjectCandidates *candidates = data;
+  if (candidates->len == candidates->len_alloc) {
+    candidates->len_alloc = max_ii(64, candidates->len_alloc * 2);
+    candidates->data = MEM_reallocN(candidates->data,
+                                    sizeof(*candidates->data) * (size_t)candidates->len_alloc);
+  }
+  SnapObjectCandidate *candidate = &candidates->data[candidates->len++];
+  candidate->ob_eval = ob_eval;
+  copy_m4_m4(candidate->obmat, obmat);
+  candidate->is_object_active = is_object_active;
+  candidate->depth = 0.0f;
+}
+
+static int snap_object_candidate_depth_cmp(const void *arg1, const void *arg2)
+{
+  const SnapObjectCandidate *candidate1 = arg1;
+  const SnapObjectCandidate *candidate2 = arg2;
+  if (candidate1->depth < candidate2->depth) {
+    return -1;
+  }
+  if (candidate1->depth > candidate2->depth) {
+    return 1;
+  }
+  return 0;
+}
+
+/**
+ * Same as #iter_snap_objects, but for ray-casts on the nearest hit only: objects are visited in
+ * order of distance to their world space bounds along the ray. Objects whose bounds are missed by
+ * the ray, or are behind the nearest hit found so far, are skipped without testing their geometry.
+ */
+static void iter_snap_objects_along_ray(SnapObjectContext *sctx,
+                                        const struct SnapObjectParams *params,
+                                        const float ray_start[3],
+                                        const float ray_dir[3],
+                                        const float *ray_depth,
+                                        IterSnapObjsCallback sob_callback,
+                                        void *data)
+{
+  SnapObjectCandidates candidates = {NULL};
+  iter_snap_objects(sctx, params, snap_object_candidates_add_fn, &candidates);
+
+  int candidates_len = 0;
+  for (int i = 0; i < candidates.len; i++) {
+    SnapObjectCandidate *candidate = &candidates.data[i];
+    float depth = 0.0f;
+    /* Geometry of objects in edit-mode may be more recent than their bounds, always test them. */
+    BoundBox *bb = BKE_object_is_in_editmode(candidate->ob_eval) ?
+                       NULL :
+                       BKE_object_boundbox_get(candidate->ob_eval);
+    if (bb) {
+      float min[3], max[3];
+      BKE_boundbox_minmax(bb, candidate->obmat, min, max);
+      if (!isect_ray_aabb_v3_simple(ray_start, ray_dir, min, max, &depth, NULL)) {
+        continue;
+      }
+      depth = max_ff(depth, 0.0f);
+    }
+    candidate->depth = depth;
+    candidates.data[candidates_len++] = *candidate;
+  }
+
+  qsort(candidates.data,
+        (size_t)candidates_len,
+        sizeof(*candidates.data),
+        snap_object_candidate_depth_cmp);
+
+  for (int i = 0; i < candidates_len; i++) {
+    const SnapObjectCandidate *candidate = &candidates.data[i];
+    if (candidate->depth > *ray_depth) {
+      /* All remaining objects are further away than the nearest hit. */
+      break;
+    }
+    sob_callback(sctx,
+                 candidate->ob_eval,
+                 (float(*)[4])candidate->obmat,
+                 params->edit_mode_type,
+                 params->use_backface_culling,
+                 candidate->is_object_active,
+                 data);
+  }
+
+  MEM_SAFE_FREE(candidates.data);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -725,6 +836,10 @@ static bool raycastMesh(SnapObjectContext *sctx,
             ray_start_local, ray_normal_local, bb->vec[0], bb->vec[6], &len_diff, NULL)) {
       return retval;
     }
+    if (len_diff > local_depth) {
+      /* The bounds are behind a closer hit. */
+      return retval;
+    }
   }
   /* We pass a temp ray_start, set from object's boundbox, to avoid precision issues with
    * very far away ray_start values (as returned in case of ortho view3d), see T50486, T38358.
@@ -864,6 +979,10 @@ static bool raycastEditMesh(SnapObjectContext *sctx,
           ray_start_local, ray_normal_local, sod->min, sod->max, &len_diff, NULL)) {
     return retval;
   }
+  if (len_diff > local_depth) {
+    /* The bounds are behind a closer hit. */
+    return retval;
+  }
 
   /* We pass a temp ray_start, set from object's boundbox, to avoid precision issues with
    * very far away ray_start values (as returned in case of ortho view3d), see T50486, T38358.
@@ -1174,7 +1293,13 @@ static bool raycastObjects(SnapObjectContext *sctx,
       .ret = false,
   };
 
-  iter_snap_objects(sctx, params, raycast_obj_fn, &data);
+  if (r_hit_list) {
+    iter_snap_objects(sctx, params, raycast_obj_fn, &data);
+  }
+  else {
+    iter_snap_objects_along_ray(
+        sctx, params, ray_start, ray_dir, ray_depth, raycast_obj_fn, &data);
+  }
 
   return data.ret;
 }
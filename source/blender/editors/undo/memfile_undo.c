@@ -66,6 +66,10 @@ typedef struct MemFileUndoStep {
   MemFileUndoData *data;
 } MemFileUndoStep;
 
+/* Number of memfile steps behind the newest one after which a step gets compressed,
+ * being that far back it is unlikely to be loaded again. */
+#define MEMFILE_UNDO_COMPRESS_STEP_OFFSET 3
+
 static bool memfile_undosys_poll(bContext *C)
 {
   /* other poll functions must run first, this is a catch-all. */
@@ -101,6 +105,19 @@ static bool memfile_undosys_step_encode(struct bContext *UNUSED(C),
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : NULL);
   us->step.data_size = us->data->undo_size;
 
+  /* Compress an older step, keeping the memory it shares with its next step as is. */
+  MemFileUndoStep *us_compress_next = us;
+  MemFileUndoStep *us_compress = us_prev;
+  for (int i = 1; i < MEMFILE_UNDO_COMPRESS_STEP_OFFSET && us_compress != NULL; i++) {
+    us_compress_next = us_compress;
+    us_compress = (MemFileUndoStep *)BKE_undosys_step_same_type_prev(&us_compress->step);
+  }
+  if (us_compress != NULL) {
+    BLO_memfile_compress(&us_compress->data->memfile, &us_compress_next->data->memfile);
+    us_compress->data->undo_size = us_compress->data->memfile.size;
+    us_compress->step.data_size = us_compress->data->undo_size;
+  }
+
   /* Store the fact that we should not re-use old data with that undo step, and reset the Main
    * flag. */
   us->step.use_old_bmain_data = !bmain->use_memfile_full_barrier;
@@ -192,6 +209,10 @@ static void memfile_undosys_step_decode(struct bContext *C,
   MemFileUndoStep *us = (MemFileUndoStep *)us_p;
   BKE_memfile_undo_decode(us->data, undo_direction, use_old_bmain_data, C);
 
+  /* Reading decompresses the chunks it needs, account for the memory they use now. */
+  us->data->undo_size = us->data->memfile.size;
+  us->step.data_size = us->data->undo_size;
+
   for (UndoStep *us_iter = us_p->next; us_iter; us_iter = us_iter->next) {
     if (BKE_UNDOSYS_TYPE_IS_MEMFILE_SKIP(us_iter->type)) {
       continue;
@@ -61,6 +61,12 @@ template<typename In1, typename Out1> class CustomMF_SI_SO : public MultiFunctio
   template<typename ElementFuncT> static FunctionT create_function(ElementFuncT element_fn)
   {
     return [=](IndexMask mask, const VArray<In1> &in1, MutableSpan<Out1> out1) {
+      if (in1.is_single()) {
+        /* The element function only depends on its inputs, so it has to be called only once. */
+        const Out1 value = element_fn(in1.get_internal_single());
+        mask.foreach_index([&](int i) { new (static_cast<void *>(&out1[i])) Out1(value); });
+        return;
+      }
       /* Devirtualization results in a 2-3x speedup for some simple functions. */
       devirtualize_varray(in1, [&](const auto &in1) {
         mask.foreach_index(
@@ -114,6 +120,11 @@ class CustomMF_SI_SI_SO : public MultiFunction {
                const VArray<In1> &in1,
                const VArray<In2> &in2,
                MutableSpan<Out1> out1) {
+      if (in1.is_single() && in2.is_single()) {
+        const Out1 value = element_fn(in1.get_internal_single(), in2.get_internal_single());
+        mask.foreach_index([&](int i) { new (static_cast<void *>(&out1[i])) Out1(value); });
+        return;
+      }
       /* Devirtualization results in a 2-3x speedup for some simple functions. */
       devirtualize_varray2(in1, in2, [&](const auto &in1, const auto &in2) {
         mask.foreach_index(
@@ -174,9 +185,15 @@ class CustomMF_SI_SI_SI_SO : public MultiFunction {
                const VArray<In2> &in2,
                const VArray<In3> &in3,
                MutableSpan<Out1> out1) {
-      mask.foreach_index([&](int i) {
-        new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
-      });
+      devirtualize_varrays(
+          [&](const auto &in1, const auto &in2, const auto &in3) {
+            mask.foreach_index([&](int i) {
+              new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i]));
+            });
+          },
+          in1,
+          in2,
+          in3);
     };
   }
 
@@ -237,9 +254,17 @@ class CustomMF_SI_SI_SI_SI_SO : public MultiFunction {
                const VArray<In3> &in3,
                const VArray<In4> &in4,
                MutableSpan<Out1> out1) {
-      mask.foreach_index([&](int i) {
-        new (static_cast<void *>(&out1[i])) Out1(element_fn(in1[i], in2[i], in3[i], in4[i]));
-      });
+      devirtualize_varrays(
+          [&](const auto &in1, const auto &in2, const auto &in3, const auto &in4) {
+            mask.foreach_index([&](int i) {
+              new (static_cast<void *>(&out1[i]))
+                  Out1(element_fn(in1[i], in2[i], in3[i], in4[i]));
+            });
+          },
+          in1,
+          in2,
+          in3,
+          in4);
     };
   }
 
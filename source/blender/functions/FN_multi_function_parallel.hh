@@ -20,10 +20,23 @@
  * \ingroup fn
  */
 
+#include "BLI_function_ref.hh"
+
 #include "FN_multi_function.hh"
 
 namespace blender::fn {
 
+/**
+ * Calls `call_fn` with the part of `full_mask` referenced by `mask_slice`. The indices and all
+ * parameters are offset so that the sub-mask starts close to zero, so buffers allocated by the
+ * called function only have to cover the slice. Vector parameters are not supported.
+ */
+void call_with_sliced_params(const MultiFunction &fn,
+                             IndexMask full_mask,
+                             IndexRange mask_slice,
+                             MFParams params,
+                             FunctionRef<void(IndexMask sub_mask, MFParams sub_params)> call_fn);
+
 class ParallelMultiFunction : public MultiFunction {
  private:
   const MultiFunction &fn_;
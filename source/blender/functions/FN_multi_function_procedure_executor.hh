@@ -29,8 +29,15 @@ class MFProcedureExecutor : public MultiFunction {
  private:
   MFSignature signature_;
   const MFProcedure &procedure_;
+  bool chunking_supported_;
 
  public:
+  /**
+   * Large masks are evaluated in chunks of this size, to limit the memory used by temporary
+   * buffers and to keep them in the cache.
+   */
+  static constexpr int64_t chunk_size = 4096;
+
   MFProcedureExecutor(std::string name, const MFProcedure &procedure);
 
   void call(IndexMask mask, MFParams params, MFContext context) const override;
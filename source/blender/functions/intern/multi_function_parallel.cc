@@ -20,6 +20,59 @@
 
 namespace blender::fn {
 
+void call_with_sliced_params(const MultiFunction &fn,
+                             const IndexMask full_mask,
+                             const IndexRange mask_slice,
+                             MFParams params,
+                             FunctionRef<void(IndexMask sub_mask, MFParams sub_params)> call_fn)
+{
+  Vector<int64_t> sub_mask_indices;
+  const IndexMask sub_mask = full_mask.slice_and_offset(mask_slice, sub_mask_indices);
+  if (sub_mask.is_empty()) {
+    return;
+  }
+  const int64_t input_slice_start = full_mask[mask_slice.first()];
+  const int64_t input_slice_size = full_mask[mask_slice.last()] - input_slice_start + 1;
+  const IndexRange input_slice_range{input_slice_start, input_slice_size};
+
+  MFParamsBuilder sub_params{fn, sub_mask.min_array_size()};
+  ResourceScope &scope = sub_params.resource_scope();
+
+  /* All parameters are sliced so that the called function does not have to take care of the index
+   * offset. */
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType param_type = fn.param_type(param_index);
+    switch (param_type.category()) {
+      case MFParamType::SingleInput: {
+        const GVArray &varray = params.readonly_single_input(param_index);
+        const GVArray &sliced_varray = scope.construct<GVArray_Slice>(varray, input_slice_range);
+        sub_params.add_readonly_single_input(sliced_varray);
+        break;
+      }
+      case MFParamType::SingleMutable: {
+        const GMutableSpan span = params.single_mutable(param_index);
+        const GMutableSpan sliced_span = span.slice(input_slice_start, input_slice_size);
+        sub_params.add_single_mutable(sliced_span);
+        break;
+      }
+      case MFParamType::SingleOutput: {
+        const GMutableSpan span = params.uninitialized_single_output(param_index);
+        const GMutableSpan sliced_span = span.slice(input_slice_start, input_slice_size);
+        sub_params.add_uninitialized_single_output(sliced_span);
+        break;
+      }
+      case MFParamType::VectorInput:
+      case MFParamType::VectorMutable:
+      case MFParamType::VectorOutput: {
+        BLI_assert_unreachable();
+        break;
+      }
+    }
+  }
+
+  call_fn(sub_mask, sub_params);
+}
+
 ParallelMultiFunction::ParallelMultiFunction(const MultiFunction &fn, const int64_t grain_size)
     : fn_(fn), grain_size_(grain_size)
 {
@@ -44,51 +97,10 @@ void ParallelMultiFunction::call(IndexMask full_mask, MFParams params, MFContext
   }
 
   threading::parallel_for(full_mask.index_range(), grain_size_, [&](const IndexRange mask_slice) {
-    Vector<int64_t> sub_mask_indices;
-    const IndexMask sub_mask = full_mask.slice_and_offset(mask_slice, sub_mask_indices);
-    if (sub_mask.is_empty()) {
-      return;
-    }
-    const int64_t input_slice_start = full_mask[mask_slice.first()];
-    const int64_t input_slice_size = full_mask[mask_slice.last()] - input_slice_start + 1;
-    const IndexRange input_slice_range{input_slice_start, input_slice_size};
-
-    MFParamsBuilder sub_params{fn_, sub_mask.min_array_size()};
-    ResourceScope &scope = sub_params.resource_scope();
-
-    /* All parameters are sliced so that the wrapped multi-function does not have to take care of
-     * the index offset. */
-    for (const int param_index : fn_.param_indices()) {
-      const MFParamType param_type = fn_.param_type(param_index);
-      switch (param_type.category()) {
-        case MFParamType::SingleInput: {
-          const GVArray &varray = params.readonly_single_input(param_index);
-          const GVArray &sliced_varray = scope.construct<GVArray_Slice>(varray, input_slice_range);
-          sub_params.add_readonly_single_input(sliced_varray);
-          break;
-        }
-        case MFParamType::SingleMutable: {
-          const GMutableSpan span = params.single_mutable(param_index);
-          const GMutableSpan sliced_span = span.slice(input_slice_start, input_slice_size);
-          sub_params.add_single_mutable(sliced_span);
-          break;
-        }
-        case MFParamType::SingleOutput: {
-          const GMutableSpan span = params.uninitialized_single_output(param_index);
-          const GMutableSpan sliced_span = span.slice(input_slice_start, input_slice_size);
-          sub_params.add_uninitialized_single_output(sliced_span);
-          break;
-        }
-        case MFParamType::VectorInput:
-        case MFParamType::VectorMutable:
-        case MFParamType::VectorOutput: {
-          BLI_assert_unreachable();
-          break;
-        }
-      }
-    }
-
-    fn_.call(sub_mask, sub_params, context);
+    call_with_sliced_params(
+        fn_, full_mask, mask_slice, params, [&](IndexMask sub_mask, MFParams sub_params) {
+          fn_.call(sub_mask, sub_params, context);
+        });
   });
 }
 
@@ -14,6 +14,7 @@
  * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
  */
 
+#include "FN_multi_function_parallel.hh"
 #include "FN_multi_function_procedure_executor.hh"
 
 #include "BLI_stack.hh"
@@ -31,6 +32,15 @@ MFProcedureExecutor::MFProcedureExecutor(std::string name, const MFProcedure &pr
 
   signature_ = signature.build();
   this->set_signature(&signature_);
+
+  chunking_supported_ = true;
+  for (const ConstMFParameter &param : procedure.params()) {
+    if (param.variable->data_type().category() == MFDataType::Vector) {
+      /* Vector parameters can't be sliced yet. */
+      chunking_supported_ = false;
+      break;
+    }
+  }
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -149,9 +159,14 @@ class ValueAllocator : NonCopyable, NonMovable {
   /* The integer key is the size of one element (e.g. 4 for an integer buffer). All buffers are
    * aligned to #min_alignment bytes. */
   Map<int, Stack<void *>> span_buffers_free_list_;
+  /* Number of elements of every span buffer, so that buffers can be reused for all chunks that
+   * are evaluated with the same allocator. */
+  int64_t span_buffer_size_;
 
  public:
-  ValueAllocator() = default;
+  ValueAllocator(const int64_t span_buffer_size) : span_buffer_size_(span_buffer_size)
+  {
+  }
 
   ~ValueAllocator()
   {
@@ -188,19 +203,22 @@ class ValueAllocator : NonCopyable, NonMovable {
 
   VariableValue_Span *obtain_Span(const CPPType &type, int size)
   {
+    BLI_assert(size <= span_buffer_size_);
+    UNUSED_VARS_NDEBUG(size);
     void *buffer = nullptr;
 
     const int element_size = type.size();
     const int alignment = type.alignment();
+    const size_t buffer_size = (size_t)element_size * (size_t)span_buffer_size_;
 
     if (alignment > min_alignment) {
       /* In this rare case we fallback to not reusing existing buffers. */
-      buffer = MEM_mallocN_aligned(element_size * size, alignment, __func__);
+      buffer = MEM_mallocN_aligned(buffer_size, alignment, __func__);
     }
     else {
       Stack<void *> *stack = span_buffers_free_list_.lookup_ptr(element_size);
       if (stack == nullptr || stack->is_empty()) {
-        buffer = MEM_mallocN_aligned(element_size * size, min_alignment, __func__);
+        buffer = MEM_mallocN_aligned(buffer_size, min_alignment, __func__);
       }
       else {
         /* Reuse existing buffer. */
@@ -812,12 +830,13 @@ void ValueAllocator::release_variable_state(VariableState *state)
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   Map<const MFVariable *, VariableState *> variable_states_;
   IndexMask full_mask_;
 
  public:
-  VariableStates(IndexMask full_mask) : full_mask_(full_mask)
+  VariableStates(ValueAllocator &value_allocator, IndexMask full_mask)
+      : value_allocator_(value_allocator), full_mask_(full_mask)
   {
   }
 
@@ -1157,17 +1176,18 @@ class InstructionScheduler {
   }
 };
 
-void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+static void execute_procedure(const MFProcedureExecutor &fn,
+                              const MFProcedure &procedure,
+                              IndexMask full_mask,
+                              MFParams params,
+                              MFContext context,
+                              ValueAllocator &value_allocator)
 {
-  BLI_assert(procedure_.validate());
-
-  LinearAllocator<> allocator;
-
-  VariableStates variable_states{full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  VariableStates variable_states{value_allocator, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (NextInstructionInfo instr_info = scheduler.pop_next()) {
@@ -1213,9 +1233,9 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const MFParamType param_type = this->param_type(param_index);
-    const MFVariable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const MFParamType param_type = fn.param_type(param_index);
+    const MFVariable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case MFParamType::Input: {
@@ -1236,4 +1256,37 @@ void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext c
   }
 }
 
+void MFProcedureExecutor::call(IndexMask full_mask, MFParams params, MFContext context) const
+{
+  BLI_assert(procedure_.validate());
+
+  if (full_mask.size() <= chunk_size || !chunking_supported_) {
+    ValueAllocator value_allocator{full_mask.min_array_size()};
+    execute_procedure(*this, procedure_, full_mask, params, context, value_allocator);
+    return;
+  }
+
+  /* Evaluate the procedure on chunks of the mask one after another. Temporary buffers then only
+   * have to be large enough for a single chunk and are reused for every chunk. */
+  const int64_t chunks_num = (full_mask.size() + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    const int64_t start = chunk * chunk_size;
+    return IndexRange(start, std::min(chunk_size, full_mask.size() - start));
+  };
+  int64_t max_chunk_array_size = 0;
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    const IndexRange range = chunk_range(chunk);
+    max_chunk_array_size = std::max(max_chunk_array_size,
+                                    full_mask[range.last()] - full_mask[range.first()] + 1);
+  }
+
+  ValueAllocator value_allocator{max_chunk_array_size};
+  const auto execute_chunk = [&](IndexMask sub_mask, MFParams sub_params) {
+    execute_procedure(*this, procedure_, sub_mask, sub_params, context, value_allocator);
+  };
+  for (const int64_t chunk : IndexRange(chunks_num)) {
+    call_with_sliced_params(*this, full_mask, chunk_range(chunk), params, execute_chunk);
+  }
+}
+
 }  // namespace blender::fn
@@ -55,6 +55,58 @@ TEST(multi_function_procedure, SimpleTest)
   EXPECT_EQ(output_array[2], 19);
 }
 
+TEST(multi_function_procedure, ChunkedEvaluation)
+{
+  /**
+   * procedure(int var1, int *var3) {
+   *   int var2 = var1 + var1;
+   *   var3 = var2 + var1;
+   * }
+   */
+
+  CustomMF_SI_SI_SO<int, int, int> add_fn{"add", [](int a, int b) { return a + b; }};
+
+  MFProcedure procedure;
+  MFProcedureBuilder builder{procedure};
+
+  MFVariable *var1 = &builder.add_single_input_parameter<int>();
+  auto [var2] = builder.add_call<1>(add_fn, {var1, var1});
+  auto [var3] = builder.add_call<1>(add_fn, {var2, var1});
+  builder.add_destruct({var1, var2});
+  builder.add_return();
+  builder.add_output_parameter(*var3);
+
+  EXPECT_TRUE(procedure.validate());
+
+  MFProcedureExecutor executor{"My Procedure", procedure};
+
+  /* Use a sparse mask that spans multiple chunks. */
+  const int size = MFProcedureExecutor::chunk_size * 5 + 7;
+  Vector<int64_t> mask_indices;
+  for (int i = 0; i < size; i++) {
+    if (i % 3 != 1) {
+      mask_indices.append(i);
+    }
+  }
+
+  Array<int> input_array(size);
+  for (const int i : input_array.index_range()) {
+    input_array[i] = i;
+  }
+  Array<int> output_array(size, -1);
+
+  MFParamsBuilder params{executor, size};
+  MFContextBuilder context;
+  params.add_readonly_single_input(input_array.as_span());
+  params.add_uninitialized_single_output(output_array.as_mutable_span());
+
+  executor.call(mask_indices.as_span(), params, context);
+
+  for (const int i : output_array.index_range()) {
+    EXPECT_EQ(output_array[i], (i % 3 == 1) ? -1 : i * 3);
+  }
+}
+
 TEST(multi_function_procedure, BranchTest)
 {
   /**
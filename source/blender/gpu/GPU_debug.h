@@ -36,6 +36,23 @@ void GPU_debug_group_end(void);
 void GPU_debug_get_groups_names(int name_buf_len, char *r_name_buf);
 bool GPU_debug_group_match(const char *ref);
 
+/**
+ * GPU timer queries, measuring the time the GPU spends on the commands issued between
+ * #GPU_timer_begin and #GPU_timer_end. Results are only available a few frames later, so
+ * callers should keep several pools around and read the results of older ones.
+ */
+typedef struct GPUTimerPool GPUTimerPool;
+
+GPUTimerPool *GPU_timer_pool_create(void);
+void GPU_timer_pool_free(GPUTimerPool *pool);
+void GPU_timer_pool_reset(GPUTimerPool *pool);
+int GPU_timer_pool_len(const GPUTimerPool *pool);
+/** Returns the index of the started timer. Timers cannot be nested. */
+int GPU_timer_begin(GPUTimerPool *pool);
+void GPU_timer_end(GPUTimerPool *pool);
+/** Returns false if the GPU has not finished executing the commands of this timer yet. */
+bool GPU_timer_result_get(GPUTimerPool *pool, int index, uint64_t *r_time_ns);
+
 #ifdef __cplusplus
 }
 #endif
@@ -198,6 +198,7 @@ GPUMaterial *GPU_material_from_nodetree(struct Scene *scene,
                                         const char *name,
                                         GPUMaterialEvalCallbackFn callback);
 void GPU_material_compile(GPUMaterial *mat);
+void GPU_materials_compile(GPUMaterial **materials, int materials_len);
 void GPU_material_free(struct ListBase *gpumaterial);
 
 void GPU_materials_free(struct Main *bmain);
@@ -66,6 +66,19 @@ GPUShader *GPU_shader_create_ex(const char *vertcode,
                                 const char **tf_names,
                                 const int tf_count,
                                 const char *shname);
+/**
+ * Same as #GPU_shader_create but without waiting for the driver to compile the shader.
+ * #GPU_shader_compile_wait must be called before any other use of it. Creating several shaders
+ * before waiting on the first one lets drivers with parallel compilation compile them together.
+ */
+GPUShader *GPU_shader_create_async(const char *vertcode,
+                                   const char *fragcode,
+                                   const char *geomcode,
+                                   const char *libcode,
+                                   const char *defines,
+                                   const char *shname);
+/* Return the shader, or NULL after freeing it if it failed to compile. */
+GPUShader *GPU_shader_compile_wait(GPUShader *shader);
 
 struct GPU_ShaderCreateFromArray_Params {
   const char **vert, **geom, **frag, **defs;
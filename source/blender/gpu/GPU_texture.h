@@ -291,6 +291,7 @@ void GPU_texture_py_reference_set(GPUTexture *tex, void **py_ref);
 int GPU_texture_opengl_bindcode(const GPUTexture *tex);
 
 void GPU_texture_get_mipmap_size(GPUTexture *tex, int lvl, int *size);
+size_t GPU_texture_memory_size(const GPUTexture *tex);
 
 /* utilities */
 size_t GPU_texture_component_len(eGPUTextureFormat format);
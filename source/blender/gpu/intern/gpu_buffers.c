@@ -61,6 +61,10 @@ struct GPU_PBVH_Buffers {
   GPUIndexBuf *index_buf, *index_buf_fast;
   GPUIndexBuf *index_lines_buf, *index_lines_buf_fast;
   GPUVertBuf *vert_buf;
+  /* Mesh nodes keep the mask and colors in their own buffers, so they can be updated without
+   * uploading the positions and normals again. */
+  GPUVertBuf *msk_buf;
+  GPUVertBuf *col_buf;
 
   GPUBatch *lines;
   GPUBatch *lines_fast;
@@ -96,11 +100,17 @@ struct GPU_PBVH_Buffers {
   bool smooth;
 
   bool show_overlay;
+  /* Overlays of mesh buffers, kept for partial updates. */
+  bool empty_mask;
+  bool default_face_set;
 };
 
 static struct {
   GPUVertFormat format;
   uint pos, nor, msk, col, fset;
+  /* Mesh nodes split the vertex buffer format. */
+  GPUVertFormat mesh_format, msk_format, col_format;
+  uint mesh_pos, mesh_nor, mesh_fset, mesh_msk, mesh_col;
 } g_vbo_id = {{0}};
 
 /** \} */
@@ -124,6 +134,17 @@ void gpu_pbvh_init()
         &g_vbo_id.format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
     g_vbo_id.fset = GPU_vertformat_attr_add(
         &g_vbo_id.format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+
+    g_vbo_id.mesh_pos = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "pos", GPU_COMP_F32, 3, GPU_FETCH_FLOAT);
+    g_vbo_id.mesh_nor = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "nor", GPU_COMP_I16, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.mesh_fset = GPU_vertformat_attr_add(
+        &g_vbo_id.mesh_format, "fset", GPU_COMP_U8, 3, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.mesh_msk = GPU_vertformat_attr_add(
+        &g_vbo_id.msk_format, "msk", GPU_COMP_U8, 1, GPU_FETCH_INT_TO_FLOAT_UNIT);
+    g_vbo_id.mesh_col = GPU_vertformat_attr_add(
+        &g_vbo_id.col_format, "ac", GPU_COMP_U16, 4, GPU_FETCH_INT_TO_FLOAT_UNIT);
   }
 }
 
@@ -134,58 +155,74 @@ void gpu_pbvh_exit()
 
 /* Allocates a non-initialized buffer to be sent to GPU.
  * Return is false it indicates that the memory map failed. */
-static bool gpu_pbvh_vert_buf_data_set(GPU_PBVH_Buffers *buffers, uint vert_len)
+static bool gpu_pbvh_vert_buf_data_set(GPUVertBuf **vert_buf,
+                                       const GPUVertFormat *format,
+                                       uint vert_len)
 {
   /* Keep so we can test #GPU_USAGE_DYNAMIC buffer use.
    * Not that format initialization match in both blocks.
    * Do this to keep braces balanced - otherwise indentation breaks. */
 #if 0
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_DYNAMIC);
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DYNAMIC);
+    GPU_vertbuf_data_alloc(*vert_buf, vert_len);
   }
-  else if (vert_len != buffers->vert_buf->vertex_len) {
-    GPU_vertbuf_data_resize(buffers->vert_buf, vert_len);
+  else if (vert_len != (*vert_buf)->vertex_len) {
+    GPU_vertbuf_data_resize(*vert_buf, vert_len);
   }
 #else
-  if (buffers->vert_buf == NULL) {
+  if (*vert_buf == NULL) {
     /* Initialize vertex buffer (match 'VertexBufferFormat'). */
-    buffers->vert_buf = GPU_vertbuf_create_with_format_ex(&g_vbo_id.format, GPU_USAGE_STATIC);
+    *vert_buf = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
   }
-  if (GPU_vertbuf_get_data(buffers->vert_buf) == NULL ||
-      GPU_vertbuf_get_vertex_len(buffers->vert_buf) != vert_len) {
+  if (GPU_vertbuf_get_data(*vert_buf) == NULL ||
+      GPU_vertbuf_get_vertex_len(*vert_buf) != vert_len) {
     /* Allocate buffer if not allocated yet or size changed. */
-    GPU_vertbuf_data_alloc(buffers->vert_buf, vert_len);
+    GPU_vertbuf_data_alloc(*vert_buf, vert_len);
   }
 #endif
 
-  return GPU_vertbuf_get_data(buffers->vert_buf) != NULL;
+  return GPU_vertbuf_get_data(*vert_buf) != NULL;
+}
+
+static GPUBatch *gpu_pbvh_batch_create(GPU_PBVH_Buffers *buffers,
+                                       GPUPrimType prim,
+                                       GPUIndexBuf *index_buf)
+{
+  GPUBatch *batch = GPU_batch_create(prim, buffers->vert_buf, index_buf);
+  if (buffers->msk_buf) {
+    GPU_batch_vertbuf_add(batch, buffers->msk_buf);
+  }
+  if (buffers->col_buf) {
+    GPU_batch_vertbuf_add(batch, buffers->col_buf);
+  }
+  return batch;
 }
 
 static void gpu_pbvh_batch_init(GPU_PBVH_Buffers *buffers, GPUPrimType prim)
 {
   if (buffers->triangles == NULL) {
-    buffers->triangles = GPU_batch_create(prim,
-                                          buffers->vert_buf,
-                                          /* can be NULL if buffer is empty */
-                                          buffers->index_buf);
+    buffers->triangles = gpu_pbvh_batch_create(buffers,
+                                               prim,
+                                               /* can be NULL if buffer is empty */
+                                               buffers->index_buf);
   }
 
   if ((buffers->triangles_fast == NULL) && buffers->index_buf_fast) {
-    buffers->triangles_fast = GPU_batch_create(prim, buffers->vert_buf, buffers->index_buf_fast);
+    buffers->triangles_fast = gpu_pbvh_batch_create(buffers, prim, buffers->index_buf_fast);
   }
 
   if (buffers->lines == NULL) {
-    buffers->lines = GPU_batch_create(GPU_PRIM_LINES,
-                                      buffers->vert_buf,
-                                      /* can be NULL if buffer is empty */
-                                      buffers->index_lines_buf);
+    buffers->lines = gpu_pbvh_batch_create(buffers,
+                                           GPU_PRIM_LINES,
+                                           /* can be NULL if buffer is empty */
+                                           buffers->index_lines_buf);
   }
 
   if ((buffers->lines_fast == NULL) && buffers->index_lines_buf_fast) {
-    buffers->lines_fast = GPU_batch_create(
-        GPU_PRIM_LINES, buffers->vert_buf, buffers->index_lines_buf_fast);
+    buffers->lines_fast = gpu_pbvh_batch_create(
+        buffers, GPU_PRIM_LINES, buffers->index_lines_buf_fast);
   }
 }
 
@@ -220,28 +257,43 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
                               (update_flags & GPU_PBVH_BUFFERS_SHOW_SCULPT_FACE_SETS) != 0;
   const bool show_vcol = (vcol || (vtcol && U.experimental.use_sculpt_vertex_colors)) &&
                          (update_flags & GPU_PBVH_BUFFERS_SHOW_VCOL) != 0;
-  bool empty_mask = true;
-  bool default_face_set = true;
+  const uint totelem = buffers->tot_tri * 3;
 
-  {
-    const int totelem = buffers->tot_tri * 3;
+  /* Buffers that were never filled or changed size are updated entirely. */
+  const bool update_verts = (update_flags & GPU_PBVH_BUFFERS_UPDATE_VERTS) ||
+                            buffers->vert_buf == NULL ||
+                            GPU_vertbuf_get_data(buffers->vert_buf) == NULL ||
+                            GPU_vertbuf_get_vertex_len(buffers->vert_buf) != totelem;
+  const bool update_mask = update_verts || (update_flags & GPU_PBVH_BUFFERS_UPDATE_MASK);
+  const bool update_vcol = update_verts || (update_flags & GPU_PBVH_BUFFERS_UPDATE_VCOL);
 
+  {
     /* Build VBO */
-    if (gpu_pbvh_vert_buf_data_set(buffers, totelem)) {
+    if (gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.mesh_format, totelem) &&
+        gpu_pbvh_vert_buf_data_set(&buffers->msk_buf, &g_vbo_id.msk_format, totelem) &&
+        gpu_pbvh_vert_buf_data_set(&buffers->col_buf, &g_vbo_id.col_format, totelem)) {
       GPUVertBufRaw pos_step = {0};
       GPUVertBufRaw nor_step = {0};
       GPUVertBufRaw msk_step = {0};
       GPUVertBufRaw fset_step = {0};
       GPUVertBufRaw col_step = {0};
 
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.pos, &pos_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.nor, &nor_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.msk, &msk_step);
-      GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.fset, &fset_step);
-      if (show_vcol) {
-        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.col, &col_step);
+      /* Only get access to the buffers that change, the others don't need to be uploaded. */
+      if (update_verts) {
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_pos, &pos_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_nor, &nor_step);
+        GPU_vertbuf_attr_get_raw_data(buffers->vert_buf, g_vbo_id.mesh_fset, &fset_step);
+      }
+      if (update_mask) {
+        GPU_vertbuf_attr_get_raw_data(buffers->msk_buf, g_vbo_id.mesh_msk, &msk_step);
+      }
+      if (update_vcol && show_vcol) {
+        GPU_vertbuf_attr_get_raw_data(buffers->col_buf, g_vbo_id.mesh_col, &col_step);
       }
 
+      bool empty_mask = true;
+      bool default_face_set = true;
+
       /* calculate normal for each polygon only once */
       uint mpoly_prev = UINT_MAX;
       short no[3] = {0, 0, 0};
@@ -258,49 +310,60 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
           continue;
         }
 
-        /* Face normal and mask */
-        if (lt->poly != mpoly_prev && !buffers->smooth) {
-          const MPoly *mp = &buffers->mpoly[lt->poly];
-          float fno[3];
-          BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
-          normal_float_to_short_v3(no, fno);
-          mpoly_prev = lt->poly;
-        }
+        if (update_verts) {
+          /* Face normal */
+          if (lt->poly != mpoly_prev && !buffers->smooth) {
+            const MPoly *mp = &buffers->mpoly[lt->poly];
+            float fno[3];
+            BKE_mesh_calc_poly_normal(mp, &buffers->mloop[mp->loopstart], mvert, fno);
+            normal_float_to_short_v3(no, fno);
+            mpoly_prev = lt->poly;
+          }
 
-        uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
-        if (show_face_sets) {
-          const int fset = abs(sculpt_face_sets[lt->poly]);
-          /* Skip for the default color Face Set to render it white. */
-          if (fset != face_sets_color_default) {
-            BKE_paint_face_set_overlay_color_get(fset, face_sets_color_seed, face_set_color);
-            default_face_set = false;
+          uchar face_set_color[4] = {UCHAR_MAX, UCHAR_MAX, UCHAR_MAX, UCHAR_MAX};
+          if (show_face_sets) {
+            const int fset = abs(sculpt_face_sets[lt->poly]);
+            /* Skip for the default color Face Set to render it white. */
+            if (fset != face_sets_color_default) {
+              BKE_paint_face_set_overlay_color_get(fset, face_sets_color_seed, face_set_color);
+              default_face_set = false;
+            }
           }
-        }
 
-        float fmask = 0.0f;
-        uchar cmask = 0;
-        if (show_mask && !buffers->smooth) {
-          fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
-          cmask = (uchar)(fmask * 255);
-        }
+          for (uint j = 0; j < 3; j++) {
+            const MVert *v = &mvert[vtri[j]];
+            copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
 
-        for (uint j = 0; j < 3; j++) {
-          const MVert *v = &mvert[vtri[j]];
-          copy_v3_v3(GPU_vertbuf_raw_step(&pos_step), v->co);
+            if (buffers->smooth) {
+              copy_v3_v3_short(no, v->no);
+            }
+            copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
 
-          if (buffers->smooth) {
-            copy_v3_v3_short(no, v->no);
+            /* Face Sets. */
+            memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar[3]));
           }
-          copy_v3_v3_short(GPU_vertbuf_raw_step(&nor_step), no);
+        }
 
-          if (show_mask && buffers->smooth) {
-            cmask = (uchar)(vmask[vtri[j]] * 255);
+        if (update_mask) {
+          uchar cmask = 0;
+          if (show_mask && !buffers->smooth) {
+            const float fmask = (vmask[vtri[0]] + vmask[vtri[1]] + vmask[vtri[2]]) / 3.0f;
+            cmask = (uchar)(fmask * 255);
           }
 
-          *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
-          empty_mask = empty_mask && (cmask == 0);
-          /* Vertex Colors. */
-          if (show_vcol) {
+          for (uint j = 0; j < 3; j++) {
+            if (show_mask && buffers->smooth) {
+              cmask = (uchar)(vmask[vtri[j]] * 255);
+            }
+
+            *(uchar *)GPU_vertbuf_raw_step(&msk_step) = cmask;
+            empty_mask = empty_mask && (cmask == 0);
+          }
+        }
+
+        /* Vertex Colors. */
+        if (update_vcol && show_vcol) {
+          for (uint j = 0; j < 3; j++) {
             ushort scol[4] = {USHRT_MAX, USHRT_MAX, USHRT_MAX, USHRT_MAX};
             if (vtcol && U.experimental.use_sculpt_vertex_colors) {
               scol[0] = unit_float_to_ushort_clamp(vtcol[vtri[j]].color[0]);
@@ -319,10 +382,15 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
               memcpy(GPU_vertbuf_raw_step(&col_step), scol, sizeof(scol));
             }
           }
-          /* Face Sets. */
-          memcpy(GPU_vertbuf_raw_step(&fset_step), face_set_color, sizeof(uchar[3]));
         }
       }
+
+      if (update_verts) {
+        buffers->default_face_set = default_face_set;
+      }
+      if (update_mask) {
+        buffers->empty_mask = empty_mask;
+      }
     }
 
     gpu_pbvh_batch_init(buffers, GPU_PRIM_TRIS);
@@ -333,7 +401,7 @@ void GPU_pbvh_mesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const MPoly *mp = &buffers->mpoly[lt->poly];
   buffers->material_index = mp->mat_nr;
 
-  buffers->show_overlay = !empty_mask || !default_face_set;
+  buffers->show_overlay = !buffers->empty_mask || !buffers->default_face_set;
   buffers->mvert = mvert;
 }
 
@@ -357,6 +425,8 @@ GPU_PBVH_Buffers *GPU_pbvh_mesh_buffers_build(const MPoly *mpoly,
   buffers->smooth = mpoly[looptri[face_indices[0]].poly].flag & ME_SMOOTH;
 
   buffers->show_overlay = false;
+  buffers->empty_mask = true;
+  buffers->default_face_set = true;
 
   /* Count the number of visible triangles */
   for (i = 0, tottri = 0; i < face_indices_len; i++) {
@@ -634,7 +704,7 @@ void GPU_pbvh_grid_buffers_update(GPU_PBVH_Buffers *buffers,
 
   uint vbo_index_offset = 0;
   /* Build VBO */
-  if (gpu_pbvh_vert_buf_data_set(buffers, vert_count)) {
+  if (gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.format, vert_count)) {
     GPUIndexBufBuilder elb_lines;
 
     if (buffers->index_lines_buf == NULL) {
@@ -920,7 +990,7 @@ void GPU_pbvh_bmesh_buffers_update(GPU_PBVH_Buffers *buffers,
   const int cd_vert_mask_offset = CustomData_get_offset(&bm->vdata, CD_PAINT_MASK);
 
   /* Fill vertex buffer */
-  if (!gpu_pbvh_vert_buf_data_set(buffers, totvert)) {
+  if (!gpu_pbvh_vert_buf_data_set(&buffers->vert_buf, &g_vbo_id.format, totvert)) {
     /* Memory map failed */
     return;
   }
@@ -1091,6 +1161,8 @@ static void gpu_pbvh_buffers_clear(GPU_PBVH_Buffers *buffers)
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf_fast);
   GPU_INDEXBUF_DISCARD_SAFE(buffers->index_buf);
   GPU_VERTBUF_DISCARD_SAFE(buffers->vert_buf);
+  GPU_VERTBUF_DISCARD_SAFE(buffers->msk_buf);
+  GPU_VERTBUF_DISCARD_SAFE(buffers->col_buf);
 }
 
 void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
@@ -1105,6 +1177,12 @@ void GPU_pbvh_buffers_update_flush(GPU_PBVH_Buffers *buffers)
   if (buffers->vert_buf && GPU_vertbuf_get_data(buffers->vert_buf)) {
     GPU_vertbuf_use(buffers->vert_buf);
   }
+  if (buffers->msk_buf && GPU_vertbuf_get_data(buffers->msk_buf)) {
+    GPU_vertbuf_use(buffers->msk_buf);
+  }
+  if (buffers->col_buf && GPU_vertbuf_get_data(buffers->col_buf)) {
+    GPU_vertbuf_use(buffers->col_buf);
+  }
 }
 
 void GPU_pbvh_buffers_free(GPU_PBVH_Buffers *buffers)
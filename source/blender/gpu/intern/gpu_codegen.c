@@ -1036,12 +1036,21 @@ static bool gpu_pass_shader_validate(GPUPass *pass, GPUShader *shader)
   return (total_samplers_len <= GPU_max_textures());
 }
 
-bool GPU_pass_compile(GPUPass *pass, const char *shname)
+void GPU_pass_compile_begin(GPUPass *pass, const char *shname)
+{
+  /* The pass may be shared by several materials compiled together. */
+  if (!pass->compiled && pass->shader == NULL) {
+    pass->shader = GPU_shader_create_async(
+        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+  }
+}
+
+bool GPU_pass_compile_end(GPUPass *pass)
 {
   bool success = true;
   if (!pass->compiled) {
-    GPUShader *shader = GPU_shader_create(
-        pass->vertexcode, pass->fragmentcode, pass->geometrycode, NULL, pass->defines, shname);
+    BLI_assert(pass->shader != NULL);
+    GPUShader *shader = GPU_shader_compile_wait(pass->shader);
 
     /* NOTE: Some drivers / gpu allows more active samplers than the opengl limit.
      * We need to make sure to count active samplers to avoid undefined behavior. */
@@ -1060,6 +1069,12 @@ bool GPU_pass_compile(GPUPass *pass, const char *shname)
   return success;
 }
 
+bool GPU_pass_compile(GPUPass *pass, const char *shname)
+{
+  GPU_pass_compile_begin(pass, shname);
+  return GPU_pass_compile_end(pass);
+}
+
 void GPU_pass_release(GPUPass *pass)
 {
   BLI_assert(pass->refcount > 0);
@@ -56,6 +56,9 @@ GPUPass *GPU_generate_pass(struct GPUMaterial *material,
                            const char *defines);
 struct GPUShader *GPU_pass_shader_get(GPUPass *pass);
 bool GPU_pass_compile(GPUPass *pass, const char *shname);
+/* Split version of #GPU_pass_compile, to issue the compilation of several passes at once. */
+void GPU_pass_compile_begin(GPUPass *pass, const char *shname);
+bool GPU_pass_compile_end(GPUPass *pass);
 void GPU_pass_release(GPUPass *pass);
 
 /* Module */
@@ -27,7 +27,9 @@
 
 #include "BLI_string.h"
 
+#include "gpu_backend.hh"
 #include "gpu_context_private.hh"
+#include "gpu_query.hh"
 
 #include "GPU_debug.h"
 
@@ -94,3 +96,49 @@ bool GPU_debug_group_match(const char *ref)
   }
   return false;
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Timer queries
+ * \{ */
+
+GPUTimerPool *GPU_timer_pool_create(void)
+{
+  QueryPool *pool = GPUBackend::get()->querypool_alloc();
+  pool->init(GPU_QUERY_TIME_ELAPSED);
+  return reinterpret_cast<GPUTimerPool *>(pool);
+}
+
+void GPU_timer_pool_free(GPUTimerPool *pool)
+{
+  delete reinterpret_cast<QueryPool *>(pool);
+}
+
+void GPU_timer_pool_reset(GPUTimerPool *pool)
+{
+  reinterpret_cast<QueryPool *>(pool)->reset();
+}
+
+int GPU_timer_pool_len(const GPUTimerPool *pool)
+{
+  return reinterpret_cast<const QueryPool *>(pool)->query_issued_count();
+}
+
+int GPU_timer_begin(GPUTimerPool *pool)
+{
+  QueryPool *query_pool = reinterpret_cast<QueryPool *>(pool);
+  const int index = query_pool->query_issued_count();
+  query_pool->begin_query();
+  return index;
+}
+
+void GPU_timer_end(GPUTimerPool *pool)
+{
+  reinterpret_cast<QueryPool *>(pool)->end_query();
+}
+
+bool GPU_timer_result_get(GPUTimerPool *pool, int index, uint64_t *r_time_ns)
+{
+  return reinterpret_cast<QueryPool *>(pool)->get_time_elapsed_result(index, r_time_ns);
+}
+
+/** \} */
@@ -704,18 +704,14 @@ GPUMaterial *GPU_material_from_nodetree(Scene *scene,
 
 void GPU_material_compile(GPUMaterial *mat)
 {
-  bool success;
-
-  BLI_assert(mat->status == GPU_MAT_QUEUED);
-  BLI_assert(mat->pass);
+  GPU_materials_compile(&mat, 1);
+}
 
+static void gpu_material_compile_end(GPUMaterial *mat)
+{
   /* NOTE: The shader may have already been compiled here since we are
    * sharing GPUShader across GPUMaterials. In this case it's a no-op. */
-#ifndef NDEBUG
-  success = GPU_pass_compile(mat->pass, mat->name);
-#else
-  success = GPU_pass_compile(mat->pass, __func__);
-#endif
+  const bool success = GPU_pass_compile_end(mat->pass);
 
   if (success) {
     GPUShader *sh = GPU_pass_shader_get(mat->pass);
@@ -732,6 +728,27 @@ void GPU_material_compile(GPUMaterial *mat)
   }
 }
 
+/**
+ * Compile several materials, the compilation of all their shaders is issued before waiting for
+ * the first one so drivers with parallel shader compilation compile them at the same time.
+ */
+void GPU_materials_compile(GPUMaterial **materials, int materials_len)
+{
+  for (int i = 0; i < materials_len; i++) {
+    GPUMaterial *mat = materials[i];
+    BLI_assert(mat->status == GPU_MAT_QUEUED);
+    BLI_assert(mat->pass);
+#ifndef NDEBUG
+    GPU_pass_compile_begin(mat->pass, mat->name);
+#else
+    GPU_pass_compile_begin(mat->pass, __func__);
+#endif
+  }
+  for (int i = 0; i < materials_len; i++) {
+    gpu_material_compile_end(materials[i]);
+  }
+}
+
 void GPU_materials_free(Main *bmain)
 {
   LISTBASE_FOREACH (Material *, ma, &bmain->materials) {
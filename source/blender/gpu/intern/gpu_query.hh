@@ -29,6 +29,7 @@ namespace blender::gpu {
 
 typedef enum GPUQueryType {
   GPU_QUERY_OCCLUSION = 0,
+  GPU_QUERY_TIME_ELAPSED = 1,
 } GPUQueryType;
 
 class QueryPool {
@@ -41,6 +42,12 @@ class QueryPool {
    */
   virtual void init(GPUQueryType type) = 0;
 
+  /**
+   * Restart issuing queries from the first index of the pool. Already allocated queries are kept,
+   * so a pool can be reused every frame without reallocating the query objects.
+   */
+  virtual void reset(void) = 0;
+
   /**
    * Will start and end the query at this index inside the pool.
    * The pool will resize automatically.
@@ -54,6 +61,15 @@ class QueryPool {
    * drawn.
    */
   virtual void get_occlusion_result(MutableSpan<uint32_t> r_values) = 0;
+
+  /**
+   * Get the elapsed GPU time in nanoseconds of the query at this index.
+   * Returns false if the result is not available yet. This never waits for the GPU.
+   */
+  virtual bool get_time_elapsed_result(int index, uint64_t *r_time) = 0;
+
+  /** Number of queries issued since the last initialization or reset. */
+  virtual int query_issued_count(void) const = 0;
 };
 
 }  // namespace blender::gpu
@@ -85,16 +85,17 @@ static void standard_defines(Vector<const char *> &sources)
   }
 }
 
-GPUShader *GPU_shader_create_ex(const char *vertcode,
-                                const char *fragcode,
-                                const char *geomcode,
-                                const char *computecode,
-                                const char *libcode,
-                                const char *defines,
-                                const eGPUShaderTFBType tf_type,
-                                const char **tf_names,
-                                const int tf_count,
-                                const char *shname)
+/* Create the shader and issue its compilation, see #Shader::finalize_begin. */
+static Shader *shader_create_begin(const char *vertcode,
+                                   const char *fragcode,
+                                   const char *geomcode,
+                                   const char *computecode,
+                                   const char *libcode,
+                                   const char *defines,
+                                   const eGPUShaderTFBType tf_type,
+                                   const char **tf_names,
+                                   const int tf_count,
+                                   const char *shname)
 {
   /* At least a vertex shader and a fragment shader are required, or only a compute shader. */
   BLI_assert(((fragcode != nullptr) && (vertcode != nullptr) && (computecode == nullptr)) ||
@@ -170,14 +171,63 @@ GPUShader *GPU_shader_create_ex(const char *vertcode,
     shader->transform_feedback_names_set(Span<const char *>(tf_names, tf_count), tf_type);
   }
 
-  if (!shader->finalize()) {
-    delete shader;
-    return nullptr;
-  };
+  shader->finalize_begin();
+  return shader;
+}
 
+GPUShader *GPU_shader_create_ex(const char *vertcode,
+                                const char *fragcode,
+                                const char *geomcode,
+                                const char *computecode,
+                                const char *libcode,
+                                const char *defines,
+                                const eGPUShaderTFBType tf_type,
+                                const char **tf_names,
+                                const int tf_count,
+                                const char *shname)
+{
+  Shader *shader = shader_create_begin(vertcode,
+                                       fragcode,
+                                       geomcode,
+                                       computecode,
+                                       libcode,
+                                       defines,
+                                       tf_type,
+                                       tf_names,
+                                       tf_count,
+                                       shname);
+  return GPU_shader_compile_wait(wrap(shader));
+}
+
+GPUShader *GPU_shader_create_async(const char *vertcode,
+                                   const char *fragcode,
+                                   const char *geomcode,
+                                   const char *libcode,
+                                   const char *defines,
+                                   const char *shname)
+{
+  Shader *shader = shader_create_begin(vertcode,
+                                       fragcode,
+                                       geomcode,
+                                       nullptr,
+                                       libcode,
+                                       defines,
+                                       GPU_SHADER_TFB_NONE,
+                                       nullptr,
+                                       0,
+                                       shname);
   return wrap(shader);
 }
 
+GPUShader *GPU_shader_compile_wait(GPUShader *shader)
+{
+  if (!unwrap(shader)->finalize_end()) {
+    delete unwrap(shader);
+    return nullptr;
+  }
+  return shader;
+}
+
 void GPU_shader_free(GPUShader *shader)
 {
   delete unwrap(shader);
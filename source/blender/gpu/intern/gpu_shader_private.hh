@@ -53,7 +53,14 @@ class Shader {
   virtual void geometry_shader_from_glsl(MutableSpan<const char *> sources) = 0;
   virtual void fragment_shader_from_glsl(MutableSpan<const char *> sources) = 0;
   virtual void compute_shader_from_glsl(MutableSpan<const char *> sources) = 0;
-  virtual bool finalize(void) = 0;
+  /**
+   * Issue the compilation and the link of the program without waiting for the driver.
+   * Several shaders can be issued before waiting on any of them so a driver supporting parallel
+   * compilation compiles them at the same time.
+   */
+  virtual void finalize_begin(void) = 0;
+  /* Wait for the program issued by #finalize_begin. Return true on success. */
+  virtual bool finalize_end(void) = 0;
 
   virtual void transform_feedback_names_set(Span<const char *> name_list,
                                             const eGPUShaderTFBType geom_type) = 0;
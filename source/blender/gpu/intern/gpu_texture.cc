@@ -177,6 +177,18 @@ void Texture::update(eGPUDataFormat format, const void *data)
   this->update_sub(mip, offset, extent, format, data);
 }
 
+/* Estimated size of the texture in memory. */
+size_t Texture::memory_size_get() const
+{
+  if (type_ == GPU_TEXTURE_BUFFER) {
+    /* The data is owned by the vertex buffer. */
+    return 0;
+  }
+  const size_t size = to_bytesize(format_) * max_ii(1, w_) * max_ii(1, h_) * max_ii(1, d_);
+  /* A full mip-map chain takes about a third more memory. */
+  return (mipmaps_ > 0) ? size + size / 3 : size;
+}
+
 /** \} */
 
 }  // namespace blender::gpu
@@ -617,6 +629,11 @@ void GPU_texture_get_mipmap_size(GPUTexture *tex, int lvl, int *r_size)
   return reinterpret_cast<Texture *>(tex)->mip_size_get(lvl, r_size);
 }
 
+size_t GPU_texture_memory_size(const GPUTexture *tex)
+{
+  return reinterpret_cast<const Texture *>(tex)->memory_size_get();
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
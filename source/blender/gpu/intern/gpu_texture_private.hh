@@ -133,6 +133,7 @@ class Texture {
   void attach_to(FrameBuffer *fb, GPUAttachmentType type);
   void detach_from(FrameBuffer *fb);
   void update(eGPUDataFormat format, const void *data);
+  size_t memory_size_get() const;
 
   virtual void update_sub(
       int mip, int offset[3], int extent[3], eGPUDataFormat format, const void *data) = 0;
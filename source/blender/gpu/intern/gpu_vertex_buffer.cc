@@ -91,7 +91,10 @@ void VertBuf::allocate(uint vert_len)
   BLI_assert(vertex_alloc != vert_len || data == nullptr);
   vertex_len = vertex_alloc = vert_len;
 
-  this->acquire_data();
+  {
+    MEM_ScopedDomain domain(MEM_DOMAIN_GPU);
+    this->acquire_data();
+  }
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
 }
@@ -102,7 +105,10 @@ void VertBuf::resize(uint vert_len)
   BLI_assert(vertex_alloc != vert_len);
   vertex_len = vertex_alloc = vert_len;
 
-  this->resize_data();
+  {
+    MEM_ScopedDomain domain(MEM_DOMAIN_GPU);
+    this->resize_data();
+  }
 
   flag |= GPU_VERTBUF_DATA_DIRTY;
 }
@@ -56,6 +56,11 @@ GLContext::GLContext(void *ghost_window, GLSharedOrphanLists &shared_orphan_list
     debug::init_gl_callbacks();
   }
 
+  if (parallel_shader_compile_support) {
+    /* Let the driver choose the number of threads compiling the shaders of this context. */
+    glMaxShaderCompilerThreadsARB(0xFFFFFFFFu);
+  }
+
   float data[4] = {0.0f, 0.0f, 0.0f, 1.0f};
   glGenBuffers(1, &default_attr_vbo_);
   glBindBuffer(GL_ARRAY_BUFFER, default_attr_vbo_);
@@ -47,15 +47,8 @@ GLImmediate::GLImmediate()
   glGenVertexArrays(1, &vao_id_);
   glBindVertexArray(vao_id_); /* Necessary for glObjectLabel. */
 
-  buffer.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer.buffer_size, nullptr, GL_DYNAMIC_DRAW);
-
-  buffer_strict.buffer_size = DEFAULT_INTERNAL_BUFFER_SIZE;
-  glGenBuffers(1, &buffer_strict.vbo_id);
-  glBindBuffer(GL_ARRAY_BUFFER, buffer_strict.vbo_id);
-  glBufferData(GL_ARRAY_BUFFER, buffer_strict.buffer_size, nullptr, GL_DYNAMIC_DRAW);
+  this->buffer_create(buffer, DEFAULT_INTERNAL_BUFFER_SIZE);
+  this->buffer_create(buffer_strict, DEFAULT_INTERNAL_BUFFER_SIZE);
 
   glBindBuffer(GL_ARRAY_BUFFER, 0);
   glBindVertexArray(0);
@@ -69,8 +62,42 @@ GLImmediate::~GLImmediate()
 {
   glDeleteVertexArrays(1, &vao_id_);
 
-  glDeleteBuffers(1, &buffer.vbo_id);
-  glDeleteBuffers(1, &buffer_strict.vbo_id);
+  this->buffer_free(buffer);
+  this->buffer_free(buffer_strict);
+}
+
+/* Create the buffer and leave it bound to GL_ARRAY_BUFFER. */
+void GLImmediate::buffer_create(ImmediateBuffer &buf, size_t size)
+{
+  buf.buffer_size = size;
+  buf.buffer_offset = 0;
+  glGenBuffers(1, &buf.vbo_id);
+  glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+
+  if (GLContext::buffer_storage_support) {
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT;
+    glBufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+    buf.data = (uchar *)glMapBufferRange(
+        GL_ARRAY_BUFFER, 0, size, flags | GL_MAP_FLUSH_EXPLICIT_BIT);
+    BLI_assert(buf.data != nullptr);
+  }
+  else {
+    glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+  }
+}
+
+void GLImmediate::buffer_free(ImmediateBuffer &buf)
+{
+  for (GLsync &fence : buf.fences) {
+    if (fence) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+  /* Deleting a buffer also unmaps it. */
+  glDeleteBuffers(1, &buf.vbo_id);
+  buf.vbo_id = 0;
+  buf.data = nullptr;
 }
 
 /** \} */
@@ -88,6 +115,10 @@ uchar *GLImmediate::begin()
 
   GL_CHECK_RESOURCES("Immediate");
 
+  if (GLContext::buffer_storage_support) {
+    return this->begin_persistent(bytes_needed);
+  }
+
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id());
 
   bool recreate_buffer = false;
@@ -146,10 +177,18 @@ void GLImmediate::end()
       buffer_bytes_used = vertex_buffer_size(&vertex_format, vertex_len);
       /* unused buffer bytes are available to the next immBegin */
     }
-    /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
-    glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
   }
-  glUnmapBuffer(GL_ARRAY_BUFFER);
+  if (GLContext::buffer_storage_support) {
+    /* Make the written range visible to the GPU, the buffer stays mapped. */
+    glFlushMappedBufferRange(GL_ARRAY_BUFFER, buffer_offset(), buffer_bytes_used);
+  }
+  else {
+    if (!strict_vertex_len) {
+      /* tell OpenGL what range was modified so it doesn't copy the whole mapped range */
+      glFlushMappedBufferRange(GL_ARRAY_BUFFER, 0, buffer_bytes_used);
+    }
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+  }
 
   if (vertex_len > 0) {
     GLContext::get()->state_manager->apply_state();
@@ -176,9 +215,87 @@ void GLImmediate::end()
     // glBindVertexArray(0);
   }
 
+  if (GLContext::buffer_storage_support) {
+    this->end_persistent(buffer_bytes_used);
+  }
+
   buffer_offset() += buffer_bytes_used;
 }
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Persistently mapped ring buffer
+ *
+ * Avoids mapping and orphaning the buffer for every draw, which is slow on some drivers when
+ * drawing many small batches (e.g. drawing the user interface).
+ * \{ */
+
+uchar *GLImmediate::begin_persistent(size_t bytes_needed)
+{
+  ImmediateBuffer &buf = active_buffer();
+
+  /* Grow or shrink the buffer like the non-persistent path does. The storage is immutable so a
+   * new buffer is created, the old one is only released by the driver once it's not used. */
+  if ((bytes_needed > buf.buffer_size) || (bytes_needed < DEFAULT_INTERNAL_BUFFER_SIZE &&
+                                           buf.buffer_size > DEFAULT_INTERNAL_BUFFER_SIZE)) {
+    this->buffer_free(buf);
+    this->buffer_create(buf, max_zz(bytes_needed, DEFAULT_INTERNAL_BUFFER_SIZE));
+    debug::object_label(
+        GL_BUFFER, buf.vbo_id, strict_vertex_len ? "ImmediateVboStrict" : "ImmediateVbo");
+  }
+  else {
+    glBindBuffer(GL_ARRAY_BUFFER, buf.vbo_id);
+  }
+
+  const size_t section_size = buf.buffer_size / IMMEDIATE_BUFFER_SECTIONS;
+  const uint pre_padding = padding(buf.buffer_offset, vertex_format.stride);
+
+  if (buf.buffer_offset + pre_padding + bytes_needed > buf.buffer_size) {
+    /* Wrap around, the section of the previous draws is done with. */
+    const int section = min_ii((int)(buf.buffer_offset / section_size),
+                               IMMEDIATE_BUFFER_SECTIONS - 1);
+    if (buf.buffer_offset % section_size != 0 && buf.fences[section] == nullptr) {
+      buf.fences[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    buf.buffer_offset = 0;
+  }
+  else {
+    buf.buffer_offset += pre_padding;
+  }
+
+  /* Wait for the GPU to be done reading the sections we are about to write to. */
+  const int section_first = (int)(buf.buffer_offset / section_size);
+  const int section_last = min_ii((int)((buf.buffer_offset + bytes_needed) / section_size),
+                                  IMMEDIATE_BUFFER_SECTIONS - 1);
+  for (int section = section_first; section <= section_last; section++) {
+    GLsync &fence = buf.fences[section];
+    if (fence) {
+      glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_MAX);
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  bytes_mapped_ = bytes_needed;
+  return buf.data + buf.buffer_offset;
+}
+
+/* Place fences on the sections that won't be used by the following draws. */
+void GLImmediate::end_persistent(size_t bytes_used)
+{
+  ImmediateBuffer &buf = active_buffer();
+  const size_t section_size = buf.buffer_size / IMMEDIATE_BUFFER_SECTIONS;
+  const int section_first = (int)(buf.buffer_offset / section_size);
+  const int section_end = min_ii((int)((buf.buffer_offset + bytes_used) / section_size),
+                                 IMMEDIATE_BUFFER_SECTIONS);
+  for (int section = section_first; section < section_end; section++) {
+    if (buf.fences[section] == nullptr) {
+      buf.fences[section] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+  }
+}
+
+/** \} */
+
 }  // namespace blender::gpu
@@ -35,20 +35,30 @@ namespace blender::gpu {
 
 /* size of internal buffer */
 #define DEFAULT_INTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+/* Number of sections of a persistently mapped buffer, each one protected by a fence. */
+#define IMMEDIATE_BUFFER_SECTIONS 4
 
 class GLImmediate : public Immediate {
  private:
-  /* Use two buffers for strict and non-strict vertex count to
-   * avoid some huge driver slowdown (see T70922).
-   * Use accessor functions to get / modify. */
-  struct {
+  struct ImmediateBuffer {
     /** Opengl Handle for this buffer. */
     GLuint vbo_id = 0;
     /** Offset of the mapped data in data. */
     size_t buffer_offset = 0;
     /** Size of the whole buffer in bytes. */
     size_t buffer_size = 0;
-  } buffer, buffer_strict;
+    /**
+     * Persistently mapped memory of the whole buffer, only used with #buffer_storage_support.
+     * The buffer is then used as a ring buffer, and a fence is placed after the last draw using
+     * each section of it, so it's not written to again while the GPU could still read it.
+     */
+    uchar *data = nullptr;
+    GLsync fences[IMMEDIATE_BUFFER_SECTIONS] = {nullptr};
+  };
+  /* Use two buffers for strict and non-strict vertex count to
+   * avoid some huge driver slowdown (see T70922).
+   * Use accessor functions to get / modify. */
+  ImmediateBuffer buffer, buffer_strict;
   /** Size in bytes of the mapped region. */
   size_t bytes_mapped_ = 0;
   /** Vertex array for this immediate mode instance. */
@@ -76,6 +86,16 @@ class GLImmediate : public Immediate {
   {
     return strict_vertex_len ? buffer_strict.buffer_size : buffer.buffer_size;
   };
+
+  ImmediateBuffer &active_buffer(void)
+  {
+    return strict_vertex_len ? buffer_strict : buffer;
+  };
+
+  void buffer_create(ImmediateBuffer &buf, size_t size);
+  void buffer_free(ImmediateBuffer &buf);
+  uchar *begin_persistent(size_t bytes_needed);
+  void end_persistent(size_t bytes_used);
 };
 
 }  // namespace blender::gpu
@@ -41,12 +41,11 @@ void GLQueryPool::init(GPUQueryType type)
   query_issued_ = 0;
 }
 
-#if 0 /* TODO: to avoid realloc of permanent query pool. */
-void GLQueryPool::reset(GPUQueryType type)
+void GLQueryPool::reset()
 {
-  initialized_ = false;
+  BLI_assert(initialized_);
+  query_issued_ = 0;
 }
-#endif
 
 void GLQueryPool::begin_query()
 {
@@ -75,4 +74,20 @@ void GLQueryPool::get_occlusion_result(MutableSpan<uint32_t> r_values)
   }
 }
 
+bool GLQueryPool::get_time_elapsed_result(int index, uint64_t *r_time)
+{
+  BLI_assert(type_ == GPU_QUERY_TIME_ELAPSED);
+  BLI_assert(index < query_issued_);
+
+  GLuint available = GL_FALSE;
+  glGetQueryObjectuiv(query_ids_[index], GL_QUERY_RESULT_AVAILABLE, &available);
+  if (available == GL_FALSE) {
+    return false;
+  }
+  GLuint64 time;
+  glGetQueryObjectui64v(query_ids_[index], GL_QUERY_RESULT, &time);
+  *r_time = time;
+  return true;
+}
+
 }  // namespace blender::gpu
@@ -49,11 +49,18 @@ class GLQueryPool : public QueryPool {
   ~GLQueryPool();
 
   void init(GPUQueryType type) override;
+  void reset(void) override;
 
   void begin_query(void) override;
   void end_query(void) override;
 
   void get_occlusion_result(MutableSpan<uint32_t> r_values) override;
+  bool get_time_elapsed_result(int index, uint64_t *r_time) override;
+
+  int query_issued_count(void) const override
+  {
+    return query_issued_;
+  }
 };
 
 static inline GLenum to_gl(GPUQueryType type)
@@ -62,6 +69,9 @@ static inline GLenum to_gl(GPUQueryType type)
     /* TODO(fclem): try with GL_ANY_SAMPLES_PASSED​. */
     return GL_SAMPLES_PASSED;
   }
+  if (type == GPU_QUERY_TIME_ELAPSED) {
+    return GL_TIME_ELAPSED;
+  }
   BLI_assert(0);
   return GL_SAMPLES_PASSED;
 }
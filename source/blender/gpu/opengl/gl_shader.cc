@@ -21,11 +21,17 @@
  * \ingroup gpu
  */
 
+#include "BKE_appdir.h"
 #include "BKE_global.h"
 
+#include "BLI_fileops.h"
+#include "BLI_hash_md5.h"
+#include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_vector.hh"
 
+#include "DNA_userdef_types.h"
+
 #include "GPU_capabilities.h"
 #include "GPU_platform.h"
 
@@ -137,83 +143,182 @@ char *GLShader::glsl_patch_get(GLenum gl_stage)
   return glsl_patch_default_get();
 }
 
-/* Create, compile and attach the shader stage to the shader program. */
-GLuint GLShader::create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources)
+/* Store the patched sources of a stage, compiled later in #finalize_begin. */
+void GLShader::stage_source_add(GLenum gl_stage, MutableSpan<const char *> sources)
+{
+  /* Patch the shader code using the first source slot. */
+  sources[0] = glsl_patch_get(gl_stage);
+
+  StageSource stage;
+  stage.gl_stage = gl_stage;
+  for (const char *source : sources) {
+    stage.sources.append(source);
+  }
+  stage_sources_.append(std::move(stage));
+}
+
+/* Create, compile and attach the shader stage to the shader program. The compilation status is
+ * only checked by #check_shader_stage, so the driver can compile all stages at the same time. */
+GLuint GLShader::create_shader_stage(GLenum gl_stage, Span<std::string> sources)
 {
   GLuint shader = glCreateShader(gl_stage);
   if (shader == 0) {
     fprintf(stderr, "GLShader: Error: Could not create shader object.");
+    compilation_failed_ = true;
     return 0;
   }
 
-  /* Patch the shader code using the first source slot. */
-  sources[0] = glsl_patch_get(gl_stage);
+  Vector<const char *> sources_ptr;
+  for (const std::string &source : sources) {
+    sources_ptr.append(source.c_str());
+  }
 
-  glShaderSource(shader, sources.size(), sources.data(), nullptr);
+  glShaderSource(shader, sources_ptr.size(), sources_ptr.data(), nullptr);
   glCompileShader(shader);
 
+  debug::object_label(gl_stage, shader, name);
+
+  glAttachShader(shader_program_, shader);
+  return shader;
+}
+
+/* Return false and print the log if the stage failed to compile. */
+bool GLShader::check_shader_stage(GLenum gl_stage, GLuint shader, Span<std::string> sources)
+{
+  if (shader == 0) {
+    return false;
+  }
+
   GLint status;
   glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
   if (!status || (G.debug & G_DEBUG_GPU)) {
     char log[5000] = "";
     glGetShaderInfoLog(shader, sizeof(log), nullptr, log);
     if (log[0] != '\0') {
+      Vector<const char *> sources_ptr;
+      for (const std::string &source : sources) {
+        sources_ptr.append(source.c_str());
+      }
       GLLogParser parser;
       switch (gl_stage) {
         case GL_VERTEX_SHADER:
-          this->print_log(sources, log, "VertShader", !status, &parser);
+          this->print_log(sources_ptr, log, "VertShader", !status, &parser);
           break;
         case GL_GEOMETRY_SHADER:
-          this->print_log(sources, log, "GeomShader", !status, &parser);
+          this->print_log(sources_ptr, log, "GeomShader", !status, &parser);
           break;
         case GL_FRAGMENT_SHADER:
-          this->print_log(sources, log, "FragShader", !status, &parser);
+          this->print_log(sources_ptr, log, "FragShader", !status, &parser);
           break;
         case GL_COMPUTE_SHADER:
-          this->print_log(sources, log, "ComputeShader", !status, &parser);
+          this->print_log(sources_ptr, log, "ComputeShader", !status, &parser);
           break;
       }
     }
   }
   if (!status) {
-    glDeleteShader(shader);
     compilation_failed_ = true;
-    return 0;
+    return false;
   }
-
-  debug::object_label(gl_stage, shader, name);
-
-  glAttachShader(shader_program_, shader);
-  return shader;
+  return true;
 }
 
 void GLShader::vertex_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  vert_shader_ = this->create_shader_stage(GL_VERTEX_SHADER, sources);
+  this->stage_source_add(GL_VERTEX_SHADER, sources);
 }
 
 void GLShader::geometry_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  geom_shader_ = this->create_shader_stage(GL_GEOMETRY_SHADER, sources);
+  this->stage_source_add(GL_GEOMETRY_SHADER, sources);
 }
 
 void GLShader::fragment_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  frag_shader_ = this->create_shader_stage(GL_FRAGMENT_SHADER, sources);
+  this->stage_source_add(GL_FRAGMENT_SHADER, sources);
 }
 
 void GLShader::compute_shader_from_glsl(MutableSpan<const char *> sources)
 {
-  compute_shader_ = this->create_shader_stage(GL_COMPUTE_SHADER, sources);
+  this->stage_source_add(GL_COMPUTE_SHADER, sources);
 }
 
-bool GLShader::finalize()
+void GLShader::finalize_begin()
 {
+  const bool use_cache = GLContext::program_binary_support &&
+                         USER_EXPERIMENTAL_TEST(&U, use_shader_cache);
+  cache_key_ = use_cache ? this->program_cache_key_get() : "";
+
+  if (use_cache && this->program_cache_load(cache_key_.c_str())) {
+    stage_sources_.clear();
+    cache_loaded_ = true;
+    return;
+  }
+
+  /* Issue the compilation of all stages and the link without querying any status, the driver
+   * only has to finish them in #finalize_end. */
+  for (const StageSource &stage : stage_sources_) {
+    const GLuint shader = this->create_shader_stage(stage.gl_stage, stage.sources);
+    switch (stage.gl_stage) {
+      case GL_VERTEX_SHADER:
+        vert_shader_ = shader;
+        break;
+      case GL_GEOMETRY_SHADER:
+        geom_shader_ = shader;
+        break;
+      case GL_FRAGMENT_SHADER:
+        frag_shader_ = shader;
+        break;
+      case GL_COMPUTE_SHADER:
+        compute_shader_ = shader;
+        break;
+    }
+  }
+
   if (compilation_failed_) {
-    return false;
+    return;
+  }
+
+  if (use_cache) {
+    glProgramParameteri(shader_program_, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
   }
 
   glLinkProgram(shader_program_);
+}
+
+bool GLShader::finalize_end()
+{
+  if (cache_loaded_) {
+    interface = new GLShaderInterface(shader_program_);
+    return true;
+  }
+
+  for (const StageSource &stage : stage_sources_) {
+    GLuint *shader = nullptr;
+    switch (stage.gl_stage) {
+      case GL_VERTEX_SHADER:
+        shader = &vert_shader_;
+        break;
+      case GL_GEOMETRY_SHADER:
+        shader = &geom_shader_;
+        break;
+      case GL_FRAGMENT_SHADER:
+        shader = &frag_shader_;
+        break;
+      case GL_COMPUTE_SHADER:
+        shader = &compute_shader_;
+        break;
+    }
+    if (shader != nullptr && !this->check_shader_stage(stage.gl_stage, *shader, stage.sources)) {
+      glDeleteShader(*shader);
+      *shader = 0;
+    }
+  }
+  stage_sources_.clear();
+
+  if (compilation_failed_) {
+    return false;
+  }
 
   GLint status;
   glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
@@ -226,6 +331,10 @@ bool GLShader::finalize()
     return false;
   }
 
+  if (!cache_key_.empty()) {
+    this->program_cache_save(cache_key_.c_str());
+  }
+
   interface = new GLShaderInterface(shader_program_);
 
   return true;
@@ -233,6 +342,130 @@ bool GLShader::finalize()
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Program binary cache
+ *
+ * Linked programs are stored in the user cache directory, in a file named after the hash of
+ * their sources and of the driver identification strings. A program that cannot be loaded
+ * (e.g. after a driver update) is compiled again and its file overwritten.
+ * \{ */
+
+#define SHADER_CACHE_MAGIC 0x43534c47u /* "GLSC" */
+
+struct GLProgramCacheHeader {
+  uint32_t magic;
+  GLenum binary_format;
+};
+
+static bool program_cache_filepath_get(const char *key, char r_filepath[FILE_MAX])
+{
+  char cache_dir[FILE_MAX];
+  if (!BKE_appdir_folder_caches(cache_dir, sizeof(cache_dir))) {
+    return false;
+  }
+  char filename[FILE_MAXFILE];
+  BLI_snprintf(filename, sizeof(filename), "%s.bin", key);
+  BLI_path_join(r_filepath, FILE_MAX, cache_dir, "shaders", filename, NULL);
+  return true;
+}
+
+std::string GLShader::program_cache_key_get() const
+{
+  std::string text = GPU_platform_vendor();
+  text += GPU_platform_renderer();
+  text += GPU_platform_version();
+  text += transform_feedback_names_;
+  for (const StageSource &stage : stage_sources_) {
+    text += std::to_string(stage.gl_stage);
+    for (const std::string &source : stage.sources) {
+      text += source;
+    }
+  }
+
+  uchar digest[16];
+  char hex_digest[33];
+  BLI_hash_md5_buffer(text.c_str(), text.size(), digest);
+  return BLI_hash_md5_to_hexdigest(digest, hex_digest);
+}
+
+/* Return true if the program has been loaded and linked from the cache. */
+bool GLShader::program_cache_load(const char *key)
+{
+  char filepath[FILE_MAX];
+  if (!program_cache_filepath_get(key, filepath) || !BLI_exists(filepath)) {
+    return false;
+  }
+
+  size_t size = 0;
+  char *data = (char *)BLI_file_read_binary_as_mem(filepath, 0, &size);
+  if (data == nullptr) {
+    return false;
+  }
+
+  bool success = false;
+  if (size > sizeof(GLProgramCacheHeader)) {
+    const GLProgramCacheHeader *header = (const GLProgramCacheHeader *)data;
+    if (header->magic == SHADER_CACHE_MAGIC) {
+      glProgramBinary(shader_program_,
+                      header->binary_format,
+                      data + sizeof(GLProgramCacheHeader),
+                      size - sizeof(GLProgramCacheHeader));
+      GLint status;
+      glGetProgramiv(shader_program_, GL_LINK_STATUS, &status);
+      success = status != 0;
+    }
+  }
+  MEM_freeN(data);
+
+  if (!success) {
+    /* Outdated or corrupted, it will be written again after compiling. */
+    BLI_delete(filepath, false, false);
+  }
+  return success;
+}
+
+void GLShader::program_cache_save(const char *key)
+{
+  char filepath[FILE_MAX];
+  if (!program_cache_filepath_get(key, filepath)) {
+    return;
+  }
+
+  GLint binary_len = 0;
+  glGetProgramiv(shader_program_, GL_PROGRAM_BINARY_LENGTH, &binary_len);
+  if (binary_len <= 0) {
+    return;
+  }
+
+  GLProgramCacheHeader header = {SHADER_CACHE_MAGIC, 0};
+  Vector<char> binary(binary_len);
+  glGetProgramBinary(shader_program_, binary_len, nullptr, &header.binary_format, binary.data());
+
+  char dirpath[FILE_MAX];
+  BLI_split_dir_part(filepath, dirpath, sizeof(dirpath));
+  if (!BLI_dir_create_recursive(dirpath)) {
+    return;
+  }
+
+  /* Write to a temporary file first, other shaders or other instances of Blender could read
+   * the same file at the same time. */
+  char filepath_tmp[FILE_MAX];
+  BLI_snprintf(filepath_tmp, sizeof(filepath_tmp), "%s.%p.tmp", filepath, (void *)this);
+  FILE *file = BLI_fopen(filepath_tmp, "wb");
+  if (file == nullptr) {
+    return;
+  }
+  const bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+                       fwrite(binary.data(), binary.size(), 1, file) == 1;
+  fclose(file);
+
+  if (!written || BLI_rename(filepath_tmp, filepath) != 0) {
+    BLI_delete(filepath_tmp, false, false);
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Binding
  * \{ */
@@ -265,6 +498,11 @@ void GLShader::transform_feedback_names_set(Span<const char *> name_list,
   glTransformFeedbackVaryings(
       shader_program_, name_list.size(), name_list.data(), GL_INTERLEAVED_ATTRIBS);
   transform_feedback_type_ = geom_type;
+
+  for (const char *name : name_list) {
+    transform_feedback_names_ += name;
+    transform_feedback_names_ += ' ';
+  }
 }
 
 bool GLShader::transform_feedback_enable(GPUVertBuf *buf_)
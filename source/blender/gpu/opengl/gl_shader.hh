@@ -25,6 +25,10 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <string>
+
+#include "BLI_vector.hh"
+
 #include "glew-mx.h"
 
 #include "gpu_shader_private.hh"
@@ -47,6 +51,22 @@ class GLShader : public Shader {
   /** True if any shader failed to compile. */
   bool compilation_failed_ = false;
 
+  /**
+   * Sources of the stages, compiled together in #finalize_begin so the driver can compile them in
+   * parallel, and so they aren't compiled at all when the program is found in the disk cache.
+   */
+  struct StageSource {
+    GLenum gl_stage;
+    Vector<std::string> sources;
+  };
+  Vector<StageSource> stage_sources_;
+  /** Names of the transform feedback varyings, they are part of the program binary. */
+  std::string transform_feedback_names_;
+  /** Key of the program in the binary cache, empty when the cache isn't used. */
+  std::string cache_key_;
+  /** True if the program has been loaded from the binary cache by #finalize_begin. */
+  bool cache_loaded_ = false;
+
   eGPUShaderTFBType transform_feedback_type_ = GPU_SHADER_TFB_NONE;
 
  public:
@@ -58,7 +78,8 @@ class GLShader : public Shader {
   void geometry_shader_from_glsl(MutableSpan<const char *> sources) override;
   void fragment_shader_from_glsl(MutableSpan<const char *> sources) override;
   void compute_shader_from_glsl(MutableSpan<const char *> sources) override;
-  bool finalize(void) override;
+  void finalize_begin(void) override;
+  bool finalize_end(void) override;
 
   void transform_feedback_names_set(Span<const char *> name_list,
                                     const eGPUShaderTFBType geom_type) override;
@@ -79,7 +100,13 @@ class GLShader : public Shader {
  private:
   char *glsl_patch_get(GLenum gl_stage);
 
-  GLuint create_shader_stage(GLenum gl_stage, MutableSpan<const char *> sources);
+  void stage_source_add(GLenum gl_stage, MutableSpan<const char *> sources);
+  GLuint create_shader_stage(GLenum gl_stage, Span<std::string> sources);
+  bool check_shader_stage(GLenum gl_stage, GLuint shader, Span<std::string> sources);
+
+  std::string program_cache_key_get() const;
+  bool program_cache_load(const char *key);
+  void program_cache_save(const char *key);
 
   MEM_CXX_CLASS_ALLOC_FUNCS("GLShader");
 };
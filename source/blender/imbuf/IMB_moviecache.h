@@ -59,6 +59,11 @@ void IMB_moviecache_set_priority_callback(struct MovieCache *cache,
 
 void IMB_moviecache_put(struct MovieCache *cache, void *userkey, struct ImBuf *ibuf);
 bool IMB_moviecache_put_if_possible(struct MovieCache *cache, void *userkey, struct ImBuf *ibuf);
+/**
+ * Memory used by the images of all movie caches. Other caches account their memory with
+ * #MEM_CacheLimiter_external_memory_add, all of them share the cache limit.
+ */
+size_t IMB_moviecache_get_memory_in_use(void);
 struct ImBuf *IMB_moviecache_get(struct MovieCache *cache, void *userkey);
 void IMB_moviecache_remove(struct MovieCache *cache, void *userkey);
 bool IMB_moviecache_has_frame(struct MovieCache *cache, void *userkey);
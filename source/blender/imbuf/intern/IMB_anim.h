@@ -129,7 +129,11 @@ struct anim {
   int pFrameComplete;
   AVFrame *pFrameRGB;
   AVFrame *pFrameDeinterlaced;
+  /* Spare frame, swapped with pFrame when downloading hardware decoded frames. */
+  AVFrame *pFrameHW;
+  enum AVPixelFormat hw_pix_fmt;
   struct SwsContext *img_convert_ctx;
+  enum AVPixelFormat img_convert_pix_fmt;
   int videoStream;
 
   struct ImBuf *cur_frame_final;
@@ -142,9 +146,11 @@ struct anim {
 
   int proxies_tried;
   int indices_tried;
+  int keyframe_index_tried;
 
   struct anim *proxy_anim[IMB_PROXY_MAX_SLOT];
   struct anim_index *curr_idx[IMB_TC_MAX_SLOT];
+  struct anim_keyframe_index *keyframe_idx;
 
   char colorspace[64];
   char suffix[64]; /* MAX_NAME - multiview */
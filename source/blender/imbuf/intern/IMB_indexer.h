@@ -61,6 +61,14 @@ struct anim_index {
   struct anim_index_entry *entries;
 };
 
+/* Time-stamps of the key frames of the video stream, in increasing order. Unlike the time code
+ * index it is built by demuxing the file without decoding, which is quick enough to do on demand
+ * the first time a movie without time code index is seeked in. */
+struct anim_keyframe_index {
+  int num_entries;
+  int64_t *pts;
+};
+
 struct anim_index_builder;
 
 typedef struct anim_index_builder {
@@ -109,6 +117,10 @@ int IMB_indexer_can_scan(struct anim_index *idx, int old_frame_index, int new_fr
 
 void IMB_indexer_close(struct anim_index *idx);
 
+struct anim_keyframe_index *IMB_anim_open_keyframe_index(struct anim *anim);
+int64_t IMB_keyframe_index_get_seek_pts(struct anim_keyframe_index *idx, int64_t pts);
+void IMB_keyframe_index_close(struct anim_keyframe_index *idx);
+
 void IMB_free_indices(struct anim *anim);
 
 struct anim *IMB_anim_open_proxy(struct anim *anim, IMB_Proxy_Size preview_size);
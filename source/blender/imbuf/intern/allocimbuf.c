@@ -380,7 +380,10 @@ void *imb_alloc_pixels(
   }
 
   size_t size = (size_t)x * (size_t)y * (size_t)channels * typesize;
-  return MEM_callocN(size, name);
+  const eMEMDomain previous_domain = MEM_domain_begin(MEM_DOMAIN_IMAGE);
+  void *pixels = MEM_callocN(size, name);
+  MEM_domain_end(previous_domain);
+  return pixels;
 }
 
 bool imb_addrectfloatImBuf(ImBuf *ibuf)
@@ -79,6 +79,7 @@
 
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -507,6 +508,112 @@ BLI_INLINE bool need_aligned_ffmpeg_buffer(struct anim *anim)
   return (anim->x & 31) != 0;
 }
 
+/* Hardware decoding with device contexts needs FFmpeg 4.0. */
+#  if LIBAVCODEC_VERSION_MAJOR >= 58
+#    define FFMPEG_USE_HW_DECODE
+#  endif
+
+#  ifdef FFMPEG_USE_HW_DECODE
+static enum AVPixelFormat ffmpeg_get_hw_format(AVCodecContext *pCodecCtx,
+                                               const enum AVPixelFormat *pix_fmts)
+{
+  struct anim *anim = pCodecCtx->opaque;
+
+  for (const enum AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+
+  /* The stream can't be decoded by the device, fall back to software decoding. */
+  return avcodec_default_get_format(pCodecCtx, pix_fmts);
+}
+
+/* Set up decoding on the first hardware device supported by both the codec and the system.
+ * Frames are still converted on the CPU, so they are downloaded as they are decoded. */
+static void ffmpeg_hw_decode_init(struct anim *anim, AVCodec *pCodec, AVCodecContext *pCodecCtx)
+{
+  for (int i = 0;; i++) {
+    const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+    if (config == NULL) {
+      break;
+    }
+    if ((config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0) {
+      continue;
+    }
+
+    AVBufferRef *hw_device_ctx = NULL;
+    if (av_hwdevice_ctx_create(&hw_device_ctx, config->device_type, NULL, NULL, 0) < 0) {
+      continue;
+    }
+
+    av_log(pCodecCtx,
+           AV_LOG_INFO,
+           "Using %s hardware decoding\n",
+           av_hwdevice_get_type_name(config->device_type));
+
+    pCodecCtx->hw_device_ctx = hw_device_ctx;
+    pCodecCtx->opaque = anim;
+    pCodecCtx->get_format = ffmpeg_get_hw_format;
+    anim->hw_pix_fmt = config->pix_fmt;
+    return;
+  }
+}
+#  endif /* FFMPEG_USE_HW_DECODE */
+
+static bool ffmpeg_sws_context_create(struct anim *anim, enum AVPixelFormat pix_fmt)
+{
+  /* The following for color space determination */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+
+  anim->img_convert_ctx = sws_getContext(anim->x,
+                                         anim->y,
+                                         pix_fmt,
+                                         anim->x,
+                                         anim->y,
+                                         AV_PIX_FMT_RGBA,
+                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
+                                         NULL,
+                                         NULL,
+                                         NULL);
+
+  if (!anim->img_convert_ctx) {
+    return false;
+  }
+  anim->img_convert_pix_fmt = pix_fmt;
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
+  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation)) {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(anim->img_convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation)) {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  return true;
+}
+
 static int startffmpeg(struct anim *anim)
 {
   int i, video_stream_index;
@@ -520,11 +627,6 @@ static int startffmpeg(struct anim *anim)
   double frs_den;
   int streamcount;
 
-  /* The following for color space determination */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-
   if (anim == NULL) {
     return (-1);
   }
@@ -588,7 +690,17 @@ static int startffmpeg(struct anim *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  /* Deinterlacing works on the decoder output format, which is only known in advance for software
+   * decoding. */
+  anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+#  ifdef FFMPEG_USE_HW_DECODE
+  if ((anim->ib_flags & IB_animhwdecode) && !(anim->ib_flags & IB_animdeinterlace)) {
+    ffmpeg_hw_decode_init(anim, pCodec, pCodecCtx);
+  }
+#  endif
+
   if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
+    avcodec_free_context(&pCodecCtx);
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -705,6 +817,7 @@ static int startffmpeg(struct anim *anim)
   anim->pFrameComplete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
+  anim->pFrameHW = av_frame_alloc();
 
   if (need_aligned_ffmpeg_buffer(anim)) {
     anim->pFrameRGB->format = AV_PIX_FMT_RGBA;
@@ -719,6 +832,7 @@ static int startffmpeg(struct anim *anim)
       av_frame_free(&anim->pFrameRGB);
       av_frame_free(&anim->pFrameDeinterlaced);
       av_frame_free(&anim->pFrame);
+      av_frame_free(&anim->pFrameHW);
       anim->pCodecCtx = NULL;
       return -1;
     }
@@ -732,6 +846,7 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHW);
     anim->pCodecCtx = NULL;
     return -1;
   }
@@ -750,18 +865,7 @@ static int startffmpeg(struct anim *anim)
                          1);
   }
 
-  anim->img_convert_ctx = sws_getContext(anim->x,
-                                         anim->y,
-                                         anim->pCodecCtx->pix_fmt,
-                                         anim->x,
-                                         anim->y,
-                                         AV_PIX_FMT_RGBA,
-                                         SWS_BILINEAR | SWS_PRINT_INFO | SWS_FULL_CHR_H_INT,
-                                         NULL,
-                                         NULL,
-                                         NULL);
-
-  if (!anim->img_convert_ctx) {
+  if (!ffmpeg_sws_context_create(anim, anim->pCodecCtx->pix_fmt)) {
     fprintf(stderr, "Can't transform color space??? Bailing out...\n");
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
@@ -769,37 +873,11 @@ static int startffmpeg(struct anim *anim)
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHW);
     anim->pCodecCtx = NULL;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF Jpeg MotionJpeg) */
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation)) {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation)) {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -939,6 +1017,39 @@ static void ffmpeg_postprocess(struct anim *anim)
   }
 }
 
+/* Download a frame decoded on a hardware device to anim->pFrame, so it can be converted like
+ * software decoded frames. */
+static void ffmpeg_hw_frame_download(struct anim *anim)
+{
+  if (anim->hw_pix_fmt == AV_PIX_FMT_NONE || anim->pFrame->format != anim->hw_pix_fmt) {
+    return;
+  }
+
+  AVFrame *hw_frame = anim->pFrame;
+  AVFrame *sw_frame = anim->pFrameHW;
+  av_frame_unref(sw_frame);
+
+  if (av_hwframe_transfer_data(sw_frame, hw_frame, 0) < 0 ||
+      av_frame_copy_props(sw_frame, hw_frame) < 0) {
+    fprintf(stderr, "Could not download hardware decoded frame.\n");
+    anim->pFrameComplete = false;
+    return;
+  }
+
+  /* Keep the device frame around to be reused by the decoder. */
+  anim->pFrame = sw_frame;
+  anim->pFrameHW = hw_frame;
+
+  if (sw_frame->format != anim->img_convert_pix_fmt) {
+    sws_freeContext(anim->img_convert_ctx);
+    if (!ffmpeg_sws_context_create(anim, sw_frame->format)) {
+      fprintf(stderr, "Can't transform color space of hardware decoded frame.\n");
+      anim->img_convert_pix_fmt = AV_PIX_FMT_NONE;
+      anim->pFrameComplete = false;
+    }
+  }
+}
+
 /* decode one video frame also considering the packet read into cur_packet */
 
 static int ffmpeg_decode_video_frame(struct anim *anim)
@@ -967,6 +1078,9 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
 
       avcodec_send_packet(anim->pCodecCtx, anim->cur_packet);
       anim->pFrameComplete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+      if (anim->pFrameComplete) {
+        ffmpeg_hw_frame_download(anim);
+      }
 
       if (anim->pFrameComplete) {
         anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
@@ -992,6 +1106,9 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
 
     avcodec_send_packet(anim->pCodecCtx, NULL);
     anim->pFrameComplete = avcodec_receive_frame(anim->pCodecCtx, anim->pFrame) == 0;
+    if (anim->pFrameComplete) {
+      ffmpeg_hw_frame_download(anim);
+    }
 
     if (anim->pFrameComplete) {
       anim->cur_pts = av_get_pts_from_frame(anim->pFrame);
@@ -1262,6 +1379,7 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
                                     struct anim_index *tc_index,
                                     int64_t pts_to_search)
 {
+  struct anim_keyframe_index *keyframe_index;
   int64_t pos;
   int ret;
 
@@ -1298,6 +1416,32 @@ static int ffmpeg_seek_to_key_frame(struct anim *anim,
           anim->pFormatCtx, anim->videoStream, anim->cur_key_frame_pts, AVSEEK_FLAG_BACKWARD);
     }
   }
+  else if ((keyframe_index = IMB_anim_open_keyframe_index(anim))) {
+    /* The key frame index tells which GOP contains the frame, no need to probe the stream. */
+    const int64_t key_frame_pts = IMB_keyframe_index_get_seek_pts(keyframe_index, pts_to_search);
+
+    if (key_frame_pts == anim->cur_key_frame_pts && position > anim->cur_position &&
+        anim->cur_pts < pts_to_search) {
+      /* Frame is further in the GOP we are decoding, simply continue decoding from there. */
+      return 0;
+    }
+
+    pos = key_frame_pts;
+    av_log(anim->pFormatCtx, AV_LOG_DEBUG, "KEY FRAME INDEX seek pts = %" PRId64 "\n", pos);
+
+    AVFormatContext *format_ctx = anim->pFormatCtx;
+
+    if (format_ctx->iformat->read_seek2 || format_ctx->iformat->read_seek) {
+      ret = av_seek_frame(anim->pFormatCtx, anim->videoStream, pos, AVSEEK_FLAG_BACKWARD);
+    }
+    else {
+      ret = ffmpeg_generic_seek_workaround(anim, &pos, key_frame_pts);
+    }
+
+    if (ret >= 0) {
+      anim->cur_key_frame_pts = key_frame_pts;
+    }
+  }
   else {
     /* We have to manually seek with ffmpeg to get to the key frame we want to start decoding from.
      */
@@ -1471,6 +1615,7 @@ static void free_anim_ffmpeg(struct anim *anim)
     av_packet_free(&anim->cur_packet);
 
     av_frame_free(&anim->pFrame);
+    av_frame_free(&anim->pFrameHW);
 
     if (!need_aligned_ffmpeg_buffer(anim)) {
       /* If there's no need for own aligned buffer it means that FFmpeg's
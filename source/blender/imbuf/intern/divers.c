@@ -23,6 +23,7 @@
  */
 
 #include "BLI_math.h"
+#include "BLI_simd.h"
 #include "BLI_utildefines.h"
 
 #include "IMB_filter.h"
@@ -109,6 +110,33 @@ bool IMB_alpha_affects_rgb(const ImBuf *ibuf)
 }
 
 /* float to byte pixels, output 4-channel RGBA */
+#ifdef BLI_HAVE_SSE2
+/* Same as #rgba_float_to_uchar for a row of pixels, with optional conversion from premultiplied
+ * to straight alpha. This is the conversion done for every displayed float image. */
+static void float_to_byte_row_v4(uchar *to, const float *from, const int width, bool predivide)
+{
+  const __m128 scale = _mm_set1_ps(255.0f);
+  const __m128 half = _mm_set1_ps(0.5f);
+  const __m128 zero = _mm_setzero_ps();
+
+  for (int x = 0; x < width; x++, from += 4, to += 4) {
+    __m128 rgba = _mm_loadu_ps(from);
+    if (predivide && !ELEM(from[3], 0.0f, 1.0f)) {
+      const float alpha_inv = 1.0f / from[3];
+      rgba = _mm_mul_ps(rgba, _mm_set_ps(1.0f, alpha_inv, alpha_inv, alpha_inv));
+    }
+    /* Max with zero first so NaN values become zero. */
+    __m128 value = _mm_max_ps(_mm_add_ps(_mm_mul_ps(rgba, scale), half), zero);
+    value = _mm_min_ps(value, scale);
+    __m128i packed = _mm_cvttps_epi32(value);
+    packed = _mm_packs_epi32(packed, packed);
+    packed = _mm_packus_epi16(packed, packed);
+    const int bytes = _mm_cvtsi128_si32(packed);
+    memcpy(to, &bytes, sizeof(bytes));
+  }
+}
+#endif
+
 void IMB_buffer_byte_from_float(uchar *rect_to,
                                 const float *rect_from,
                                 int channels_from,
@@ -196,16 +224,22 @@ void IMB_buffer_byte_from_float(uchar *rect_to,
             float_to_byte_dither_v4(to, from, di, (float)x * inv_width, t);
           }
         }
-        else if (predivide) {
-          for (x = 0; x < width; x++, from += 4, to += 4) {
-            premul_to_straight_v4_v4(straight, from);
-            rgba_float_to_uchar(to, straight);
-          }
-        }
         else {
-          for (x = 0; x < width; x++, from += 4, to += 4) {
-            rgba_float_to_uchar(to, from);
+#ifdef BLI_HAVE_SSE2
+          float_to_byte_row_v4(to, from, width, predivide);
+#else
+          if (predivide) {
+            for (x = 0; x < width; x++, from += 4, to += 4) {
+              premul_to_straight_v4_v4(straight, from);
+              rgba_float_to_uchar(to, straight);
+            }
+          }
+          else {
+            for (x = 0; x < width; x++, from += 4, to += 4) {
+              rgba_float_to_uchar(to, from);
+            }
           }
+#endif
         }
       }
       else if (profile_to == IB_PROFILE_SRGB) {
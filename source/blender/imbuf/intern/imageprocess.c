@@ -126,12 +126,54 @@ void bicubic_interpolation(ImBuf *in, ImBuf *out, float u, float v, int xout, in
 /** \name Bi-Linear Interpolation
  * \{ */
 
+/**
+ * Weights and the offset of the first of the four pixels to interpolate, when all of them are
+ * inside the image. Most samples of a transform are, and those give the same result as
+ * #BLI_bilinear_interpolation_fl without its boundary checks and calls to `floor` and `ceil`.
+ */
+BLI_INLINE bool bilinear_interpolation_inside(
+    const struct ImBuf *in, float u, float v, float r_weights[4], size_t *r_offset)
+{
+  if (!(u >= 0.0f && v >= 0.0f)) {
+    return false;
+  }
+  /* Truncation is the same as `floor` for positive numbers. */
+  const int x1 = (int)u;
+  const int y1 = (int)v;
+  if (x1 + 1 >= in->x || y1 + 1 >= in->y) {
+    return false;
+  }
+
+  const float a = u - (float)x1;
+  const float b = v - (float)y1;
+  r_weights[0] = (1.0f - a) * (1.0f - b);
+  r_weights[1] = a * (1.0f - b);
+  r_weights[2] = (1.0f - a) * b;
+  r_weights[3] = a * b;
+  *r_offset = ((size_t)in->x * y1 + x1) * 4;
+  return true;
+}
+
 BLI_INLINE void bilinear_interpolation_color_fl(
     struct ImBuf *in, unsigned char UNUSED(outI[4]), float outF[4], float u, float v)
 {
   BLI_assert(outF);
   BLI_assert(in->rect_float);
-  BLI_bilinear_interpolation_fl(in->rect_float, outF, in->x, in->y, 4, u, v);
+
+  float w[4];
+  size_t offset;
+  if (!bilinear_interpolation_inside(in, u, v, w, &offset)) {
+    BLI_bilinear_interpolation_fl(in->rect_float, outF, in->x, in->y, 4, u, v);
+    return;
+  }
+
+  const float *row1 = in->rect_float + offset;
+  const float *row2 = row1 + (size_t)in->x * 4;
+  const float *row3 = row1 + 4;
+  const float *row4 = row2 + 4;
+  for (int i = 0; i < 4; i++) {
+    outF[i] = w[0] * row1[i] + w[1] * row3[i] + w[2] * row2[i] + w[3] * row4[i];
+  }
 }
 
 BLI_INLINE void bilinear_interpolation_color_char(
@@ -139,7 +181,22 @@ BLI_INLINE void bilinear_interpolation_color_char(
 {
   BLI_assert(outI);
   BLI_assert(in->rect);
-  BLI_bilinear_interpolation_char((unsigned char *)in->rect, outI, in->x, in->y, 4, u, v);
+
+  float w[4];
+  size_t offset;
+  if (!bilinear_interpolation_inside(in, u, v, w, &offset)) {
+    BLI_bilinear_interpolation_char((unsigned char *)in->rect, outI, in->x, in->y, 4, u, v);
+    return;
+  }
+
+  const unsigned char *row1 = (unsigned char *)in->rect + offset;
+  const unsigned char *row2 = row1 + (size_t)in->x * 4;
+  const unsigned char *row3 = row1 + 4;
+  const unsigned char *row4 = row2 + 4;
+  for (int i = 0; i < 4; i++) {
+    outI[i] = (unsigned char)(w[0] * row1[i] + w[1] * row3[i] + w[2] * row2[i] +
+                              w[3] * row4[i] + 0.5f);
+  }
 }
 
 void bilinear_interpolation_color(
@@ -66,6 +66,7 @@ static int tc_types[] = {
 #endif
 
 #define INDEX_FILE_VERSION 2
+#define KEYFRAME_INDEX_FILE_VERSION 1
 
 /* ----------------------------------------------------------------------
  * - time code index functions
@@ -472,6 +473,274 @@ static void get_tc_filename(struct anim *anim, IMB_Timecode_Type tc, char *fname
   BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
 }
 
+/* ----------------------------------------------------------------------
+ * - key frame index
+ * ---------------------------------------------------------------------- */
+
+#ifdef WITH_FFMPEG
+
+static const char keyframe_header_str[] = "BlenKIdx";
+
+static void get_keyframe_index_filename(struct anim *anim, char *fname)
+{
+  char index_dir[FILE_MAXDIR];
+  char stream_suffix[20];
+  char index_name[256];
+
+  stream_suffix[0] = 0;
+
+  if (anim->streamindex > 0) {
+    BLI_snprintf(stream_suffix, 20, "_st%d", anim->streamindex);
+  }
+
+  BLI_snprintf(index_name, 256, "key_frames%s%s.blen_kf", stream_suffix, anim->suffix);
+
+  get_index_dir(anim, index_dir, sizeof(index_dir));
+
+  BLI_join_dirfile(fname, FILE_MAXFILE + FILE_MAXDIR, index_dir, index_name);
+}
+
+/* Size and modification time of the movie, stored in the index to detect changes of the file. */
+static bool keyframe_index_get_stamp(struct anim *anim, int64_t r_stamp[2])
+{
+  BLI_stat_t st;
+
+  if (BLI_stat(anim->name, &st) != 0) {
+    return false;
+  }
+
+  r_stamp[0] = (int64_t)st.st_size;
+  r_stamp[1] = (int64_t)st.st_mtime;
+  return true;
+}
+
+static struct anim_keyframe_index *keyframe_index_read(const char *name, const int64_t stamp[2])
+{
+  char header[13];
+  int64_t file_stamp[2];
+  FILE *fp = BLI_fopen(name, "rb");
+
+  if (!fp) {
+    return NULL;
+  }
+
+  if (fread(header, 12, 1, fp) != 1 || fread(file_stamp, sizeof(file_stamp), 1, fp) != 1) {
+    fprintf(stderr, "Couldn't read key frame index file: %s\n", name);
+    fclose(fp);
+    return NULL;
+  }
+
+  header[12] = 0;
+
+  if (memcmp(header, keyframe_header_str, 8) != 0 ||
+      atoi(header + 9) != KEYFRAME_INDEX_FILE_VERSION) {
+    fprintf(stderr, "Error reading %s: Binary file type or version mismatch\n", name);
+    fclose(fp);
+    return NULL;
+  }
+
+  const bool switch_endian = (ENDIAN_ORDER == B_ENDIAN) != (header[8] == 'V');
+  if (switch_endian) {
+    BLI_endian_switch_int64_array(file_stamp, 2);
+  }
+
+  if (file_stamp[0] != stamp[0] || file_stamp[1] != stamp[1]) {
+    /* Movie was modified after the index was written, it has to be built again. */
+    fclose(fp);
+    return NULL;
+  }
+
+  fseek(fp, 0, SEEK_END);
+  const int num_entries = (ftell(fp) - 12 - sizeof(file_stamp)) / sizeof(int64_t);
+  fseek(fp, 12 + sizeof(file_stamp), SEEK_SET);
+
+  if (num_entries <= 0) {
+    fclose(fp);
+    return NULL;
+  }
+
+  struct anim_keyframe_index *idx = MEM_callocN(sizeof(struct anim_keyframe_index),
+                                                "anim_keyframe_index");
+  idx->num_entries = num_entries;
+  idx->pts = MEM_mallocN(sizeof(int64_t) * num_entries, "anim_keyframe_index_pts");
+
+  if (fread(idx->pts, sizeof(int64_t), num_entries, fp) != (size_t)num_entries) {
+    fprintf(stderr, "Error: Element data size mismatch in: %s\n", name);
+    IMB_keyframe_index_close(idx);
+    fclose(fp);
+    return NULL;
+  }
+
+  if (switch_endian) {
+    BLI_endian_switch_int64_array(idx->pts, num_entries);
+  }
+
+  fclose(fp);
+
+  return idx;
+}
+
+static void keyframe_index_write(const char *name,
+                                 const int64_t stamp[2],
+                                 const struct anim_keyframe_index *idx)
+{
+  char temp_name[FILE_MAX];
+  BLI_snprintf(temp_name, sizeof(temp_name), "%s%s", name, temp_ext);
+
+  BLI_make_existing_file(temp_name);
+
+  FILE *fp = BLI_fopen(temp_name, "wb");
+  if (!fp) {
+    /* Index directory is not writable, the index is only kept for this session. */
+    return;
+  }
+
+  fprintf(fp,
+          "%s%c%.3d",
+          keyframe_header_str,
+          (ENDIAN_ORDER == B_ENDIAN) ? 'V' : 'v',
+          KEYFRAME_INDEX_FILE_VERSION);
+
+  const bool written = fwrite(stamp, sizeof(int64_t), 2, fp) == 2 &&
+                       fwrite(idx->pts, sizeof(int64_t), idx->num_entries, fp) ==
+                           (size_t)idx->num_entries;
+  fclose(fp);
+
+  if (written) {
+    unlink(name);
+    BLI_rename(temp_name, name);
+  }
+  else {
+    unlink(temp_name);
+  }
+}
+
+static int keyframe_index_cmp_pts(const void *a_v, const void *b_v)
+{
+  const int64_t a = *(const int64_t *)a_v;
+  const int64_t b = *(const int64_t *)b_v;
+  return (a > b) - (a < b);
+}
+
+static struct anim_keyframe_index *keyframe_index_build(struct anim *anim)
+{
+  AVFormatContext *format_ctx = NULL;
+
+  if (avformat_open_input(&format_ctx, anim->name, NULL, NULL) != 0) {
+    return NULL;
+  }
+
+  if (avformat_find_stream_info(format_ctx, NULL) < 0 || anim->videoStream < 0 ||
+      anim->videoStream >= (int)format_ctx->nb_streams ||
+      format_ctx->streams[anim->videoStream]->codecpar->codec_type != AVMEDIA_TYPE_VIDEO) {
+    avformat_close_input(&format_ctx);
+    return NULL;
+  }
+
+  /* Only the packet flags and time-stamps are needed, let the demuxer skip what it can. */
+  for (int i = 0; i < format_ctx->nb_streams; i++) {
+    format_ctx->streams[i]->discard = (i == anim->videoStream) ? AVDISCARD_NONKEY : AVDISCARD_ALL;
+  }
+
+  int num_entries = 0;
+  int max_entries = 256;
+  int64_t *pts = MEM_mallocN(sizeof(int64_t) * max_entries, "anim_keyframe_index_pts");
+
+  AVPacket *packet = av_packet_alloc();
+  while (av_read_frame(format_ctx, packet) >= 0) {
+    if (packet->stream_index == anim->videoStream && (packet->flags & AV_PKT_FLAG_KEY)) {
+      const int64_t packet_pts = timestamp_from_pts_or_dts(packet->pts, packet->dts);
+      if (packet_pts != AV_NOPTS_VALUE) {
+        if (num_entries == max_entries) {
+          max_entries *= 2;
+          pts = MEM_reallocN(pts, sizeof(int64_t) * max_entries);
+        }
+        pts[num_entries++] = packet_pts;
+      }
+    }
+    av_packet_unref(packet);
+  }
+  av_packet_free(&packet);
+  avformat_close_input(&format_ctx);
+
+  if (num_entries == 0) {
+    MEM_freeN(pts);
+    return NULL;
+  }
+
+  /* Packets come in decoding order, which is not always the presentation order. */
+  qsort(pts, num_entries, sizeof(int64_t), keyframe_index_cmp_pts);
+
+  struct anim_keyframe_index *idx = MEM_callocN(sizeof(struct anim_keyframe_index),
+                                                "anim_keyframe_index");
+  idx->num_entries = num_entries;
+  idx->pts = pts;
+
+  return idx;
+}
+
+#endif /* WITH_FFMPEG */
+
+struct anim_keyframe_index *IMB_anim_open_keyframe_index(struct anim *anim)
+{
+  if (anim->keyframe_idx) {
+    return anim->keyframe_idx;
+  }
+
+  if (anim->keyframe_index_tried) {
+    return NULL;
+  }
+
+  anim->keyframe_index_tried = 1;
+
+#ifdef WITH_FFMPEG
+  char fname[FILE_MAX];
+  int64_t stamp[2];
+
+  if (anim->curtype != ANIM_FFMPEG || !keyframe_index_get_stamp(anim, stamp)) {
+    return NULL;
+  }
+
+  get_keyframe_index_filename(anim, fname);
+
+  anim->keyframe_idx = keyframe_index_read(fname, stamp);
+
+  if (!anim->keyframe_idx) {
+    anim->keyframe_idx = keyframe_index_build(anim);
+    if (anim->keyframe_idx) {
+      keyframe_index_write(fname, stamp, anim->keyframe_idx);
+    }
+  }
+#endif
+
+  return anim->keyframe_idx;
+}
+
+/* Time-stamp of the last key frame at or before the given one, or the first key frame. */
+int64_t IMB_keyframe_index_get_seek_pts(struct anim_keyframe_index *idx, int64_t pts)
+{
+  int low = 0;
+  int high = idx->num_entries - 1;
+
+  while (low < high) {
+    const int mid = (low + high + 1) / 2;
+    if (idx->pts[mid] <= pts) {
+      low = mid;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+
+  return idx->pts[low];
+}
+
+void IMB_keyframe_index_close(struct anim_keyframe_index *idx)
+{
+  MEM_freeN(idx->pts);
+  MEM_freeN(idx);
+}
+
 /* ----------------------------------------------------------------------
  * - common rebuilder structures
  * ---------------------------------------------------------------------- */
@@ -1409,8 +1678,14 @@ void IMB_free_indices(struct anim *anim)
     }
   }
 
+  if (anim->keyframe_idx) {
+    IMB_keyframe_index_close(anim->keyframe_idx);
+    anim->keyframe_idx = NULL;
+  }
+
   anim->proxies_tried = 0;
   anim->indices_tried = 0;
+  anim->keyframe_index_tried = 0;
 }
 
 void IMB_anim_set_index_dir(struct anim *anim, const char *dir)
@@ -369,7 +369,8 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   mem_limit = MEM_CacheLimiter_get_maximum();
 
   BLI_mutex_lock(&limitor_lock);
-  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
+  mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor) +
+               MEM_CacheLimiter_get_external_memory_in_use();
 
   if (mem_in_use + elem_size <= mem_limit) {
     do_moviecache_put(cache, userkey, ibuf, false);
@@ -381,6 +382,19 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
   return result;
 }
 
+size_t IMB_moviecache_get_memory_in_use(void)
+{
+  size_t mem_in_use = 0;
+
+  BLI_mutex_lock(&limitor_lock);
+  if (limitor) {
+    mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
+  }
+  BLI_mutex_unlock(&limitor_lock);
+
+  return mem_in_use;
+}
+
 void IMB_moviecache_remove(MovieCache *cache, void *userkey)
 {
   MovieCacheKey key;
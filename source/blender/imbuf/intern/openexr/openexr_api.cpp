@@ -646,6 +646,8 @@ struct ExrHandle {
   ListBase layers;   /* hierarchical, pointing in end to ExrChannel */
 
   int num_half_channels; /* used during filr save, allows faster temporary buffers allocation */
+
+  bool use_pass_selection; /* only read the passes selected with IMB_exr_select_pass */
 };
 
 /* flattened out channel */
@@ -659,6 +661,7 @@ struct ExrChannel {
   char chan_id;                   /* quick lookup of channel char */
   int view_id;                    /* quick lookup of channel view */
   bool use_half_float;            /* when saving use half float for file storage */
+  bool selected;                  /* picked with IMB_exr_select_pass */
 };
 
 /* hierarchical; layers -> passes -> channels[] */
@@ -673,6 +676,7 @@ struct ExrPass {
   char internal_name[EXR_PASS_MAXNAME]; /* name with no view */
   char view[EXR_VIEW_MAXNAME];
   int view_id;
+  bool selected;
 };
 
 struct ExrLayer {
@@ -682,6 +686,8 @@ struct ExrLayer {
 };
 
 static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data);
+static void imb_exr_pass_rect_ensure(ExrHandle *data, ExrPass *pass);
+static int imb_exr_split_channel_name(ExrChannel *echan, char *layname, char *passname);
 
 /* ********************** */
 
@@ -1220,6 +1226,57 @@ void IMB_exrtile_write_channels(
   }
 }
 
+/**
+ * Restrict #IMB_exr_read_channels to the passes matching \a layname and \a passname (the pass
+ * name without view), NULL matching any name. Can be called several times to select more passes.
+ * Passes that aren't selected are neither allocated nor decoded, and are left out of
+ * #IMB_exr_multilayer_convert. For handles opened without parsing the channels, the selection
+ * is matched against the channel names and only restricts which of the channels given a rect
+ * with #IMB_exr_set_channel are read.
+ *
+ * \return true when at least one pass matched.
+ */
+bool IMB_exr_select_pass(void *handle, const char *layname, const char *passname)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  bool found = false;
+
+  data->use_pass_selection = true;
+
+  if (BLI_listbase_is_empty(&data->layers)) {
+    for (ExrChannel *echan = (ExrChannel *)data->channels.first; echan; echan = echan->next) {
+      char lay[EXR_TOT_MAXNAME], pass[EXR_TOT_MAXNAME];
+      const char chan_id = echan->chan_id;
+      const bool ok = imb_exr_split_channel_name(echan, lay, pass);
+      echan->chan_id = chan_id;
+
+      if (ok && (!layname || STREQ(lay, layname)) && (!passname || STREQ(pass, passname))) {
+        echan->selected = true;
+        found = true;
+      }
+    }
+    return found;
+  }
+
+  for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
+    if (layname && !STREQ(lay->name, layname)) {
+      continue;
+    }
+    for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+      if (passname && !STREQ(pass->internal_name, passname)) {
+        continue;
+      }
+      pass->selected = true;
+      for (int a = 0; a < pass->totchan; a++) {
+        pass->chan[a]->selected = true;
+      }
+      found = true;
+    }
+  }
+
+  return found;
+}
+
 void IMB_exr_read_channels(void *handle)
 {
   ExrHandle *data = (ExrHandle *)handle;
@@ -1232,6 +1289,15 @@ void IMB_exr_read_channels(void *handle)
   /* 'previous multilayer attribute, flipped. */
   short flip = (ta && STRPREFIX(ta->value().c_str(), "Blender V2.43"));
 
+  /* Allocate the passes to read, when the channels have been parsed. */
+  for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
+    for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+      if (!data->use_pass_selection || pass->selected) {
+        imb_exr_pass_rect_ensure(data, pass);
+      }
+    }
+  }
+
   exr_printf(
       "\nIMB_exr_read_channels\n%s %-6s %-22s "
       "\"%s\"\n---------------------------------------------------------------------\n",
@@ -1261,6 +1327,10 @@ void IMB_exr_read_channels(void *handle)
                  echan->m->name.c_str(),
                  echan->m->internal_name.c_str());
 
+      if (data->use_pass_selection && !echan->selected) {
+        continue;
+      }
+
       if (echan->rect) {
         float *rect = echan->rect;
         size_t xstride = echan->xstride * sizeof(float);
@@ -1281,11 +1351,17 @@ void IMB_exr_read_channels(void *handle)
         frameBuffer.insert(echan->m->internal_name,
                            Slice(Imf::FLOAT, (char *)rect, xstride, ystride));
       }
-      else {
+      else if (!data->use_pass_selection) {
         printf("warning, channel with no rect set %s\n", echan->m->internal_name.c_str());
       }
     }
 
+    /* Nothing to decode in this part, skip it instead of decompressing every chunk of it. */
+    if (frameBuffer.begin() == frameBuffer.end()) {
+      exr_printf("readPixels:skipping part %d, no channels requested\n", i);
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1332,9 +1408,21 @@ void IMB_exr_multilayer_convert(void *handle,
   }
 
   for (lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
+    /* Leave out the layers and passes that haven't been read. */
+    bool has_rect = false;
+    for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+      has_rect |= pass->rect != nullptr;
+    }
+    if (!has_rect) {
+      continue;
+    }
+
     void *laybase = addlayer(base, lay->name);
     if (laybase) {
       for (pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
+        if (pass->rect == nullptr) {
+          continue;
+        }
         addpass(base,
                 laybase,
                 pass->internal_name,
@@ -1594,71 +1682,73 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
     return false;
   }
 
+  return true;
+}
+
+/* Allocate the buffer of a pass parsed from a file, and point its channels to it. */
+static void imb_exr_pass_rect_ensure(ExrHandle *data, ExrPass *pass)
+{
+  if (pass->rect != nullptr || pass->totchan == 0) {
+    return;
+  }
+
   /* with some heuristics, try to merge the channels in buffers */
-  for (ExrLayer *lay = (ExrLayer *)data->layers.first; lay; lay = lay->next) {
-    for (ExrPass *pass = (ExrPass *)lay->passes.first; pass; pass = pass->next) {
-      if (pass->totchan) {
-        pass->rect = (float *)MEM_callocN(
-            data->width * data->height * pass->totchan * sizeof(float), "pass rect");
-        if (pass->totchan == 1) {
-          ExrChannel *echan = pass->chan[0];
-          echan->rect = pass->rect;
-          echan->xstride = 1;
-          echan->ystride = data->width;
-          pass->chan_id[0] = echan->chan_id;
-        }
-        else {
-          char lookup[256];
-
-          memset(lookup, 0, sizeof(lookup));
-
-          /* we can have RGB(A), XYZ(W), UVA */
-          if (ELEM(pass->totchan, 3, 4)) {
-            if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
-                pass->chan[2]->chan_id == 'B') {
-              lookup[(unsigned int)'R'] = 0;
-              lookup[(unsigned int)'G'] = 1;
-              lookup[(unsigned int)'B'] = 2;
-              lookup[(unsigned int)'A'] = 3;
-            }
-            else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
-                     pass->chan[2]->chan_id == 'Y') {
-              lookup[(unsigned int)'X'] = 0;
-              lookup[(unsigned int)'Y'] = 1;
-              lookup[(unsigned int)'Z'] = 2;
-              lookup[(unsigned int)'W'] = 3;
-            }
-            else {
-              lookup[(unsigned int)'U'] = 0;
-              lookup[(unsigned int)'V'] = 1;
-              lookup[(unsigned int)'A'] = 2;
-            }
-            for (int a = 0; a < pass->totchan; a++) {
-              echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[(unsigned int)echan->chan_id];
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[(unsigned int)lookup[(unsigned int)echan->chan_id]] = echan->chan_id;
-            }
-          }
-          else { /* unknown */
-            for (int a = 0; a < pass->totchan; a++) {
-              ExrChannel *echan = pass->chan[a];
-              echan->rect = pass->rect + a;
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[a] = echan->chan_id;
-            }
-          }
-        }
+  pass->rect = (float *)MEM_callocN(
+      data->width * data->height * pass->totchan * sizeof(float), "pass rect");
+  if (pass->totchan == 1) {
+    ExrChannel *echan = pass->chan[0];
+    echan->rect = pass->rect;
+    echan->xstride = 1;
+    echan->ystride = data->width;
+    pass->chan_id[0] = echan->chan_id;
+  }
+  else {
+    char lookup[256];
+
+    memset(lookup, 0, sizeof(lookup));
+
+    /* we can have RGB(A), XYZ(W), UVA */
+    if (ELEM(pass->totchan, 3, 4)) {
+      if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
+          pass->chan[2]->chan_id == 'B') {
+        lookup[(unsigned int)'R'] = 0;
+        lookup[(unsigned int)'G'] = 1;
+        lookup[(unsigned int)'B'] = 2;
+        lookup[(unsigned int)'A'] = 3;
+      }
+      else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
+               pass->chan[2]->chan_id == 'Y') {
+        lookup[(unsigned int)'X'] = 0;
+        lookup[(unsigned int)'Y'] = 1;
+        lookup[(unsigned int)'Z'] = 2;
+        lookup[(unsigned int)'W'] = 3;
+      }
+      else {
+        lookup[(unsigned int)'U'] = 0;
+        lookup[(unsigned int)'V'] = 1;
+        lookup[(unsigned int)'A'] = 2;
+      }
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = pass->rect + lookup[(unsigned int)echan->chan_id];
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[(unsigned int)lookup[(unsigned int)echan->chan_id]] = echan->chan_id;
+      }
+    }
+    else { /* unknown */
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = pass->rect + a;
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[a] = echan->chan_id;
       }
     }
   }
-
-  return true;
 }
 
-/* creates channels, makes a hierarchy and assigns memory to channels */
+/* creates channels and makes a hierarchy, memory is assigned to the channels when reading */
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
                                          int width,
@@ -1680,6 +1770,46 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   return data;
 }
 
+/**
+ * Read only the beauty pass of the first layer of a multilayer file into the float buffer of
+ * \a ibuf, the other passes aren't decoded. Return false when there is no pass to read.
+ */
+static bool imb_exr_multilayer_read_thumbnail(ExrHandle *data, ImBuf *ibuf)
+{
+  ExrLayer *lay = (ExrLayer *)data->layers.first;
+  if (lay == nullptr || BLI_listbase_is_empty(&lay->passes)) {
+    return false;
+  }
+
+  ExrPass *pass = (ExrPass *)BLI_findstring(
+      &lay->passes, "Combined", offsetof(ExrPass, internal_name));
+  if (pass == nullptr) {
+    pass = (ExrPass *)lay->passes.first;
+  }
+
+  IMB_exr_select_pass(data, lay->name, pass->internal_name);
+  IMB_exr_read_channels(data);
+  if (pass->rect == nullptr) {
+    return false;
+  }
+
+  imb_addrectfloatImBuf(ibuf);
+  const int totchan = pass->totchan;
+  const size_t totpixel = (size_t)ibuf->x * ibuf->y;
+  for (size_t a = 0; a < totpixel; a++) {
+    const float *src = pass->rect + a * totchan;
+    float *color = ibuf->rect_float + a * 4;
+    for (int i = 0; i < 3; i++) {
+      color[i] = (totchan >= 3) ? src[i] : src[0];
+    }
+    color[3] = (totchan == 4) ? src[3] : 1.0f;
+  }
+  if (totchan == 4) {
+    ibuf->planes = 32;
+  }
+  return true;
+}
+
 /* ********************************************************* */
 
 /* debug only */
@@ -1950,7 +2080,7 @@ struct ImBuf *imb_load_openexr(const unsigned char *mem,
     is_multi = imb_exr_is_multi(*file);
 
     /* do not make an ibuf when */
-    if (is_multi && !(flags & IB_test) && !(flags & IB_multilayer)) {
+    if (is_multi && !(flags & IB_test) && !(flags & (IB_multilayer | IB_thumbnail))) {
       printf("Error: can't process EXR multilayer file\n");
     }
     else {
@@ -1995,6 +2125,14 @@ struct ImBuf *imb_load_openexr(const unsigned char *mem,
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
         }
+        else if (is_multi) {
+          /* Thumbnail of a multilayer file. The handle owns the file, also when it fails. */
+          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
+          if (handle) {
+            imb_exr_multilayer_read_thumbnail(handle, ibuf);
+            IMB_exr_close(handle);
+          }
+        }
         else {
           const char *rgb_channels[3];
           const int num_rgb_channels = exr_has_rgb(*file, rgb_channels);
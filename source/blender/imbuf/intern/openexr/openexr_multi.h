@@ -72,6 +72,7 @@ float *IMB_exr_channel_rect(void *handle,
                             const char *passname,
                             const char *view);
 
+bool IMB_exr_select_pass(void *handle, const char *layname, const char *passname);
 void IMB_exr_read_channels(void *handle);
 void IMB_exr_write_channels(void *handle);
 void IMB_exrtile_write_channels(
@@ -86,6 +86,13 @@ float *IMB_exr_channel_rect(void * /*handle*/,
   return nullptr;
 }
 
+bool IMB_exr_select_pass(void * /*handle*/,
+                         const char * /*layname*/,
+                         const char * /*passname*/)
+{
+  return false;
+}
+
 void IMB_exr_read_channels(void * /*handle*/)
 {
 }
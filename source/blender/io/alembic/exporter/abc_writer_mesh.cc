@@ -24,6 +24,7 @@
 
 #include "BLI_assert.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_attribute.h"
 #include "BKE_customdata.h"
@@ -437,11 +438,27 @@ static void get_vertices(struct Mesh *mesh, std::vector<Imath::V3f> &points)
   points.clear();
   points.resize(mesh->totvert);
 
-  MVert *verts = mesh->mvert;
+  const MVert *verts = mesh->mvert;
 
-  for (int i = 0, e = mesh->totvert; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), verts[i].co);
-  }
+  threading::parallel_for(IndexRange(mesh->totvert), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), verts[i].co);
+    }
+  });
+}
+
+/* Start of the loops of every polygon in the face-varying arrays, which are written polygon by
+ * polygon, with the total number of loops as last element. */
+static std::vector<int> get_poly_offsets(const struct Mesh *mesh)
+{
+  std::vector<int> offsets(mesh->totpoly + 1);
+  int offset = 0;
+  for (int i = 0; i < mesh->totpoly; i++) {
+    offsets[i] = offset;
+    offset += mesh->mpoly[i].totloop;
+  }
+  offsets[mesh->totpoly] = offset;
+  return offsets;
 }
 
 static void get_topology(struct Mesh *mesh,
@@ -450,29 +467,34 @@ static void get_topology(struct Mesh *mesh,
                          bool &r_has_flat_shaded_poly)
 {
   const int num_poly = mesh->totpoly;
-  const int num_loops = mesh->totloop;
-  MLoop *mloop = mesh->mloop;
-  MPoly *mpoly = mesh->mpoly;
+  const MLoop *mloop = mesh->mloop;
+  const MPoly *mpoly = mesh->mpoly;
+  const std::vector<int> offsets = get_poly_offsets(mesh);
   r_has_flat_shaded_poly = false;
 
   poly_verts.clear();
   loop_counts.clear();
-  poly_verts.reserve(num_loops);
-  loop_counts.reserve(num_poly);
+  poly_verts.resize(offsets[num_poly]);
+  loop_counts.resize(num_poly);
 
-  /* NOTE: data needs to be written in the reverse order. */
   for (int i = 0; i < num_poly; i++) {
-    MPoly &poly = mpoly[i];
-    loop_counts.push_back(poly.totloop);
+    r_has_flat_shaded_poly |= (mpoly[i].flag & ME_SMOOTH) == 0;
+  }
 
-    r_has_flat_shaded_poly |= (poly.flag & ME_SMOOTH) == 0;
+  /* NOTE: data needs to be written in the reverse order. */
+  threading::parallel_for(IndexRange(num_poly), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly &poly = mpoly[i];
+      loop_counts[i] = poly.totloop;
 
-    MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+      const MLoop *loop = mloop + poly.loopstart + (poly.totloop - 1);
+      int32_t *abc_poly_verts = &poly_verts[offsets[i]];
 
-    for (int j = 0; j < poly.totloop; j++, loop--) {
-      poly_verts.push_back(loop->v);
+      for (int j = 0; j < poly.totloop; j++, loop--) {
+        abc_poly_verts[j] = loop->v;
+      }
     }
-  }
+  });
 }
 
 static void get_creases(struct Mesh *mesh,
@@ -520,15 +542,20 @@ static void get_loop_normals(struct Mesh *mesh,
 
   normals.resize(mesh->totloop);
 
+  const MPoly *mpoly = mesh->mpoly;
+  const std::vector<int> offsets = get_poly_offsets(mesh);
+
   /* NOTE: data needs to be written in the reverse order. */
-  int abc_index = 0;
-  MPoly *mp = mesh->mpoly;
-  for (int i = 0, e = mesh->totpoly; i < e; i++, mp++) {
-    for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
-      int blender_index = mp->loopstart + j;
-      copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+  threading::parallel_for(IndexRange(mesh->totpoly), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const MPoly *mp = &mpoly[i];
+      int abc_index = offsets[i];
+      for (int j = mp->totloop - 1; j >= 0; j--, abc_index++) {
+        const int blender_index = mp->loopstart + j;
+        copy_yup_from_zup(normals[abc_index].getValue(), lnors[blender_index]);
+      }
     }
-  }
+  });
 }
 
 ABCMeshWriter::ABCMeshWriter(const ABCWriterConstructorArgs &args) : ABCGenericMeshWriter(args)
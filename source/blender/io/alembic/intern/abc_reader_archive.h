@@ -26,6 +26,8 @@
 #include <Alembic/AbcCoreOgawa/All.h>
 
 #include <fstream>
+#include <memory>
+#include <vector>
 
 struct Main;
 
@@ -34,11 +36,14 @@ namespace blender::io::alembic {
 /* Wrappers around input and output archives. The goal is to be able to use
  * streams so that unicode paths work on Windows (T49112), and to make sure that
  * the stream objects remain valid as long as the archives are open.
+ *
+ * Ogawa reads through one of the streams that is not in use by another thread, so the archive
+ * is opened with a stream per thread to let objects of the same archive be read in parallel.
  */
 
 class ArchiveReader {
   Alembic::Abc::IArchive m_archive;
-  std::ifstream m_infile;
+  std::vector<std::unique_ptr<std::ifstream>> m_infiles;
   std::vector<std::istream *> m_streams;
 
  public:
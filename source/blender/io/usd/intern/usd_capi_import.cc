@@ -207,7 +207,9 @@ static void import_startjob(void *customdata, short *stop, short *do_update, flo
   *data->do_update = true;
   *data->progress = 0.1f;
 
-  pxr::UsdStageRefPtr stage = pxr::UsdStage::Open(data->filename);
+  pxr::UsdStageRefPtr stage = pxr::UsdStage::Open(
+      data->filename,
+      data->params.import_payloads ? pxr::UsdStage::LoadAll : pxr::UsdStage::LoadNone);
 
   if (!stage) {
     WM_reportf(RPT_ERROR, "USD Import: unable to open stage to read %s", data->filename);
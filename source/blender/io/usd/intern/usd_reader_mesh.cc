@@ -23,6 +23,7 @@
 #include "usd_reader_material.h"
 
 #include "BKE_customdata.h"
+#include "BKE_lib_id.h"
 #include "BKE_main.h"
 #include "BKE_material.h"
 #include "BKE_mesh.h"
@@ -190,43 +191,66 @@ USDMeshReader::USDMeshReader(const pxr::UsdPrim &prim,
       is_left_handed_(false),
       has_uvs_(false),
       is_time_varying_(false),
-      is_initial_load_(false)
+      is_initial_load_(false),
+      instance_source_(nullptr)
 {
 }
 
 void USDMeshReader::create_object(Main *bmain, const double /* motionSampleTime */)
 {
-  Mesh *mesh = BKE_mesh_add(bmain, name_.c_str());
-
   object_ = BKE_object_add_only_object(bmain, OB_MESH, name_.c_str());
-  object_->data = mesh;
+
+  if (instance_source_ && instance_source_->object()) {
+    Mesh *mesh = (Mesh *)instance_source_->object()->data;
+    id_us_plus(&mesh->id);
+    object_->data = mesh;
+    return;
+  }
+
+  instance_source_ = nullptr;
+  object_->data = BKE_mesh_add(bmain, name_.c_str());
 }
 
 void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
-  is_initial_load_ = true;
-  Mesh *read_mesh = this->read_mesh(
-      mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+  /* Animated meshes are read through a cache modifier per object, so they can't be shared. */
+  if (instance_source_ && instance_source_->is_time_varying_) {
+    id_us_min(&mesh->id);
+    mesh = BKE_mesh_add(bmain, name_.c_str());
+    object_->data = mesh;
+    instance_source_ = nullptr;
+  }
 
-  is_initial_load_ = false;
-  if (read_mesh != mesh) {
-    /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
-    /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that happens. */
-    short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
-    BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
-    mesh->flag |= autosmooth;
+  if (instance_source_) {
+    /* The shared mesh was already read by the source reader. */
+    BKE_object_materials_test(bmain, object_, &mesh->id);
   }
+  else {
+    is_initial_load_ = true;
+    Mesh *read_mesh = this->read_mesh(
+        mesh, motionSampleTime, import_params_.mesh_read_flag, nullptr);
+
+    is_initial_load_ = false;
+    if (read_mesh != mesh) {
+      /* FIXME: after 2.80; `mesh->flag` isn't copied by #BKE_mesh_nomain_to_mesh() */
+      /* read_mesh can be freed by BKE_mesh_nomain_to_mesh(), so get the flag before that
+       * happens. */
+      short autosmooth = (read_mesh->flag & ME_AUTOSMOOTH);
+      BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_, &CD_MASK_MESH, true);
+      mesh->flag |= autosmooth;
+    }
 
-  readFaceSetsSample(bmain, mesh, motionSampleTime);
+    readFaceSetsSample(bmain, mesh, motionSampleTime);
 
-  if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
-    is_time_varying_ = true;
-  }
+    if (mesh_prim_.GetPointsAttr().ValueMightBeTimeVarying()) {
+      is_time_varying_ = true;
+    }
 
-  if (is_time_varying_) {
-    add_cache_modifier();
+    if (is_time_varying_) {
+      add_cache_modifier();
+    }
   }
 
   if (import_params_.import_subdiv) {
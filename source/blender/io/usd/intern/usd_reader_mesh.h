@@ -55,6 +55,9 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_;
 
+  /* Reader of another instance proxy of the same prototype, whose mesh is shared. */
+  USDMeshReader *instance_source_;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
@@ -72,6 +75,13 @@ class USDMeshReader : public USDGeomReader {
 
   bool topology_changed(Mesh *existing_mesh, double motionSampleTime) override;
 
+  /* Share the mesh of the reader of another instance of the same prototype, instead of reading
+   * it again. Must be called before #create_object, with a source that is read first. */
+  void set_instance_source(USDMeshReader *source)
+  {
+    instance_source_ = source;
+  }
+
  private:
   void process_normals_vertex_varying(Mesh *mesh);
   void process_normals_face_varying(Mesh *mesh);
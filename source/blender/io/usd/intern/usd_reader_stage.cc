@@ -175,6 +175,26 @@ bool USDStageReader::include_by_purpose(const pxr::UsdGeomImageable &imageable)
   return true;
 }
 
+/* Let the reader of an instance proxy share the mesh of the first reader of the same prototype
+ * prim, so large instanced scenes don't get a full copy of the geometry per instance. */
+void USDStageReader::find_instance_source(const pxr::UsdPrim &prim, USDPrimReader *reader)
+{
+  if (!params_.use_instancing || !prim.IsInstanceProxy()) {
+    return;
+  }
+
+  USDMeshReader *mesh_reader = dynamic_cast<USDMeshReader *>(reader);
+  if (!mesh_reader) {
+    return;
+  }
+
+  const pxr::SdfPath prototype_path = prim.GetPrimInMaster().GetPath();
+  const auto [it, is_new] = prototype_mesh_readers_.emplace(prototype_path, mesh_reader);
+  if (!is_new) {
+    mesh_reader->set_instance_source(it->second);
+  }
+}
+
 /* Determine if the given reader can use the parent of the encapsulated USD prim
  * to compute the Blender object's transform. If so, the reader is appropriately
  * flagged and the function returns true. Otherwise, the function returns false. */
@@ -263,6 +283,8 @@ USDPrimReader *USDStageReader::collect_readers(Main *bmain, const pxr::UsdPrim &
     return nullptr;
   }
 
+  find_instance_source(prim, reader);
+
   reader->create_object(bmain, 0.0);
 
   readers_.push_back(reader);
@@ -319,6 +341,7 @@ void USDStageReader::clear_readers()
   }
 
   readers_.clear();
+  prototype_mesh_readers_.clear();
 }
 
 }  // Namespace blender::io::usd
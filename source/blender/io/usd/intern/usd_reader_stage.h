@@ -26,12 +26,15 @@ struct Main;
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/imageable.h>
 
+#include <map>
 #include <vector>
 
 struct ImportSettings;
 
 namespace blender::io::usd {
 
+class USDMeshReader;
+
 typedef std::map<pxr::SdfPath, std::vector<USDPrimReader *>> ProtoReaderMap;
 
 class USDStageReader {
@@ -43,6 +46,10 @@ class USDStageReader {
 
   std::vector<USDPrimReader *> readers_;
 
+  /* First mesh reader of every prototype prim, whose mesh is shared by the other instance
+   * proxies of the prototype when instancing is enabled. */
+  std::map<pxr::SdfPath, USDMeshReader *> prototype_mesh_readers_;
+
  public:
   USDStageReader(pxr::UsdStageRefPtr stage,
                  const USDImportParams &params,
@@ -82,6 +89,8 @@ class USDStageReader {
  private:
   USDPrimReader *collect_readers(Main *bmain, const pxr::UsdPrim &prim);
 
+  void find_instance_source(const pxr::UsdPrim &prim, USDPrimReader *reader);
+
   bool include_by_visibility(const pxr::UsdGeomImageable &imageable) const;
 
   bool include_by_purpose(const pxr::UsdGeomImageable &imageable) const;
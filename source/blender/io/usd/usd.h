@@ -66,6 +66,7 @@ struct USDImportParams {
   bool import_render;
   bool import_visible_only;
   bool use_instancing;
+  bool import_payloads;
   bool import_usd_preview;
   bool set_material_blend;
   float light_intensity_scale;
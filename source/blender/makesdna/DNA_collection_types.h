@@ -117,6 +117,8 @@ enum {
    * is called from very low-level places, like e.g ID remapping...
    * Using a generic tag like LIB_TAG_DOIT for this is just impossible, we need our very own. */
   COLLECTION_TAG_RELATION_REBUILD = (1 << 0),
+  /* Used by #BKE_main_collection_sync_from_collection to find the scenes using a collection. */
+  COLLECTION_TAG_SCENE_SYNC = (1 << 1),
 };
 
 /* Collection->color_tag. */
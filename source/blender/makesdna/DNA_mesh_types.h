@@ -86,7 +86,8 @@ typedef struct Mesh_Runtime {
   void *batch_cache;
 
   struct SubdivCCG *subdiv_ccg;
-  void *_pad1;
+  /** Lazily created topology maps, `MeshTopologyMapCache` defined in 'mesh_runtime.c'. */
+  struct MeshTopologyMapCache *topology_map_cache;
   int subdiv_ccg_tot_level;
   char _pad2[4];
 
@@ -149,6 +149,11 @@ typedef enum {
    * Only one modifier on an object should have this flag set.
    */
   eModifierFlag_Active = (1 << 2),
+  /**
+   * Keep the result of the modifier stack up to this modifier, so changes to the following
+   * modifiers don't evaluate it again.
+   */
+  eModifierFlag_CacheResult = (1 << 3),
 } ModifierFlag;
 
 /* not a real modifier */
@@ -526,6 +526,11 @@ typedef struct bNodeTree {
   int execution_mode;
 
   rctf viewer_border;
+  /**
+   * Part of the viewer image shown in editors in normalized coordinates, set when starting a
+   * compositing job with #NTREE_VISIBLE_REGION.
+   */
+  rctf visible_region;
 
   /* Lists of bNodeSocket to hold default values and own_index.
    * Warning! Don't make links to these sockets, input/output nodes are used for that.
@@ -584,6 +589,9 @@ typedef struct bNodeTree {
 /* tree is localized copy, free when deleting node groups */
 /* #define NTREE_IS_LOCALIZED           (1 << 5) */
 
+/* only compute the part of viewer nodes visible in editors */
+#define NTREE_VISIBLE_REGION (1 << 6)
+
 /* ntree->update */
 typedef enum eNodeTreeUpdate {
   NTREE_UPDATE = 0xFFFF,             /* generic update flag (includes all others) */
@@ -114,6 +114,7 @@ enum {
 };
 
 struct CustomData_MeshMasks;
+struct MeshModifierStackCache;
 
 /* Not saved in file! */
 typedef struct Object_Runtime {
@@ -203,6 +204,13 @@ typedef struct Object_Runtime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   struct CurveCache *curve_cache;
 
+  /**
+   * Result of the modifier stack up to a modifier with #eModifierFlag_CacheResult,
+   * kept between evaluations.
+   */
+  struct MeshModifierStackCache *modifier_stack_cache;
+  void *_pad3;
+
   unsigned short local_collections_bits;
   short _pad2[3];
 } Object_Runtime;
@@ -172,7 +172,8 @@ typedef struct FFMpegCodecData {
   int rc_buffer_size;
   int mux_packet_size;
   int mux_rate;
-  char _pad1[4];
+  /** Number of threads used by the video encoder, 0 to decide automatically. */
+  int threads;
 
   IDProperty *properties;
 } FFMpegCodecData;
@@ -1885,7 +1886,7 @@ enum {
 #define R_MATNODE_PREVIEW (1 << 5)
 #define R_DOCOMP (1 << 6)
 #define R_COMP_CROP (1 << 7)
-#define R_SCEMODE_UNUSED_8 (1 << 8) /* cleared */
+#define R_BACKGROUND_WRITE (1 << 8)
 #define R_SINGLE_LAYER (1 << 9)
 #define R_SCEMODE_UNUSED_10 (1 << 10) /* cleared */
 #define R_SCEMODE_UNUSED_11 (1 << 11) /* cleared */
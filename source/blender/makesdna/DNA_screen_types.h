@@ -448,6 +448,7 @@ typedef struct ScrArea {
 typedef struct ARegion_Runtime {
   /* Panel category to use between 'layout' and 'draw'. */
   const char *category;
+  void *_pad1;
 
   /**
    * The visible part of the region, use with region overlap not to draw
@@ -458,6 +459,12 @@ typedef struct ARegion_Runtime {
 
   /* The offset needed to not overlap with window scrollbars. Only used by HUD regions for now. */
   int offset_x, offset_y;
+
+  /** #PIL_check_seconds_timer() value at the end of the last redraw. */
+  double draw_end_time;
+  /** Duration of the last redraw in seconds, used to defer redraws of slow regions. */
+  float draw_time;
+  char _pad[4];
 } ARegion_Runtime;
 
 typedef struct ARegion {
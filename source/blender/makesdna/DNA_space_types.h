@@ -1581,6 +1581,8 @@ typedef enum eSpaceNode_Flag {
   SNODE_PIN = (1 << 12),
   /** automatically offset following nodes in a chain on insertion */
   SNODE_SKIP_INSOFFSET = (1 << 13),
+  /** Show the time it took to execute geometry nodes above them. */
+  SNODE_SHOW_TIMINGS = (1 << 14),
 } eSpaceNode_Flag;
 
 /* SpaceNode.texfrom */
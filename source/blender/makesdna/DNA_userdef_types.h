@@ -654,7 +654,13 @@ typedef struct UserDef_Experimental {
   char use_sculpt_tools_tilt;
   char use_extended_asset_browser;
   char use_override_templates;
-  char _pad[3];
+  char use_undo_skip_unchanged_ids;
+  char use_autosave_async;
+  char use_geometry_nodes_cache;
+  char use_gpu_mesh_extraction;
+  char use_shader_cache;
+  char use_viewport_mesh_lod;
+  char _pad[5];
   /** `makesdna` does not allow empty structs. */
 } UserDef_Experimental;
 
@@ -802,7 +808,8 @@ typedef struct UserDef {
   int prefetchframes;
   /** Control the rotation step of the view when PAD2, PAD4, PAD6&PAD8 is use. */
   float pad_rot_angle;
-  char _pad12[4];
+  /** Graphics memory limit of image textures (in megabytes), 0 for no limit. */
+  int texmemlimit;
   /** Rotating view icon size. */
   short rvisize;
   /** Rotating view icon brightness. */
@@ -932,7 +939,8 @@ typedef struct UserDef {
   short sequencer_proxy_setup; /* eUserpref_SeqProxySetup */
 
   float collection_instance_empty_size;
-  char _pad10[2];
+  char video_decode_flag; /* eUserpref_VideoDecode_Flag */
+  char _pad10[1];
 
   char file_preview_type; /* eUserpref_File_Preview_Type */
   char statusbar_flag;    /* eUserpref_StatusBar_Flag */
@@ -1412,6 +1420,11 @@ typedef enum eUserpref_SeqProxySetup {
   USER_SEQ_PROXY_SETUP_AUTOMATIC = 1,
 } eUserpref_SeqProxySetup;
 
+/** #UserDef.video_decode_flag */
+typedef enum eUserpref_VideoDecode_Flag {
+  USER_VIDEO_DECODE_HARDWARE = (1 << 0),
+} eUserpref_VideoDecode_Flag;
+
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
 /** #UserDef.language */
 enum {
@@ -1093,6 +1093,206 @@ void DNA_struct_switch_endian(const SDNA *sdna, int struct_nr, char *data)
   }
 }
 
+/**
+ * A flattened run of values of the same size within a struct that have to be byte swapped.
+ * Nested structs and member arrays are expanded, and adjacent runs are merged.
+ */
+typedef struct EndianSwitchStep {
+  int offset;
+  /** Size of a single value in bytes, either 2, 4 or 8. */
+  int elem_size;
+  int array_len;
+} EndianSwitchStep;
+
+typedef struct DNA_EndianSwitchInfo {
+  const SDNA *sdna;
+  /** Stored separately so the info can be freed after the #SDNA. */
+  int structs_len;
+  int *step_counts;
+  EndianSwitchStep **steps;
+} DNA_EndianSwitchInfo;
+
+typedef struct EndianSwitchStepsBuilder {
+  EndianSwitchStep *steps;
+  int steps_len;
+  int steps_capacity;
+} EndianSwitchStepsBuilder;
+
+static void endian_switch_steps_add(EndianSwitchStepsBuilder *builder,
+                                    const int offset,
+                                    const int elem_size,
+                                    const int array_len)
+{
+  if (builder->steps_len > 0) {
+    EndianSwitchStep *last = &builder->steps[builder->steps_len - 1];
+    if (last->elem_size == elem_size &&
+        last->offset + last->elem_size * last->array_len == offset) {
+      last->array_len += array_len;
+      return;
+    }
+  }
+  if (builder->steps_len == builder->steps_capacity) {
+    builder->steps_capacity = MAX2(8, builder->steps_capacity * 2);
+    builder->steps = MEM_reallocN(builder->steps,
+                                  sizeof(EndianSwitchStep) * (size_t)builder->steps_capacity);
+  }
+  EndianSwitchStep *step = &builder->steps[builder->steps_len++];
+  step->offset = offset;
+  step->elem_size = elem_size;
+  step->array_len = array_len;
+}
+
+static void endian_switch_steps_add_struct(const SDNA *sdna,
+                                           const int struct_nr,
+                                           const int base_offset,
+                                           EndianSwitchStepsBuilder *builder)
+{
+  const SDNA_Struct *struct_info = sdna->structs[struct_nr];
+
+  int offset_in_bytes = base_offset;
+  for (int member_index = 0; member_index < struct_info->members_len; member_index++) {
+    const SDNA_StructMember *member = &struct_info->members[member_index];
+    const eStructMemberCategory member_category = get_struct_member_category(sdna, member);
+    const int member_array_length = sdna->names_array_len[member->name];
+
+    switch (member_category) {
+      case STRUCT_MEMBER_CATEGORY_STRUCT: {
+        const int substruct_size = sdna->types_size[member->type];
+        const int substruct_nr = DNA_struct_find_nr(sdna, sdna->types[member->type]);
+        BLI_assert(substruct_nr != -1);
+        for (int a = 0; a < member_array_length; a++) {
+          endian_switch_steps_add_struct(
+              sdna, substruct_nr, offset_in_bytes + a * substruct_size, builder);
+        }
+        break;
+      }
+      case STRUCT_MEMBER_CATEGORY_PRIMITIVE: {
+        switch (member->type) {
+          case SDNA_TYPE_SHORT:
+          case SDNA_TYPE_USHORT: {
+            endian_switch_steps_add(builder, offset_in_bytes, 2, member_array_length);
+            break;
+          }
+          case SDNA_TYPE_INT:
+          case SDNA_TYPE_FLOAT: {
+            /* NOTE: long/ulong are ignored, see #DNA_struct_switch_endian. */
+            endian_switch_steps_add(builder, offset_in_bytes, 4, member_array_length);
+            break;
+          }
+          case SDNA_TYPE_INT64:
+          case SDNA_TYPE_UINT64:
+          case SDNA_TYPE_DOUBLE: {
+            endian_switch_steps_add(builder, offset_in_bytes, 8, member_array_length);
+            break;
+          }
+          default: {
+            break;
+          }
+        }
+        break;
+      }
+      case STRUCT_MEMBER_CATEGORY_POINTER: {
+        if (sizeof(void *) < 8) {
+          if (sdna->pointer_size == 8) {
+            endian_switch_steps_add(builder, offset_in_bytes, 8, member_array_length);
+          }
+        }
+        break;
+      }
+    }
+    offset_in_bytes += get_member_size_in_bytes(sdna, member);
+  }
+}
+
+/**
+ * Precompute the byte swaps needed for every struct in \a sdna, so that arrays of structs can
+ * be switched without walking the struct members for every element.
+ */
+DNA_EndianSwitchInfo *DNA_endian_switch_info_create(const SDNA *sdna)
+{
+  DNA_EndianSwitchInfo *info = MEM_callocN(sizeof(DNA_EndianSwitchInfo), __func__);
+  info->sdna = sdna;
+  info->structs_len = sdna->structs_len;
+  info->step_counts = MEM_malloc_arrayN(sdna->structs_len, sizeof(int), __func__);
+  info->steps = MEM_malloc_arrayN(sdna->structs_len, sizeof(EndianSwitchStep *), __func__);
+
+  for (int struct_nr = 0; struct_nr < sdna->structs_len; struct_nr++) {
+    EndianSwitchStepsBuilder builder = {NULL};
+    endian_switch_steps_add_struct(sdna, struct_nr, 0, &builder);
+    info->steps[struct_nr] = builder.steps;
+    info->step_counts[struct_nr] = builder.steps_len;
+  }
+
+  return info;
+}
+
+void DNA_endian_switch_info_free(DNA_EndianSwitchInfo *info)
+{
+  for (int a = 0; a < info->structs_len; a++) {
+    if (info->steps[a] != NULL) {
+      MEM_freeN(info->steps[a]);
+    }
+  }
+  MEM_freeN(info->steps);
+  MEM_freeN(info->step_counts);
+  MEM_freeN(info);
+}
+
+static void endian_switch_values(char *data, const int elem_size, const int len)
+{
+  switch (elem_size) {
+    case 2:
+      BLI_endian_switch_int16_array((int16_t *)data, len);
+      break;
+    case 4:
+      BLI_endian_switch_int32_array((int32_t *)data, len);
+      break;
+    case 8:
+      BLI_endian_switch_int64_array((int64_t *)data, len);
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+/**
+ * Does endian swapping on an array of struct values, using the steps precomputed by
+ * #DNA_endian_switch_info_create. Gives the same result as calling #DNA_struct_switch_endian
+ * on every element.
+ *
+ * \param blocks: Number of consecutive struct values in \a data.
+ */
+void DNA_struct_switch_endian_array(const DNA_EndianSwitchInfo *info,
+                                    int struct_nr,
+                                    int blocks,
+                                    char *data)
+{
+  if (struct_nr == -1) {
+    return;
+  }
+
+  const SDNA *sdna = info->sdna;
+  const int struct_size = sdna->types_size[sdna->structs[struct_nr]->type];
+  const EndianSwitchStep *steps = info->steps[struct_nr];
+  const int steps_len = info->step_counts[struct_nr];
+
+  if (steps_len == 1 && steps[0].offset == 0 &&
+      steps[0].elem_size * steps[0].array_len == struct_size) {
+    /* The struct only consists of values of the same size without padding (e.g. #MLoop or
+     * #MLoopUV), so the whole array can be switched in a single pass. */
+    endian_switch_values(data, steps[0].elem_size, steps[0].array_len * blocks);
+    return;
+  }
+
+  for (int block = 0; block < blocks; block++) {
+    char *block_data = data + (size_t)block * (size_t)struct_size;
+    for (int a = 0; a < steps_len; a++) {
+      endian_switch_values(block_data + steps[a].offset, steps[a].elem_size, steps[a].array_len);
+    }
+  }
+}
+
 typedef enum eReconstructStepType {
   RECONSTRUCT_STEP_MEMCPY,
   RECONSTRUCT_STEP_CAST_PRIMITIVE,
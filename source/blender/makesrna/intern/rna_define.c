@@ -837,6 +837,13 @@ void RNA_struct_free(BlenderRNA *brna, StructRNA *srna)
     }
   }
 
+  if (srna->flag & STRUCT_RUNTIME) {
+    if (srna->cont.prophash) {
+      BLI_ghash_free(srna->cont.prophash, NULL, NULL);
+      srna->cont.prophash = NULL;
+    }
+  }
+
   rna_brna_structs_remove_and_free(brna, srna);
 #else
   UNUSED_VARS(brna, srna);
@@ -1041,6 +1048,19 @@ StructRNA *RNA_def_struct_ptr(BlenderRNA *brna, const char *identifier, StructRN
     }
   }
 
+#ifdef RNA_RUNTIME
+  /* Structs defined at runtime (e.g. by Python classes) come after #RNA_init created the
+   * property hashes, create one here so that property lookups don't walk the list. */
+  if (!DefRNA.preprocess) {
+    srna->cont.prophash = BLI_ghash_str_new("RNA_def_struct_ptr gh");
+    LISTBASE_FOREACH (PropertyRNA *, iprop, &srna->cont.properties) {
+      if (!(iprop->flag_internal & PROP_INTERN_BUILTIN)) {
+        BLI_ghash_insert(srna->cont.prophash, (void *)iprop->identifier, iprop);
+      }
+    }
+  }
+#endif
+
   return srna;
 }
 
@@ -6928,6 +6928,8 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
 {
   StructRNA *srna;
   PropertyRNA *prop;
+  FunctionRNA *func;
+  PropertyRNA *parm;
 
   srna = RNA_def_struct(brna, "NodesModifier", "Modifier");
   RNA_def_struct_ui_text(srna, "Nodes Modifier", "");
@@ -6944,6 +6946,23 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_update(prop, 0, "rna_NodesModifier_node_group_update");
 
   RNA_define_lib_overridable(false);
+
+  func = RNA_def_function(srna, "node_execution_time", "MOD_nodes_node_execution_time_get");
+  RNA_def_function_ui_description(
+      func,
+      "Time in milliseconds it took to execute a node in the last evaluation of the active "
+      "depsgraph");
+  parm = RNA_def_string(func,
+                        "node_path",
+                        NULL,
+                        0,
+                        "Node Path",
+                        "Name of the node, nodes in groups are separated with a slash, e.g. "
+                        "\"Group/Node\"");
+  RNA_def_parameter_flags(parm, 0, PARM_REQUIRED);
+  parm = RNA_def_float(
+      func, "time", 0.0f, -FLT_MAX, FLT_MAX, "Time", "Negative when there is no time", 0, 0);
+  RNA_def_function_return(func, parm);
 }
 
 static void rna_def_modifier_mesh_to_volume(BlenderRNA *brna)
@@ -7245,6 +7264,18 @@ void RNA_def_modifier(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Active", "The active modifier in the list");
   RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, NULL);
 
+  prop = RNA_def_property(srna, "use_cache_result", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", eModifierFlag_CacheResult);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_override_flag(prop, PROPOVERRIDE_OVERRIDABLE_LIBRARY);
+  RNA_def_property_ui_text(
+      prop,
+      "Cache Result",
+      "Keep the result of the modifier stack up to this modifier, so that changing the following "
+      "modifiers doesn't evaluate it again (only for modifiers depending on nothing else than "
+      "the mesh)");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "use_apply_on_spline", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "mode", eModifierMode_ApplyOnSpline);
   RNA_def_property_ui_text(
@@ -603,6 +603,10 @@ static const EnumPropertyItem rna_node_geometry_attribute_input_type_items_no_bo
 #  include "DNA_scene_types.h"
 #  include "WM_api.h"
 
+#  ifdef WITH_COMPOSITOR
+#    include "COM_compositor.h"
+#  endif
+
 static void rna_Node_socket_update(Main *bmain, Scene *UNUSED(scene), PointerRNA *ptr);
 
 int rna_node_tree_type_to_enum(bNodeTreeType *typeinfo)
@@ -3570,6 +3574,38 @@ static void rna_CompositorNode_tag_need_exec(bNode *node)
   node->need_exec = true;
 }
 
+static void rna_CompositorNode_execution_stats(ID *id,
+                                               bNode *node,
+                                               Main *bmain,
+                                               float *r_time,
+                                               float *r_thread_time,
+                                               int *r_area,
+                                               float *r_memory)
+{
+  *r_time = *r_thread_time = *r_memory = 0.0f;
+  *r_area = 0;
+
+#  ifdef WITH_COMPOSITOR
+  bNodeTree *ntree = (bNodeTree *)id;
+  LISTBASE_FOREACH (Scene *, scene, &bmain->scenes) {
+    if (scene->nodetree != ntree) {
+      continue;
+    }
+    COM_NodeExecutionStats stats;
+    const bNodeInstanceKey key = BKE_node_instance_key(NODE_INSTANCE_KEY_BASE, ntree, node);
+    if (COM_node_execution_stats_get(scene, key, &stats)) {
+      *r_time = (float)stats.wall_time;
+      *r_thread_time = (float)stats.thread_time;
+      *r_area = (int)MIN2(stats.area, INT_MAX);
+      *r_memory = (float)stats.memory;
+    }
+    break;
+  }
+#  else
+  UNUSED_VARS(id, node, bmain);
+#  endif
+}
+
 static void rna_Node_tex_image_update(Main *bmain, Scene *UNUSED(scene), PointerRNA *ptr)
 {
   bNodeTree *ntree = (bNodeTree *)ptr->owner_id;
@@ -10898,6 +10934,7 @@ static void rna_def_compositor_node(BlenderRNA *brna)
 {
   StructRNA *srna;
   FunctionRNA *func;
+  PropertyRNA *parm;
 
   srna = RNA_def_struct(brna, "CompositorNode", "NodeInternal");
   RNA_def_struct_ui_text(srna, "Compositor Node", "");
@@ -10908,6 +10945,39 @@ static void rna_def_compositor_node(BlenderRNA *brna)
   func = RNA_def_function(srna, "tag_need_exec", "rna_CompositorNode_tag_need_exec");
   RNA_def_function_ui_description(func, "Tag the node for compositor update");
 
+  func = RNA_def_function(srna, "execution_stats", "rna_CompositorNode_execution_stats");
+  RNA_def_function_ui_description(func,
+                                  "Statistics of the last execution of the node in the scene "
+                                  "compositing tree, zero when it wasn't executed. Group nodes "
+                                  "sum the nodes inside of them");
+  RNA_def_function_flag(func, FUNC_USE_SELF_ID | FUNC_USE_MAIN);
+  parm = RNA_def_float(
+      func, "time", 0.0f, 0.0f, FLT_MAX, "Time", "Execution time in seconds", 0.0f, FLT_MAX);
+  RNA_def_function_output(func, parm);
+  parm = RNA_def_float(func,
+                       "thread_time",
+                       0.0f,
+                       0.0f,
+                       FLT_MAX,
+                       "Thread Time",
+                       "Execution time summed over the compositor threads, in seconds",
+                       0.0f,
+                       FLT_MAX);
+  RNA_def_function_output(func, parm);
+  parm = RNA_def_int(
+      func, "area", 0, 0, INT_MAX, "Area", "Number of rendered pixels", 0, INT_MAX);
+  RNA_def_function_output(func, parm);
+  parm = RNA_def_float(func,
+                       "memory",
+                       0.0f,
+                       0.0f,
+                       FLT_MAX,
+                       "Memory",
+                       "Bytes allocated for the output buffers",
+                       0.0f,
+                       FLT_MAX);
+  RNA_def_function_output(func, parm);
+
   def_cmp_cryptomatte_entry(brna);
 }
 
@@ -12751,6 +12821,14 @@ static void rna_def_composite_nodetree(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Viewer Region", "Use boundaries for viewer nodes and composite backdrop");
   RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
+
+  prop = RNA_def_property(srna, "use_visible_region", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "flag", NTREE_VISIBLE_REGION);
+  RNA_def_property_ui_text(prop,
+                           "Visible Region",
+                           "Only calculate the part of viewer nodes shown in the backdrop and "
+                           "image editors during editing (Full Frame execution mode only)");
+  RNA_def_property_update(prop, NC_NODE | ND_DISPLAY, "rna_NodeTree_update");
 }
 
 static void rna_def_shader_nodetree(BlenderRNA *brna)
@@ -5723,6 +5723,16 @@ static void rna_def_scene_ffmpeg_settings(BlenderRNA *brna)
                            "influences file size and seekability");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "threads", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "threads");
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_range(prop, 0, BLENDER_MAX_THREADS);
+  RNA_def_property_ui_text(
+      prop,
+      "Threads",
+      "Number of threads used by the video encoder, 0 to use as many as the codec supports");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "max_b_frames", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "max_b_frames");
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -6157,6 +6167,16 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Overwrite", "Overwrite existing files while rendering");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
 
+  prop = RNA_def_property(srna, "use_background_write", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_BACKGROUND_WRITE);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Save in Background",
+                           "Save animation frames while the next frame renders, and read image "
+                           "sequences used by the compositor ahead of time (render write handlers "
+                           "run before the file is saved)");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, NULL);
+
   prop = RNA_def_property(srna, "use_compositing", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "scemode", R_DOCOMP);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -559,6 +559,12 @@ static void rna_def_region(BlenderRNA *brna)
   RNA_def_property_clear_flag(prop, PROP_EDITABLE);
   RNA_def_property_ui_text(prop, "Height", "Region height");
 
+  prop = RNA_def_property(srna, "draw_time", PROP_FLOAT, PROP_TIME_ABSOLUTE);
+  RNA_def_property_float_sdna(prop, NULL, "runtime.draw_time");
+  RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+  RNA_def_property_ui_text(
+      prop, "Draw Time", "Time the last redraw of the region took, in seconds");
+
   prop = RNA_def_property(srna, "view2d", PROP_POINTER, PROP_NONE);
   RNA_def_property_pointer_sdna(prop, NULL, "v2d");
   RNA_def_property_clear_flag(prop, PROP_EDITABLE);
@@ -5468,6 +5468,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, NULL, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  /* Video decoding */
+
+  prop = RNA_def_property(srna, "use_hardware_video_decode", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "video_decode_flag", USER_VIDEO_DECODE_HARDWARE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movie strips and clips on the GPU when the system supports it, "
+                           "falling back to CPU decoding otherwise. Applies to movies opened "
+                           "after changing it");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, NULL, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -5566,6 +5576,16 @@ static void rna_def_userdef_system(BlenderRNA *brna)
       "Time since last access of a GL texture in seconds after which it is freed "
       "(set to 0 to keep textures allocated)");
 
+  prop = RNA_def_property(srna, "texture_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, NULL, "texmemlimit");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_ui_text(prop,
+                           "Texture Memory Limit",
+                           "Graphics memory limit of image textures (in megabytes). When it is "
+                           "exceeded, textures of the images that were not displayed recently "
+                           "are freed (set to 0 for no limit)");
+
   prop = RNA_def_property(srna, "texture_collection_rate", PROP_INT, PROP_NONE);
   RNA_def_property_int_sdna(prop, NULL, "texcollectrate");
   RNA_def_property_range(prop, 1, 3600);
@@ -6359,6 +6379,50 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Override Templates", "Enable library override template in the python API");
 
+  prop = RNA_def_property(srna, "use_undo_skip_unchanged_ids", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_undo_skip_unchanged_ids", 1);
+  RNA_def_property_ui_text(prop,
+                           "Undo Skip Unchanged Data",
+                           "Re-use the undo memory of the previous step for geometry data-blocks "
+                           "that were not tagged for update, instead of writing them again");
+
+  prop = RNA_def_property(srna, "use_autosave_async", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_autosave_async", 1);
+  RNA_def_property_ui_text(prop,
+                           "Asynchronous Auto Save",
+                           "Write auto-save files from a copy of the undo memory in the "
+                           "background, instead of blocking the interface while saving");
+
+  prop = RNA_def_property(srna, "use_geometry_nodes_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_geometry_nodes_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Geometry Nodes Cache",
+                           "Reuse the outputs of expensive geometry nodes from the previous "
+                           "evaluation when their inputs and settings did not change");
+
+  prop = RNA_def_property(srna, "use_gpu_mesh_extraction", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_gpu_mesh_extraction", 1);
+  RNA_def_property_ui_text(prop,
+                           "GPU Mesh Extraction",
+                           "Build the mesh positions and normals for the viewport with compute "
+                           "shaders, which reduces the data uploaded for deforming meshes");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
+  prop = RNA_def_property(srna, "use_shader_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_shader_cache", 1);
+  RNA_def_property_ui_text(prop,
+                           "Shader Cache",
+                           "Store compiled shader programs on disk, so they don't need to be "
+                           "compiled again the next time they are used");
+
+  prop = RNA_def_property(srna, "use_viewport_mesh_lod", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, NULL, "use_viewport_mesh_lod", 1);
+  RNA_def_property_ui_text(prop,
+                           "Viewport Mesh LOD",
+                           "Draw heavy meshes with a simplified version when they only cover a "
+                           "small part of the viewport");
+  RNA_def_property_update(prop, 0, "rna_userdef_update");
+
   prop = RNA_def_property(srna, "use_geometry_nodes_legacy", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, NULL, "use_geometry_nodes_legacy", 1);
   RNA_def_property_ui_text(
@@ -28,6 +28,14 @@ void MOD_nodes_update_interface(struct Object *object, struct NodesModifierData
 
 void MOD_nodes_init(struct Main *bmain, struct NodesModifierData *nmd);
 
+/**
+ * Time in milliseconds it took to execute the node in the last evaluation that was logged. Nodes
+ * in nested groups are found with a path like `Group Node/Node`. Returns a negative value when
+ * there is no time for the node.
+ */
+float MOD_nodes_node_execution_time_get(const struct NodesModifierData *nmd,
+                                        const char *node_path);
+
 #ifdef __cplusplus
 }
 #endif
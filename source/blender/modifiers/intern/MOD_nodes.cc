@@ -46,6 +46,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
 #include "DNA_windowmanager_types.h"
 
 #include "BKE_attribute_math.hh"
@@ -108,6 +109,7 @@ using blender::bke::OutputAttribute;
 using blender::fn::GField;
 using blender::fn::GMutablePointer;
 using blender::fn::GPointer;
+using blender::modifiers::geometry_nodes::GeometryNodesCache;
 using blender::nodes::FieldInferencingInterface;
 using blender::nodes::GeoNodeExecParams;
 using blender::nodes::InputSocketFieldType;
@@ -838,6 +840,48 @@ static void find_sockets_to_preview(NodesModifierData *nmd,
   }
 }
 
+static void freeRuntimeData(void *runtime_data_v)
+{
+  if (runtime_data_v == nullptr) {
+    return;
+  }
+  GeometryNodesCache *cache = static_cast<GeometryNodesCache *>(runtime_data_v);
+  blender::modifiers::geometry_nodes::geometry_nodes_cache_free(cache);
+}
+
+float MOD_nodes_node_execution_time_get(const NodesModifierData *nmd, const char *node_path)
+{
+  if (nmd->runtime_eval_log == nullptr) {
+    return -1.0f;
+  }
+  const geo_log::ModifierLog &log = *static_cast<geo_log::ModifierLog *>(nmd->runtime_eval_log);
+  const geo_log::TreeLog *tree_log = &log.root_tree();
+  StringRef remaining_path = node_path;
+  while (true) {
+    const int64_t separator = remaining_path.find('/');
+    if (separator == StringRef::not_found) {
+      break;
+    }
+    tree_log = tree_log->lookup_child_log(remaining_path.substr(0, separator));
+    if (tree_log == nullptr) {
+      return -1.0f;
+    }
+    remaining_path = remaining_path.drop_prefix(separator + 1);
+  }
+  std::chrono::microseconds exec_time;
+  if (const geo_log::TreeLog *child_log = tree_log->lookup_child_log(remaining_path)) {
+    /* Group nodes don't have a time themselves. */
+    exec_time = child_log->execution_time();
+  }
+  else if (const geo_log::NodeLog *node_log = tree_log->lookup_node_log(remaining_path)) {
+    exec_time = node_log->execution_time();
+  }
+  else {
+    return -1.0f;
+  }
+  return exec_time.count() / 1000.0f;
+}
+
 static void clear_runtime_data(NodesModifierData *nmd)
 {
   if (nmd->runtime_eval_log != nullptr) {
@@ -912,6 +956,23 @@ static void store_output_value_in_geometry(GeometrySet &geometry_set,
   }
 }
 
+/**
+ * The cache is stored in the runtime data of the evaluated modifier, which is kept when the
+ * modifier is copied for evaluation again.
+ */
+static GeometryNodesCache *ensure_geometry_nodes_cache(NodesModifierData *nmd)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_geometry_nodes_cache)) {
+    freeRuntimeData(nmd->modifier.runtime);
+    nmd->modifier.runtime = nullptr;
+    return nullptr;
+  }
+  if (nmd->modifier.runtime == nullptr) {
+    nmd->modifier.runtime = blender::modifiers::geometry_nodes::geometry_nodes_cache_new();
+  }
+  return static_cast<GeometryNodesCache *>(nmd->modifier.runtime);
+}
+
 /**
  * Evaluate a node group to compute the output geometry.
  */
@@ -982,6 +1043,7 @@ static GeometrySet compute_geometry(const DerivedNodeTree &tree,
   eval_params.depsgraph = ctx->depsgraph;
   eval_params.self_object = ctx->object;
   eval_params.geo_logger = geo_logger.has_value() ? &*geo_logger : nullptr;
+  eval_params.cache = ensure_geometry_nodes_cache(nmd);
   blender::modifiers::geometry_nodes::evaluate_geometry_nodes(eval_params);
 
   if (geo_logger.has_value()) {
@@ -1389,7 +1451,7 @@ ModifierTypeInfo modifierType_Nodes = {
     /* dependsOnNormals */ nullptr,
     /* foreachIDLink */ foreachIDLink,
     /* foreachTexLink */ foreachTexLink,
-    /* freeRuntimeData */ nullptr,
+    /* freeRuntimeData */ freeRuntimeData,
     /* panelRegister */ panelRegister,
     /* blendWrite */ blendWrite,
     /* blendRead */ blendRead,
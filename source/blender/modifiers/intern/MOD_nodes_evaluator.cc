@@ -28,12 +28,18 @@
 
 #include "BLT_translation.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BLI_enumerable_thread_specific.hh"
+#include "BLI_set.hh"
 #include "BLI_stack.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
 #include "BLI_vector_set.hh"
 
+#include <chrono>
+#include <mutex>
+
 namespace blender::modifiers::geometry_nodes {
 
 using fn::CPPType;
@@ -158,6 +164,29 @@ struct OutputState {
   int potential_users = 0;
 };
 
+/**
+ * A rough estimate for how expensive it is to execute a node. Nodes that process geometry can
+ * take a long time, while nodes that only work on fields or single values just build up a new
+ * field or compute a single value.
+ */
+static bool node_is_cheap_to_execute(const DNode node)
+{
+  if (node->is_group_input_node() || node->is_group_output_node()) {
+    return true;
+  }
+  for (const InputSocketRef *socket : node->inputs()) {
+    if (socket->is_available() && socket->bsocket()->type == SOCK_GEOMETRY) {
+      return false;
+    }
+  }
+  for (const OutputSocketRef *socket : node->outputs()) {
+    if (socket->is_available() && socket->bsocket()->type == SOCK_GEOMETRY) {
+      return false;
+    }
+  }
+  return true;
+}
+
 enum class NodeScheduleState {
   /**
    * Default state of every node.
@@ -227,6 +256,12 @@ struct NodeState {
    * not run twice at the same time accidentally.
    */
   NodeScheduleState schedule_state = NodeScheduleState::NotScheduled;
+
+  /**
+   * Nodes that are cheap to execute are run directly on the thread that scheduled them, instead
+   * of going through the task pool. This is set once when the state is created.
+   */
+  bool is_cheap = false;
 };
 
 /**
@@ -364,6 +399,173 @@ static bool node_supports_laziness(const DNode node)
   return node->typeinfo()->geometry_node_execute_supports_laziness;
 }
 
+/**
+ * Idnames of nodes whose outputs are kept in the #GeometryNodesCache. Those nodes are
+ * deterministic, only depend on their inputs and settings and are expensive enough that
+ * comparing their inputs is cheaper than executing them again.
+ */
+static bool node_is_cacheable(const DNode node)
+{
+  static const Set<StringRef> cacheable_idnames = {
+      "GeometryNodeConvexHull",
+      "GeometryNodeCurvePrimitiveBezierSegment",
+      "GeometryNodeCurvePrimitiveCircle",
+      "GeometryNodeCurvePrimitiveLine",
+      "GeometryNodeCurvePrimitiveQuadrilateral",
+      "GeometryNodeCurveQuadraticBezier",
+      "GeometryNodeCurveSpiral",
+      "GeometryNodeCurveStar",
+      "GeometryNodeCurveToMesh",
+      "GeometryNodeDistributePointsOnFaces",
+      "GeometryNodeFillCurve",
+      "GeometryNodeMeshCircle",
+      "GeometryNodeMeshCone",
+      "GeometryNodeMeshCube",
+      "GeometryNodeMeshCylinder",
+      "GeometryNodeMeshGrid",
+      "GeometryNodeMeshIcoSphere",
+      "GeometryNodeMeshLine",
+      "GeometryNodeMeshUVSphere",
+      "GeometryNodeSubdivideMesh",
+      "GeometryNodeTriangulate",
+  };
+  if (node_supports_laziness(node)) {
+    return false;
+  }
+  for (const InputSocketRef *socket : node->inputs()) {
+    if (socket->is_multi_input_socket()) {
+      return false;
+    }
+  }
+  return cacheable_idnames.contains(node->idname());
+}
+
+/**
+ * Allocate a value that is owned by the cache and can outlive the evaluation that created it.
+ */
+static GMutablePointer cache_value_alloc(const CPPType &type)
+{
+  return {type, MEM_mallocN_aligned(type.size(), type.alignment(), __func__)};
+}
+
+static void cache_value_free(GMutablePointer value)
+{
+  if (value.get() != nullptr) {
+    value.destruct();
+    MEM_freeN(value.get());
+  }
+}
+
+/**
+ * Geometries are compared by the identity of their components. This is correct, because the
+ * cache keeps the compared components alive and components that are shared are never modified.
+ */
+static bool cache_values_equal(const GPointer a, const GPointer b)
+{
+  if (a.get() == nullptr || b.get() == nullptr) {
+    return a.get() == b.get();
+  }
+  if (a.type() != b.type()) {
+    return false;
+  }
+  if (a.type()->is<GeometrySet>()) {
+    const GeometrySet &geometry_a = *(const GeometrySet *)a.get();
+    const GeometrySet &geometry_b = *(const GeometrySet *)b.get();
+    return geometry_a.get_components_for_read() == geometry_b.get_components_for_read();
+  }
+  return a.type()->is_equal(a.get(), b.get());
+}
+
+class GeometryNodesCache : NonCopyable, NonMovable {
+ public:
+  struct Entry : NonCopyable, NonMovable {
+    /** Raw bytes of the settings stored in the node. */
+    Vector<char> settings;
+    /**
+     * One value per input socket, null for unavailable inputs. Fields are stored as the constant
+     * value they evaluate to.
+     */
+    Vector<GMutablePointer> inputs;
+    /** One value per output socket, null for outputs that have not been computed. */
+    Vector<GMutablePointer> outputs;
+    /** True when the entry has been used in the current evaluation. */
+    bool is_used = false;
+
+    ~Entry()
+    {
+      for (GMutablePointer value : inputs) {
+        cache_value_free(value);
+      }
+      for (GMutablePointer value : outputs) {
+        cache_value_free(value);
+      }
+    }
+
+    bool matches(const Entry &other) const
+    {
+      if (settings != other.settings || inputs.size() != other.inputs.size()) {
+        return false;
+      }
+      for (const int i : inputs.index_range()) {
+        if (!cache_values_equal(inputs[i], other.inputs[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+  };
+
+  std::mutex mutex;
+  /** Entries are identified by the path of the node through the nested node groups. */
+  Map<std::string, std::unique_ptr<Entry>> entries;
+
+  /** Remove entries of nodes that have not been executed in the last evaluation. */
+  void remove_unused_entries()
+  {
+    Vector<std::string> keys_to_remove;
+    for (auto item : entries.items()) {
+      if (!item.value->is_used) {
+        keys_to_remove.append(item.key);
+      }
+      item.value->is_used = false;
+    }
+    for (const std::string &key : keys_to_remove) {
+      entries.remove(key);
+    }
+  }
+};
+
+/**
+ * The key contains the node tree and the type of every node on the path, so that a node that is
+ * replaced by another one with the same name, or a group node that now uses another node group,
+ * does not find the entry of the previous node.
+ */
+static std::string cache_key_for_node_ref(const NodeRef &node)
+{
+  return std::to_string(node.btree()->id.session_uuid) + ":" + node.idname() + ":" + node.name();
+}
+
+static std::string cache_key_for_node(const DNode node)
+{
+  std::string key = cache_key_for_node_ref(*node.node_ref());
+  for (const DTreeContext *context = node.context(); context->parent_node() != nullptr;
+       context = context->parent_context()) {
+    key = cache_key_for_node_ref(*context->parent_node()) + "/" + key;
+  }
+  return key;
+}
+
+static void cache_key_settings(const bNode &bnode, Vector<char> &r_settings)
+{
+  r_settings.extend(Span<char>((const char *)&bnode.custom1, sizeof(bnode.custom1)));
+  r_settings.extend(Span<char>((const char *)&bnode.custom2, sizeof(bnode.custom2)));
+  r_settings.extend(Span<char>((const char *)&bnode.custom3, sizeof(bnode.custom3)));
+  r_settings.extend(Span<char>((const char *)&bnode.custom4, sizeof(bnode.custom4)));
+  if (bnode.storage != nullptr) {
+    r_settings.extend(Span<char>((const char *)bnode.storage, MEM_allocN_len(bnode.storage)));
+  }
+}
+
 /** Implements the callbacks that might be called when a node is executed. */
 class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
  private:
@@ -371,6 +573,9 @@ class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
   NodeState &node_state_;
 
  public:
+  /** When set, copies of the outputs are stored in this cache entry. */
+  GeometryNodesCache::Entry *cache_entry = nullptr;
+
   NodeParamsProvider(GeometryNodesEvaluator &evaluator, DNode dnode, NodeState &node_state);
 
   bool can_get_input(StringRef identifier) const override;
@@ -387,6 +592,13 @@ class NodeParamsProvider : public nodes::GeoNodeExecParamsProvider {
   bool lazy_output_is_required(StringRef identifier) const override;
 };
 
+/**
+ * Time spent in nodes that were executed inline on the current thread while another node was
+ * running, see #GeometryNodesEvaluator::run_or_add_node_to_task_pool. It is subtracted from the
+ * time of the running node, so that every node only logs its own execution time.
+ */
+static thread_local std::chrono::steady_clock::duration inline_execution_time{0};
+
 class GeometryNodesEvaluator {
  private:
   /**
@@ -493,6 +705,7 @@ class GeometryNodesEvaluator {
     /* Construct arrays of the correct size. */
     node_state.inputs = allocator.construct_array<InputState>(node->inputs().size());
     node_state.outputs = allocator.construct_array<OutputState>(node->outputs().size());
+    node_state.is_cheap = node_is_cheap_to_execute(node);
 
     /* Initialize input states. */
     for (const int i : node->inputs().index_range()) {
@@ -858,8 +1071,6 @@ class GeometryNodesEvaluator {
    */
   void execute_node(const DNode node, NodeState &node_state)
   {
-    const bNode &bnode = *node->bnode();
-
     if (node_state.has_been_executed) {
       if (!node_supports_laziness(node)) {
         /* Nodes that don't support laziness must not be executed more than once. */
@@ -868,6 +1079,27 @@ class GeometryNodesEvaluator {
     }
     node_state.has_been_executed = true;
 
+    if (params_.geo_logger == nullptr) {
+      this->execute_node_without_timing(node, node_state);
+      return;
+    }
+    /* Time the node so that the node editor can show which nodes are slow. */
+    const std::chrono::steady_clock::duration inline_time_start = inline_execution_time;
+    const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+    this->execute_node_without_timing(node, node_state);
+    const std::chrono::steady_clock::time_point end_time = std::chrono::steady_clock::now();
+    const std::chrono::steady_clock::duration inline_time = inline_execution_time -
+                                                            inline_time_start;
+    params_.geo_logger->local().log_execution_time(
+        node,
+        std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time -
+                                                              inline_time));
+  }
+
+  void execute_node_without_timing(const DNode node, NodeState &node_state)
+  {
+    const bNode &bnode = *node->bnode();
+
     /* Use the geometry node execute callback if it exists. */
     if (bnode.typeinfo->geometry_node_execute != nullptr) {
       this->execute_geometry_node(node, node_state);
@@ -888,13 +1120,147 @@ class GeometryNodesEvaluator {
   {
     const bNode &bnode = *node->bnode();
 
+    std::unique_ptr<GeometryNodesCache::Entry> cache_entry;
+    if (params_.cache != nullptr && node_is_cacheable(node)) {
+      cache_entry = this->cache_entry_for_node_inputs(node, node_state);
+      if (cache_entry && this->try_forward_cached_outputs(node, node_state, *cache_entry)) {
+        return;
+      }
+    }
+
     NodeParamsProvider params_provider{*this, node, node_state};
+    params_provider.cache_entry = cache_entry.get();
     GeoNodeExecParams params{params_provider};
     if (node->idname().find("Legacy") != StringRef::not_found) {
       params.error_message_add(geo_log::NodeWarningType::Legacy,
                                TIP_("Legacy node will be removed before Blender 4.0"));
     }
     bnode.typeinfo->geometry_node_execute(params);
+
+    if (cache_entry) {
+      cache_entry->is_used = true;
+      std::lock_guard lock{params_.cache->mutex};
+      params_.cache->entries.add_overwrite(cache_key_for_node(node), std::move(cache_entry));
+    }
+  }
+
+  /**
+   * Create a cache entry that contains the current inputs and settings of the node. Returns null
+   * when some input can't be compared with the inputs of a previous evaluation.
+   */
+  std::unique_ptr<GeometryNodesCache::Entry> cache_entry_for_node_inputs(const DNode node,
+                                                                          NodeState &node_state)
+  {
+    std::unique_ptr<GeometryNodesCache::Entry> entry =
+        std::make_unique<GeometryNodesCache::Entry>();
+    cache_key_settings(*node->bnode(), entry->settings);
+    entry->inputs.resize(node->inputs().size(), GMutablePointer());
+    entry->outputs.resize(node->outputs().size(), GMutablePointer());
+
+    for (const InputSocketRef *socket_ref : node->inputs()) {
+      if (!socket_ref->is_available()) {
+        continue;
+      }
+      const InputState &input_state = node_state.inputs[socket_ref->index()];
+      if (input_state.type == nullptr || input_state.value.single->value == nullptr) {
+        return {};
+      }
+      const CPPType &type = *input_state.type;
+      const void *value = input_state.value.single->value;
+      if (const FieldCPPType *field_cpp_type = dynamic_cast<const FieldCPPType *>(&type)) {
+        /* Only fields that evaluate to a single value can be compared. */
+        const GField &field = field_cpp_type->get_gfield(value);
+        const CPPType &base_type = field_cpp_type->field_type();
+        if (field.node().depends_on_input() || !base_type.is_equality_comparable()) {
+          return {};
+        }
+        GMutablePointer owned_value = cache_value_alloc(base_type);
+        fn::evaluate_constant_field(field, owned_value.get());
+        entry->inputs[socket_ref->index()] = owned_value;
+      }
+      else if (type.is<GeometrySet>()) {
+        /* Geometries that reference data outside of the geometry set are not kept in the cache,
+         * because that data may be freed or change between evaluations. */
+        if (!((const GeometrySet *)value)->owns_direct_data()) {
+          return {};
+        }
+        GMutablePointer owned_value = cache_value_alloc(type);
+        type.copy_construct(value, owned_value.get());
+        entry->inputs[socket_ref->index()] = owned_value;
+      }
+      else {
+        /* E.g. object or collection pointers, whose data can change without the pointer
+         * changing. */
+        return {};
+      }
+    }
+    return entry;
+  }
+
+  /**
+   * Forward the outputs of a matching entry from a previous evaluation. Returns false when there
+   * is no such entry or when it does not contain all outputs that are required now.
+   */
+  bool try_forward_cached_outputs(const DNode node,
+                                  NodeState &node_state,
+                                  const GeometryNodesCache::Entry &new_entry)
+  {
+    LinearAllocator<> &allocator = local_allocators_.local();
+    Vector<std::pair<DOutputSocket, GMutablePointer>> outputs_to_forward;
+    {
+      std::lock_guard lock{params_.cache->mutex};
+      std::unique_ptr<GeometryNodesCache::Entry> *cached_entry_ptr =
+          params_.cache->entries.lookup_ptr(cache_key_for_node(node));
+      if (cached_entry_ptr == nullptr) {
+        return false;
+      }
+      GeometryNodesCache::Entry &cached_entry = **cached_entry_ptr;
+      if (!cached_entry.matches(new_entry)) {
+        return false;
+      }
+      for (const OutputSocketRef *socket_ref : node->outputs()) {
+        const OutputState &output_state = node_state.outputs[socket_ref->index()];
+        if (!socket_ref->is_available() ||
+            output_state.output_usage_for_execution == ValueUsage::Unused) {
+          continue;
+        }
+        if (cached_entry.outputs[socket_ref->index()].get() == nullptr) {
+          return false;
+        }
+      }
+      cached_entry.is_used = true;
+      for (const OutputSocketRef *socket_ref : node->outputs()) {
+        const GMutablePointer cached_value = cached_entry.outputs[socket_ref->index()];
+        if (!socket_ref->is_available() || cached_value.get() == nullptr) {
+          continue;
+        }
+        const CPPType &type = *cached_value.type();
+        void *buffer = allocator.allocate(type.size(), type.alignment());
+        type.copy_construct(cached_value.get(), buffer);
+        outputs_to_forward.append({{node.context(), socket_ref}, {type, buffer}});
+      }
+    }
+
+    /* Forward outside of the lock, because that can trigger execution of other nodes. */
+    for (auto &[socket, value] : outputs_to_forward) {
+      OutputState &output_state = node_state.outputs[socket->index()];
+      this->forward_output(socket, value);
+      output_state.has_been_computed = true;
+    }
+    return true;
+  }
+
+  void add_output_to_cache_entry(GeometryNodesCache::Entry &entry,
+                                 const DOutputSocket socket,
+                                 const GPointer value)
+  {
+    const CPPType &type = *value.type();
+    if (type.is<GeometrySet>() && !((const GeometrySet *)value.get())->owns_direct_data()) {
+      return;
+    }
+    GMutablePointer owned_value = cache_value_alloc(type);
+    type.copy_construct(value.get(), owned_value.get());
+    entry.outputs[socket->index()] = owned_value;
   }
 
   void execute_multi_function_node(const DNode node,
@@ -1203,6 +1569,40 @@ class GeometryNodesEvaluator {
     });
   }
 
+  /**
+   * Cheap nodes are executed on the current thread right away, which avoids the overhead of
+   * going through the task pool for every small node. Expensive nodes are always added to the
+   * pool, so that independent branches are evaluated by different threads at the same time.
+   * This must only be called when no node is locked on the current thread.
+   */
+  void run_or_add_node_to_task_pool(const DNode node)
+  {
+    /* Limits the recursion depth when a long chain of cheap nodes is executed. */
+    static constexpr int max_inline_execution_depth = 32;
+    static thread_local int inline_execution_depth = 0;
+
+    const NodeWithState *node_with_state = node_states_.lookup_key_ptr_as(node);
+    if (node_with_state->state->is_cheap &&
+        inline_execution_depth < max_inline_execution_depth) {
+      inline_execution_depth++;
+      if (params_.geo_logger == nullptr) {
+        this->node_task_run(node, *node_with_state->state);
+      }
+      else {
+        /* Replace the time of nested inline executions with the total time, so that the running
+         * node doesn't subtract them twice. */
+        const std::chrono::steady_clock::duration inline_time_start = inline_execution_time;
+        const std::chrono::steady_clock::time_point start_time = std::chrono::steady_clock::now();
+        this->node_task_run(node, *node_with_state->state);
+        inline_execution_time = inline_time_start + (std::chrono::steady_clock::now() -
+                                                     start_time);
+      }
+      inline_execution_depth--;
+      return;
+    }
+    this->add_node_to_task_pool(node);
+  }
+
   void add_node_to_task_pool(const DNode node)
   {
     /* Push the task to the pool while it is not locked to avoid a deadlock in case when the task
@@ -1518,7 +1918,7 @@ class GeometryNodesEvaluator {
       this->send_output_unused_notification(socket);
     }
     for (const DNode &node : locked_node.delayed_scheduled_nodes) {
-      this->add_node_to_task_pool(node);
+      this->run_or_add_node_to_task_pool(node);
     }
   }
 };
@@ -1634,6 +2034,9 @@ void NodeParamsProvider::set_output(StringRef identifier, GMutablePointer value)
 
   OutputState &output_state = node_state_.outputs[socket->index()];
   BLI_assert(!output_state.has_been_computed);
+  if (this->cache_entry != nullptr) {
+    evaluator_.add_output_to_cache_entry(*this->cache_entry, socket, value);
+  }
   evaluator_.forward_output(socket, value);
   output_state.has_been_computed = true;
 }
@@ -1693,6 +2096,19 @@ void evaluate_geometry_nodes(GeometryNodesEvaluationParams &params)
 {
   GeometryNodesEvaluator evaluator{params};
   evaluator.execute();
+  if (params.cache != nullptr) {
+    params.cache->remove_unused_entries();
+  }
+}
+
+GeometryNodesCache *geometry_nodes_cache_new()
+{
+  return new GeometryNodesCache();
+}
+
+void geometry_nodes_cache_free(GeometryNodesCache *cache)
+{
+  delete cache;
 }
 
 }  // namespace blender::modifiers::geometry_nodes
@@ -36,6 +36,8 @@ using namespace nodes::derived_node_tree_types;
 using fn::GMutablePointer;
 using fn::GPointer;
 
+class GeometryNodesCache;
+
 struct GeometryNodesEvaluationParams {
   blender::LinearAllocator<> allocator;
 
@@ -52,10 +54,19 @@ struct GeometryNodesEvaluationParams {
   Depsgraph *depsgraph;
   Object *self_object;
   geo_log::GeoLogger *geo_logger;
+  /* Outputs of some nodes are reused from a previous evaluation when this is not null. */
+  GeometryNodesCache *cache = nullptr;
 
   Vector<GMutablePointer> r_output_values;
 };
 
 void evaluate_geometry_nodes(GeometryNodesEvaluationParams &params);
 
+/**
+ * The cache keeps the outputs of expensive nodes across evaluations of the same modifier, so that
+ * they don't have to be recomputed when their inputs and settings did not change.
+ */
+GeometryNodesCache *geometry_nodes_cache_new();
+void geometry_nodes_cache_free(GeometryNodesCache *cache);
+
 }  // namespace blender::modifiers::geometry_nodes
@@ -292,6 +292,13 @@ static void modifier_ops_extra_draw(bContext *C, uiLayout *layout, void *md_v)
   if (!md->next) {
     uiLayoutSetEnabled(row, false);
   }
+
+  /* Keep the result of the stack, only constructive mesh modifiers are supported. */
+  if (ob->type == OB_MESH &&
+      BKE_modifier_get_info(md->type)->type != eModifierTypeType_OnlyDeform) {
+    uiItemS(layout);
+    uiItemR(layout, &ptr, "use_cache_result", 0, NULL, ICON_NONE);
+  }
 }
 
 static void modifier_panel_header(const bContext *C, Panel *panel)
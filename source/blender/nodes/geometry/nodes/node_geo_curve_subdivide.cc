@@ -313,11 +313,15 @@ static std::unique_ptr<CurveEval> subdivide_curve(const CurveEval &input_curve,
   output_curve->attributes = input_curve.attributes;
   MutableSpan<SplinePtr> output_splines = output_curve->splines();
 
-  threading::parallel_for(input_splines.index_range(), 128, [&](IndexRange range) {
-    for (const int i : range) {
-      output_splines[i] = subdivide_spline(*input_splines[i], cuts, control_point_offsets[i]);
-    }
-  });
+  threading::parallel_for_weighted(
+      input_splines.index_range(),
+      4096,
+      [&](IndexRange range) {
+        for (const int i : range) {
+          output_splines[i] = subdivide_spline(*input_splines[i], cuts, control_point_offsets[i]);
+        }
+      },
+      [&](const int64_t i) { return input_splines[i]->size(); });
 
   return output_curve;
 }
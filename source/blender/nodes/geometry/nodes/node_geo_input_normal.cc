@@ -184,23 +184,27 @@ static Array<float3> curve_normal_point_domain(const CurveEval &curve)
   const int total_size = offsets.last();
   Array<float3> normals(total_size);
 
-  threading::parallel_for(splines.index_range(), 128, [&](IndexRange range) {
-    for (const int i : range) {
-      const Spline &spline = *splines[i];
-      MutableSpan spline_normals{normals.as_mutable_span().slice(offsets[i], spline.size())};
-      switch (splines[i]->type()) {
-        case Spline::Type::Bezier:
-          calculate_bezier_normals(static_cast<const BezierSpline &>(spline), spline_normals);
-          break;
-        case Spline::Type::Poly:
-          calculate_poly_normals(static_cast<const PolySpline &>(spline), spline_normals);
-          break;
-        case Spline::Type::NURBS:
-          calculate_nurbs_normals(static_cast<const NURBSpline &>(spline), spline_normals);
-          break;
-      }
-    }
-  });
+  threading::parallel_for_weighted(
+      splines.index_range(),
+      4096,
+      [&](IndexRange range) {
+        for (const int i : range) {
+          const Spline &spline = *splines[i];
+          MutableSpan spline_normals{normals.as_mutable_span().slice(offsets[i], spline.size())};
+          switch (splines[i]->type()) {
+            case Spline::Type::Bezier:
+              calculate_bezier_normals(static_cast<const BezierSpline &>(spline), spline_normals);
+              break;
+            case Spline::Type::Poly:
+              calculate_poly_normals(static_cast<const PolySpline &>(spline), spline_normals);
+              break;
+            case Spline::Type::NURBS:
+              calculate_nurbs_normals(static_cast<const NURBSpline &>(spline), spline_normals);
+              break;
+          }
+        }
+      },
+      [&](const int64_t i) { return offsets[i + 1] - offsets[i]; });
   return normals;
 }
 
@@ -20,6 +20,8 @@
 #  include <openvdb/tools/ParticlesToLevelSet.h>
 #endif
 
+#include "BLI_task.hh"
+
 #include "node_geometry_util.hh"
 
 #include "BKE_lib_id.h"
@@ -186,12 +188,14 @@ static void convert_to_grid_index_space(const float voxel_size,
                                         MutableSpan<float> radii)
 {
   const float voxel_size_inv = 1.0f / voxel_size;
-  for (const int i : positions.index_range()) {
-    positions[i] *= voxel_size_inv;
-    /* Better align generated grid with source points. */
-    positions[i] -= float3(0.5f);
-    radii[i] *= voxel_size_inv;
-  }
+  threading::parallel_for(positions.index_range(), 2048, [&](IndexRange range) {
+    for (const int i : range) {
+      positions[i] *= voxel_size_inv;
+      /* Better align generated grid with source points. */
+      positions[i] -= float3(0.5f);
+      radii[i] *= voxel_size_inv;
+    }
+  });
 }
 
 static void initialize_volume_component_from_points(GeoNodeExecParams &params,
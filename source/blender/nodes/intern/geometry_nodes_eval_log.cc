@@ -54,6 +54,12 @@ ModifierLog::ModifierLog(GeoLogger &logger)
                                                        node_with_warning.node);
       node_log.warnings_.append(node_with_warning.warning);
     }
+
+    for (NodeWithExecutionTime &node_with_exec_time : local_logger.node_exec_times_) {
+      NodeLog &node_log = this->lookup_or_add_node_log(log_by_tree_context,
+                                                       node_with_exec_time.node);
+      node_log.exec_time_ += node_with_exec_time.exec_time;
+    }
   }
 }
 
@@ -140,6 +146,13 @@ void TreeLog::foreach_node_log(FunctionRef<void(const NodeLog &)> fn) const
   }
 }
 
+std::chrono::microseconds TreeLog::execution_time() const
+{
+  std::chrono::microseconds exec_time{0};
+  this->foreach_node_log([&](const NodeLog &node_log) { exec_time += node_log.execution_time(); });
+  return exec_time;
+}
+
 const SocketLog *NodeLog::lookup_socket_log(eNodeSocketInOut in_out, int index) const
 {
   BLI_assert(index >= 0);
@@ -385,4 +398,9 @@ void LocalGeoLogger::log_node_warning(DNode node, NodeWarningType type, std::str
   node_warnings_.append({node, {type, std::move(message)}});
 }
 
+void LocalGeoLogger::log_execution_time(DNode node, std::chrono::microseconds exec_time)
+{
+  node_exec_times_.append({node, exec_time});
+}
+
 }  // namespace blender::nodes::geometry_nodes_eval_log
@@ -44,9 +44,12 @@
 /* modules */
 #include "bpy_app_icons.h"
 #include "bpy_app_timers.h"
+#include "bpy_app_trace.h"
 
 #include "BLI_utildefines.h"
 
+#include "MEM_guardedalloc.h"
+
 #include "BKE_appdir.h"
 #include "BKE_blender_version.h"
 #include "BKE_global.h"
@@ -126,6 +129,7 @@ static PyStructSequence_Field app_info_fields[] = {
     /* Modules (not struct sequence). */
     {"icons", "Manage custom icons"},
     {"timers", "Manage timers"},
+    {"trace", "Record timed events to a trace file"},
     {NULL},
 };
 
@@ -212,6 +216,7 @@ static PyObject *make_app_info(void)
   /* modules */
   SetObjItem(BPY_app_icons_module());
   SetObjItem(BPY_app_timers_module());
+  SetObjItem(BPY_app_trace_module());
 
 #undef SetIntItem
 #undef SetStrItem
@@ -328,6 +333,21 @@ static PyObject *bpy_app_tempdir_get(PyObject *UNUSED(self), void *UNUSED(closur
   return PyC_UnicodeFromByte(BKE_tempdir_session());
 }
 
+PyDoc_STRVAR(bpy_app_memory_usage_doc,
+             "Dictionary of the memory in use in bytes, by the part of Blender it is used for: "
+             "'Mesh', 'Undo', 'Image', 'GPU', 'Depsgraph', 'Python' and 'Other' (read-only)");
+static PyObject *bpy_app_memory_usage_get(PyObject *UNUSED(self), void *UNUSED(closure))
+{
+  PyObject *dict = PyDict_New();
+  for (int i = 0; i < MEM_DOMAIN_NUM; i++) {
+    const eMEMDomain domain = (eMEMDomain)i;
+    PyObject *item = PyLong_FromSize_t(MEM_get_memory_in_use_domain(domain));
+    PyDict_SetItemString(dict, MEM_domain_name(domain), item);
+    Py_DECREF(item);
+  }
+  return dict;
+}
+
 PyDoc_STRVAR(
     bpy_app_driver_dict_doc,
     "Dictionary for drivers namespace, editable in-place, reset on file load (read-only)");
@@ -439,6 +459,7 @@ static PyGetSetDef bpy_app_getsets[] = {
      NULL},
     {"tempdir", bpy_app_tempdir_get, NULL, bpy_app_tempdir_doc, NULL},
     {"driver_namespace", bpy_app_driver_dict_get, NULL, bpy_app_driver_dict_doc, NULL},
+    {"memory_usage", bpy_app_memory_usage_get, NULL, bpy_app_memory_usage_doc, NULL},
 
     {"render_icon_size",
      bpy_app_preview_render_size_get,
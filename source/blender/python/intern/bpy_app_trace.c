@@ -0,0 +1,107 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+/** \file
+ * \ingroup pythonintern
+ */
+
+#include "BLI_trace.h"
+#include "BLI_utildefines.h"
+#include <Python.h>
+
+#include "bpy_app_trace.h"
+
+#include "../generic/py_capi_utils.h"
+
+PyDoc_STRVAR(bpy_app_trace_start_doc,
+             ".. function:: start(filepath)\n"
+             "\n"
+             "   Start recording timed events of Blender, such as dependency graph evaluation and\n"
+             "   drawing. The events are written to a file in the Chrome trace format when\n"
+             "   recording stops, which can be opened with https://ui.perfetto.dev.\n"
+             "\n"
+             "   :arg filepath: The file the trace is written to.\n"
+             "   :type filepath: string\n");
+static PyObject *bpy_app_trace_start(PyObject *UNUSED(self), PyObject *args, PyObject *kw)
+{
+  const char *filepath;
+  static const char *_keywords[] = {"filepath", NULL};
+  static _PyArg_Parser _parser = {"s:start", _keywords, 0};
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, &filepath)) {
+    return NULL;
+  }
+  if (BLI_trace_is_enabled()) {
+    PyErr_SetString(PyExc_RuntimeError, "Error: a trace is already being recorded");
+    return NULL;
+  }
+  BLI_trace_start(filepath);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(bpy_app_trace_stop_doc,
+             ".. function:: stop()\n"
+             "\n"
+             "   Stop recording and write the trace.\n"
+             "\n"
+             "   :return: False when writing the trace failed, otherwise True.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_trace_stop(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(BLI_trace_stop());
+}
+
+PyDoc_STRVAR(bpy_app_trace_is_recording_doc,
+             ".. function:: is_recording()\n"
+             "\n"
+             "   :return: True when a trace is being recorded, otherwise False.\n"
+             "   :rtype: bool\n");
+static PyObject *bpy_app_trace_is_recording(PyObject *UNUSED(self))
+{
+  return PyBool_FromLong(BLI_trace_is_enabled());
+}
+
+static struct PyMethodDef M_AppTrace_methods[] = {
+    {"start",
+     (PyCFunction)bpy_app_trace_start,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_trace_start_doc},
+    {"stop", (PyCFunction)bpy_app_trace_stop, METH_NOARGS, bpy_app_trace_stop_doc},
+    {"is_recording",
+     (PyCFunction)bpy_app_trace_is_recording,
+     METH_NOARGS,
+     bpy_app_trace_is_recording_doc},
+    {NULL, NULL, 0, NULL},
+};
+
+static struct PyModuleDef M_AppTrace_module_def = {
+    PyModuleDef_HEAD_INIT,
+    "bpy.app.trace",    /* m_name */
+    NULL,               /* m_doc */
+    0,                  /* m_size */
+    M_AppTrace_methods, /* m_methods */
+    NULL,               /* m_reload */
+    NULL,               /* m_traverse */
+    NULL,               /* m_clear */
+    NULL,               /* m_free */
+};
+
+PyObject *BPY_app_trace_module(void)
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+  PyObject *mod = PyModule_Create(&M_AppTrace_module_def);
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+  return mod;
+}
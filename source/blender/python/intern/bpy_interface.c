@@ -89,6 +89,8 @@ CLG_LOGREF_DECLARE_GLOBAL(BPY_LOG_RNA, "bpy.rna");
 /* In case a python script triggers another python call,
  * stop bpy_context_clear from invalidating. */
 static int py_call_level = 0;
+/* Memory domain to restore when the outermost Python call ends. */
+static eMEMDomain py_call_previous_domain = MEM_DOMAIN_OTHER;
 
 /* Set by command line arguments before Python starts. */
 static bool py_use_system_env = false;
@@ -127,6 +129,7 @@ void bpy_context_set(bContext *C, PyGILState_STATE *gilstate)
 
   if (py_call_level == 1) {
     BPY_context_update(C);
+    py_call_previous_domain = MEM_domain_begin(MEM_DOMAIN_PYTHON);
 
 #ifdef TIME_PY_RUN
     if (bpy_timer_count == 0) {
@@ -154,6 +157,8 @@ void bpy_context_clear(bContext *UNUSED(C), const PyGILState_STATE *gilstate)
     fprintf(stderr, "ERROR: Python context internal state bug. this should not happen!\n");
   }
   else if (py_call_level == 0) {
+    MEM_domain_end(py_call_previous_domain);
+
     /* XXX: Calling classes currently won't store the context :\,
      * can't set NULL because of this. but this is very flaky still. */
 #if 0
@@ -66,6 +66,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_math.h"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
@@ -95,6 +96,8 @@ typedef struct BakeDataZSpan {
   ZSpan *zspan;
   float du_dx, du_dy;
   float dv_dx, dv_dy;
+  /** Image rows this rasterizer writes to, pixels outside are owned by other tasks. */
+  int band_ymin, band_ymax;
 } BakeDataZSpan;
 
 /**
@@ -118,6 +121,10 @@ static void store_bake_pixel(void *handle, int x, int y, float u, float v)
   BakeDataZSpan *bd = (BakeDataZSpan *)handle;
   BakePixel *pixel;
 
+  if (y < bd->band_ymin || y >= bd->band_ymax) {
+    return;
+  }
+
   const int width = bd->bk_image->width;
   const size_t offset = bd->bk_image->offset;
   const int i = offset + y * width + x;
@@ -697,6 +704,118 @@ static void bake_differentials(BakeDataZSpan *bd,
   }
 }
 
+/** UV coordinates and differentials of a triangle, in pixel space of its bake image. */
+typedef struct BakeTriangle {
+  float vec[3][2];
+  float du_dx, du_dy;
+  float dv_dx, dv_dy;
+  int image_id;
+} BakeTriangle;
+
+typedef struct BakePopulateData {
+  const Mesh *me;
+  const MLoopTri *looptri;
+  const MLoopUV *mloopuv;
+  const BakeTargets *targets;
+  BakeTriangle *triangles;
+  int tottri;
+  BakePixel *pixel_array;
+  /** Every image is split in bands of rows, tasks are (image, band) pairs. */
+  int bands_num;
+} BakePopulateData;
+
+static void bake_triangles_prepare_fn(void *__restrict userdata,
+                                      const int i,
+                                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BakePopulateData *data = userdata;
+  const MLoopTri *lt = &data->looptri[i];
+  const MPoly *mp = &data->me->mpoly[lt->poly];
+  BakeTriangle *tri = &data->triangles[i];
+
+  tri->image_id = data->targets->material_to_image[mp->mat_nr];
+  if (tri->image_id < 0) {
+    return;
+  }
+
+  const BakeImage *bk_image = &data->targets->images[tri->image_id];
+  for (int a = 0; a < 3; a++) {
+    const float *uv = data->mloopuv[lt->tri[a]].uv;
+
+    /* NOTE(campbell): workaround for pixel aligned UVs which are common and can screw up our
+     * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
+     * camera aligned quads also have this problem but they are less common.
+     * Add a small offset to the UVs, fixes bug T18685. */
+    tri->vec[a][0] = uv[0] * (float)bk_image->width - (0.5f + 0.001f);
+    tri->vec[a][1] = uv[1] * (float)bk_image->height - (0.5f + 0.002f);
+  }
+
+  BakeDataZSpan bd;
+  bake_differentials(&bd, tri->vec[0], tri->vec[1], tri->vec[2]);
+  tri->du_dx = bd.du_dx;
+  tri->du_dy = bd.du_dy;
+  tri->dv_dx = bd.dv_dx;
+  tri->dv_dy = bd.dv_dy;
+}
+
+static void bake_pixels_populate_band_fn(void *__restrict userdata,
+                                         const int task_index,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  BakePopulateData *data = userdata;
+  const int image_id = task_index / data->bands_num;
+  const int band = task_index % data->bands_num;
+  BakeImage *bk_image = &data->targets->images[image_id];
+
+  const int band_height = divide_ceil_u(bk_image->height, data->bands_num);
+  const int band_ymin = band * band_height;
+  const int band_ymax = min_ii(band_ymin + band_height, bk_image->height);
+  if (band_ymin >= band_ymax) {
+    return;
+  }
+
+  ZSpan zspan;
+  zbuf_alloc_span(&zspan, bk_image->width, bk_image->height);
+
+  BakeDataZSpan bd;
+  bd.pixel_array = data->pixel_array;
+  bd.bk_image = bk_image;
+  bd.zspan = &zspan;
+  bd.band_ymin = band_ymin;
+  bd.band_ymax = band_ymax;
+
+  /* Triangles are rasterized in their original order, so where they overlap the same one wins
+   * as when rasterizing the whole image at once. */
+  for (int i = 0; i < data->tottri; i++) {
+    const BakeTriangle *tri = &data->triangles[i];
+    if (tri->image_id != image_id) {
+      continue;
+    }
+
+    const float ymin = min_fff(tri->vec[0][1], tri->vec[1][1], tri->vec[2][1]);
+    const float ymax = max_fff(tri->vec[0][1], tri->vec[1][1], tri->vec[2][1]);
+    if (ymax < (float)(band_ymin - 1) || ymin > (float)(band_ymax + 1)) {
+      continue;
+    }
+
+    bd.primitive_id = i;
+    bd.du_dx = tri->du_dx;
+    bd.du_dy = tri->du_dy;
+    bd.dv_dx = tri->dv_dx;
+    bd.dv_dy = tri->dv_dy;
+    zspan_scanconvert(
+        &zspan, (void *)&bd, tri->vec[0], tri->vec[1], tri->vec[2], store_bake_pixel);
+  }
+
+  zbuf_free_span(&zspan);
+}
+
+/**
+ * Rasterize the UV layout of \a me into the pixels of the bake images.
+ *
+ * Each image is split in bands of rows which are filled in parallel, every band rasterizes the
+ * triangles that overlap it and only stores pixels within its own rows.
+ */
 void RE_bake_pixels_populate(Mesh *me,
                              BakePixel pixel_array[],
                              const size_t num_pixels,
@@ -716,60 +835,41 @@ void RE_bake_pixels_populate(Mesh *me,
     return;
   }
 
-  BakeDataZSpan bd;
-  bd.pixel_array = pixel_array;
-  bd.zspan = MEM_callocN(sizeof(ZSpan) * targets->num_images, "bake zspan");
-
   /* initialize all pixel arrays so we know which ones are 'blank' */
   for (int i = 0; i < num_pixels; i++) {
     pixel_array[i].primitive_id = -1;
     pixel_array[i].object_id = 0;
   }
 
-  for (int i = 0; i < targets->num_images; i++) {
-    zbuf_alloc_span(&bd.zspan[i], targets->images[i].width, targets->images[i].height);
-  }
-
   const int tottri = poly_to_tri_count(me->totpoly, me->totloop);
   MLoopTri *looptri = MEM_mallocN(sizeof(*looptri) * tottri, __func__);
 
   BKE_mesh_recalc_looptri(me->mloop, me->mpoly, me->mvert, me->totloop, me->totpoly, looptri);
 
-  for (int i = 0; i < tottri; i++) {
-    const MLoopTri *lt = &looptri[i];
-    const MPoly *mp = &me->mpoly[lt->poly];
-    float vec[3][2];
-    int mat_nr = mp->mat_nr;
-    int image_id = targets->material_to_image[mat_nr];
-
-    if (image_id < 0) {
-      continue;
-    }
-
-    bd.bk_image = &targets->images[image_id];
-    bd.primitive_id = i;
-
-    for (int a = 0; a < 3; a++) {
-      const float *uv = mloopuv[lt->tri[a]].uv;
-
-      /* NOTE(campbell): workaround for pixel aligned UVs which are common and can screw up our
-       * intersection tests where a pixel gets in between 2 faces or the middle of a quad,
-       * camera aligned quads also have this problem but they are less common.
-       * Add a small offset to the UVs, fixes bug T18685. */
-      vec[a][0] = uv[0] * (float)bd.bk_image->width - (0.5f + 0.001f);
-      vec[a][1] = uv[1] * (float)bd.bk_image->height - (0.5f + 0.002f);
-    }
+  BakePopulateData data = {
+      .me = me,
+      .looptri = looptri,
+      .mloopuv = mloopuv,
+      .targets = targets,
+      .triangles = MEM_mallocN(sizeof(BakeTriangle) * tottri, "bake triangles"),
+      .tottri = tottri,
+      .pixel_array = pixel_array,
+      /* Enough bands to balance the load, few enough that culling triangles per band is cheap. */
+      .bands_num = BLI_task_scheduler_num_threads() * 2,
+  };
 
-    bake_differentials(&bd, vec[0], vec[1], vec[2]);
-    zspan_scanconvert(&bd.zspan[image_id], (void *)&bd, vec[0], vec[1], vec[2], store_bake_pixel);
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, tottri, &data, bake_triangles_prepare_fn, &settings);
 
-  for (int i = 0; i < targets->num_images; i++) {
-    zbuf_free_span(&bd.zspan[i]);
-  }
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 1;
+  BLI_task_parallel_range(
+      0, targets->num_images * data.bands_num, &data, bake_pixels_populate_band_fn, &settings);
 
+  MEM_freeN(data.triangles);
   MEM_freeN(looptri);
-  MEM_freeN(bd.zspan);
 }
 
 /* ******************** NORMALS ************************ */
@@ -47,6 +47,8 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_system.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timecode.h"
 
@@ -157,12 +159,15 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 
 /* ********* alloc and free ******** */
 
+struct RenderWriteQueue;
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override);
+                                   const char *name_override,
+                                   struct RenderWriteQueue *write_queue);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void *UNUSED(arg), RenderResult *UNUSED(rr))
@@ -1878,7 +1883,7 @@ void RE_RenderFrame(Render *re,
                                      NULL);
 
         /* reports only used for Movie */
-        do_write_image_or_movie(re, bmain, scene, NULL, 0, name);
+        do_write_image_or_movie(re, bmain, scene, NULL, 0, name, NULL);
       }
     }
 
@@ -2173,14 +2178,252 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Background Writing
+ *
+ * With #R_BACKGROUND_WRITE, animation frames are saved by a task while the next frame renders.
+ * The task works on a copy of the render result and a shallow copy of the scene, so nothing it
+ * reads is changed by the next frame. Only one frame is saved at a time, which keeps the memory
+ * usage down and the frames of movies in order. When the copy does not fit in memory the frame is
+ * saved directly instead.
+ * \{ */
+
+typedef struct RenderWriteQueue {
+  TaskPool *task_pool;
+  Render *re;
+  bMovieHandle *mh;
+  int totvideos;
+  /* Reports of the frame being saved, moved to the render reports by the main thread. */
+  ReportList reports;
+  /* Cleared when saving a frame failed. */
+  bool ok;
+} RenderWriteQueue;
+
+typedef struct RenderWriteTaskData {
+  RenderResult *rr;
+  Scene tmp_scene;
+  RenderData rd;
+  char name[FILE_MAX];
+} RenderWriteTaskData;
+
+static bool render_write_views(ReportList *reports,
+                               RenderResult *rr,
+                               Scene *scene,
+                               RenderData *rd,
+                               bMovieHandle *mh,
+                               void **movie_ctx_arr,
+                               const int totvideos,
+                               char *name)
+{
+  if (BKE_imtype_is_movie(scene->r.im_format.imtype)) {
+    RE_WriteRenderViewsMovie(reports, rr, scene, rd, mh, movie_ctx_arr, totvideos, false);
+    return true;
+  }
+  /* write images as individual images or stereo */
+  return RE_WriteRenderViewsImage(reports, rr, scene, true, name);
+}
+
+static void render_write_task_func(TaskPool *__restrict pool, void *task_data_v)
+{
+  RenderWriteQueue *write_queue = (RenderWriteQueue *)BLI_task_pool_user_data(pool);
+  RenderWriteTaskData *task_data = (RenderWriteTaskData *)task_data_v;
+
+  if (!render_write_views(&write_queue->reports,
+                          task_data->rr,
+                          &task_data->tmp_scene,
+                          &task_data->rd,
+                          write_queue->mh,
+                          write_queue->re->movie_ctx_arr,
+                          write_queue->totvideos,
+                          task_data->name)) {
+    write_queue->ok = false;
+  }
+
+  RE_FreeRenderResult(task_data->rr);
+}
+
+static void render_write_queue_init(RenderWriteQueue *write_queue,
+                                    Render *re,
+                                    bMovieHandle *mh,
+                                    const int totvideos)
+{
+  write_queue->task_pool = BLI_task_pool_create_background_serial(write_queue,
+                                                                  TASK_PRIORITY_LOW);
+  write_queue->re = re;
+  write_queue->mh = mh;
+  write_queue->totvideos = totvideos;
+  BKE_reports_init(&write_queue->reports, RPT_STORE);
+  write_queue->ok = true;
+}
+
+/**
+ * Wait for the frame being saved, returns false when saving any frame failed.
+ */
+static bool render_write_queue_wait(RenderWriteQueue *write_queue)
+{
+  BLI_task_pool_work_and_wait(write_queue->task_pool);
+
+  LISTBASE_FOREACH (Report *, report, &write_queue->reports.list) {
+    BKE_report(write_queue->re->reports, report->type, report->message);
+  }
+  BKE_reports_clear(&write_queue->reports);
+
+  return write_queue->ok;
+}
+
+static void render_write_queue_free(RenderWriteQueue *write_queue)
+{
+  BLI_assert(BLI_listbase_is_empty(&write_queue->reports.list));
+  BLI_task_pool_free(write_queue->task_pool);
+}
+
+static bool render_write_use_layers(const Scene *scene)
+{
+  /* Only OpenEXR files contain the passes of the render layers. */
+  return ELEM(scene->r.im_format.imtype, R_IMF_IMTYPE_OPENEXR, R_IMF_IMTYPE_MULTILAYER);
+}
+
+/**
+ * Approximate size in bytes of the copy of \a rr made to save it in the background.
+ */
+static size_t render_write_result_size(const RenderResult *rr, const bool use_layers)
+{
+  const size_t pixels = (size_t)rr->rectx * (size_t)rr->recty;
+  size_t size = 0;
+
+  LISTBASE_FOREACH (const RenderView *, rv, &rr->views) {
+    size += rv->rectf ? pixels * sizeof(float[4]) : 0;
+    size += rv->rectz ? pixels * sizeof(float) : 0;
+    size += rv->rect32 ? pixels * sizeof(int) : 0;
+  }
+
+  if (use_layers) {
+    LISTBASE_FOREACH (const RenderLayer *, rl, &rr->layers) {
+      LISTBASE_FOREACH (const RenderPass *, rpass, &rl->passes) {
+        size += (size_t)rpass->rectx * (size_t)rpass->recty * rpass->channels * sizeof(float);
+      }
+    }
+  }
+
+  return size;
+}
+
+/**
+ * Check whether a copy of \a rr can be kept while the next frame renders, limited to half of the
+ * system memory like the default cache limit.
+ */
+static bool render_write_queue_fits(const RenderResult *rr, const Scene *scene)
+{
+  const size_t memory_max = BLI_system_memory_max_in_megabytes() * 1024 * 1024;
+  const size_t size = render_write_result_size(rr, render_write_use_layers(scene));
+  return MEM_get_memory_in_use() + size <= memory_max / 2;
+}
+
+static void render_write_queue_push(RenderWriteQueue *write_queue,
+                                    RenderResult *rr,
+                                    Scene *scene,
+                                    const char *name)
+{
+  RenderWriteTaskData *task_data = MEM_mallocN(sizeof(RenderWriteTaskData), __func__);
+  const ListBase layers = rr->layers;
+  if (!render_write_use_layers(scene)) {
+    BLI_listbase_clear(&rr->layers);
+  }
+  task_data->rr = RE_DuplicateRenderResult(rr);
+  rr->layers = layers;
+
+  task_data->tmp_scene = *scene;
+  task_data->rd = write_queue->re->r;
+  BLI_strncpy(task_data->name, name, sizeof(task_data->name));
+
+  BLI_task_pool_push(write_queue->task_pool, render_write_task_func, task_data, true, NULL);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Input Prefetching
+ *
+ * With #R_BACKGROUND_WRITE, the files of image sequences used by the compositor are read by
+ * tasks while the frame before them renders. Only the file contents are read, so they come from
+ * the file system cache when the image is loaded; the image data-blocks are not accessed from
+ * other threads.
+ * \{ */
+
+#define PREFETCH_BUFFER_SIZE (1 << 20)
+
+static void render_prefetch_file_func(TaskPool *__restrict UNUSED(pool), void *task_data)
+{
+  const char *filepath = (const char *)task_data;
+  FILE *file = BLI_fopen(filepath, "rb");
+  if (file == NULL) {
+    return;
+  }
+
+  void *buffer = MEM_mallocN(PREFETCH_BUFFER_SIZE, __func__);
+  while (fread(buffer, 1, PREFETCH_BUFFER_SIZE, file) == PREFETCH_BUFFER_SIZE) {
+    /* Pass. */
+  }
+  MEM_freeN(buffer);
+  fclose(file);
+}
+
+static void render_prefetch_ntree_images(TaskPool *task_pool,
+                                         Main *bmain,
+                                         bNodeTree *ntree,
+                                         const int cfra)
+{
+  LISTBASE_FOREACH (bNode *, node, &ntree->nodes) {
+    if ((node->flag & NODE_MUTED) || node->id == NULL) {
+      continue;
+    }
+
+    if (node->type == NODE_GROUP) {
+      render_prefetch_ntree_images(task_pool, bmain, (bNodeTree *)node->id, cfra);
+    }
+    else if (node->type == CMP_NODE_IMAGE) {
+      Image *ima = (Image *)node->id;
+      if (ima->source != IMA_SRC_SEQUENCE) {
+        continue;
+      }
+
+      /* Not #BKE_image_user_frame_calc, which also tags the image. */
+      ImageUser iuser = *(ImageUser *)node->storage;
+      iuser.framenr = BKE_image_user_frame_get(&iuser, cfra, NULL);
+
+      char *filepath = MEM_mallocN(FILE_MAX, __func__);
+      BKE_image_user_file_path(&iuser, ima, filepath);
+      BLI_path_abs(filepath, ID_BLEND_PATH(bmain, &ima->id));
+
+      BLI_task_pool_push(task_pool, render_prefetch_file_func, filepath, true, NULL);
+    }
+  }
+}
+
+/**
+ * Start reading the image sequence files of the compositor for frame \a cfra, after waiting for
+ * the files of the previous frame.
+ */
+static void render_prefetch_images(TaskPool *task_pool, Main *bmain, Scene *scene, const int cfra)
+{
+  BLI_task_pool_work_and_wait(task_pool);
+
+  if ((scene->r.scemode & R_DOCOMP) && scene->use_nodes && scene->nodetree) {
+    render_prefetch_ntree_images(task_pool, bmain, scene->nodetree, cfra);
+  }
+}
+
+/** \} */
+
 static int do_write_image_or_movie(Render *re,
                                    Main *bmain,
                                    Scene *scene,
                                    bMovieHandle *mh,
                                    const int totvideos,
-                                   const char *name_override)
+                                   const char *name_override,
+                                   RenderWriteQueue *write_queue)
 {
-  char name[FILE_MAX];
+  char name[FILE_MAX] = "";
   RenderResult rres;
   double render_time;
   bool ok = true;
@@ -2193,12 +2436,7 @@ static int do_write_image_or_movie(Render *re,
   if (do_write_file) {
     RE_AcquireResultImageViews(re, &rres);
 
-    /* write movie or image */
-    if (BKE_imtype_is_movie(scene->r.im_format.imtype)) {
-      RE_WriteRenderViewsMovie(
-          re->reports, &rres, scene, &re->r, mh, re->movie_ctx_arr, totvideos, false);
-    }
-    else {
+    if (!BKE_imtype_is_movie(scene->r.im_format.imtype)) {
       if (name_override) {
         BLI_strncpy(name, name_override, sizeof(name));
       }
@@ -2212,9 +2450,24 @@ static int do_write_image_or_movie(Render *re,
                                      true,
                                      NULL);
       }
+    }
 
-      /* write images as individual images or stereo */
-      ok = RE_WriteRenderViewsImage(re->reports, &rres, scene, true, name);
+    if (write_queue) {
+      /* Errors of the previous frame stop the animation before this one is saved. */
+      ok = render_write_queue_wait(write_queue);
+      if (ok) {
+        if (render_write_queue_fits(&rres, scene)) {
+          render_write_queue_push(write_queue, &rres, scene, name);
+        }
+        else {
+          ok = render_write_views(
+              re->reports, &rres, scene, &re->r, mh, re->movie_ctx_arr, totvideos, name);
+        }
+      }
+    }
+    else {
+      ok = render_write_views(
+          re->reports, &rres, scene, &re->r, mh, re->movie_ctx_arr, totvideos, name);
     }
 
     RE_ReleaseResultImageViews(re, &rres);
@@ -2363,6 +2616,14 @@ void RE_RenderAnim(Render *re,
 
   re->flag |= R_ANIMATION;
 
+  RenderWriteQueue write_queue;
+  TaskPool *prefetch_pool = NULL;
+  const bool use_background_write = (rd.scemode & R_BACKGROUND_WRITE) && do_write_file;
+  if (use_background_write) {
+    render_write_queue_init(&write_queue, re, mh, totvideos);
+    prefetch_pool = BLI_task_pool_create_background(NULL, TASK_PRIORITY_LOW);
+  }
+
   {
     for (nfra = sfra, scene->r.cfra = sfra; scene->r.cfra <= efra; scene->r.cfra++) {
       char name[FILE_MAX];
@@ -2476,12 +2737,22 @@ void RE_RenderAnim(Render *re,
       /* run callbacks before rendering, before the scene is updated */
       render_callback_exec_id(re, re->main, &scene->id, BKE_CB_EVT_RENDER_PRE);
 
+      if (prefetch_pool && nfra <= efra) {
+        render_prefetch_images(prefetch_pool, bmain, scene, nfra);
+      }
+
       do_render_full_pipeline(re);
       totrendered++;
 
       if (re->test_break(re->tbh) == 0) {
         if (!G.is_break) {
-          if (!do_write_image_or_movie(re, bmain, scene, mh, totvideos, NULL)) {
+          if (!do_write_image_or_movie(re,
+                                       bmain,
+                                       scene,
+                                       mh,
+                                       totvideos,
+                                       NULL,
+                                       use_background_write ? &write_queue : NULL)) {
             G.is_break = true;
           }
         }
@@ -2531,6 +2802,15 @@ void RE_RenderAnim(Render *re,
     }
   }
 
+  if (use_background_write) {
+    if (!render_write_queue_wait(&write_queue)) {
+      G.is_break = true;
+    }
+    render_write_queue_free(&write_queue);
+    BLI_task_pool_work_and_wait(prefetch_pool);
+    BLI_task_pool_free(prefetch_pool);
+  }
+
   /* end movie */
   if (is_movie && do_write_file) {
     re_movie_free_all(re, mh, totvideos);
@@ -1133,6 +1133,11 @@ int render_result_exr_file_read_path(RenderResult *rr,
     }
   }
 
+  /* Only decode the parts holding the requested layer. */
+  if (rl_single) {
+    IMB_exr_select_pass(exrhandle, rl_single->name, NULL);
+  }
+
   IMB_exr_read_channels(exrhandle);
   IMB_exr_close(exrhandle);
 
@@ -1208,6 +1213,16 @@ bool render_result_exr_file_cache_read(Render *re)
   const char *colorspace = IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_SCENE_LINEAR);
   RE_FreeRenderResult(re->result);
 
+  /* Skip layers cached by an earlier render that are no longer rendered. */
+  bool found = false;
+  FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer) {
+    found |= IMB_exr_select_pass(exrhandle, view_layer->name, NULL);
+  }
+  FOREACH_VIEW_LAYER_TO_RENDER_END;
+  if (!found) {
+    IMB_exr_select_pass(exrhandle, NULL, NULL);
+  }
+
   IMB_exr_read_channels(exrhandle);
   re->result = render_result_new_from_exr(exrhandle, colorspace, false, rectx, recty);
 
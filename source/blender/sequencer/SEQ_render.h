@@ -36,6 +36,7 @@ struct Sequence;
 
 typedef enum eSeqTaskId {
   SEQ_TASK_MAIN_RENDER,
+  /* Every prefetch worker uses its own ID, starting with this one. */
   SEQ_TASK_PREFETCH_RENDER,
 } eSeqTaskId;
 
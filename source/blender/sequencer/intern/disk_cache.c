@@ -24,6 +24,7 @@
 #include <memory.h>
 #include <stddef.h>
 #include <time.h>
+#include <zstd.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -67,7 +68,10 @@
  * For each cached non-temp image, image data and supplementary info are written to HDD.
  * Multiple(DCACHE_IMAGES_PER_FILE) images share the same file.
  * Each of these files contains header DiskCacheHeader followed by image data.
- * Zlib compression with user definable level can be used to compress image data(per image)
+ * Zstd compression with user definable level can be used to compress image data(per image).
+ * Images that don't get smaller are stored uncompressed, then `size_compressed == size_raw`.
+ * Compression and decompression run outside of the disk cache lock, which only protects the
+ * file access. Image data is aligned to DCACHE_ENTRY_ALIGNMENT bytes in the file.
  * Images are written in order in which they are rendered.
  * Overwriting of individual entry is not possible.
  * Stored images are deleted by invalidation, or when size of all files exceeds maximum
@@ -81,6 +85,7 @@
 #define DCACHE_FNAME_FORMAT "%d-%dx%d-%d%%(%d)-%d.dcf"
 #define DCACHE_IMAGES_PER_FILE 100
 #define DCACHE_CURRENT_VERSION 2
+#define DCACHE_ENTRY_ALIGNMENT 4096
 #define COLORSPACE_NAME_MAX 64 /* XXX: defined in IMB intern. */
 
 typedef struct DiskCacheHeaderEntry {
@@ -434,39 +439,53 @@ void seq_disk_cache_invalidate(SeqDiskCache *disk_cache,
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
 }
 
-static size_t deflate_imbuf_to_file(ImBuf *ibuf,
-                                    FILE *file,
-                                    int level,
-                                    DiskCacheHeaderEntry *header_entry)
+static void *seq_disk_cache_imbuf_data(ImBuf *ibuf)
 {
-  void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+  return (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
+}
 
-  /* Apply compression if wanted, otherwise just write directly to the file. */
-  if (level > 0) {
-    return BLI_file_zstd_from_mem_at_pos(
-        data, header_entry->size_raw, file, header_entry->offset, level);
+/* Compress image data into a new buffer, this is done before the disk cache is locked so other
+ * threads can read and write in the meantime. Returns NULL when the data does not get smaller,
+ * in which case it is stored as is. */
+static void *seq_disk_cache_compress(const void *data,
+                                     size_t size_raw,
+                                     int level,
+                                     size_t *r_size_compressed)
+{
+  const size_t size_bound = ZSTD_compressBound(size_raw);
+  void *buf = MEM_mallocN(size_bound, __func__);
+
+  ZSTD_CCtx *ctx = ZSTD_createCCtx();
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_compressionLevel, level);
+  /* Big frames are split over worker threads. This fails silently when zstd is built without
+   * multi-threading support, compression then runs on the calling thread. */
+  ZSTD_CCtx_setParameter(ctx, ZSTD_c_nbWorkers, BLI_system_thread_count());
+  const size_t ret = ZSTD_compress2(ctx, buf, size_bound, data, size_raw);
+  ZSTD_freeCCtx(ctx);
+
+  if (ZSTD_isError(ret) || ret >= size_raw) {
+    MEM_freeN(buf);
+    return NULL;
   }
 
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fwrite(data, 1, header_entry->size_raw, file);
+  *r_size_compressed = ret;
+  return buf;
 }
 
-static size_t inflate_file_to_imbuf(ImBuf *ibuf, FILE *file, DiskCacheHeaderEntry *header_entry)
+static bool seq_disk_cache_write_data(FILE *file, uint64_t offset, const void *data, size_t size)
 {
-  void *data = (ibuf->rect != NULL) ? (void *)ibuf->rect : (void *)ibuf->rect_float;
-  char header[4];
-  fseek(file, header_entry->offset, SEEK_SET);
-  if (fread(header, 1, sizeof(header), file) != sizeof(header)) {
-    return 0;
+  if (BLI_fseek(file, (int64_t)offset, SEEK_SET) != 0) {
+    return false;
   }
+  return fwrite(data, 1, size, file) == size;
+}
 
-  /* Check if the data is compressed or raw. */
-  if (BLI_file_magic_is_zstd(header)) {
-    return BLI_file_unzstd_to_mem_at_pos(data, header_entry->size_raw, file, header_entry->offset);
+static bool seq_disk_cache_read_data(FILE *file, uint64_t offset, void *data, size_t size)
+{
+  if (BLI_fseek(file, (int64_t)offset, SEEK_SET) != 0) {
+    return false;
   }
-
-  fseek(file, header_entry->offset, SEEK_SET);
-  return fread(data, 1, header_entry->size_raw, file);
+  return fread(data, 1, size, file) == size;
 }
 
 static bool seq_disk_cache_read_header(FILE *file, DiskCacheHeader *header)
@@ -521,6 +540,8 @@ static int seq_disk_cache_add_header_entry(SeqCacheKey *key, ImBuf *ibuf, DiskCa
   if (i > 0) {
     offset = header->entry[i - 1].offset + header->entry[i - 1].size_compressed;
   }
+  /* Start every image on a page boundary, so it is read with aligned I/O. */
+  offset = (offset + DCACHE_ENTRY_ALIGNMENT - 1) & ~(uint64_t)(DCACHE_ENTRY_ALIGNMENT - 1);
 
   if (ENDIAN_ORDER == B_ENDIAN) {
     header->entry[i].encoding = 255;
@@ -561,9 +582,24 @@ static int seq_disk_cache_get_header_entry(SeqCacheKey *key, DiskCacheHeader *he
 
 bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf *ibuf)
 {
+  const int level = seq_disk_cache_compression_level();
+  const void *data = seq_disk_cache_imbuf_data(ibuf);
+  const size_t size_raw = (size_t)ibuf->x * ibuf->y * ibuf->channels *
+                          ((ibuf->rect != NULL) ? 1 : 4);
+  size_t size_data = size_raw;
+  void *data_compressed = NULL;
+
+  if (level > 0) {
+    data_compressed = seq_disk_cache_compress(data, size_raw, level, &size_data);
+    if (data_compressed != NULL) {
+      data = data_compressed;
+    }
+  }
+
   BLI_mutex_lock(&disk_cache->read_write_mutex);
 
   char path[FILE_MAX];
+  bool success = false;
 
   seq_disk_cache_get_file_path(disk_cache, key, path, sizeof(path));
   BLI_make_existing_file(path);
@@ -571,44 +607,44 @@ bool seq_disk_cache_write_file(SeqDiskCache *disk_cache, SeqCacheKey *key, ImBuf
   FILE *file = BLI_fopen(path, "rb+");
   if (!file) {
     file = BLI_fopen(path, "wb+");
-    if (!file) {
-      BLI_mutex_unlock(&disk_cache->read_write_mutex);
-      return false;
+    if (file) {
+      seq_disk_cache_add_file_to_list(disk_cache, path);
     }
-    seq_disk_cache_add_file_to_list(disk_cache, path);
-  }
-
-  DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, path);
-  DiskCacheHeader header;
-  memset(&header, 0, sizeof(header));
-  /* #BLI_make_existing_file() above may create an empty file. This is fine, don't attempt reading
-   * the header in that case. */
-  if (cache_file->fstat.st_size != 0 && !seq_disk_cache_read_header(file, &header)) {
-    fclose(file);
-    seq_disk_cache_delete_file(disk_cache, cache_file);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return false;
   }
-  int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
-
-  size_t bytes_written = deflate_imbuf_to_file(
-      ibuf, file, seq_disk_cache_compression_level(), &header.entry[entry_index]);
-
-  if (bytes_written != 0) {
-    /* Last step is writing header, as image data can be overwritten,
-     * but missing data would cause problems.
-     */
-    header.entry[entry_index].size_compressed = bytes_written;
-    seq_disk_cache_write_header(file, &header);
-    seq_disk_cache_update_file(disk_cache, path);
-    fclose(file);
 
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return true;
+  if (file) {
+    DiskCacheFile *cache_file = seq_disk_cache_get_file_entry_by_path(disk_cache, path);
+    DiskCacheHeader header;
+    memset(&header, 0, sizeof(header));
+    /* #BLI_make_existing_file() above may create an empty file. This is fine, don't attempt
+     * reading the header in that case. */
+    if (cache_file->fstat.st_size != 0 && !seq_disk_cache_read_header(file, &header)) {
+      fclose(file);
+      seq_disk_cache_delete_file(disk_cache, cache_file);
+    }
+    else {
+      int entry_index = seq_disk_cache_add_header_entry(key, ibuf, &header);
+      BLI_assert(header.entry[entry_index].size_raw == size_raw);
+
+      if (seq_disk_cache_write_data(file, header.entry[entry_index].offset, data, size_data)) {
+        /* Last step is writing header, as image data can be overwritten,
+         * but missing data would cause problems.
+         */
+        header.entry[entry_index].size_compressed = size_data;
+        seq_disk_cache_write_header(file, &header);
+        success = true;
+      }
+      fclose(file);
+      if (success) {
+        seq_disk_cache_update_file(disk_cache, path);
+      }
+    }
   }
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
-  return false;
+
+  MEM_SAFE_FREE(data_compressed);
+  return success;
 }
 
 ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
@@ -641,20 +677,23 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     return NULL;
   }
 
+  const DiskCacheHeaderEntry *entry = &header.entry[entry_index];
   ImBuf *ibuf;
   uint64_t size_char = (uint64_t)key->context.rectx * key->context.recty * 4;
   uint64_t size_float = (uint64_t)key->context.rectx * key->context.recty * 16;
-  size_t expected_size;
 
-  if (header.entry[entry_index].size_raw == size_char) {
-    expected_size = size_char;
+  if (entry->size_compressed == 0) {
+    fclose(file);
+    BLI_mutex_unlock(&disk_cache->read_write_mutex);
+    return NULL;
+  }
+  if (entry->size_raw == size_char) {
     ibuf = IMB_allocImBuf(key->context.rectx, key->context.recty, 32, IB_rect);
-    IMB_colormanagement_assign_rect_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_rect_colorspace(ibuf, entry->colorspace_name);
   }
-  else if (header.entry[entry_index].size_raw == size_float) {
-    expected_size = size_float;
+  else if (entry->size_raw == size_float) {
     ibuf = IMB_allocImBuf(key->context.rectx, key->context.recty, 32, IB_rectfloat);
-    IMB_colormanagement_assign_float_colorspace(ibuf, header.entry[entry_index].colorspace_name);
+    IMB_colormanagement_assign_float_colorspace(ibuf, entry->colorspace_name);
   }
   else {
     fclose(file);
@@ -662,20 +701,36 @@ ImBuf *seq_disk_cache_read_file(SeqDiskCache *disk_cache, SeqCacheKey *key)
     return NULL;
   }
 
-  size_t bytes_read = inflate_file_to_imbuf(ibuf, file, &header.entry[entry_index]);
+  /* Uncompressed images are read straight into the image buffer, compressed ones in one go into
+   * a temporary buffer, to be decompressed after the lock is released. */
+  void *data = seq_disk_cache_imbuf_data(ibuf);
+  const bool is_compressed = entry->size_compressed != entry->size_raw;
+  void *data_compressed = is_compressed ? MEM_mallocN(entry->size_compressed, __func__) : NULL;
 
-  /* Sanity check. */
-  if (bytes_read != expected_size) {
-    fclose(file);
-    IMB_freeImBuf(ibuf);
-    BLI_mutex_unlock(&disk_cache->read_write_mutex);
-    return NULL;
+  bool success = seq_disk_cache_read_data(file,
+                                          entry->offset,
+                                          is_compressed ? data_compressed : data,
+                                          entry->size_compressed);
+  if (success) {
+    BLI_file_touch(path);
+    seq_disk_cache_update_file(disk_cache, path);
   }
-  BLI_file_touch(path);
-  seq_disk_cache_update_file(disk_cache, path);
   fclose(file);
 
   BLI_mutex_unlock(&disk_cache->read_write_mutex);
+
+  if (success && is_compressed) {
+    const size_t ret = ZSTD_decompress(
+        data, entry->size_raw, data_compressed, entry->size_compressed);
+    /* Sanity check. */
+    success = !ZSTD_isError(ret) && ret == entry->size_raw;
+  }
+  MEM_SAFE_FREE(data_compressed);
+
+  if (!success) {
+    IMB_freeImBuf(ibuf);
+    return NULL;
+  }
   return ibuf;
 }
 
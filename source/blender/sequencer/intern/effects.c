@@ -35,6 +35,7 @@
 #include "BLI_path_util.h"
 #include "BLI_rect.h"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -2176,28 +2177,28 @@ static void copy_wipe_effect(Sequence *dst, Sequence *src, const int UNUSED(flag
 
 static void do_wipe_effect_byte(Sequence *seq,
                                 float facf0,
-                                float UNUSED(facf1),
-                                int x,
-                                int y,
+                                int width,
+                                int height,
+                                int start_line,
+                                int total_lines,
                                 unsigned char *rect1,
                                 unsigned char *rect2,
                                 unsigned char *out)
 {
   WipeZone wipezone;
   WipeVars *wipe = (WipeVars *)seq->effectdata;
-  int xo, yo;
+  int x, y;
   unsigned char *cp1, *cp2, *rt;
 
-  precalc_wipe_zone(&wipezone, wipe, x, y);
+  /* The zone is defined for the whole image, the slice only covers some of its lines. */
+  precalc_wipe_zone(&wipezone, wipe, width, height);
 
   cp1 = rect1;
   cp2 = rect2;
   rt = out;
 
-  xo = x;
-  yo = y;
-  for (y = 0; y < yo; y++) {
-    for (x = 0; x < xo; x++) {
+  for (y = start_line; y < start_line + total_lines; y++) {
+    for (x = 0; x < width; x++) {
       float check = check_zone(&wipezone, x, y, seq, facf0);
       if (check) {
         if (cp1) {
@@ -2248,28 +2249,28 @@ static void do_wipe_effect_byte(Sequence *seq,
 
 static void do_wipe_effect_float(Sequence *seq,
                                  float facf0,
-                                 float UNUSED(facf1),
-                                 int x,
-                                 int y,
+                                 int width,
+                                 int height,
+                                 int start_line,
+                                 int total_lines,
                                  float *rect1,
                                  float *rect2,
                                  float *out)
 {
   WipeZone wipezone;
   WipeVars *wipe = (WipeVars *)seq->effectdata;
-  int xo, yo;
+  int x, y;
   float *rt1, *rt2, *rt;
 
-  precalc_wipe_zone(&wipezone, wipe, x, y);
+  /* The zone is defined for the whole image, the slice only covers some of its lines. */
+  precalc_wipe_zone(&wipezone, wipe, width, height);
 
   rt1 = rect1;
   rt2 = rect2;
   rt = out;
 
-  xo = x;
-  yo = y;
-  for (y = 0; y < yo; y++) {
-    for (x = 0; x < xo; x++) {
+  for (y = start_line; y < start_line + total_lines; y++) {
+    for (x = 0; x < width; x++) {
       float check = check_zone(&wipezone, x, y, seq, facf0);
       if (check) {
         if (rt1) {
@@ -2311,39 +2312,50 @@ static void do_wipe_effect_float(Sequence *seq,
   }
 }
 
-static ImBuf *do_wipe_effect(const SeqRenderData *context,
-                             Sequence *seq,
-                             float UNUSED(timeline_frame),
-                             float facf0,
-                             float facf1,
-                             ImBuf *ibuf1,
-                             ImBuf *ibuf2,
-                             ImBuf *ibuf3)
+static void do_wipe_effect(const SeqRenderData *context,
+                           Sequence *seq,
+                           float UNUSED(timeline_frame),
+                           float facf0,
+                           float UNUSED(facf1),
+                           ImBuf *ibuf1,
+                           ImBuf *ibuf2,
+                           ImBuf *UNUSED(ibuf3),
+                           int start_line,
+                           int total_lines,
+                           ImBuf *out)
 {
-  ImBuf *out = prepare_effect_imbufs(context, ibuf1, ibuf2, ibuf3);
-
   if (out->rect_float) {
+    float *rect1 = NULL, *rect2 = NULL, *rect_out = NULL;
+
+    slice_get_float_buffers(
+        context, ibuf1, ibuf2, NULL, out, start_line, &rect1, &rect2, NULL, &rect_out);
+
     do_wipe_effect_float(seq,
                          facf0,
-                         facf1,
                          context->rectx,
                          context->recty,
-                         ibuf1->rect_float,
-                         ibuf2->rect_float,
-                         out->rect_float);
+                         start_line,
+                         total_lines,
+                         rect1,
+                         rect2,
+                         rect_out);
   }
   else {
+    unsigned char *rect1 = NULL, *rect2 = NULL, *rect_out = NULL;
+
+    slice_get_byte_buffers(
+        context, ibuf1, ibuf2, NULL, out, start_line, &rect1, &rect2, NULL, &rect_out);
+
     do_wipe_effect_byte(seq,
                         facf0,
-                        facf1,
                         context->rectx,
                         context->recty,
-                        (unsigned char *)ibuf1->rect,
-                        (unsigned char *)ibuf2->rect,
-                        (unsigned char *)out->rect);
+                        start_line,
+                        total_lines,
+                        rect1,
+                        rect2,
+                        rect_out);
   }
-
-  return out;
 }
 
 /*********************** Transform *************************/
@@ -2498,6 +2510,118 @@ static void do_transform_effect(const SeqRenderData *context,
 
 /*********************** Glow *************************/
 
+typedef struct GlowBlurData {
+  const float *src;
+  float *dst;
+  const float *filter;
+  int width, height;
+  int half_width;
+} GlowBlurData;
+
+static void glow_blur_rows_task(void *__restrict userdata,
+                                const int y,
+                                const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const GlowBlurData *data = userdata;
+  const float *map = data->src;
+  float *temp = data->dst;
+  const float *filter = data->filter;
+  const int width = data->width;
+  const int halfWidth = data->half_width;
+  int x, i, fx, index;
+  float curColor[4], curColor2[4];
+
+  /* Do the left & right strips, not going past the row for small images. */
+  const int strip_width = min_ii(halfWidth, width);
+  for (x = 0; x < strip_width; x++) {
+    fx = 0;
+    zero_v4(curColor);
+    zero_v4(curColor2);
+
+    for (i = x - halfWidth; i < x + halfWidth; i++) {
+      if ((i >= 0) && (i < width)) {
+        index = (i + y * width) * 4;
+        madd_v4_v4fl(curColor, map + index, filter[fx]);
+
+        index = (width - 1 - i + y * width) * 4;
+        madd_v4_v4fl(curColor2, map + index, filter[fx]);
+      }
+      fx++;
+    }
+    index = (x + y * width) * 4;
+    copy_v4_v4(temp + index, curColor);
+
+    index = (width - 1 - x + y * width) * 4;
+    copy_v4_v4(temp + index, curColor2);
+  }
+
+  /* Do the main body */
+  for (x = halfWidth; x < width - halfWidth; x++) {
+    fx = 0;
+    zero_v4(curColor);
+    for (i = x - halfWidth; i < x + halfWidth; i++) {
+      index = (i + y * width) * 4;
+      madd_v4_v4fl(curColor, map + index, filter[fx]);
+      fx++;
+    }
+    index = (x + y * width) * 4;
+    copy_v4_v4(temp + index, curColor);
+  }
+}
+
+static void glow_blur_columns_task(void *__restrict userdata,
+                                   const int x,
+                                   const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const GlowBlurData *data = userdata;
+  const float *map = data->src;
+  float *temp = data->dst;
+  const float *filter = data->filter;
+  const int width = data->width;
+  const int height = data->height;
+  const int halfWidth = data->half_width;
+  int y, i, fy, index;
+  float curColor[4], curColor2[4];
+
+  /* Do the top & bottom strips, not going past the column for small images. */
+  const int strip_height = min_ii(halfWidth, height);
+  for (y = 0; y < strip_height; y++) {
+    fy = 0;
+    zero_v4(curColor);
+    zero_v4(curColor2);
+    for (i = y - halfWidth; i < y + halfWidth; i++) {
+      if ((i >= 0) && (i < height)) {
+        /* Bottom */
+        index = (x + i * width) * 4;
+        madd_v4_v4fl(curColor, map + index, filter[fy]);
+
+        /* Top */
+        index = (x + (height - 1 - i) * width) * 4;
+        madd_v4_v4fl(curColor2, map + index, filter[fy]);
+      }
+      fy++;
+    }
+    index = (x + y * width) * 4;
+    copy_v4_v4(temp + index, curColor);
+
+    index = (x + (height - 1 - y) * width) * 4;
+    copy_v4_v4(temp + index, curColor2);
+  }
+
+  /* Do the main body */
+  for (y = halfWidth; y < height - halfWidth; y++) {
+    fy = 0;
+    zero_v4(curColor);
+    for (i = y - halfWidth; i < y + halfWidth; i++) {
+      index = (x + i * width) * 4;
+      madd_v4_v4fl(curColor, map + index, filter[fy]);
+      fy++;
+    }
+    index = (x + y * width) * 4;
+    copy_v4_v4(temp + index, curColor);
+  }
+}
+
 static void RVBlurBitmap2_float(float *map, int width, int height, float blur, int quality)
 {
   /* Much better than the previous blur!
@@ -2507,11 +2631,10 @@ static void RVBlurBitmap2_float(float *map, int width, int height, float blur, i
    * Watch out though, it tends to misbehave with large blur values on
    * a small bitmap. Avoid avoid! */
 
-  float *temp = NULL, *swap;
+  float *temp = NULL;
   float *filter = NULL;
-  int x, y, i, fx, fy;
-  int index, ix, halfWidth;
-  float fval, k, curColor[4], curColor2[4], weight = 0;
+  int ix, halfWidth;
+  float fval, k, weight = 0;
 
   /* If we're not really blurring, bail out */
   if (blur <= 0) {
@@ -2556,93 +2679,26 @@ static void RVBlurBitmap2_float(float *map, int width, int height, float blur, i
     filter[ix] /= fval;
   }
 
-  /* Blur the rows */
-  for (y = 0; y < height; y++) {
-    /* Do the left & right strips */
-    for (x = 0; x < halfWidth; x++) {
-      fx = 0;
-      zero_v4(curColor);
-      zero_v4(curColor2);
-
-      for (i = x - halfWidth; i < x + halfWidth; i++) {
-        if ((i >= 0) && (i < width)) {
-          index = (i + y * width) * 4;
-          madd_v4_v4fl(curColor, map + index, filter[fx]);
-
-          index = (width - 1 - i + y * width) * 4;
-          madd_v4_v4fl(curColor2, map + index, filter[fx]);
-        }
-        fx++;
-      }
-      index = (x + y * width) * 4;
-      copy_v4_v4(temp + index, curColor);
-
-      index = (width - 1 - x + y * width) * 4;
-      copy_v4_v4(temp + index, curColor2);
-    }
-
-    /* Do the main body */
-    for (x = halfWidth; x < width - halfWidth; x++) {
-      fx = 0;
-      zero_v4(curColor);
-      for (i = x - halfWidth; i < x + halfWidth; i++) {
-        index = (i + y * width) * 4;
-        madd_v4_v4fl(curColor, map + index, filter[fx]);
-        fx++;
-      }
-      index = (x + y * width) * 4;
-      copy_v4_v4(temp + index, curColor);
-    }
-  }
-
-  /* Swap buffers */
-  swap = temp;
-  temp = map;
-  map = swap;
-
-  /* Blur the columns */
-  for (x = 0; x < width; x++) {
-    /* Do the top & bottom strips */
-    for (y = 0; y < halfWidth; y++) {
-      fy = 0;
-      zero_v4(curColor);
-      zero_v4(curColor2);
-      for (i = y - halfWidth; i < y + halfWidth; i++) {
-        if ((i >= 0) && (i < height)) {
-          /* Bottom */
-          index = (x + i * width) * 4;
-          madd_v4_v4fl(curColor, map + index, filter[fy]);
-
-          /* Top */
-          index = (x + (height - 1 - i) * width) * 4;
-          madd_v4_v4fl(curColor2, map + index, filter[fy]);
-        }
-        fy++;
-      }
-      index = (x + y * width) * 4;
-      copy_v4_v4(temp + index, curColor);
+  /* Blur the rows into the temporary map, then the columns back into the map. Rows and columns
+   * are independent of each other, so they are blurred in parallel. */
+  GlowBlurData data = {
+      .src = map,
+      .dst = temp,
+      .filter = filter,
+      .width = width,
+      .height = height,
+      .half_width = halfWidth,
+  };
 
-      index = (x + (height - 1 - y) * width) * 4;
-      copy_v4_v4(temp + index, curColor2);
-    }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.min_iter_per_thread = 8;
 
-    /* Do the main body */
-    for (y = halfWidth; y < height - halfWidth; y++) {
-      fy = 0;
-      zero_v4(curColor);
-      for (i = y - halfWidth; i < y + halfWidth; i++) {
-        index = (x + i * width) * 4;
-        madd_v4_v4fl(curColor, map + index, filter[fy]);
-        fy++;
-      }
-      index = (x + y * width) * 4;
-      copy_v4_v4(temp + index, curColor);
-    }
-  }
+  BLI_task_parallel_range(0, height, &data, glow_blur_rows_task, &settings);
 
-  /* Swap buffers */
-  swap = temp;
-  temp = map; /* map = swap; */ /* UNUSED */
+  data.src = temp;
+  data.dst = map;
+  BLI_task_parallel_range(0, width, &data, glow_blur_columns_task, &settings);
 
   /* Tidy up. */
   MEM_freeN(filter);
@@ -3847,6 +3903,10 @@ static int early_out_text(Sequence *seq, float UNUSED(facf0), float UNUSED(facf1
   return EARLY_NO_INPUT;
 }
 
+/* Fonts are shared by all text strips using them, and the buffer drawing state is stored in the
+ * font. Prefetching renders multiple frames at the same time, so drawing must be serialized. */
+static ThreadMutex text_effect_mutex = BLI_MUTEX_INITIALIZER;
+
 static ImBuf *do_text_effect(const SeqRenderData *context,
                              Sequence *seq,
                              float UNUSED(timeline_frame),
@@ -3867,6 +3927,8 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
   int y_ofs, x, y;
   double proxy_size_comp;
 
+  BLI_mutex_lock(&text_effect_mutex);
+
   if (data->text_blf_id == SEQ_FONT_NOT_LOADED) {
     data->text_blf_id = -1;
 
@@ -3965,6 +4027,8 @@ static ImBuf *do_text_effect(const SeqRenderData *context,
 
   BLF_disable(font, font_flags);
 
+  BLI_mutex_unlock(&text_effect_mutex);
+
   return out;
 }
 
@@ -4148,7 +4212,8 @@ static struct SeqEffectHandle get_sequence_effect_impl(int seq_type)
       rval.copy = copy_wipe_effect;
       rval.early_out = early_out_fade;
       rval.get_default_fac = get_default_fac_fade;
-      rval.execute = do_wipe_effect;
+      rval.multithreaded = true;
+      rval.execute_slice = do_wipe_effect;
       break;
     case SEQ_TYPE_GLOW:
       rval.init = init_glow_effect;
@@ -24,6 +24,7 @@
 #include <stddef.h>
 #include <time.h>
 
+#include "MEM_CacheLimiterC-Api.h"
 #include "MEM_guardedalloc.h"
 
 #include "DNA_scene_types.h"
@@ -33,6 +34,7 @@
 #include "IMB_colormanagement.h"
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
+#include "IMB_moviecache.h"
 
 #include "BLI_blenlib.h"
 #include "BLI_endian_defines.h"
@@ -40,6 +42,7 @@
 #include "BLI_fileops.h"
 #include "BLI_fileops_types.h"
 #include "BLI_ghash.h"
+#include "BLI_linklist.h"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
 #include "BLI_path_util.h"
@@ -74,15 +77,22 @@
  * Entries are linked in order as they are put into cache.
  * Only permanent (is_temp_cache = 0) cache entries are linked.
  * Putting #SEQ_CACHE_STORE_FINAL_OUT will reset linking
+ * Every render task (main render and each prefetch worker) has its own chain, so frames rendered
+ * at the same time are not linked together.
  *
  * Only entire frame can be freed to release resources for new entries (recycling).
  * Once again, this is to reduce number of iterations, but also more controllable than removing
  * entries one by one in reverse order to their creation.
  *
  * User can exclude caching of some images. Such entries will have is_temp_cache set.
+ *
+ * Locking: All render tasks share the cache, so the lock is held as briefly as possible. Images
+ * removed from the cache are only freed once the lock is released, releasing large buffers is
+ * slow and does not need to block other tasks.
  */
 
 #define THUMB_CACHE_LIMIT 5000
+#define SEQ_CACHE_TASKS_NUM (SEQ_TASK_PREFETCH_RENDER + SEQ_PREFETCH_MAX_WORKERS)
 
 typedef struct SeqCache {
   Main *bmain;
@@ -90,14 +100,18 @@ typedef struct SeqCache {
   ThreadMutex iterator_mutex;
   struct BLI_mempool *keys_pool;
   struct BLI_mempool *items_pool;
-  struct SeqCacheKey *last_key;
+  struct SeqCacheKey *last_key[SEQ_CACHE_TASKS_NUM];
   struct SeqDiskCache *disk_cache;
   int thumbnail_count;
+  /* Images removed from the cache while locked, freed when unlocking. */
+  struct LinkNode *ibufs_to_free;
 } SeqCache;
 
 typedef struct SeqCacheItem {
   struct SeqCache *cache_owner;
   struct ImBuf *ibuf;
+  /* Memory accounted for the image in the shared cache limit. */
+  size_t ibuf_size;
 } SeqCacheItem;
 
 static ThreadMutex cache_create_lock = BLI_MUTEX_INITIALIZER;
@@ -181,12 +195,28 @@ static void seq_cache_lock(Scene *scene)
   }
 }
 
+static void seq_cache_free_pending_ibufs(LinkNode *ibufs_to_free)
+{
+  BLI_linklist_free(ibufs_to_free, (LinkNodeFreeFP)IMB_freeImBuf);
+}
+
 static void seq_cache_unlock(Scene *scene)
 {
   SeqCache *cache = seq_cache_get_from_scene(scene);
 
   if (cache) {
+    LinkNode *ibufs_to_free = cache->ibufs_to_free;
+    cache->ibufs_to_free = NULL;
     BLI_mutex_unlock(&cache->iterator_mutex);
+
+    seq_cache_free_pending_ibufs(ibufs_to_free);
+  }
+}
+
+static void seq_cache_reset_linking(SeqCache *cache)
+{
+  for (int i = 0; i < SEQ_CACHE_TASKS_NUM; i++) {
+    cache->last_key[i] = NULL;
   }
 }
 
@@ -195,6 +225,7 @@ static size_t seq_cache_get_mem_total(void)
   return ((size_t)U.memcachelimit) * 1024 * 1024;
 }
 
+
 static void seq_cache_keyfree(void *val)
 {
   SeqCacheKey *key = val;
@@ -204,12 +235,14 @@ static void seq_cache_keyfree(void *val)
 static void seq_cache_valfree(void *val)
 {
   SeqCacheItem *item = (SeqCacheItem *)val;
+  SeqCache *cache = item->cache_owner;
 
   if (item->ibuf) {
-    IMB_freeImBuf(item->ibuf);
+    MEM_CacheLimiter_external_memory_sub(item->ibuf_size);
+    BLI_linklist_prepend(&cache->ibufs_to_free, item->ibuf);
   }
 
-  BLI_mempool_free(item->cache_owner->items_pool, item);
+  BLI_mempool_free(cache->items_pool, item);
 }
 
 static int get_stored_types_flag(Scene *scene, SeqCacheKey *key)
@@ -235,36 +268,39 @@ static void seq_cache_put_ex(Scene *scene, SeqCacheKey *key, ImBuf *ibuf)
   item = BLI_mempool_alloc(cache->items_pool);
   item->cache_owner = cache;
   item->ibuf = ibuf;
+  item->ibuf_size = ibuf ? IMB_get_size_in_memory(ibuf) : 0;
+  MEM_CacheLimiter_external_memory_add(item->ibuf_size);
 
   const int stored_types_flag = get_stored_types_flag(scene, key);
+  SeqCacheKey **last_key = &cache->last_key[key->task_id];
 
   /* Item stored for later use. */
   if (stored_types_flag & key->type) {
     key->is_temp_cache = false;
-    key->link_prev = cache->last_key;
+    key->link_prev = *last_key;
   }
 
   /* Store pointer to last cached key. */
-  SeqCacheKey *temp_last_key = cache->last_key;
+  SeqCacheKey *temp_last_key = *last_key;
 
   if (BLI_ghash_reinsert(cache->hash, key, item, seq_cache_keyfree, seq_cache_valfree)) {
     IMB_refImBuf(ibuf);
 
     if (!key->is_temp_cache || key->type != SEQ_CACHE_STORE_THUMBNAIL) {
-      cache->last_key = key;
+      *last_key = key;
     }
   }
 
   /* Set last_key's reference to this key so we can look up chain backwards.
-   * Item is already put in cache, so cache->last_key points to current key.
+   * Item is already put in cache, so last_key points to current key.
    */
   if (!key->is_temp_cache && temp_last_key) {
-    temp_last_key->link_next = cache->last_key;
+    temp_last_key->link_next = *last_key;
   }
 
   /* Reset linking. */
   if (key->type == SEQ_CACHE_STORE_FINAL_OUT) {
-    cache->last_key = NULL;
+    *last_key = NULL;
   }
 }
 
@@ -512,7 +548,7 @@ static void seq_cache_create(Main *bmain, Scene *scene)
     cache->keys_pool = BLI_mempool_create(sizeof(SeqCacheKey), 0, 64, BLI_MEMPOOL_NOP);
     cache->items_pool = BLI_mempool_create(sizeof(SeqCacheItem), 0, 64, BLI_MEMPOOL_NOP);
     cache->hash = BLI_ghash_new(seq_cache_hashhash, seq_cache_hashcmp, "SeqCache hash");
-    cache->last_key = NULL;
+    seq_cache_reset_linking(cache);
     cache->bmain = bmain;
     cache->thumbnail_count = 0;
     BLI_mutex_init(&cache->iterator_mutex);
@@ -592,6 +628,7 @@ void seq_cache_destruct(Scene *scene)
   }
 
   BLI_ghash_free(cache->hash, seq_cache_keyfree, seq_cache_valfree);
+  seq_cache_free_pending_ibufs(cache->ibufs_to_free);
   BLI_mempool_destroy(cache->keys_pool);
   BLI_mempool_destroy(cache->items_pool);
   BLI_mutex_end(&cache->iterator_mutex);
@@ -629,7 +666,7 @@ void SEQ_cache_cleanup(Scene *scene)
     BLI_ghashIterator_step(&gh_iter);
     BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
   }
-  cache->last_key = NULL;
+  seq_cache_reset_linking(cache);
   cache->thumbnail_count = 0;
   seq_cache_unlock(scene);
 }
@@ -694,7 +731,7 @@ void seq_cache_cleanup_sequence(Scene *scene,
       BLI_ghash_remove(cache->hash, key, seq_cache_keyfree, seq_cache_valfree);
     }
   }
-  cache->last_key = NULL;
+  seq_cache_reset_linking(cache);
   seq_cache_unlock(scene);
 }
 
@@ -735,7 +772,7 @@ void seq_cache_thumbnail_cleanup(Scene *scene, rctf *view_area_safe)
       cache->thumbnail_count--;
     }
   }
-  cache->last_key = NULL;
+  seq_cache_reset_linking(cache);
 }
 
 struct ImBuf *seq_cache_get(const SeqRenderData *context,
@@ -794,8 +831,13 @@ struct ImBuf *seq_cache_get(const SeqRenderData *context,
 
     /* Store read image in RAM. Only recycle item for final type. */
     if (key.type != SEQ_CACHE_STORE_FINAL_OUT || seq_cache_recycle_item(scene)) {
-      SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
-      seq_cache_put_ex(scene, new_key, ibuf);
+      seq_cache_lock(scene);
+      /* Another task may have read the same image in the meantime. */
+      if (!BLI_ghash_haskey(cache->hash, &key)) {
+        SeqCacheKey *new_key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+        seq_cache_put_ex(scene, new_key, ibuf);
+      }
+      seq_cache_unlock(scene);
     }
   }
 
@@ -822,8 +864,11 @@ bool seq_cache_put_if_possible(
     return true;
   }
 
-  seq_cache_set_temp_cache_linked(scene, scene->ed->cache->last_key);
-  scene->ed->cache->last_key = NULL;
+  SeqCache *cache = seq_cache_get_from_scene(scene);
+  seq_cache_lock(scene);
+  seq_cache_set_temp_cache_linked(scene, cache->last_key[context->task_id]);
+  cache->last_key[context->task_id] = NULL;
+  seq_cache_unlock(scene);
   return false;
 }
 
@@ -888,6 +933,14 @@ void seq_cache_put(
   seq_cache_lock(scene);
   SeqCache *cache = seq_cache_get_from_scene(scene);
   SeqCacheKey *key = seq_cache_allocate_key(cache, context, seq, timeline_frame, type);
+
+  /* Another task may have put the same image in the meantime. */
+  if (BLI_ghash_haskey(cache->hash, key)) {
+    BLI_mempool_free(cache->keys_pool, key);
+    seq_cache_unlock(scene);
+    return;
+  }
+
   seq_cache_put_ex(scene, key, i);
   seq_cache_unlock(scene);
 
@@ -927,11 +980,18 @@ void SEQ_cache_iterate(
     interrupt = callback_iter(userdata, key->seq, key->timeline_frame, key->type);
   }
 
-  cache->last_key = NULL;
+  seq_cache_reset_linking(cache);
   seq_cache_unlock(scene);
 }
 
+/**
+ * The sequencer cache shares its limit with the movie caches of images and clips and with other
+ * caches accounted with #MEM_CacheLimiter_external_memory_add, rather than comparing with all
+ * memory in use. Images removed from the cache are not counted even while they are waiting to
+ * be freed.
+ */
 bool seq_cache_is_full(void)
 {
-  return seq_cache_get_mem_total() < MEM_get_memory_in_use();
+  return seq_cache_get_mem_total() <
+         IMB_moviecache_get_memory_in_use() + MEM_CacheLimiter_get_external_memory_in_use();
 }
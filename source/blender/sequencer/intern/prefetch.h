@@ -35,6 +35,10 @@ struct Sequence;
 }
 #endif
 
+/* Upper limit of frames rendered at the same time. Every worker renders frames in its own
+ * thread, using its own copy of the scene. */
+#define SEQ_PREFETCH_MAX_WORKERS 8
+
 void seq_prefetch_start(const struct SeqRenderData *context, float timeline_frame);
 void seq_prefetch_free(struct Scene *scene);
 bool seq_prefetch_job_is_running(struct Scene *scene);
@@ -32,6 +32,7 @@
 #include "DNA_mask_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
+#include "DNA_userdef_types.h"
 
 #include "BLI_blenlib.h"
 
@@ -289,6 +290,14 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
   /* reset all the previously created anims */
   SEQ_relations_sequence_free_anim(seq);
 
+  int anim_flags = IB_rect;
+  if (seq->flag & SEQ_FILTERY) {
+    anim_flags |= IB_animdeinterlace;
+  }
+  if (U.video_decode_flag & USER_VIDEO_DECODE_HARDWARE) {
+    anim_flags |= IB_animhwdecode;
+  }
+
   BLI_join_dirfile(name, sizeof(name), seq->strip->dir, seq->strip->stripdata->name);
   BLI_path_abs(name, BKE_main_blendfile_path_from_global());
 
@@ -332,14 +341,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
         if (openfile) {
           sanim->anim = openanim(str,
-                                 IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                 anim_flags,
                                  seq->streamindex,
                                  seq->strip->colorspace_settings.name);
         }
         else {
           sanim->anim = openanim_noload(str,
-                                        IB_rect |
-                                            ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                        anim_flags,
                                         seq->streamindex,
                                         seq->strip->colorspace_settings.name);
         }
@@ -351,14 +359,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
         else {
           if (openfile) {
             sanim->anim = openanim(name,
-                                   IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                   anim_flags,
                                    seq->streamindex,
                                    seq->strip->colorspace_settings.name);
           }
           else {
             sanim->anim = openanim_noload(name,
-                                          IB_rect |
-                                              ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                          anim_flags,
                                           seq->streamindex,
                                           seq->strip->colorspace_settings.name);
           }
@@ -383,13 +390,13 @@ void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
     if (openfile) {
       sanim->anim = openanim(name,
-                             IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                             anim_flags,
                              seq->streamindex,
                              seq->strip->colorspace_settings.name);
     }
     else {
       sanim->anim = openanim_noload(name,
-                                    IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+                                    anim_flags,
                                     seq->streamindex,
                                     seq->strip->colorspace_settings.name);
     }
@@ -34,6 +34,7 @@
 #  include "DNA_texture_types.h"
 
 #  include "BLI_math.h"
+#  include "BLI_task.h"
 #  include "BLI_utildefines.h"
 
 #  include "BKE_cloth.h"
@@ -46,9 +47,10 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+/* Number of vertices from which the solver operations on long vectors are multi-threaded. */
+#  define CLOTH_PARALLEL_LIMIT 1024
+/* Number of vertices summed by one task in a dot product of long vectors. */
+#  define CLOTH_DOT_BLOCK_SIZE 1024
 
 //#define DEBUG_TIME
 
@@ -192,21 +194,60 @@ DO_INLINE void submul_lfvectorS(float (*to)[3],
     VECSUBMUL(to[i], fLongVector[i], scalar);
   }
 }
+typedef struct DotLongVectorData {
+  float (*fLongVectorA)[3];
+  float (*fLongVectorB)[3];
+  unsigned int verts;
+  /** Sum of each block of #CLOTH_DOT_BLOCK_SIZE vertices. */
+  float *block_sums;
+} DotLongVectorData;
+
+static void dot_lfvector_block_fn(void *__restrict userdata,
+                                  const int block,
+                                  const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  DotLongVectorData *data = userdata;
+  const unsigned int start = (unsigned int)block * CLOTH_DOT_BLOCK_SIZE;
+  const unsigned int end = MIN2(start + CLOTH_DOT_BLOCK_SIZE, data->verts);
+  float temp = 0.0f;
+  for (unsigned int i = start; i < end; i++) {
+    temp += dot_v3v3(data->fLongVectorA[i], data->fLongVectorB[i]);
+  }
+  data->block_sums[block] = temp;
+}
+
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3],
                              float (*fLongVectorB)[3],
                              unsigned int verts)
 {
-  long i = 0;
   float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  //#pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < (long)verts; i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  if (verts <= CLOTH_DOT_BLOCK_SIZE) {
+    for (unsigned int i = 0; i < verts; i++) {
+      temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+    }
+    return temp;
+  }
+
+  /* Floating point addition isn't associative, a reduction over threads would make the
+   * simulation give different results each time it runs. Blocks of a fixed size are summed in
+   * parallel instead, and the block sums are added in order. */
+  const int blocks_num = (int)((verts + CLOTH_DOT_BLOCK_SIZE - 1) / CLOTH_DOT_BLOCK_SIZE);
+  DotLongVectorData data = {
+      .fLongVectorA = fLongVectorA,
+      .fLongVectorB = fLongVectorB,
+      .verts = verts,
+      .block_sums = MEM_mallocN(sizeof(float) * (size_t)blocks_num, __func__),
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  BLI_task_parallel_range(0, blocks_num, &data, dot_lfvector_block_fn, &settings);
+
+  for (int block = 0; block < blocks_num; block++) {
+    temp += data.block_sums[block];
   }
+  MEM_freeN(data.block_sums);
   return temp;
 }
 /* `A = B + C` -> for big vector. */
@@ -613,35 +654,114 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/**
+ * The off-diagonal blocks of big matrices touching each vertex, so a big matrix can be
+ * multiplied with a long vector one row at a time without threads writing to the same vertex.
+ * All big matrices of the solver share the layout of their blocks.
+ */
+typedef struct fmatrixRows {
+  /** Start of the entries of each vertex, `vcount + 1` items. */
+  unsigned int *offsets;
+  /**
+   * Block index shifted left by one, the lowest bit is set when the transposed block contributes
+   * to the row (the block is in the lower triangle for that vertex), `2 * scount` items.
+   */
+  unsigned int *entries;
+} fmatrixRows;
+
+static void create_bfmatrix_rows(fmatrixRows *rows, unsigned int verts, unsigned int springs)
 {
-  unsigned int vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  rows->offsets = MEM_mallocN(sizeof(*rows->offsets) * (verts + 1), "cloth_implicit_rows");
+  rows->entries = MEM_mallocN(sizeof(*rows->entries) * (2 * springs + 1), "cloth_implicit_rows");
+}
 
-  zero_lfvector(to, vcount);
+static void del_bfmatrix_rows(fmatrixRows *rows)
+{
+  MEM_freeN(rows->offsets);
+  MEM_freeN(rows->entries);
+}
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (unsigned int i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed submatrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
+/* Gather the off-diagonal blocks per row, in order of the blocks. */
+static void build_bfmatrix_rows(fmatrixRows *rows, const fmatrix3x3 *matrix, int num_blocks)
+{
+  const unsigned int vcount = matrix[0].vcount;
+  unsigned int *offsets = rows->offsets;
+  unsigned int total = 0;
+
+  memset(offsets, 0, sizeof(*offsets) * (vcount + 1));
+  for (unsigned int b = vcount; b < vcount + (unsigned int)num_blocks; b++) {
+    offsets[matrix[b].r]++;
+    offsets[matrix[b].c]++;
+  }
+  for (unsigned int i = 0; i < vcount; i++) {
+    const unsigned int count = offsets[i];
+    offsets[i] = total;
+    total += count;
+  }
+  offsets[vcount] = total;
+
+  for (unsigned int b = vcount; b < vcount + (unsigned int)num_blocks; b++) {
+    rows->entries[offsets[matrix[b].r]++] = b << 1;
+    rows->entries[offsets[matrix[b].c]++] = (b << 1) | 1;
+  }
+  /* Each offset is at the start of the next row now. */
+  memmove(offsets + 1, offsets, sizeof(*offsets) * vcount);
+  offsets[0] = 0;
+}
+
+typedef struct MulBigMatrixData {
+  float (*to)[3];
+  const fmatrix3x3 *from;
+  const fmatrixRows *rows;
+  const lfVector *fLongVector;
+} MulBigMatrixData;
+
+static void mul_bfmatrix_lfvector_row_fn(void *__restrict userdata,
+                                         const int i,
+                                         const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const MulBigMatrixData *data = userdata;
+  const fmatrix3x3 *from = data->from;
+  const lfVector *fLongVector = data->fLongVector;
+  float *to = data->to[i];
+
+  /* The vertex part of the matrix is diagonal blocks. */
+  mul_fmatrix_fvector(to, from[i].m, fLongVector[i]);
+
+  for (unsigned int j = data->rows->offsets[i]; j < data->rows->offsets[i + 1]; j++) {
+    const unsigned int entry = data->rows->entries[j];
+    const fmatrix3x3 *block = &from[entry >> 1];
+    if (entry & 1) {
+      /* This is the lower triangle of the sparse matrix,
+       * therefore multiplication occurs with transposed submatrices. */
+      muladd_fmatrixT_fvector(to, block->m, fLongVector[block->r]);
     }
-#  pragma omp section
-    {
-      for (unsigned int i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
+    else {
+      muladd_fmatrix_fvector(to, block->m, fLongVector[block->c]);
     }
   }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+}
 
-  del_lfvector(temp);
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     const fmatrix3x3 *from,
+                                     const fmatrixRows *rows,
+                                     const lfVector *fLongVector)
+{
+  const unsigned int vcount = from[0].vcount;
+  MulBigMatrixData data = {
+      .to = to,
+      .from = from,
+      .rows = rows,
+      .fLongVector = fLongVector,
+  };
+
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = 256;
+  BLI_task_parallel_range(0, (int)vcount, &data, mul_bfmatrix_lfvector_row_fn, &settings);
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -683,6 +803,8 @@ typedef struct Implicit_Data {
   lfVector *z;          /* target velocity in constrained directions */
   fmatrix3x3 *S;        /* filtering matrix for constraints */
   fmatrix3x3 *P, *Pinv; /* pre-conditioning matrix */
+
+  fmatrixRows rows; /* off-diagonal blocks per vertex, for multiplication */
 } Implicit_Data;
 
 Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
@@ -707,6 +829,7 @@ Implicit_Data *SIM_mass_spring_solver_create(int numverts, int numsprings)
   id->B = create_lfvector(numverts);
   id->dV = create_lfvector(numverts);
   id->z = create_lfvector(numverts);
+  create_bfmatrix_rows(&id->rows, numverts, numsprings);
 
   initdiag_bfmatrix(id->bigI, I);
 
@@ -733,6 +856,7 @@ void SIM_mass_spring_solver_free(Implicit_Data *id)
   del_lfvector(id->B);
   del_lfvector(id->dV);
   del_lfvector(id->z);
+  del_bfmatrix_rows(&id->rows);
 
   MEM_freeN(id);
 }
@@ -771,13 +895,31 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 /* ================================ */
 
+typedef struct FilterData {
+  lfVector *V;
+  fmatrix3x3 *S;
+} FilterData;
+
+static void filter_fn(void *__restrict userdata,
+                      const int i,
+                      const TaskParallelTLS *__restrict UNUSED(tls))
+{
+  const FilterData *data = userdata;
+  mul_m3_v3(data->S[i].m, data->V[data->S[i].r]);
+}
+
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  unsigned int i = 0;
+  FilterData data = {
+      .V = V,
+      .S = S,
+  };
 
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+  TaskParallelSettings settings;
+  BLI_parallel_range_settings_defaults(&settings);
+  settings.use_threading = S[0].vcount > CLOTH_PARALLEL_LIMIT;
+  settings.min_iter_per_thread = 1024;
+  BLI_task_parallel_range(0, (int)S[0].vcount, &data, filter_fn, &settings);
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -852,6 +994,7 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const fmatrixRows *rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
@@ -879,7 +1022,7 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
@@ -902,7 +1045,7 @@ static int cg_filtered(lfVector *ldV,
 #  endif
 
   while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+    mul_bfmatrix_lfvector(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -1162,7 +1305,9 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  build_bfmatrix_rows(&data->rows, data->A, data->num_blocks);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, &data->rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1171,7 +1316,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, &data->rows, data->B, data->z, data->S, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
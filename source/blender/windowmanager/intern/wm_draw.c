@@ -40,6 +40,7 @@
 #include "BLI_utildefines.h"
 
 #include "BKE_context.h"
+#include "BKE_global.h"
 #include "BKE_image.h"
 #include "BKE_main.h"
 #include "BKE_scene.h"
@@ -60,6 +61,8 @@
 #include "GPU_texture.h"
 #include "GPU_viewport.h"
 
+#include "PIL_time.h"
+
 #include "RE_engine.h"
 
 #include "WM_api.h"
@@ -652,6 +655,55 @@ GPUViewport *WM_draw_region_get_bound_viewport(ARegion *region)
   return viewport;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Deferred Region Redraws
+ *
+ * While transforming, every change tags many regions for redraw (outliner, timeline, node
+ * editors, ...). Slow regions outside of the region the user interacts with are only redrawn a
+ * few times per second then, so they don't slow down the interactive feedback.
+ * \{ */
+
+/** Regions drawing faster than this (in seconds) are never deferred. */
+#define WM_DRAW_REGION_DEFER_TIME_MIN 0.005
+/** Deferred regions are still redrawn after this interval (in seconds). */
+#define WM_DRAW_REGION_DEFER_INTERVAL 0.2
+
+static bool wm_draw_region_defer(const bScreen *screen,
+                                 const ARegion *region,
+                                 const bool stereo,
+                                 const double time)
+{
+  if (G.moving == 0 || stereo || region == screen->active_region) {
+    return false;
+  }
+  /* A new layout always has to be drawn. */
+  if (region->type->layout) {
+    return false;
+  }
+  if (region->runtime.draw_time < WM_DRAW_REGION_DEFER_TIME_MIN) {
+    return false;
+  }
+  /* The previous drawing can only be reused if the buffer still matches the region size. */
+  const wmDrawBuffer *draw_buffer = region->draw_buffer;
+  if (draw_buffer == NULL || draw_buffer->stereo) {
+    return false;
+  }
+  if (draw_buffer->viewport) {
+    GPUTexture *texture = GPU_viewport_color_texture(draw_buffer->viewport, 0);
+    if (texture == NULL || GPU_texture_width(texture) != region->winx ||
+        GPU_texture_height(texture) != region->winy) {
+      return false;
+    }
+  }
+  else if (GPU_offscreen_width(draw_buffer->offscreen) != region->winx ||
+           GPU_offscreen_height(draw_buffer->offscreen) != region->winy) {
+    return false;
+  }
+  return (time - region->runtime.draw_end_time) < WM_DRAW_REGION_DEFER_INTERVAL;
+}
+
+/** \} */
+
 static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 {
   Main *bmain = CTX_data_main(C);
@@ -695,6 +747,12 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
         continue;
       }
 
+      const double draw_start_time = PIL_check_seconds_timer();
+      if (wm_draw_region_defer(screen, region, stereo, draw_start_time)) {
+        /* Keep `do_draw` set, so the region is redrawn later. */
+        continue;
+      }
+
       CTX_wm_region_set(C, region);
       bool use_viewport = WM_region_use_viewport(area, region);
 
@@ -731,6 +789,9 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 
       GPU_debug_group_end();
 
+      region->runtime.draw_end_time = PIL_check_seconds_timer();
+      region->runtime.draw_time = (float)(region->runtime.draw_end_time - draw_start_time);
+
       region->do_draw = false;
       CTX_wm_region_set(C, NULL);
     }
@@ -1936,6 +1936,57 @@ static void wm_autosave_location(char *filepath)
   BLI_join_dirfile(filepath, FILE_MAX, BKE_tempdir_base(), path);
 }
 
+typedef struct AutosaveJob {
+  /** Copy of the undo memfile, so the undo stack can change while writing. */
+  MemFile memfile;
+  char filepath[FILE_MAX];
+} AutosaveJob;
+
+static void wm_autosave_job_startjob(void *customdata,
+                                     short *UNUSED(stop),
+                                     short *UNUSED(do_update),
+                                     float *UNUSED(progress))
+{
+  AutosaveJob *autosave_job = customdata;
+  BLO_memfile_write_file(&autosave_job->memfile, autosave_job->filepath);
+}
+
+static void wm_autosave_job_free(void *customdata)
+{
+  AutosaveJob *autosave_job = customdata;
+  BLO_memfile_free(&autosave_job->memfile);
+  MEM_freeN(autosave_job);
+}
+
+/**
+ * Write a copy of the undo memfile from a job thread, so the UI isn't blocked by file IO.
+ *
+ * \return false when the memfile could not be copied.
+ */
+static bool wm_autosave_write_async(wmWindowManager *wm,
+                                    const MemFile *memfile,
+                                    const char *filepath)
+{
+  wmJob *wm_job = WM_jobs_get(wm, wm->winactive, wm, "Auto Saving...", 0, WM_JOB_TYPE_AUTOSAVE);
+  if (WM_jobs_is_running(wm_job)) {
+    /* The previous auto-save is still being written, skip this one. */
+    return true;
+  }
+
+  AutosaveJob *autosave_job = MEM_callocN(sizeof(AutosaveJob), __func__);
+  if (!BLO_memfile_copy(memfile, &autosave_job->memfile)) {
+    MEM_freeN(autosave_job);
+    return false;
+  }
+  BLI_strncpy(autosave_job->filepath, filepath, sizeof(autosave_job->filepath));
+
+  WM_jobs_customdata_set(wm_job, autosave_job, wm_autosave_job_free);
+  WM_jobs_timer(wm_job, 0.1, 0, 0);
+  WM_jobs_callbacks(wm_job, wm_autosave_job_startjob, NULL, NULL, NULL);
+  WM_jobs_start(wm, wm_job);
+  return true;
+}
+
 static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
 {
   char filepath[FILE_MAX];
@@ -1945,7 +1996,11 @@ static void wm_autosave_write(Main *bmain, wmWindowManager *wm)
   /* Fast save of last undo-buffer, now with UI. */
   const bool use_memfile = (U.uiflag & USER_GLOBALUNDO) != 0;
   MemFile *memfile = use_memfile ? ED_undosys_stack_memfile_get_active(wm->undo_stack) : NULL;
-  if (memfile != NULL) {
+  if (memfile != NULL && USER_EXPERIMENTAL_TEST(&U, use_autosave_async) &&
+      wm_autosave_write_async(wm, memfile, filepath)) {
+    /* Pass. */
+  }
+  else if (memfile != NULL) {
     BLO_memfile_write_file(memfile, filepath);
   }
   else {
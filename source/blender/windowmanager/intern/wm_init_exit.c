@@ -47,6 +47,7 @@
 #include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_timer.h"
+#include "BLI_trace.h"
 #include "BLI_utildefines.h"
 
 #include "BLO_undofile.h"
@@ -637,6 +638,9 @@ void WM_exit_ex(bContext *C, const bool do_python)
 
   DNA_sdna_current_free();
 
+  /* Write the trace started with `--debug-trace` or from Python, no work runs anymore. */
+  BLI_trace_stop();
+
   BLI_threadapi_exit();
   BLI_task_scheduler_exit();
 
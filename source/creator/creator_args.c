@@ -40,7 +40,9 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task.h"
 #  include "BLI_threads.h"
+#  include "BLI_trace.h"
 #  include "BLI_utildefines.h"
 
 #  include "BLO_readfile.h" /* only for BLO_has_bfile_extension */
@@ -516,7 +518,9 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--frame-jump");
   BLI_args_print_arg_doc(ba, "--render-output");
   BLI_args_print_arg_doc(ba, "--engine");
+  BLI_args_print_arg_doc(ba, "--persistent-data");
   BLI_args_print_arg_doc(ba, "--threads");
+  BLI_args_print_arg_doc(ba, "--threads-numa");
 
   printf("\n");
   printf("Format Options:\n");
@@ -579,6 +583,7 @@ static int arg_handle_print_help(int UNUSED(argc), const char **UNUSED(argv), vo
   BLI_args_print_arg_doc(ba, "--debug-cycles");
 #  endif
   BLI_args_print_arg_doc(ba, "--debug-memory");
+  BLI_args_print_arg_doc(ba, "--debug-trace");
   BLI_args_print_arg_doc(ba, "--debug-jobs");
   BLI_args_print_arg_doc(ba, "--debug-python");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph");
@@ -1075,6 +1080,20 @@ static int arg_handle_debug_mode_memory_set(int UNUSED(argc),
   return 0;
 }
 
+static const char arg_handle_debug_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord timed events, such as dependency graph evaluation and drawing,\n"
+    "\tand write them to <filepath> in the Chrome trace format on exit.";
+static int arg_handle_debug_trace_set(int argc, const char **argv, void *UNUSED(data))
+{
+  if (argc > 1) {
+    BLI_trace_start(argv[1]);
+    return 1;
+  }
+  printf("\nError: you must specify a path after '--debug-trace'.\n");
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -1428,6 +1447,29 @@ static int arg_handle_engine_set(int argc, const char **argv, void *data)
   return 0;
 }
 
+static const char arg_handle_persistent_data_set_doc[] =
+    "\n"
+    "\tKeep render data around between frames of an animation render (and between re-renders),\n"
+    "\tso only the changes of each frame have to be synchronized by the render engine.\n"
+    "\tThis increases memory usage.";
+static int arg_handle_persistent_data_set(int UNUSED(argc),
+                                          const char **UNUSED(argv),
+                                          void *data)
+{
+  bContext *C = data;
+  Scene *scene = CTX_data_scene(C);
+  if (scene) {
+    scene->r.mode |= R_PERSISTENT_DATA;
+    DEG_id_tag_update(&scene->id, ID_RECALC_COPY_ON_WRITE);
+  }
+  else {
+    printf(
+        "\nError: no blend loaded. "
+        "order the arguments so '--persistent-data' is after a blend is loaded.\n");
+  }
+  return 0;
+}
+
 static const char arg_handle_image_type_set_doc[] =
     "<format>\n"
     "\tSet the render format.\n"
@@ -1494,6 +1536,18 @@ static int arg_handle_threads_set(int argc, const char **argv, void *UNUSED(data
   return 0;
 }
 
+static const char arg_handle_threads_numa_set_doc[] =
+    "\n\t"
+    "Create a separate task arena for every NUMA node, with threads bound to that node.\n"
+    "\tImproves memory locality of loops that distribute their work over the NUMA nodes.";
+static int arg_handle_threads_numa_set(int UNUSED(argc),
+                                       const char **UNUSED(argv),
+                                       void *UNUSED(data))
+{
+  BLI_task_scheduler_use_numa_arenas_set(true);
+  return 0;
+}
+
 static const char arg_handle_verbosity_set_doc[] =
     "<verbose>\n"
     "\tSet the logging verbosity level for debug messages that support it.";
@@ -2054,6 +2108,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--env-system-python", CB_EX(arg_handle_env_system_set, python), NULL);
 
   BLI_args_add(ba, "-t", "--threads", CB(arg_handle_threads_set), NULL);
+  BLI_args_add(ba, NULL, "--threads-numa", CB(arg_handle_threads_numa_set), NULL);
 
   /* Include in the environment pass so it's possible display errors initializing subsystems,
    * especially `bpy.appdir` since it's useful to show errors finding paths on startup. */
@@ -2152,6 +2207,7 @@ void main_args_setup(bContext *C, bArgs *ba)
   BLI_args_add(ba, NULL, "--debug-cycles", CB(arg_handle_debug_mode_cycles), NULL);
 #  endif
   BLI_args_add(ba, NULL, "--debug-memory", CB(arg_handle_debug_mode_memory_set), NULL);
+  BLI_args_add(ba, NULL, "--debug-trace", CB(arg_handle_debug_trace_set), NULL);
 
   BLI_args_add(ba, NULL, "--debug-value", CB(arg_handle_debug_value_set), NULL);
   BLI_args_add(ba,
@@ -2249,6 +2305,7 @@ void main_args_setup(bContext *C, bArgs *ba)
 
   BLI_args_add(ba, "-o", "--render-output", CB(arg_handle_output_set), C);
   BLI_args_add(ba, "-E", "--engine", CB(arg_handle_engine_set), C);
+  BLI_args_add(ba, NULL, "--persistent-data", CB(arg_handle_persistent_data_set), C);
 
   BLI_args_add(ba, "-F", "--render-format", CB(arg_handle_image_type_set), C);
   BLI_args_add(ba, "-x", "--use-extension", CB(arg_handle_extension_set), C);
@@ -0,0 +1,17 @@
+# Apache License, Version 2.0
+
+import sys
+
+
+def peak_memory_usage() -> int:
+    # Peak resident memory of the current process in bytes, or 0 when it can
+    # not be queried on this platform. Tests run in a new Blender process, so
+    # this measures the peak memory of the test itself.
+    try:
+        import resource
+    except ImportError:
+        return 0
+
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Reported in bytes on macOS and in kilobytes elsewhere.
+    return peak if sys.platform == 'darwin' else peak * 1024
@@ -0,0 +1,56 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+    import time
+
+    filepath = args['filepath']
+    use_compress = args['use_compress']
+
+    bpy.ops.wm.open_mainfile(filepath=filepath)
+
+    with tempfile.TemporaryDirectory() as tmpdir:
+        save_filepath = os.path.join(tmpdir, 'save.blend')
+
+        # Save once to ensure the output location is cached by OS.
+        bpy.ops.wm.save_as_mainfile(filepath=save_filepath, compress=use_compress, copy=True)
+
+        # Measure saving the second time
+        start_time = time.time()
+        bpy.ops.wm.save_as_mainfile(filepath=save_filepath, compress=use_compress, copy=True)
+        elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time, 'memory': api.peak_memory_usage()}
+    return result
+
+
+class BlendSaveTest(api.Test):
+    def __init__(self, filepath, use_compress):
+        self.filepath = filepath
+        self.use_compress = use_compress
+
+    def name(self):
+        if self.use_compress:
+            return self.filepath.stem + "_compressed"
+        return self.filepath.stem
+
+    def category(self):
+        return "blend_save"
+
+    def run(self, env, device_id):
+        args = {'filepath': str(self.filepath), 'use_compress': self.use_compress}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    filepaths = env.find_blend_files('*/*')
+    return [BlendSaveTest(filepath, use_compress)
+            for filepath in filepaths
+            for use_compress in (False, True)]
@@ -0,0 +1,60 @@
+# Apache License, Version 2.0
+
+import api
+import os
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Evaluate once so one-time initialization is not measured.
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+
+    objects = [ob for ob in bpy.context.scene.objects if ob.modifiers]
+
+    start_time = time.time()
+    elapsed_time = 0.0
+    num_evaluations = 0
+
+    while elapsed_time < 10.0 or num_evaluations == 0:
+        # Only tag the objects with modifiers, so their modifier stack is
+        # evaluated again and other objects are not.
+        for ob in objects:
+            ob.update_tag(refresh={'DATA'})
+        depsgraph.update()
+
+        num_evaluations += 1
+        elapsed_time = time.time() - start_time
+
+    time_per_evaluation = elapsed_time / num_evaluations
+
+    result = {'time': time_per_evaluation, 'memory': api.peak_memory_usage()}
+    return result
+
+
+class ModifiersTest(api.Test):
+    def __init__(self, filepath, category):
+        self.filepath = filepath
+        self._category = category
+
+    def name(self):
+        return self.filepath.stem
+
+    def category(self):
+        return self._category
+
+    def run(self, env, device_id):
+        args = {}
+        result, _ = env.run_in_blender(_run, args, [self.filepath])
+        return result
+
+
+def generate(env):
+    # Geometry nodes files are expected to have one file per node type or
+    # node setup, so regressions can be traced to a specific node.
+    tests = []
+    for category in ('geometry_nodes', 'modifiers'):
+        filepaths = env.find_blend_files(category + '/*')
+        tests += [ModifiersTest(filepath, category) for filepath in filepaths]
+    return tests